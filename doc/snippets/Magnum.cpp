@@ -23,8 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <unordered_map>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/AsyncResourceLoader.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
@@ -62,6 +65,37 @@ class MeshResourceLoader: public AbstractResourceLoader<GL::Mesh> {
 /* [AbstractResourceLoader-implementation] */
 #endif
 
+Containers::Optional<Image2D> loadImage(const std::string& filename);
+
+/* [AsyncResourceLoader-implementation] */
+class ImageResourceLoader: public AsyncResourceLoader<Image2D> {
+    public:
+        explicit ImageResourceLoader(std::unordered_map<ResourceKey, std::string> filenames): _filenames{std::move(filenames)} {}
+
+        ~ImageResourceLoader() {
+            /* doLoadAsync() accesses _filenames, stop the workers before
+               it's destroyed */
+            stop();
+        }
+
+    private:
+        /* Called from a worker thread */
+        void doLoadAsync(ResourceKey key) override {
+            /* The map is never modified, so no locking needed */
+            auto found = _filenames.find(key);
+            Containers::Optional<Image2D> image;
+            if(found == _filenames.end() || !(image = loadImage(found->second))) {
+                setNotFound(key);
+                return;
+            }
+
+            set(key, std::move(*image));
+        }
+
+        std::unordered_map<ResourceKey, std::string> _filenames;
+};
+/* [AsyncResourceLoader-implementation] */
+
 int main() {
 
 {
@@ -277,4 +311,34 @@ Resource<GL::Mesh> myMesh = manager.get<GL::Mesh>("my-mesh");
 }
 #endif
 
+{
+std::unordered_map<ResourceKey, std::string> filenames;
+/* [ResourceManager-thread-safe] */
+ResourceManager<Image2D> manager{ResourceManagerFlag::ThreadSafe};
+manager.setLoader<Image2D>(Containers::pointer<ImageResourceLoader>(filenames));
+
+// Returns immediately, the image gets loaded on a worker thread
+Resource<Image2D> logo = manager.get<Image2D>("logo");
+
+// Later, in the main loop
+if(logo.state() == ResourceState::Final) {
+    // use *logo ...
+}
+/* [ResourceManager-thread-safe] */
+}
+
+{
+Image2D image{PixelFormat::RGBA8Unorm, {}, nullptr};
+/* [ResourceManager-budget] */
+ResourceManager<Image2D> manager;
+
+// Keep unused images around only as long as they fit into 256 MB
+manager.setBudget<Image2D>(256*1024*1024);
+
+const std::size_t size = image.data().size();
+manager.set("logo", std::move(image), ResourceDataState::Final,
+    ResourcePolicy::Cached, size);
+/* [ResourceManager-budget] */
+}
+
 }
@@ -23,13 +23,89 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/Manager.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
 #include "Magnum/Audio/Context.h"
 #include "Magnum/Audio/Extensions.h"
+#include "Magnum/Audio/Resampler.h"
+#include "Magnum/Audio/SampleConversion.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Audio/StreamingSource.h"
 
 using namespace Magnum;
 
 int main() {
 
+{
+PluginManager::Manager<Audio::AbstractImporter> manager;
+/* [AbstractImporter-streaming] */
+Containers::Pointer<Audio::AbstractImporter> importer =
+    manager.loadAndInstantiate("AnyAudioImporter");
+if(!importer || !importer->openFile("music.wav") ||
+   !(importer->features() & Audio::ImporterFeature::Streaming))
+    Fatal{} << "Can't stream music.wav";
+
+Containers::Array<char> chunk{4096*Audio::frameSize(importer->format())};
+while(std::size_t frames = importer->read(chunk)) {
+    // process frames*frameSize(format) bytes from the chunk
+}
+/* [AbstractImporter-streaming] */
+}
+
+{
+PluginManager::Manager<Audio::AbstractImporter> manager;
+Containers::Pointer<Audio::AbstractImporter> importer =
+    manager.loadAndInstantiate("AnyAudioImporter");
+bool running{};
+/* [StreamingSource-usage] */
+importer->openFile("music.ogg");
+
+Audio::StreamingSource music{*importer};
+music.setLooping(true)
+     .play();
+music.source().setGain(0.5f);
+
+while(running) {
+    music.update();
+
+    // the rest of the main loop ...
+}
+/* [StreamingSource-usage] */
+}
+
+{
+PluginManager::Manager<Audio::AbstractImporter> manager;
+Containers::Pointer<Audio::AbstractImporter> importer =
+    manager.loadAndInstantiate("AnyAudioImporter");
+/* [Resampler] */
+const Audio::BufferFormat format = importer->format();
+const UnsignedInt channelCount = Audio::channelCount(format);
+Audio::Resampler resampler{channelCount, importer->frequency(), 48000};
+
+Containers::Array<char> chunk{4096*Audio::frameSize(format)};
+Containers::Array<Float> samples{4096*channelCount};
+Containers::Array<Float> resampled;
+while(std::size_t frames = importer->read(chunk)) {
+    const std::size_t sampleCount = frames*channelCount;
+    Audio::convertSamplesInto(format,
+        chunk.prefix(frames*Audio::frameSize(format)),
+        samples.prefix(sampleCount));
+
+    const std::size_t outputSampleCount =
+        resampler.outputFrameCount(frames)*channelCount;
+    if(resampled.size() < outputSampleCount)
+        resampled = Containers::Array<Float>{outputSampleCount};
+    resampler.process(samples.prefix(sampleCount),
+        resampled.prefix(outputSampleCount));
+
+    // use the 48 kHz samples ...
+}
+/* [Resampler] */
+}
+
 {
 /* [Context-isExtensionSupported] */
 if(Audio::Context::current().isExtensionSupported<Audio::Extensions::ALC::SOFTX::HRTF>()) {
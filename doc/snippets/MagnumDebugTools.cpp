@@ -27,6 +27,7 @@
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
@@ -106,6 +107,7 @@ CORRADE_COMPARE_WITH(actual.pixels<Color3ub>().flipped<0>(), expected,
 struct MyApp {
     void drawEvent();
     void drawEventAgain();
+    void cull();
     void swapBuffers();
     void redraw();
 
@@ -138,6 +140,15 @@ void MyApp::drawEventAgain() {
 }
 /* [FrameProfiler-usage-console] */
 
+/* [FrameProfiler-zones] */
+void MyApp::cull() {
+    DebugTools::FrameProfiler::Zone zone{_profiler, "culling"};
+
+    // culling code, possibly spawning worker threads that record their own
+    // zones …
+}
+/* [FrameProfiler-zones] */
+
 int main() {
 {
 /* [FrameProfiler-setup-immediate] */
@@ -161,4 +172,11 @@ DebugTools::FrameProfiler profiler{{
 /* [FrameProfiler-setup-immediate] */
 }
 
+{
+DebugTools::FrameProfiler profiler;
+/* [FrameProfiler-zones-export] */
+Utility::Directory::writeString("trace.json", profiler.chromeTrace());
+/* [FrameProfiler-zones-export] */
+}
+
 }
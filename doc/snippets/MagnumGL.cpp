@@ -41,9 +41,11 @@
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/GL/PixelFormat.h"
 #include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/RenderState.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
 #include "Magnum/GL/Shader.h"
+#include "Magnum/GL/StreamingBuffer.h"
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
 #include "Magnum/GL/Version.h"
@@ -76,6 +78,7 @@
 #include "Magnum/GL/BufferTextureFormat.h"
 #include "Magnum/GL/CubeMapTextureArray.h"
 #include "Magnum/GL/MultisampleTexture.h"
+#include "Magnum/GL/ProgramBinaryCache.h"
 #endif
 
 #ifndef MAGNUM_TARGET_GLES
@@ -85,6 +88,60 @@
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
 
+#ifndef MAGNUM_TARGET_GLES
+namespace {
+
+/* [AbstractShaderProgram-async] */
+class MyAsyncShader: public GL::AbstractShaderProgram {
+    public:
+        class CompileState;
+
+        /* Submits compilation and linking, doesn't wait for the result */
+        static CompileState compile();
+
+        /* Checks the result and finishes the setup */
+        explicit MyAsyncShader(CompileState&& state);
+
+    private:
+        explicit MyAsyncShader(NoInitT) {}
+
+        Int _transformationMatrixUniform;
+};
+
+class MyAsyncShader::CompileState: public MyAsyncShader {
+    private:
+        friend MyAsyncShader;
+
+        explicit CompileState(MyAsyncShader&& shader, GL::Shader&& vert, GL::Shader&& frag): MyAsyncShader{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)} {}
+
+        GL::Shader _vert, _frag;
+};
+
+MyAsyncShader::CompileState MyAsyncShader::compile() {
+    GL::Shader vert{GL::Version::GL430, GL::Shader::Type::Vertex};
+    GL::Shader frag{GL::Version::GL430, GL::Shader::Type::Fragment};
+    vert.addFile("MyShader.vert");
+    frag.addFile("MyShader.frag");
+    vert.submitCompile();
+    frag.submitCompile();
+
+    MyAsyncShader out{NoInit};
+    out.attachShaders({vert, frag});
+    out.submitLink();
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag)};
+}
+
+MyAsyncShader::MyAsyncShader(CompileState&& state): MyAsyncShader{static_cast<MyAsyncShader&&>(std::move(state))} {
+    CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile() && checkLink());
+
+    _transformationMatrixUniform = uniformLocation("transformationMatrix");
+}
+/* [AbstractShaderProgram-async] */
+
+}
+#endif
+
 int main() {
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -365,6 +422,22 @@ bindFragmentDataLocation(NormalOutput, "normal");
 // Link...
 /* [AbstractShaderProgram-binding] */
 
+{
+GL::Shader vert{GL::Version::GL430, GL::Shader::Type::Vertex};
+GL::Shader frag{GL::Version::GL430, GL::Shader::Type::Fragment};
+/* [AbstractShaderProgram-loadBinary] */
+vert.addFile("MyShader.vert");
+frag.addFile("MyShader.frag");
+
+/* Compile, attach and link only if the binary isn't in the cache already */
+if(!loadBinary({vert, frag})) {
+    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    attachShaders({vert, frag});
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+}
+/* [AbstractShaderProgram-loadBinary] */
+}
+
 /* [AbstractShaderProgram-uniform-location] */
 Int projectionMatrixUniform = uniformLocation("projectionMatrix");
 Int transformationMatrixUniform = uniformLocation("transformationMatrix");
@@ -396,6 +469,19 @@ setTransformFeedbackOutputs({
 };
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+{
+/* [AbstractShaderProgram-async-usage] */
+MyAsyncShader::CompileState state = MyAsyncShader::compile();
+while(!state.isLinkFinished()) {
+    // draw a frame of the loading screen ...
+}
+
+MyAsyncShader shader{std::move(state)};
+/* [AbstractShaderProgram-async-usage] */
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 {
 MyShader shader;
@@ -452,6 +538,100 @@ buffer.setData({nullptr, 200*sizeof(Vector3)});
 /* [Buffer-setdata-allocate] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+struct TransformationUniform {
+    Matrix4 transformationMatrix;
+};
+Containers::ArrayView<const Matrix4> transformations;
+struct: GL::AbstractShaderProgram {} shader;
+GL::Mesh mesh;
+/* [StreamingBuffer-usage] */
+GL::StreamingBuffer uniforms{64*1024, 3, GL::Buffer::TargetHint::Uniform};
+
+/* Each frame, allocate and fill uniforms for all objects first ... */
+std::vector<GLintptr> offsets(transformations.size());
+for(std::size_t i = 0; i != transformations.size(); ++i) {
+    Containers::ArrayView<char> data;
+    std::tie(offsets[i], data) = uniforms.allocate(
+        sizeof(TransformationUniform), GL::Buffer::uniformOffsetAlignment());
+    Containers::arrayCast<TransformationUniform>(data)[0]
+        .transformationMatrix = transformations[i];
+}
+
+/* ... flush them all at once ... */
+uniforms.flush();
+
+/* ... and bind the corresponding range for each draw */
+for(GLintptr offset: offsets) {
+    uniforms.buffer().bind(GL::Buffer::Target::Uniform, 0, offset,
+        sizeof(TransformationUniform));
+    shader.draw(mesh);
+}
+
+uniforms.finishFrame();
+/* [StreamingBuffer-usage] */
+}
+#endif
+
+{
+struct: GL::AbstractShaderProgram {} shader;
+GL::Mesh opaqueMesh, transparentMesh;
+/* [RenderState-usage] */
+GL::RenderState opaque;
+opaque
+    .enable(GL::Renderer::Feature::DepthTest)
+    .disable(GL::Renderer::Feature::Blending)
+    .setDepthMask(true);
+
+GL::RenderState transparent;
+transparent
+    .enable(GL::Renderer::Feature::DepthTest)
+    .enable(GL::Renderer::Feature::Blending)
+    .setBlendFunction(GL::Renderer::BlendFunction::One,
+                      GL::Renderer::BlendFunction::OneMinusSourceAlpha)
+    .setDepthMask(false);
+
+/* Only the depth mask and blending get toggled, depth test is already
+   enabled */
+opaque.apply();
+shader.draw(opaqueMesh);
+transparent.apply();
+shader.draw(transparentMesh);
+/* [RenderState-usage] */
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+/* [ProgramBinaryCache-usage] */
+/* Keep the cache alive for as long as shaders are being created */
+GL::ProgramBinaryCache cache{"shader-cache"};
+
+/* Compiled and linked on the first run, loaded from the cache on the next */
+Shaders::Phong shader{Shaders::Phong::Flag::DiffuseTexture, 3};
+/* [ProgramBinaryCache-usage] */
+}
+
+{
+/* [ProgramBinaryCache-prewarm] */
+GL::ProgramBinaryCache cache{"shader-cache"};
+
+/* Construct all variants the application will need, for example in a loading
+   screen or at install time */
+for(Shaders::Phong::Flags flags: {
+    Shaders::Phong::Flags{},
+    Shaders::Phong::Flags{Shaders::Phong::Flag::DiffuseTexture},
+    Shaders::Phong::Flag::DiffuseTexture|Shaders::Phong::Flag::NormalTexture,
+    Shaders::Phong::Flag::DiffuseTexture|Shaders::Phong::Flag::AlphaMask})
+    for(UnsignedInt lightCount: {1, 2, 4})
+        Shaders::Phong{flags, lightCount};
+
+Debug{} << cache.missCount() << "variants compiled," << cache.hitCount()
+    << "loaded from the cache";
+/* [ProgramBinaryCache-prewarm] */
+}
+#endif
+
 #ifndef MAGNUM_TARGET_WEBGL
 {
 GL::Buffer buffer;
@@ -26,11 +26,13 @@
 #include <tuple> /* for std::tie() :( */
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/Compile.h"
 #include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/MeshTools/Concatenate.h"
 #include "Magnum/MeshTools/Interleave.h"
 #include "Magnum/Trade/MeshData.h"
 
@@ -73,6 +75,26 @@ mesh.addVertexBuffer(std::move(vertices),
 /* [compile-external-attributes] */
 }
 
+#ifndef MAGNUM_TARGET_GLES
+{
+Trade::MeshData a{MeshPrimitive::Triangles, 0};
+Trade::MeshData b{MeshPrimitive::Triangles, 0};
+Trade::MeshData c{MeshPrimitive::Triangles, 0};
+struct: GL::AbstractShaderProgram {} shader;
+/* [compileDrawCommands] */
+/* Put all meshes into a single vertex and index buffer */
+GL::Mesh mesh = MeshTools::compile(MeshTools::concatenate({a, b, c}));
+
+/* One command for each of the original meshes */
+GL::Buffer commands{GL::Buffer::TargetHint::DrawIndirect,
+    MeshTools::compileDrawCommands({a, b, c})};
+
+/* Draw all of them at once */
+shader.drawIndirect(mesh, commands, 0, 3);
+/* [compileDrawCommands] */
+}
+#endif
+
 {
 /* [compressIndices] */
 Containers::Array<UnsignedInt> indices;
@@ -25,15 +25,18 @@
 
 #include <tuple>
 #include <vector>
+#include <Corrade/Utility/Debug.h>
 
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/MeshTools/Bvh.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Concatenate.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/FlipNormals.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Quantize.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Transform.h"
 #include "Magnum/Primitives/Cube.h"
@@ -49,6 +52,26 @@ using namespace Magnum::Math::Literals;
 
 int main() {
 
+{
+Trade::MeshData mesh{MeshPrimitive::Triangles, 0};
+Vector3 cameraPosition, direction, lightPosition, point;
+/* [Bvh-usage] */
+MeshTools::Bvh bvh{mesh};
+
+/* Pick the triangle under the cursor */
+if(Containers::Optional<MeshTools::Bvh::Hit> hit =
+    bvh.closestHit(cameraPosition, direction))
+{
+    Debug{} << "Picked triangle" << hit->triangle << "at distance"
+        << hit->distance;
+}
+
+/* Check if a point is in shadow, limiting the ray to the light distance */
+bool inShadow = bvh.anyHit(point, lightPosition - point, 1.0f);
+/* [Bvh-usage] */
+static_cast<void>(inShadow);
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 {
 CORRADE_IGNORE_DEPRECATED_PUSH
@@ -149,6 +172,22 @@ Trade::MeshData indexed{data.primitive(),
 /* [interleavedLayout-indices] */
 }
 
+{
+Trade::MeshData mesh{MeshPrimitive::Points, 0};
+Matrix4 transformationMatrix;
+/* [quantize] */
+Trade::MeshData quantized{MeshPrimitive::Points, 0};
+Matrix4 positionTransformation;
+Matrix3 textureCoordinateTransformation;
+std::tie(quantized, positionTransformation, textureCoordinateTransformation) =
+    MeshTools::quantize(mesh);
+
+/* Undo the position quantization as a part of the object transformation */
+Matrix4 transformation = transformationMatrix*positionTransformation;
+/* [quantize] */
+static_cast<void>(transformation);
+}
+
 {
 /* [removeDuplicates] */
 Containers::ArrayView<Vector3i> data;
@@ -35,6 +35,7 @@
 #include "Magnum/GL/DefaultFramebuffer.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
 #include "Magnum/GL/Shader.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
@@ -118,6 +119,22 @@ visualizerShader
 /* [shaders-meshvisualizer] */
 }
 
+{
+/* [shaders-async] */
+Shaders::Flat3D::CompileState flatState =
+    Shaders::Flat3D::compile(Shaders::Flat3D::Flag::Textured);
+Shaders::Phong::CompileState phongState =
+    Shaders::Phong::compile(Shaders::Phong::Flag::DiffuseTexture, 2);
+
+while(!flatState.isLinkFinished() || !phongState.isLinkFinished()) {
+    // do other work ...
+}
+
+Shaders::Flat3D flat{std::move(flatState)};
+Shaders::Phong phong{std::move(phongState)};
+/* [shaders-async] */
+}
+
 {
 /* [DistanceFieldVector-usage1] */
 struct Vertex {
@@ -274,6 +291,70 @@ mesh.setInstanceCount(Containers::arraySize(instanceData))
 /* [Flat-usage-instancing] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh mesh;
+Matrix3 transformationProjectionMatrix;
+/* [Flat-usage-ubo] */
+GL::Buffer transformationProjectionUniform, drawUniform, materialUniform;
+transformationProjectionUniform.setData({
+    Shaders::TransformationProjectionUniform2D{}
+        .setTransformationProjectionMatrix(transformationProjectionMatrix)
+});
+drawUniform.setData({
+    Shaders::FlatDrawUniform{}
+        .setMaterialId(0)
+});
+materialUniform.setData({
+    Shaders::FlatMaterialUniform{}
+        .setColor(0x2f83cc_rgbf)
+});
+
+Shaders::Flat2D shader{Shaders::Flat2D::Flag::UniformBuffers, 1, 1};
+shader
+    .bindTransformationProjectionBuffer(transformationProjectionUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindMaterialBuffer(materialUniform)
+    .draw(mesh);
+/* [Flat-usage-ubo] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+{
+GL::Mesh mesh;
+Matrix3 projection, transformationA, transformationB, transformationC;
+GL::MeshView viewA{mesh}, viewB{mesh}, viewC{mesh};
+/* [Flat-usage-multidraw] */
+GL::Buffer transformationProjectionUniform, drawUniform, materialUniform;
+transformationProjectionUniform.setData({
+    Shaders::TransformationProjectionUniform2D{}
+        .setTransformationProjectionMatrix(projection*transformationA),
+    Shaders::TransformationProjectionUniform2D{}
+        .setTransformationProjectionMatrix(projection*transformationB),
+    Shaders::TransformationProjectionUniform2D{}
+        .setTransformationProjectionMatrix(projection*transformationC)
+});
+drawUniform.setData({
+    Shaders::FlatDrawUniform{}.setMaterialId(0),
+    Shaders::FlatDrawUniform{}.setMaterialId(1),
+    Shaders::FlatDrawUniform{}.setMaterialId(0)
+});
+materialUniform.setData({
+    Shaders::FlatMaterialUniform{}.setColor(0x2f83cc_rgbf),
+    Shaders::FlatMaterialUniform{}.setColor(0xdcdcdc_rgbf)
+});
+
+Shaders::Flat2D shader{Shaders::Flat2D::Flag::MultiDraw, 2, 3};
+shader
+    .bindTransformationProjectionBuffer(transformationProjectionUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindMaterialBuffer(materialUniform)
+    .draw({viewA, viewB, viewC});
+/* [Flat-usage-multidraw] */
+}
+#endif
+
 {
 struct: GL::AbstractShaderProgram {
 void foo() {
@@ -320,6 +401,52 @@ mesh.setInstanceCount(Containers::arraySize(instanceData))
 /* [Phong-usage-instancing] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh mesh;
+Matrix4 projectionMatrix, transformationMatrix;
+/* [Phong-usage-ubo] */
+GL::Buffer projectionUniform, transformationUniform, drawUniform,
+    materialUniform, lightUniform;
+projectionUniform.setData({
+    Shaders::ProjectionUniform3D{}
+        .setProjectionMatrix(projectionMatrix)
+});
+transformationUniform.setData({
+    Shaders::TransformationUniform3D{}
+        .setTransformationMatrix(transformationMatrix)
+});
+drawUniform.setData({
+    Shaders::PhongDrawUniform{}
+        .setNormalMatrix(transformationMatrix.normalMatrix())
+        .setMaterialId(0)
+        .setLightOffsetCount(0, 2)
+});
+materialUniform.setData({
+    Shaders::PhongMaterialUniform{}
+        .setDiffuseColor(0x2f83cc_rgbf)
+        .setShininess(200.0f)
+});
+lightUniform.setData({
+    Shaders::PhongLightUniform{}
+        .setPosition({5.0f, 5.0f, 7.0f, 0.0f}),
+    Shaders::PhongLightUniform{}
+        .setPosition({-5.0f, -5.0f, 7.0f, 0.0f})
+        .setColor(0x3366cc_rgbf)
+});
+
+Shaders::Phong shader{Shaders::Phong::Flag::UniformBuffers, 2, 1, 1};
+shader
+    .bindProjectionBuffer(projectionUniform)
+    .bindTransformationBuffer(transformationUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindLightBuffer(lightUniform)
+    .draw(mesh);
+/* [Phong-usage-ubo] */
+}
+#endif
+
 {
 /* [MeshVisualizer-usage-geom1] */
 struct Vertex {
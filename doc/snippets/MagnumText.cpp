@@ -25,16 +25,20 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Resource.h>
 
 #include "Magnum/FileCallback.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Shaders/Vector.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/DistanceFieldGlyphCache.h"
+#include "Magnum/Text/DynamicGlyphCache.h"
+#include "Magnum/Text/GlyphLayout.h"
 #include "Magnum/Text/Renderer.h"
 
 using namespace Magnum;
@@ -176,4 +180,56 @@ shader.setTransformationProjectionMatrix(projectionMatrix)
 /* [Renderer-usage2] */
 }
 
+{
+Containers::Pointer<Text::AbstractFont> font;
+Text::GlyphCache cache{Vector2i{512}};
+Containers::ArrayView<const std::string> labels;
+/* [layoutGlyphQuadsInto] */
+/* Allocated once and reused every frame, sized for the worst case of one
+   glyph per byte */
+std::size_t maxGlyphCount = 0;
+for(const std::string& label: labels) maxGlyphCount += label.size();
+struct Vertex {
+    Vector2 position;
+    Vector2 textureCoordinates;
+};
+Containers::Array<Vertex> vertices{Containers::NoInit, maxGlyphCount*4};
+Containers::Array<UnsignedInt> indices{Containers::NoInit, maxGlyphCount*6};
+Containers::Array<UnsignedInt> glyphOffsets{Containers::NoInit, labels.size()};
+Containers::Array<Range2D> rectangles{Containers::NoInit, labels.size()};
+
+/* Lay out all labels into the interleaved vertex array, then generate
+   indices for the glyphs actually produced */
+UnsignedInt glyphCount = Text::layoutGlyphQuadsInto(*font, cache, 0.15f,
+    Text::Alignment::LineLeft, labels,
+    Containers::StridedArrayView1D<Vector2>{vertices, &vertices[0].position,
+        vertices.size(), sizeof(Vertex)},
+    Containers::StridedArrayView1D<Vector2>{vertices,
+        &vertices[0].textureCoordinates, vertices.size(), sizeof(Vertex)},
+    glyphOffsets, rectangles);
+Text::glyphQuadIndicesInto(0, indices.prefix(glyphCount*6));
+/* [layoutGlyphQuadsInto] */
+}
+
+{
+Containers::Pointer<Text::AbstractFont> font;
+Shaders::Vector2D shader;
+std::string userInput;
+/* [DynamicGlyphCache-usage] */
+Text::GlyphCache texture{Vector2i{1024}, Vector2i{1}};
+Text::DynamicGlyphCache cache{texture, PixelFormat::R8Unorm};
+Text::Renderer2D renderer{*font, cache, 0.15f};
+renderer.reserve(256, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+
+/* Every frame, rasterize glyphs that aren't in the cache yet, lay out the
+   text and upload everything that changed in a single call */
+cache.fillGlyphs(*font, userInput);
+renderer.render(userInput);
+cache.flush();
+
+shader.bindVectorTexture(texture.texture())
+    .draw(renderer.mesh());
+/* [DynamicGlyphCache-usage] */
+}
+
 }
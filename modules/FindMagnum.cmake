@@ -88,6 +88,8 @@
 #  OpenGLTester                 - OpenGLTester class
 #  MagnumFont                   - Magnum bitmap font plugin
 #  MagnumFontConverter          - Magnum bitmap font converter plugin
+#  MeshCodecImporter            - Mesh codec importer plugin
+#  MeshCodecSceneConverter      - Mesh codec scene converter plugin
 #  ObjImporter                  - OBJ importer plugin
 #  TgaImageConverter            - TGA image converter plugin
 #  TgaImporter                  - TGA importer plugin
@@ -346,8 +348,9 @@ if(NOT TARGET Magnum::Magnum)
         ${MAGNUM_INCLUDE_DIR})
 
     # Dependent libraries
+    find_package(Threads REQUIRED)
     set_property(TARGET Magnum::Magnum APPEND PROPERTY INTERFACE_LINK_LIBRARIES
-         Corrade::Utility)
+         Corrade::Utility Threads::Threads)
 else()
     set(MAGNUM_LIBRARY Magnum::Magnum)
 endif()
@@ -365,8 +368,9 @@ set(_MAGNUM_LIBRARY_COMPONENT_LIST
     OpenGLTester)
 set(_MAGNUM_PLUGIN_COMPONENT_LIST
     AnyAudioImporter AnyImageConverter AnyImageImporter AnySceneConverter
-    AnySceneImporter MagnumFont MagnumFontConverter ObjImporter
-    TgaImageConverter TgaImporter WavAudioImporter)
+    AnySceneImporter MagnumFont MagnumFontConverter MeshCodecImporter
+    MeshCodecSceneConverter ObjImporter TgaImageConverter TgaImporter
+    WavAudioImporter)
 set(_MAGNUM_EXECUTABLE_COMPONENT_LIST
     distancefieldconverter fontconverter imageconverter sceneconverter
     shaderconverter gl-info al-info)
@@ -466,6 +470,8 @@ set(_MAGNUM_WglContext_DEPENDENCIES GL)
 
 set(_MAGNUM_MagnumFont_DEPENDENCIES Trade TgaImporter GL) # and below
 set(_MAGNUM_MagnumFontConverter_DEPENDENCIES Trade TgaImageConverter) # and below
+set(_MAGNUM_MeshCodecImporter_DEPENDENCIES MeshTools) # and below
+set(_MAGNUM_MeshCodecSceneConverter_DEPENDENCIES MeshTools) # and below
 set(_MAGNUM_ObjImporter_DEPENDENCIES MeshTools) # and below
 foreach(_component ${_MAGNUM_PLUGIN_COMPONENT_LIST})
     if(_component MATCHES ".+AudioImporter")
@@ -903,6 +909,8 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # No special setup for AnySceneImporter plugin
         # No special setup for MagnumFont plugin
         # No special setup for MagnumFontConverter plugin
+        # No special setup for MeshCodecImporter plugin
+        # No special setup for MeshCodecSceneConverter plugin
         # No special setup for ObjImporter plugin
         # No special setup for TgaImageConverter plugin
         # No special setup for TgaImporter plugin
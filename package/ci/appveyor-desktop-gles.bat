@@ -40,6 +40,8 @@ cmake .. ^
     -DWITH_ANYSHADERCONVERTER=OFF ^
     -DWITH_MAGNUMFONT=ON ^
     -DWITH_MAGNUMFONTCONVERTER=ON ^
+    -DWITH_MESHCODECIMPORTER=OFF ^
+    -DWITH_MESHCODECSCENECONVERTER=OFF ^
     -DWITH_OBJIMPORTER=OFF ^
     -DWITH_TGAIMAGECONVERTER=OFF ^
     -DWITH_TGAIMPORTER=OFF ^
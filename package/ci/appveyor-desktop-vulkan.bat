@@ -47,6 +47,8 @@ cmake .. ^
     -DWITH_ANYSCENEIMPORTER=OFF ^
     -DWITH_MAGNUMFONT=OFF ^
     -DWITH_MAGNUMFONTCONVERTER=OFF ^
+    -DWITH_MESHCODECIMPORTER=OFF ^
+    -DWITH_MESHCODECSCENECONVERTER=OFF ^
     -DWITH_OBJIMPORTER=OFF ^
     -DWITH_TGAIMAGECONVERTER=OFF ^
     -DWITH_TGAIMPORTER=OFF ^
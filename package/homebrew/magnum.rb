@@ -32,6 +32,8 @@ class Magnum < Formula
         "-DWITH_ANYSHADERCONVERTER=ON",
         "-DWITH_MAGNUMFONT=ON",
         "-DWITH_MAGNUMFONTCONVERTER=ON",
+        "-DWITH_MESHCODECIMPORTER=ON",
+        "-DWITH_MESHCODECSCENECONVERTER=ON",
         "-DWITH_OBJIMPORTER=ON",
         "-DWITH_TGAIMAGECONVERTER=ON",
         "-DWITH_TGAIMPORTER=ON",
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::AbstractResourceLoader
  */
 
+#include <atomic>
 #include <string>
 
 #include "Magnum/ResourceManager.h"
@@ -75,6 +76,8 @@ the following code, however, the loader destroys itself (and removes itself
 from the manager) before the manager is destroyed.
 
 @snippet Magnum.cpp AbstractResourceLoader-use
+
+For loading on a pool of worker threads see @ref AsyncResourceLoader.
 */
 template<class T> class AbstractResourceLoader {
     public:
@@ -141,18 +144,22 @@ template<class T> class AbstractResourceLoader {
          * @ref ResourceManager and it's not loaded yet, so it's not needed to
          * call this function. For marking a resource as not found you can also
          * use the convenience @ref setNotFound() variant.
+         *
+         * Pass @p size together with @ref ResourcePolicy::Cached to make the
+         * resource subject to the manager memory budget, see
+         * @ref ResourceManager-budget for more information.
          * @see @ref loadedCount()
          */
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0);
 
         /** @overload */
-        void set(ResourceKey key, Containers::Pointer<T> data, ResourceDataState state, ResourcePolicy policy) {
-            return set(key, data.release(), state, policy);
+        void set(ResourceKey key, Containers::Pointer<T> data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            return set(key, data.release(), state, policy, size);
         }
 
         /** @overload */
-        template<class U, class = typename std::enable_if<!std::is_same<typename std::decay<U>::type, std::nullptr_t>::value>::type> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy) {
-            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
+        template<class U, class = typename std::enable_if<!std::is_same<typename std::decay<U>::type, std::nullptr_t>::value>::type> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
         }
 
         /**
@@ -209,10 +216,16 @@ template<class T> class AbstractResourceLoader {
     private:
         #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
         friend Implementation::ResourceManagerData<T>;
+        template<class> friend class AsyncResourceLoader;
         #endif
 
+        /* Called from ResourceManager::get() with the resource already
+           marked as loading */
+        void loadInternal(ResourceKey key);
+
         Implementation::ResourceManagerData<T>* manager;
-        std::size_t _requestedCount,
+        /* Atomic as set() can be called from multiple loader threads */
+        std::atomic<std::size_t> _requestedCount,
             _loadedCount,
             _notFoundCount;
 };
@@ -224,17 +237,21 @@ template<class T> AbstractResourceLoader<T>::~AbstractResourceLoader() {
 template<class T> std::string AbstractResourceLoader<T>::doName(ResourceKey) const { return {}; }
 
 template<class T> void AbstractResourceLoader<T>::load(ResourceKey key) {
-    ++_requestedCount;
     /** @todo What policy for loading resources? */
-    manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident);
+    manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident, 0);
 
+    loadInternal(key);
+}
+
+template<class T> void AbstractResourceLoader<T>::loadInternal(ResourceKey key) {
+    ++_requestedCount;
     doLoad(key);
 }
 
-template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
+template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size) {
     if(data) ++_loadedCount;
     if(!data && state == ResourceDataState::NotFound) ++_notFoundCount;
-    manager->set(key, data, state, policy);
+    manager->set(key, data, state, policy, size);
 }
 
 }
@@ -0,0 +1,238 @@
+#ifndef Magnum_AsyncResourceLoader_h
+#define Magnum_AsyncResourceLoader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::AsyncResourceLoader
+ * @m_since_latest
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/AbstractResourceLoader.h"
+
+namespace Magnum {
+
+/**
+@brief Base for resource loaders with a pool of worker threads
+@m_since_latest
+
+Each resource requested through @ref ResourceManager::get() is put into a
+queue, while its state is set to @ref ResourceState::Loading. Worker threads
+then take the requests from the queue and call @ref doLoadAsync() on them,
+which is expected to load the data and pass them to the manager using
+@ref set() or @ref setNotFound() the same way as with
+@ref AbstractResourceLoader::doLoad(). The main thread thus never waits for
+any loading --- the @ref Resource instances simply report
+@ref ResourceState::Loading (or use a fallback) until the data arrive.
+
+The manager the loader is added to has to be constructed with
+@ref ResourceManagerFlag::ThreadSafe. The @ref doLoadAsync() implementation
+is called from multiple threads at once, so it has to synchronize access to
+any state it shares:
+
+@snippet Magnum.cpp AsyncResourceLoader-implementation
+
+@snippet Magnum.cpp ResourceManager-thread-safe
+
+@section AsyncResourceLoader-destruction Destruction
+
+The worker threads call @ref doLoadAsync(), which is implemented by the
+subclass, so they have to be stopped before the subclass gets destroyed. The
+subclass destructor is thus expected to call @ref stop(), as is done in the
+above snippet. The base destructor asserts that it was done.
+*/
+template<class T> class AsyncResourceLoader: public AbstractResourceLoader<T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param threadCount   Count of worker threads. If @cpp 0 @ce,
+         *      @ref std::thread::hardware_concurrency() is used.
+         */
+        explicit AsyncResourceLoader(UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that @ref stop() was called already from the subclass
+         * destructor.
+         */
+        ~AsyncResourceLoader();
+
+        /** @brief Count of worker threads */
+        UnsignedInt threadCount() const { return UnsignedInt(_threads.size()); }
+
+        /**
+         * @brief Count of pending requests
+         *
+         * Resources that are either queued or being loaded at the moment.
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Wait until all pending requests are done
+         *
+         * Blocks the calling thread until @ref pendingCount() becomes zero.
+         * Useful for example for loading screens or for synchronizing the
+         * state in tests.
+         */
+        void wait();
+
+        /**
+         * @brief Stop the workers
+         *
+         * Waits for the in-progress requests to finish, joins the worker
+         * threads and marks all requests that didn't start loading yet as
+         * not found using @ref setNotFound(). Any further @ref load() is
+         * not allowed. Calling this function on an already stopped loader
+         * does nothing.
+         */
+        void stop();
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    private:
+    #else
+    protected:
+    #endif
+        /**
+         * @brief Load resource asynchronously
+         *
+         * Called from one of the worker threads. The implementation is
+         * expected to call @ref set() or @ref setNotFound() once the data
+         * are loaded.
+         */
+        virtual void doLoadAsync(ResourceKey key) = 0;
+
+    private:
+        void doLoad(ResourceKey key) override final;
+
+        void run();
+
+        Containers::Array<std::thread> _threads;
+        mutable std::mutex _mutex;
+        std::condition_variable _requested, _finished;
+        std::deque<ResourceKey> _queue;
+        std::size_t _inProgress;
+        bool _stopped;
+};
+
+template<class T> AsyncResourceLoader<T>::AsyncResourceLoader(UnsignedInt threadCount): _inProgress{0}, _stopped{false} {
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    /* The threads only wait on the queue until the first load() is called,
+       which can't happen before the subclass is fully constructed */
+    _threads = Containers::Array<std::thread>{threadCount};
+    for(std::thread& thread: _threads)
+        thread = std::thread{&AsyncResourceLoader<T>::run, this};
+}
+
+template<class T> AsyncResourceLoader<T>::~AsyncResourceLoader() {
+    /* Otherwise the workers could call doLoadAsync() on an already destroyed
+       subclass. Stopping them anyway to not have std::thread terminate the
+       application on destruction if the assert is graceful or disabled. */
+    #ifndef CORRADE_NO_ASSERT
+    bool stopped;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        stopped = _stopped;
+    }
+    #endif
+    stop();
+    CORRADE_ASSERT(stopped,
+        "AsyncResourceLoader: stop() has to be called from the subclass destructor", );
+}
+
+template<class T> std::size_t AsyncResourceLoader<T>::pendingCount() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _queue.size() + _inProgress;
+}
+
+template<class T> void AsyncResourceLoader<T>::wait() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    _finished.wait(lock, [this]{ return _queue.empty() && !_inProgress; });
+}
+
+template<class T> void AsyncResourceLoader<T>::stop() {
+    std::deque<ResourceKey> discarded;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        if(_stopped) return;
+        _stopped = true;
+        std::swap(discarded, _queue);
+    }
+
+    _requested.notify_all();
+    for(std::thread& thread: _threads) thread.join();
+
+    /* The discarded resources would otherwise stay in the Loading state
+       forever */
+    if(this->manager) for(const ResourceKey key: discarded)
+        this->setNotFound(key);
+
+    _finished.notify_all();
+}
+
+template<class T> void AsyncResourceLoader<T>::doLoad(const ResourceKey key) {
+    CORRADE_ASSERT(this->manager->flags() & ResourceManagerFlag::ThreadSafe,
+        "AsyncResourceLoader: the manager has to be constructed with ResourceManagerFlag::ThreadSafe", );
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        CORRADE_ASSERT(!_stopped,
+            "AsyncResourceLoader: can't load" << key << "as the loader is stopped", );
+        _queue.push_back(key);
+    }
+
+    _requested.notify_one();
+}
+
+template<class T> void AsyncResourceLoader<T>::run() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    for(;;) {
+        _requested.wait(lock, [this]{ return _stopped || !_queue.empty(); });
+        if(_stopped) return;
+
+        const ResourceKey key = _queue.front();
+        _queue.pop_front();
+        ++_inProgress;
+
+        /* Load without holding the lock so other workers can proceed */
+        lock.unlock();
+        doLoadAsync(key);
+        lock.lock();
+
+        if(!--_inProgress && _queue.empty())
+            _finished.notify_all();
+    }
+}
+
+}
+
+#endif
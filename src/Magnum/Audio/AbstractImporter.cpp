@@ -40,7 +40,7 @@ namespace Magnum { namespace Audio {
 std::string AbstractImporter::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Audio.AbstractImporter/0.1"
+"cz.mosra.magnum.Audio.AbstractImporter/0.2"
 /* [interface] */
     ;
 }
@@ -129,6 +129,49 @@ Containers::Array<char> AbstractImporter::data() {
     return out;
 }
 
+UnsignedLong AbstractImporter::frameCount() const {
+    CORRADE_ASSERT(features() & ImporterFeature::Streaming,
+        "Audio::AbstractImporter::frameCount(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::frameCount(): no file opened", {});
+    return doFrameCount();
+}
+
+UnsignedLong AbstractImporter::doFrameCount() const {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::frameCount(): feature advertised but not implemented", {});
+}
+
+bool AbstractImporter::seek(const UnsignedLong frame) {
+    CORRADE_ASSERT(features() & ImporterFeature::Streaming,
+        "Audio::AbstractImporter::seek(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::seek(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedLong count = doFrameCount();
+    #endif
+    CORRADE_ASSERT(frame <= count,
+        "Audio::AbstractImporter::seek(): frame" << frame << "out of range for" << count << "frames", {});
+    return doSeek(frame);
+}
+
+bool AbstractImporter::doSeek(UnsignedLong) {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::seek(): feature advertised but not implemented", {});
+}
+
+std::size_t AbstractImporter::read(const Containers::ArrayView<char> destination) {
+    CORRADE_ASSERT(features() & ImporterFeature::Streaming,
+        "Audio::AbstractImporter::read(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::read(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt size = frameSize(doFormat());
+    #endif
+    CORRADE_ASSERT(destination.size() >= size,
+        "Audio::AbstractImporter::read(): expected at least" << size << "bytes for one frame but got" << destination.size(), {});
+    return doRead(destination);
+}
+
+std::size_t AbstractImporter::doRead(Containers::ArrayView<char>) {
+    CORRADE_ASSERT_UNREACHABLE("Audio::AbstractImporter::read(): feature advertised but not implemented", {});
+}
+
 Debug& operator<<(Debug& debug, const ImporterFeature value) {
     debug << "Audio::ImporterFeature" << Debug::nospace;
 
@@ -136,6 +179,7 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
         /* LCOV_EXCL_START */
         #define _c(v) case ImporterFeature::v: return debug << "::" #v;
         _c(OpenData)
+        _c(Streaming)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -145,7 +189,8 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
 
 Debug& operator<<(Debug& debug, const ImporterFeatures value) {
     return Containers::enumSetDebugOutput(debug, value, "Audio::ImporterFeatures{}", {
-        ImporterFeature::OpenData});
+        ImporterFeature::OpenData,
+        ImporterFeature::Streaming});
 }
 
 }}
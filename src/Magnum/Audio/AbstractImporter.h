@@ -44,7 +44,14 @@ namespace Magnum { namespace Audio {
 */
 enum class ImporterFeature: UnsignedByte {
     /** Opening files from raw data using @ref AbstractImporter::openData() */
-    OpenData = 1 << 0
+    OpenData = 1 << 0,
+
+    /**
+     * Incremental decoding using @ref AbstractImporter::frameCount(),
+     * @ref AbstractImporter::seek() and @ref AbstractImporter::read()
+     * @m_since_latest
+     */
+    Streaming = 1 << 1
 };
 
 /**
@@ -79,6 +86,22 @@ around in order to have the returned data valid. Moreover, all returned
 deleters --- this is to avoid potential dangling function pointer calls when
 destructing such instances after the plugin module has been unloaded.
 
+@section Audio-AbstractImporter-streaming Streaming
+
+Instead of decoding the whole file at once using @ref data(), importers
+advertising @ref ImporterFeature::Streaming allow decoding the data in
+smaller pieces into a caller-provided memory. That's useful mainly for long
+music tracks, where the decoded data would occupy a lot of memory --- see
+@ref StreamingSource for a convenience wrapper that keeps a ring of buffers
+queued on a @ref Source.
+
+@snippet MagnumAudio.cpp AbstractImporter-streaming
+
+A *frame* is one sample for each channel, its size in bytes is given by
+@ref frameSize(BufferFormat). The @ref read() function always reads only
+whole frames and returns their count, zero is returned once the end of the
+stream is reached.
+
 @section Audio-AbstractImporter-subclassing Subclassing
 
 Plugin implements function @ref doFeatures(), @ref doIsOpened(), one of or both
@@ -93,6 +116,11 @@ checked by the implementation:
     is any file opened.
 -   Function @ref doOpenData() is called only if @ref ImporterFeature::OpenData
     is supported.
+-   Functions @ref doFrameCount(), @ref doSeek() and @ref doRead() are called
+    only if @ref ImporterFeature::Streaming is supported, @ref doSeek() is
+    called only with a frame not larger than @ref frameCount() and
+    @ref doRead() only with a destination large enough for at least one
+    frame.
 -   All `do*()` implementations working on opened file are called only if
     there is any file opened.
 
@@ -192,6 +220,46 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Sample data */
         Containers::Array<char> data();
 
+        /**
+         * @brief Frame count
+         * @m_since_latest
+         *
+         * Count of frames in the opened file, one frame being one sample
+         * for each channel. Available only if @ref ImporterFeature::Streaming
+         * is supported. Expects that a file is opened.
+         * @see @ref features(), @ref frameSize(BufferFormat)
+         */
+        UnsignedLong frameCount() const;
+
+        /**
+         * @brief Seek to given frame
+         * @m_since_latest
+         *
+         * Next call to @ref read() will return data starting at @p frame.
+         * Available only if @ref ImporterFeature::Streaming is supported.
+         * Expects that a file is opened and that @p frame is not larger than
+         * @ref frameCount(). Returns @cpp false @ce if the seek failed, in
+         * which case the read position is unspecified.
+         * @see @ref features()
+         */
+        bool seek(UnsignedLong frame);
+
+        /**
+         * @brief Read frames into given memory
+         * @m_since_latest
+         *
+         * Decodes as many whole frames from the current position as fit into
+         * @p destination, in the layout given by @ref format(), and advances
+         * the position past them. Returns count of frames written, which is
+         * less than what would fit only if the end of the stream was reached,
+         * and @cpp 0 @ce once there is nothing left to read. Available only if
+         * @ref ImporterFeature::Streaming is supported. Expects that a file
+         * is opened and that @p destination is large enough for at least one
+         * frame.
+         * @see @ref features(), @ref seek(), @ref frameSize(BufferFormat)
+         */
+        std::size_t read(Containers::ArrayView<char> destination);
+
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
         /**
@@ -228,6 +296,24 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         /** @brief Implementation for @ref data() */
         virtual Containers::Array<char> doData() = 0;
+
+        /**
+         * @brief Implementation for @ref frameCount()
+         * @m_since_latest
+         */
+        virtual UnsignedLong doFrameCount() const;
+
+        /**
+         * @brief Implementation for @ref seek()
+         * @m_since_latest
+         */
+        virtual bool doSeek(UnsignedLong frame);
+
+        /**
+         * @brief Implementation for @ref read()
+         * @m_since_latest
+         */
+        virtual std::size_t doRead(Containers::ArrayView<char> destination);
 };
 
 }}
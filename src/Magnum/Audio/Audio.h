@@ -44,7 +44,9 @@ enum class BufferFormat: ALenum;
 
 class Buffer;
 class Context;
+class Resampler;
 class Source;
+class StreamingSource;
 /* Renderer used only statically */
 
 template<UnsignedInt> class Playable;
@@ -25,10 +25,93 @@
 
 #include "BufferFormat.h"
 
+#include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
 namespace Magnum { namespace Audio {
 
+UnsignedInt sampleSize(const BufferFormat format) {
+    switch(format) {
+        case BufferFormat::Mono8:
+        case BufferFormat::Stereo8:
+        case BufferFormat::MonoALaw:
+        case BufferFormat::StereoALaw:
+        case BufferFormat::MonoMuLaw:
+        case BufferFormat::StereoMuLaw:
+        case BufferFormat::Quad8:
+        case BufferFormat::Rear8:
+        case BufferFormat::Surround51Channel8:
+        case BufferFormat::Surround61Channel8:
+        case BufferFormat::Surround71Channel8:
+            return 1;
+        case BufferFormat::Mono16:
+        case BufferFormat::Stereo16:
+        case BufferFormat::Quad16:
+        case BufferFormat::Rear16:
+        case BufferFormat::Surround51Channel16:
+        case BufferFormat::Surround61Channel16:
+        case BufferFormat::Surround71Channel16:
+            return 2;
+        case BufferFormat::MonoFloat:
+        case BufferFormat::StereoFloat:
+        case BufferFormat::Quad32:
+        case BufferFormat::Rear32:
+        case BufferFormat::Surround51Channel32:
+        case BufferFormat::Surround61Channel32:
+        case BufferFormat::Surround71Channel32:
+            return 4;
+        case BufferFormat::MonoDouble:
+        case BufferFormat::StereoDouble:
+            return 8;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE("Audio::sampleSize(): invalid format" << format, {});
+}
+
+UnsignedInt channelCount(const BufferFormat format) {
+    switch(format) {
+        case BufferFormat::Mono8:
+        case BufferFormat::Mono16:
+        case BufferFormat::MonoALaw:
+        case BufferFormat::MonoMuLaw:
+        case BufferFormat::MonoFloat:
+        case BufferFormat::MonoDouble:
+            return 1;
+        case BufferFormat::Stereo8:
+        case BufferFormat::Stereo16:
+        case BufferFormat::StereoALaw:
+        case BufferFormat::StereoMuLaw:
+        case BufferFormat::StereoFloat:
+        case BufferFormat::StereoDouble:
+        case BufferFormat::Rear8:
+        case BufferFormat::Rear16:
+        case BufferFormat::Rear32:
+            return 2;
+        case BufferFormat::Quad8:
+        case BufferFormat::Quad16:
+        case BufferFormat::Quad32:
+            return 4;
+        case BufferFormat::Surround51Channel8:
+        case BufferFormat::Surround51Channel16:
+        case BufferFormat::Surround51Channel32:
+            return 6;
+        case BufferFormat::Surround61Channel8:
+        case BufferFormat::Surround61Channel16:
+        case BufferFormat::Surround61Channel32:
+            return 7;
+        case BufferFormat::Surround71Channel8:
+        case BufferFormat::Surround71Channel16:
+        case BufferFormat::Surround71Channel32:
+            return 8;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE("Audio::channelCount(): invalid format" << format, {});
+}
+
+UnsignedInt frameSize(const BufferFormat format) {
+    return channelCount(format)*sampleSize(format);
+}
+
 Debug& operator<<(Debug& debug, const BufferFormat value) {
     debug << "Audio::BufferFormat" << Debug::nospace;
 
@@ -190,6 +190,38 @@ enum class BufferFormat: ALenum {
     Surround71Channel32 = AL_FORMAT_71CHN32
 };
 
+/**
+@brief Size of a single sample in given format
+@m_since_latest
+
+Size of one sample of one channel, i.e. returns @cpp 2 @ce for both
+@ref BufferFormat::Mono16 and @ref BufferFormat::Stereo16. Expects a valid
+format.
+@see @ref channelCount(BufferFormat), @ref frameSize(BufferFormat)
+*/
+MAGNUM_AUDIO_EXPORT UnsignedInt sampleSize(BufferFormat format);
+
+/**
+@brief Channel count of given format
+@m_since_latest
+
+Expects a valid format.
+@see @ref sampleSize(BufferFormat), @ref frameSize(BufferFormat)
+*/
+MAGNUM_AUDIO_EXPORT UnsignedInt channelCount(BufferFormat format);
+
+/**
+@brief Size of a single frame in given format
+@m_since_latest
+
+A frame is one sample for each channel, i.e. returns @cpp 4 @ce for
+@ref BufferFormat::Stereo16 or @cpp 6 @ce for
+@ref BufferFormat::Surround51Channel8. Same as @ref sampleSize(BufferFormat)
+multiplied by @ref channelCount(BufferFormat). Expects a valid format.
+@see @ref AbstractImporter::read()
+*/
+MAGNUM_AUDIO_EXPORT UnsignedInt frameSize(BufferFormat format);
+
 /** @debugoperatorenum{BufferFormat} */
 MAGNUM_AUDIO_EXPORT Debug& operator<<(Debug& debug, BufferFormat value);
 
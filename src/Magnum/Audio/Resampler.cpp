@@ -0,0 +1,144 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Constants.h"
+
+namespace Magnum { namespace Audio {
+
+namespace {
+
+UnsignedInt greatestCommonDivisor(UnsignedInt a, UnsignedInt b) {
+    while(b) {
+        const UnsignedInt t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+}
+
+Resampler::Resampler(const UnsignedInt channelCount, const UnsignedInt sourceFrequency, const UnsignedInt destinationFrequency, const UnsignedInt tapCount): _channelCount{channelCount}, _sourceFrequency{sourceFrequency}, _destinationFrequency{destinationFrequency}, _tapCount{tapCount} {
+    CORRADE_ASSERT(channelCount && sourceFrequency && destinationFrequency && tapCount,
+        "Audio::Resampler: expected non-zero channel count, frequencies and tap count but got" << channelCount << Debug::nospace << "," << sourceFrequency << Debug::nospace << "," << destinationFrequency << "and" << tapCount, );
+
+    const UnsignedInt divisor = greatestCommonDivisor(sourceFrequency, destinationFrequency);
+    _up = destinationFrequency/divisor;
+    _down = sourceFrequency/divisor;
+
+    /* Windowed sinc prototype filter at the upsampled rate, with the cutoff
+       slightly below the Nyquist frequency of the lower of the two rates to
+       leave room for the transition band */
+    const std::size_t length = std::size_t(_up)*_tapCount;
+    const Double cutoff = 0.5*0.95*std::min(1.0, Double(_up)/_down)/_up;
+    const Double center = (length - 1)*0.5;
+    _filter = Containers::Array<Float>{Containers::NoInit, length};
+    for(std::size_t phase = 0; phase != _up; ++phase) {
+        Float* const coefficients = _filter.data() + phase*_tapCount;
+
+        /* Tap j of a phase gets applied to the input frame j - tapCount + 1
+           relative to the current one, so the phase is stored reversed */
+        Double sum = 0.0;
+        for(std::size_t j = 0; j != _tapCount; ++j) {
+            const std::size_t i = phase + (_tapCount - 1 - j)*_up;
+            const Double x = i - center;
+            const Double sinc = x == 0.0 ? 2.0*cutoff :
+                std::sin(2.0*Math::Constants<Double>::pi()*cutoff*x)/(Math::Constants<Double>::pi()*x);
+            const Double t = (i + 0.5)/length;
+            const Double window = 0.42 - 0.5*std::cos(2.0*Math::Constants<Double>::pi()*t) + 0.08*std::cos(4.0*Math::Constants<Double>::pi()*t);
+            coefficients[j] = sinc*window;
+            sum += coefficients[j];
+        }
+
+        /* Normalize each phase to unit gain so a constant signal stays
+           constant */
+        for(std::size_t j = 0; j != _tapCount; ++j)
+            coefficients[j] /= sum;
+    }
+
+    reset();
+}
+
+std::size_t Resampler::outputFrameCount(const std::size_t inputFrameCount) const {
+    const UnsignedLong end = UnsignedLong(inputFrameCount)*_up;
+    return end > _time ? (end - _time + _down - 1)/_down : 0;
+}
+
+std::size_t Resampler::process(const Containers::ArrayView<const Float> source, const Containers::ArrayView<Float> destination) {
+    CORRADE_ASSERT(source.size() % _channelCount == 0,
+        "Audio::Resampler::process(): can't split" << source.size() << "samples into" << _channelCount << "channels", {});
+    const std::size_t inputFrameCount = source.size()/_channelCount;
+    #ifndef CORRADE_NO_ASSERT
+    const std::size_t outputFrameCount = this->outputFrameCount(inputFrameCount);
+    #endif
+    CORRADE_ASSERT(destination.size() >= outputFrameCount*_channelCount,
+        "Audio::Resampler::process(): expected destination size at least" << outputFrameCount*_channelCount << "but got" << destination.size(), {});
+
+    /* Append the input after the history */
+    const std::size_t historySize = std::size_t(_tapCount - 1)*_channelCount;
+    const std::size_t bufferSize = historySize + source.size();
+    if(_buffer.size() < bufferSize) {
+        Containers::Array<Float> buffer{Containers::NoInit, bufferSize};
+        std::copy(_buffer.begin(), _buffer.begin() + historySize, buffer.begin());
+        _buffer = std::move(buffer);
+    }
+    std::copy(source.begin(), source.end(), _buffer.begin() + historySize);
+
+    const UnsignedLong end = UnsignedLong(inputFrameCount)*_up;
+    std::size_t out = 0;
+    for(; _time < end; _time += _down, ++out) {
+        const Float* const coefficients = _filter.data() + (_time % _up)*_tapCount;
+        const Float* const in = _buffer.data() + (_time/_up)*_channelCount;
+        Float* const dst = destination.data() + out*_channelCount;
+
+        for(std::size_t c = 0; c != _channelCount; ++c) dst[c] = 0.0f;
+        for(std::size_t j = 0; j != _tapCount; ++j) {
+            const Float coefficient = coefficients[j];
+            const Float* const frame = in + j*_channelCount;
+            for(std::size_t c = 0; c != _channelCount; ++c)
+                dst[c] += coefficient*frame[c];
+        }
+    }
+    _time -= end;
+
+    /* Keep the last tapCount - 1 frames for the next call */
+    std::copy(_buffer.begin() + bufferSize - historySize, _buffer.begin() + bufferSize, _buffer.begin());
+
+    return out;
+}
+
+void Resampler::reset() {
+    _time = 0;
+    _buffer = Containers::Array<Float>{Containers::ValueInit, std::size_t(_tapCount - 1)*_channelCount};
+}
+
+}}
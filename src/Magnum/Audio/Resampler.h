@@ -0,0 +1,141 @@
+#ifndef Magnum_Audio_Resampler_h
+#define Magnum_Audio_Resampler_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::Resampler
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Polyphase sample rate converter
+@m_since_latest
+
+Converts interleaved floating-point samples between two sample rates using a
+rational polyphase FIR filter. The ratio between the two frequencies is
+reduced to @f$ \frac{L}{M} @f$ and the input is conceptually upsampled
+@f$ L @f$ times, lowpass-filtered with a Blackman-windowed sinc and
+downsampled @f$ M @f$ times, evaluating only the filter taps that contribute
+to the output. The filter is split into @f$ L @f$ phases of @ref tapCount()
+taps each, stored in @f$ L \cdot \text{tapCount} @f$ floats --- for example
+converting from 44.1 kHz to 48 kHz has @f$ L = 160 @f$, while frequencies
+with a small common divisor result in a large filter.
+
+The resampler keeps the last few input frames and the fractional position
+between calls to @ref process(), so a stream can be converted in chunks of
+arbitrary size with the same result as converting it all at once:
+
+@snippet MagnumAudio.cpp Resampler
+
+The filter is causal, which means the output is delayed by about half of
+@ref tapCount() input frames, with the stream start preceded by silence. The
+cutoff frequency is set slightly below the Nyquist frequency of the lower of
+the two rates. With the default of 32 taps the stopband attenuation is
+around 75 dB.
+
+Use @ref convertSamplesInto() to convert from and to other sample formats.
+*/
+class MAGNUM_AUDIO_EXPORT Resampler {
+    public:
+        /**
+         * @brief Constructor
+         * @param channelCount          Count of interleaved channels
+         * @param sourceFrequency       Source sample frequency
+         * @param destinationFrequency  Destination sample frequency
+         * @param tapCount              Filter tap count for each phase
+         *
+         * Expects that all parameters are non-zero.
+         */
+        explicit Resampler(UnsignedInt channelCount, UnsignedInt sourceFrequency, UnsignedInt destinationFrequency, UnsignedInt tapCount = 32);
+
+        /** @brief Channel count */
+        UnsignedInt channelCount() const { return _channelCount; }
+
+        /** @brief Source sample frequency */
+        UnsignedInt sourceFrequency() const { return _sourceFrequency; }
+
+        /** @brief Destination sample frequency */
+        UnsignedInt destinationFrequency() const { return _destinationFrequency; }
+
+        /** @brief Filter tap count for each phase */
+        UnsignedInt tapCount() const { return _tapCount; }
+
+        /**
+         * @brief Count of output frames for given input
+         *
+         * Returns how many frames the next @ref process() call produces
+         * from @p inputFrameCount frames. Depends on the current position,
+         * the total for a sequence of calls is the same as when processing
+         * everything at once.
+         */
+        std::size_t outputFrameCount(std::size_t inputFrameCount) const;
+
+        /**
+         * @brief Process samples
+         * @param source        Interleaved input samples
+         * @param destination   Interleaved output samples
+         * @return Count of frames written to @p destination
+         *
+         * Consumes all of @p source. Expects that size of @p source is
+         * divisible by @ref channelCount() and @p destination is large
+         * enough for @ref outputFrameCount() frames.
+         */
+        std::size_t process(Containers::ArrayView<const Float> source, Containers::ArrayView<Float> destination);
+
+        /**
+         * @brief Reset the state
+         *
+         * Clears the input history and the position, so the next
+         * @ref process() call behaves as if it was the first.
+         */
+        void reset();
+
+    private:
+        UnsignedInt _channelCount, _sourceFrequency, _destinationFrequency, _tapCount;
+        /* The reduced ratio, destination frequency is _up/_down times the
+           source frequency */
+        UnsignedInt _up, _down;
+        /* Position of the next output frame relative to the first input
+           frame of the next process() call, in units of the upsampled rate */
+        UnsignedLong _time{};
+        /* _up phases of _tapCount coefficients, each phase reversed so it
+           can be applied to input frames in memory order */
+        Containers::Array<Float> _filter;
+        /* Last _tapCount - 1 input frames followed by the input of the
+           current process() call, grown on demand */
+        Containers::Array<Float> _buffer;
+};
+
+}}
+
+#endif
@@ -0,0 +1,295 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SampleConversion.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Audio/BufferFormat.h"
+
+namespace Magnum { namespace Audio {
+
+namespace {
+
+enum class SampleType { UnsignedByte, Short, ALaw, MuLaw, Float, Double };
+
+SampleType sampleType(const BufferFormat format) {
+    switch(format) {
+        case BufferFormat::Mono8:
+        case BufferFormat::Stereo8:
+        case BufferFormat::Quad8:
+        case BufferFormat::Rear8:
+        case BufferFormat::Surround51Channel8:
+        case BufferFormat::Surround61Channel8:
+        case BufferFormat::Surround71Channel8:
+            return SampleType::UnsignedByte;
+        case BufferFormat::Mono16:
+        case BufferFormat::Stereo16:
+        case BufferFormat::Quad16:
+        case BufferFormat::Rear16:
+        case BufferFormat::Surround51Channel16:
+        case BufferFormat::Surround61Channel16:
+        case BufferFormat::Surround71Channel16:
+            return SampleType::Short;
+        case BufferFormat::MonoALaw:
+        case BufferFormat::StereoALaw:
+            return SampleType::ALaw;
+        case BufferFormat::MonoMuLaw:
+        case BufferFormat::StereoMuLaw:
+            return SampleType::MuLaw;
+        case BufferFormat::MonoFloat:
+        case BufferFormat::StereoFloat:
+        case BufferFormat::Quad32:
+        case BufferFormat::Rear32:
+        case BufferFormat::Surround51Channel32:
+        case BufferFormat::Surround61Channel32:
+        case BufferFormat::Surround71Channel32:
+            return SampleType::Float;
+        case BufferFormat::MonoDouble:
+        case BufferFormat::StereoDouble:
+            return SampleType::Double;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* The sample data may come directly from a file and thus don't need to be
+   aligned, memcpy() makes the access well-defined without preventing
+   vectorization */
+template<class T> inline T load(const char* const data, const std::size_t i) {
+    T out;
+    std::memcpy(&out, data + i*sizeof(T), sizeof(T));
+    return out;
+}
+
+template<class T> inline void store(char* const data, const std::size_t i, const T value) {
+    std::memcpy(data + i*sizeof(T), &value, sizeof(T));
+}
+
+/* ITU-T G.711 decoding to 16-bit linear PCM */
+inline Short aLawToLinear(UnsignedByte value) {
+    value ^= 0x55;
+    const Int segment = (value & 0x70) >> 4;
+    Int magnitude = (value & 0x0f) << 4;
+    if(segment == 0) magnitude += 8;
+    else magnitude = (magnitude + 0x108) << (segment - 1);
+    return Short((value & 0x80) ? magnitude : -magnitude);
+}
+
+inline Short muLawToLinear(UnsignedByte value) {
+    value = ~value;
+    const Int magnitude = (((value & 0x0f) << 3) + 0x84) << ((value & 0x70) >> 4);
+    return Short((value & 0x80) ? 0x84 - magnitude : magnitude - 0x84);
+}
+
+/* ITU-T G.711 encoding from 16-bit linear PCM */
+inline UnsignedByte linearToALaw(const Short value) {
+    Int pcm = value >> 3;
+    Int mask;
+    if(pcm >= 0) mask = 0xd5;
+    else {
+        mask = 0x55;
+        pcm = -pcm - 1;
+    }
+
+    Int segment = 0;
+    while(segment != 8 && pcm >= (0x20 << segment)) ++segment;
+    if(segment == 8) return UnsignedByte(0x7f ^ mask);
+
+    return UnsignedByte(((segment << 4)|((pcm >> (segment < 2 ? 1 : segment)) & 0x0f)) ^ mask);
+}
+
+inline UnsignedByte linearToMuLaw(const Short value) {
+    Int pcm = value >> 2;
+    Int mask;
+    if(pcm < 0) {
+        pcm = -pcm;
+        mask = 0x7f;
+    } else mask = 0xff;
+    if(pcm > 8159) pcm = 8159;
+    pcm += 0x84 >> 2;
+
+    Int segment = 0;
+    while(segment != 8 && pcm >= (0x40 << segment)) ++segment;
+    if(segment == 8) return UnsignedByte(0x7f ^ mask);
+
+    return UnsignedByte(((segment << 4)|((pcm >> (segment + 1)) & 0x0f)) ^ mask);
+}
+
+/* Turns NaNs into silence. Done with integer operations, as a float
+   comparison in a ternary would prevent the loops from being vectorized. */
+inline Float silenceNan(Float value) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &value, sizeof(Float));
+    bits &= -UnsignedInt((bits & 0x7fffffffu) <= 0x7f800000u);
+    std::memcpy(&value, &bits, sizeof(Float));
+    return value;
+}
+
+/* The comparisons are written so they compile to min/max instructions */
+inline Float scaleToUnsignedByte(Float value) {
+    value = silenceNan(value)*128.0f + 128.5f;
+    value = 0.0f < value ? value : 0.0f;
+    return 255.0f < value ? 255.0f : value;
+}
+
+inline Float scaleToShort(Float value) {
+    value = silenceNan(value)*32768.0f + 32768.5f;
+    value = 0.0f < value ? value : 0.0f;
+    return 65535.0f < value ? 65535.0f : value;
+}
+
+inline Short floatToShort(const Float value) {
+    /* The value is biased to be positive so the truncation rounds to
+       nearest */
+    return Short(Int(scaleToShort(value)) - 32768);
+}
+
+}
+
+void convertSamplesInto(const BufferFormat format, const Containers::ArrayView<const char> source, const Containers::ArrayView<Float> destination) {
+    const UnsignedInt size = sampleSize(format);
+    CORRADE_ASSERT(source.size() % size == 0,
+        "Audio::convertSamplesInto(): source size" << source.size() << "is not a multiple of" << format << "sample size", );
+    CORRADE_ASSERT(destination.size() == source.size()/size,
+        "Audio::convertSamplesInto(): expected destination size" << source.size()/size << "but got" << destination.size(), );
+
+    const char* const src = source.data();
+    Float* const dst = destination.data();
+    const std::size_t count = destination.size();
+    switch(sampleType(format)) {
+        case SampleType::UnsignedByte:
+            for(std::size_t i = 0; i != count; ++i)
+                dst[i] = (Int(UnsignedByte(src[i])) - 128)*(1.0f/128.0f);
+            return;
+        case SampleType::Short:
+            for(std::size_t i = 0; i != count; ++i)
+                dst[i] = load<Short>(src, i)*(1.0f/32768.0f);
+            return;
+        case SampleType::ALaw:
+            for(std::size_t i = 0; i != count; ++i)
+                dst[i] = aLawToLinear(src[i])*(1.0f/32768.0f);
+            return;
+        case SampleType::MuLaw:
+            for(std::size_t i = 0; i != count; ++i)
+                dst[i] = muLawToLinear(src[i])*(1.0f/32768.0f);
+            return;
+        case SampleType::Float:
+            std::memcpy(dst, src, count*sizeof(Float));
+            return;
+        case SampleType::Double:
+            for(std::size_t i = 0; i != count; ++i)
+                dst[i] = Float(load<Double>(src, i));
+            return;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+Containers::Array<Float> convertSamples(const BufferFormat format, const Containers::ArrayView<const char> source) {
+    Containers::Array<Float> out{Containers::NoInit, source.size()/sampleSize(format)};
+    convertSamplesInto(format, source, out);
+    return out;
+}
+
+void convertSamplesInto(const Containers::ArrayView<const Float> source, const BufferFormat format, const Containers::ArrayView<char> destination) {
+    const UnsignedInt size = sampleSize(format);
+    CORRADE_ASSERT(destination.size() == source.size()*size,
+        "Audio::convertSamplesInto(): expected destination size" << source.size()*size << "but got" << destination.size(), );
+
+    const Float* const src = source.data();
+    char* const dst = destination.data();
+    const std::size_t count = source.size();
+    switch(sampleType(format)) {
+        case SampleType::UnsignedByte:
+            for(std::size_t i = 0; i != count; ++i)
+                dst[i] = char(UnsignedByte(Int(scaleToUnsignedByte(src[i]))));
+            return;
+        case SampleType::Short:
+            for(std::size_t i = 0; i != count; ++i)
+                store<Short>(dst, i, floatToShort(src[i]));
+            return;
+        case SampleType::ALaw:
+            for(std::size_t i = 0; i != count; ++i)
+                dst[i] = char(linearToALaw(floatToShort(src[i])));
+            return;
+        case SampleType::MuLaw:
+            for(std::size_t i = 0; i != count; ++i)
+                dst[i] = char(linearToMuLaw(floatToShort(src[i])));
+            return;
+        case SampleType::Float:
+            std::memcpy(dst, src, count*sizeof(Float));
+            return;
+        case SampleType::Double:
+            for(std::size_t i = 0; i != count; ++i)
+                store<Double>(dst, i, src[i]);
+            return;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+Containers::Array<char> convertSamples(const Containers::ArrayView<const Float> source, const BufferFormat format) {
+    Containers::Array<char> out{Containers::NoInit, source.size()*sampleSize(format)};
+    convertSamplesInto(source, format, out);
+    return out;
+}
+
+void deinterleaveInto(const Containers::ArrayView<const Float> interleaved, const UnsignedInt channelCount, const Containers::ArrayView<Float> planar) {
+    CORRADE_ASSERT(channelCount && interleaved.size() % channelCount == 0,
+        "Audio::deinterleaveInto(): can't split" << interleaved.size() << "samples into" << channelCount << "channels", );
+    CORRADE_ASSERT(planar.size() == interleaved.size(),
+        "Audio::deinterleaveInto(): expected destination size" << interleaved.size() << "but got" << planar.size(), );
+
+    const std::size_t frameCount = interleaved.size()/channelCount;
+    /* Writing one channel at a time keeps the stores contiguous */
+    for(std::size_t c = 0; c != channelCount; ++c) {
+        Float* const dst = planar.data() + c*frameCount;
+        const Float* const src = interleaved.data() + c;
+        for(std::size_t i = 0; i != frameCount; ++i)
+            dst[i] = src[i*channelCount];
+    }
+}
+
+void interleaveInto(const Containers::ArrayView<const Float> planar, const UnsignedInt channelCount, const Containers::ArrayView<Float> interleaved) {
+    CORRADE_ASSERT(channelCount && planar.size() % channelCount == 0,
+        "Audio::interleaveInto(): can't split" << planar.size() << "samples into" << channelCount << "channels", );
+    CORRADE_ASSERT(interleaved.size() == planar.size(),
+        "Audio::interleaveInto(): expected destination size" << planar.size() << "but got" << interleaved.size(), );
+
+    const std::size_t frameCount = planar.size()/channelCount;
+    /* Reading one channel at a time keeps the loads contiguous */
+    for(std::size_t c = 0; c != channelCount; ++c) {
+        const Float* const src = planar.data() + c*frameCount;
+        Float* const dst = interleaved.data() + c;
+        for(std::size_t i = 0; i != frameCount; ++i)
+            dst[i*channelCount] = src[i];
+    }
+}
+
+}}
@@ -0,0 +1,132 @@
+#ifndef Magnum_Audio_SampleConversion_h
+#define Magnum_Audio_SampleConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Audio::convertSamples(), @ref Magnum::Audio::convertSamplesInto(), @ref Magnum::Audio::interleaveInto(), @ref Magnum::Audio::deinterleaveInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Convert samples to floating-point
+@param format       Source format
+@param source       Source sample data
+@param destination  Destination floating-point samples
+@m_since_latest
+
+Converts samples of any @ref BufferFormat to floating-point values, keeping
+the channel layout. Unsigned 8-bit samples are mapped from @f$ [0, 255] @f$ to
+@f$ [-1, \frac{127}{128}] @f$, signed 16-bit samples from
+@f$ [-32768, 32767] @f$ to @f$ [-1, \frac{32767}{32768}] @f$ and A-Law and
+μ-Law samples are decoded according to the ITU-T G.711 standard and then
+mapped the same as 16-bit samples. Floating-point samples are copied and
+double-precision samples are cast to single precision.
+
+Expects that size of @p source is divisible by @ref sampleSize(BufferFormat)
+and @p destination has exactly as many items as there are samples in
+@p source.
+@see @ref convertSamples(BufferFormat, Containers::ArrayView<const char>),
+    @ref deinterleaveInto()
+*/
+MAGNUM_AUDIO_EXPORT void convertSamplesInto(BufferFormat format, Containers::ArrayView<const char> source, Containers::ArrayView<Float> destination);
+
+/**
+@brief Convert samples to floating-point
+@m_since_latest
+
+Allocates a destination array and calls
+@ref convertSamplesInto(BufferFormat, Containers::ArrayView<const char>, Containers::ArrayView<Float>).
+*/
+MAGNUM_AUDIO_EXPORT Containers::Array<Float> convertSamples(BufferFormat format, Containers::ArrayView<const char> source);
+
+/**
+@brief Convert floating-point samples to given format
+@param source       Source floating-point samples
+@param format       Destination format
+@param destination  Destination sample data
+@m_since_latest
+
+Inverse of @ref convertSamplesInto(BufferFormat, Containers::ArrayView<const char>, Containers::ArrayView<Float>).
+Values outside of the @f$ [-1, 1] @f$ range are clamped for integer and
+A-Law / μ-Law formats, NaNs are converted to silence. Integer samples are
+rounded to nearest, so a conversion from an integer format to floating-point
+and back is lossless.
+
+Expects that size of @p destination is exactly size of @p source multiplied by
+@ref sampleSize(BufferFormat).
+@see @ref convertSamples(Containers::ArrayView<const Float>, BufferFormat),
+    @ref interleaveInto()
+*/
+MAGNUM_AUDIO_EXPORT void convertSamplesInto(Containers::ArrayView<const Float> source, BufferFormat format, Containers::ArrayView<char> destination);
+
+/**
+@brief Convert floating-point samples to given format
+@m_since_latest
+
+Allocates a destination array and calls
+@ref convertSamplesInto(Containers::ArrayView<const Float>, BufferFormat, Containers::ArrayView<char>).
+*/
+MAGNUM_AUDIO_EXPORT Containers::Array<char> convertSamples(Containers::ArrayView<const Float> source, BufferFormat format);
+
+/**
+@brief Convert interleaved samples to planar
+@param interleaved  Source interleaved samples
+@param channelCount Channel count
+@param planar       Destination planar samples
+@m_since_latest
+
+The @p planar output contains all samples of the first channel, followed by
+all samples of the second channel etc. Expects that @p channelCount is
+non-zero, size of @p interleaved is divisible by it and @p planar has the same
+size as @p interleaved.
+@see @ref interleaveInto(), @ref channelCount(BufferFormat)
+*/
+MAGNUM_AUDIO_EXPORT void deinterleaveInto(Containers::ArrayView<const Float> interleaved, UnsignedInt channelCount, Containers::ArrayView<Float> planar);
+
+/**
+@brief Convert planar samples to interleaved
+@param planar       Source planar samples
+@param channelCount Channel count
+@param interleaved  Destination interleaved samples
+@m_since_latest
+
+Inverse of @ref deinterleaveInto(). Expects that @p channelCount is non-zero,
+size of @p planar is divisible by it and @p interleaved has the same size as
+@p planar.
+*/
+MAGNUM_AUDIO_EXPORT void interleaveInto(Containers::ArrayView<const Float> planar, UnsignedInt channelCount, Containers::ArrayView<Float> interleaved);
+
+}}
+
+#endif
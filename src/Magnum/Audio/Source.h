@@ -47,8 +47,8 @@ namespace Magnum { namespace Audio {
 /**
 @brief Source
 
-Manages positional audio source.
-@todo Expose convenient API for buffer queuing
+Manages positional audio source. See @ref StreamingSource for a convenience
+wrapper that streams data from an importer through a ring of queued buffers.
 */
 class MAGNUM_AUDIO_EXPORT Source {
     public:
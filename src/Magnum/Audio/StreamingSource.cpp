@@ -0,0 +1,194 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StreamingSource.h"
+
+#include <new>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio {
+
+struct StreamingSource::State {
+    explicit State(AbstractImporter& importer, UnsignedInt bufferCount, std::size_t bufferFrameCount);
+
+    /* Fills the buffer with at most bufferFrameCount frames, returns count
+       of frames written */
+    std::size_t fill(Buffer& buffer);
+    /* Fills and queues all free buffers until the stream ends */
+    void queueFree();
+
+    AbstractImporter& importer;
+    BufferFormat format;
+    UnsignedInt frequency;
+    UnsignedInt frameSize;
+    std::size_t bufferFrameCount;
+
+    /* The buffers need to be destroyed only after the source, otherwise the
+       deletion would fail as they're still attached to it */
+    Containers::Array<Buffer> buffers;
+    Containers::Array<bool> queued;
+    /* Scratch memory for passing buffer references to Source, to avoid
+       allocating on every update() */
+    Containers::Array<Containers::Reference<Buffer>> references;
+    Containers::Array<char> data;
+    Source source;
+
+    bool looping = false;
+    bool playing = false;
+};
+
+StreamingSource::State::State(AbstractImporter& importer, const UnsignedInt bufferCount, const std::size_t bufferFrameCount): importer(importer), format{importer.format()}, frequency{importer.frequency()}, frameSize{Audio::frameSize(format)}, bufferFrameCount{bufferFrameCount}, buffers{bufferCount}, queued{Containers::ValueInit, bufferCount}, references{Containers::NoInit, bufferCount}, data{Containers::NoInit, bufferFrameCount*frameSize} {
+    for(std::size_t i = 0; i != bufferCount; ++i)
+        new(&references[i]) Containers::Reference<Buffer>{buffers[i]};
+}
+
+std::size_t StreamingSource::State::fill(Buffer& buffer) {
+    std::size_t count = 0;
+    while(count != bufferFrameCount) {
+        const std::size_t read = importer.read(data.suffix(count*frameSize));
+        count += read;
+        if(read) continue;
+
+        /* End of the stream. Wrap around if looping, unless there's nothing
+           to read at all. */
+        if(!looping || !importer.frameCount() || !importer.seek(0)) break;
+    }
+
+    if(count) buffer.setData(format, data.prefix(count*frameSize), frequency);
+    return count;
+}
+
+void StreamingSource::State::queueFree() {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != buffers.size(); ++i) {
+        if(queued[i]) continue;
+        if(!fill(buffers[i])) break;
+        queued[i] = true;
+        references[count++] = buffers[i];
+    }
+
+    if(count) source.queueBuffers(references.prefix(count));
+}
+
+StreamingSource::StreamingSource(AbstractImporter& importer, const UnsignedInt bufferCount, const std::size_t bufferFrameCount) {
+    CORRADE_ASSERT(importer.features() & ImporterFeature::Streaming,
+        "Audio::StreamingSource: the importer doesn't support streaming", );
+    CORRADE_ASSERT(importer.isOpened(),
+        "Audio::StreamingSource: no file opened", );
+    CORRADE_ASSERT(bufferCount && bufferFrameCount,
+        "Audio::StreamingSource: expected non-zero buffer count and size but got" << bufferCount << "and" << bufferFrameCount, );
+
+    _state.emplace(importer, bufferCount, bufferFrameCount);
+}
+
+StreamingSource::StreamingSource(StreamingSource&&) noexcept = default;
+
+StreamingSource::~StreamingSource() = default;
+
+StreamingSource& StreamingSource::operator=(StreamingSource&&) noexcept = default;
+
+Source& StreamingSource::source() { return _state->source; }
+
+const Source& StreamingSource::source() const { return _state->source; }
+
+AbstractImporter& StreamingSource::importer() { return _state->importer; }
+
+UnsignedInt StreamingSource::bufferCount() const { return _state->buffers.size(); }
+
+std::size_t StreamingSource::bufferFrameCount() const { return _state->bufferFrameCount; }
+
+UnsignedInt StreamingSource::queuedBufferCount() const {
+    UnsignedInt count = 0;
+    for(bool queued: _state->queued) if(queued) ++count;
+    return count;
+}
+
+bool StreamingSource::isLooping() const { return _state->looping; }
+
+StreamingSource& StreamingSource::setLooping(const bool looping) {
+    _state->looping = looping;
+    return *this;
+}
+
+StreamingSource& StreamingSource::play() {
+    _state->playing = true;
+    update();
+    return *this;
+}
+
+StreamingSource& StreamingSource::pause() {
+    _state->playing = false;
+    _state->source.pause();
+    return *this;
+}
+
+StreamingSource& StreamingSource::stop() {
+    State& state = *_state;
+    state.playing = false;
+
+    /* Stopping marks all queued buffers as processed, so this unqueues all
+       of them */
+    state.source.stop();
+    update();
+    state.importer.seek(0);
+    return *this;
+}
+
+bool StreamingSource::update() {
+    State& state = *_state;
+
+    /* Unqueue buffers that finished playing. The source unqueues all
+       processed buffers, so it has to get all queued buffers. */
+    std::size_t queuedCount = 0;
+    for(std::size_t i = 0; i != state.buffers.size(); ++i)
+        if(state.queued[i]) state.references[queuedCount++] = state.buffers[i];
+    const std::size_t unqueuedCount = state.source.unqueueBuffers(state.references.prefix(queuedCount));
+    for(std::size_t i = 0; i != unqueuedCount; ++i) {
+        Buffer& buffer = state.references[i];
+        state.queued[&buffer - state.buffers.begin()] = false;
+    }
+
+    /* Refill and queue them again. Not while stopped, as stop() calls this
+       to unqueue everything and then seeks back. */
+    if(state.playing || state.source.state() == Source::State::Paused)
+        state.queueFree();
+
+    const bool anythingQueued = queuedBufferCount();
+
+    /* If the source ran out of data and stopped while playing, restart it */
+    if(state.playing && anythingQueued && state.source.state() != Source::State::Playing)
+        state.source.play();
+
+    return anythingQueued;
+}
+
+}}
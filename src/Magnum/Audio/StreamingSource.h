@@ -0,0 +1,187 @@
+#ifndef Magnum_Audio_StreamingSource_h
+#define Magnum_Audio_StreamingSource_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::StreamingSource
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Streaming source
+@m_since_latest
+
+Plays data from an @ref AbstractImporter supporting
+@ref ImporterFeature::Streaming without decoding the whole file upfront. Owns
+a @ref Source and a ring of @ref Buffer instances, each holding at most
+@ref bufferFrameCount() frames. Buffers that finished playing are refilled
+with further data from the importer and queued again in @ref update(), which
+is meant to be called periodically, for example once every frame:
+
+@snippet MagnumAudio.cpp StreamingSource-usage
+
+The ring has to be large enough to not run out of queued data between two
+@ref update() calls --- with the defaults it's four buffers of 8192 frames,
+which is about 0.75 seconds at 44.1 kHz. If the source runs out of data
+anyway, it stops and @ref update() restarts it once there are new buffers
+queued.
+
+The importer has to stay alive and opened for the whole lifetime of the
+source. Looping is implemented by seeking the importer back to the beginning
+once it reaches the end of the stream, @ref Source::setLooping() shouldn't be
+used on the underlying @ref source() as it would loop just the queued buffers.
+Other properties such as position or gain are set directly on the @ref source().
+*/
+class MAGNUM_AUDIO_EXPORT StreamingSource {
+    public:
+        /**
+         * @brief Constructor
+         * @param importer          Importer to stream from
+         * @param bufferCount       Count of buffers in the ring
+         * @param bufferFrameCount  Max count of frames in one buffer
+         *
+         * Expects that @p importer supports @ref ImporterFeature::Streaming,
+         * has a file opened and that both @p bufferCount and
+         * @p bufferFrameCount are non-zero. No data is read until
+         * @ref play() is called.
+         */
+        explicit StreamingSource(AbstractImporter& importer, UnsignedInt bufferCount = 4, std::size_t bufferFrameCount = 8192);
+
+        /** @brief Copying is not allowed */
+        StreamingSource(const StreamingSource&) = delete;
+
+        /** @brief Move constructor */
+        StreamingSource(StreamingSource&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes the source and all buffers.
+         */
+        ~StreamingSource();
+
+        /** @brief Copying is not allowed */
+        StreamingSource& operator=(const StreamingSource&) = delete;
+
+        /** @brief Move assignment */
+        StreamingSource& operator=(StreamingSource&&) noexcept;
+
+        /** @brief Underlying source */
+        Source& source();
+        const Source& source() const; /**< @overload */
+
+        /** @brief Importer the data are streamed from */
+        AbstractImporter& importer();
+
+        /** @brief Count of buffers in the ring */
+        UnsignedInt bufferCount() const;
+
+        /** @brief Max count of frames in one buffer */
+        std::size_t bufferFrameCount() const;
+
+        /**
+         * @brief Count of currently queued buffers
+         *
+         * Buffers that finished playing stay counted until the next
+         * @ref update().
+         */
+        UnsignedInt queuedBufferCount() const;
+
+        /**
+         * @brief Whether the stream is looping
+         *
+         * @see @ref setLooping()
+         */
+        bool isLooping() const;
+
+        /**
+         * @brief Set whether the stream is looping
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, the importer is seeked back to the beginning once it
+         * reaches the end of the stream. Default is @cpp false @ce.
+         */
+        StreamingSource& setLooping(bool looping);
+
+        /**
+         * @brief Play
+         * @return Reference to self (for method chaining)
+         *
+         * Fills and queues all free buffers and starts or resumes the
+         * playback.
+         * @see @ref update(), @ref Source::play()
+         */
+        StreamingSource& play();
+
+        /**
+         * @brief Pause
+         * @return Reference to self (for method chaining)
+         *
+         * @ref update() keeps buffers filled while paused, but doesn't
+         * resume the playback.
+         * @see @ref Source::pause()
+         */
+        StreamingSource& pause();
+
+        /**
+         * @brief Stop
+         * @return Reference to self (for method chaining)
+         *
+         * Stops the playback, unqueues all buffers and seeks the importer
+         * back to the beginning, so a subsequent @ref play() starts from the
+         * beginning.
+         * @see @ref Source::stop()
+         */
+        StreamingSource& stop();
+
+        /**
+         * @brief Refill and queue processed buffers
+         *
+         * Unqueues buffers that finished playing, refills them with further
+         * data from the importer and queues them again. If the source ran
+         * out of data and stopped while playing, restarts it. Returns
+         * @cpp false @ce if there's nothing queued anymore, which means the
+         * stream finished playing, @cpp true @ce otherwise. Call @ref stop()
+         * to rewind a finished stream before playing it again.
+         */
+        bool update();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
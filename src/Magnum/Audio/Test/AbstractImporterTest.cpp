@@ -63,6 +63,13 @@ struct AbstractImporterTest: TestSuite::Tester {
     void dataNoFile();
     void dataCustomDeleter();
 
+    void streaming();
+    void streamingNotSupported();
+    void streamingNotImplemented();
+    void streamingNoFile();
+    void seekOutOfRange();
+    void readTooSmall();
+
     void debugFeature();
     void debugFeatures();
 };
@@ -88,6 +95,13 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::dataNoFile,
               &AbstractImporterTest::dataCustomDeleter,
 
+              &AbstractImporterTest::streaming,
+              &AbstractImporterTest::streamingNotSupported,
+              &AbstractImporterTest::streamingNotImplemented,
+              &AbstractImporterTest::streamingNoFile,
+              &AbstractImporterTest::seekOutOfRange,
+              &AbstractImporterTest::readTooSmall,
+
               &AbstractImporterTest::debugFeature,
               &AbstractImporterTest::debugFeatures});
 }
@@ -389,6 +403,186 @@ void AbstractImporterTest::dataCustomDeleter() {
     CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::data(): implementation is not allowed to use a custom Array deleter\n");
 }
 
+void AbstractImporterTest::streaming() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Stereo8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        UnsignedLong doFrameCount() const override { return 5; }
+        bool doSeek(UnsignedLong frame) override {
+            _position = frame;
+            return true;
+        }
+        std::size_t doRead(Containers::ArrayView<char> destination) override {
+            std::size_t count = 0;
+            for(; count != destination.size()/2 && _position != 5; ++count, ++_position) {
+                destination[count*2 + 0] = 'a' + _position;
+                destination[count*2 + 1] = 'A' + _position;
+            }
+            return count;
+        }
+
+        UnsignedLong _position = 0;
+    } importer;
+
+    CORRADE_COMPARE(importer.frameCount(), 5);
+
+    char data[7]{};
+    CORRADE_COMPARE(importer.read(data), 3);
+    CORRADE_COMPARE((std::string{data, 6}), "aAbBcC");
+
+    CORRADE_COMPARE(importer.read(data), 2);
+    CORRADE_COMPARE((std::string{data, 4}), "dDeE");
+
+    CORRADE_COMPARE(importer.read(data), 0);
+
+    CORRADE_VERIFY(importer.seek(1));
+    CORRADE_COMPARE(importer.read({data, 2}), 1);
+    CORRADE_COMPARE((std::string{data, 2}), "bB");
+}
+
+void AbstractImporterTest::streamingNotSupported() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.frameCount();
+    importer.seek(0);
+    importer.read(data);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::frameCount(): feature not supported\n"
+        "Audio::AbstractImporter::seek(): feature not supported\n"
+        "Audio::AbstractImporter::read(): feature not supported\n");
+}
+
+void AbstractImporterTest::streamingNotImplemented() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.frameCount();
+    importer.read(data);
+    /* seek() calls doFrameCount() for the range check, so it fails on that
+       already */
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::frameCount(): feature advertised but not implemented\n"
+        "Audio::AbstractImporter::read(): feature advertised but not implemented\n");
+}
+
+void AbstractImporterTest::streamingNoFile() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[1];
+    importer.frameCount();
+    importer.seek(0);
+    importer.read(data);
+    CORRADE_COMPARE(out.str(),
+        "Audio::AbstractImporter::frameCount(): no file opened\n"
+        "Audio::AbstractImporter::seek(): no file opened\n"
+        "Audio::AbstractImporter::read(): no file opened\n");
+}
+
+void AbstractImporterTest::seekOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        UnsignedLong doFrameCount() const override { return 16; }
+        bool doSeek(UnsignedLong) override { return true; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Seeking to the end is fine */
+    CORRADE_VERIFY(importer.seek(16));
+    CORRADE_VERIFY(!importer.seek(17));
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::seek(): frame 17 out of range for 16 frames\n");
+}
+
+void AbstractImporterTest::readTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::StereoFloat; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        std::size_t doRead(Containers::ArrayView<char>) override { return 1; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[8];
+    CORRADE_COMPARE(importer.read(data), 1);
+    CORRADE_COMPARE(importer.read({data, 7}), 0);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::read(): expected at least 8 bytes for one frame but got 7\n");
+}
+
 void AbstractImporterTest::debugFeature() {
     std::ostringstream out;
 
@@ -399,8 +593,8 @@ void AbstractImporterTest::debugFeature() {
 void AbstractImporterTest::debugFeatures() {
     std::ostringstream out;
 
-    Debug{&out} << ImporterFeature::OpenData << ImporterFeatures{};
-    CORRADE_COMPARE(out.str(), "Audio::ImporterFeature::OpenData Audio::ImporterFeatures{}\n");
+    Debug{&out} << (ImporterFeature::OpenData|ImporterFeature::Streaming) << ImporterFeatures{};
+    CORRADE_COMPARE(out.str(), "Audio::ImporterFeature::OpenData|Audio::ImporterFeature::Streaming Audio::ImporterFeatures{}\n");
 }
 
 }}}}
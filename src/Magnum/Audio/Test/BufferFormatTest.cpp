@@ -34,11 +34,45 @@ namespace Magnum { namespace Audio { namespace Test { namespace {
 struct BufferFormatTest: TestSuite::Tester {
     explicit BufferFormatTest();
 
+    void sampleSize();
+    void channelCount();
+    void frameSize();
+
     void debugFormat();
 };
 
 BufferFormatTest::BufferFormatTest() {
-    addTests({&BufferFormatTest::debugFormat});
+    addTests({&BufferFormatTest::sampleSize,
+              &BufferFormatTest::channelCount,
+              &BufferFormatTest::frameSize,
+
+              &BufferFormatTest::debugFormat});
+}
+
+void BufferFormatTest::sampleSize() {
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::Stereo8), 1);
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::MonoMuLaw), 1);
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::Surround61Channel16), 2);
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::Quad32), 4);
+    CORRADE_COMPARE(Audio::sampleSize(BufferFormat::MonoDouble), 8);
+}
+
+void BufferFormatTest::channelCount() {
+    CORRADE_COMPARE(Audio::channelCount(BufferFormat::MonoFloat), 1);
+    CORRADE_COMPARE(Audio::channelCount(BufferFormat::StereoALaw), 2);
+    CORRADE_COMPARE(Audio::channelCount(BufferFormat::Rear16), 2);
+    CORRADE_COMPARE(Audio::channelCount(BufferFormat::Quad8), 4);
+    CORRADE_COMPARE(Audio::channelCount(BufferFormat::Surround51Channel32), 6);
+    CORRADE_COMPARE(Audio::channelCount(BufferFormat::Surround71Channel8), 8);
+}
+
+void BufferFormatTest::frameSize() {
+    CORRADE_COMPARE(Audio::frameSize(BufferFormat::Mono8), 1);
+    CORRADE_COMPARE(Audio::frameSize(BufferFormat::StereoMuLaw), 2);
+    CORRADE_COMPARE(Audio::frameSize(BufferFormat::Stereo16), 4);
+    CORRADE_COMPARE(Audio::frameSize(BufferFormat::StereoDouble), 16);
+    CORRADE_COMPARE(Audio::frameSize(BufferFormat::Surround61Channel16), 14);
+    CORRADE_COMPARE(Audio::frameSize(BufferFormat::Surround71Channel32), 32);
 }
 
 void BufferFormatTest::debugFormat() {
@@ -0,0 +1,289 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Audio/Resampler.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct ResamplerTest: TestSuite::Tester {
+    explicit ResamplerTest();
+
+    void construct();
+    void outputFrameCount();
+
+    void constant();
+    void sine();
+    void antialiasing();
+    void multipleChannels();
+    void chunked();
+    void reset();
+
+    void constructInvalid();
+    void processInvalidSize();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt sourceFrequency, destinationFrequency;
+} FrequencyData[]{
+    {"44.1 to 48 kHz", 44100, 48000},
+    {"48 to 44.1 kHz", 48000, 44100},
+    {"22.05 to 48 kHz", 22050, 48000},
+    {"48 to 16 kHz", 48000, 16000}
+};
+
+ResamplerTest::ResamplerTest() {
+    addTests({&ResamplerTest::construct,
+              &ResamplerTest::outputFrameCount});
+
+    addInstancedTests({&ResamplerTest::constant,
+                       &ResamplerTest::sine},
+        Containers::arraySize(FrequencyData));
+
+    addTests({&ResamplerTest::antialiasing,
+              &ResamplerTest::multipleChannels,
+              &ResamplerTest::chunked,
+              &ResamplerTest::reset,
+
+              &ResamplerTest::constructInvalid,
+              &ResamplerTest::processInvalidSize});
+}
+
+Containers::Array<Float> generateSine(const UnsignedInt frequency, const Float toneFrequency, const std::size_t frameCount, const Float delay = 0.0f) {
+    Containers::Array<Float> out{Containers::NoInit, frameCount};
+    for(std::size_t i = 0; i != frameCount; ++i)
+        out[i] = Math::sin(Rad(2.0f*Constants::pi()*toneFrequency*(i - delay)/frequency));
+    return out;
+}
+
+void ResamplerTest::construct() {
+    Resampler resampler{2, 44100, 48000};
+    CORRADE_COMPARE(resampler.channelCount(), 2);
+    CORRADE_COMPARE(resampler.sourceFrequency(), 44100);
+    CORRADE_COMPARE(resampler.destinationFrequency(), 48000);
+    CORRADE_COMPARE(resampler.tapCount(), 32);
+}
+
+void ResamplerTest::outputFrameCount() {
+    Resampler resampler{1, 44100, 48000, 8};
+    CORRADE_COMPARE(resampler.outputFrameCount(0), 0);
+    CORRADE_COMPARE(resampler.outputFrameCount(1), 2);
+    CORRADE_COMPARE(resampler.outputFrameCount(441), 480);
+    CORRADE_COMPARE(resampler.outputFrameCount(44100), 48000);
+
+    /* The fractional position carries over between calls, so the total is
+       the same as when processing everything at once */
+    Float source[147]{};
+    Float destination[200];
+    CORRADE_COMPARE(resampler.process(source, destination), 160);
+    CORRADE_COMPARE(resampler.outputFrameCount(147), 160);
+    CORRADE_COMPARE(resampler.process(source, destination), 160);
+    CORRADE_COMPARE(resampler.outputFrameCount(146), 159);
+    CORRADE_COMPARE(resampler.process(Containers::arrayView(source).prefix(146), destination), 159);
+    CORRADE_COMPARE(resampler.outputFrameCount(1), 1);
+}
+
+void ResamplerTest::constant() {
+    auto&& data = FrequencyData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Resampler resampler{1, data.sourceFrequency, data.destinationFrequency};
+
+    Containers::Array<Float> source{Containers::DirectInit, 4096, 0.75f};
+    Containers::Array<Float> destination{Containers::NoInit, resampler.outputFrameCount(source.size())};
+    CORRADE_COMPARE(resampler.process(source, destination), destination.size());
+
+    /* Skip the initial transition from the silence preceding the stream */
+    const std::size_t transitionEnd = (resampler.tapCount()*data.destinationFrequency + data.sourceFrequency - 1)/data.sourceFrequency;
+    Float maxError = 0.0f;
+    for(std::size_t i = transitionEnd; i != destination.size(); ++i)
+        maxError = Math::max(maxError, Math::abs(destination[i] - 0.75f));
+    CORRADE_COMPARE_AS(maxError, 1.0e-5f, TestSuite::Compare::Less);
+}
+
+void ResamplerTest::sine() {
+    auto&& data = FrequencyData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Resampler resampler{1, data.sourceFrequency, data.destinationFrequency};
+
+    /* A 1 kHz tone is well below the cutoff for all rates */
+    Containers::Array<Float> source = generateSine(data.sourceFrequency, 1000.0f, 4096);
+    Containers::Array<Float> destination{Containers::NoInit, resampler.outputFrameCount(source.size())};
+    CORRADE_COMPARE(resampler.process(source, destination), destination.size());
+
+    /* The filter is symmetric, so the output is the same tone delayed by
+       half of the filter length at the upsampled rate, which is
+       destinationFrequency/divisor times the source rate */
+    UnsignedInt divisor = data.sourceFrequency;
+    for(UnsignedInt b = data.destinationFrequency; b; ) {
+        const UnsignedInt t = divisor % b;
+        divisor = b;
+        b = t;
+    }
+    const Float up = data.destinationFrequency/divisor;
+    const Float delay = (resampler.tapCount()*up - 1.0f)/(2.0f*up)*data.destinationFrequency/data.sourceFrequency;
+    Containers::Array<Float> expected = generateSine(data.destinationFrequency, 1000.0f, destination.size(), delay);
+
+    const std::size_t transitionEnd = (resampler.tapCount()*data.destinationFrequency + data.sourceFrequency - 1)/data.sourceFrequency;
+    Float maxError = 0.0f;
+    for(std::size_t i = transitionEnd; i != destination.size(); ++i)
+        maxError = Math::max(maxError, Math::abs(destination[i] - expected[i]));
+    CORRADE_COMPARE_AS(maxError, 1.0e-3f, TestSuite::Compare::Less);
+}
+
+void ResamplerTest::antialiasing() {
+    /* A 15 kHz tone is above the Nyquist frequency of 22.05 kHz and thus
+       should get filtered out instead of aliasing to 7.05 kHz */
+    Resampler resampler{1, 48000, 22050};
+
+    Containers::Array<Float> source = generateSine(48000, 15000.0f, 4096);
+    Containers::Array<Float> destination{Containers::NoInit, resampler.outputFrameCount(source.size())};
+    CORRADE_COMPARE(resampler.process(source, destination), destination.size());
+
+    Float sum = 0.0f;
+    for(std::size_t i = 32; i != destination.size(); ++i)
+        sum += destination[i]*destination[i];
+    CORRADE_COMPARE_AS(Math::sqrt(sum/(destination.size() - 32)), 1.0e-3f, TestSuite::Compare::Less);
+}
+
+void ResamplerTest::multipleChannels() {
+    Containers::Array<Float> source = generateSine(44100, 1000.0f, 1024);
+
+    Resampler mono{1, 44100, 48000};
+    Containers::Array<Float> expected{Containers::NoInit, mono.outputFrameCount(source.size())};
+    CORRADE_COMPARE(mono.process(source, expected), expected.size());
+
+    /* Each channel should be processed independently, with the second one
+       being the first negated and the third silent */
+    Containers::Array<Float> sourceInterleaved{Containers::ValueInit, source.size()*3};
+    for(std::size_t i = 0; i != source.size(); ++i) {
+        sourceInterleaved[i*3 + 0] = source[i];
+        sourceInterleaved[i*3 + 1] = -source[i];
+    }
+
+    Resampler resampler{3, 44100, 48000};
+    CORRADE_COMPARE(resampler.outputFrameCount(source.size()), expected.size());
+    Containers::Array<Float> destination{Containers::NoInit, expected.size()*3};
+    CORRADE_COMPARE(resampler.process(sourceInterleaved, destination), expected.size());
+
+    Containers::Array<Float> expectedInterleaved{Containers::NoInit, expected.size()*3};
+    for(std::size_t i = 0; i != expected.size(); ++i) {
+        expectedInterleaved[i*3 + 0] = expected[i];
+        expectedInterleaved[i*3 + 1] = -expected[i];
+        expectedInterleaved[i*3 + 2] = 0.0f;
+    }
+    CORRADE_COMPARE_AS(destination, expectedInterleaved, TestSuite::Compare::Container);
+}
+
+void ResamplerTest::chunked() {
+    Containers::Array<Float> source = generateSine(44100, 1000.0f, 2048);
+
+    Resampler whole{1, 44100, 48000};
+    Containers::Array<Float> expected{Containers::NoInit, whole.outputFrameCount(source.size())};
+    CORRADE_COMPARE(whole.process(source, expected), expected.size());
+
+    /* Chunks of varying size, including ones shorter than the filter and an
+       empty one, should give exactly the same output */
+    Resampler resampler{1, 44100, 48000};
+    Containers::Array<Float> destination{Containers::NoInit, expected.size()};
+    const std::size_t chunkSizes[]{1, 7, 0, 300, 31, 1024, 3, 682};
+    std::size_t sourceOffset = 0, destinationOffset = 0;
+    for(const std::size_t chunkSize: chunkSizes) {
+        const std::size_t outputFrameCount = resampler.outputFrameCount(chunkSize);
+        CORRADE_COMPARE(resampler.process(
+            source.slice(sourceOffset, sourceOffset + chunkSize),
+            destination.slice(destinationOffset, destinationOffset + outputFrameCount)), outputFrameCount);
+        sourceOffset += chunkSize;
+        destinationOffset += outputFrameCount;
+    }
+    CORRADE_COMPARE(sourceOffset, source.size());
+    CORRADE_COMPARE(destinationOffset, expected.size());
+    CORRADE_COMPARE_AS(destination, expected, TestSuite::Compare::Container);
+}
+
+void ResamplerTest::reset() {
+    Containers::Array<Float> source = generateSine(44100, 1000.0f, 512);
+
+    Resampler resampler{1, 44100, 48000};
+    Containers::Array<Float> expected{Containers::NoInit, resampler.outputFrameCount(source.size())};
+    CORRADE_COMPARE(resampler.process(source, expected), expected.size());
+
+    /* Process something that leaves a fractional position and non-zero
+       history behind */
+    Float destination[600];
+    resampler.process(source.prefix(100), destination);
+
+    resampler.reset();
+    CORRADE_COMPARE(resampler.outputFrameCount(source.size()), expected.size());
+    CORRADE_COMPARE(resampler.process(source, destination), expected.size());
+    CORRADE_COMPARE_AS(Containers::arrayView(destination).prefix(expected.size()), expected, TestSuite::Compare::Container);
+}
+
+void ResamplerTest::constructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Resampler{0, 44100, 48000};
+    Resampler{2, 44100, 0, 16};
+    Resampler{2, 44100, 48000, 0};
+    CORRADE_COMPARE(out.str(),
+        "Audio::Resampler: expected non-zero channel count, frequencies and tap count but got 0, 44100, 48000 and 32\n"
+        "Audio::Resampler: expected non-zero channel count, frequencies and tap count but got 2, 44100, 0 and 16\n"
+        "Audio::Resampler: expected non-zero channel count, frequencies and tap count but got 2, 44100, 48000 and 0\n");
+}
+
+void ResamplerTest::processInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Resampler resampler{2, 44100, 48000};
+    Float source[882];
+    Float destination[959];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    resampler.process(Containers::arrayView(source).prefix(881), destination);
+    resampler.process(source, destination);
+    CORRADE_COMPARE(out.str(),
+        "Audio::Resampler::process(): can't split 881 samples into 2 channels\n"
+        "Audio::Resampler::process(): expected destination size at least 960 but got 959\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::ResamplerTest)
@@ -0,0 +1,190 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/Resampler.h"
+#include "Magnum/Audio/SampleConversion.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct SampleConversionBenchmark: TestSuite::Tester {
+    explicit SampleConversionBenchmark();
+
+    void shortToFloatBaseline();
+    void shortToFloat();
+    void floatToShortBaseline();
+    void floatToShort();
+    void muLawToFloatBaseline();
+    void muLawToFloat();
+    void deinterleaveBaseline();
+    void deinterleave();
+
+    void resample();
+};
+
+SampleConversionBenchmark::SampleConversionBenchmark() {
+    addBenchmarks({&SampleConversionBenchmark::shortToFloatBaseline,
+                   &SampleConversionBenchmark::shortToFloat,
+                   &SampleConversionBenchmark::floatToShortBaseline,
+                   &SampleConversionBenchmark::floatToShort,
+                   &SampleConversionBenchmark::muLawToFloatBaseline,
+                   &SampleConversionBenchmark::muLawToFloat,
+                   &SampleConversionBenchmark::deinterleaveBaseline,
+                   &SampleConversionBenchmark::deinterleave,
+
+                   &SampleConversionBenchmark::resample}, 50);
+}
+
+/* A second of stereo audio at 48 kHz */
+enum: std::size_t { Count = 96000 };
+
+Containers::Array<Short> shortData() {
+    Containers::Array<Short> out{Containers::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i)
+        out[i] = Short(i*7919);
+    return out;
+}
+
+Containers::Array<Float> floatData() {
+    Containers::Array<Float> out{Containers::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i)
+        out[i] = Float((i*7919) % 2001)/1000.0f - 1.0f;
+    return out;
+}
+
+void SampleConversionBenchmark::shortToFloatBaseline() {
+    Containers::Array<Short> src = shortData();
+    Containers::Array<Float> dst{Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != Count; ++i)
+            dst[i] = src[i]/32768.0f;
+
+    CORRADE_COMPARE(dst[Count - 1], src[Count - 1]/32768.0f);
+}
+
+void SampleConversionBenchmark::shortToFloat() {
+    Containers::Array<Short> src = shortData();
+    Containers::Array<Float> dst{Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        convertSamplesInto(BufferFormat::Stereo16, Containers::arrayCast<const char>(src), dst);
+
+    CORRADE_COMPARE(dst[Count - 1], src[Count - 1]/32768.0f);
+}
+
+void SampleConversionBenchmark::floatToShortBaseline() {
+    Containers::Array<Float> src = floatData();
+    Containers::Array<Short> dst{Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != Count; ++i) {
+            const Float value = src[i] != src[i] ? 0.0f : std::round(src[i]*32768.0f);
+            dst[i] = value < -32768.0f ? -32768 : value > 32767.0f ? 32767 : Short(value);
+        }
+
+    CORRADE_COMPARE(dst[0], -32768);
+}
+
+void SampleConversionBenchmark::floatToShort() {
+    Containers::Array<Float> src = floatData();
+    Containers::Array<Short> dst{Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        convertSamplesInto(src, BufferFormat::Stereo16, Containers::arrayCast<char>(dst));
+
+    CORRADE_COMPARE(dst[0], -32768);
+}
+
+void SampleConversionBenchmark::muLawToFloatBaseline() {
+    Containers::Array<Short> src = shortData();
+    Containers::ArrayView<const UnsignedByte> srcBytes = Containers::arrayCast<const UnsignedByte>(src);
+    Containers::Array<Float> dst{Containers::NoInit, Count};
+
+    /* Straightforward G.711 decoding with branches */
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != Count; ++i) {
+            const UnsignedByte value = ~srcBytes[i];
+            const Int exponent = (value >> 4) & 0x07;
+            const Int magnitude = ((((value & 0x0f) << 3) + 0x84) << exponent) - 0x84;
+            if(value & 0x80) dst[i] = -magnitude/32768.0f;
+            else dst[i] = magnitude/32768.0f;
+        }
+
+    CORRADE_COMPARE(dst[0], -32124.0f/32768.0f);
+}
+
+void SampleConversionBenchmark::muLawToFloat() {
+    Containers::Array<Short> src = shortData();
+    Containers::Array<Float> dst{Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        convertSamplesInto(BufferFormat::StereoMuLaw, Containers::arrayCast<const char>(src).prefix(Count), dst);
+
+    CORRADE_COMPARE(dst[0], -32124.0f/32768.0f);
+}
+
+void SampleConversionBenchmark::deinterleaveBaseline() {
+    Containers::Array<Float> src = floatData();
+    Containers::Array<Float> dst{Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        for(std::size_t channel = 0; channel != 2; ++channel)
+            for(std::size_t i = 0; i != Count/2; ++i)
+                dst[channel*Count/2 + i] = src[i*2 + channel];
+
+    CORRADE_COMPARE(dst[Count/2], src[1]);
+}
+
+void SampleConversionBenchmark::deinterleave() {
+    Containers::Array<Float> src = floatData();
+    Containers::Array<Float> dst{Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        deinterleaveInto(src, 2, dst);
+
+    CORRADE_COMPARE(dst[Count/2], src[1]);
+}
+
+void SampleConversionBenchmark::resample() {
+    /* A second of stereo audio from 44.1 kHz to 48 kHz */
+    Containers::Array<Float> src = floatData();
+    Resampler resampler{2, 44100, 48000};
+    Containers::Array<Float> dst{Containers::NoInit, resampler.outputFrameCount(44100)*2};
+
+    std::size_t frameCount{};
+    CORRADE_BENCHMARK(1)
+        frameCount = resampler.process(src.prefix(44100*2), dst);
+
+    CORRADE_COMPARE(frameCount, 48000);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::SampleConversionBenchmark)
@@ -0,0 +1,353 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/SampleConversion.h"
+#include "Magnum/Math/Constants.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct SampleConversionTest: TestSuite::Tester {
+    explicit SampleConversionTest();
+
+    void unsignedByteToFloat();
+    void shortToFloat();
+    void aLawToFloat();
+    void muLawToFloat();
+    void floatToFloat();
+    void doubleToFloat();
+
+    void floatToUnsignedByte();
+    void floatToShort();
+    void floatToALaw();
+    void floatToMuLaw();
+    void floatToDouble();
+
+    void roundtripUnsignedByte();
+    void roundtripShort();
+    void roundtripALaw();
+    void roundtripMuLaw();
+
+    void unaligned();
+    void allocate();
+
+    void deinterleave();
+    void interleave();
+
+    void convertInvalidSize();
+    void interleaveInvalidSize();
+};
+
+SampleConversionTest::SampleConversionTest() {
+    addTests({&SampleConversionTest::unsignedByteToFloat,
+              &SampleConversionTest::shortToFloat,
+              &SampleConversionTest::aLawToFloat,
+              &SampleConversionTest::muLawToFloat,
+              &SampleConversionTest::floatToFloat,
+              &SampleConversionTest::doubleToFloat,
+
+              &SampleConversionTest::floatToUnsignedByte,
+              &SampleConversionTest::floatToShort,
+              &SampleConversionTest::floatToALaw,
+              &SampleConversionTest::floatToMuLaw,
+              &SampleConversionTest::floatToDouble,
+
+              &SampleConversionTest::roundtripUnsignedByte,
+              &SampleConversionTest::roundtripShort,
+              &SampleConversionTest::roundtripALaw,
+              &SampleConversionTest::roundtripMuLaw,
+
+              &SampleConversionTest::unaligned,
+              &SampleConversionTest::allocate,
+
+              &SampleConversionTest::deinterleave,
+              &SampleConversionTest::interleave,
+
+              &SampleConversionTest::convertInvalidSize,
+              &SampleConversionTest::interleaveInvalidSize});
+}
+
+void SampleConversionTest::unsignedByteToFloat() {
+    const UnsignedByte source[]{0x00, 0x40, 0x80, 0xc0, 0xff};
+    Float destination[5];
+    convertSamplesInto(BufferFormat::Mono8, Containers::arrayCast<const char>(Containers::arrayView(source)), destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Float>({
+        -1.0f, -0.5f, 0.0f, 0.5f, 127.0f/128.0f
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::shortToFloat() {
+    const Short source[]{-32768, -16384, 0, 16384, 32767};
+    Float destination[5];
+    convertSamplesInto(BufferFormat::Stereo16, Containers::arrayCast<const char>(Containers::arrayView(source)), destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Float>({
+        -1.0f, -0.5f, 0.0f, 0.5f, 32767.0f/32768.0f
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::aLawToFloat() {
+    /* Smallest and largest magnitudes of both signs, values from the
+       reference G.711 implementation */
+    const UnsignedByte source[]{0xd5, 0x55, 0xaa, 0x2a};
+    Float destination[4];
+    convertSamplesInto(BufferFormat::MonoALaw, Containers::arrayCast<const char>(Containers::arrayView(source)), destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Float>({
+        8.0f/32768.0f, -8.0f/32768.0f, 32256.0f/32768.0f, -32256.0f/32768.0f
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::muLawToFloat() {
+    const UnsignedByte source[]{0xff, 0x7f, 0x80, 0x00};
+    Float destination[4];
+    convertSamplesInto(BufferFormat::StereoMuLaw, Containers::arrayCast<const char>(Containers::arrayView(source)), destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Float>({
+        0.0f, 0.0f, 32124.0f/32768.0f, -32124.0f/32768.0f
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::floatToFloat() {
+    /* Out-of-range values are passed through unchanged */
+    const Float source[]{-2.5f, 0.25f, 1.5f};
+    Float destination[3];
+    convertSamplesInto(BufferFormat::MonoFloat, Containers::arrayCast<const char>(Containers::arrayView(source)), destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView(source), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::doubleToFloat() {
+    const Double source[]{-1.0, 0.125, 0.75};
+    Float destination[3];
+    convertSamplesInto(BufferFormat::StereoDouble, Containers::arrayCast<const char>(Containers::arrayView(source)), destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Float>({
+        -1.0f, 0.125f, 0.75f
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::floatToUnsignedByte() {
+    const Float source[]{-2.0f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 2.0f, Constants::nan()};
+    UnsignedByte destination[8];
+    convertSamplesInto(source, BufferFormat::Stereo8, Containers::arrayCast<char>(Containers::arrayView(destination)));
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<UnsignedByte>({
+        0, 0, 64, 128, 192, 255, 255, 128
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::floatToShort() {
+    const Float source[]{-2.0f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 2.0f, Constants::nan()};
+    Short destination[8];
+    convertSamplesInto(source, BufferFormat::Mono16, Containers::arrayCast<char>(Containers::arrayView(destination)));
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Short>({
+        -32768, -32768, -16384, 0, 16384, 32767, 32767, 0
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::floatToALaw() {
+    const Float source[]{8.0f/32768.0f, -8.0f/32768.0f, 2.0f, -2.0f, Constants::nan()};
+    UnsignedByte destination[5];
+    convertSamplesInto(source, BufferFormat::StereoALaw, Containers::arrayCast<char>(Containers::arrayView(destination)));
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<UnsignedByte>({
+        0xd5, 0x55, 0xaa, 0x2a, 0xd5
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::floatToMuLaw() {
+    const Float source[]{0.0f, 2.0f, -2.0f, Constants::nan()};
+    UnsignedByte destination[4];
+    convertSamplesInto(source, BufferFormat::MonoMuLaw, Containers::arrayCast<char>(Containers::arrayView(destination)));
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<UnsignedByte>({
+        0xff, 0x80, 0x00, 0xff
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::floatToDouble() {
+    const Float source[]{-1.0f, 0.125f, 0.75f};
+    Double destination[3];
+    convertSamplesInto(source, BufferFormat::MonoDouble, Containers::arrayCast<char>(Containers::arrayView(destination)));
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Double>({
+        -1.0, 0.125, 0.75
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::roundtripUnsignedByte() {
+    UnsignedByte source[256];
+    for(std::size_t i = 0; i != 256; ++i) source[i] = i;
+
+    Float samples[256];
+    convertSamplesInto(BufferFormat::Mono8, Containers::arrayCast<const char>(Containers::arrayView(source)), samples);
+    UnsignedByte destination[256];
+    convertSamplesInto(samples, BufferFormat::Mono8, Containers::arrayCast<char>(Containers::arrayView(destination)));
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView(source), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::roundtripShort() {
+    Containers::Array<Short> source{Containers::NoInit, 65536};
+    for(std::size_t i = 0; i != source.size(); ++i) source[i] = Short(i - 32768);
+
+    Containers::Array<Float> samples{Containers::NoInit, source.size()};
+    convertSamplesInto(BufferFormat::Mono16, Containers::arrayCast<const char>(source), samples);
+    Containers::Array<Short> destination{Containers::NoInit, source.size()};
+    convertSamplesInto(samples, BufferFormat::Mono16, Containers::arrayCast<char>(destination));
+    CORRADE_COMPARE_AS(destination, source, TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::roundtripALaw() {
+    UnsignedByte source[256];
+    for(std::size_t i = 0; i != 256; ++i) source[i] = i;
+
+    /* All A-Law codes are unique, so the roundtrip is lossless */
+    Float samples[256];
+    convertSamplesInto(BufferFormat::MonoALaw, Containers::arrayCast<const char>(Containers::arrayView(source)), samples);
+    UnsignedByte destination[256];
+    convertSamplesInto(samples, BufferFormat::MonoALaw, Containers::arrayCast<char>(Containers::arrayView(destination)));
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView(source), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::roundtripMuLaw() {
+    UnsignedByte source[256];
+    for(std::size_t i = 0; i != 256; ++i) source[i] = i;
+
+    /* μ-Law has both a positive and a negative zero, the negative one
+       (0x7f) gets encoded back as the positive one (0xff) */
+    Float samples[256];
+    convertSamplesInto(BufferFormat::MonoMuLaw, Containers::arrayCast<const char>(Containers::arrayView(source)), samples);
+    UnsignedByte destination[256];
+    convertSamplesInto(samples, BufferFormat::MonoMuLaw, Containers::arrayCast<char>(Containers::arrayView(destination)));
+    source[0x7f] = 0xff;
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView(source), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::unaligned() {
+    /* 16-bit samples starting at an odd address, as can happen with data
+       coming straight from a file */
+    const Short samples[]{16384, -16384, 0};
+    char source[7]{};
+    std::memcpy(source + 1, samples, sizeof(samples));
+    Float destination[3];
+    convertSamplesInto(BufferFormat::Mono16, Containers::arrayView(source).suffix(1), destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Float>({
+        0.5f, -0.5f, 0.0f
+    }), TestSuite::Compare::Container);
+
+    char destinationBytes[7]{};
+    convertSamplesInto(destination, BufferFormat::Mono16, Containers::arrayView(destinationBytes).suffix(1));
+    CORRADE_COMPARE_AS(Containers::arrayView(destinationBytes), Containers::arrayView(source), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::allocate() {
+    const Short source[]{-16384, 0, 16384};
+    Containers::Array<Float> samples = convertSamples(BufferFormat::Mono16, Containers::arrayCast<const char>(Containers::arrayView(source)));
+    CORRADE_COMPARE_AS(samples, Containers::arrayView<Float>({
+        -0.5f, 0.0f, 0.5f
+    }), TestSuite::Compare::Container);
+
+    Containers::Array<char> destination = convertSamples(samples, BufferFormat::Mono16);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Short>(destination), Containers::arrayView(source), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::deinterleave() {
+    const Float source[]{
+        0.0f, 1.0f, 2.0f,
+        3.0f, 4.0f, 5.0f,
+        6.0f, 7.0f, 8.0f,
+        9.0f, 10.0f, 11.0f
+    };
+    Float destination[12];
+    deinterleaveInto(source, 3, destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Float>({
+        0.0f, 3.0f, 6.0f, 9.0f,
+        1.0f, 4.0f, 7.0f, 10.0f,
+        2.0f, 5.0f, 8.0f, 11.0f
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::interleave() {
+    const Float source[]{
+        0.0f, 3.0f, 6.0f, 9.0f,
+        1.0f, 4.0f, 7.0f, 10.0f,
+        2.0f, 5.0f, 8.0f, 11.0f
+    };
+    Float destination[12];
+    interleaveInto(source, 3, destination);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Float>({
+        0.0f, 1.0f, 2.0f,
+        3.0f, 4.0f, 5.0f,
+        6.0f, 7.0f, 8.0f,
+        9.0f, 10.0f, 11.0f
+    }), TestSuite::Compare::Container);
+}
+
+void SampleConversionTest::convertInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char data[6];
+    Float samples[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertSamplesInto(BufferFormat::MonoDouble, data, samples);
+    convertSamplesInto(BufferFormat::Stereo16, data, samples);
+    convertSamplesInto(Containers::arrayView(samples).prefix(2), BufferFormat::Stereo16, data);
+    CORRADE_COMPARE(out.str(),
+        "Audio::convertSamplesInto(): source size 6 is not a multiple of Audio::BufferFormat::MonoDouble sample size\n"
+        "Audio::convertSamplesInto(): expected destination size 3 but got 4\n"
+        "Audio::convertSamplesInto(): expected destination size 4 but got 6\n");
+}
+
+void SampleConversionTest::interleaveInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Float source[6]{};
+    Float destination[5];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    deinterleaveInto(source, 4, destination);
+    deinterleaveInto(source, 0, destination);
+    deinterleaveInto(source, 3, destination);
+    interleaveInto(source, 4, destination);
+    interleaveInto(source, 0, destination);
+    interleaveInto(source, 3, destination);
+    CORRADE_COMPARE(out.str(),
+        "Audio::deinterleaveInto(): can't split 6 samples into 4 channels\n"
+        "Audio::deinterleaveInto(): can't split 6 samples into 0 channels\n"
+        "Audio::deinterleaveInto(): expected destination size 6 but got 5\n"
+        "Audio::interleaveInto(): can't split 6 samples into 4 channels\n"
+        "Audio::interleaveInto(): can't split 6 samples into 0 channels\n"
+        "Audio::interleaveInto(): expected destination size 6 but got 5\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::SampleConversionTest)
@@ -0,0 +1,203 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <type_traits>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Audio/StreamingSource.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct StreamingSourceALTest: TestSuite::Tester {
+    explicit StreamingSourceALTest();
+
+    void construct();
+    void constructMove();
+
+    void play();
+    void playShort();
+    void looping();
+    void stop();
+
+    Context _context;
+};
+
+StreamingSourceALTest::StreamingSourceALTest():
+    TestSuite::Tester{TestSuite::Tester::TesterConfiguration{}.setSkippedArgumentPrefixes({"magnum"})},
+    _context{arguments().first, arguments().second}
+{
+    addTests({&StreamingSourceALTest::construct,
+              &StreamingSourceALTest::constructMove,
+
+              &StreamingSourceALTest::play,
+              &StreamingSourceALTest::playShort,
+              &StreamingSourceALTest::looping,
+              &StreamingSourceALTest::stop});
+}
+
+/* Generates a given count of silent 16-bit mono frames */
+struct SilenceImporter: AbstractImporter {
+    explicit SilenceImporter(UnsignedLong frameCount): _frameCount{frameCount} {}
+
+    ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    BufferFormat doFormat() const override { return BufferFormat::Mono16; }
+    UnsignedInt doFrequency() const override { return 44100; }
+    Containers::Array<char> doData() override { return nullptr; }
+
+    UnsignedLong doFrameCount() const override { return _frameCount; }
+    bool doSeek(UnsignedLong frame) override {
+        position = frame;
+        return true;
+    }
+    std::size_t doRead(Containers::ArrayView<char> destination) override {
+        const std::size_t count = Math::min(UnsignedLong(destination.size()/2), _frameCount - position);
+        for(char& i: destination.prefix(count*2)) i = 0;
+        position += count;
+        return count;
+    }
+
+    UnsignedLong position = 0;
+
+    private:
+        UnsignedLong _frameCount;
+};
+
+void StreamingSourceALTest::construct() {
+    SilenceImporter importer{100000};
+    StreamingSource source{importer, 3, 1024};
+    CORRADE_VERIFY(source.source().id() != 0);
+    CORRADE_VERIFY(&source.importer() == &importer);
+    CORRADE_COMPARE(source.bufferCount(), 3);
+    CORRADE_COMPARE(source.bufferFrameCount(), 1024);
+    CORRADE_COMPARE(source.queuedBufferCount(), 0);
+    CORRADE_VERIFY(!source.isLooping());
+
+    /* Nothing is read until playing */
+    CORRADE_COMPARE(importer.position, 0);
+}
+
+void StreamingSourceALTest::constructMove() {
+    SilenceImporter importer{100000};
+    StreamingSource a{importer, 3, 1024};
+    const ALuint id = a.source().id();
+
+    StreamingSource b{std::move(a)};
+    CORRADE_COMPARE(b.source().id(), id);
+    CORRADE_COMPARE(b.bufferCount(), 3);
+
+    SilenceImporter importer2{100};
+    StreamingSource c{importer2, 2, 16};
+    c = std::move(b);
+    CORRADE_COMPARE(c.source().id(), id);
+    CORRADE_VERIFY(&c.importer() == &importer);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<StreamingSource>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<StreamingSource>::value);
+}
+
+void StreamingSourceALTest::play() {
+    SilenceImporter importer{100000};
+    StreamingSource source{importer, 3, 1024};
+    source.play();
+
+    /* All buffers get filled and queued */
+    CORRADE_COMPARE(source.queuedBufferCount(), 3);
+    CORRADE_COMPARE(importer.position, 3*1024);
+    CORRADE_COMPARE(source.source().state(), Source::State::Playing);
+    CORRADE_COMPARE(source.source().type(), Source::Type::Streaming);
+
+    /* Update keeps the ring full */
+    CORRADE_VERIFY(source.update());
+    CORRADE_COMPARE(source.queuedBufferCount(), 3);
+
+    source.pause();
+    CORRADE_COMPARE(source.source().state(), Source::State::Paused);
+    CORRADE_VERIFY(source.update());
+    CORRADE_COMPARE(source.source().state(), Source::State::Paused);
+}
+
+void StreamingSourceALTest::playShort() {
+    /* Less data than what fits into the ring */
+    SilenceImporter importer{1500};
+    StreamingSource source{importer, 3, 1024};
+    source.play();
+    CORRADE_COMPARE(source.queuedBufferCount(), 2);
+    CORRADE_COMPARE(importer.position, 1500);
+
+    /* Wait until it all plays, which should take about 35 ms */
+    for(std::size_t i = 0; i != 100 && source.update(); ++i)
+        Utility::System::sleep(10);
+    CORRADE_VERIFY(!source.update());
+    CORRADE_COMPARE(source.queuedBufferCount(), 0);
+    CORRADE_COMPARE(source.source().state(), Source::State::Stopped);
+}
+
+void StreamingSourceALTest::looping() {
+    SilenceImporter importer{1500};
+    StreamingSource source{importer, 3, 1024};
+    source.setLooping(true);
+    CORRADE_VERIFY(source.isLooping());
+    source.play();
+
+    /* The stream wraps around, so all buffers get filled */
+    CORRADE_COMPARE(source.queuedBufferCount(), 3);
+    CORRADE_COMPARE(importer.position, 3*1024 - 1500);
+
+    for(std::size_t i = 0; i != 10; ++i) {
+        Utility::System::sleep(10);
+        CORRADE_VERIFY(source.update());
+    }
+    CORRADE_COMPARE(source.source().state(), Source::State::Playing);
+}
+
+void StreamingSourceALTest::stop() {
+    SilenceImporter importer{100000};
+    StreamingSource source{importer, 3, 1024};
+    source.play();
+    CORRADE_COMPARE(source.queuedBufferCount(), 3);
+
+    source.stop();
+    CORRADE_COMPARE(source.source().state(), Source::State::Stopped);
+    CORRADE_COMPARE(source.queuedBufferCount(), 0);
+    CORRADE_COMPARE(importer.position, 0);
+
+    /* Playing again starts from the beginning */
+    source.play();
+    CORRADE_COMPARE(source.queuedBufferCount(), 3);
+    CORRADE_COMPARE(importer.position, 3*1024);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::StreamingSourceALTest)
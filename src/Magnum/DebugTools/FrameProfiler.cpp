@@ -25,8 +25,11 @@
 
 #include "FrameProfiler.h"
 
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -35,6 +38,7 @@
 
 #include "Magnum/Math/Functions.h"
 #ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/TimeQuery.h"
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/GL/PipelineStatisticsQuery.h"
@@ -43,6 +47,118 @@
 
 namespace Magnum { namespace DebugTools {
 
+namespace {
+
+struct ZoneRecord {
+    const char* name;
+    UnsignedLong begin, end;
+    UnsignedInt frame;
+};
+
+struct ZoneBuffer {
+    explicit ZoneBuffer(std::thread::id thread, std::size_t capacity): thread{thread}, records{Containers::NoInit, capacity} {}
+
+    std::thread::id thread;
+    /* Locked by the owning thread when recording and by chromeTrace() when
+       exporting, so practically never contended */
+    mutable std::mutex mutex;
+    Containers::Array<ZoneRecord> records;
+    /* Total count of records written, the newest one is at
+       (count - 1) % records.size() */
+    std::size_t count{};
+};
+
+/* Each ZoneState gets a unique ID so the thread-local cache below doesn't
+   pick a buffer of a deleted profiler that had the same address */
+std::atomic<std::size_t> zoneStateCounter{0};
+
+struct ZoneBufferCache {
+    std::size_t state;
+    ZoneBuffer* buffer;
+};
+
+#ifdef CORRADE_BUILD_MULTITHREADED
+CORRADE_THREAD_LOCAL
+#endif
+ZoneBufferCache zoneBufferCache{0, nullptr};
+
+}
+
+struct FrameProfiler::ZoneState {
+    explicit ZoneState(): id{++zoneStateCounter}, epoch{std::chrono::high_resolution_clock::now()} {}
+
+    UnsignedLong now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - epoch).count();
+    }
+
+    ZoneBuffer& buffer();
+    void record(const char* name, UnsignedLong begin, UnsignedLong end);
+    void clear();
+
+    const std::size_t id;
+    const std::chrono::high_resolution_clock::time_point epoch;
+    std::atomic<bool> enabled{true};
+    std::atomic<UnsignedInt> frame{0};
+    UnsignedLong frameBegin{};
+    std::size_t capacity{4096};
+    /* Guards the buffer list, not the buffers themselves */
+    mutable std::mutex mutex;
+    Containers::Array<Containers::Pointer<ZoneBuffer>> buffers;
+};
+
+ZoneBuffer& FrameProfiler::ZoneState::buffer() {
+    /* Fast path, the thread already recorded into this profiler last time */
+    if(zoneBufferCache.state == id) return *zoneBufferCache.buffer;
+
+    const std::thread::id thread = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock{mutex};
+    ZoneBuffer* found = nullptr;
+    for(Containers::Pointer<ZoneBuffer>& buffer: buffers) {
+        if(buffer->thread != thread) continue;
+        found = buffer.get();
+        break;
+    }
+
+    /* First zone recorded from this thread, create a new buffer. The
+       pointers stay stable even if the list gets reallocated. */
+    if(!found) {
+        arrayAppend(buffers, Containers::InPlaceInit, new ZoneBuffer{thread, capacity});
+        found = buffers[buffers.size() - 1].get();
+    }
+
+    zoneBufferCache.state = id;
+    zoneBufferCache.buffer = found;
+    return *found;
+}
+
+void FrameProfiler::ZoneState::record(const char* const name, const UnsignedLong begin, const UnsignedLong end) {
+    ZoneBuffer& buffer = this->buffer();
+    std::lock_guard<std::mutex> lock{buffer.mutex};
+    buffer.records[buffer.count++ % buffer.records.size()] = ZoneRecord{name, begin, end, frame.load(std::memory_order_relaxed)};
+}
+
+void FrameProfiler::ZoneState::clear() {
+    std::lock_guard<std::mutex> lock{mutex};
+    for(Containers::Pointer<ZoneBuffer>& buffer: buffers) {
+        std::lock_guard<std::mutex> bufferLock{buffer->mutex};
+        buffer->count = 0;
+    }
+    frame = 0;
+}
+
+FrameProfiler::Zone::Zone(FrameProfiler& profiler, const char* const name): _state{profiler._zones.get()}, _name{name}, _begin{} {
+    if(!_state || !_state->enabled.load(std::memory_order_relaxed)) {
+        _state = nullptr;
+        return;
+    }
+
+    _begin = _state->now();
+}
+
+FrameProfiler::Zone::~Zone() {
+    if(_state) _state->record(_name, _begin, _state->now());
+}
+
 FrameProfiler::Measurement::Measurement(const std::string& name, const Units units, void(*const begin)(void*), UnsignedLong(*const end)(void*), void* const state): _name{name}, _end{nullptr}, _state{state}, _units{units}, _delay{0} {
     _begin.immediate = begin;
     _query.immediate = end;
@@ -55,9 +171,9 @@ FrameProfiler::Measurement::Measurement(const std::string& name, const Units uni
     _query.delayed = query;
 }
 
-FrameProfiler::FrameProfiler() noexcept = default;
+FrameProfiler::FrameProfiler() noexcept: _zones{Containers::InPlaceInit} {}
 
-FrameProfiler::FrameProfiler(Containers::Array<Measurement>&& measurements, UnsignedInt maxFrameCount) noexcept {
+FrameProfiler::FrameProfiler(Containers::Array<Measurement>&& measurements, UnsignedInt maxFrameCount) noexcept: _zones{Containers::InPlaceInit} {
     setup(std::move(measurements), maxFrameCount);
 }
 
@@ -71,7 +187,8 @@ FrameProfiler::FrameProfiler(FrameProfiler&& other) noexcept:
     _maxFrameCount{other._maxFrameCount},
     _measuredFrameCount{other._measuredFrameCount},
     _measurements{std::move(other._measurements)},
-    _data{std::move(other._data)}
+    _data{std::move(other._data)},
+    _zones{std::move(other._zones)}
 {
     /* For all state pointers that point to &other patch them to point to this
        instead, to account for 90% of use cases of derived classes */
@@ -89,6 +206,7 @@ FrameProfiler& FrameProfiler::operator=(FrameProfiler&& other) noexcept {
     swap(_measuredFrameCount, other._measuredFrameCount);
     swap(_measurements, other._measurements);
     swap(_data, other._data);
+    swap(_zones, other._zones);
 
     /* For all state pointers that point to &other patch them to point to this
        instead, to account for 90% of use cases of derived classes */
@@ -103,6 +221,8 @@ FrameProfiler& FrameProfiler::operator=(FrameProfiler&& other) noexcept {
     return *this;
 }
 
+FrameProfiler::~FrameProfiler() = default;
+
 void FrameProfiler::setup(Containers::Array<Measurement>&& measurements, const UnsignedInt maxFrameCount) {
     CORRADE_ASSERT(maxFrameCount >= 1, "DebugTools::FrameProfiler::setup(): max frame count can't be zero", );
 
@@ -144,10 +264,17 @@ void FrameProfiler::enable() {
         measurement._movingSum = 0;
         measurement._current = 0;
     }
+
+    /* The instance could be moved out */
+    if(_zones) {
+        _zones->clear();
+        _zones->enabled = true;
+    }
 }
 
 void FrameProfiler::disable() {
     _enabled = false;
+    if(_zones) _zones->enabled = false;
 }
 
 void FrameProfiler::beginFrame() {
@@ -158,6 +285,8 @@ void FrameProfiler::beginFrame() {
     _beginFrameCalled = true;
     #endif
 
+    if(_zones) _zones->frameBegin = _zones->now();
+
     /* For all measurements call the begin function */
     for(const Measurement& measurement: _measurements) {
         if(!measurement._delay)
@@ -180,6 +309,14 @@ void FrameProfiler::endFrame() {
     _beginFrameCalled = false;
     #endif
 
+    /* Record the frame as a zone first so it doesn't include the time spent
+       in the measurement callbacks, zones recorded from now on belong to the
+       next frame */
+    if(_zones) {
+        _zones->record("Frame", _zones->frameBegin, _zones->now());
+        ++_zones->frame;
+    }
+
     /* If we don't have all frames yet, enlarge the array */
     if(++_measuredFrameCount <= _maxFrameCount)
         arrayAppend(_data, Containers::NoInit, _measurements.size());
@@ -411,6 +548,75 @@ void FrameProfiler::printStatistics(Debug& out, const UnsignedInt frequency) con
         out << Debug::newline;
 }
 
+std::size_t FrameProfiler::zoneCapacity() const {
+    return _zones ? _zones->capacity : 0;
+}
+
+void FrameProfiler::setZoneCapacity(const std::size_t capacity) {
+    CORRADE_ASSERT(capacity >= 1,
+        "DebugTools::FrameProfiler::setZoneCapacity(): capacity can't be zero", );
+    if(!_zones) return;
+
+    std::lock_guard<std::mutex> lock{_zones->mutex};
+    _zones->capacity = capacity;
+    for(Containers::Pointer<ZoneBuffer>& buffer: _zones->buffers) {
+        std::lock_guard<std::mutex> bufferLock{buffer->mutex};
+        buffer->records = Containers::Array<ZoneRecord>{Containers::NoInit, capacity};
+        buffer->count = 0;
+    }
+}
+
+namespace {
+
+void printJsonString(std::ostringstream& out, const char* string) {
+    out << '"';
+    for(const char* c = string; *c; ++c) {
+        if(*c == '"' || *c == '\\')
+            out << '\\' << *c;
+        else if(UnsignedByte(*c) < 0x20)
+            out << Utility::formatString("\\u{:.4x}", UnsignedInt(UnsignedByte(*c)));
+        else out << *c;
+    }
+    out << '"';
+}
+
+}
+
+std::string FrameProfiler::chromeTrace() const {
+    std::ostringstream out;
+    out << "{\"traceEvents\":[";
+
+    bool first = true;
+    if(_zones) {
+        std::lock_guard<std::mutex> lock{_zones->mutex};
+        for(std::size_t i = 0; i != _zones->buffers.size(); ++i) {
+            const ZoneBuffer& buffer = *_zones->buffers[i];
+            std::lock_guard<std::mutex> bufferLock{buffer.mutex};
+            if(!buffer.count) continue;
+
+            if(!first) out << ",";
+            first = false;
+            out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+                << i << ",\"args\":{\"name\":\"Thread " << i << "\"}}";
+
+            /* Oldest records first */
+            const std::size_t capacity = buffer.records.size();
+            for(std::size_t j = buffer.count > capacity ? buffer.count - capacity : 0; j != buffer.count; ++j) {
+                const ZoneRecord& record = buffer.records[j % capacity];
+                out << ",\n{\"name\":";
+                printJsonString(out, record.name);
+                out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << i
+                    << ",\"ts\":" << Utility::formatString("{:.3f}", record.begin/1000.0)
+                    << ",\"dur\":" << Utility::formatString("{:.3f}", (record.end - record.begin)/1000.0)
+                    << ",\"args\":{\"frame\":" << record.frame << "}}";
+            }
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return out.str();
+}
+
 Debug& operator<<(Debug& debug, const FrameProfiler::Units value) {
     debug << "DebugTools::FrameProfiler::Units" << Debug::nospace;
 
@@ -438,8 +644,10 @@ struct GLFrameProfiler::State {
     UnsignedShort vertexFetchRatioIndex = 0xffff,
         primitiveClipRatioIndex = 0xffff;
     #endif
+    UnsignedShort elidedStateChangesIndex = 0xffff;
     UnsignedLong frameTimeStartFrame[2];
     UnsignedLong cpuDurationStartFrame;
+    UnsignedLong elidedStateChangesStartFrame;
     GL::TimeQuery timeQueries[3]{GL::TimeQuery{NoCreate}, GL::TimeQuery{NoCreate}, GL::TimeQuery{NoCreate}};
     #ifndef MAGNUM_TARGET_GLES
     GL::PipelineStatisticsQuery verticesSubmittedQueries[3]{GL::PipelineStatisticsQuery{NoCreate}, GL::PipelineStatisticsQuery{NoCreate}, GL::PipelineStatisticsQuery{NoCreate}};
@@ -563,6 +771,17 @@ void GLFrameProfiler::setup(const Values values, const UnsignedInt maxFrameCount
         _state->primitiveClipRatioIndex = index++;
     }
     #endif
+    if(values & Value::ElidedStateChanges) {
+        arrayAppend(measurements, Containers::InPlaceInit,
+            "Elided state changes", Units::Count,
+            [](void* state) {
+                static_cast<State*>(state)->elidedStateChangesStartFrame = GL::Renderer::elidedStateChangeCount();
+            },
+            [](void* state) {
+                return GL::Renderer::elidedStateChangeCount() - static_cast<State*>(state)->elidedStateChangesStartFrame;
+            }, _state.get());
+        _state->elidedStateChangesIndex = index++;
+    }
     setup(std::move(measurements), maxFrameCount);
 }
 
@@ -575,6 +794,7 @@ auto GLFrameProfiler::values() const -> Values {
     if(_state->vertexFetchRatioIndex != 0xffff) values |= Value::VertexFetchRatio;
     if(_state->primitiveClipRatioIndex != 0xffff) values |= Value::PrimitiveClipRatio;
     #endif
+    if(_state->elidedStateChangesIndex != 0xffff) values |= Value::ElidedStateChanges;
     return values;
 }
 
@@ -588,6 +808,7 @@ bool GLFrameProfiler::isMeasurementAvailable(const Value value) const {
         case Value::VertexFetchRatio: index = &_state->vertexFetchRatioIndex; break;
         case Value::PrimitiveClipRatio: index = &_state->primitiveClipRatioIndex; break;
         #endif
+        case Value::ElidedStateChanges: index = &_state->elidedStateChangesIndex; break;
     }
     CORRADE_INTERNAL_ASSERT(index);
     CORRADE_ASSERT(*index < measurementCount(),
@@ -627,6 +848,12 @@ Double GLFrameProfiler::primitiveClipRatioMean() const {
 }
 #endif
 
+Double GLFrameProfiler::elidedStateChangesMean() const {
+    CORRADE_ASSERT(_state->elidedStateChangesIndex < measurementCount(),
+        "DebugTools::GLFrameProfiler::elidedStateChangesMean(): not enabled", {});
+    return measurementMean(_state->elidedStateChangesIndex);
+}
+
 namespace {
 
 constexpr const char* GLFrameProfilerValueNames[] {
@@ -634,7 +861,8 @@ constexpr const char* GLFrameProfilerValueNames[] {
     "CpuDuration",
     "GpuDuration",
     "VertexFetchRatio",
-    "PrimitiveClipRatio"
+    "PrimitiveClipRatio",
+    "ElidedStateChanges"
 };
 
 }
@@ -656,8 +884,9 @@ Debug& operator<<(Debug& debug, const GLFrameProfiler::Values value) {
         GLFrameProfiler::Value::GpuDuration,
         #ifndef MAGNUM_TARGET_GLES
         GLFrameProfiler::Value::VertexFetchRatio,
-        GLFrameProfiler::Value::PrimitiveClipRatio
+        GLFrameProfiler::Value::PrimitiveClipRatio,
         #endif
+        GLFrameProfiler::Value::ElidedStateChanges
         });
 }
 #endif
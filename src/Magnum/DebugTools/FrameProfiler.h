@@ -119,6 +119,29 @@ parameters passed to each callback:
     If you don't or can't use @cpp this @ce as a state pointer, you need to
     either provide a dedicated move constructor and assignment to do the
     required patching or disable moves altogether to avoid accidents.
+
+@section DebugTools-FrameProfiler-zones CPU zones and trace export
+
+Apart from the per-frame measurements, durations of particular parts of a
+frame can be recorded by creating a scoped @ref Zone instance. Zones can be
+nested and created from any thread --- each thread records into its own ring
+buffer of @ref zoneCapacity() entries, with the oldest zones overwritten once
+the buffer is full. The zone name is not copied and is expected to stay in
+scope for the whole profiler lifetime, which is commonly the case with string
+literals:
+
+@snippet MagnumDebugTools.cpp FrameProfiler-zones
+
+The zones, together with the frames delimited by @ref beginFrame() and
+@ref endFrame(), can be then exported via @ref chromeTrace() into the
+[Chrome trace event format](https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/),
+which can be opened in the `chrome://tracing` UI or in
+[Perfetto](https://ui.perfetto.dev/):
+
+@snippet MagnumDebugTools.cpp FrameProfiler-zones-export
+
+While the profiler is disabled, creating a @ref Zone costs just a single
+branch and nothing is recorded.
 */
 class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
     public:
@@ -164,6 +187,7 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
         };
 
         class Measurement;
+        class Zone;
 
         /**
          * @brief Default constructor
@@ -195,6 +219,14 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
         /** @brief Move assignment */
         FrameProfiler& operator=(FrameProfiler&&) noexcept;
 
+        /**
+         * @brief Destructor
+         *
+         * Any @ref Zone recording into this profiler has to be destroyed
+         * before the profiler itself.
+         */
+        ~FrameProfiler();
+
         /**
          * @brief Setup measurements
          * @param measurements  List of measurements
@@ -217,18 +249,20 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
          * @brief Enable the profiler
          *
          * The profiler is enabled implicitly after construction. When this
-         * function is called, it discards all measured data, effectively
-         * making @ref measuredFrameCount() zero. If you want to reset the
-         * profiler to measure different values as well, call @ref setup().
+         * function is called, it discards all measured data including
+         * recorded @ref Zone measurements, effectively making
+         * @ref measuredFrameCount() zero. If you want to reset the profiler
+         * to measure different values as well, call @ref setup().
          */
         void enable();
 
         /**
          * @brief Disable the profiler
          *
-         * Disabling the profiler will make @ref beginFrame() and
-         * @ref endFrame() a no-op, effectively freezing all reported
-         * measurements until the profiler is enabled again.
+         * Disabling the profiler will make @ref beginFrame(),
+         * @ref endFrame() and @ref Zone instances a no-op, effectively
+         * freezing all reported measurements until the profiler is enabled
+         * again.
          */
         void disable();
 
@@ -390,6 +424,42 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
             printStatistics(out, frequency);
         }
 
+        /**
+         * @brief Per-thread zone capacity
+         * @m_since_latest
+         *
+         * Max count of @ref Zone measurements kept for each thread, after
+         * which the oldest get overwritten. Default is @cpp 4096 @ce.
+         * @see @ref setZoneCapacity()
+         */
+        std::size_t zoneCapacity() const;
+
+        /**
+         * @brief Set per-thread zone capacity
+         * @m_since_latest
+         *
+         * Discards all zones recorded so far. Expects that @p capacity is at
+         * least @cpp 1 @ce. Not meant to be called while other threads
+         * record zones.
+         * @see @ref DebugTools-FrameProfiler-zones
+         */
+        void setZoneCapacity(std::size_t capacity);
+
+        /**
+         * @brief Recorded zones and frames in the Chrome trace event format
+         * @m_since_latest
+         *
+         * Returns a JSON with a complete (@cpp "ph": "X" @ce) event for each
+         * @ref Zone and each @ref beginFrame() / @ref endFrame() pair still
+         * kept in the per-thread buffers, with the frame index in its
+         * arguments, and a thread name metadata event for each thread that
+         * recorded anything. Timestamps are in microseconds relative to the
+         * profiler construction. Can be called while other threads record
+         * zones. See @ref DebugTools-FrameProfiler-zones for more
+         * information.
+         */
+        std::string chromeTrace() const;
+
     private:
         UnsignedInt delayedCurrentData(UnsignedInt delay) const;
         Double measurementMeanInternal(const Measurement& measurement) const;
@@ -404,6 +474,9 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
         UnsignedInt _maxFrameCount{1}, _measuredFrameCount{};
         Containers::Array<Measurement> _measurements;
         Containers::Array<UnsignedLong> _data;
+
+        struct ZoneState;
+        Containers::Pointer<ZoneState> _zones;
 };
 
 /**
@@ -484,6 +557,51 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler::Measurement {
         UnsignedLong _movingSum{};
 };
 
+/**
+@brief Zone
+@m_since_latest
+
+Measures the time between its construction and destruction, recording it
+into a per-thread buffer of the @ref FrameProfiler it was created with. See
+@ref DebugTools-FrameProfiler-zones for more information.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler::Zone {
+    public:
+        /**
+         * @brief Constructor
+         * @param profiler  Profiler to record the zone into
+         * @param name      Zone name. The string is not copied and is
+         *      expected to stay in scope until the profiler is destroyed.
+         *
+         * If @p profiler is disabled, the zone doesn't record anything.
+         */
+        explicit Zone(FrameProfiler& profiler, const char* name);
+
+        /** @brief Copying is not allowed */
+        Zone(const Zone&) = delete;
+
+        /** @brief Moving is not allowed */
+        Zone(Zone&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Records the zone into the profiler.
+         */
+        ~Zone();
+
+        /** @brief Copying is not allowed */
+        Zone& operator=(const Zone&) = delete;
+
+        /** @brief Moving is not allowed */
+        Zone& operator=(Zone&&) = delete;
+
+    private:
+        ZoneState* _state;
+        const char* _name;
+        UnsignedLong _begin;
+};
+
 /**
 @debugoperatorclassenum{FrameProfiler,FrameProfiler::Units}
 @m_since{2020,06}
@@ -565,8 +683,18 @@ class MAGNUM_DEBUGTOOLS_EXPORT GLFrameProfiler: public FrameProfiler {
              * value requires an active OpenGL context.
              * @requires_gl46 Extension @gl_extension{ARB,pipeline_statistics_query}
              */
-            PrimitiveClipRatio = 1 << 4
+            PrimitiveClipRatio = 1 << 4,
             #endif
+
+            /**
+             * Count of GL state changes that were skipped because the value
+             * was already set, between @ref beginFrame() and
+             * @ref endFrame(). Reported in @ref Units::Count with a delay of
+             * 1 frame. This value requires an active OpenGL context. See
+             * @ref GL-Renderer-state-tracking for more information.
+             * @m_since_latest
+             */
+            ElidedStateChanges = 1 << 5
         };
 
         /**
@@ -689,6 +817,17 @@ class MAGNUM_DEBUGTOOLS_EXPORT GLFrameProfiler: public FrameProfiler {
         Double primitiveClipRatioMean() const;
         #endif
 
+        /**
+         * @brief Mean count of elided state changes
+         * @m_since_latest
+         *
+         * Expects that @ref Value::ElidedStateChanges was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double elidedStateChangesMean() const;
+
     private:
         using FrameProfiler::setup;
 
@@ -34,6 +34,7 @@
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
 #include "Magnum/MeshTools/Compile.h"
 #include "Magnum/Primitives/Cube.h"
 #include "Magnum/Shaders/Flat.h"
@@ -49,6 +50,7 @@ struct FrameProfilerGLTest: GL::OpenGLTester {
     void vertexFetchRatioDivisionByZero();
     void primitiveClipRatioDivisionByZero();
     #endif
+    void elidedStateChanges();
 };
 
 struct {
@@ -72,6 +74,8 @@ FrameProfilerGLTest::FrameProfilerGLTest() {
     addTests({&FrameProfilerGLTest::vertexFetchRatioDivisionByZero,
               &FrameProfilerGLTest::primitiveClipRatioDivisionByZero});
     #endif
+
+    addTests({&FrameProfilerGLTest::elidedStateChanges});
 }
 
 void FrameProfilerGLTest::test() {
@@ -239,6 +243,28 @@ void FrameProfilerGLTest::primitiveClipRatioDivisionByZero() {
 }
 #endif
 
+void FrameProfilerGLTest::elidedStateChanges() {
+    GLFrameProfiler profiler{GLFrameProfiler::Value::ElidedStateChanges, 4};
+
+    /* Make the state known to the renderer so it's elided in all frames */
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+    GL::Renderer::setDepthFunction(GL::Renderer::DepthFunction::LessOrEqual);
+
+    for(std::size_t i = 0; i != 4; ++i) {
+        CORRADE_ITERATION(i);
+        profiler.beginFrame();
+        GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+        GL::Renderer::setDepthFunction(GL::Renderer::DepthFunction::LessOrEqual);
+        GL::Renderer::setDepthFunction(GL::Renderer::DepthFunction::LessOrEqual);
+        profiler.endFrame();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(profiler.isMeasurementAvailable(GLFrameProfiler::Value::ElidedStateChanges));
+    CORRADE_COMPARE(profiler.elidedStateChangesMean(), 3.0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::FrameProfilerGLTest)
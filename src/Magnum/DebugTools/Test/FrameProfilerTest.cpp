@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <thread>
 #include <Corrade/Containers/Pointer.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
@@ -61,6 +62,14 @@ struct FrameProfilerTest: TestSuite::Tester {
 
     void statistics();
 
+    void zones();
+    void zonesDisabled();
+    void zonesEnableDiscards();
+    void zonesMultipleThreads();
+    void zoneCapacity();
+    void zoneCapacityZero();
+    void chromeTraceEscaping();
+
     #ifdef MAGNUM_TARGET_GL
     void gl();
     void glNotEnabled();
@@ -95,6 +104,13 @@ struct {
     {"delayed by 3", true, 3}
 };
 
+std::size_t countOccurences(const std::string& string, const std::string& substring) {
+    std::size_t count = 0;
+    for(std::size_t pos = string.find(substring); pos != std::string::npos; pos = string.find(substring, pos + substring.size()))
+        ++count;
+    return count;
+}
+
 #ifdef MAGNUM_TARGET_GL
 struct {
     const char* name;
@@ -133,7 +149,15 @@ FrameProfilerTest::FrameProfilerTest() {
               &FrameProfilerTest::dataNotAvailableYet,
               &FrameProfilerTest::meanNotAvailableYet,
 
-              &FrameProfilerTest::statistics});
+              &FrameProfilerTest::statistics,
+
+              &FrameProfilerTest::zones,
+              &FrameProfilerTest::zonesDisabled,
+              &FrameProfilerTest::zonesEnableDiscards,
+              &FrameProfilerTest::zonesMultipleThreads,
+              &FrameProfilerTest::zoneCapacity,
+              &FrameProfilerTest::zoneCapacityZero,
+              &FrameProfilerTest::chromeTraceEscaping});
 
     #ifdef MAGNUM_TARGET_GL
     addInstancedTests({&FrameProfilerTest::gl},
@@ -1108,6 +1132,151 @@ void FrameProfilerTest::statistics() {
         "  CPU usage: -.-- %");
 }
 
+void FrameProfilerTest::zones() {
+    FrameProfiler profiler;
+    CORRADE_COMPARE(profiler.zoneCapacity(), 4096);
+    CORRADE_COMPARE(profiler.chromeTrace(),
+        "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+
+    profiler.beginFrame();
+    {
+        FrameProfiler::Zone zone{profiler, "culling"};
+        FrameProfiler::Zone nested{profiler, "sorting"};
+    }
+    profiler.endFrame();
+
+    profiler.beginFrame();
+    {
+        FrameProfiler::Zone zone{profiler, "culling"};
+    }
+    profiler.endFrame();
+
+    const std::string trace = profiler.chromeTrace();
+    CORRADE_COMPARE(trace.find("{\"traceEvents\":["), 0);
+    CORRADE_COMPARE(countOccurences(trace, "\"ph\":\"M\""), 1);
+    CORRADE_COMPARE(countOccurences(trace, "\"ph\":\"X\""), 5);
+    CORRADE_COMPARE(countOccurences(trace, "{\"name\":\"culling\""), 2);
+    CORRADE_COMPARE(countOccurences(trace, "{\"name\":\"sorting\""), 1);
+    CORRADE_COMPARE(countOccurences(trace, "{\"name\":\"Frame\""), 2);
+    CORRADE_COMPARE(countOccurences(trace, "\"args\":{\"frame\":0}"), 3);
+    CORRADE_COMPARE(countOccurences(trace, "\"args\":{\"frame\":1}"), 2);
+
+    /* Nested zone is destructed first, so it's recorded first */
+    CORRADE_VERIFY(trace.find("\"sorting\"") < trace.find("\"culling\""));
+}
+
+void FrameProfilerTest::zonesDisabled() {
+    FrameProfiler profiler;
+    profiler.disable();
+
+    profiler.beginFrame();
+    {
+        FrameProfiler::Zone zone{profiler, "culling"};
+    }
+    profiler.endFrame();
+
+    CORRADE_COMPARE(countOccurences(profiler.chromeTrace(), "\"ph\":"), 0);
+
+    /* A moved-out instance shouldn't record anything either */
+    FrameProfiler moved{std::move(profiler)};
+    {
+        FrameProfiler::Zone zone{profiler, "culling"};
+    }
+    CORRADE_COMPARE(profiler.zoneCapacity(), 0);
+    CORRADE_COMPARE(countOccurences(profiler.chromeTrace(), "\"ph\":"), 0);
+}
+
+void FrameProfilerTest::zonesEnableDiscards() {
+    FrameProfiler profiler;
+    {
+        FrameProfiler::Zone zone{profiler, "culling"};
+    }
+    CORRADE_COMPARE(countOccurences(profiler.chromeTrace(), "\"ph\":\"X\""), 1);
+
+    profiler.disable();
+    profiler.enable();
+    CORRADE_COMPARE(countOccurences(profiler.chromeTrace(), "\"ph\":"), 0);
+
+    {
+        FrameProfiler::Zone zone{profiler, "sorting"};
+    }
+    const std::string trace = profiler.chromeTrace();
+    CORRADE_COMPARE(countOccurences(trace, "\"ph\":\"X\""), 1);
+    CORRADE_COMPARE(countOccurences(trace, "\"sorting\""), 1);
+}
+
+void FrameProfilerTest::zonesMultipleThreads() {
+    FrameProfiler profiler;
+
+    auto work = [&profiler]() {
+        for(std::size_t i = 0; i != 100; ++i)
+            FrameProfiler::Zone zone{profiler, "work"};
+    };
+
+    std::thread a{work}, b{work}, c{work};
+    work();
+    a.join();
+    b.join();
+    c.join();
+
+    const std::string trace = profiler.chromeTrace();
+    CORRADE_COMPARE(countOccurences(trace, "\"ph\":\"M\""), 4);
+    CORRADE_COMPARE(countOccurences(trace, "\"ph\":\"X\""), 400);
+
+    /* A new thread with an ID equal to one of the finished ones reuses its
+       buffer, otherwise a new buffer gets created */
+    std::thread d{work};
+    d.join();
+    CORRADE_COMPARE(countOccurences(profiler.chromeTrace(), "\"ph\":\"X\""), 500);
+}
+
+void FrameProfilerTest::zoneCapacity() {
+    FrameProfiler profiler;
+    {
+        FrameProfiler::Zone zone{profiler, "discarded"};
+    }
+
+    /* Changing the capacity discards everything recorded so far */
+    profiler.setZoneCapacity(3);
+    CORRADE_COMPARE(profiler.zoneCapacity(), 3);
+    CORRADE_COMPARE(countOccurences(profiler.chromeTrace(), "\"ph\":"), 0);
+
+    for(const char* name: {"a", "b", "c", "d", "e"})
+        FrameProfiler::Zone zone{profiler, name};
+
+    /* Only the last three are kept, oldest first */
+    const std::string trace = profiler.chromeTrace();
+    CORRADE_COMPARE(countOccurences(trace, "\"ph\":\"X\""), 3);
+    CORRADE_COMPARE(countOccurences(trace, "\"a\""), 0);
+    CORRADE_COMPARE(countOccurences(trace, "\"b\""), 0);
+    CORRADE_VERIFY(trace.find("\"c\"") < trace.find("\"d\""));
+    CORRADE_VERIFY(trace.find("\"d\"") < trace.find("\"e\""));
+    CORRADE_VERIFY(trace.find("\"e\"") != std::string::npos);
+}
+
+void FrameProfilerTest::zoneCapacityZero() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameProfiler profiler;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.setZoneCapacity(0);
+    CORRADE_COMPARE(out.str(), "DebugTools::FrameProfiler::setZoneCapacity(): capacity can't be zero\n");
+}
+
+void FrameProfilerTest::chromeTraceEscaping() {
+    FrameProfiler profiler;
+    {
+        FrameProfiler::Zone zone{profiler, "a \"quoted\"\\path\n"};
+    }
+
+    CORRADE_COMPARE(countOccurences(profiler.chromeTrace(),
+        "{\"name\":\"a \\\"quoted\\\"\\\\path\\u000a\""), 1);
+}
+
 #ifdef MAGNUM_TARGET_GL
 void FrameProfilerTest::gl() {
     auto&& data = GLData[testCaseInstanceId()];
@@ -34,6 +34,9 @@
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/GL/MeshView.h"
 #include "Magnum/GL/Shader.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/ProgramBinaryCache.h"
+#endif
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Magnum/GL/Implementation/DebugState.h"
 #endif
@@ -298,7 +301,11 @@ AbstractShaderProgram::AbstractShaderProgram(): _id(glCreateProgram()) {
 
 AbstractShaderProgram::AbstractShaderProgram(NoCreateT) noexcept: _id{0} {}
 
-AbstractShaderProgram::AbstractShaderProgram(AbstractShaderProgram&& other) noexcept: _id(other._id) {
+AbstractShaderProgram::AbstractShaderProgram(AbstractShaderProgram&& other) noexcept: _id(other._id)
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    , _binaryCacheKey{std::move(other._binaryCacheKey)}
+    #endif
+{
     other._id = 0;
 }
 
@@ -315,6 +322,9 @@ AbstractShaderProgram::~AbstractShaderProgram() {
 AbstractShaderProgram& AbstractShaderProgram::operator=(AbstractShaderProgram&& other) noexcept {
     using std::swap;
     swap(_id, other._id);
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    swap(_binaryCacheKey, other._binaryCacheKey);
+    #endif
     return *this;
 }
 
@@ -427,6 +437,14 @@ void AbstractShaderProgram::drawTransformFeedback(MeshView& mesh, TransformFeedb
     use();
     mesh._original->drawInternal(xfb, stream, mesh._instanceCount);
 }
+
+void AbstractShaderProgram::drawIndirect(Mesh& mesh, Buffer& commands, const GLintptr offset, const UnsignedInt drawCount, const UnsignedInt stride) {
+    /* Nothing to draw, exit without touching any state */
+    if(!drawCount) return;
+
+    use();
+    mesh.drawInternal(commands, offset, drawCount, stride);
+}
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
@@ -494,49 +512,97 @@ void AbstractShaderProgram::transformFeedbackVaryingsImplementationDanglingWorka
 
 bool AbstractShaderProgram::link() { return link({*this}); }
 
-bool AbstractShaderProgram::link(std::initializer_list<Containers::Reference<AbstractShaderProgram>> shaders) {
-    bool allSuccess = true;
+bool AbstractShaderProgram::loadBinary(const std::initializer_list<Containers::Reference<Shader>> shaders) {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    ProgramBinaryCache* const cache = Context::current().state().shaderProgram->binaryCache;
+    if(!cache || !cache->isSupported()) return false;
 
+    std::string key = cache->key(shaders);
+    if(cache->load(*this, key)) return true;
+
+    /* Remember the key for link(). The hint has to be set before linking. */
+    _binaryCacheKey = std::move(key);
+    setRetrievableBinary(true);
+    return false;
+    #else
+    static_cast<void>(shaders);
+    return false;
+    #endif
+}
+
+bool AbstractShaderProgram::link(std::initializer_list<Containers::Reference<AbstractShaderProgram>> shaders) {
     /* Invoke (possibly parallel) linking on all shaders */
-    for(AbstractShaderProgram& shader: shaders) glLinkProgram(shader._id);
+    for(AbstractShaderProgram& shader: shaders) shader.submitLink();
 
     /* After linking phase, check status of all shaders */
+    bool allSuccess = true;
     Int i = 1;
     for(AbstractShaderProgram& shader: shaders) {
-        GLint success, logLength;
-        glGetProgramiv(shader._id, GL_LINK_STATUS, &success);
-        glGetProgramiv(shader._id, GL_INFO_LOG_LENGTH, &logLength);
-
-        /* Error or warning message. The string is returned null-terminated,
-           scrap the \0 at the end afterwards */
-        std::string message(logLength, '\n');
-        if(message.size() > 1)
-            glGetProgramInfoLog(shader._id, message.size(), nullptr, &message[0]);
-        message.resize(Math::max(logLength, 1)-1);
-
-        /* Show error log */
-        if(!success) {
-            Error out{Debug::Flag::NoNewlineAtTheEnd};
-            out << "GL::AbstractShaderProgram::link(): linking";
-            if(shaders.size() != 1) out << "of shader" << i;
-            out << "failed with the following message:" << Debug::newline << message;
-
-        /* Or just warnings, if any */
-        } else if(!message.empty() && !Implementation::isProgramLinkLogEmpty(message)) {
-            Warning out{Debug::Flag::NoNewlineAtTheEnd};
-            out << "GL::AbstractShaderProgram::link(): linking";
-            if(shaders.size() != 1) out << "of shader" << i;
-            out << "succeeded with the following message:" << Debug::newline << message;
-        }
-
         /* Success of all depends on each of them */
-        allSuccess = allSuccess && success;
+        allSuccess = shader.checkLinkInternal(shaders.size() != 1 ? i : 0) && allSuccess;
         ++i;
     }
 
     return allSuccess;
 }
 
+void AbstractShaderProgram::submitLink() {
+    glLinkProgram(_id);
+}
+
+bool AbstractShaderProgram::checkLink() { return checkLinkInternal(0); }
+
+bool AbstractShaderProgram::checkLinkInternal(const Int index) {
+    GLint success, logLength;
+    glGetProgramiv(_id, GL_LINK_STATUS, &success);
+    glGetProgramiv(_id, GL_INFO_LOG_LENGTH, &logLength);
+
+    /* Error or warning message. The string is returned null-terminated,
+       scrap the \0 at the end afterwards */
+    std::string message(logLength, '\n');
+    if(message.size() > 1)
+        glGetProgramInfoLog(_id, message.size(), nullptr, &message[0]);
+    message.resize(Math::max(logLength, 1)-1);
+
+    /* Show error log */
+    if(!success) {
+        Error out{Debug::Flag::NoNewlineAtTheEnd};
+        out << "GL::AbstractShaderProgram::link(): linking";
+        if(index) out << "of shader" << index;
+        out << "failed with the following message:" << Debug::newline << message;
+
+    /* Or just warnings, if any */
+    } else if(!message.empty() && !Implementation::isProgramLinkLogEmpty(message)) {
+        Warning out{Debug::Flag::NoNewlineAtTheEnd};
+        out << "GL::AbstractShaderProgram::link(): linking";
+        if(index) out << "of shader" << index;
+        out << "succeeded with the following message:" << Debug::newline << message;
+    }
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Store the binary if loadBinary() didn't find it in the cache */
+    if(!_binaryCacheKey.empty()) {
+        ProgramBinaryCache* const cache = Context::current().state().shaderProgram->binaryCache;
+        if(success && cache) cache->store(*this, _binaryCacheKey);
+        _binaryCacheKey = {};
+    }
+    #endif
+
+    return success;
+}
+
+bool AbstractShaderProgram::isLinkFinished() {
+    GLint success;
+    Context::current().state().shaderProgram->completionStatusImplementation(_id, GL_COMPLETION_STATUS_KHR, &success);
+    return success == GL_TRUE;
+}
+
+void APIENTRY AbstractShaderProgram::completionStatusImplementationFallback(GLuint, GLenum, GLint* value) {
+    /* Without KHR_parallel_shader_compile the status query blocks anyway, so
+       report the linking as finished */
+    *value = GL_TRUE;
+}
+
 Int AbstractShaderProgram::uniformLocationInternal(const Containers::ArrayView<const char> name) {
     const GLint location = glGetUniformLocation(_id, name);
     if(location == -1)
@@ -345,6 +345,28 @@ out vec3 velocity;
     in OpenGL ES or WebGL.
 @requires_webgl20 Transform feedback is not available in WebGL 1.0.
 
+@section GL-AbstractShaderProgram-async Asynchronous compilation and linking
+
+The @ref Shader::compile() and @ref link() functions block until the driver is
+done, which with many shaders can take a long time. The work can be instead
+split into a submit and a check step, with the check done only once
+@ref Shader::isCompileFinished() and @ref isLinkFinished() report the
+operation is done. A subclass can for example provide a @cpp compile() @ce
+function that submits the work and returns a partially constructed instance,
+and a constructor taking that instance and finishing the setup:
+
+@snippet MagnumGL.cpp AbstractShaderProgram-async
+
+The application then polls the returned state, keeping a loading screen
+responsive, and constructs the final shader only once it's ready:
+
+@snippet MagnumGL.cpp AbstractShaderProgram-async-usage
+
+The polling doesn't block only if @gl_extension{KHR,parallel_shader_compile}
+is supported. On drivers without it, @ref isLinkFinished() always returns
+@cpp true @ce and the work is done in @ref checkLink(). All builtin
+@ref Shaders support this through their @cpp compile() @ce functions as well.
+
 @section GL-AbstractShaderProgram-rendering-workflow Rendering workflow
 
 Basic workflow with AbstractShaderProgram subclasses is: instance shader
@@ -749,6 +771,21 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          */
         std::pair<bool, std::string> validate();
 
+        /**
+         * @brief Whether a submitted link is finished
+         * @m_since_latest
+         *
+         * If @gl_extension{KHR,parallel_shader_compile} is supported, queries
+         * the completion status without blocking. Otherwise always returns
+         * @cpp true @ce, as the linking is then done synchronously by
+         * @ref checkLink(). See @ref GL-AbstractShaderProgram-async for more
+         * information.
+         * @see @ref submitLink(), @ref Shader::isCompileFinished(),
+         *      @fn_gl_keyword{GetProgram} with
+         *      @def_gl_extension{COMPLETION_STATUS,KHR,parallel_shader_compile}
+         */
+        bool isLinkFinished();
+
         /**
          * @brief Draw a mesh
          * @param mesh      Mesh to draw
@@ -922,6 +959,50 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          *      if @ref MeshView::instanceCount() is more than `1`
          */
         void drawTransformFeedback(MeshView& mesh, TransformFeedback& xfb, UnsignedInt stream = 0);
+
+        /**
+         * @brief Draw multiple meshes with parameters coming from a buffer
+         * @param mesh          Mesh to draw
+         * @param commands      Buffer with draw commands
+         * @param offset        Offset of the first command in @p commands,
+         *      in bytes
+         * @param drawCount     Count of commands to execute
+         * @param stride        Distance between consecutive commands or
+         *      @cpp 0 @ce if they're tightly packed
+         * @m_since_latest
+         *
+         * If the mesh is indexed, @p commands is expected to contain
+         * @ref DrawElementsIndirectCommand instances, otherwise
+         * @ref DrawArraysIndirectCommand instances. Everything set by
+         * @ref Mesh::setCount(), @ref Mesh::setInstanceCount(),
+         * @ref Mesh::setBaseInstance(), @ref Mesh::setBaseVertex() and the
+         * offset passed to @ref Mesh::setIndexBuffer() is ignored, the
+         * @ref DrawElementsIndirectCommand::firstIndex is always counted from
+         * the start of the index buffer. Compared to
+         * @ref draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+         * this executes an arbitrary number of draws with a single call
+         * without any per-draw work on the CPU side, and the commands can be
+         * generated on the GPU as well. Use @ref MeshTools::compileDrawCommands()
+         * to create commands for meshes that were put together with
+         * @ref MeshTools::concatenate():
+         *
+         * @snippet MagnumMeshTools-gl.cpp compileDrawCommands
+         *
+         * If @p drawCount is @cpp 0 @ce, the function is a no-op. If
+         * @gl_extension{ARB,vertex_array_object} (part of OpenGL 3.0) is
+         * available, the associated vertex array object is bound instead of
+         * setting up the mesh from scratch.
+         * @see @ref draw(Mesh&), @fn_gl{UseProgram},
+         *      @fn_gl_keyword{EnableVertexAttribArray}, @fn_gl{BindBuffer},
+         *      @fn_gl_keyword{VertexAttribPointer}, @fn_gl_keyword{DisableVertexAttribArray}
+         *      or @fn_gl{BindVertexArray},
+         *      @fn_gl_keyword{MultiDrawArraysIndirect} or
+         *      @fn_gl_keyword{MultiDrawElementsIndirect}
+         * @requires_gl43 Extension @gl_extension{ARB,multi_draw_indirect}
+         * @requires_gl Indirect multi-draw is not available in OpenGL ES or
+         *      WebGL.
+         */
+        void drawIndirect(Mesh& mesh, Buffer& commands, GLintptr offset, UnsignedInt drawCount, UnsignedInt stride = 0);
         #endif
 
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
@@ -948,13 +1029,41 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          * output. All attached shaders must be compiled with
          * @ref Shader::compile() before linking. The operation is batched in a
          * way that allows the driver to link multiple shaders simultaneously
-         * (i.e. in multiple threads).
+         * (i.e. in multiple threads). Programs for which @ref loadBinary()
+         * was called before get their binary stored in the active
+         * @ref ProgramBinaryCache after a successful link.
          * @see @fn_gl_keyword{LinkProgram}, @fn_gl_keyword{GetProgram} with
          *      @def_gl{LINK_STATUS} and @def_gl{INFO_LOG_LENGTH},
          *      @fn_gl_keyword{GetProgramInfoLog}
          */
         static bool link(std::initializer_list<Containers::Reference<AbstractShaderProgram>> shaders);
 
+        /**
+         * @brief Load the program from a binary cache
+         * @param shaders   All shaders that would be attached to the program
+         * @return @cpp true @ce if the program was loaded and is linked,
+         *      @cpp false @ce otherwise
+         * @m_since_latest
+         *
+         * If a @ref ProgramBinaryCache is active, looks up a binary matching
+         * sources of @p shaders in it. Call this after all sources are added
+         * to the shaders but before they're compiled. If this function
+         * returns @cpp true @ce, the program is ready for use and shader
+         * compilation, attaching and linking can be skipped. Otherwise the
+         * program gets marked as retrievable with @ref setRetrievableBinary()
+         * and the subsequent @ref link() stores its binary in the cache:
+         *
+         * @snippet MagnumGL.cpp AbstractShaderProgram-loadBinary
+         *
+         * Always returns @cpp false @ce if there's no active
+         * @ref ProgramBinaryCache, if the driver doesn't support any program
+         * binary format and on OpenGL ES 2.0 and WebGL.
+         * @see @ref ProgramBinaryCache::current(),
+         *      @ref ProgramBinaryCache::isSupported(),
+         *      @fn_gl_keyword{ProgramBinary}
+         */
+        bool loadBinary(std::initializer_list<Containers::Reference<Shader>> shaders);
+
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         /**
          * @brief Allow retrieving program binary
@@ -1129,9 +1238,39 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          * at once using @ref link(std::initializer_list<Containers::Reference<AbstractShaderProgram>>)
          * for improved performance, see its documentation for more
          * information.
+         * @see @ref submitLink(), @ref checkLink()
          */
         bool link();
 
+        /**
+         * @brief Submit the shader for linking
+         * @m_since_latest
+         *
+         * Starts linking without waiting for its result. The attached shaders
+         * don't need to have their compilation finished yet. Together with
+         * @ref isLinkFinished() and @ref checkLink() this allows linking
+         * shaders asynchronously, see @ref GL-AbstractShaderProgram-async for
+         * more information.
+         * @see @ref Shader::submitCompile(), @fn_gl_keyword{LinkProgram}
+         */
+        void submitLink();
+
+        /**
+         * @brief Check link status
+         * @m_since_latest
+         *
+         * Returns @cpp false @ce if linking submitted by @ref submitLink()
+         * failed, @cpp true @ce otherwise. Linker messages (if any) are
+         * printed to error output. If the linking isn't finished yet, this
+         * function blocks until it is. If @ref loadBinary() was called
+         * before, the binary gets stored in the active
+         * @ref ProgramBinaryCache after a successful link.
+         * @see @ref isLinkFinished(), @ref Shader::checkCompile(),
+         *      @fn_gl_keyword{GetProgram} with @def_gl{LINK_STATUS} and
+         *      @def_gl{INFO_LOG_LENGTH}, @fn_gl_keyword{GetProgramInfoLog}
+         */
+        bool checkLink();
+
         /**
          * @brief Get uniform location
          * @param name          Uniform name
@@ -1336,6 +1475,10 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
         Int uniformLocationInternal(Containers::ArrayView<const char> name);
         UnsignedInt uniformBlockIndexInternal(Containers::ArrayView<const char> name);
 
+        bool checkLinkInternal(Int index);
+
+        static MAGNUM_GL_LOCAL void APIENTRY completionStatusImplementationFallback(GLuint, GLenum, GLint* value);
+
         #ifndef MAGNUM_TARGET_GLES2
         void MAGNUM_GL_LOCAL transformFeedbackVaryingsImplementationDefault(Containers::ArrayView<const std::string> outputs, TransformFeedbackBufferMode bufferMode);
         #ifdef CORRADE_TARGET_WINDOWS
@@ -1480,6 +1623,12 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
 
         GLuint _id;
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /* Set by loadBinary() on a cache miss, link() then stores the binary
+           under this key */
+        std::string _binaryCacheKey;
+        #endif
+
         #if defined(CORRADE_TARGET_WINDOWS) && !defined(MAGNUM_TARGET_GLES2)
         /* Needed for the nv-windows-dangling-transform-feedback-varying-names
            workaround */
@@ -106,6 +106,7 @@ constexpr Extension ExtensionList[]{
     _extension(GREMEDY,string_marker),
     _extension(KHR,blend_equation_advanced),
     _extension(KHR,blend_equation_advanced_coherent),
+    _extension(KHR,parallel_shader_compile),
     _extension(KHR,texture_compression_astc_hdr),
     _extension(KHR,texture_compression_astc_ldr),
     _extension(KHR,texture_compression_astc_sliced_3d),
@@ -277,6 +278,7 @@ constexpr Extension ExtensionList[]{
     _extension(EXT,texture_compression_rgtc),
     _extension(EXT,texture_filter_anisotropic),
     _extension(EXT,texture_norm16),
+    _extension(KHR,parallel_shader_compile),
     _extension(OES,texture_float_linear),
     #ifndef MAGNUM_TARGET_GLES2
     _extension(OVR,multiview2),
@@ -375,6 +377,7 @@ constexpr Extension ExtensionList[]{
     _extension(KHR,blend_equation_advanced_coherent),
     _extension(KHR,context_flush_control),
     _extension(KHR,no_error),
+    _extension(KHR,parallel_shader_compile),
     _extension(KHR,texture_compression_astc_hdr),
     _extension(KHR,texture_compression_astc_sliced_3d),
     #ifndef MAGNUM_TARGET_GLES2
@@ -1108,7 +1111,8 @@ void Context::resetState(const States states) {
         _state->renderer->packPixelStorage.reset();
     }
 
-    /* Nothing to reset for renderer yet */
+    if(states & State::Renderer)
+        _state->renderer->fixedFunction.reset();
 
     if(states & State::Shaders) {
         /* Nothing to reset for shaders */
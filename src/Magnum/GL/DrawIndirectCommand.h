@@ -0,0 +1,110 @@
+#ifndef Magnum_GL_DrawIndirectCommand_h
+#define Magnum_GL_DrawIndirectCommand_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Struct @ref Magnum::GL::DrawArraysIndirectCommand, @ref Magnum::GL::DrawElementsIndirectCommand
+ * @m_since_latest
+ */
+#endif
+
+#include "Magnum/Magnum.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum { namespace GL {
+
+/**
+@brief Indirect draw command for non-indexed meshes
+@m_since_latest
+
+Layout matches the @cpp DrawArraysIndirectCommand @ce structure consumed by
+@fn_gl_keyword{MultiDrawArraysIndirect}, which means an array of these can be
+uploaded directly to a @ref Buffer and drawn with
+@ref AbstractShaderProgram::drawIndirect().
+@see @ref DrawElementsIndirectCommand
+@requires_gl43 Extension @gl_extension{ARB,multi_draw_indirect}
+@requires_gl Indirect multi-draw is not available in OpenGL ES or WebGL.
+*/
+struct DrawArraysIndirectCommand {
+    /** @brief Vertex count */
+    UnsignedInt count;
+
+    /** @brief Instance count */
+    UnsignedInt instanceCount;
+
+    /** @brief First vertex */
+    UnsignedInt first;
+
+    /** @brief Base instance */
+    UnsignedInt baseInstance;
+};
+
+static_assert(sizeof(DrawArraysIndirectCommand) == 16, "Improper size of DrawArraysIndirectCommand");
+
+/**
+@brief Indirect draw command for indexed meshes
+@m_since_latest
+
+Layout matches the @cpp DrawElementsIndirectCommand @ce structure consumed by
+@fn_gl_keyword{MultiDrawElementsIndirect}, which means an array of these can
+be uploaded directly to a @ref Buffer and drawn with
+@ref AbstractShaderProgram::drawIndirect(). Use
+@ref MeshTools::compileDrawCommands() to create commands for meshes that were
+put together with @ref MeshTools::concatenate().
+@see @ref DrawArraysIndirectCommand
+@requires_gl43 Extension @gl_extension{ARB,multi_draw_indirect}
+@requires_gl Indirect multi-draw is not available in OpenGL ES or WebGL.
+*/
+struct DrawElementsIndirectCommand {
+    /** @brief Index count */
+    UnsignedInt count;
+
+    /** @brief Instance count */
+    UnsignedInt instanceCount;
+
+    /**
+     * @brief First index
+     *
+     * In elements, not bytes, counted from the start of the index buffer.
+     */
+    UnsignedInt firstIndex;
+
+    /** @brief Value added to each index before fetching the vertex */
+    Int baseVertex;
+
+    /** @brief Base instance */
+    UnsignedInt baseInstance;
+};
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "Improper size of DrawElementsIndirectCommand");
+
+}}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
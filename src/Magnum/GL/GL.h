@@ -82,6 +82,11 @@ class CubeMapTextureArray;
 /* DefaultFramebuffer is available only through global instance */
 /* DimensionTraits forward declaration is not needed */
 
+#ifndef MAGNUM_TARGET_GLES
+struct DrawArraysIndirectCommand;
+struct DrawElementsIndirectCommand;
+#endif
+
 class Extension;
 class Framebuffer;
 
@@ -109,6 +114,10 @@ enum class CompressedPixelFormat: GLenum;
 
 /* ObjectFlag, ObjectFlags are used only in conjunction with *::wrap() function */
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class ProgramBinaryCache;
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 class PipelineStatisticsQuery;
 #endif
@@ -126,6 +135,7 @@ class RectangleTexture;
 
 class Renderbuffer;
 enum class RenderbufferFormat: GLenum;
+class RenderState;
 
 enum class SamplerFilter: GLint;
 enum class SamplerMipmap: GLint;
@@ -140,6 +150,7 @@ enum class SamplerDepthStencilMode: GLenum;
 
 class Sampler;
 class Shader;
+class StreamingBuffer;
 
 template<UnsignedInt> class Texture;
 #ifndef MAGNUM_TARGET_GLES
@@ -25,6 +25,8 @@
 
 #include "RendererState.h"
 
+#include <Corrade/Containers/ArrayView.h>
+
 #include "Magnum/PixelStorage.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
@@ -184,6 +186,56 @@ RendererState::RendererState(Context& context, ContextState& contextState, std::
     #endif
 }
 
+const Renderer::Feature RendererTrackedFeatures[]{
+    Renderer::Feature::Blending,
+    Renderer::Feature::DepthTest,
+    Renderer::Feature::Dithering,
+    Renderer::Feature::FaceCulling,
+    Renderer::Feature::PolygonOffsetFill,
+    Renderer::Feature::ScissorTest,
+    Renderer::Feature::StencilTest,
+    #ifndef MAGNUM_TARGET_GLES2
+    Renderer::Feature::RasterizerDiscard,
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    Renderer::Feature::DepthClamp,
+    Renderer::Feature::LogicOperation,
+    Renderer::Feature::Multisampling,
+    Renderer::Feature::ProgramPointSize
+    #endif
+    /* Everything else (debug output, sRGB, ...) is toggled rarely enough to
+       not be worth tracking. There's 16 bits for the masks. */
+};
+
+const UnsignedInt RendererTrackedFeatureCount = Containers::arraySize(RendererTrackedFeatures);
+
+Int rendererFeatureIndex(const GLenum feature) {
+    for(UnsignedInt i = 0; i != RendererTrackedFeatureCount; ++i)
+        if(GLenum(RendererTrackedFeatures[i]) == feature) return i;
+    return -1;
+}
+
+bool RendererState::elideFeature(const GLenum feature, const bool enabled) {
+    const Int index = rendererFeatureIndex(feature);
+    if(index == -1) return false;
+
+    const UnsignedShort bit = 1 << index;
+    if((fixedFunction.knownFeatures & bit) && !!(fixedFunction.enabledFeatures & bit) == enabled) {
+        ++elidedStateChangeCount;
+        return true;
+    }
+
+    fixedFunction.knownFeatures |= bit;
+    if(enabled) fixedFunction.enabledFeatures |= bit;
+    else fixedFunction.enabledFeatures &= ~bit;
+    return false;
+}
+
+void RendererState::invalidateFeature(const GLenum feature) {
+    const Int index = rendererFeatureIndex(feature);
+    if(index != -1) fixedFunction.knownFeatures &= ~(1 << index);
+}
+
 RendererState::PixelStorage::PixelStorage():
     alignment{4}
     #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
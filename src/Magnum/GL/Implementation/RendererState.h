@@ -29,12 +29,22 @@
 #include <vector>
 
 #include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/Math/Range.h"
 
 namespace Magnum { namespace GL { namespace Implementation {
 
 struct ContextState;
 
+/* Features shadowed in RendererState::FixedFunction, index in the array is
+   the bit index in the feature masks. Used also by GL::RenderState. */
+extern const Renderer::Feature RendererTrackedFeatures[];
+extern const UnsignedInt RendererTrackedFeatureCount;
+
+/* Bit index of a feature in RendererTrackedFeatures, or -1 if given feature
+   isn't tracked */
+Int rendererFeatureIndex(GLenum feature);
+
 struct RendererState {
     explicit RendererState(Context& context, ContextState& contextState, std::vector<std::string>& extensions);
 
@@ -89,6 +99,84 @@ struct RendererState {
     };
 
     PixelStorage packPixelStorage, unpackPixelStorage;
+
+    /* Shadowed fixed-function state. A cleared bit in `known` (or
+       `knownFeatures`) means the value isn't known and the next call goes
+       to GL unconditionally. Everything starts unknown as the context might
+       not be in the default state when Magnum takes it over. */
+    struct FixedFunction {
+        enum: UnsignedInt {
+            BlendEquation = 1 << 0,
+            BlendFunction = 1 << 1,
+            BlendColor = 1 << 2,
+            ClearColor = 1 << 3,
+            DepthFunction = 1 << 4,
+            DepthMask = 1 << 5,
+            ColorMask = 1 << 6,
+            FrontFace = 1 << 7,
+            FaceCullingMode = 1 << 8,
+            PolygonOffset = 1 << 9,
+            LineWidth = 1 << 10,
+            #ifndef MAGNUM_TARGET_GLES
+            PointSize = 1 << 11,
+            #endif
+            Scissor = 1 << 12,
+            /* Front face is the lower bit, back face the upper */
+            StencilFunction = 1 << 13,
+            StencilOperation = 1 << 15,
+            StencilMask = 1 << 17
+        };
+
+        void reset() {
+            known = 0;
+            knownFeatures = 0;
+        }
+
+        UnsignedInt known{};
+        UnsignedShort knownFeatures{}, enabledFeatures{};
+
+        GLenum blendEquationRgb{}, blendEquationAlpha{};
+        GLenum blendSourceRgb{}, blendDestinationRgb{},
+            blendSourceAlpha{}, blendDestinationAlpha{};
+        Color4 blendColor, clearColor;
+        GLenum depthFunction{};
+        GLboolean depthMask{};
+        UnsignedByte colorMask{}; /* RGBA in bits 0 to 3 */
+        GLenum frontFace{}, faceCullingMode{};
+        Float polygonOffsetFactor{}, polygonOffsetUnits{};
+        Float lineWidth{};
+        #ifndef MAGNUM_TARGET_GLES
+        Float pointSize{};
+        #endif
+        Range2Di scissor;
+        /* Indexed by front (0) and back (1) face */
+        GLenum stencilFunction[2]{};
+        Int stencilReference[2]{};
+        UnsignedInt stencilValueMask[2]{};
+        GLenum stencilFail[2]{}, stencilDepthFail[2]{}, stencilDepthPass[2]{};
+        UnsignedInt stencilWriteMask[2]{};
+    };
+
+    /* If the feature is tracked and already in given state, counts an elided
+       call and returns true. Otherwise updates the shadow and returns false. */
+    bool elideFeature(GLenum feature, bool enabled);
+    /* Drops a feature from the shadow, used by indexed *i() variants */
+    void invalidateFeature(GLenum feature);
+    /* If all `groups` are known and `equal` is true, counts an elided call
+       and returns true. Otherwise marks the groups as known and returns
+       false, the caller is then responsible for updating the shadow and
+       calling GL. */
+    bool elideStateChange(UnsignedInt groups, bool equal) {
+        if((fixedFunction.known & groups) == groups && equal) {
+            ++elidedStateChangeCount;
+            return true;
+        }
+        fixedFunction.known |= groups;
+        return false;
+    }
+
+    FixedFunction fixedFunction;
+    UnsignedLong elidedStateChangeCount{};
     Range1D lineWidthRange;
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     GLint maxPatchVertexCount{};
@@ -33,7 +33,11 @@
 
 namespace Magnum { namespace GL { namespace Implementation {
 
-ShaderProgramState::ShaderProgramState(Context& context, std::vector<std::string>& extensions): current(0), maxVertexAttributes(0)
+ShaderProgramState::ShaderProgramState(Context& context, std::vector<std::string>& extensions): current(0),
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        binaryCache{},
+        #endif
+        maxVertexAttributes(0)
         #ifndef MAGNUM_TARGET_GLES2
         #ifndef MAGNUM_TARGET_WEBGL
         , maxGeometryOutputVertices{0}, maxAtomicCounterBufferSize(0), maxComputeSharedMemorySize(0), maxComputeWorkGroupInvocations(0), maxImageUnits(0), maxCombinedShaderOutputResources(0), maxUniformLocations(0)
@@ -60,6 +64,13 @@ ShaderProgramState::ShaderProgramState(Context& context, std::vector<std::string
     }
     #endif
 
+    if(context.isExtensionSupported<Extensions::KHR::parallel_shader_compile>()) {
+        /* Extension added to the list by ShaderState already */
+        completionStatusImplementation = glGetProgramiv;
+    } else {
+        completionStatusImplementation = &AbstractShaderProgram::completionStatusImplementationFallback;
+    }
+
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     #ifndef MAGNUM_TARGET_GLES
     if(context.isExtensionSupported<Extensions::ARB::separate_shader_objects>())
@@ -192,7 +203,6 @@ ShaderProgramState::ShaderProgramState(Context& context, std::vector<std::string
     }
 
     #ifdef MAGNUM_TARGET_WEBGL
-    static_cast<void>(context);
     static_cast<void>(extensions);
     #endif
 }
@@ -91,9 +91,16 @@ struct ShaderProgramState {
     void(AbstractShaderProgram::*uniformMatrix4x3dvImplementation)(GLint, GLsizei, const Math::RectangularMatrix<4, 3, GLdouble>*);
     #endif
 
+    void(APIENTRY *completionStatusImplementation)(GLuint, GLenum, GLint*);
+
     /* Currently used program */
     GLuint current;
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Currently active binary cache, if any */
+    ProgramBinaryCache* binaryCache;
+    #endif
+
     GLint maxVertexAttributes;
     #ifndef MAGNUM_TARGET_GLES2
     #ifndef MAGNUM_TARGET_WEBGL
@@ -25,15 +25,13 @@
 
 #include "ShaderState.h"
 
-#include "Magnum/GL/Shader.h"
-
-#if defined(CORRADE_TARGET_EMSCRIPTEN) && defined(__EMSCRIPTEN_PTHREADS__)
 #include "Magnum/GL/Context.h"
-#endif
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Shader.h"
 
 namespace Magnum { namespace GL { namespace Implementation {
 
-ShaderState::ShaderState(Context& context, std::vector<std::string>&):
+ShaderState::ShaderState(Context& context, std::vector<std::string>& extensions):
     maxVertexOutputComponents{}, maxFragmentInputComponents{},
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     maxTessellationControlInputComponents{}, maxTessellationControlOutputComponents{}, maxTessellationControlTotalOutputComponents{}, maxTessellationEvaluationInputComponents{}, maxTessellationEvaluationOutputComponents{}, maxGeometryInputComponents{}, maxGeometryOutputComponents{}, maxGeometryTotalOutputComponents{}, maxAtomicCounterBuffers{}, maxCombinedAtomicCounterBuffers{}, maxAtomicCounters{}, maxCombinedAtomicCounters{}, maxImageUniforms{}, maxCombinedImageUniforms{}, maxShaderStorageBlocks{}, maxCombinedShaderStorageBlocks{},
@@ -56,9 +54,12 @@ ShaderState::ShaderState(Context& context, std::vector<std::string>&):
         addSourceImplementation = &Shader::addSourceImplementationDefault;
     }
 
-    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || !defined(__EMSCRIPTEN_PTHREADS__)
-    static_cast<void>(context);
-    #endif
+    if(context.isExtensionSupported<Extensions::KHR::parallel_shader_compile>()) {
+        extensions.emplace_back(Extensions::KHR::parallel_shader_compile::string());
+        completionStatusImplementation = glGetShaderiv;
+    } else {
+        completionStatusImplementation = &Shader::completionStatusImplementationFallback;
+    }
 }
 
 }}}
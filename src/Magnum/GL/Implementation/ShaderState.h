@@ -52,6 +52,7 @@ struct ShaderState {
     };
 
     void(Shader::*addSourceImplementation)(std::string);
+    void(APIENTRY *completionStatusImplementation)(GLuint, GLenum, GLint*);
 
     GLint maxVertexOutputComponents,
         maxFragmentInputComponents;
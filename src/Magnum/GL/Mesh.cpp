@@ -539,6 +539,26 @@ void Mesh::drawInternal(TransformFeedback& xfb, const UnsignedInt stream, const
 
     (this->*state.unbindImplementation)();
 }
+
+void Mesh::drawInternal(Buffer& commands, const GLintptr offset, const UnsignedInt drawCount, const UnsignedInt stride) {
+    const Implementation::MeshState& state = *Context::current().state().mesh;
+
+    (this->*state.bindImplementation)();
+
+    /* The indirect buffer binding is not part of VAO state, so it can be
+       bound after */
+    commands.bindInternal(Buffer::TargetHint::DrawIndirect);
+
+    /* Non-indexed mesh */
+    if(!_indexBuffer.id())
+        glMultiDrawArraysIndirect(GLenum(_primitive), reinterpret_cast<GLvoid*>(offset), drawCount, stride);
+
+    /* Indexed mesh */
+    else
+        glMultiDrawElementsIndirect(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<GLvoid*>(offset), drawCount, stride);
+
+    (this->*state.unbindImplementation)();
+}
 #endif
 
 #ifdef MAGNUM_BUILD_DEPRECATED
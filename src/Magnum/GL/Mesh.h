@@ -1078,6 +1078,7 @@ class MAGNUM_GL_EXPORT Mesh: public AbstractObject {
 
         #ifndef MAGNUM_TARGET_GLES
         void drawInternal(TransformFeedback& xfb, UnsignedInt stream, Int instanceCount);
+        void drawInternal(Buffer& commands, GLintptr offset, UnsignedInt drawCount, UnsignedInt stride);
         #endif
 
         void MAGNUM_GL_LOCAL createImplementationDefault(bool);
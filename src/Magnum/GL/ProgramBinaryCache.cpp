@@ -0,0 +1,147 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ProgramBinaryCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/Implementation/ShaderProgramState.h"
+#include "Magnum/GL/Implementation/State.h"
+
+namespace Magnum { namespace GL {
+
+ProgramBinaryCache* ProgramBinaryCache::current() {
+    return Context::current().state().shaderProgram->binaryCache;
+}
+
+ProgramBinaryCache::ProgramBinaryCache(const std::string& path): _path{path}, _hitCount{}, _missCount{} {
+    Context& context = Context::current();
+
+    /* Any change in the driver invalidates all binaries */
+    _driver = context.vendorString();
+    _driver += '\0';
+    _driver += context.rendererString();
+    _driver += '\0';
+    _driver += context.versionString();
+    _driver += '\0';
+
+    /* If there are no formats, the cache does nothing */
+    #ifndef MAGNUM_TARGET_GLES
+    if(context.isExtensionSupported<Extensions::ARB::get_program_binary>())
+    #endif
+    {
+        GLint formatCount{};
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        if(formatCount) {
+            _formats = Containers::Array<GLint>{Containers::ValueInit, std::size_t(formatCount)};
+            glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, _formats);
+        }
+    }
+
+    if(isSupported() && !Utility::Directory::mkpath(_path))
+        Warning{} << "GL::ProgramBinaryCache: can't create" << _path << Debug::nospace << ", binaries won't be stored";
+
+    /* Become the current one */
+    ProgramBinaryCache*& current = context.state().shaderProgram->binaryCache;
+    _previous = current;
+    current = this;
+}
+
+ProgramBinaryCache::~ProgramBinaryCache() {
+    /* Nested caches are expected to be destroyed in reverse order, but if
+       not, at least don't leave a dangling pointer behind */
+    ProgramBinaryCache*& current = Context::current().state().shaderProgram->binaryCache;
+    if(current == this) current = _previous;
+}
+
+std::string ProgramBinaryCache::key(const std::initializer_list<Containers::Reference<Shader>> shaders) const {
+    std::string data = _driver;
+    for(Shader& shader: shaders) {
+        data += std::to_string(GLenum(shader.type()));
+        data += '\0';
+        for(const std::string& source: shader.sources()) {
+            data += source;
+            data += '\0';
+        }
+    }
+
+    return Utility::Sha1::digest(data).hexString();
+}
+
+bool ProgramBinaryCache::load(AbstractShaderProgram& program, const std::string& key) {
+    const std::string filename = Utility::Directory::join(_path, key);
+    if(!Utility::Directory::exists(filename)) {
+        ++_missCount;
+        return false;
+    }
+
+    /* The file is the binary format followed by the binary itself. Check the
+       format first, passing an unknown one would cause a GL error. */
+    const Containers::Array<char> data = Utility::Directory::read(filename);
+    GLint format{};
+    if(data.size() > sizeof(GLint))
+        std::memcpy(&format, data, sizeof(GLint));
+    if(data.size() <= sizeof(GLint) || std::find(_formats.begin(), _formats.end(), format) == _formats.end()) {
+        ++_missCount;
+        return false;
+    }
+
+    /* If the driver rejects the binary, the program stays unlinked and can be
+       linked from source as usual */
+    glProgramBinary(program.id(), format, data + sizeof(GLint), data.size() - sizeof(GLint));
+    GLint success;
+    glGetProgramiv(program.id(), GL_LINK_STATUS, &success);
+    if(!success) {
+        ++_missCount;
+        return false;
+    }
+
+    ++_hitCount;
+    return true;
+}
+
+void ProgramBinaryCache::store(AbstractShaderProgram& program, const std::string& key) {
+    GLint size{};
+    glGetProgramiv(program.id(), GL_PROGRAM_BINARY_LENGTH, &size);
+    if(!size) return;
+
+    Containers::Array<char> data{Containers::NoInit, sizeof(GLint) + size};
+    GLenum format;
+    glGetProgramBinary(program.id(), size, nullptr, &format, data + sizeof(GLint));
+    const GLint formatInt = format;
+    std::memcpy(data, &formatInt, sizeof(GLint));
+
+    Utility::Directory::write(Utility::Directory::join(_path, key), data);
+}
+
+}}
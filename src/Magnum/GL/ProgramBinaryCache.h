@@ -0,0 +1,184 @@
+#ifndef Magnum_GL_ProgramBinaryCache_h
+#define Magnum_GL_ProgramBinaryCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::GL::ProgramBinaryCache
+ * @m_since_latest
+ */
+#endif
+
+#include <initializer_list>
+#include <string>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/OpenGL.h"
+#include "Magnum/GL/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace GL {
+
+/**
+@brief On-disk program binary cache
+@m_since_latest
+
+Stores linked shader programs on disk and loads them back using
+@fn_gl_keyword{ProgramBinary} instead of compiling and linking the shaders from
+source again, which can save a significant amount of startup time on drivers
+with slow shader compilers.
+
+@section GL-ProgramBinaryCache-usage Usage
+
+The cache is opt-in. While an instance exists, it's used by all shaders created
+in the current OpenGL context, including all builtin @ref Shaders:
+
+@snippet MagnumGL.cpp ProgramBinaryCache-usage
+
+Each program is identified by a SHA-1 hash of the types and sources of all its
+shaders, together with the @ref Context::vendorString(),
+@ref Context::rendererString() and @ref Context::versionString(). A driver
+update thus automatically results in the binaries being created anew. Entries
+that fail to load, for example because the driver rejected them or the file
+is corrupted, are replaced with a freshly linked program. The cache doesn't do
+any eviction, remove the directory to clear it.
+
+If the driver reports no supported binary formats, @ref isSupported() returns
+@cpp false @ce and the cache does nothing.
+
+@section GL-ProgramBinaryCache-prewarm Pre-warming the cache
+
+Binaries are specific to the GPU and driver, so the cache can't be shipped
+together with the application. It can be however filled in advance, for example
+during installation or behind a loading screen on the first start, by simply
+creating all shader variants the application is going to use:
+
+@snippet MagnumGL.cpp ProgramBinaryCache-prewarm
+
+@section GL-ProgramBinaryCache-custom Custom shaders
+
+Subclasses of @ref AbstractShaderProgram opt in to the cache by calling
+@ref AbstractShaderProgram::loadBinary() with all shaders that would be
+attached to the program, after their sources are added but before they're
+compiled. If it returns @cpp true @ce, the program is already linked and
+compiling, attaching and linking is skipped. Otherwise the binary is stored by
+the subsequent @ref AbstractShaderProgram::link() call. Because only the
+sources are hashed, attribute and fragment data location bindings and
+transform feedback outputs are expected to be a function of the sources.
+@requires_gl41 Extension @gl_extension{ARB,get_program_binary}
+@requires_gles30 Not available in OpenGL ES 2.0.
+@requires_gles Binary program representations are not supported in WebGL.
+*/
+class MAGNUM_GL_EXPORT ProgramBinaryCache {
+    public:
+        /**
+         * @brief Currently active cache
+         *
+         * Returns the most recently created cache that wasn't destroyed yet or
+         * @cpp nullptr @ce if there's none in the current context.
+         */
+        static ProgramBinaryCache* current();
+
+        /**
+         * @brief Constructor
+         * @param path      Directory to store the binaries in
+         *
+         * Creates @p path if it doesn't exist and makes the instance
+         * @ref current() in the current context. Instances can be nested, the
+         * previous instance becomes current again when this one is destroyed.
+         * @see @fn_gl{Get} with @def_gl_keyword{PROGRAM_BINARY_FORMATS}
+         */
+        explicit ProgramBinaryCache(const std::string& path);
+
+        /** @brief Copying is not allowed */
+        ProgramBinaryCache(const ProgramBinaryCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        ProgramBinaryCache(ProgramBinaryCache&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Makes the previous instance @ref current() again.
+         */
+        ~ProgramBinaryCache();
+
+        /** @brief Copying is not allowed */
+        ProgramBinaryCache& operator=(const ProgramBinaryCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        ProgramBinaryCache& operator=(ProgramBinaryCache&&) = delete;
+
+        /** @brief Cache directory */
+        std::string path() const { return _path; }
+
+        /**
+         * @brief Whether the driver supports any program binary format
+         *
+         * If not, @ref AbstractShaderProgram::loadBinary() always returns
+         * @cpp false @ce and nothing gets stored.
+         */
+        bool isSupported() const { return !_formats.empty(); }
+
+        /** @brief Count of programs loaded from the cache */
+        UnsignedInt hitCount() const { return _hitCount; }
+
+        /**
+         * @brief Count of programs that weren't found in the cache
+         *
+         * Includes also entries that failed to load.
+         */
+        UnsignedInt missCount() const { return _missCount; }
+
+        /**
+         * @brief Cache key for given shaders
+         *
+         * A hexadecimal SHA-1 hash of shader types and sources together with
+         * driver identification strings. Used as a filename inside
+         * @ref path().
+         */
+        std::string key(std::initializer_list<Containers::Reference<Shader>> shaders) const;
+
+    private:
+        friend AbstractShaderProgram;
+
+        bool MAGNUM_GL_LOCAL load(AbstractShaderProgram& program, const std::string& key);
+        void MAGNUM_GL_LOCAL store(AbstractShaderProgram& program, const std::string& key);
+
+        ProgramBinaryCache* _previous;
+        std::string _path, _driver;
+        Containers::Array<GLint> _formats;
+        UnsignedInt _hitCount, _missCount;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
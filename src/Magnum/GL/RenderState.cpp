@@ -0,0 +1,178 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderState.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/Implementation/RendererState.h"
+
+namespace Magnum { namespace GL {
+
+RenderState::RenderState() noexcept: _set{}, _setFeatures{}, _enabledFeatures{}, _blendEquationRgb{}, _blendEquationAlpha{}, _blendSourceRgb{}, _blendDestinationRgb{}, _blendSourceAlpha{}, _blendDestinationAlpha{}, _depthFunction{}, _depthMask{}, _colorMask{}, _frontFace{}, _faceCullingMode{}, _polygonOffsetFactor{}, _polygonOffsetUnits{}, _lineWidth{}, _stencilFunction{}, _stencilReference{}, _stencilValueMask{}, _stencilFail{}, _stencilDepthFail{}, _stencilDepthPass{}, _stencilWriteMask{} {}
+
+RenderState& RenderState::setFeature(const Renderer::Feature feature, const bool enabled) {
+    const Int index = Implementation::rendererFeatureIndex(GLenum(feature));
+    CORRADE_ASSERT(index != -1,
+        "GL::RenderState::setFeature(): feature" << reinterpret_cast<void*>(GLenum(feature)) << "can't be used in a render state block", *this);
+
+    const UnsignedShort bit = 1 << index;
+    _setFeatures |= bit;
+    if(enabled) _enabledFeatures |= bit;
+    else _enabledFeatures &= ~bit;
+    return *this;
+}
+
+RenderState& RenderState::setBlendEquation(const Renderer::BlendEquation rgb, const Renderer::BlendEquation alpha) {
+    _set |= BlendEquation;
+    _blendEquationRgb = rgb;
+    _blendEquationAlpha = alpha;
+    return *this;
+}
+
+RenderState& RenderState::setBlendFunction(const Renderer::BlendFunction sourceRgb, const Renderer::BlendFunction destinationRgb, const Renderer::BlendFunction sourceAlpha, const Renderer::BlendFunction destinationAlpha) {
+    _set |= BlendFunction;
+    _blendSourceRgb = sourceRgb;
+    _blendDestinationRgb = destinationRgb;
+    _blendSourceAlpha = sourceAlpha;
+    _blendDestinationAlpha = destinationAlpha;
+    return *this;
+}
+
+RenderState& RenderState::setBlendColor(const Color4& color) {
+    _set |= BlendColor;
+    _blendColor = color;
+    return *this;
+}
+
+RenderState& RenderState::setDepthFunction(const Renderer::DepthFunction function) {
+    _set |= DepthFunction;
+    _depthFunction = function;
+    return *this;
+}
+
+RenderState& RenderState::setDepthMask(const bool allow) {
+    _set |= DepthMask;
+    _depthMask = allow;
+    return *this;
+}
+
+RenderState& RenderState::setColorMask(const bool allowRed, const bool allowGreen, const bool allowBlue, const bool allowAlpha) {
+    _set |= ColorMask;
+    _colorMask = (allowRed ? 1 : 0)|(allowGreen ? 2 : 0)|
+                 (allowBlue ? 4 : 0)|(allowAlpha ? 8 : 0);
+    return *this;
+}
+
+RenderState& RenderState::setFrontFace(const Renderer::FrontFace mode) {
+    _set |= FrontFace;
+    _frontFace = mode;
+    return *this;
+}
+
+RenderState& RenderState::setFaceCullingMode(const Renderer::PolygonFacing mode) {
+    _set |= FaceCullingMode;
+    _faceCullingMode = mode;
+    return *this;
+}
+
+RenderState& RenderState::setPolygonOffset(const Float factor, const Float units) {
+    _set |= PolygonOffset;
+    _polygonOffsetFactor = factor;
+    _polygonOffsetUnits = units;
+    return *this;
+}
+
+RenderState& RenderState::setLineWidth(const Float width) {
+    _set |= LineWidth;
+    _lineWidth = width;
+    return *this;
+}
+
+RenderState& RenderState::setStencilFunction(const Renderer::StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    _set |= StencilFunction;
+    _stencilFunction = function;
+    _stencilReference = referenceValue;
+    _stencilValueMask = mask;
+    return *this;
+}
+
+RenderState& RenderState::setStencilOperation(const Renderer::StencilOperation stencilFail, const Renderer::StencilOperation depthFail, const Renderer::StencilOperation depthPass) {
+    _set |= StencilOperation;
+    _stencilFail = stencilFail;
+    _stencilDepthFail = depthFail;
+    _stencilDepthPass = depthPass;
+    return *this;
+}
+
+RenderState& RenderState::setStencilMask(const UnsignedInt allowBits) {
+    _set |= StencilMask;
+    _stencilWriteMask = allowBits;
+    return *this;
+}
+
+RenderState& RenderState::setScissor(const Range2Di& rectangle) {
+    _set |= Scissor;
+    _scissor = rectangle;
+    return *this;
+}
+
+void RenderState::apply() const {
+    for(UnsignedInt i = 0; i != Implementation::RendererTrackedFeatureCount; ++i) {
+        if(!(_setFeatures & (1 << i))) continue;
+        Renderer::setFeature(Implementation::RendererTrackedFeatures[i], !!(_enabledFeatures & (1 << i)));
+    }
+
+    if(_set & BlendEquation)
+        Renderer::setBlendEquation(_blendEquationRgb, _blendEquationAlpha);
+    if(_set & BlendFunction)
+        Renderer::setBlendFunction(_blendSourceRgb, _blendDestinationRgb, _blendSourceAlpha, _blendDestinationAlpha);
+    if(_set & BlendColor)
+        Renderer::setBlendColor(_blendColor);
+    if(_set & DepthFunction)
+        Renderer::setDepthFunction(_depthFunction);
+    if(_set & DepthMask)
+        Renderer::setDepthMask(_depthMask);
+    if(_set & ColorMask)
+        Renderer::setColorMask(bool(_colorMask & 1), bool(_colorMask & 2), bool(_colorMask & 4), bool(_colorMask & 8));
+    if(_set & FrontFace)
+        Renderer::setFrontFace(_frontFace);
+    if(_set & FaceCullingMode)
+        Renderer::setFaceCullingMode(_faceCullingMode);
+    if(_set & PolygonOffset)
+        Renderer::setPolygonOffset(_polygonOffsetFactor, _polygonOffsetUnits);
+    if(_set & LineWidth)
+        Renderer::setLineWidth(_lineWidth);
+    if(_set & StencilFunction)
+        Renderer::setStencilFunction(_stencilFunction, _stencilReference, _stencilValueMask);
+    if(_set & StencilOperation)
+        Renderer::setStencilOperation(_stencilFail, _stencilDepthFail, _stencilDepthPass);
+    if(_set & StencilMask)
+        Renderer::setStencilMask(_stencilWriteMask);
+    if(_set & Scissor)
+        Renderer::setScissor(_scissor);
+}
+
+}}
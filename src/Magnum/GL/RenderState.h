@@ -0,0 +1,297 @@
+#ifndef Magnum_GL_RenderState_h
+#define Magnum_GL_RenderState_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::RenderState
+ * @m_since_latest
+ */
+
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Render state block
+@m_since_latest
+
+Collects fixed-function state for a particular draw or a group of draws and
+applies it at once. Only values that were explicitly set are applied, the
+rest of the state is left untouched. As @ref Renderer shadows the state (see
+@ref GL-Renderer-state-tracking), @ref apply() results only in GL calls for
+values that differ from what's currently set, so it's cheap to apply a full
+block before each draw:
+
+@snippet MagnumGL.cpp RenderState-usage
+
+The block is a plain value type, it doesn't need an active GL context until
+@ref apply() is called and can be freely copied.
+
+Only features that are shadowed by the renderer can be toggled through
+@ref enable(), @ref disable() and @ref setFeature() --- these are
+@ref Renderer::Feature::Blending, @relativeref{Renderer::Feature,DepthTest},
+@relativeref{Renderer::Feature,Dithering},
+@relativeref{Renderer::Feature,FaceCulling},
+@relativeref{Renderer::Feature,PolygonOffsetFill},
+@relativeref{Renderer::Feature,ScissorTest},
+@relativeref{Renderer::Feature,StencilTest},
+@relativeref{Renderer::Feature,RasterizerDiscard},
+@relativeref{Renderer::Feature,DepthClamp},
+@relativeref{Renderer::Feature,LogicOperation},
+@relativeref{Renderer::Feature,Multisampling} and
+@relativeref{Renderer::Feature,ProgramPointSize}, where available on given
+target. Stencil function, operation and mask are set for both faces.
+*/
+class MAGNUM_GL_EXPORT RenderState {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty block, applying which does nothing.
+         */
+        explicit RenderState() noexcept;
+
+        /**
+         * @brief Enable a feature
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p feature is one of the features listed in the
+         * class documentation.
+         * @see @ref Renderer::enable()
+         */
+        RenderState& enable(Renderer::Feature feature) {
+            return setFeature(feature, true);
+        }
+
+        /**
+         * @brief Disable a feature
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p feature is one of the features listed in the
+         * class documentation.
+         * @see @ref Renderer::disable()
+         */
+        RenderState& disable(Renderer::Feature feature) {
+            return setFeature(feature, false);
+        }
+
+        /**
+         * @brief Enable or disable a feature
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p feature is one of the features listed in the
+         * class documentation.
+         * @see @ref Renderer::setFeature()
+         */
+        RenderState& setFeature(Renderer::Feature feature, bool enabled);
+
+        /**
+         * @brief Set blend equation
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendEquation(Renderer::BlendEquation)
+         */
+        RenderState& setBlendEquation(Renderer::BlendEquation equation) {
+            return setBlendEquation(equation, equation);
+        }
+
+        /**
+         * @brief Set blend equation separately for RGB and alpha components
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendEquation(Renderer::BlendEquation, Renderer::BlendEquation)
+         */
+        RenderState& setBlendEquation(Renderer::BlendEquation rgb, Renderer::BlendEquation alpha);
+
+        /**
+         * @brief Set blend function
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendFunction(Renderer::BlendFunction, Renderer::BlendFunction)
+         */
+        RenderState& setBlendFunction(Renderer::BlendFunction source, Renderer::BlendFunction destination) {
+            return setBlendFunction(source, destination, source, destination);
+        }
+
+        /**
+         * @brief Set blend function separately for RGB and alpha components
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendFunction(Renderer::BlendFunction, Renderer::BlendFunction, Renderer::BlendFunction, Renderer::BlendFunction)
+         */
+        RenderState& setBlendFunction(Renderer::BlendFunction sourceRgb, Renderer::BlendFunction destinationRgb, Renderer::BlendFunction sourceAlpha, Renderer::BlendFunction destinationAlpha);
+
+        /**
+         * @brief Set blend color
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setBlendColor()
+         */
+        RenderState& setBlendColor(const Color4& color);
+
+        /**
+         * @brief Set depth function
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setDepthFunction()
+         */
+        RenderState& setDepthFunction(Renderer::DepthFunction function);
+
+        /**
+         * @brief Mask depth writes
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setDepthMask()
+         */
+        RenderState& setDepthMask(bool allow);
+
+        /**
+         * @brief Mask color writes
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setColorMask(GLboolean, GLboolean, GLboolean, GLboolean)
+         */
+        RenderState& setColorMask(bool allowRed, bool allowGreen, bool allowBlue, bool allowAlpha);
+
+        /**
+         * @brief Set front-facing polygon winding
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setFrontFace()
+         */
+        RenderState& setFrontFace(Renderer::FrontFace mode);
+
+        /**
+         * @brief Set which polygon facing to cull
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setFaceCullingMode()
+         */
+        RenderState& setFaceCullingMode(Renderer::PolygonFacing mode);
+
+        /**
+         * @brief Set polygon offset
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setPolygonOffset()
+         */
+        RenderState& setPolygonOffset(Float factor, Float units);
+
+        /**
+         * @brief Set line width
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setLineWidth()
+         */
+        RenderState& setLineWidth(Float width);
+
+        /**
+         * @brief Set stencil function for both faces
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setStencilFunction(Renderer::StencilFunction, Int, UnsignedInt)
+         */
+        RenderState& setStencilFunction(Renderer::StencilFunction function, Int referenceValue, UnsignedInt mask);
+
+        /**
+         * @brief Set stencil operation for both faces
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setStencilOperation(Renderer::StencilOperation, Renderer::StencilOperation, Renderer::StencilOperation)
+         */
+        RenderState& setStencilOperation(Renderer::StencilOperation stencilFail, Renderer::StencilOperation depthFail, Renderer::StencilOperation depthPass);
+
+        /**
+         * @brief Mask stencil writes for both faces
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setStencilMask(UnsignedInt)
+         */
+        RenderState& setStencilMask(UnsignedInt allowBits);
+
+        /**
+         * @brief Set scissor rectangle
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Renderer::setScissor()
+         */
+        RenderState& setScissor(const Range2Di& rectangle);
+
+        /**
+         * @brief Apply the state
+         *
+         * Calls the corresponding @ref Renderer functions for all values
+         * that were set, values that are already set in the renderer don't
+         * result in any GL calls.
+         */
+        void apply() const;
+
+    private:
+        enum: UnsignedInt {
+            BlendEquation = 1 << 0,
+            BlendFunction = 1 << 1,
+            BlendColor = 1 << 2,
+            DepthFunction = 1 << 3,
+            DepthMask = 1 << 4,
+            ColorMask = 1 << 5,
+            FrontFace = 1 << 6,
+            FaceCullingMode = 1 << 7,
+            PolygonOffset = 1 << 8,
+            LineWidth = 1 << 9,
+            StencilFunction = 1 << 10,
+            StencilOperation = 1 << 11,
+            StencilMask = 1 << 12,
+            Scissor = 1 << 13
+        };
+
+        UnsignedInt _set;
+        UnsignedShort _setFeatures, _enabledFeatures;
+        Renderer::BlendEquation _blendEquationRgb, _blendEquationAlpha;
+        Renderer::BlendFunction _blendSourceRgb, _blendDestinationRgb,
+            _blendSourceAlpha, _blendDestinationAlpha;
+        Color4 _blendColor;
+        Renderer::DepthFunction _depthFunction;
+        bool _depthMask;
+        /* RGBA in bits 0 to 3 */
+        UnsignedByte _colorMask;
+        Renderer::FrontFace _frontFace;
+        Renderer::PolygonFacing _faceCullingMode;
+        Float _polygonOffsetFactor, _polygonOffsetUnits;
+        Float _lineWidth;
+        Renderer::StencilFunction _stencilFunction;
+        Int _stencilReference;
+        UnsignedInt _stencilValueMask;
+        Renderer::StencilOperation _stencilFail, _stencilDepthFail,
+            _stencilDepthPass;
+        UnsignedInt _stencilWriteMask;
+        Range2Di _scissor;
+};
+
+}}
+
+#endif
@@ -35,6 +35,97 @@
 
 namespace Magnum { namespace GL {
 
+namespace {
+
+typedef Implementation::RendererState::FixedFunction Shadow;
+
+/* Math::Vector comparison is fuzzy, but here we need to know whether the
+   value actually changed */
+bool exactlyEqual(const Color4& a, const Color4& b) {
+    return a.r() == b.r() && a.g() == b.g() && a.b() == b.b() && a.a() == b.a();
+}
+
+/* Bit 0 is front face, bit 1 back face, matching the two bits reserved for
+   each stencil group in the shadow */
+UnsignedInt stencilFaces(const Renderer::PolygonFacing facing) {
+    return facing == Renderer::PolygonFacing::Front ? 1 :
+           facing == Renderer::PolygonFacing::Back ? 2 : 3;
+}
+
+bool elideStencilFunction(Implementation::RendererState& state, const UnsignedInt faces, const GLenum function, const Int referenceValue, const UnsignedInt mask) {
+    Shadow& shadow = state.fixedFunction;
+    bool equal = true;
+    for(UnsignedInt i = 0; i != 2; ++i) if(faces & (1 << i))
+        equal = equal && shadow.stencilFunction[i] == function && shadow.stencilReference[i] == referenceValue && shadow.stencilValueMask[i] == mask;
+    if(state.elideStateChange(faces*Shadow::StencilFunction, equal))
+        return true;
+
+    for(UnsignedInt i = 0; i != 2; ++i) if(faces & (1 << i)) {
+        shadow.stencilFunction[i] = function;
+        shadow.stencilReference[i] = referenceValue;
+        shadow.stencilValueMask[i] = mask;
+    }
+    return false;
+}
+
+bool elideStencilOperation(Implementation::RendererState& state, const UnsignedInt faces, const GLenum stencilFail, const GLenum depthFail, const GLenum depthPass) {
+    Shadow& shadow = state.fixedFunction;
+    bool equal = true;
+    for(UnsignedInt i = 0; i != 2; ++i) if(faces & (1 << i))
+        equal = equal && shadow.stencilFail[i] == stencilFail && shadow.stencilDepthFail[i] == depthFail && shadow.stencilDepthPass[i] == depthPass;
+    if(state.elideStateChange(faces*Shadow::StencilOperation, equal))
+        return true;
+
+    for(UnsignedInt i = 0; i != 2; ++i) if(faces & (1 << i)) {
+        shadow.stencilFail[i] = stencilFail;
+        shadow.stencilDepthFail[i] = depthFail;
+        shadow.stencilDepthPass[i] = depthPass;
+    }
+    return false;
+}
+
+bool elideStencilMask(Implementation::RendererState& state, const UnsignedInt faces, const UnsignedInt allowBits) {
+    Shadow& shadow = state.fixedFunction;
+    bool equal = true;
+    for(UnsignedInt i = 0; i != 2; ++i) if(faces & (1 << i))
+        equal = equal && shadow.stencilWriteMask[i] == allowBits;
+    if(state.elideStateChange(faces*Shadow::StencilMask, equal))
+        return true;
+
+    for(UnsignedInt i = 0; i != 2; ++i) if(faces & (1 << i))
+        shadow.stencilWriteMask[i] = allowBits;
+    return false;
+}
+
+bool elideBlendEquation(Implementation::RendererState& state, const GLenum rgb, const GLenum alpha) {
+    Shadow& shadow = state.fixedFunction;
+    if(state.elideStateChange(Shadow::BlendEquation,
+        shadow.blendEquationRgb == rgb && shadow.blendEquationAlpha == alpha))
+        return true;
+
+    shadow.blendEquationRgb = rgb;
+    shadow.blendEquationAlpha = alpha;
+    return false;
+}
+
+bool elideBlendFunction(Implementation::RendererState& state, const GLenum sourceRgb, const GLenum destinationRgb, const GLenum sourceAlpha, const GLenum destinationAlpha) {
+    Shadow& shadow = state.fixedFunction;
+    if(state.elideStateChange(Shadow::BlendFunction,
+        shadow.blendSourceRgb == sourceRgb &&
+        shadow.blendDestinationRgb == destinationRgb &&
+        shadow.blendSourceAlpha == sourceAlpha &&
+        shadow.blendDestinationAlpha == destinationAlpha))
+        return true;
+
+    shadow.blendSourceRgb = sourceRgb;
+    shadow.blendDestinationRgb = destinationRgb;
+    shadow.blendSourceAlpha = sourceAlpha;
+    shadow.blendDestinationAlpha = destinationAlpha;
+    return false;
+}
+
+}
+
 Range1D Renderer::lineWidthRange() {
     auto& state = *Context::current().state().renderer;
     Range1D& value = state.lineWidthRange;
@@ -61,10 +152,14 @@ Range1D Renderer::lineWidthRangeImplementationMesaForwardCompatible() {
 #endif
 
 void Renderer::enable(const Feature feature) {
+    if(Context::current().state().renderer->elideFeature(GLenum(feature), true))
+        return;
     glEnable(GLenum(feature));
 }
 
 void Renderer::disable(const Feature feature) {
+    if(Context::current().state().renderer->elideFeature(GLenum(feature), false))
+        return;
     glDisable(GLenum(feature));
 }
 
@@ -74,11 +169,16 @@ void Renderer::setFeature(const Feature feature, const bool enabled) {
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderer::enable(const Feature feature, const UnsignedInt drawBuffer) {
-    Context::current().state().renderer->enableiImplementation(GLenum(feature), drawBuffer);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    /* Per-buffer state can't be represented in the shadow, forget it */
+    state.invalidateFeature(GLenum(feature));
+    state.enableiImplementation(GLenum(feature), drawBuffer);
 }
 
 void Renderer::disable(const Feature feature, const UnsignedInt drawBuffer) {
-    Context::current().state().renderer->disableiImplementation(GLenum(feature), drawBuffer);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    state.invalidateFeature(GLenum(feature));
+    state.disableiImplementation(GLenum(feature), drawBuffer);
 }
 
 void Renderer::setFeature(const Feature feature, const UnsignedInt drawBuffer, const bool enabled) {
@@ -91,6 +191,10 @@ void Renderer::setHint(const Hint target, const HintMode mode) {
 }
 
 void Renderer::setClearColor(const Color4& color) {
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(state.elideStateChange(Shadow::ClearColor, exactlyEqual(state.fixedFunction.clearColor, color)))
+        return;
+    state.fixedFunction.clearColor = color;
     glClearColor(color.r(), color.g(), color.b(), color.a());
 }
 
@@ -109,10 +213,18 @@ void Renderer::setClearStencil(const Int stencil) {
 }
 
 void Renderer::setFrontFace(const FrontFace mode) {
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(state.elideStateChange(Shadow::FrontFace, state.fixedFunction.frontFace == GLenum(mode)))
+        return;
+    state.fixedFunction.frontFace = GLenum(mode);
     glFrontFace(GLenum(mode));
 }
 
 void Renderer::setFaceCullingMode(const PolygonFacing mode) {
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(state.elideStateChange(Shadow::FaceCullingMode, state.fixedFunction.faceCullingMode == GLenum(mode)))
+        return;
+    state.fixedFunction.faceCullingMode = GLenum(mode);
     glCullFace(GLenum(mode));
 }
 
@@ -134,15 +246,30 @@ void Renderer::setPolygonMode(const PolygonMode mode) {
 #endif
 
 void Renderer::setPolygonOffset(const Float factor, const Float units) {
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(state.elideStateChange(Shadow::PolygonOffset,
+        state.fixedFunction.polygonOffsetFactor == factor &&
+        state.fixedFunction.polygonOffsetUnits == units))
+        return;
+    state.fixedFunction.polygonOffsetFactor = factor;
+    state.fixedFunction.polygonOffsetUnits = units;
     glPolygonOffset(factor, units);
 }
 
 void Renderer::setLineWidth(const Float width) {
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(state.elideStateChange(Shadow::LineWidth, state.fixedFunction.lineWidth == width))
+        return;
+    state.fixedFunction.lineWidth = width;
     glLineWidth(width);
 }
 
 #ifndef MAGNUM_TARGET_GLES
 void Renderer::setPointSize(const Float size) {
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(state.elideStateChange(Shadow::PointSize, state.fixedFunction.pointSize == size))
+        return;
+    state.fixedFunction.pointSize = size;
     glPointSize(size);
 }
 #endif
@@ -279,86 +406,138 @@ UnsignedInt Renderer::maxCombinedClipAndCullDistances() {
 #endif
 
 void Renderer::setScissor(const Range2Di& rectangle) {
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(state.elideStateChange(Shadow::Scissor, state.fixedFunction.scissor == rectangle))
+        return;
+    state.fixedFunction.scissor = rectangle;
     glScissor(rectangle.left(), rectangle.bottom(), rectangle.sizeX(), rectangle.sizeY());
 }
 
 void Renderer::setStencilFunction(const PolygonFacing facing, const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    if(elideStencilFunction(*Context::current().state().renderer, stencilFaces(facing), GLenum(function), referenceValue, mask))
+        return;
     glStencilFuncSeparate(GLenum(facing), GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilFunction(const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    if(elideStencilFunction(*Context::current().state().renderer, 3, GLenum(function), referenceValue, mask))
+        return;
     glStencilFunc(GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilOperation(const PolygonFacing facing, const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
+    if(elideStencilOperation(*Context::current().state().renderer, stencilFaces(facing), GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass)))
+        return;
     glStencilOpSeparate(GLenum(facing), GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setStencilOperation(const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
+    if(elideStencilOperation(*Context::current().state().renderer, 3, GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass)))
+        return;
     glStencilOp(GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setDepthFunction(const DepthFunction function) {
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(state.elideStateChange(Shadow::DepthFunction, state.fixedFunction.depthFunction == GLenum(function)))
+        return;
+    state.fixedFunction.depthFunction = GLenum(function);
     glDepthFunc(GLenum(function));
 }
 
 void Renderer::setColorMask(const GLboolean allowRed, const GLboolean allowGreen, const GLboolean allowBlue, const GLboolean allowAlpha) {
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    const UnsignedByte mask = (allowRed ? 1 : 0)|(allowGreen ? 2 : 0)|
+                              (allowBlue ? 4 : 0)|(allowAlpha ? 8 : 0);
+    if(state.elideStateChange(Shadow::ColorMask, state.fixedFunction.colorMask == mask))
+        return;
+    state.fixedFunction.colorMask = mask;
     glColorMask(allowRed, allowGreen, allowBlue, allowAlpha);
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderer::setColorMask(const UnsignedInt drawBuffer, const GLboolean allowRed, const GLboolean allowGreen, const GLboolean allowBlue, const GLboolean allowAlpha) {
-    Context::current().state().renderer->colorMaskiImplementation(drawBuffer, allowRed, allowGreen, allowBlue, allowAlpha);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    state.fixedFunction.known &= ~Shadow::ColorMask;
+    state.colorMaskiImplementation(drawBuffer, allowRed, allowGreen, allowBlue, allowAlpha);
 }
 #endif
 
 void Renderer::setDepthMask(const GLboolean allow) {
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(state.elideStateChange(Shadow::DepthMask, !state.fixedFunction.depthMask == !allow))
+        return;
+    state.fixedFunction.depthMask = allow;
     glDepthMask(allow);
 }
 
 void Renderer::setStencilMask(const PolygonFacing facing, const UnsignedInt allowBits) {
+    if(elideStencilMask(*Context::current().state().renderer, stencilFaces(facing), allowBits))
+        return;
     glStencilMaskSeparate(GLenum(facing), allowBits);
 }
 
 void Renderer::setStencilMask(const UnsignedInt allowBits) {
+    if(elideStencilMask(*Context::current().state().renderer, 3, allowBits))
+        return;
     glStencilMask(allowBits);
 }
 
 void Renderer::setBlendEquation(const BlendEquation equation) {
+    if(elideBlendEquation(*Context::current().state().renderer, GLenum(equation), GLenum(equation)))
+        return;
     glBlendEquation(GLenum(equation));
 }
 
 void Renderer::setBlendEquation(const BlendEquation rgb, const BlendEquation alpha) {
+    if(elideBlendEquation(*Context::current().state().renderer, GLenum(rgb), GLenum(alpha)))
+        return;
     glBlendEquationSeparate(GLenum(rgb), GLenum(alpha));
 }
 
 void Renderer::setBlendFunction(const BlendFunction source, const BlendFunction destination) {
+    if(elideBlendFunction(*Context::current().state().renderer, GLenum(source), GLenum(destination), GLenum(source), GLenum(destination)))
+        return;
     glBlendFunc(GLenum(source), GLenum(destination));
 }
 
 void Renderer::setBlendFunction(const BlendFunction sourceRgb, const BlendFunction destinationRgb, const BlendFunction sourceAlpha, const BlendFunction destinationAlpha) {
+    if(elideBlendFunction(*Context::current().state().renderer, GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha)))
+        return;
     glBlendFuncSeparate(GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderer::setBlendEquation(const UnsignedInt drawBuffer, const BlendEquation equation) {
-    Context::current().state().renderer->blendEquationiImplementation(drawBuffer, GLenum(equation));
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    state.fixedFunction.known &= ~Shadow::BlendEquation;
+    state.blendEquationiImplementation(drawBuffer, GLenum(equation));
 }
 
 void Renderer::setBlendEquation(const UnsignedInt drawBuffer, const BlendEquation rgb, const BlendEquation alpha) {
-    Context::current().state().renderer->blendEquationSeparateiImplementation(drawBuffer, GLenum(rgb), GLenum(alpha));
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    state.fixedFunction.known &= ~Shadow::BlendEquation;
+    state.blendEquationSeparateiImplementation(drawBuffer, GLenum(rgb), GLenum(alpha));
 }
 
 void Renderer::setBlendFunction(const UnsignedInt drawBuffer, const BlendFunction source, const BlendFunction destination) {
-    Context::current().state().renderer->blendFunciImplementation(drawBuffer, GLenum(source), GLenum(destination));
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    state.fixedFunction.known &= ~Shadow::BlendFunction;
+    state.blendFunciImplementation(drawBuffer, GLenum(source), GLenum(destination));
 }
 
 void Renderer::setBlendFunction(const UnsignedInt drawBuffer, const BlendFunction sourceRgb, const BlendFunction destinationRgb, const BlendFunction sourceAlpha, const BlendFunction destinationAlpha) {
-    Context::current().state().renderer->blendFuncSeparateiImplementation(drawBuffer, GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    state.fixedFunction.known &= ~Shadow::BlendFunction;
+    state.blendFuncSeparateiImplementation(drawBuffer, GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
 }
 #endif
 
 void Renderer::setBlendColor(const Color4& color) {
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(state.elideStateChange(Shadow::BlendColor, exactlyEqual(state.fixedFunction.blendColor, color)))
+        return;
+    state.fixedFunction.blendColor = color;
     glBlendColor(color.r(), color.g(), color.b(), color.a());
 }
 
@@ -379,6 +558,14 @@ void Renderer::setMemoryBarrier(MemoryBarriers barriers) {
 }
 #endif
 
+UnsignedLong Renderer::elidedStateChangeCount() {
+    return Context::current().state().renderer->elidedStateChangeCount;
+}
+
+void Renderer::resetElidedStateChangeCount() {
+    Context::current().state().renderer->elidedStateChangeCount = 0;
+}
+
 #ifndef MAGNUM_TARGET_WEBGL
 Renderer::ResetNotificationStrategy Renderer::resetNotificationStrategy() {
     #ifndef MAGNUM_TARGET_GLES
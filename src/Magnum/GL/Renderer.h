@@ -47,6 +47,29 @@ namespace Implementation { struct RendererState; }
 /** @nosubgrouping
 @brief Global renderer configuration
 
+@section GL-Renderer-state-tracking Redundant state elimination
+
+Most of the fixed-function state --- commonly toggled features such as
+@ref Feature::Blending, @ref Feature::DepthTest or
+@ref Feature::FaceCulling, blend equation, function and color, depth
+function, color, depth and stencil masks, stencil function and operation,
+front face, face culling mode, polygon offset, line width, point size,
+scissor rectangle and clear color --- is shadowed in the context and setting
+a value that's already set is a no-op that doesn't reach GL. This makes it
+cheap to set up the full state before each draw without having to track
+what the previous draw left behind. Use @ref RenderState to group the state
+for a particular draw and apply it at once. The amount of calls skipped this
+way can be queried with @ref elidedStateChangeCount() or tracked per frame
+with @ref DebugTools::GLFrameProfiler::Value::ElidedStateChanges.
+
+The shadow starts empty, so the first call for each value always goes to
+GL. Draw-buffer-indexed variants such as
+@ref setBlendFunction(UnsignedInt, BlendFunction, BlendFunction) can't be
+represented in the shadow and only invalidate the corresponding value. If
+you modify the state through raw GL calls or interact with third-party GL
+code, call @ref Context::resetState() with @ref Context::State::Renderer
+afterwards --- see @ref opengl-state-tracking for more information.
+
 @todo @gl_extension{ARB,viewport_array}
 @todo `GL_POINT_SIZE_GRANULARITY`, `GL_POINT_SIZE_RANGE` (?)
 @todo `GL_STEREO`, `GL_DOUBLEBUFFER` (?)
@@ -2176,6 +2199,27 @@ class MAGNUM_GL_EXPORT Renderer {
         static GraphicsResetStatus graphicsResetStatus();
         #endif
 
+        /**
+         * @brief Count of elided state changes
+         * @m_since_latest
+         *
+         * Count of state-setting calls that were not passed to GL because
+         * the value was already set. The count is accumulated since context
+         * creation or the last @ref resetElidedStateChangeCount() call. See
+         * @ref GL-Renderer-state-tracking for more information.
+         * @see @ref DebugTools::GLFrameProfiler::Value::ElidedStateChanges
+         */
+        static UnsignedLong elidedStateChangeCount();
+
+        /**
+         * @brief Reset the count of elided state changes
+         * @m_since_latest
+         *
+         * Call for example at the beginning of each frame to get a per-frame
+         * count from @ref elidedStateChangeCount().
+         */
+        static void resetElidedStateChangeCount();
+
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
         /**
@@ -61,6 +61,18 @@ Source number `0` is a @glsl #version @ce directive added in the constructor
 (unless @ref Version::None is specified). which means the first added source
 has a number `1`.
 
+@section GL-Shader-async Asynchronous compilation
+
+The @ref compile() functions submit all shaders for compilation and then
+immediately query their status, which blocks until the driver is done. To
+avoid stalls for example during a loading screen, the two steps can be done
+separately with @ref submitCompile() and @ref checkCompile(), polling
+@ref isCompileFinished() in between. The poll doesn't block if
+@gl_extension{KHR,parallel_shader_compile} is supported, on drivers without it
+it always returns @cpp true @ce and the compilation finishes in
+@ref checkCompile(). See @ref GL-AbstractShaderProgram-async for a complete
+example including linking.
+
 @section GL-Shader-performance-optimizations Performance optimizations
 
 Shader limits and implementation-defined values (such as @ref maxUniformComponents())
@@ -641,12 +653,56 @@ class MAGNUM_GL_EXPORT Shader: public AbstractObject {
          * using @ref compile(std::initializer_list<Containers::Reference<Shader>>)
          * for improved performance, see its documentation for more
          * information.
+         * @see @ref submitCompile(), @ref checkCompile()
          */
         bool compile();
 
+        /**
+         * @brief Submit the shader for compilation
+         * @m_since_latest
+         *
+         * Uploads the sources and starts compilation without waiting for its
+         * result. Together with @ref isCompileFinished() and
+         * @ref checkCompile() this allows compiling shaders asynchronously,
+         * see @ref GL-Shader-async for more information.
+         * @see @fn_gl_keyword{ShaderSource}, @fn_gl_keyword{CompileShader}
+         */
+        void submitCompile();
+
+        /**
+         * @brief Whether a submitted compilation is finished
+         * @m_since_latest
+         *
+         * If @gl_extension{KHR,parallel_shader_compile} is supported, queries
+         * the completion status without blocking. Otherwise always returns
+         * @cpp true @ce, as the compilation is then done synchronously by
+         * @ref checkCompile().
+         * @see @ref submitCompile(), @fn_gl_keyword{GetShader} with
+         *      @def_gl_extension{COMPLETION_STATUS,KHR,parallel_shader_compile}
+         */
+        bool isCompileFinished();
+
+        /**
+         * @brief Check compilation status
+         * @m_since_latest
+         *
+         * Returns @cpp false @ce if compilation submitted by
+         * @ref submitCompile() failed, @cpp true @ce otherwise. Compiler
+         * messages (if any) are printed to error output. If the compilation
+         * isn't finished yet, this function blocks until it is.
+         * @see @ref isCompileFinished(), @fn_gl_keyword{GetShader} with
+         *      @def_gl{COMPILE_STATUS} and @def_gl{INFO_LOG_LENGTH},
+         *      @fn_gl_keyword{GetShaderInfoLog}
+         */
+        bool checkCompile();
+
     private:
         Shader& setLabelInternal(Containers::ArrayView<const char> label);
 
+        bool checkCompileInternal(Int index);
+
+        static MAGNUM_GL_LOCAL void APIENTRY completionStatusImplementationFallback(GLuint, GLenum, GLint* value);
+
         void MAGNUM_GL_LOCAL addSourceImplementationDefault(std::string source);
         #if defined(CORRADE_TARGET_EMSCRIPTEN) && defined(__EMSCRIPTEN_PTHREADS__)
         void MAGNUM_GL_LOCAL addSourceImplementationEmscriptenPthread(std::string source);
@@ -0,0 +1,176 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StreamingBuffer.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+
+namespace Magnum { namespace GL {
+
+StreamingBuffer::StreamingBuffer(const std::size_t size, const UnsignedInt regionCount, const Buffer::TargetHint targetHint): _buffer{targetHint}, _size{size}, _offset{}, _flushed{}, _regionCount{regionCount}, _region{}, _orphaned{}
+    #ifndef MAGNUM_TARGET_GLES
+    , _mapped{}
+    #endif
+{
+    CORRADE_ASSERT(size && regionCount,
+        "GL::StreamingBuffer: expected non-zero size and region count but got" << size << "and" << regionCount, );
+
+    /* Immutable storage mapped once, each frame in a different region */
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::ARB::buffer_storage>()) {
+        _buffer.setStorage(size*regionCount, Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent);
+        _mapped = _buffer.map(0, size*regionCount, Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::FlushExplicit).data();
+        _fences = Containers::Array<GLsync>{Containers::ValueInit, regionCount};
+        return;
+    }
+    #endif
+
+    /* Otherwise a CPU-side copy that gets uploaded into orphaned storage */
+    _buffer.setData({nullptr, size}, BufferUsage::StreamDraw);
+    _data = Containers::Array<char>{Containers::NoInit, size};
+}
+
+StreamingBuffer::StreamingBuffer(NoCreateT) noexcept: _buffer{NoCreate}, _size{}, _offset{}, _flushed{}, _regionCount{}, _region{}, _orphaned{}
+    #ifndef MAGNUM_TARGET_GLES
+    , _mapped{}
+    #endif
+    {}
+
+StreamingBuffer::StreamingBuffer(StreamingBuffer&& other) noexcept: _buffer{std::move(other._buffer)}, _size{other._size}, _offset{other._offset}, _flushed{other._flushed}, _regionCount{other._regionCount}, _region{other._region}, _orphaned{other._orphaned}, _data{std::move(other._data)}
+    #ifndef MAGNUM_TARGET_GLES
+    , _mapped{other._mapped}, _fences{std::move(other._fences)}
+    #endif
+{
+    #ifndef MAGNUM_TARGET_GLES
+    other._mapped = nullptr;
+    #endif
+}
+
+StreamingBuffer::~StreamingBuffer() {
+    /* The buffer gets implicitly unmapped on deletion */
+    #ifndef MAGNUM_TARGET_GLES
+    for(GLsync fence: _fences) if(fence) glDeleteSync(fence);
+    #endif
+}
+
+StreamingBuffer& StreamingBuffer::operator=(StreamingBuffer&& other) noexcept {
+    using std::swap;
+    swap(_buffer, other._buffer);
+    swap(_size, other._size);
+    swap(_offset, other._offset);
+    swap(_flushed, other._flushed);
+    swap(_regionCount, other._regionCount);
+    swap(_region, other._region);
+    swap(_orphaned, other._orphaned);
+    swap(_data, other._data);
+    #ifndef MAGNUM_TARGET_GLES
+    swap(_mapped, other._mapped);
+    swap(_fences, other._fences);
+    #endif
+    return *this;
+}
+
+bool StreamingBuffer::isPersistent() const {
+    #ifndef MAGNUM_TARGET_GLES
+    return _mapped;
+    #else
+    return false;
+    #endif
+}
+
+std::pair<GLintptr, Containers::ArrayView<char>> StreamingBuffer::allocate(const std::size_t size, const std::size_t alignment) {
+    CORRADE_ASSERT(alignment && !(alignment & (alignment - 1)),
+        "GL::StreamingBuffer::allocate(): expected alignment to be a power of two but got" << alignment, {});
+
+    /* If the region was used before, wait until the GPU is done with it */
+    std::size_t base = 0;
+    #ifndef MAGNUM_TARGET_GLES
+    if(_mapped) {
+        base = _region*_size;
+        GLsync& fence = _fences[_region];
+        if(fence) {
+            /* Waiting a millisecond at a time */
+            while(glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    #endif
+
+    /* Alignment is relative to the buffer start, not to the region start */
+    const std::size_t offset = ((base + _offset + alignment - 1) & ~(alignment - 1)) - base;
+    CORRADE_ASSERT(offset + size <= _size,
+        "GL::StreamingBuffer::allocate(): can't fit" << size << "bytes with alignment" << alignment << "into" << _size - _offset << "bytes remaining for the frame", {});
+    _offset = offset + size;
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(_mapped) return {GLintptr(base + offset), {_mapped + base + offset, size}};
+    #endif
+    return {GLintptr(offset), _data.slice(offset, offset + size)};
+}
+
+StreamingBuffer& StreamingBuffer::flush() {
+    if(_flushed == _offset) return *this;
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(_mapped) {
+        _buffer.flushMappedRange(GLintptr(_region*_size + _flushed), GLsizeiptr(_offset - _flushed));
+        _flushed = _offset;
+        return *this;
+    }
+    #endif
+
+    /* Orphan the storage on first upload in a frame so the driver doesn't
+       need to wait for commands using the previous contents */
+    if(!_orphaned) {
+        _buffer.setData({nullptr, _size}, BufferUsage::StreamDraw);
+        _orphaned = true;
+    }
+    _buffer.setSubData(GLintptr(_flushed), _data.slice(_flushed, _offset));
+    _flushed = _offset;
+    return *this;
+}
+
+StreamingBuffer& StreamingBuffer::finishFrame() {
+    flush();
+
+    /* Nothing to guard if nothing was allocated, the region can be used for
+       the next frame again */
+    #ifndef MAGNUM_TARGET_GLES
+    if(_mapped && _offset) {
+        _fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        _region = (_region + 1) % _regionCount;
+    }
+    #endif
+
+    _offset = _flushed = 0;
+    _orphaned = false;
+    return *this;
+}
+
+}}
@@ -0,0 +1,203 @@
+#ifndef Magnum_GL_StreamingBuffer_h
+#define Magnum_GL_StreamingBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::StreamingBuffer
+ * @m_since_latest
+ */
+
+#include <utility>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/GL/Buffer.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Streaming buffer
+@m_since_latest
+
+Manages a @ref Buffer for data that are generated anew every frame, such as
+per-frame uniforms or dynamic vertex data, handing out aligned
+sub-allocations for each frame.
+
+@section GL-StreamingBuffer-usage Usage
+
+Allocate space for each upload with @ref allocate(), fill the returned view
+and use the returned offset when binding the buffer or setting up the mesh.
+Before issuing draws that use the data, call @ref flush(). At the end of the
+frame call @ref finishFrame(), which makes the allocated space available again
+once the GPU is done with it:
+
+@snippet MagnumGL.cpp StreamingBuffer-usage
+
+@section GL-StreamingBuffer-persistent Persistent mapping
+
+If @gl_extension{ARB,buffer_storage} (part of OpenGL 4.4) is available, the
+buffer is allocated with immutable storage of @ref size() times
+@ref regionCount() bytes, which is mapped just once for the whole lifetime
+of the instance using @ref Buffer::MapFlag::Persistent and
+@ref Buffer::MapFlag::FlushExplicit. Each frame uses a different region of
+the buffer, @ref finishFrame() inserts a fence after commands of the frame
+and the first allocation in a region that's used again waits for its fence,
+which means the CPU is never writing into memory that the GPU is still
+reading from. The @ref flush() calls @ref Buffer::flushMappedRange() on the
+range written since the previous call.
+
+@section GL-StreamingBuffer-orphaning Orphaning
+
+On OpenGL ES, WebGL and if @gl_extension{ARB,buffer_storage} is not
+available, the buffer has just @ref size() bytes and @ref allocate() hands
+out views into a CPU-side copy of it. The first @ref flush() in each frame
+reallocates the buffer storage using @ref Buffer::setData() with a
+@cpp nullptr @ce view, which lets the driver keep the old storage alive for
+commands still in flight instead of stalling, and then uploads the written
+range with @ref Buffer::setSubData(). Subsequent @ref flush() calls in the
+same frame only upload the newly written ranges. The @ref regionCount()
+isn't used in this case.
+
+The persistent mapping can be disabled with the
+@ref GL-Context-command-line "--magnum-disable-extensions GL_ARB_buffer_storage"
+command-line option, which is useful for testing the orphaning code path.
+@see @ref isPersistent()
+*/
+class MAGNUM_GL_EXPORT StreamingBuffer {
+    public:
+        /**
+         * @brief Constructor
+         * @param size          Capacity for data of a single frame, in bytes
+         * @param regionCount   Count of frames that can be in flight
+         * @param targetHint    Target hint for the underlying buffer
+         *
+         * Expects that both @p size and @p regionCount are non-zero. See
+         * @ref GL-StreamingBuffer-persistent and
+         * @ref GL-StreamingBuffer-orphaning for how the underlying buffer is
+         * allocated.
+         */
+        explicit StreamingBuffer(std::size_t size, UnsignedInt regionCount = 3, Buffer::TargetHint targetHint = Buffer::TargetHint::Array);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit StreamingBuffer(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        StreamingBuffer(const StreamingBuffer&) = delete;
+
+        /** @brief Move constructor */
+        StreamingBuffer(StreamingBuffer&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes the underlying buffer and all fences that are still
+         * pending.
+         */
+        ~StreamingBuffer();
+
+        /** @brief Copying is not allowed */
+        StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+        /** @brief Move assignment */
+        StreamingBuffer& operator=(StreamingBuffer&& other) noexcept;
+
+        /** @brief Underlying buffer */
+        Buffer& buffer() { return _buffer; }
+
+        /** @brief Capacity for data of a single frame, in bytes */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Count of frames that can be in flight
+         *
+         * Used only if @ref isPersistent() is @cpp true @ce.
+         */
+        UnsignedInt regionCount() const { return _regionCount; }
+
+        /**
+         * @brief Whether the buffer is persistently mapped
+         *
+         * See @ref GL-StreamingBuffer-persistent and
+         * @ref GL-StreamingBuffer-orphaning for more information.
+         */
+        bool isPersistent() const;
+
+        /** @brief Bytes allocated in the current frame, including alignment */
+        std::size_t usedSize() const { return _offset; }
+
+        /**
+         * @brief Allocate space for data in the current frame
+         * @param size          Size in bytes
+         * @param alignment     Alignment of the buffer offset in bytes
+         * @return Offset in @ref buffer() and a view to write the data to
+         *
+         * The @p alignment is expected to be a power of two, for uniform
+         * buffer ranges use @ref Buffer::uniformOffsetAlignment(). The data
+         * have to be written before the next @ref flush() and the view can't
+         * be used after. Expects that the allocation fits into the space that
+         * remains for the current frame.
+         */
+        std::pair<GLintptr, Containers::ArrayView<char>> allocate(std::size_t size, std::size_t alignment = 4);
+
+        /**
+         * @brief Make the data written so far available to OpenGL
+         * @return Reference to self (for method chaining)
+         *
+         * Has to be called before issuing any commands that use the data.
+         * Does nothing if nothing was allocated since the previous call.
+         */
+        StreamingBuffer& flush();
+
+        /**
+         * @brief Finish current frame
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref flush() and makes the space allocated in the current
+         * frame available for reuse once the GPU is done with it. Call after
+         * all commands using the data of the current frame were issued.
+         */
+        StreamingBuffer& finishFrame();
+
+    private:
+        Buffer _buffer;
+        std::size_t _size, _offset, _flushed;
+        UnsignedInt _regionCount, _region;
+        bool _orphaned;
+        Containers::Array<char> _data;
+        #ifndef MAGNUM_TARGET_GLES
+        char* _mapped;
+        Containers::Array<GLsync> _fences;
+        #endif
+};
+
+}}
+
+#endif
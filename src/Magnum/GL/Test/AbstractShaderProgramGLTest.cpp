@@ -28,6 +28,7 @@
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Resource.h>
+#include <Corrade/Utility/System.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
@@ -64,7 +65,9 @@ struct AbstractShaderProgramGLTest: OpenGLTester {
     void createMultipleOutputsIndexed();
     #endif
 
+    void createAsync();
     void linkFailure();
+    void linkFailureAsync();
     void uniformNotFound();
 
     void uniform();
@@ -103,7 +106,9 @@ AbstractShaderProgramGLTest::AbstractShaderProgramGLTest() {
               &AbstractShaderProgramGLTest::createMultipleOutputsIndexed,
               #endif
 
+              &AbstractShaderProgramGLTest::createAsync,
               &AbstractShaderProgramGLTest::linkFailure,
+              &AbstractShaderProgramGLTest::linkFailureAsync,
               &AbstractShaderProgramGLTest::uniformNotFound,
 
               &AbstractShaderProgramGLTest::uniform,
@@ -195,6 +200,8 @@ struct MyPublicShader: AbstractShaderProgram {
     using AbstractShaderProgram::bindFragmentDataLocation;
     #endif
     using AbstractShaderProgram::link;
+    using AbstractShaderProgram::submitLink;
+    using AbstractShaderProgram::checkLink;
     using AbstractShaderProgram::uniformLocation;
     #ifndef MAGNUM_TARGET_GLES2
     using AbstractShaderProgram::uniformBlockIndex;
@@ -378,6 +385,59 @@ void AbstractShaderProgramGLTest::createMultipleOutputsIndexed() {
 }
 #endif
 
+void AbstractShaderProgramGLTest::createAsync() {
+    Utility::Resource rs("AbstractShaderProgramGLTest");
+
+    Shader vert(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Vertex);
+    vert.addSource(rs.get("MyShader.vert"));
+
+    Shader frag(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Fragment);
+    frag.addSource(rs.get("MyShader.frag"));
+
+    vert.submitCompile();
+    frag.submitCompile();
+
+    MyPublicShader program;
+    program.attachShaders({vert, frag});
+    program.bindAttributeLocation(0, "position");
+    program.submitLink();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Without KHR_parallel_shader_compile this returns true immediately */
+    while(!program.isLinkFinished())
+        Utility::System::sleep(100);
+
+    CORRADE_VERIFY(vert.checkCompile());
+    CORRADE_VERIFY(frag.checkCompile());
+    CORRADE_VERIFY(program.checkLink());
+    CORRADE_VERIFY(program.isLinkFinished());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(program.uniformLocation("matrix") >= 0);
+    CORRADE_VERIFY(program.uniformLocation("multiplier") >= 0);
+}
+
 void AbstractShaderProgramGLTest::linkFailure() {
     Shader shader(
         #ifndef MAGNUM_TARGET_GLES
@@ -402,6 +462,35 @@ void AbstractShaderProgramGLTest::linkFailure() {
     CORRADE_VERIFY(!program.link());
 }
 
+void AbstractShaderProgramGLTest::linkFailureAsync() {
+    Shader shader(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Fragment);
+    shader.addSource("[fu] bleh error #:! stuff\n");
+    shader.submitCompile();
+
+    MyPublicShader program;
+    program.attachShaders({shader});
+    program.submitLink();
+
+    while(!program.isLinkFinished())
+        Utility::System::sleep(100);
+
+    {
+        Error redirectError{nullptr};
+        CORRADE_VERIFY(!shader.checkCompile());
+        CORRADE_VERIFY(!program.checkLink());
+    }
+}
+
 void AbstractShaderProgramGLTest::uniformNotFound() {
     MyPublicShader program;
 
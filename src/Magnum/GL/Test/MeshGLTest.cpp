@@ -45,6 +45,10 @@
 #include "Magnum/Math/Matrix.h"
 #include "Magnum/Math/Vector4.h"
 
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/GL/DrawIndirectCommand.h"
+#endif
+
 namespace Magnum { namespace GL { namespace Test { namespace {
 
 /* Tests also the MeshView class. */
@@ -162,6 +166,9 @@ struct MeshGLTest: OpenGLTester {
     void multiDrawIndexed();
     #ifndef MAGNUM_TARGET_GLES
     void multiDrawBaseVertex();
+
+    void multiDrawIndirect();
+    void multiDrawIndirectIndexed();
     #endif
 };
 
@@ -283,7 +290,10 @@ MeshGLTest::MeshGLTest() {
               &MeshGLTest::multiDraw,
               &MeshGLTest::multiDrawIndexed,
               #ifndef MAGNUM_TARGET_GLES
-              &MeshGLTest::multiDrawBaseVertex
+              &MeshGLTest::multiDrawBaseVertex,
+
+              &MeshGLTest::multiDrawIndirect,
+              &MeshGLTest::multiDrawIndirectIndexed
               #endif
               });
 }
@@ -2958,25 +2968,21 @@ void MeshGLTest::resetDivisorAfterInstancedDraw() {
 
 struct MultiChecker {
     MultiChecker(AbstractShaderProgram&& shader, Mesh& mesh);
+    #ifndef MAGNUM_TARGET_GLES
+    MultiChecker(AbstractShaderProgram&& shader, Mesh& mesh, Buffer& commands);
+    #endif
 
     template<class T> T get(PixelFormat format, PixelType type);
 
+    void setup();
+
     Renderbuffer renderbuffer;
     Framebuffer framebuffer;
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 MultiChecker::MultiChecker(AbstractShaderProgram&& shader, Mesh& mesh): framebuffer({{}, Vector2i(1)}) {
-    renderbuffer.setStorage(
-        #ifndef MAGNUM_TARGET_GLES2
-        RenderbufferFormat::RGBA8,
-        #else
-        RenderbufferFormat::RGBA4,
-        #endif
-        Vector2i(1));
-    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), renderbuffer);
-
-    framebuffer.bind();
+    setup();
     mesh.setPrimitive(MeshPrimitive::Points)
         .setCount(2);
 
@@ -2999,6 +3005,33 @@ MultiChecker::MultiChecker(AbstractShaderProgram&& shader, Mesh& mesh): framebuf
     shader.draw({a, b, c});
 }
 
+#ifndef MAGNUM_TARGET_GLES
+MultiChecker::MultiChecker(AbstractShaderProgram&& shader, Mesh& mesh, Buffer& commands): framebuffer({{}, Vector2i(1)}) {
+    setup();
+    mesh.setPrimitive(MeshPrimitive::Points);
+
+    /* The commands are expected to be the same as the views above -- a
+       zero-count one, then the first and the second vertex. Skip the first
+       command to test also offsets. */
+    shader.drawIndirect(mesh, commands, mesh.isIndexed() ?
+        sizeof(DrawElementsIndirectCommand) :
+        sizeof(DrawArraysIndirectCommand), 3);
+}
+#endif
+
+void MultiChecker::setup() {
+    renderbuffer.setStorage(
+        #ifndef MAGNUM_TARGET_GLES2
+        RenderbufferFormat::RGBA8,
+        #else
+        RenderbufferFormat::RGBA4,
+        #endif
+        Vector2i(1));
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), renderbuffer);
+
+    framebuffer.bind();
+}
+
 template<class T> T MultiChecker::get(PixelFormat format, PixelType type) {
     return Containers::arrayCast<T>(framebuffer.read({{}, Vector2i{1}}, {format, type}).data())[0];
 }
@@ -3092,6 +3125,72 @@ void MeshGLTest::multiDrawBaseVertex() {
     MAGNUM_VERIFY_NO_GL_ERROR();
     CORRADE_COMPARE(value, indexedResult);
 }
+
+void MeshGLTest::multiDrawIndirect() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::ARB::multi_draw_indirect::string() + std::string(" is not available."));
+
+    typedef Attribute<0, Float> Attribute;
+
+    const Float data[] = { 0.0f, -0.7f, Math::unpack<Float, UnsignedByte>(96) };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.addVertexBuffer(buffer, 4, Attribute());
+
+    /* First command is skipped via an offset, the second has zero count */
+    const DrawArraysIndirectCommand commandData[]{
+        {1, 1, 0, 0},
+        {0, 1, 0, 0},
+        {1, 1, 0, 0},
+        {1, 1, 1, 0}
+    };
+    Buffer commands{Buffer::TargetHint::DrawIndirect, commandData};
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    const auto value = MultiChecker(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"),
+        mesh, commands).get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(value, 96);
+}
+
+void MeshGLTest::multiDrawIndirectIndexed() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::ARB::multi_draw_indirect::string() + std::string(" is not available."));
+
+    Buffer vertices;
+    vertices.setData(indexedVertexDataBaseVertex, BufferUsage::StaticDraw);
+
+    constexpr UnsignedShort indexData[] = { 2, 1, 0 };
+    Buffer indices{Buffer::TargetHint::ElementArray};
+    indices.setData(indexData, BufferUsage::StaticDraw);
+
+    /* The index buffer offset set on the mesh is ignored, the first index is
+       always counted from the start of the buffer */
+    Mesh mesh;
+    mesh.addVertexBuffer(vertices, 2*4,  MultipleShader::Position(),
+                         MultipleShader::Normal(), MultipleShader::TextureCoordinates())
+        .setIndexBuffer(indices, 0, MeshIndexType::UnsignedShort);
+
+    /* First command is skipped via an offset, the second has zero count */
+    const DrawElementsIndirectCommand commandData[]{
+        {1, 1, 0, 0, 0},
+        {0, 1, 1, 2, 0},
+        {1, 1, 1, 2, 0},
+        {1, 1, 2, 2, 0}
+    };
+    Buffer commands{Buffer::TargetHint::DrawIndirect, commandData};
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    const auto value = MultiChecker(MultipleShader{}, mesh, commands).get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(value, indexedResult);
+}
 #endif
 
 }}}}
@@ -0,0 +1,230 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/ProgramBinaryCache.h"
+#include "Magnum/GL/Shader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct ProgramBinaryCacheGLTest: OpenGLTester {
+    explicit ProgramBinaryCacheGLTest();
+
+    void construct();
+    void constructNested();
+
+    void key();
+    void keyDifferent();
+
+    void noCache();
+    void missThenHit();
+    void corrupted();
+};
+
+ProgramBinaryCacheGLTest::ProgramBinaryCacheGLTest() {
+    addTests({&ProgramBinaryCacheGLTest::construct,
+              &ProgramBinaryCacheGLTest::constructNested,
+
+              &ProgramBinaryCacheGLTest::key,
+              &ProgramBinaryCacheGLTest::keyDifferent,
+
+              &ProgramBinaryCacheGLTest::noCache,
+              &ProgramBinaryCacheGLTest::missThenHit,
+              &ProgramBinaryCacheGLTest::corrupted});
+}
+
+struct Sources {
+    explicit Sources(const char* color = "vec4(1.0)");
+
+    Shader vert, frag;
+};
+
+Sources::Sources(const char* color):
+    #ifndef MAGNUM_TARGET_GLES
+    vert{Version::GL300, Shader::Type::Vertex},
+    frag{Version::GL300, Shader::Type::Fragment}
+    #else
+    vert{Version::GLES300, Shader::Type::Vertex},
+    frag{Version::GLES300, Shader::Type::Fragment}
+    #endif
+{
+    vert.addSource(
+        "in highp vec4 position;\n"
+        "void main() {\n"
+        "    gl_Position = position;\n"
+        "}\n");
+    frag.addSource(
+        "out lowp vec4 color;\n"
+        "void main() {\n"
+        "    color = ").addSource(color).addSource(";\n"
+        "}\n");
+}
+
+struct CachedShader: AbstractShaderProgram {
+    explicit CachedShader(Sources& sources);
+
+    bool loaded;
+};
+
+CachedShader::CachedShader(Sources& sources) {
+    loaded = loadBinary({sources.vert, sources.frag});
+    if(!loaded) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({sources.vert, sources.frag}));
+        attachShaders({sources.vert, sources.frag});
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    }
+}
+
+bool isLinked(AbstractShaderProgram& shader) {
+    GLint success;
+    glGetProgramiv(shader.id(), GL_LINK_STATUS, &success);
+    return success;
+}
+
+void ProgramBinaryCacheGLTest::construct() {
+    CORRADE_VERIFY(!ProgramBinaryCache::current());
+
+    {
+        ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(ProgramBinaryCache::current(), &cache);
+        CORRADE_COMPARE(cache.path(), PROGRAMBINARYCACHEGLTEST_SAVE_DIR);
+        CORRADE_COMPARE(cache.hitCount(), 0);
+        CORRADE_COMPARE(cache.missCount(), 0);
+    }
+
+    CORRADE_VERIFY(!ProgramBinaryCache::current());
+}
+
+void ProgramBinaryCacheGLTest::constructNested() {
+    ProgramBinaryCache a{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+    CORRADE_COMPARE(ProgramBinaryCache::current(), &a);
+
+    {
+        ProgramBinaryCache b{Utility::Directory::join(PROGRAMBINARYCACHEGLTEST_SAVE_DIR, "nested")};
+        CORRADE_COMPARE(ProgramBinaryCache::current(), &b);
+    }
+
+    CORRADE_COMPARE(ProgramBinaryCache::current(), &a);
+}
+
+void ProgramBinaryCacheGLTest::key() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+
+    Sources a, b;
+    const std::string key = cache.key({a.vert, a.frag});
+    CORRADE_COMPARE(key.size(), 40);
+    CORRADE_COMPARE(cache.key({b.vert, b.frag}), key);
+}
+
+void ProgramBinaryCacheGLTest::keyDifferent() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+
+    Sources a, b{"vec4(0.5)"};
+    const std::string key = cache.key({a.vert, a.frag});
+
+    /* Different sources */
+    CORRADE_VERIFY(cache.key({b.vert, b.frag}) != key);
+
+    /* Same sources, different order of shaders */
+    CORRADE_VERIFY(cache.key({a.frag, a.vert}) != key);
+}
+
+void ProgramBinaryCacheGLTest::noCache() {
+    CORRADE_VERIFY(!ProgramBinaryCache::current());
+
+    Sources sources;
+    CachedShader shader{sources};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!shader.loaded);
+    CORRADE_VERIFY(isLinked(shader));
+}
+
+void ProgramBinaryCacheGLTest::missThenHit() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+    if(!cache.isSupported())
+        CORRADE_SKIP("The driver doesn't support any program binary formats.");
+
+    /* Remove a file possibly left over from a previous run */
+    const std::string filename = [&]() {
+        Sources sources;
+        return Utility::Directory::join(cache.path(), cache.key({sources.vert, sources.frag}));
+    }();
+    if(Utility::Directory::exists(filename))
+        CORRADE_VERIFY(Utility::Directory::rm(filename));
+
+    {
+        Sources sources;
+        CachedShader shader{sources};
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_VERIFY(!shader.loaded);
+        CORRADE_VERIFY(isLinked(shader));
+        CORRADE_COMPARE(cache.hitCount(), 0);
+        CORRADE_COMPARE(cache.missCount(), 1);
+        CORRADE_VERIFY(Utility::Directory::exists(filename));
+    } {
+        Sources sources;
+        CachedShader shader{sources};
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_VERIFY(shader.loaded);
+        CORRADE_VERIFY(isLinked(shader));
+        CORRADE_COMPARE(cache.hitCount(), 1);
+        CORRADE_COMPARE(cache.missCount(), 1);
+    }
+}
+
+void ProgramBinaryCacheGLTest::corrupted() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+    if(!cache.isSupported())
+        CORRADE_SKIP("The driver doesn't support any program binary formats.");
+
+    Sources sources{"vec4(0.25)"};
+    const std::string filename = Utility::Directory::join(cache.path(), cache.key({sources.vert, sources.frag}));
+    CORRADE_VERIFY(Utility::Directory::writeString(filename, "this is not a program binary"));
+
+    /* The entry gets rejected, the program linked from source and the file
+       replaced */
+    CachedShader shader{sources};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!shader.loaded);
+    CORRADE_VERIFY(isLinked(shader));
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 1);
+    CORRADE_VERIFY(Utility::Directory::readString(filename) != "this is not a program binary");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::ProgramBinaryCacheGLTest)
@@ -0,0 +1,75 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <type_traits>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/RenderState.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct RenderStateTest: TestSuite::Tester {
+    explicit RenderStateTest();
+
+    void constructCopy();
+    void setFeatureNotTracked();
+};
+
+RenderStateTest::RenderStateTest() {
+    addTests({&RenderStateTest::constructCopy,
+              &RenderStateTest::setFeatureNotTracked});
+}
+
+void RenderStateTest::constructCopy() {
+    /* The block is meant to be a plain value type usable without a GL
+       context */
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<RenderState>::value);
+    CORRADE_VERIFY(std::is_nothrow_copy_constructible<RenderState>::value);
+    CORRADE_VERIFY(std::is_nothrow_copy_assignable<RenderState>::value);
+
+    RenderState a;
+    a.enable(Renderer::Feature::Blending)
+     .setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::OneMinusSourceAlpha)
+     .setDepthMask(false);
+    RenderState b = a;
+    CORRADE_VERIFY(&b.setScissor({{}, {16, 16}}) == &b);
+}
+
+void RenderStateTest::setFeatureNotTracked() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    RenderState{}.enable(Renderer::Feature(0xdead));
+    CORRADE_COMPARE(out.str(), "GL::RenderState::setFeature(): feature 0xdead can't be used in a render state block\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::RenderStateTest)
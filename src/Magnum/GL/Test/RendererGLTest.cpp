@@ -38,6 +38,7 @@
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/GL/PixelFormat.h"
 #include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/RenderState.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
 #include "Magnum/GL/Shader.h"
@@ -63,6 +64,14 @@ struct RendererGLTest: OpenGLTester {
     void drawBuffersBlend();
     #endif
 
+    void elideStateChanges();
+    void elideStateChangesStencilFacing();
+    void elideStateChangesReset();
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    void elideStateChangesIndexed();
+    #endif
+    void renderState();
+
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
         std::string _testDir;
@@ -81,9 +90,15 @@ RendererGLTest::RendererGLTest() {
               #endif
               #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
               &RendererGLTest::drawBuffersIndexed,
-              &RendererGLTest::drawBuffersBlend
+              &RendererGLTest::drawBuffersBlend,
               #endif
-              });
+              &RendererGLTest::elideStateChanges,
+              &RendererGLTest::elideStateChangesStencilFacing,
+              &RendererGLTest::elideStateChangesReset,
+              #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+              &RendererGLTest::elideStateChangesIndexed,
+              #endif
+              &RendererGLTest::renderState});
 
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
@@ -293,6 +308,172 @@ void RendererGLTest::drawBuffersBlend() {
 }
 #endif
 
+void RendererGLTest::elideStateChanges() {
+    /* Start from an unknown state */
+    Context::current().resetState(Context::State::Renderer);
+    Renderer::resetElidedStateChangeCount();
+
+    /* First calls always go through */
+    Renderer::enable(Renderer::Feature::DepthTest);
+    Renderer::setDepthFunction(Renderer::DepthFunction::LessOrEqual);
+    Renderer::setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::OneMinusSourceAlpha);
+    Renderer::setClearColor(0x336699_rgbf);
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 0);
+
+    /* Setting the same values again is elided. The separate blend function
+       variant with equal RGB and alpha is the same state. */
+    Renderer::enable(Renderer::Feature::DepthTest);
+    Renderer::setDepthFunction(Renderer::DepthFunction::LessOrEqual);
+    Renderer::setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::OneMinusSourceAlpha, Renderer::BlendFunction::One, Renderer::BlendFunction::OneMinusSourceAlpha);
+    Renderer::setClearColor(0x336699_rgbf);
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 4);
+
+    /* Different values go through */
+    Renderer::disable(Renderer::Feature::DepthTest);
+    Renderer::setDepthFunction(Renderer::DepthFunction::Less);
+    Renderer::setClearColor(0x336699ff_rgbaf*0.5f);
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 4);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Verify that the GL state actually matches */
+    CORRADE_VERIFY(!glIsEnabled(GL_DEPTH_TEST));
+    GLint depthFunction;
+    glGetIntegerv(GL_DEPTH_FUNC, &depthFunction);
+    CORRADE_COMPARE(depthFunction, GL_LESS);
+
+    Renderer::resetElidedStateChangeCount();
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 0);
+}
+
+void RendererGLTest::elideStateChangesStencilFacing() {
+    Context::current().resetState(Context::State::Renderer);
+    Renderer::resetElidedStateChangeCount();
+
+    /* Setting both faces makes both known */
+    Renderer::setStencilMask(0xff);
+    Renderer::setStencilMask(Renderer::PolygonFacing::Front, 0xff);
+    Renderer::setStencilMask(Renderer::PolygonFacing::Back, 0xff);
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 2);
+
+    /* Changing just one face means the combined value is different */
+    Renderer::setStencilMask(Renderer::PolygonFacing::Back, 0x0f);
+    Renderer::setStencilMask(0x0f);
+    Renderer::setStencilMask(Renderer::PolygonFacing::FrontAndBack, 0x0f);
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 3);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    GLint front, back;
+    glGetIntegerv(GL_STENCIL_WRITEMASK, &front);
+    glGetIntegerv(GL_STENCIL_BACK_WRITEMASK, &back);
+    CORRADE_COMPARE(front, 0x0f);
+    CORRADE_COMPARE(back, 0x0f);
+}
+
+void RendererGLTest::elideStateChangesReset() {
+    Context::current().resetState(Context::State::Renderer);
+    Renderer::resetElidedStateChangeCount();
+
+    Renderer::enable(Renderer::Feature::FaceCulling);
+
+    /* Simulate external code changing the state behind our back */
+    glDisable(GL_CULL_FACE);
+
+    /* Without a reset the call would be elided, leaving culling disabled */
+    Context::current().resetState(Context::State::Renderer);
+    Renderer::enable(Renderer::Feature::FaceCulling);
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_CULL_FACE));
+
+    Renderer::disable(Renderer::Feature::FaceCulling);
+}
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+void RendererGLTest::elideStateChangesIndexed() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::draw_buffers_blend>())
+        CORRADE_SKIP(Extensions::ARB::draw_buffers_blend::string() + std::string(" is not available."));
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::EXT::draw_buffers_indexed>())
+        CORRADE_SKIP(Extensions::EXT::draw_buffers_indexed::string() + std::string(" is not available."));
+    #endif
+
+    Context::current().resetState(Context::State::Renderer);
+    Renderer::resetElidedStateChangeCount();
+
+    Renderer::enable(Renderer::Feature::Blending);
+    Renderer::setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::Zero);
+
+    /* Per-buffer state invalidates the global shadow, so the next global
+       call has to go through to override it */
+    Renderer::disable(Renderer::Feature::Blending, 0);
+    Renderer::setBlendFunction(0, Renderer::BlendFunction::Zero, Renderer::BlendFunction::One);
+    Renderer::enable(Renderer::Feature::Blending);
+    Renderer::setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::Zero);
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(glIsEnabled(GL_BLEND));
+    GLint source;
+    glGetIntegerv(GL_BLEND_SRC_RGB, &source);
+    CORRADE_COMPARE(source, GL_ONE);
+
+    Renderer::disable(Renderer::Feature::Blending);
+}
+#endif
+
+void RendererGLTest::renderState() {
+    Context::current().resetState(Context::State::Renderer);
+    Renderer::resetElidedStateChangeCount();
+
+    RenderState transparent;
+    transparent
+        .enable(Renderer::Feature::Blending)
+        .enable(Renderer::Feature::DepthTest)
+        .setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::OneMinusSourceAlpha)
+        .setDepthMask(false);
+
+    RenderState opaque;
+    opaque
+        .disable(Renderer::Feature::Blending)
+        .enable(Renderer::Feature::DepthTest)
+        .setDepthMask(true);
+
+    /* Nothing known yet, so everything goes through */
+    transparent.apply();
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 0);
+
+    /* Applying the same block again is a no-op */
+    transparent.apply();
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 4);
+
+    /* Only the difference is applied, depth test stays enabled */
+    opaque.apply();
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 5);
+
+    /* An empty block does nothing at all */
+    RenderState{}.apply();
+    CORRADE_COMPARE(Renderer::elidedStateChangeCount(), 5);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(!glIsEnabled(GL_BLEND));
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+    GLboolean depthMask;
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+    CORRADE_VERIFY(depthMask);
+    /* The blend function from the first block is still set */
+    GLint destination;
+    glGetIntegerv(GL_BLEND_DST_RGB, &destination);
+    CORRADE_COMPARE(destination, GL_ONE_MINUS_SRC_ALPHA);
+
+    Renderer::disable(Renderer::Feature::DepthTest);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::GL::Test::RendererGLTest)
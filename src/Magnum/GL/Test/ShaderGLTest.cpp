@@ -25,6 +25,7 @@
 
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/System.h>
 
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
@@ -52,6 +53,8 @@ struct ShaderGLTest: OpenGLTester {
     void compile();
     void compileUtf8();
     void compileNoVersion();
+    void compileAsync();
+    void compileAsyncFailure();
 };
 
 ShaderGLTest::ShaderGLTest() {
@@ -68,7 +71,9 @@ ShaderGLTest::ShaderGLTest() {
               &ShaderGLTest::addFile,
               &ShaderGLTest::compile,
               &ShaderGLTest::compileUtf8,
-              &ShaderGLTest::compileNoVersion});
+              &ShaderGLTest::compileNoVersion,
+              &ShaderGLTest::compileAsync,
+              &ShaderGLTest::compileAsyncFailure});
 }
 
 void ShaderGLTest::construct() {
@@ -302,6 +307,60 @@ void ShaderGLTest::compileNoVersion() {
     CORRADE_VERIFY(shader.compile());
 }
 
+void ShaderGLTest::compileAsync() {
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Version v =
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        ;
+    #else
+    constexpr Version v = Version::GLES200;
+    #endif
+
+    Shader shader(v, Shader::Type::Fragment);
+    shader.addSource("void main() {}\n");
+    shader.submitCompile();
+
+    /* Without KHR_parallel_shader_compile this returns true immediately */
+    while(!shader.isCompileFinished())
+        Utility::System::sleep(100);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(shader.checkCompile());
+    CORRADE_VERIFY(shader.isCompileFinished());
+}
+
+void ShaderGLTest::compileAsyncFailure() {
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Version v =
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        ;
+    #else
+    constexpr Version v = Version::GLES200;
+    #endif
+
+    Shader shader(v, Shader::Type::Fragment);
+    shader.addSource("[fu] bleh error #:! stuff\n");
+    shader.submitCompile();
+
+    while(!shader.isCompileFinished())
+        Utility::System::sleep(100);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    {
+        Error redirectError{nullptr};
+        CORRADE_VERIFY(!shader.checkCompile());
+    }
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::GL::Test::ShaderGLTest)
@@ -0,0 +1,267 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/StreamingBuffer.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct StreamingBufferGLTest: OpenGLTester {
+    explicit StreamingBufferGLTest();
+
+    void construct();
+    void constructInvalid();
+    void constructMove();
+
+    void allocate();
+    void allocateInvalidAlignment();
+    void allocateTooLarge();
+    void flush();
+    void finishFrame();
+    void finishFrameEmpty();
+};
+
+StreamingBufferGLTest::StreamingBufferGLTest() {
+    addTests({&StreamingBufferGLTest::construct,
+              &StreamingBufferGLTest::constructInvalid,
+              &StreamingBufferGLTest::constructMove,
+
+              &StreamingBufferGLTest::allocate,
+              &StreamingBufferGLTest::allocateInvalidAlignment,
+              &StreamingBufferGLTest::allocateTooLarge,
+              &StreamingBufferGLTest::flush,
+              &StreamingBufferGLTest::finishFrame,
+              &StreamingBufferGLTest::finishFrameEmpty});
+}
+
+void StreamingBufferGLTest::construct() {
+    {
+        StreamingBuffer buffer{1024, 2, Buffer::TargetHint::ElementArray};
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_VERIFY(buffer.buffer().id() > 0);
+        CORRADE_COMPARE(buffer.buffer().targetHint(), Buffer::TargetHint::ElementArray);
+        CORRADE_COMPARE(buffer.size(), 1024);
+        CORRADE_COMPARE(buffer.regionCount(), 2);
+        CORRADE_COMPARE(buffer.usedSize(), 0);
+
+        #ifndef MAGNUM_TARGET_GLES
+        const bool persistent = Context::current().isExtensionSupported<Extensions::ARB::buffer_storage>();
+        CORRADE_COMPARE(buffer.isPersistent(), persistent);
+        CORRADE_COMPARE(buffer.buffer().size(), persistent ? 2048 : 1024);
+        #else
+        CORRADE_VERIFY(!buffer.isPersistent());
+        #endif
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void StreamingBufferGLTest::constructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    StreamingBuffer{0, 3};
+    StreamingBuffer{1024, 0};
+    CORRADE_COMPARE(out.str(),
+        "GL::StreamingBuffer: expected non-zero size and region count but got 0 and 3\n"
+        "GL::StreamingBuffer: expected non-zero size and region count but got 1024 and 0\n");
+}
+
+void StreamingBufferGLTest::constructMove() {
+    StreamingBuffer a{1024};
+    const Int id = a.buffer().id();
+    const bool persistent = a.isPersistent();
+    a.allocate(16);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(id > 0);
+
+    StreamingBuffer b{std::move(a)};
+
+    CORRADE_COMPARE(a.buffer().id(), 0);
+    CORRADE_COMPARE(b.buffer().id(), id);
+    CORRADE_COMPARE(b.size(), 1024);
+    CORRADE_COMPARE(b.regionCount(), 3);
+    CORRADE_COMPARE(b.usedSize(), 16);
+    CORRADE_COMPARE(b.isPersistent(), persistent);
+
+    StreamingBuffer c{512, 2};
+    const Int cId = c.buffer().id();
+    c = std::move(b);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(cId > 0);
+    CORRADE_COMPARE(b.buffer().id(), cId);
+    CORRADE_COMPARE(b.size(), 512);
+    CORRADE_COMPARE(c.buffer().id(), id);
+    CORRADE_COMPARE(c.size(), 1024);
+    CORRADE_COMPARE(c.usedSize(), 16);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<StreamingBuffer>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<StreamingBuffer>::value);
+}
+
+void StreamingBufferGLTest::allocate() {
+    StreamingBuffer buffer{1024};
+
+    std::pair<GLintptr, Containers::ArrayView<char>> a = buffer.allocate(6);
+    std::pair<GLintptr, Containers::ArrayView<char>> b = buffer.allocate(12);
+    std::pair<GLintptr, Containers::ArrayView<char>> c = buffer.allocate(3, 1);
+    std::pair<GLintptr, Containers::ArrayView<char>> d = buffer.allocate(64, 256);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(a.first, 0);
+    CORRADE_COMPARE(a.second.size(), 6);
+    CORRADE_COMPARE(b.first, 8);
+    CORRADE_COMPARE(b.second.size(), 12);
+    CORRADE_COMPARE(b.second.data(), a.second.data() + 8);
+    CORRADE_COMPARE(c.first, 20);
+    CORRADE_COMPARE(c.second.size(), 3);
+    CORRADE_COMPARE(d.first, 256);
+    CORRADE_COMPARE(d.second.size(), 64);
+    CORRADE_COMPARE(buffer.usedSize(), 320);
+
+    /* The whole remaining space can be allocated */
+    std::pair<GLintptr, Containers::ArrayView<char>> e = buffer.allocate(704);
+    CORRADE_COMPARE(e.first, 320);
+    CORRADE_COMPARE(buffer.usedSize(), 1024);
+}
+
+void StreamingBufferGLTest::allocateInvalidAlignment() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    StreamingBuffer buffer{1024};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.allocate(16, 0);
+    buffer.allocate(16, 12);
+    CORRADE_COMPARE(out.str(),
+        "GL::StreamingBuffer::allocate(): expected alignment to be a power of two but got 0\n"
+        "GL::StreamingBuffer::allocate(): expected alignment to be a power of two but got 12\n");
+}
+
+void StreamingBufferGLTest::allocateTooLarge() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    StreamingBuffer buffer{1024};
+    buffer.allocate(1000);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.allocate(24, 16);
+    buffer.allocate(1025, 1);
+    CORRADE_COMPARE(out.str(),
+        "GL::StreamingBuffer::allocate(): can't fit 24 bytes with alignment 16 into 24 bytes remaining for the frame\n"
+        "GL::StreamingBuffer::allocate(): can't fit 1025 bytes with alignment 1 into 24 bytes remaining for the frame\n");
+}
+
+void StreamingBufferGLTest::flush() {
+    StreamingBuffer buffer{64};
+
+    std::pair<GLintptr, Containers::ArrayView<char>> a = buffer.allocate(4*4);
+    Containers::ArrayView<Int> aData = Containers::arrayCast<Int>(a.second);
+    aData[0] = 2;
+    aData[1] = 7;
+    aData[2] = 5;
+    aData[3] = 13;
+    buffer.flush();
+
+    /* Second flush in a frame uploads only the new data */
+    std::pair<GLintptr, Containers::ArrayView<char>> b = buffer.allocate(2*4);
+    Containers::ArrayView<Int> bData = Containers::arrayCast<Int>(b.second);
+    bData[0] = 25;
+    bData[1] = 36;
+    buffer.flush();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /** @todo How to verify the contents in ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Int expected[]{2, 7, 5, 13, 25, 36};
+    CORRADE_COMPARE_AS(Containers::arrayCast<Int>(buffer.buffer().subData(a.first, 6*4)),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void StreamingBufferGLTest::finishFrame() {
+    StreamingBuffer buffer{64, 3};
+    const std::size_t regionSize = buffer.isPersistent() ? 64 : 0;
+
+    for(Int frame: {0, 1, 2, 3, 4}) {
+        CORRADE_ITERATION(frame);
+
+        std::pair<GLintptr, Containers::ArrayView<char>> a = buffer.allocate(4);
+        Containers::arrayCast<Int>(a.second)[0] = frame;
+
+        /* Persistent buffers cycle through the regions, orphaned ones reuse
+           the same range every frame */
+        CORRADE_COMPARE(a.first, GLintptr(std::size_t(frame % 3)*regionSize));
+
+        buffer.finishFrame();
+        CORRADE_COMPARE(buffer.usedSize(), 0);
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        /** @todo How to verify the contents in ES? */
+        #ifndef MAGNUM_TARGET_GLES
+        CORRADE_COMPARE(Containers::arrayCast<Int>(buffer.buffer().subData(a.first, 4))[0], frame);
+        #endif
+    }
+}
+
+void StreamingBufferGLTest::finishFrameEmpty() {
+    StreamingBuffer buffer{64, 3};
+    const std::size_t regionSize = buffer.isPersistent() ? 64 : 0;
+
+    buffer.allocate(4);
+    buffer.finishFrame();
+
+    /* A frame with nothing allocated doesn't advance to the next region */
+    buffer.finishFrame();
+    CORRADE_COMPARE(buffer.allocate(4).first, GLintptr(regionSize));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::StreamingBufferGLTest)
@@ -27,3 +27,4 @@
 #cmakedefine TGAIMPORTER_PLUGIN_FILENAME "${TGAIMPORTER_PLUGIN_FILENAME}"
 #define SHADERGLTEST_FILES_DIR "${SHADERGLTEST_FILES_DIR}"
 #define RENDERERGLTEST_FILES_DIR "${RENDERERGLTEST_FILES_DIR}"
+#define PROGRAMBINARYCACHEGLTEST_SAVE_DIR "${PROGRAMBINARYCACHEGLTEST_SAVE_DIR}"
@@ -25,11 +25,13 @@
 
 #include "PackingBatch.h"
 
+#include <cstring>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Math/Implementation/halfTables.hpp"
+#include "Magnum/Math/Implementation/srgbTables.hpp"
 
 namespace Magnum { namespace Math {
 
@@ -328,4 +330,137 @@ void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& sr
     }
 }
 
+namespace {
+
+/* Bit casts, compiled to plain register moves */
+inline UnsignedInt floatBits(const Float value) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &value, sizeof(Float));
+    return bits;
+}
+
+inline Float floatFromBits(const UnsignedInt bits) {
+    Float value;
+    std::memcpy(&value, &bits, sizeof(Float));
+    return value;
+}
+
+/* A ternary operator with arithmetic in the branches isn't turned into a
+   conditional move under the default -ftrapping-math, which then prevents
+   the whole loop from being vectorized. Selecting the bits explicitly
+   doesn't have this problem. */
+inline Float select(const bool condition, const Float a, const Float b) {
+    const UnsignedInt mask = 0u - UnsignedInt(condition);
+    return floatFromBits((floatBits(a) & mask)|(floatBits(b) & ~mask));
+}
+
+/* Base-2 logarithm of a positive normal value. The exponent is extracted
+   directly, the mantissa is reduced to [√½, √2) and for s = (m - 1)/(m + 1)
+   the logarithm is approximated with an odd minimax polynomial in s, with
+   absolute error below 3e-8. */
+inline Float log2Approximate(const Float value) {
+    const UnsignedInt bits = floatBits(value);
+    const UnsignedInt mantissa = bits & 0x007fffff;
+    /* 0x3504f3 is the mantissa of √2 */
+    const UnsignedInt aboveSqrt2 = mantissa > 0x003504f3;
+    const Float m = floatFromBits(mantissa|(0x3f800000 - (aboveSqrt2 << 23)));
+    const Int exponent = Int((bits >> 23) & 0xff) - 127 + Int(aboveSqrt2);
+    const Float s = (m - 1.0f)/(m + 1.0f);
+    const Float s2 = s*s;
+    return Float(exponent) + s*(2.88539129f + s2*(0.961470809f + s2*0.59897388f));
+}
+
+/* Base-2 exponential. The integer part goes directly into the exponent, the
+   fractional part in [0, 1) is approximated with a minimax polynomial, with
+   relative error below 2e-9. The exponent is clamped to the normal range,
+   so the result is always finite. */
+inline Float exp2Approximate(const Float value) {
+    /* floor() without a libcall or SSE4.1 */
+    Int integral = Int(value);
+    integral -= Int(Float(integral) > value);
+    const Float f = value - Float(integral);
+    integral = integral < -126 ? -126 : integral;
+    integral = integral > 127 ? 127 : integral;
+    const Float p = 1.0f + f*(0.693147044f + f*(0.240229306f + f*(0.0554852806f + f*(0.00967545166f + f*(0.00124678457f + f*0.000216129172f)))));
+    return p*floatFromBits(UnsignedInt(integral + 127) << 23);
+}
+
+inline Float srgbToLinear(const Float value) {
+    const Float linear = value*(1.0f/12.92f);
+    const Float power = exp2Approximate(2.4f*log2Approximate((value + 0.055f)*(1.0f/1.055f)));
+    return select(value <= 0.04045f, linear, power);
+}
+
+inline Float srgbToLinear(const UnsignedByte value) {
+    return floatFromBits(SrgbToLinearTable[value]);
+}
+
+inline Float linearToSrgb(const Float value) {
+    const Float linear = value*12.92f;
+    const Float power = 1.055f*exp2Approximate((1.0f/2.4f)*log2Approximate(value)) - 0.055f;
+    return select(value <= 0.0031308f, linear, power);
+}
+
+inline UnsignedByte linearToSrgb8(const Float value) {
+    /* Clamping to the [0, 1] range first, NaNs become zero */
+    const Float clamped = select(value > 0.0f, select(value < 1.0f, value, 1.0f), 0.0f);
+    return UnsignedByte(linearToSrgb(clamped)*255.0f + 0.5f);
+}
+
+template<class T, class U, U(*function)(T)> inline void srgbIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst) {
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride()[0];
+    const std::ptrdiff_t dstStride = dst.stride()[0];
+    const std::size_t maxJ = src.size()[1];
+    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
+        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
+        U* dstPtrI = reinterpret_cast<U*>(dstPtr);
+        for(std::size_t j = 0; j != maxJ; ++j)
+            *dstPtrI++ = function(*srcPtrI++);
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+}
+
+void fromSrgbInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::fromSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::fromSrgbInto(): second view dimension is not contiguous", );
+
+    srgbIntoImplementation<UnsignedByte, Float, srgbToLinear>(src, dst);
+}
+
+void fromSrgbInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::fromSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::fromSrgbInto(): second view dimension is not contiguous", );
+
+    srgbIntoImplementation<Float, Float, srgbToLinear>(src, dst);
+}
+
+void toSrgbInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::toSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::toSrgbInto(): second view dimension is not contiguous", );
+
+    srgbIntoImplementation<Float, Float, linearToSrgb>(src, dst);
+}
+
+void toSrgbInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::toSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::toSrgbInto(): second view dimension is not contiguous", );
+
+    srgbIntoImplementation<Float, UnsignedByte, linearToSrgb8>(src, dst);
+}
+
 }}
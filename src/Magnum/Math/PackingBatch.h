@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Functions @ref Magnum::Math::packInto(), @ref Magnum::Math::unpackInto(), @ref Magnum::Math::packHalfInto(), @ref Magnum::Math::unpackHalfInto(), @ref Magnum::Math::castInto()
+ * @brief Functions @ref Magnum::Math::packInto(), @ref Magnum::Math::unpackInto(), @ref Magnum::Math::packHalfInto(), @ref Magnum::Math::unpackHalfInto(), @ref Magnum::Math::fromSrgbInto(), @ref Magnum::Math::toSrgbInto(), @ref Magnum::Math::castInto()
  * @m_since{2020,06}
  */
 
@@ -165,6 +165,82 @@ ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf*
 */
 MAGNUM_EXPORT void unpackHalfInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
 
+/**
+@brief Convert 8-bit sRGB values into linear RGB
+@param[in]  src     Source 8-bit sRGB values
+@param[out] dst     Destination linear floating-point values
+@m_since_latest
+
+Batch equivalent of @ref Color3::fromSrgb(const Vector3<Integral>&), using a
+256-entry lookup table instead of calculating the power for every value. The
+table values are correctly rounded, so the result may differ from the
+single-value API by one ULP. Unlike with @ref Color4::fromSrgbAlpha(), all
+components are converted --- to keep the alpha channel linear, slice it away
+from the views and use @ref unpackInto() for it. Expects that @p src and
+@p dst have the same size and that the second dimension in both is contiguous.
+@see @ref toSrgbInto(),
+    @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_EXPORT void fromSrgbInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
+
+/**
+@brief Convert sRGB values into linear RGB
+@param[in]  src     Source sRGB values
+@param[out] dst     Destination linear values
+@m_since_latest
+
+Batch equivalent of @ref Color3::fromSrgb(). Instead of calling
+@ref std::pow() for every value, the power is calculated via a polynomial
+approximation of @f$ \log_2 @f$ and @f$ 2^x @f$ that the compiler can
+vectorize. For inputs in the @f$ [0, 1] @f$ range the maximum absolute error
+against a double-precision calculation is @f$ 3 \cdot 10^{-7} @f$, comparable
+to a single-precision @ref std::pow(). Results for NaN and infinity are
+undefined. Like with @ref fromSrgbInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>&, const Corrade::Containers::StridedArrayView2D<Float>&),
+all components are converted. Expects that @p src and @p dst have the same
+size and that the second dimension in both is contiguous. The views are
+allowed to alias.
+@see @ref toSrgbInto(),
+    @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_EXPORT void fromSrgbInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
+
+/**
+@brief Convert linear RGB values into sRGB
+@param[in]  src     Source linear values
+@param[out] dst     Destination sRGB values
+@m_since_latest
+
+Batch equivalent of @ref Color3::toSrgb(), using the same polynomial
+approximation as @ref fromSrgbInto(const Corrade::Containers::StridedArrayView2D<const Float>&, const Corrade::Containers::StridedArrayView2D<Float>&).
+For inputs in the @f$ [0, 1] @f$ range the maximum absolute error against a
+double-precision calculation is @f$ 3 \cdot 10^{-7} @f$, values above
+@f$ 1 @f$ are converted with a comparable relative error. Results for NaN and
+infinity are undefined. All components are converted, to keep the alpha
+channel linear, slice it away from the views. Expects that @p src and @p dst
+have the same size and that the second dimension in both is contiguous. The
+views are allowed to alias.
+@see @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_EXPORT void toSrgbInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
+
+/**
+@brief Convert linear RGB values into 8-bit sRGB
+@param[in]  src     Source linear values
+@param[out] dst     Destination 8-bit sRGB values
+@m_since_latest
+
+Batch equivalent of @ref Color3::toSrgb() const with an integral result.
+The values are clamped to the @f$ [0, 1] @f$ range, converted using
+@ref toSrgbInto(const Corrade::Containers::StridedArrayView2D<const Float>&, const Corrade::Containers::StridedArrayView2D<Float>&)
+and rounded to the nearest integer. Only inputs extremely close to a rounding
+boundary can result in a value that differs by one from a correctly rounded
+result. NaNs are converted to zero. Expects that @p src and @p dst have the
+same size and that the second dimension in both is contiguous.
+@see @ref fromSrgbInto(),
+    @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_EXPORT void toSrgbInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst);
+
 /**
 @brief Cast integer values into a floating-point representation
 @param[in]  src     Source integral values
@@ -0,0 +1,170 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/PackingBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct PackingBatchBenchmark: Corrade::TestSuite::Tester {
+    explicit PackingBatchBenchmark();
+
+    void fromSrgbUnsignedByteBaseline();
+    void fromSrgbUnsignedByte();
+    void fromSrgbFloatBaseline();
+    void fromSrgbFloat();
+    void toSrgbFloatBaseline();
+    void toSrgbFloat();
+    void toSrgbUnsignedByteBaseline();
+    void toSrgbUnsignedByte();
+};
+
+PackingBatchBenchmark::PackingBatchBenchmark() {
+    addBenchmarks({&PackingBatchBenchmark::fromSrgbUnsignedByteBaseline,
+                   &PackingBatchBenchmark::fromSrgbUnsignedByte,
+                   &PackingBatchBenchmark::fromSrgbFloatBaseline,
+                   &PackingBatchBenchmark::fromSrgbFloat,
+                   &PackingBatchBenchmark::toSrgbFloatBaseline,
+                   &PackingBatchBenchmark::toSrgbFloat,
+                   &PackingBatchBenchmark::toSrgbUnsignedByteBaseline,
+                   &PackingBatchBenchmark::toSrgbUnsignedByte}, 50);
+}
+
+typedef Math::Vector3<UnsignedByte> Vector3ub;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Color3<Float> Color3;
+
+/* 64k RGB pixels */
+enum: std::size_t { Count = 65536 };
+
+Corrade::Containers::Array<Vector3ub> unsignedByteData() {
+    Corrade::Containers::Array<Vector3ub> out{Corrade::Containers::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i)
+        out[i] = Vector3ub{UnsignedByte(i), UnsignedByte(i >> 8), UnsignedByte(i*7)};
+    return out;
+}
+
+Corrade::Containers::Array<Vector3> floatData() {
+    Corrade::Containers::Array<Vector3> out{Corrade::Containers::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i)
+        out[i] = Vector3{Float(i), Float(Count - i - 1), Float((i*7) % Count)}/Float(Count - 1);
+    return out;
+}
+
+void PackingBatchBenchmark::fromSrgbUnsignedByteBaseline() {
+    Corrade::Containers::Array<Vector3ub> src = unsignedByteData();
+    Corrade::Containers::Array<Color3> dst{Corrade::Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != Count; ++i)
+            dst[i] = Color3::fromSrgb(src[i]);
+
+    CORRADE_COMPARE(dst[Count - 1], Color3::fromSrgb(Vector3ub{0xff, 0xff, 0xf9}));
+}
+
+void PackingBatchBenchmark::fromSrgbUnsignedByte() {
+    Corrade::Containers::Array<Vector3ub> src = unsignedByteData();
+    Corrade::Containers::Array<Color3> dst{Corrade::Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        fromSrgbInto(Corrade::Containers::arrayCast<2, UnsignedByte>(Corrade::Containers::stridedArrayView(src)),
+                     Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(dst)));
+
+    CORRADE_COMPARE(dst[Count - 1], Color3::fromSrgb(Vector3ub{0xff, 0xff, 0xf9}));
+}
+
+void PackingBatchBenchmark::fromSrgbFloatBaseline() {
+    Corrade::Containers::Array<Vector3> src = floatData();
+    Corrade::Containers::Array<Color3> dst{Corrade::Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != Count; ++i)
+            dst[i] = Color3::fromSrgb(src[i]);
+
+    CORRADE_COMPARE(dst[Count - 1], Color3::fromSrgb(src[Count - 1]));
+}
+
+void PackingBatchBenchmark::fromSrgbFloat() {
+    Corrade::Containers::Array<Vector3> src = floatData();
+    Corrade::Containers::Array<Color3> dst{Corrade::Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        fromSrgbInto(Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(src)),
+                     Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(dst)));
+
+    CORRADE_COMPARE(dst[Count - 1], Color3::fromSrgb(src[Count - 1]));
+}
+
+void PackingBatchBenchmark::toSrgbFloatBaseline() {
+    Corrade::Containers::Array<Vector3> src = floatData();
+    Corrade::Containers::Array<Vector3> dst{Corrade::Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != Count; ++i)
+            dst[i] = Color3{src[i]}.toSrgb();
+
+    CORRADE_COMPARE(dst[Count - 1], Color3{src[Count - 1]}.toSrgb());
+}
+
+void PackingBatchBenchmark::toSrgbFloat() {
+    Corrade::Containers::Array<Vector3> src = floatData();
+    Corrade::Containers::Array<Vector3> dst{Corrade::Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        toSrgbInto(Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(src)),
+                   Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(dst)));
+
+    CORRADE_COMPARE(dst[Count - 1], Color3{src[Count - 1]}.toSrgb());
+}
+
+void PackingBatchBenchmark::toSrgbUnsignedByteBaseline() {
+    Corrade::Containers::Array<Vector3> src = floatData();
+    Corrade::Containers::Array<Vector3ub> dst{Corrade::Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != Count; ++i)
+            dst[i] = Color3{src[i]}.toSrgb<UnsignedByte>();
+
+    CORRADE_COMPARE(dst[Count - 1], Color3{src[Count - 1]}.toSrgb<UnsignedByte>());
+}
+
+void PackingBatchBenchmark::toSrgbUnsignedByte() {
+    Corrade::Containers::Array<Vector3> src = floatData();
+    Corrade::Containers::Array<Vector3ub> dst{Corrade::Containers::NoInit, Count};
+
+    CORRADE_BENCHMARK(1)
+        toSrgbInto(Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(src)),
+                   Corrade::Containers::arrayCast<2, UnsignedByte>(Corrade::Containers::stridedArrayView(dst)));
+
+    CORRADE_COMPARE(dst[Count - 1], Color3{src[Count - 1]}.toSrgb<UnsignedByte>());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::PackingBatchBenchmark)
@@ -23,10 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cmath>
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 
@@ -52,6 +55,12 @@ struct PackingBatchTest: Corrade::TestSuite::Tester {
     void unpackHalf();
     void packHalf();
 
+    void fromSrgbUnsignedByte();
+    void fromSrgbFloat();
+    void toSrgbFloat();
+    void toSrgbUnsignedByte();
+    void srgbPrecision();
+
     template<class T> void castUnsignedFloat();
     template<class T> void castSignedFloat();
 
@@ -60,6 +69,7 @@ struct PackingBatchTest: Corrade::TestSuite::Tester {
 
     template<class T> void assertionsPackUnpack();
     void assertionsPackUnpackHalf();
+    void assertionsSrgb();
     template<class U, class T> void assertionsCast();
 };
 
@@ -76,6 +86,12 @@ PackingBatchTest::PackingBatchTest() {
               &PackingBatchTest::unpackHalf,
               &PackingBatchTest::packHalf,
 
+              &PackingBatchTest::fromSrgbUnsignedByte,
+              &PackingBatchTest::fromSrgbFloat,
+              &PackingBatchTest::toSrgbFloat,
+              &PackingBatchTest::toSrgbUnsignedByte,
+              &PackingBatchTest::srgbPrecision,
+
               &PackingBatchTest::castUnsignedFloat<UnsignedByte>,
               &PackingBatchTest::castUnsignedFloat<UnsignedShort>,
               &PackingBatchTest::castUnsignedFloat<UnsignedInt>,
@@ -93,6 +109,7 @@ PackingBatchTest::PackingBatchTest() {
               &PackingBatchTest::assertionsPackUnpack<UnsignedShort>,
               &PackingBatchTest::assertionsPackUnpack<Short>,
               &PackingBatchTest::assertionsPackUnpackHalf,
+              &PackingBatchTest::assertionsSrgb,
               &PackingBatchTest::assertionsCast<Float, UnsignedByte>,
               &PackingBatchTest::assertionsCast<Float, Byte>,
               &PackingBatchTest::assertionsCast<Float, UnsignedShort>,
@@ -113,8 +130,10 @@ typedef Math::Vector2<Short> Vector2s;
 typedef Math::Vector2<Float> Vector2;
 typedef Math::Vector2<UnsignedInt> Vector2ui;
 typedef Math::Vector2<Int> Vector2i;
+typedef Math::Vector3<UnsignedByte> Vector3ub;
 typedef Math::Vector3<Float> Vector3;
 typedef Math::Vector4<Float> Vector4;
+typedef Math::Color3<Float> Color3;
 
 void PackingBatchTest::unpackUnsignedByte() {
     /* Test data adapted from PackingTest */
@@ -414,6 +433,178 @@ void PackingBatchTest::packHalf() {
         CORRADE_COMPARE(Math::packHalf(data[i].src), data[i].dst);
 }
 
+void PackingBatchTest::fromSrgbUnsignedByte() {
+    struct Data {
+        Vector3ub src;
+        Color3 dst;
+    } data[]{
+        {{0, 128, 255}, {}},
+        {{10, 200, 64}, {}}
+    };
+
+    constexpr Color3 expected[] {
+        {0.0f, 0.2158605f, 1.0f},
+        {0.0030353f, 0.5775805f, 0.0512695f}
+    };
+
+    Corrade::Containers::StridedArrayView1D<Vector3ub> src{data, &data[0].src,
+        Corrade::Containers::arraySize(data), sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Color3> dst{data, &data[0].dst,
+        Corrade::Containers::arraySize(data), sizeof(Data)};
+    fromSrgbInto(Corrade::Containers::arrayCast<2, UnsignedByte>(src),
+                 Corrade::Containers::arrayCast<2, Float>(dst));
+    CORRADE_COMPARE_AS(dst, Corrade::Containers::stridedArrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    /* Ensure the results are consistent with non-batch APIs */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i)
+        CORRADE_COMPARE(Color3::fromSrgb(data[i].src), data[i].dst);
+}
+
+void PackingBatchTest::fromSrgbFloat() {
+    struct Data {
+        Vector3 src;
+        Color3 dst;
+    } data[]{
+        {{0.0f, 0.5f, 1.0f}, {}},
+        {{0.2f, 0.04f, 0.9f}, {}},
+        /* Values outside of the range are converted too */
+        {{-0.5f, 1.5f, 0.75f}, {}}
+    };
+
+    constexpr Color3 expected[] {
+        {0.0f, 0.2140412f, 1.0f},
+        {0.0331048f, 0.0030960f, 0.7874123f},
+        {-0.0386997f, 2.5371556f, 0.5225216f}
+    };
+
+    Corrade::Containers::StridedArrayView1D<Vector3> src{data, &data[0].src,
+        Corrade::Containers::arraySize(data), sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Color3> dst{data, &data[0].dst,
+        Corrade::Containers::arraySize(data), sizeof(Data)};
+    fromSrgbInto(Corrade::Containers::arrayCast<2, Float>(src),
+                 Corrade::Containers::arrayCast<2, Float>(dst));
+    CORRADE_COMPARE_AS(dst, Corrade::Containers::stridedArrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    /* Ensure the results are consistent with non-batch APIs */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i)
+        CORRADE_COMPARE(Color3::fromSrgb(data[i].src), data[i].dst);
+}
+
+void PackingBatchTest::toSrgbFloat() {
+    struct Data {
+        Color3 src;
+        Vector3 dst;
+    } data[]{
+        {{0.0f, 0.5f, 1.0f}, {}},
+        {{0.2f, 0.04f, 0.9f}, {}},
+        /* Values outside of the range are converted too */
+        {{-0.5f, 1.5f, 0.0031308f}, {}}
+    };
+
+    constexpr Vector3 expected[] {
+        {0.0f, 0.7353569f, 1.0f},
+        {0.4845292f, 0.2209164f, 0.9546872f},
+        {-6.46f, 1.1941764f, 0.0404499f}
+    };
+
+    Corrade::Containers::StridedArrayView1D<Color3> src{data, &data[0].src,
+        Corrade::Containers::arraySize(data), sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Vector3> dst{data, &data[0].dst,
+        Corrade::Containers::arraySize(data), sizeof(Data)};
+    toSrgbInto(Corrade::Containers::arrayCast<2, Float>(src),
+               Corrade::Containers::arrayCast<2, Float>(dst));
+    CORRADE_COMPARE_AS(dst, Corrade::Containers::stridedArrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    /* Ensure the results are consistent with non-batch APIs */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i)
+        CORRADE_COMPARE(data[i].src.toSrgb(), data[i].dst);
+}
+
+void PackingBatchTest::toSrgbUnsignedByte() {
+    struct Data {
+        Color3 src;
+        Vector3ub dst;
+    } data[]{
+        {{0.0f, 0.5f, 1.0f}, {}},
+        {{0.2f, 0.04f, 0.9f}, {}},
+        {{0.75f, 0.001f, 0.3f}, {}},
+        /* Values outside of the range are clamped, NaN becomes zero */
+        {{-0.5f, 1.5f, Constants::nan()}, {}}
+    };
+
+    constexpr Vector3ub expected[] {
+        {0, 188, 255},
+        {124, 56, 243},
+        {225, 3, 149},
+        {0, 255, 0}
+    };
+
+    Corrade::Containers::StridedArrayView1D<Color3> src{data, &data[0].src,
+        Corrade::Containers::arraySize(data), sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Vector3ub> dst{data, &data[0].dst,
+        Corrade::Containers::arraySize(data), sizeof(Data)};
+    toSrgbInto(Corrade::Containers::arrayCast<2, Float>(src),
+               Corrade::Containers::arrayCast<2, UnsignedByte>(dst));
+    CORRADE_COMPARE_AS(dst, Corrade::Containers::stridedArrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    /* Ensure the results are consistent with non-batch APIs, except for the
+       last item that's out of range */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data) - 1; ++i)
+        CORRADE_COMPARE(data[i].src.toSrgb<UnsignedByte>(), data[i].dst);
+}
+
+void PackingBatchTest::srgbPrecision() {
+    /* Verifies the error bounds stated in the docs on a dense sampling of the
+       [0, 1] range against a double-precision calculation */
+    constexpr std::size_t count = 65537;
+    Corrade::Containers::Array<Float> values{Corrade::Containers::NoInit, count};
+    Corrade::Containers::Array<Float> linear{Corrade::Containers::NoInit, count};
+    Corrade::Containers::Array<Float> srgb{Corrade::Containers::NoInit, count};
+    Corrade::Containers::Array<UnsignedByte> srgb8{Corrade::Containers::NoInit, count};
+    for(std::size_t i = 0; i != count; ++i)
+        values[i] = Float(i)/Float(count - 1);
+
+    const Corrade::Containers::StridedArrayView2D<const Float> valuesView{values, {count, 1}};
+    fromSrgbInto(valuesView, Corrade::Containers::StridedArrayView2D<Float>{linear, {count, 1}});
+    toSrgbInto(valuesView, Corrade::Containers::StridedArrayView2D<Float>{srgb, {count, 1}});
+    toSrgbInto(valuesView, Corrade::Containers::StridedArrayView2D<UnsignedByte>{srgb8, {count, 1}});
+
+    Double maxLinearError{}, maxSrgbError{};
+    Int maxSrgb8Error{};
+    for(std::size_t i = 0; i != count; ++i) {
+        const Double value = values[i];
+        const Double expectedLinear = value <= 0.04045 ? value/12.92 : std::pow((value + 0.055)/1.055, 2.4);
+        const Double expectedSrgb = value <= 0.0031308 ? value*12.92 : 1.055*std::pow(value, 1.0/2.4) - 0.055;
+        maxLinearError = Math::max(maxLinearError, Math::abs(linear[i] - expectedLinear));
+        maxSrgbError = Math::max(maxSrgbError, Math::abs(srgb[i] - expectedSrgb));
+        maxSrgb8Error = Math::max(maxSrgb8Error, Math::abs(Int(srgb8[i]) - Int(std::floor(expectedSrgb*255.0 + 0.5))));
+    }
+
+    CORRADE_COMPARE_AS(maxLinearError, 3.0e-7,
+        Corrade::TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(maxSrgbError, 3.0e-7,
+        Corrade::TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(maxSrgb8Error, 1,
+        Corrade::TestSuite::Compare::LessOrEqual);
+
+    /* The 8-bit table is correctly rounded */
+    UnsignedByte all[256];
+    Float allLinear[256];
+    for(std::size_t i = 0; i != 256; ++i) all[i] = UnsignedByte(i);
+    fromSrgbInto(
+        Corrade::Containers::StridedArrayView2D<const UnsignedByte>{all, {256, 1}},
+        Corrade::Containers::StridedArrayView2D<Float>{allLinear, {256, 1}});
+    for(std::size_t i = 0; i != 256; ++i) {
+        CORRADE_ITERATION(i);
+        const Double value = i/255.0;
+        CORRADE_COMPARE(allLinear[i], Float(value <= 0.04045 ? value/12.92 : std::pow((value + 0.055)/1.055, 2.4)));
+    }
+}
+
 template<class T> void PackingBatchTest::castUnsignedFloat() {
     setTestCaseTemplateName(TypeTraits<T>::name());
 
@@ -646,6 +837,54 @@ void PackingBatchTest::assertionsPackUnpackHalf() {
         "Math::packHalfInto(): second view dimension is not contiguous\n");
 }
 
+void PackingBatchTest::assertionsSrgb() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vector3ub data[2]{};
+    Vector3 dataFloat[2]{};
+    Vector3 resultWrongCount[1]{};
+    Vector4 resultWrongVectorSize[2]{};
+    Math::Vector<6, Float> resultNonContiguous[2]{};
+    Math::Vector<6, UnsignedByte> resultNonContiguousByte[2]{};
+
+    auto src = Corrade::Containers::arrayCast<2, UnsignedByte>(
+        Corrade::Containers::arrayView(data));
+    auto srcFloat = Corrade::Containers::arrayCast<2, Float>(
+        Corrade::Containers::arrayView(dataFloat));
+    auto dstWrongCount = Corrade::Containers::arrayCast<2, Float>(
+        Corrade::Containers::arrayView(resultWrongCount));
+    auto dstWrongVectorSize = Corrade::Containers::arrayCast<2, Float>(
+        Corrade::Containers::arrayView(resultWrongVectorSize));
+    auto dstNotContiguous = Corrade::Containers::arrayCast<2, Float>(
+        Corrade::Containers::arrayView(resultNonContiguous)).every({1, 2});
+    auto dstNotContiguousByte = Corrade::Containers::arrayCast<2, UnsignedByte>(
+        Corrade::Containers::arrayView(resultNonContiguousByte)).every({1, 2});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    fromSrgbInto(src, dstWrongCount);
+    fromSrgbInto(src, dstWrongVectorSize);
+    fromSrgbInto(src, dstNotContiguous);
+    fromSrgbInto(srcFloat, dstWrongCount);
+    fromSrgbInto(srcFloat, dstNotContiguous);
+    toSrgbInto(srcFloat, dstWrongVectorSize);
+    toSrgbInto(srcFloat, dstNotContiguous);
+    toSrgbInto(dstWrongCount, src);
+    toSrgbInto(srcFloat, dstNotContiguousByte);
+    CORRADE_COMPARE(out.str(),
+        "Math::fromSrgbInto(): wrong destination size, got {1, 3} but expected {2, 3}\n"
+        "Math::fromSrgbInto(): wrong destination size, got {2, 4} but expected {2, 3}\n"
+        "Math::fromSrgbInto(): second view dimension is not contiguous\n"
+        "Math::fromSrgbInto(): wrong destination size, got {1, 3} but expected {2, 3}\n"
+        "Math::fromSrgbInto(): second view dimension is not contiguous\n"
+        "Math::toSrgbInto(): wrong destination size, got {2, 4} but expected {2, 3}\n"
+        "Math::toSrgbInto(): second view dimension is not contiguous\n"
+        "Math::toSrgbInto(): wrong destination size, got {2, 3} but expected {1, 3}\n"
+        "Math::toSrgbInto(): second view dimension is not contiguous\n");
+}
+
 template<class U, class T> void PackingBatchTest::assertionsCast() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -0,0 +1,638 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Bvh.h"
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Implementation/Parallel.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Bin count for the SAH split search. More bins find slightly better splits
+   but make the build slower, 16 is the usual compromise. */
+constexpr UnsignedInt BinCount = 16;
+
+/* Nodes with at most this many triangles become leaves if splitting them
+   doesn't reduce the expected cost, larger nodes are always split */
+constexpr UnsignedInt MaxLeafSize = 4;
+
+/* Cost of traversing a node relative to a ray/triangle test */
+constexpr Float TraversalCost = 1.0f;
+
+/* Nodes deeper than this are always leaves, which bounds the size of the
+   traversal stacks */
+constexpr UnsignedInt MaxDepth = 48;
+
+/* Calculating triangle bounds is cheap, give each thread enough triangles to
+   offset the cost of spawning it */
+constexpr std::size_t MinTrianglesPerThread = 16384;
+
+constexpr UnsignedInt NoHit = ~UnsignedInt{};
+
+inline Range3D emptyRange() {
+    return {Vector3{Constants::inf()}, Vector3{-Constants::inf()}};
+}
+
+/* Unlike Math::join() this doesn't treat zero-size ranges as empty, which
+   would make points and axis-aligned triangles disappear */
+inline Range3D joinRanges(const Range3D& a, const Range3D& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+/* Half of the surface area, the factor of two doesn't matter for SAH */
+inline Float halfArea(const Range3D& range) {
+    const Vector3 size = range.size();
+    return size.x()*size.y() + size.y()*size.z() + size.z()*size.x();
+}
+
+inline UnsignedInt binFor(const Float centroid, const Float min, const Float scale) {
+    return Math::min(UnsignedInt((centroid - min)*scale), BinCount - 1);
+}
+
+struct BuildState {
+    Containers::ArrayView<const Range3D> triangleBounds;
+    Containers::ArrayView<const Vector3> centroids;
+    Containers::ArrayView<UnsignedInt> triangleIds;
+};
+
+/* Builds a subtree for triangles [begin, end) into node nodeId, appending
+   its descendants to the end of nodes. The left subtree of nodes above
+   parallelDepth is built on a separate thread into its own array and then
+   appended after the right subtree. */
+void buildInto(const BuildState& state, Containers::Array<Bvh::Node>& nodes, const std::size_t nodeId, const UnsignedInt begin, const UnsignedInt end, const UnsignedInt depth, const UnsignedInt parallelDepth) {
+    Range3D bounds = emptyRange();
+    Range3D centroidBounds = emptyRange();
+    for(UnsignedInt i = begin; i != end; ++i) {
+        const UnsignedInt id = state.triangleIds[i];
+        bounds = joinRanges(bounds, state.triangleBounds[id]);
+        centroidBounds = joinRanges(centroidBounds, {state.centroids[id], state.centroids[id]});
+    }
+
+    const UnsignedInt count = end - begin;
+    if(count == 1 || depth >= MaxDepth) {
+        nodes[nodeId] = Bvh::Node{bounds, begin, count};
+        return;
+    }
+
+    /* Find the split with the least cost among bin boundaries on all axes.
+       Axes where all centroids are at the same position are skipped. */
+    Float bestCost = Constants::inf();
+    UnsignedInt bestAxis{}, bestSplit{};
+    Float bestMin{}, bestScale{};
+    for(UnsignedInt axis = 0; axis != 3; ++axis) {
+        const Float min = centroidBounds.min()[axis];
+        const Float extent = centroidBounds.max()[axis] - min;
+        if(!(extent > 0.0f)) continue;
+        const Float scale = BinCount/extent;
+
+        Range3D binBounds[BinCount];
+        UnsignedInt binCounts[BinCount]{};
+        for(Range3D& i: binBounds) i = emptyRange();
+        for(UnsignedInt i = begin; i != end; ++i) {
+            const UnsignedInt id = state.triangleIds[i];
+            const UnsignedInt bin = binFor(state.centroids[id][axis], min, scale);
+            binBounds[bin] = joinRanges(binBounds[bin], state.triangleBounds[id]);
+            ++binCounts[bin];
+        }
+
+        /* Sweep from the right to get the area and count of everything right
+           of each bin boundary, then sweep from the left and evaluate the
+           cost at each boundary */
+        Float rightAreas[BinCount];
+        UnsignedInt rightCounts[BinCount];
+        Range3D right = emptyRange();
+        UnsignedInt rightCount = 0;
+        for(UnsignedInt i = BinCount - 1; i != 0; --i) {
+            right = joinRanges(right, binBounds[i]);
+            rightCount += binCounts[i];
+            rightAreas[i] = rightCount ? halfArea(right) : 0.0f;
+            rightCounts[i] = rightCount;
+        }
+
+        Range3D left = emptyRange();
+        UnsignedInt leftCount = 0;
+        for(UnsignedInt i = 1; i != BinCount; ++i) {
+            left = joinRanges(left, binBounds[i - 1]);
+            leftCount += binCounts[i - 1];
+            if(!leftCount || !rightCounts[i]) continue;
+
+            const Float cost = leftCount*halfArea(left) + rightCounts[i]*rightAreas[i];
+            if(cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = i;
+                bestMin = min;
+                bestScale = scale;
+            }
+        }
+    }
+
+    UnsignedInt middle;
+
+    /* All centroids at the same position, split in the middle unless the
+       node is small enough */
+    if(bestCost == Constants::inf()) {
+        if(count <= MaxLeafSize) {
+            nodes[nodeId] = Bvh::Node{bounds, begin, count};
+            return;
+        }
+
+        middle = begin + count/2;
+
+    /* Otherwise make a leaf if it's cheaper than the split and small enough,
+       and partition the triangles if not */
+    } else {
+        const Float area = halfArea(bounds);
+        if(count <= MaxLeafSize && TraversalCost*area + bestCost >= count*area) {
+            nodes[nodeId] = Bvh::Node{bounds, begin, count};
+            return;
+        }
+
+        middle = UnsignedInt(std::partition(state.triangleIds + begin, state.triangleIds + end, [&](const UnsignedInt id) {
+            return binFor(state.centroids[id][bestAxis], bestMin, bestScale) < bestSplit;
+        }) - state.triangleIds.begin());
+        CORRADE_INTERNAL_ASSERT(middle != begin && middle != end);
+    }
+
+    const std::size_t childId = nodes.size();
+    arrayResize(nodes, Containers::NoInit, childId + 2);
+    nodes[nodeId] = Bvh::Node{bounds, UnsignedInt(childId), 0};
+
+    if(depth >= parallelDepth) {
+        buildInto(state, nodes, childId, begin, middle, depth + 1, parallelDepth);
+        buildInto(state, nodes, childId + 1, middle, end, depth + 1, parallelDepth);
+        return;
+    }
+
+    /* The left subtree has its root at index 0 and children offsets relative
+       to that, so after appending the rest of it at the end the offsets of
+       interior nodes need to be shifted */
+    Containers::Array<Bvh::Node> leftNodes;
+    arrayResize(leftNodes, Containers::NoInit, 1);
+    std::thread thread{[&]() {
+        buildInto(state, leftNodes, 0, begin, middle, depth + 1, parallelDepth);
+    }};
+    buildInto(state, nodes, childId + 1, middle, end, depth + 1, parallelDepth);
+    thread.join();
+
+    const std::size_t offset = nodes.size() - 1;
+    arrayResize(nodes, Containers::NoInit, offset + leftNodes.size());
+    for(std::size_t i = 0; i != leftNodes.size(); ++i) {
+        Bvh::Node node = leftNodes[i];
+        if(!node.count) node.offset += offset;
+        nodes[i ? offset + i : childId] = node;
+    }
+}
+
+/* Slab test. The parameters of the closer intersection are clamped to the
+   [0, maxDistance] range and the test passes if the range is non-empty. Axes
+   where the ray is parallel to the box produce NaNs if the origin is exactly
+   on the box boundary, which Math::min() and Math::max() ignore. */
+inline bool intersectRayBox(const Vector3& origin, const Vector3& inverseDirection, const Range3D& box, const Float maxDistance, Float& entry) {
+    Float nearest = 0.0f;
+    Float farthest = maxDistance;
+    for(std::size_t axis = 0; axis != 3; ++axis) {
+        const Float t0 = (box.min()[axis] - origin[axis])*inverseDirection[axis];
+        const Float t1 = (box.max()[axis] - origin[axis])*inverseDirection[axis];
+        nearest = Math::max(nearest, Math::min(t0, t1));
+        farthest = Math::min(farthest, Math::max(t0, t1));
+    }
+
+    entry = nearest;
+    return nearest <= farthest;
+}
+
+/* Möller-Trumbore ray/triangle test. The distance isn't checked against any
+   range, that's up to the caller. */
+inline bool intersectRayTriangle(const Vector3& origin, const Vector3& direction, const Vector3* const triangle, Float& distance, Vector2& barycentric) {
+    const Vector3 ab = triangle[1] - triangle[0];
+    const Vector3 ac = triangle[2] - triangle[0];
+    const Vector3 p = Math::cross(direction, ac);
+    const Float determinant = Math::dot(ab, p);
+    if(determinant == 0.0f) return false;
+
+    const Float inverseDeterminant = 1.0f/determinant;
+    const Vector3 s = origin - triangle[0];
+    const Float u = Math::dot(s, p)*inverseDeterminant;
+    if(u < 0.0f || u > 1.0f) return false;
+
+    const Vector3 q = Math::cross(s, ab);
+    const Float v = Math::dot(direction, q)*inverseDeterminant;
+    if(v < 0.0f || u + v > 1.0f) return false;
+
+    distance = Math::dot(ac, q)*inverseDeterminant;
+    barycentric = {u, v};
+    return true;
+}
+
+/* Ray data of a packet as a structure of arrays, so the per-ray loops below
+   can be vectorized. Unused rays have maxDistance negative, which makes them
+   fail all tests. */
+struct RayPacket {
+    Float origin[3][Bvh::PacketSize];
+    Float direction[3][Bvh::PacketSize];
+    Float inverseDirection[3][Bvh::PacketSize];
+    Float maxDistance[Bvh::PacketSize];
+    UnsignedInt triangle[Bvh::PacketSize];
+    Float u[Bvh::PacketSize];
+    Float v[Bvh::PacketSize];
+};
+
+void fillPacket(RayPacket& packet, const Containers::StridedArrayView1D<const Vector3>& origins, const Containers::StridedArrayView1D<const Vector3>& directions, const Float maxDistance, const std::size_t begin, const std::size_t count) {
+    for(std::size_t i = 0; i != Bvh::PacketSize; ++i) {
+        const bool used = i < count;
+        const Vector3 origin = used ? origins[begin + i] : Vector3{};
+        const Vector3 direction = used ? directions[begin + i] : Vector3::xAxis();
+        for(std::size_t axis = 0; axis != 3; ++axis) {
+            packet.origin[axis][i] = origin[axis];
+            packet.direction[axis][i] = direction[axis];
+            packet.inverseDirection[axis][i] = 1.0f/direction[axis];
+        }
+        packet.maxDistance[i] = used ? maxDistance : -1.0f;
+        packet.triangle[i] = NoHit;
+        packet.u[i] = 0.0f;
+        packet.v[i] = 0.0f;
+    }
+}
+
+/* Same as intersectRayBox() for all rays in the packet, returns a mask of
+   rays that hit the box */
+UnsignedInt intersectPacketBox(const RayPacket& packet, const Range3D& box) {
+    Float nearest[Bvh::PacketSize];
+    Float farthest[Bvh::PacketSize];
+    for(std::size_t i = 0; i != Bvh::PacketSize; ++i) {
+        nearest[i] = 0.0f;
+        farthest[i] = packet.maxDistance[i];
+    }
+
+    for(std::size_t axis = 0; axis != 3; ++axis) {
+        const Float min = box.min()[axis];
+        const Float max = box.max()[axis];
+        for(std::size_t i = 0; i != Bvh::PacketSize; ++i) {
+            const Float t0 = (min - packet.origin[axis][i])*packet.inverseDirection[axis][i];
+            const Float t1 = (max - packet.origin[axis][i])*packet.inverseDirection[axis][i];
+            nearest[i] = Math::max(nearest[i], Math::min(t0, t1));
+            farthest[i] = Math::min(farthest[i], Math::max(t0, t1));
+        }
+    }
+
+    UnsignedInt mask = 0;
+    for(std::size_t i = 0; i != Bvh::PacketSize; ++i)
+        mask |= UnsignedInt(nearest[i] <= farthest[i]) << i;
+    return mask;
+}
+
+/* Same as intersectRayTriangle() for all rays in the packet, without early
+   exits. Rays that hit the triangle closer than their maxDistance record
+   the hit and have the maxDistance shortened to it. For any-hit queries the
+   maxDistance is set negative instead, so the ray doesn't participate in
+   any further tests. */
+template<bool anyHit> void intersectPacketTriangle(RayPacket& packet, const Vector3* const triangle, const UnsignedInt id) {
+    const Vector3 ab = triangle[1] - triangle[0];
+    const Vector3 ac = triangle[2] - triangle[0];
+    for(std::size_t i = 0; i != Bvh::PacketSize; ++i) {
+        const Vector3 direction{packet.direction[0][i], packet.direction[1][i], packet.direction[2][i]};
+        const Vector3 s = Vector3{packet.origin[0][i], packet.origin[1][i], packet.origin[2][i]} - triangle[0];
+        const Vector3 p = Math::cross(direction, ac);
+        const Vector3 q = Math::cross(s, ab);
+        const Float determinant = Math::dot(ab, p);
+        const Float inverseDeterminant = 1.0f/determinant;
+        const Float u = Math::dot(s, p)*inverseDeterminant;
+        const Float v = Math::dot(direction, q)*inverseDeterminant;
+        const Float distance = Math::dot(ac, q)*inverseDeterminant;
+
+        const bool hit = determinant != 0.0f &&
+            u >= 0.0f && u <= 1.0f && v >= 0.0f && u + v <= 1.0f &&
+            distance >= 0.0f && distance < packet.maxDistance[i];
+        packet.maxDistance[i] = hit ? (anyHit ? -1.0f : distance) : packet.maxDistance[i];
+        packet.triangle[i] = hit ? id : packet.triangle[i];
+        packet.u[i] = hit ? u : packet.u[i];
+        packet.v[i] = hit ? v : packet.v[i];
+    }
+}
+
+/* Traverses the tree once for all rays in the packet, descending into nodes
+   hit by at least one ray. Children are visited in the order of the average
+   ray direction. */
+template<bool anyHit> void traversePacket(const Containers::ArrayView<const Bvh::Node> nodes, const Containers::ArrayView<const Vector3> vertices, RayPacket& packet) {
+    Vector3 direction;
+    for(std::size_t i = 0; i != Bvh::PacketSize; ++i)
+        direction += Vector3{packet.direction[0][i], packet.direction[1][i], packet.direction[2][i]};
+
+    UnsignedInt stack[MaxDepth + 2];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize) {
+        const Bvh::Node& node = nodes[stack[--stackSize]];
+        if(!intersectPacketBox(packet, node.bounds)) continue;
+
+        if(node.count) {
+            for(UnsignedInt i = node.offset, end = node.offset + node.count; i != end; ++i)
+                intersectPacketTriangle<anyHit>(packet, vertices + i*3, i);
+
+            if(anyHit && std::all_of(packet.maxDistance, packet.maxDistance + Bvh::PacketSize, [](Float distance) { return distance < 0.0f; }))
+                return;
+            continue;
+        }
+
+        /* Push the farther child first so it's popped last */
+        const Vector3 difference = nodes[node.offset + 1].bounds.center() - nodes[node.offset].bounds.center();
+        const UnsignedInt secondCloser = Math::dot(difference, direction) < 0.0f;
+        stack[stackSize++] = node.offset + 1 - secondCloser;
+        stack[stackSize++] = node.offset + secondCloser;
+    }
+}
+
+/* Separating axis test of a triangle and a box, after Akenine-Möller, Fast
+   3D Triangle-Box Overlap Testing. Touching counts as overlapping. */
+bool overlapsTriangleBox(const Vector3& center, const Vector3& halfSize, const Vector3* const triangle) {
+    const Vector3 v[]{
+        triangle[0] - center,
+        triangle[1] - center,
+        triangle[2] - center
+    };
+
+    /* Box face normals, equivalent to a box/box test with triangle bounds */
+    if((Math::min(v[0], Math::min(v[1], v[2])) > halfSize).any() ||
+       (Math::max(v[0], Math::max(v[1], v[2])) < -halfSize).any())
+        return false;
+
+    /* Triangle normal */
+    const Vector3 edges[]{v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+    const Vector3 normal = Math::cross(edges[0], edges[1]);
+    if(Math::abs(Math::dot(normal, v[0])) > Math::dot(halfSize, Math::abs(normal)))
+        return false;
+
+    /* Cross products of triangle edges and box axes */
+    for(const Vector3& edge: edges) {
+        for(std::size_t i = 0; i != 3; ++i) {
+            Vector3 boxAxis;
+            boxAxis[i] = 1.0f;
+            const Vector3 axis = Math::cross(boxAxis, edge);
+            const Float p0 = Math::dot(axis, v[0]);
+            const Float p1 = Math::dot(axis, v[1]);
+            const Float p2 = Math::dot(axis, v[2]);
+            const Float radius = Math::dot(halfSize, Math::abs(axis));
+            if(Math::min(p0, Math::min(p1, p2)) > radius ||
+               Math::max(p0, Math::max(p1, p2)) < -radius)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+Bvh::Bvh(const Trade::MeshData& mesh, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::Bvh: expected a triangle mesh but got" << mesh.primitive(), );
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::Bvh: the mesh has no positions", );
+
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    Containers::Array<UnsignedInt> indices;
+    if(mesh.isIndexed()) indices = mesh.indicesAsArray();
+    else {
+        indices = Containers::Array<UnsignedInt>{Containers::NoInit, mesh.vertexCount()};
+        std::iota(indices.begin(), indices.end(), 0);
+    }
+
+    *this = Bvh{Containers::stridedArrayView(indices), Containers::stridedArrayView(positions), threadCount};
+}
+
+Bvh::Bvh(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::Bvh: expected index count divisible by 3, got" << indices.size(), );
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::Bvh: index" << index << "out of bounds for" << positions.size() << "vertices", );
+    #endif
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* Calculate bounds and centroids of all triangles */
+    const UnsignedInt actualThreadCount = Implementation::parallelThreadCount(threadCount, triangleCount, MinTrianglesPerThread);
+    Containers::Array<Range3D> triangleBounds{Containers::NoInit, triangleCount};
+    Containers::Array<Vector3> centroids{Containers::NoInit, triangleCount};
+    Implementation::parallelFor(actualThreadCount, triangleCount, [&](UnsignedInt, const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            const Vector3& a = positions[indices[i*3 + 0]];
+            const Vector3& b = positions[indices[i*3 + 1]];
+            const Vector3& c = positions[indices[i*3 + 2]];
+            triangleBounds[i] = {Math::min(a, Math::min(b, c)),
+                                 Math::max(a, Math::max(b, c))};
+            centroids[i] = triangleBounds[i].center();
+        }
+    });
+
+    _triangleIds = Containers::Array<UnsignedInt>{Containers::NoInit, triangleCount};
+    std::iota(_triangleIds.begin(), _triangleIds.end(), 0);
+
+    /* Each level above parallelDepth doubles the thread count */
+    UnsignedInt parallelDepth = 0;
+    while((1u << parallelDepth) < actualThreadCount) ++parallelDepth;
+
+    arrayResize(_nodes, Containers::NoInit, 1);
+    buildInto({triangleBounds, centroids, _triangleIds}, _nodes, 0, 0, triangleCount, 0, parallelDepth);
+    arrayShrink(_nodes, Containers::DefaultInit);
+
+    /* Copy the vertices in leaf order, so triangles of each leaf are next to
+       each other in memory */
+    _vertices = Containers::Array<Vector3>{Containers::NoInit, triangleCount*3};
+    for(std::size_t i = 0; i != triangleCount; ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            _vertices[i*3 + j] = positions[indices[_triangleIds[i]*3 + j]];
+}
+
+Bvh::Bvh(Bvh&&) noexcept = default;
+
+Bvh::~Bvh() = default;
+
+Bvh& Bvh::operator=(Bvh&&) noexcept = default;
+
+Range3D Bvh::bounds() const {
+    return _nodes.empty() ? Range3D{} : _nodes[0].bounds;
+}
+
+Containers::Optional<Bvh::Hit> Bvh::closestHit(const Vector3& origin, const Vector3& direction, const Float maxDistance) const {
+    if(_nodes.empty()) return {};
+
+    const Vector3 inverseDirection = 1.0f/direction;
+    Hit hit{NoHit, maxDistance, {}};
+
+    /* Nodes to visit together with distance at which the ray enters them, so
+       nodes behind the closest hit found so far can be skipped */
+    struct StackItem {
+        UnsignedInt node;
+        Float entry;
+    } stack[MaxDepth + 2];
+    std::size_t stackSize = 0;
+    Float entry;
+    if(!intersectRayBox(origin, inverseDirection, _nodes[0].bounds, maxDistance, entry))
+        return {};
+    stack[stackSize++] = {0, entry};
+
+    while(stackSize) {
+        const StackItem item = stack[--stackSize];
+        if(item.entry > hit.distance) continue;
+
+        const Node& node = _nodes[item.node];
+        if(node.count) {
+            Float distance;
+            Vector2 barycentric;
+            for(UnsignedInt i = node.offset, end = node.offset + node.count; i != end; ++i) {
+                if(intersectRayTriangle(origin, direction, _vertices + i*3, distance, barycentric) && distance >= 0.0f && distance < hit.distance)
+                    hit = Hit{i, distance, barycentric};
+            }
+            continue;
+        }
+
+        /* Push the farther child first so it's popped last */
+        Float entries[2];
+        const bool hits[]{
+            intersectRayBox(origin, inverseDirection, _nodes[node.offset].bounds, hit.distance, entries[0]),
+            intersectRayBox(origin, inverseDirection, _nodes[node.offset + 1].bounds, hit.distance, entries[1])
+        };
+        const UnsignedInt first = entries[1] < entries[0];
+        if(hits[1 - first])
+            stack[stackSize++] = {node.offset + 1 - first, entries[1 - first]};
+        if(hits[first])
+            stack[stackSize++] = {node.offset + first, entries[first]};
+    }
+
+    if(hit.triangle == NoHit) return {};
+    hit.triangle = _triangleIds[hit.triangle];
+    return hit;
+}
+
+bool Bvh::anyHit(const Vector3& origin, const Vector3& direction, const Float maxDistance) const {
+    if(_nodes.empty()) return false;
+
+    const Vector3 inverseDirection = 1.0f/direction;
+    UnsignedInt stack[MaxDepth + 2];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    Float entry;
+    while(stackSize) {
+        const Node& node = _nodes[stack[--stackSize]];
+        if(!intersectRayBox(origin, inverseDirection, node.bounds, maxDistance, entry))
+            continue;
+
+        if(node.count) {
+            Float distance;
+            Vector2 barycentric;
+            for(UnsignedInt i = node.offset, end = node.offset + node.count; i != end; ++i) {
+                if(intersectRayTriangle(origin, direction, _vertices + i*3, distance, barycentric) && distance >= 0.0f && distance < maxDistance)
+                    return true;
+            }
+            continue;
+        }
+
+        stack[stackSize++] = node.offset;
+        stack[stackSize++] = node.offset + 1;
+    }
+
+    return false;
+}
+
+void Bvh::closestHits(const Containers::StridedArrayView1D<const Vector3>& origins, const Containers::StridedArrayView1D<const Vector3>& directions, const Float maxDistance, const Containers::StridedArrayView1D<Hit>& hits) const {
+    CORRADE_ASSERT(directions.size() == origins.size() && hits.size() == origins.size(),
+        "MeshTools::Bvh::closestHits(): expected" << origins.size() << "directions and hits but got" << directions.size() << "and" << hits.size(), );
+
+    RayPacket packet;
+    for(std::size_t begin = 0; begin < origins.size(); begin += PacketSize) {
+        const std::size_t count = Math::min(std::size_t(PacketSize), origins.size() - begin);
+        fillPacket(packet, origins, directions, maxDistance, begin, count);
+        if(!_nodes.empty()) traversePacket<false>(_nodes, _vertices, packet);
+
+        for(std::size_t i = 0; i != count; ++i) {
+            const bool hit = packet.triangle[i] != NoHit;
+            hits[begin + i] = Hit{hit ? _triangleIds[packet.triangle[i]] : NoHit,
+                packet.maxDistance[i], {packet.u[i], packet.v[i]}};
+        }
+    }
+}
+
+void Bvh::anyHits(const Containers::StridedArrayView1D<const Vector3>& origins, const Containers::StridedArrayView1D<const Vector3>& directions, const Float maxDistance, const Containers::StridedArrayView1D<bool>& hits) const {
+    CORRADE_ASSERT(directions.size() == origins.size() && hits.size() == origins.size(),
+        "MeshTools::Bvh::anyHits(): expected" << origins.size() << "directions and hits but got" << directions.size() << "and" << hits.size(), );
+
+    RayPacket packet;
+    for(std::size_t begin = 0; begin < origins.size(); begin += PacketSize) {
+        const std::size_t count = Math::min(std::size_t(PacketSize), origins.size() - begin);
+        fillPacket(packet, origins, directions, maxDistance, begin, count);
+        if(!_nodes.empty()) traversePacket<true>(_nodes, _vertices, packet);
+
+        for(std::size_t i = 0; i != count; ++i)
+            hits[begin + i] = packet.triangle[i] != NoHit;
+    }
+}
+
+Containers::Array<UnsignedInt> Bvh::overlapping(const Range3D& range) const {
+    Containers::Array<UnsignedInt> out;
+    if(_nodes.empty()) return out;
+
+    const Vector3 center = range.center();
+    const Vector3 halfSize = range.size()*0.5f;
+    UnsignedInt stack[MaxDepth + 2];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize) {
+        const Node& node = _nodes[stack[--stackSize]];
+        if((node.bounds.min() > range.max()).any() ||
+           (node.bounds.max() < range.min()).any())
+            continue;
+
+        if(node.count) {
+            for(UnsignedInt i = node.offset, end = node.offset + node.count; i != end; ++i)
+                if(overlapsTriangleBox(center, halfSize, _vertices + i*3))
+                    arrayAppend(out, _triangleIds[i]);
+            continue;
+        }
+
+        stack[stackSize++] = node.offset;
+        stack[stackSize++] = node.offset + 1;
+    }
+
+    /* Convert back to a non-growable Array so users don't get surprised by
+       a custom deleter */
+    arrayShrink(out, Containers::DefaultInit);
+    return out;
+}
+
+}}
@@ -0,0 +1,282 @@
+#ifndef Magnum_MeshTools_Bvh_h
+#define Magnum_MeshTools_Bvh_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::Bvh
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Bounding volume hierarchy over a triangle mesh
+@m_since_latest
+
+Acceleration structure for ray and overlap queries on a triangle mesh, for
+use in CPU-side picking, baking or visibility tools where testing each
+triangle separately would be too slow.
+
+@section MeshTools-Bvh-build Building
+
+The hierarchy is built using a binned surface area heuristic (SAH) --- at
+each node, triangle centroids are sorted into 16 bins along each axis and the
+split minimizing the expected ray traversal cost is picked. Nodes with a few
+triangles where splitting wouldn't pay off become leaves. Calculation of
+triangle bounds and the top levels of the tree are processed in parallel
+with up to the passed thread count, with each thread getting at least 16k
+triangles so small meshes are processed on the calling thread only.
+
+The nodes are stored in a single flat array in depth-first order with both
+children of a node next to each other, see @ref Node for details. Triangle
+vertex positions are copied into the hierarchy in the leaf order, so the
+original mesh doesn't need to be kept around.
+
+@section MeshTools-Bvh-queries Queries
+
+@ref closestHit() finds the nearest triangle along a ray, @ref anyHit() only
+checks if there's any triangle along a ray, which is faster for occlusion
+and shadow rays. Both traverse the tree front-to-back using a stack.
+
+@ref closestHits() and @ref anyHits() process batches of rays in packets of
+@ref PacketSize, traversing the tree once for the whole packet. Ray data in
+a packet are stored as a structure of arrays and every box and triangle test
+is done for all rays in a single loop, which the compiler turns into SSE,
+AVX or NEON code as appropriate for the target. This is most efficient for
+coherent rays, such as primary rays from a camera or rays from a lightmap
+texel. For divergent rays use the single-ray variants instead.
+
+@ref overlapping() returns all triangles that overlap given axis-aligned box.
+
+@snippet MagnumMeshTools.cpp Bvh-usage
+*/
+class MAGNUM_MESHTOOLS_EXPORT Bvh {
+    public:
+        enum: std::size_t {
+            /**
+             * Count of rays processed together in @ref closestHits() and
+             * @ref anyHits()
+             */
+            PacketSize = 8
+        };
+
+        /**
+         * @brief Hierarchy node
+         *
+         * If @ref count is non-zero, the node is a leaf containing triangles
+         * @cpp offset @ce to @cpp offset + count - 1 @ce in the
+         * @ref triangleIds() array. Otherwise it's an interior node with
+         * children at indices @cpp offset @ce and @cpp offset + 1 @ce in
+         * the @ref nodes() array.
+         */
+        struct Node {
+            /** @brief Node bounds */
+            Range3D bounds;
+
+            /** @brief First child node index or first triangle index */
+            UnsignedInt offset;
+
+            /** @brief Triangle count or @cpp 0 @ce for an interior node */
+            UnsignedInt count;
+        };
+
+        /**
+         * @brief Ray hit
+         *
+         * @see @ref closestHit(), @ref closestHits()
+         */
+        struct Hit {
+            /**
+             * @brief Triangle ID
+             *
+             * Index of the triangle in the original mesh. In case of
+             * @ref closestHits(), rays that didn't hit anything have this set
+             * to @cpp ~UnsignedInt{} @ce.
+             */
+            UnsignedInt triangle;
+
+            /**
+             * @brief Hit distance
+             *
+             * In multiples of the ray direction length.
+             */
+            Float distance;
+
+            /**
+             * @brief Barycentric coordinates of the hit
+             *
+             * The hit point is @f$ (1 - u - v)\boldsymbol{a} + u\boldsymbol{b} + v\boldsymbol{c} @f$,
+             * where @f$ \boldsymbol{a} @f$, @f$ \boldsymbol{b} @f$ and
+             * @f$ \boldsymbol{c} @f$ are the triangle vertices in order they
+             * were in the index buffer.
+             */
+            Vector2 barycentric;
+        };
+
+        /**
+         * @brief Construct from a mesh
+         * @param mesh          Input mesh
+         * @param threadCount   How many threads to use for the build. If
+         *      @cpp 0 @ce, @ref std::thread::hardware_concurrency() is
+         *      used.
+         *
+         * Expects that @p mesh is a @ref MeshPrimitive::Triangles with a
+         * @ref Trade::MeshAttribute::Position attribute. If it's not indexed,
+         * each three subsequent vertices are treated as a triangle.
+         */
+        explicit Bvh(const Trade::MeshData& mesh, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Construct from an index and position array
+         * @param indices       Triangle indices
+         * @param positions     Vertex positions
+         * @param threadCount   How many threads to use for the build. If
+         *      @cpp 0 @ce, @ref std::thread::hardware_concurrency() is
+         *      used.
+         *
+         * Expects that the index count is divisible by 3 and all indices are
+         * in bounds for @p positions.
+         */
+        explicit Bvh(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt threadCount = 0);
+
+        /** @brief Copying is not allowed */
+        Bvh(const Bvh&) = delete;
+
+        /** @brief Move constructor */
+        Bvh(Bvh&&) noexcept;
+
+        ~Bvh();
+
+        /** @brief Copying is not allowed */
+        Bvh& operator=(const Bvh&) = delete;
+
+        /** @brief Move assignment */
+        Bvh& operator=(Bvh&&) noexcept;
+
+        /** @brief Triangle count */
+        std::size_t triangleCount() const { return _triangleIds.size(); }
+
+        /**
+         * @brief Hierarchy nodes
+         *
+         * The first node is the root. Empty if the mesh has no triangles.
+         */
+        Containers::ArrayView<const Node> nodes() const { return _nodes; }
+
+        /**
+         * @brief Triangle IDs in leaf order
+         *
+         * Maps triangle indices referenced by leaf @ref Node instances to
+         * triangle indices in the original mesh.
+         */
+        Containers::ArrayView<const UnsignedInt> triangleIds() const { return _triangleIds; }
+
+        /**
+         * @brief Bounds of the whole mesh
+         *
+         * Default-constructed range if the mesh has no triangles.
+         */
+        Range3D bounds() const;
+
+        /**
+         * @brief Find the closest hit along a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction. Doesn't need to be
+         *      normalized.
+         * @param maxDistance   Max hit distance, in multiples of
+         *      @p direction length
+         *
+         * Returns the closest front- or back-facing triangle hit by the ray
+         * with distance in range @f$ [0, d_{max}) @f$ or
+         * @ref Containers::NullOpt if there's none.
+         */
+        Containers::Optional<Hit> closestHit(const Vector3& origin, const Vector3& direction, Float maxDistance = Constants::inf()) const;
+
+        /**
+         * @brief Check if a ray hits anything
+         *
+         * Like @ref closestHit(), but returns as soon as any hit in range
+         * @f$ [0, d_{max}) @f$ is found.
+         */
+        bool anyHit(const Vector3& origin, const Vector3& direction, Float maxDistance = Constants::inf()) const;
+
+        /**
+         * @brief Find closest hits for a batch of rays
+         * @param[in] origins       Ray origins
+         * @param[in] directions    Ray directions
+         * @param[in] maxDistance   Max hit distance, same for all rays
+         * @param[out] hits         Where to put the hits
+         *
+         * Equivalent to calling @ref closestHit() for each ray, but
+         * processes the rays in packets of @ref PacketSize, see
+         * @ref MeshTools-Bvh-queries for details. Rays that didn't hit
+         * anything get @ref Hit::triangle set to @cpp ~UnsignedInt{} @ce.
+         * Expects that all views have the same size.
+         */
+        void closestHits(const Containers::StridedArrayView1D<const Vector3>& origins, const Containers::StridedArrayView1D<const Vector3>& directions, Float maxDistance, const Containers::StridedArrayView1D<Hit>& hits) const;
+
+        /**
+         * @brief Check if a batch of rays hits anything
+         * @param[in] origins       Ray origins
+         * @param[in] directions    Ray directions
+         * @param[in] maxDistance   Max hit distance, same for all rays
+         * @param[out] hits         Where to put the results
+         *
+         * Equivalent to calling @ref anyHit() for each ray, but processes
+         * the rays in packets of @ref PacketSize, see
+         * @ref MeshTools-Bvh-queries for details. Expects that all views
+         * have the same size.
+         */
+        void anyHits(const Containers::StridedArrayView1D<const Vector3>& origins, const Containers::StridedArrayView1D<const Vector3>& directions, Float maxDistance, const Containers::StridedArrayView1D<bool>& hits) const;
+
+        /**
+         * @brief Triangles overlapping a box
+         *
+         * Returns IDs of all triangles that overlap @p range, in no
+         * particular order. Triangles that only touch the box boundary are
+         * included as well.
+         */
+        Containers::Array<UnsignedInt> overlapping(const Range3D& range) const;
+
+    private:
+        Containers::Array<Node> _nodes;
+        Containers::Array<UnsignedInt> _triangleIds;
+        /* Three vertices for each triangle, in leaf order */
+        Containers::Array<Vector3> _vertices;
+};
+
+}}
+
+#endif
@@ -26,9 +26,12 @@
 #include "Compile.h"
 
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Reference.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
@@ -169,6 +172,43 @@ GL::Mesh compileInternal(const Trade::MeshData& meshData, const CompileFlags fla
     }
 
     GL::Buffer vertices{GL::Buffer::TargetHint::Array};
+
+    /* Interleave the vertex data straight into a mapped buffer. If mapping
+       isn't supported or fails, interleave into a temporary array and upload
+       that instead. */
+    if(flags & CompileFlag::ParallelInterleave) {
+        const Trade::MeshData layout = interleavedLayout(meshData, 0);
+        const std::size_t size = layout.attributeCount() ?
+            layout.attributeStride(0)*meshData.vertexCount() : 0;
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        #ifndef MAGNUM_TARGET_GLES
+        if(size && GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        #elif defined(MAGNUM_TARGET_GLES2)
+        if(size && GL::Context::current().isExtensionSupported<GL::Extensions::EXT::map_buffer_range>())
+        #else
+        if(size)
+        #endif
+        {
+            vertices.setData({nullptr, size});
+            const Containers::ArrayView<char> mapped = vertices.map(0, size,
+                GL::Buffer::MapFlag::Write|GL::Buffer::MapFlag::InvalidateBuffer);
+            if(mapped) {
+                const Trade::MeshData interleaved = interleaveInto(meshData, mapped);
+                /* The mapped memory may become corrupted, in which case we
+                   upload everything again below */
+                if(vertices.unmap())
+                    return compileInternal(interleaved, std::move(indices), std::move(vertices), flags & ~CompileFlag::ParallelInterleave);
+            }
+        }
+        #endif
+
+        Containers::Array<char> vertexData{Containers::NoInit, size};
+        const Trade::MeshData interleaved = interleaveInto(meshData, vertexData);
+        vertices.setData(vertexData);
+        return compileInternal(interleaved, std::move(indices), std::move(vertices), flags & ~CompileFlag::ParallelInterleave);
+    }
+
     vertices.setData(meshData.vertexData());
 
     return compileInternal(meshData, std::move(indices), std::move(vertices), flags);
@@ -243,10 +283,44 @@ GL::Mesh compile(const Trade::MeshData& meshData, CompileFlags flags) {
     }
 
     flags &= ~(CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals);
-    CORRADE_INTERNAL_ASSERT(!(flags & ~CompileFlag::NoWarnOnCustomAttributes));
+    CORRADE_INTERNAL_ASSERT(!(flags & ~(CompileFlag::NoWarnOnCustomAttributes|CompileFlag::ParallelInterleave)));
     return compileInternal(meshData, flags);
 }
 
+#ifndef MAGNUM_TARGET_GLES
+Containers::Array<GL::DrawElementsIndirectCommand> compileDrawCommands(const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes) {
+    CORRADE_ASSERT(!meshes.empty(),
+        "MeshTools::compileDrawCommands(): no meshes passed", {});
+
+    Containers::Array<GL::DrawElementsIndirectCommand> out{Containers::NoInit, meshes.size()};
+    UnsignedInt indexOffset = 0;
+    bool indexed = false;
+    for(std::size_t i = 0; i != meshes.size(); ++i) {
+        const Trade::MeshData& mesh = meshes[i];
+        /* Non-indexed meshes get a trivial index buffer in concatenate(), so
+           the vertex count is the index count */
+        const UnsignedInt count = mesh.isIndexed() ? mesh.indexCount() : mesh.vertexCount();
+        if(mesh.isIndexed()) indexed = true;
+
+        out[i].count = count;
+        out[i].instanceCount = 1;
+        out[i].firstIndex = indexOffset;
+        out[i].baseVertex = 0;
+        out[i].baseInstance = i;
+        indexOffset += count;
+    }
+
+    CORRADE_ASSERT(indexed,
+        "MeshTools::compileDrawCommands(): expected at least one indexed mesh", {});
+
+    return out;
+}
+
+Containers::Array<GL::DrawElementsIndirectCommand> compileDrawCommands(const std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes) {
+    return compileDrawCommands(Containers::arrayView(meshes));
+}
+#endif
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 CORRADE_IGNORE_DEPRECATED_PUSH
 GL::Mesh compile(const Trade::MeshData2D& meshData) {
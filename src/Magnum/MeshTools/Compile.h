@@ -26,12 +26,13 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compile()
+ * @brief Function @ref Magnum::MeshTools::compile(), @ref Magnum::MeshTools::compileDrawCommands()
  */
 
 #include "Magnum/configure.h"
 
 #ifdef MAGNUM_TARGET_GL
+#include <initializer_list>
 #include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
@@ -39,6 +40,12 @@
 #include "Magnum/Trade/Trade.h"
 #include "Magnum/MeshTools/visibility.h"
 
+#ifndef MAGNUM_TARGET_GLES
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/GL/DrawIndirectCommand.h"
+#endif
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 #include <Corrade/Utility/Macros.h>
 #endif
@@ -81,7 +88,21 @@ enum class CompileFlag: UnsignedByte {
      * this flag to suppress the warning messages.
      * @m_since{2020,06}
      */
-    NoWarnOnCustomAttributes = 1 << 2
+    NoWarnOnCustomAttributes = 1 << 2,
+
+    /**
+     * Interleave the vertex data directly into a mapped vertex buffer using
+     * @ref interleaveInto() with all available hardware threads, instead of
+     * uploading the vertex data in their original layout. Compared to calling
+     * @ref interleave() and then @ref compile(), this avoids a temporary
+     * copy and a second pass over the data, which is significant for meshes
+     * with tens of millions of vertices. If buffer mapping is not available
+     * (such as on WebGL or on OpenGL ES 2.0 without
+     * @gl_extension{EXT,map_buffer_range}) or fails, the data are interleaved
+     * to a temporary array and uploaded from there.
+     * @m_since_latest
+     */
+    ParallelInterleave = 1 << 3
 };
 
 /**
@@ -194,6 +215,47 @@ MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData& meshData, GL::Bu
  */
 MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData& meshData, GL::Buffer&& indices, GL::Buffer&& vertices);
 
+#ifndef MAGNUM_TARGET_GLES
+/**
+@brief Create indirect draw commands for concatenated meshes
+@m_since_latest
+
+Returns one @ref GL::DrawElementsIndirectCommand for each item in @p meshes,
+describing where given mesh ended up in the result of
+@ref concatenate(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>>)
+called on the same list. The @ref GL::DrawElementsIndirectCommand::count is
+index count of given mesh or its vertex count if it's not indexed (matching the
+trivial index buffer @ref concatenate() generates in that case),
+@ref GL::DrawElementsIndirectCommand::firstIndex is the sum of counts of all
+previous meshes, @ref GL::DrawElementsIndirectCommand::instanceCount is
+@cpp 1 @ce and @ref GL::DrawElementsIndirectCommand::baseVertex is
+@cpp 0 @ce, as the concatenated indices are already adjusted for vertex
+offsets. The @ref GL::DrawElementsIndirectCommand::baseInstance is set to the
+mesh index, so per-draw data can be fetched from an instanced vertex attribute
+or by indexing an array with @glsl gl_BaseInstance @ce in the shader. Upload
+the commands to a @ref GL::Buffer and draw all meshes with a single
+@ref GL::AbstractShaderProgram::drawIndirect() call:
+
+@snippet MagnumMeshTools-gl.cpp compileDrawCommands
+
+Expects that @p meshes contains at least one item and that at least one mesh is
+indexed, as otherwise the concatenated mesh isn't indexed either. The commands
+stay valid if the concatenated index buffer gets compressed to a smaller type
+with @ref compressIndices(const Trade::MeshData&, MeshIndexType).
+
+@note This function is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default) and only on desktop
+    OpenGL. See @ref building-features for more information.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<GL::DrawElementsIndirectCommand> compileDrawCommands(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<GL::DrawElementsIndirectCommand> compileDrawCommands(std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes);
+#endif
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /**
 @brief Compile 2D mesh data
@@ -0,0 +1,454 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Encode.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* First byte of the encoded data, the lower four bits are a format version */
+constexpr char IndexHeader = char(0xe0);
+constexpr char VertexHeader = char(0xa0);
+
+constexpr UnsignedInt NoVertex = ~UnsignedInt{};
+
+/* Edge FIFO position 15 in the triangle code means there's no shared edge,
+   vertex code 0 is the next never referenced vertex, 1 to 14 a vertex FIFO
+   position and 15 an explicitly encoded vertex */
+constexpr UnsignedByte NoEdge = 15;
+constexpr UnsignedByte NextVertex = 0;
+constexpr UnsignedByte ExplicitVertex = 15;
+
+/* Vertex codec block and bit-packing group size */
+constexpr std::size_t VertexBlockSize = 256;
+constexpr std::size_t VertexGroupSize = 16;
+
+/* State of the index codec. The encoder updates it the same way as the
+   decoder does, so both always agree on the FIFO contents. */
+struct IndexCodecState {
+    explicit IndexCodecState() {
+        for(std::size_t i = 0; i != 16; ++i) {
+            edges[i][0] = edges[i][1] = NoVertex;
+            vertices[i] = NoVertex;
+        }
+    }
+
+    void pushEdge(const UnsignedInt a, const UnsignedInt b) {
+        edges[edgeOffset][0] = a;
+        edges[edgeOffset][1] = b;
+        edgeOffset = (edgeOffset + 1) & 15;
+    }
+
+    void pushVertex(const UnsignedInt vertex) {
+        vertices[vertexOffset] = vertex;
+        vertexOffset = (vertexOffset + 1) & 15;
+    }
+
+    /* Returns the FIFO position, with 0 being the most recent edge */
+    UnsignedByte findEdge(const UnsignedInt a, const UnsignedInt b) const {
+        for(UnsignedByte i = 0; i != NoEdge; ++i) {
+            const UnsignedInt* const edge = edges[(edgeOffset - 1 - i) & 15];
+            if(edge[0] == a && edge[1] == b) return i;
+        }
+        return NoEdge;
+    }
+
+    UnsignedInt edges[16][2];
+    UnsignedInt vertices[16];
+    std::size_t edgeOffset{}, vertexOffset{};
+    UnsignedInt next{}, last{};
+};
+
+char* writeVarint(char* out, UnsignedInt value) {
+    while(value >= 0x80) {
+        *out++ = char((value & 0x7f)|0x80);
+        value >>= 7;
+    }
+    *out++ = char(value);
+    return out;
+}
+
+inline bool readVarint(const UnsignedByte*& in, const UnsignedByte* const end, UnsignedInt& value) {
+    value = 0;
+    for(UnsignedInt shift = 0; shift < 35; shift += 7) {
+        if(in == end) return false;
+        const UnsignedByte byte = *in++;
+        value |= UnsignedInt(byte & 0x7f) << shift;
+        if(!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+/* Writes the explicit vertex difference to out, if needed */
+UnsignedByte encodeVertex(IndexCodecState& state, const UnsignedInt vertex, char*& out) {
+    if(vertex == state.next) {
+        ++state.next;
+        state.last = vertex;
+        state.pushVertex(vertex);
+        return NextVertex;
+    }
+
+    for(UnsignedByte i = 1; i != ExplicitVertex; ++i)
+        if(state.vertices[(state.vertexOffset - i) & 15] == vertex) return i;
+
+    /* Zigzag encoding so small negative differences are small as well */
+    const Int difference = Int(vertex - state.last);
+    out = writeVarint(out, (UnsignedInt(difference) << 1)^UnsignedInt(difference >> 31));
+    state.last = vertex;
+    state.pushVertex(vertex);
+    return ExplicitVertex;
+}
+
+inline bool decodeVertex(IndexCodecState& state, const UnsignedByte code, const UnsignedByte*& in, const UnsignedByte* const end, UnsignedInt& vertex) {
+    if(code == NextVertex) {
+        vertex = state.next++;
+    } else if(code != ExplicitVertex) {
+        vertex = state.vertices[(state.vertexOffset - code) & 15];
+        return true;
+    } else {
+        UnsignedInt difference;
+        if(!readVarint(in, end, difference)) return false;
+        vertex = state.last + ((difference >> 1)^(0u - (difference & 1)));
+    }
+
+    state.last = vertex;
+    state.pushVertex(vertex);
+    return true;
+}
+
+inline UnsignedByte zigzag(const UnsignedByte difference) {
+    return UnsignedByte(difference << 1)^UnsignedByte(Byte(difference) >> 7);
+}
+
+inline UnsignedByte unzigzag(const UnsignedByte value) {
+    return UnsignedByte((value >> 1)^-(value & 1));
+}
+
+}
+
+Containers::Array<char> encodeTriangleIndices(const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::encodeTriangleIndices(): expected index count divisible by 3, got" << indices.size(), {});
+
+    /* The header byte, then one code byte for each triangle, then
+       variable-length data */
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<char> out;
+    arrayReserve(out, 1 + triangleCount*2);
+    arrayResize(out, Containers::NoInit, 1 + triangleCount);
+    out[0] = IndexHeader;
+
+    IndexCodecState state;
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        const UnsignedInt triangle[]{indices[i*3 + 0], indices[i*3 + 1], indices[i*3 + 2]};
+
+        /* At most an extra code byte and three varints */
+        char data[16];
+        char* dataEnd = data;
+        UnsignedByte code;
+
+        /* Find a rotation of the triangle which has the first edge in the
+           FIFO */
+        UnsignedByte edge = NoEdge;
+        std::size_t rotation = 0;
+        for(; rotation != 3; ++rotation)
+            if((edge = state.findEdge(triangle[rotation], triangle[(rotation + 1) % 3])) != NoEdge) break;
+
+        if(edge != NoEdge) {
+            const UnsignedInt a = triangle[rotation];
+            const UnsignedInt b = triangle[(rotation + 1) % 3];
+            const UnsignedInt c = triangle[(rotation + 2) % 3];
+            code = UnsignedByte(edge << 4|encodeVertex(state, c, dataEnd));
+
+            /* The shared edge won't be shared again, push just the two new
+               ones, reversed, as that's how the neighbors will see them */
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+
+        } else {
+            const UnsignedInt a = triangle[0];
+            const UnsignedInt b = triangle[1];
+            const UnsignedInt c = triangle[2];
+            code = UnsignedByte(NoEdge << 4|encodeVertex(state, a, dataEnd));
+
+            /* Codes of the other two vertices are in an extra byte that
+               precedes their data */
+            char* const extra = dataEnd++;
+            const UnsignedByte codeB = encodeVertex(state, b, dataEnd);
+            const UnsignedByte codeC = encodeVertex(state, c, dataEnd);
+            *extra = char(codeB << 4|codeC);
+
+            state.pushEdge(b, a);
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+        }
+
+        out[1 + i] = char(code);
+        arrayAppend(out, Containers::ArrayView<const char>{data, std::size_t(dataEnd - data)});
+    }
+
+    /* Convert back to a default deleter so the data can be passed to
+       plugins */
+    arrayShrink(out, Containers::DefaultInit);
+    return out;
+}
+
+bool decodeTriangleIndicesInto(const Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::decodeTriangleIndicesInto(): expected index count divisible by 3, got" << indices.size(), {});
+
+    if(data.empty() || data[0] != IndexHeader) {
+        Error{} << "MeshTools::decodeTriangleIndicesInto(): invalid header";
+        return false;
+    }
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(data.size() < 1 + triangleCount) {
+        Error{} << "MeshTools::decodeTriangleIndicesInto(): expected at least" << 1 + triangleCount << "bytes for" << triangleCount << "triangles but got" << data.size();
+        return false;
+    }
+
+    const UnsignedByte* const codes = reinterpret_cast<const UnsignedByte*>(data.data()) + 1;
+    const UnsignedByte* in = codes + triangleCount;
+    const UnsignedByte* const end = reinterpret_cast<const UnsignedByte*>(data.end());
+
+    IndexCodecState state;
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        const UnsignedByte code = codes[i];
+        const UnsignedByte edge = code >> 4;
+        UnsignedInt a, b, c;
+
+        if(edge != NoEdge) {
+            const UnsignedInt* const shared = state.edges[(state.edgeOffset - 1 - edge) & 15];
+            a = shared[0];
+            b = shared[1];
+            if(!decodeVertex(state, code & 15, in, end, c)) {
+                Error{} << "MeshTools::decodeTriangleIndicesInto(): unexpected end of data";
+                return false;
+            }
+
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+
+        } else {
+            if(!decodeVertex(state, code & 15, in, end, a) || in == end) {
+                Error{} << "MeshTools::decodeTriangleIndicesInto(): unexpected end of data";
+                return false;
+            }
+
+            const UnsignedByte extra = *in++;
+            if(!decodeVertex(state, extra >> 4, in, end, b) ||
+               !decodeVertex(state, extra & 15, in, end, c)) {
+                Error{} << "MeshTools::decodeTriangleIndicesInto(): unexpected end of data";
+                return false;
+            }
+
+            state.pushEdge(b, a);
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+        }
+
+        indices[i*3 + 0] = a;
+        indices[i*3 + 1] = b;
+        indices[i*3 + 2] = c;
+    }
+
+    if(in != end) {
+        Error{} << "MeshTools::decodeTriangleIndicesInto(): expected" << in - reinterpret_cast<const UnsignedByte*>(data.data()) << "bytes for" << triangleCount << "triangles but got" << data.size();
+        return false;
+    }
+
+    return true;
+}
+
+Containers::Array<char> encodeVertices(const Containers::StridedArrayView2D<const char>& vertices) {
+    CORRADE_ASSERT(vertices.isContiguous<1>(),
+        "MeshTools::encodeVertices(): second view dimension is not contiguous", {});
+
+    const std::size_t vertexCount = vertices.size()[0];
+    const std::size_t vertexSize = vertices.size()[1];
+    const char* const vertexData = static_cast<const char*>(vertices.data());
+    const std::ptrdiff_t stride = vertices.stride()[0];
+
+    Containers::Array<char> out;
+    arrayAppend(out, VertexHeader);
+
+    /* Last vertex of the previous block, differences in the first block are
+       to zero */
+    Containers::Array<UnsignedByte> previous{Containers::ValueInit, vertexSize};
+    UnsignedByte values[VertexBlockSize];
+    for(std::size_t blockBegin = 0; blockBegin < vertexCount; blockBegin += VertexBlockSize) {
+        const std::size_t blockSize = Math::min(VertexBlockSize, vertexCount - blockBegin);
+        const std::size_t groupCount = (blockSize + VertexGroupSize - 1)/VertexGroupSize;
+
+        for(std::size_t byte = 0; byte != vertexSize; ++byte) {
+            /* Differences of given byte for all vertices in the block,
+               padded with zeros to whole groups */
+            const char* const in = vertexData + std::ptrdiff_t(blockBegin)*stride + byte;
+            UnsignedByte last = previous[byte];
+            for(std::size_t i = 0; i != blockSize; ++i) {
+                const UnsignedByte value = in[std::ptrdiff_t(i)*stride];
+                values[i] = zigzag(value - last);
+                last = value;
+            }
+            previous[byte] = last;
+            for(std::size_t i = blockSize; i != groupCount*VertexGroupSize; ++i)
+                values[i] = 0;
+
+            /* Bit widths of all groups, four in a byte, followed by the
+               packed groups */
+            const std::size_t widthOffset = out.size();
+            arrayResize(out, widthOffset + (groupCount + 3)/4);
+            for(std::size_t group = 0; group != groupCount; ++group) {
+                const UnsignedByte* const groupValues = values + group*VertexGroupSize;
+                UnsignedByte bits = 0;
+                for(std::size_t i = 0; i != VertexGroupSize; ++i)
+                    bits |= groupValues[i];
+
+                char packed[VertexGroupSize];
+                std::size_t packedSize;
+                UnsignedByte width;
+                if(bits == 0) {
+                    width = 0;
+                    packedSize = 0;
+                } else if(bits < 4) {
+                    width = 1;
+                    packedSize = VertexGroupSize/4;
+                    for(std::size_t i = 0; i != packedSize; ++i)
+                        packed[i] = char(groupValues[i*4 + 0] << 0|
+                                         groupValues[i*4 + 1] << 2|
+                                         groupValues[i*4 + 2] << 4|
+                                         groupValues[i*4 + 3] << 6);
+                } else if(bits < 16) {
+                    width = 2;
+                    packedSize = VertexGroupSize/2;
+                    for(std::size_t i = 0; i != packedSize; ++i)
+                        packed[i] = char(groupValues[i*2 + 0] << 0|
+                                         groupValues[i*2 + 1] << 4);
+                } else {
+                    width = 3;
+                    packedSize = VertexGroupSize;
+                    for(std::size_t i = 0; i != packedSize; ++i)
+                        packed[i] = char(groupValues[i]);
+                }
+
+                out[widthOffset + group/4] |= char(width << (group % 4)*2);
+                arrayAppend(out, Containers::ArrayView<const char>{packed, packedSize});
+            }
+        }
+    }
+
+    /* Convert back to a default deleter so the data can be passed to
+       plugins */
+    arrayShrink(out, Containers::DefaultInit);
+    return out;
+}
+
+bool decodeVerticesInto(const Containers::ArrayView<const char> data, const Containers::StridedArrayView2D<char>& vertices) {
+    CORRADE_ASSERT(vertices.isContiguous<1>(),
+        "MeshTools::decodeVerticesInto(): second view dimension is not contiguous", {});
+
+    if(data.empty() || data[0] != VertexHeader) {
+        Error{} << "MeshTools::decodeVerticesInto(): invalid header";
+        return false;
+    }
+
+    const std::size_t vertexCount = vertices.size()[0];
+    const std::size_t vertexSize = vertices.size()[1];
+    char* const vertexData = static_cast<char*>(vertices.data());
+    const std::ptrdiff_t stride = vertices.stride()[0];
+
+    const UnsignedByte* in = reinterpret_cast<const UnsignedByte*>(data.data()) + 1;
+    const UnsignedByte* const end = reinterpret_cast<const UnsignedByte*>(data.end());
+
+    Containers::Array<UnsignedByte> previous{Containers::ValueInit, vertexSize};
+    UnsignedByte values[VertexBlockSize];
+    for(std::size_t blockBegin = 0; blockBegin < vertexCount; blockBegin += VertexBlockSize) {
+        const std::size_t blockSize = Math::min(VertexBlockSize, vertexCount - blockBegin);
+        const std::size_t groupCount = (blockSize + VertexGroupSize - 1)/VertexGroupSize;
+
+        for(std::size_t byte = 0; byte != vertexSize; ++byte) {
+            const std::size_t widthSize = (groupCount + 3)/4;
+            if(std::size_t(end - in) < widthSize) {
+                Error{} << "MeshTools::decodeVerticesInto(): unexpected end of data";
+                return false;
+            }
+            const UnsignedByte* const widths = in;
+            in += widthSize;
+
+            /* Unpack all groups */
+            for(std::size_t group = 0; group != groupCount; ++group) {
+                UnsignedByte* const groupValues = values + group*VertexGroupSize;
+                const UnsignedByte width = (widths[group/4] >> (group % 4)*2) & 3;
+                const std::size_t packedSize = width ? VertexGroupSize >> (3 - width) : 0;
+                if(std::size_t(end - in) < packedSize) {
+                    Error{} << "MeshTools::decodeVerticesInto(): unexpected end of data";
+                    return false;
+                }
+
+                if(width == 0) {
+                    for(std::size_t i = 0; i != VertexGroupSize; ++i)
+                        groupValues[i] = 0;
+                } else if(width == 1) {
+                    for(std::size_t i = 0; i != VertexGroupSize; ++i)
+                        groupValues[i] = (in[i/4] >> (i % 4)*2) & 0x03;
+                } else if(width == 2) {
+                    for(std::size_t i = 0; i != VertexGroupSize; ++i)
+                        groupValues[i] = (in[i/2] >> (i % 2)*4) & 0x0f;
+                } else {
+                    for(std::size_t i = 0; i != VertexGroupSize; ++i)
+                        groupValues[i] = in[i];
+                }
+
+                in += packedSize;
+            }
+
+            /* Undo the differences */
+            char* const out = vertexData + std::ptrdiff_t(blockBegin)*stride + byte;
+            UnsignedByte last = previous[byte];
+            for(std::size_t i = 0; i != blockSize; ++i) {
+                last += unzigzag(values[i]);
+                out[std::ptrdiff_t(i)*stride] = char(last);
+            }
+            previous[byte] = last;
+        }
+    }
+
+    if(in != end) {
+        Error{} << "MeshTools::decodeVerticesInto(): expected" << in - reinterpret_cast<const UnsignedByte*>(data.data()) << "bytes for" << vertexCount << "vertices of" << vertexSize << "bytes but got" << data.size();
+        return false;
+    }
+
+    return true;
+}
+
+}}
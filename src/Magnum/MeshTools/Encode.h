@@ -0,0 +1,115 @@
+#ifndef Magnum_MeshTools_Encode_h
+#define Magnum_MeshTools_Encode_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::encodeTriangleIndices(), @ref Magnum::MeshTools::decodeTriangleIndicesInto(), @ref Magnum::MeshTools::encodeVertices(), @ref Magnum::MeshTools::decodeVerticesInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Encode a triangle index buffer
+@m_since_latest
+
+Unlike @ref compressIndices(), which only picks the smallest index type,
+this reduces the actual entropy of the data, so the result is considerably
+smaller and compresses further with general-purpose compressors. Expects
+that the index count is divisible by 3. Decode the data with
+@ref decodeTriangleIndicesInto().
+
+Each triangle is described by a single code byte. The encoder keeps a FIFO of
+16 recently seen edges and 16 recently seen vertices. If the triangle shares
+an edge with one of the previous triangles, the code contains a FIFO position
+of the edge and a code for the remaining vertex. Otherwise the code and an
+extra byte contain codes for all three vertices. A vertex is encoded either as
+being the next vertex never referenced before, as a position in the vertex
+FIFO, or, if neither applies, as a variable-length difference to the last
+explicitly encoded vertex. In vertex-cache-optimized meshes (see
+@ref tipsifyInPlace()) whose vertices are ordered by their first reference,
+most triangles encode to a single byte.
+
+To make better use of the edge FIFO, vertices of a triangle may get rotated
+--- the decoded triangle @f$ (b, c, a) @f$ is the same as the encoded
+@f$ (a, b, c) @f$, with the winding preserved.
+@see @ref encodeVertices()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeTriangleIndices(const Containers::StridedArrayView1D<const UnsignedInt>& indices);
+
+/**
+@brief Decode a triangle index buffer
+@m_since_latest
+
+Decodes data produced by @ref encodeTriangleIndices() into @p indices.
+Expects that the index count is divisible by 3. If @p data is not a valid
+encoded index buffer or doesn't match the @p indices size, prints a message
+to @ref Error and returns @cpp false @ce, which makes it
+suitable for untrusted input. The decoded indices aren't checked against any
+vertex count.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeTriangleIndicesInto(Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+
+/**
+@brief Encode a vertex buffer
+@m_since_latest
+
+Expects a 2D view where the first dimension is vertices and the second is
+bytes of each vertex, contiguous. Use for example
+@ref interleavedData() to get such view from a @ref Trade::MeshData.
+
+The vertices are processed in blocks of 256. In each block, every byte of a
+vertex is replaced with its difference from the same byte of the previous
+vertex and the differences are transposed so all differences for a
+particular byte are next to each other. Attributes that change smoothly
+between neighboring vertices thus result in long runs of small numbers,
+which get bit-packed in groups of 16 to 0, 2, 4 or 8 bits. Ordering the
+vertices spatially, for example using @ref reorderSpatially(), makes the
+output considerably smaller. Decode the data with @ref decodeVerticesInto().
+@see @ref encodeTriangleIndices()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeVertices(const Containers::StridedArrayView2D<const char>& vertices);
+
+/**
+@brief Decode a vertex buffer
+@m_since_latest
+
+Decodes data produced by @ref encodeVertices() into @p vertices. Expects that
+the second dimension of @p vertices is contiguous. If @p data is not a valid
+encoded vertex buffer or doesn't match the @p vertices size, prints a message
+to @ref Error and returns @cpp false @ce, which makes it
+suitable for untrusted input.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeVerticesInto(Containers::ArrayView<const char> data, const Containers::StridedArrayView2D<char>& vertices);
+
+}}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef Magnum_MeshTools_Implementation_Parallel_h
+#define Magnum_MeshTools_Implementation_Parallel_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <thread>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation { namespace {
+
+/* Clamps the thread count so each thread gets at least minItemsPerThread
+   items. Spawning a thread isn't free, so it's not worth it for small data.
+   Zero means all hardware threads, threading is disabled altogether on
+   Emscripten without pthreads. */
+UnsignedInt parallelThreadCount(UnsignedInt threadCount, const std::size_t itemCount, const std::size_t minItemsPerThread) {
+    #if defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+    static_cast<void>(threadCount);
+    static_cast<void>(itemCount);
+    static_cast<void>(minItemsPerThread);
+    return 1;
+    #else
+    if(!threadCount)
+        threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+    return Math::min(threadCount, UnsignedInt(Math::max(itemCount/minItemsPerThread, std::size_t{1})));
+    #endif
+}
+
+/* Splits itemCount items into threadCount contiguous ranges and calls
+   f(thread, begin, end) for each, with the first range processed on the
+   calling thread. Returns after all ranges are done. The split is
+   deterministic, so two subsequent calls with the same counts get the same
+   ranges for the same thread ID. */
+template<class F> void parallelFor(const UnsignedInt threadCount, const std::size_t itemCount, const F& f) {
+    const std::size_t itemsPerThread = (itemCount + threadCount - 1)/threadCount;
+    Containers::Array<std::thread> threads{threadCount - 1};
+    for(UnsignedInt i = 1; i < threadCount; ++i) {
+        const std::size_t begin = Math::min(i*itemsPerThread, itemCount);
+        threads[i - 1] = std::thread{[&f](UnsignedInt thread, std::size_t begin, std::size_t end) {
+            f(thread, begin, end);
+        }, i, begin, Math::min(begin + itemsPerThread, itemCount)};
+    }
+    f(0, 0, Math::min(itemsPerThread, itemCount));
+    for(std::thread& thread: threads) thread.join();
+}
+
+}}}}
+
+#endif
@@ -29,6 +29,7 @@
 #include <Corrade/Utility/Algorithms.h>
 
 #include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/Implementation/Parallel.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace MeshTools {
@@ -337,4 +338,57 @@ Trade::MeshData interleave(const Trade::MeshData& data, const std::initializer_l
     return interleave(std::move(data), Containers::arrayView(extra));
 }
 
+namespace {
+
+/* Spawning a thread costs about as much as copying a few hundred kB, so give
+   each thread at least this much to make it worth it */
+constexpr std::size_t InterleaveMinBytesPerThread = 1024*1024;
+
+}
+
+Trade::MeshData interleaveInto(const Trade::MeshData& data, const Containers::ArrayView<char> destination, UnsignedInt threadCount) {
+    const UnsignedInt vertexCount = data.vertexCount();
+    Containers::Array<Trade::MeshAttributeData> attributeData = Implementation::interleavedLayout(
+        Trade::MeshData{data.primitive(), {}, data.vertexData(),
+            Trade::meshAttributeDataNonOwningArray(data.attributeData()),
+            vertexCount}, {});
+
+    const std::size_t stride = attributeData ? attributeData[0].stride() : 0;
+    const std::size_t size = stride*vertexCount;
+    CORRADE_ASSERT(destination.size() >= size,
+        "MeshTools::interleaveInto(): the data buffer is too small, expected" << size << "but got" << destination.size(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Convert the attributes from offset-only to absolute, referencing the
+       destination */
+    for(Trade::MeshAttributeData& attribute: attributeData) {
+        attribute = Trade::MeshAttributeData{
+            attribute.name(), attribute.format(),
+            Containers::StridedArrayView1D<void>{destination,
+                destination + attribute.offset(destination),
+                vertexCount, attribute.stride()},
+            attribute.arraySize()};
+    }
+
+    /* If the mesh is not indexed, the reference will be also non-indexed */
+    Trade::MeshData layout{data.primitive(),
+        {}, data.indexData(), Trade::MeshIndexData{data.indices()},
+        Trade::DataFlag::Mutable, destination.prefix(size),
+        std::move(attributeData), vertexCount};
+
+    /* Each thread copies all attributes for a contiguous range of vertices,
+       which means every thread writes to a contiguous range of the
+       destination and no cache line is shared by more than two threads */
+    const std::size_t minVerticesPerThread = Math::max(InterleaveMinBytesPerThread/Math::max(stride, std::size_t{1}), std::size_t{1});
+    Implementation::parallelFor(
+        Implementation::parallelThreadCount(threadCount, vertexCount, minVerticesPerThread),
+        vertexCount, [&](UnsignedInt, std::size_t begin, std::size_t end) {
+            for(UnsignedInt i = 0; i != data.attributeCount(); ++i)
+                Utility::copy(data.attribute(i).slice(begin, end),
+                    layout.mutableAttribute(i).slice(begin, end));
+        });
+
+    return layout;
+}
+
 }}
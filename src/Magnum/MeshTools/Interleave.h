@@ -330,6 +330,37 @@ MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(Trade::MeshData&& data, Conta
  */
 MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(Trade::MeshData&& data, std::initializer_list<Trade::MeshAttributeData> extra);
 
+/**
+@brief Interleave mesh data into a caller-provided buffer
+@param data         Input mesh
+@param destination  Destination buffer
+@param threadCount  How many threads to use. If @cpp 0 @ce,
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Like @ref interleave(const Trade::MeshData&, Containers::ArrayView<const Trade::MeshAttributeData>),
+but instead of allocating a new vertex buffer, the attributes are copied
+directly to @p destination, which can be for example a mapped
+@ref GL::Buffer range. That avoids an extra copy when uploading large meshes,
+@ref compile() uses this function when
+@ref CompileFlag::ParallelInterleave is set.
+
+The layout is the same as calculated by @ref interleavedLayout(), expects
+that @p destination is at least as large as
+@ref Trade::MeshData::vertexCount() multiplied by the resulting stride. The
+copy is split into contiguous vertex ranges that are processed in parallel by
+up to @p threadCount threads, however each thread gets at least about a
+megabyte of data so small meshes are processed on the calling thread only.
+On Emscripten builds without threading support, everything is always done
+on the calling thread.
+
+The returned instance references @p destination as
+@ref Trade::DataFlag::Mutable vertex data and the index data of @p data, if
+any, so it's valid only as long as both are.
+@see @ref isInterleaved(), @ref Trade::MeshData::attributeStride()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleaveInto(const Trade::MeshData& data, Containers::ArrayView<char> destination, UnsignedInt threadCount = 0);
+
 }}
 
 #endif
@@ -0,0 +1,247 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Quantize.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Max error of a value packed to a normalized type, which is half of the
+   quantization step. Signed types represent the [-1, 1] range, unsigned
+   the [0, 1] range. */
+constexpr Float ByteError = 0.5f/127.0f;
+constexpr Float ShortError = 0.5f/32767.0f;
+constexpr Float UnsignedByteError = 0.5f/255.0f;
+constexpr Float UnsignedShortError = 0.5f/65535.0f;
+
+enum class Quantization: UnsignedByte {
+    None, Position, Vector, TextureCoordinates
+};
+
+/* Packs all components of the input into an attribute of a format picked by
+   quantize() */
+void packAttribute(const Containers::StridedArrayView2D<const Float>& in, Trade::MeshData& out, const UnsignedInt id) {
+    switch(out.attributeFormat(id)) {
+        case VertexFormat::Vector2ubNormalized:
+            Math::packInto(in, Containers::arrayCast<2, UnsignedByte>(out.mutableAttribute<Vector2ub>(id)));
+            return;
+        case VertexFormat::Vector2usNormalized:
+            Math::packInto(in, Containers::arrayCast<2, UnsignedShort>(out.mutableAttribute<Vector2us>(id)));
+            return;
+        case VertexFormat::Vector3bNormalized:
+            Math::packInto(in, Containers::arrayCast<2, Byte>(out.mutableAttribute<Vector3b>(id)));
+            return;
+        case VertexFormat::Vector3sNormalized:
+            Math::packInto(in, Containers::arrayCast<2, Short>(out.mutableAttribute<Vector3s>(id)));
+            return;
+        case VertexFormat::Vector4bNormalized:
+            Math::packInto(in, Containers::arrayCast<2, Byte>(out.mutableAttribute<Vector4b>(id)));
+            return;
+        case VertexFormat::Vector4sNormalized:
+            Math::packInto(in, Containers::arrayCast<2, Short>(out.mutableAttribute<Vector4s>(id)));
+            return;
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+}
+
+std::tuple<Trade::MeshData, Matrix4, Matrix3> quantize(const Trade::MeshData& data, const Float positionError, const Float normalError, const Float textureCoordinateError) {
+    const UnsignedInt vertexCount = data.vertexCount();
+
+    /* Pick output format of each attribute and calculate the transformations
+       needed to get the data into the range of the normalized formats */
+    Containers::Array<VertexFormat> formats{Containers::NoInit, data.attributeCount()};
+    Containers::Array<Quantization> quantizations{Containers::ValueInit, data.attributeCount()};
+    bool positionsFound = false, textureCoordinatesFound = false;
+    Vector3 positionCenter;
+    Float positionScale = 1.0f;
+    Vector2 textureCoordinateOffset;
+    Vector2 textureCoordinateScale{1.0f};
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        const Trade::MeshAttribute name = data.attributeName(i);
+        const VertexFormat format = data.attributeFormat(i);
+        CORRADE_ASSERT(!isVertexFormatImplementationSpecific(format),
+            "MeshTools::quantize(): attribute" << i << "has an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(format)),
+            (std::make_tuple(Trade::MeshData{MeshPrimitive::Points, 0}, Matrix4{}, Matrix3{})));
+        formats[i] = format;
+
+        /* There's just one dequantization transformation for positions, so
+           only the first position attribute can be quantized */
+        if(name == Trade::MeshAttribute::Position) {
+            const bool first = !positionsFound;
+            positionsFound = true;
+            if(!first || format != VertexFormat::Vector3) continue;
+
+            /* Scale the bounding box uniformly to the [-1, 1] range, which
+               means the relative error is half of the normalized error. An
+               empty range gives back zeros, which is fine. */
+            if(positionError >= ByteError*0.5f)
+                formats[i] = VertexFormat::Vector3bNormalized;
+            else if(positionError >= ShortError*0.5f)
+                formats[i] = VertexFormat::Vector3sNormalized;
+            else continue;
+
+            const std::pair<Vector3, Vector3> minmax = Math::minmax(data.attribute<Vector3>(i));
+            positionCenter = (minmax.first + minmax.second)*0.5f;
+            const Float halfExtent = (minmax.second - minmax.first).max()*0.5f;
+            if(halfExtent != 0.0f) positionScale = halfExtent;
+            quantizations[i] = Quantization::Position;
+
+        /* Unit vectors are in the [-1, 1] range already */
+        } else if((name == Trade::MeshAttribute::Normal ||
+                   name == Trade::MeshAttribute::Tangent ||
+                   name == Trade::MeshAttribute::Bitangent) &&
+                  (format == VertexFormat::Vector3 ||
+                   format == VertexFormat::Vector4)) {
+            const bool four = format == VertexFormat::Vector4;
+            if(normalError >= ByteError)
+                formats[i] = four ? VertexFormat::Vector4bNormalized : VertexFormat::Vector3bNormalized;
+            else if(normalError >= ShortError)
+                formats[i] = four ? VertexFormat::Vector4sNormalized : VertexFormat::Vector3sNormalized;
+            else continue;
+
+            quantizations[i] = Quantization::Vector;
+
+        /* Similarly to positions, there's just one texture transformation */
+        } else if(name == Trade::MeshAttribute::TextureCoordinates) {
+            const bool first = !textureCoordinatesFound;
+            textureCoordinatesFound = true;
+            if(!first || format != VertexFormat::Vector2) continue;
+
+            /* If the coordinates are outside of the [0, 1] range, scale their
+               bounding box to it, which scales the error as well */
+            const std::pair<Vector2, Vector2> minmax = Math::minmax(data.attribute<Vector2>(i));
+            Vector2 offset;
+            Vector2 scale{1.0f};
+            if(minmax.first.min() < 0.0f || minmax.second.max() > 1.0f) {
+                offset = minmax.first;
+                scale = minmax.second - minmax.first;
+                for(std::size_t j = 0; j != 2; ++j)
+                    if(scale[j] == 0.0f) scale[j] = 1.0f;
+            }
+
+            if(textureCoordinateError >= UnsignedByteError*scale.max())
+                formats[i] = VertexFormat::Vector2ubNormalized;
+            else if(textureCoordinateError >= UnsignedShortError*scale.max())
+                formats[i] = VertexFormat::Vector2usNormalized;
+            else continue;
+
+            textureCoordinateOffset = offset;
+            textureCoordinateScale = scale;
+            quantizations[i] = Quantization::TextureCoordinates;
+        }
+    }
+
+    /* Interleave the output, with each attribute padded to four bytes to
+       keep all attributes aligned */
+    Containers::Array<std::size_t> offsets{Containers::NoInit, data.attributeCount()};
+    std::size_t stride = 0;
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        offsets[i] = stride;
+        const UnsignedShort arraySize = data.attributeArraySize(i);
+        stride += (vertexFormatSize(formats[i])*(arraySize ? arraySize : 1) + 3) & ~std::size_t{3};
+    }
+
+    /* Zero-initialized so the padding doesn't contain random memory */
+    Containers::Array<char> vertexData{Containers::ValueInit, stride*vertexCount};
+    Containers::Array<Trade::MeshAttributeData> attributeData{data.attributeCount()};
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        attributeData[i] = Trade::MeshAttributeData{
+            data.attributeName(i), formats[i],
+            Containers::StridedArrayView1D<const void>{
+                vertexData,
+                vertexData.data() + offsets[i],
+                vertexCount, std::ptrdiff_t(stride)},
+            data.attributeArraySize(i)};
+    }
+
+    /* Copy the index data, if the mesh is indexed */
+    Containers::Array<char> indexData;
+    Trade::MeshIndexData indices;
+    if(data.isIndexed()) {
+        indexData = Containers::Array<char>{Containers::NoInit, data.indexData().size()};
+        indices = Trade::MeshIndexData{data.indexType(), indexData.slice(data.indexOffset(), data.indexOffset() + data.indexCount()*meshIndexTypeSize(data.indexType()))};
+        Utility::copy(data.indexData(), indexData);
+    }
+
+    Trade::MeshData out{data.primitive(),
+        std::move(indexData), indices,
+        std::move(vertexData), std::move(attributeData),
+        vertexCount};
+
+    /* Fill the attributes */
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        switch(quantizations[i]) {
+            case Quantization::None:
+                Utility::copy(data.attribute(i), out.mutableAttribute(i));
+                break;
+
+            /* Clamping to guard against values slightly outside of the range
+               due to floating-point rounding */
+            case Quantization::Position: {
+                const Containers::StridedArrayView1D<const Vector3> in = data.attribute<Vector3>(i);
+                Containers::Array<Vector3> positions{Containers::NoInit, vertexCount};
+                const Float inverseScale = 1.0f/positionScale;
+                for(std::size_t j = 0; j != vertexCount; ++j)
+                    positions[j] = Math::clamp((in[j] - positionCenter)*inverseScale, -1.0f, 1.0f);
+                packAttribute(Containers::arrayCast<2, Float>(Containers::stridedArrayView(positions)), out, i);
+            } break;
+
+            case Quantization::Vector:
+                if(data.attributeFormat(i) == VertexFormat::Vector4)
+                    packAttribute(Containers::arrayCast<2, const Float>(data.attribute<Vector4>(i)), out, i);
+                else
+                    packAttribute(Containers::arrayCast<2, const Float>(data.attribute<Vector3>(i)), out, i);
+                break;
+
+            case Quantization::TextureCoordinates: {
+                const Containers::StridedArrayView1D<const Vector2> in = data.attribute<Vector2>(i);
+                Containers::Array<Vector2> textureCoordinates{Containers::NoInit, vertexCount};
+                const Vector2 inverseScale = 1.0f/textureCoordinateScale;
+                for(std::size_t j = 0; j != vertexCount; ++j)
+                    textureCoordinates[j] = Math::clamp((in[j] - textureCoordinateOffset)*inverseScale, 0.0f, 1.0f);
+                packAttribute(Containers::arrayCast<2, Float>(Containers::stridedArrayView(textureCoordinates)), out, i);
+            } break;
+        }
+    }
+
+    return std::make_tuple(std::move(out),
+        Matrix4::translation(positionCenter)*Matrix4::scaling(Vector3{positionScale}),
+        Matrix3::translation(textureCoordinateOffset)*Matrix3::scaling(textureCoordinateScale));
+}
+
+}}
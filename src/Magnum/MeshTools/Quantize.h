@@ -0,0 +1,105 @@
+#ifndef Magnum_MeshTools_Quantize_h
+#define Magnum_MeshTools_Quantize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::quantize()
+ * @m_since_latest
+ */
+
+#include <tuple>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Quantize mesh vertex attributes
+@param data                     Input mesh
+@param positionError            Max position error, relative to the largest
+    side of the position bounding box
+@param normalError              Max error of a normal, tangent or bitangent
+    component
+@param textureCoordinateError   Max texture coordinate error
+@return Quantized mesh, position dequantization transformation and texture
+    coordinate transformation
+@m_since_latest
+
+For each attribute picks the smallest normalized format that represents the
+data within given error bound and packs the data using @ref Math::packInto().
+If even a 16-bit format isn't precise enough, the attribute is kept in its
+original format. The maximal error introduced by the quantization is half of
+the quantization step:
+
+-   The first @ref Trade::MeshAttribute::Position in @ref VertexFormat::Vector3
+    is scaled uniformly to the @f$ [-1, 1] @f$ range around its bounding box
+    center and stored as @ref VertexFormat::Vector3bNormalized, with an error
+    of @f$ \frac{1}{508} @f$ of the largest bounding box side, or as
+    @ref VertexFormat::Vector3sNormalized, with an error of
+    @f$ \frac{1}{131068} @f$. The returned @ref Matrix4 transforms the
+    quantized positions back and is meant to be multiplied into the object
+    transformation.
+-   @ref Trade::MeshAttribute::Normal, @ref Trade::MeshAttribute::Tangent
+    and @ref Trade::MeshAttribute::Bitangent in
+    @ref VertexFormat::Vector3 or @ref VertexFormat::Vector4 are expected to
+    have all components in the @f$ [-1, 1] @f$ range and are stored as
+    @ref VertexFormat::Vector3bNormalized / @ref VertexFormat::Vector4bNormalized,
+    with an error of @f$ \frac{1}{254} @f$, or as
+    @ref VertexFormat::Vector3sNormalized / @ref VertexFormat::Vector4sNormalized,
+    with an error of @f$ \frac{1}{65534} @f$.
+-   The first @ref Trade::MeshAttribute::TextureCoordinates in
+    @ref VertexFormat::Vector2 are stored as
+    @ref VertexFormat::Vector2ubNormalized or
+    @ref VertexFormat::Vector2usNormalized. If they're all in the
+    @f$ [0, 1] @f$ range, they're stored as-is with an error of
+    @f$ \frac{1}{510} @f$ or @f$ \frac{1}{131070} @f$ and the returned
+    @ref Matrix3 is an identity. Otherwise their bounding box is scaled to
+    the @f$ [0, 1] @f$ range, the error is scaled accordingly and the
+    returned @ref Matrix3 is a texture transformation that maps the quantized
+    coordinates back.
+
+All other attributes, including attributes with other formats and array
+attributes, are copied unchanged. The output is interleaved with each
+attribute padded to a multiple of four bytes; with default error bounds a
+mesh with @ref VertexFormat::Vector3 positions and normals and
+@ref VertexFormat::Vector2 texture coordinates takes 16 bytes per vertex
+instead of 32. Index data, if present, are copied unchanged. Expects that
+the mesh doesn't contain attributes with implementation-specific formats.
+
+@snippet MagnumMeshTools.cpp quantize
+
+@see @ref isVertexFormatImplementationSpecific(), @ref interleave(),
+    @ref encodeVertices()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Trade::MeshData, Matrix4, Matrix3> quantize(const Trade::MeshData& data, Float positionError = 1.0e-4f, Float normalError = 5.0e-3f, Float textureCoordinateError = 1.0e-4f);
+
+}}
+
+#endif
@@ -0,0 +1,230 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ReorderSpatially.h"
+
+#include <numeric>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Implementation/Parallel.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Inserts two zero bits between each of the lower 10 bits */
+inline UnsignedInt expandMortonBits(UnsignedInt v) {
+    v = (v*0x00010001u) & 0xff0000ffu;
+    v = (v*0x00000101u) & 0x0f00f00fu;
+    v = (v*0x00000011u) & 0xc30c30c3u;
+    v = (v*0x00000005u) & 0x49249249u;
+    return v;
+}
+
+/* Each radix sort pass is two passes over the data, give each thread enough
+   to offset the cost of spawning it */
+constexpr std::size_t RadixSortMinItemsPerThread = 65536;
+
+/* Stable LSD radix sort of 32-bit keys with 8-bit digits, values are
+   reordered together with the keys. Each pass first calculates a per-thread
+   digit histogram of a contiguous range and then each thread scatters its
+   range to offsets given by a prefix sum over all histograms, ordered first
+   by digit and then by thread ID, which keeps the sort stable. */
+void radixSort(const Containers::ArrayView<UnsignedInt> keys, const Containers::ArrayView<UnsignedInt> values, const UnsignedInt threadCount) {
+    CORRADE_INTERNAL_ASSERT(keys.size() == values.size());
+    const std::size_t count = keys.size();
+
+    Containers::Array<UnsignedInt> keysTemporary{Containers::NoInit, count};
+    Containers::Array<UnsignedInt> valuesTemporary{Containers::NoInit, count};
+    Containers::Array<std::size_t> histograms{Containers::NoInit, threadCount*256};
+
+    UnsignedInt* keysFrom = keys.data();
+    UnsignedInt* keysTo = keysTemporary.data();
+    UnsignedInt* valuesFrom = values.data();
+    UnsignedInt* valuesTo = valuesTemporary.data();
+
+    /* Four passes, so the result ends up in the original arrays */
+    for(UnsignedInt shift = 0; shift != 32; shift += 8) {
+        for(std::size_t& i: histograms) i = 0;
+        Implementation::parallelFor(threadCount, count, [&](const UnsignedInt thread, const std::size_t begin, const std::size_t end) {
+            std::size_t* const histogram = histograms + thread*256;
+            for(std::size_t i = begin; i != end; ++i)
+                ++histogram[(keysFrom[i] >> shift) & 0xff];
+        });
+
+        std::size_t offset = 0;
+        for(std::size_t digit = 0; digit != 256; ++digit) {
+            for(std::size_t thread = 0; thread != threadCount; ++thread) {
+                std::size_t& histogram = histograms[thread*256 + digit];
+                const std::size_t digitCount = histogram;
+                histogram = offset;
+                offset += digitCount;
+            }
+        }
+
+        Implementation::parallelFor(threadCount, count, [&](const UnsignedInt thread, const std::size_t begin, const std::size_t end) {
+            std::size_t* const histogram = histograms + thread*256;
+            for(std::size_t i = begin; i != end; ++i) {
+                const std::size_t to = histogram[(keysFrom[i] >> shift) & 0xff]++;
+                keysTo[to] = keysFrom[i];
+                valuesTo[to] = valuesFrom[i];
+            }
+        });
+
+        std::swap(keysFrom, keysTo);
+        std::swap(valuesFrom, valuesTo);
+    }
+
+    CORRADE_INTERNAL_ASSERT(keysFrom == keys.data());
+}
+
+/* Returns the sorted order of items with given codes */
+Containers::Array<UnsignedInt> sortedOrder(const Containers::ArrayView<UnsignedInt> codes, const UnsignedInt threadCount) {
+    Containers::Array<UnsignedInt> order{Containers::NoInit, codes.size()};
+    std::iota(order.begin(), order.end(), 0);
+    radixSort(codes, order, Implementation::parallelThreadCount(threadCount, codes.size(), RadixSortMinItemsPerThread));
+    return order;
+}
+
+template<class T> void copyIndicesInto(const Containers::ArrayView<const UnsignedInt> indices, const Containers::ArrayView<char> out) {
+    const Containers::ArrayView<T> outT = Containers::arrayCast<T>(out);
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        outT[i] = T(indices[i]);
+}
+
+}
+
+void mortonCodesInto(const Containers::StridedArrayView1D<const Vector3>& points, const Containers::StridedArrayView1D<UnsignedInt>& codes) {
+    CORRADE_ASSERT(codes.size() == points.size(),
+        "MeshTools::mortonCodesInto(): expected" << points.size() << "items in the output but got" << codes.size(), );
+
+    if(points.empty()) return;
+
+    /* Calculate the bounds */
+    Vector3 min = points[0];
+    Vector3 max = points[0];
+    for(const Vector3& point: points) {
+        min = Math::min(min, point);
+        max = Math::max(max, point);
+    }
+
+    /* Scale to quantize the bounding box to 10 bits, zero for flat axes */
+    const Vector3 size = max - min;
+    Vector3 scale;
+    for(std::size_t i = 0; i != 3; ++i)
+        scale[i] = size[i] > 0.0f ? 1023.0f/size[i] : 0.0f;
+
+    for(std::size_t i = 0; i != points.size(); ++i) {
+        const Vector3ui quantized{Math::clamp((points[i] - min)*scale, 0.0f, 1023.0f)};
+        codes[i] = expandMortonBits(quantized.x())|
+                   expandMortonBits(quantized.y()) << 1|
+                   expandMortonBits(quantized.z()) << 2;
+    }
+}
+
+Containers::Array<UnsignedInt> mortonCodes(const Containers::StridedArrayView1D<const Vector3>& points) {
+    Containers::Array<UnsignedInt> out{Containers::NoInit, points.size()};
+    mortonCodesInto(points, Containers::stridedArrayView(out));
+    return out;
+}
+
+Trade::MeshData reorderSpatially(const Trade::MeshData& data, const ReorderSpatiallyFlags flags, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(data.isIndexed(),
+        "MeshTools::reorderSpatially(): the mesh is not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::reorderSpatially(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(!(flags & ReorderSpatiallyFlag::Faces) || data.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::reorderSpatially(): can't sort faces of" << data.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(!(flags & ReorderSpatiallyFlag::Faces) || data.indexCount() % 3 == 0,
+        "MeshTools::reorderSpatially(): index count not divisible by 3",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    const UnsignedInt vertexCount = data.vertexCount();
+    const Containers::Array<Vector3> positions = data.positions3DAsArray();
+    Containers::Array<UnsignedInt> indices = data.indicesAsArray();
+
+    /* If sorting faces, calculate their codes from the original positions
+       before the indices get remapped */
+    Containers::Array<UnsignedInt> faceOrder;
+    if(flags & ReorderSpatiallyFlag::Faces) {
+        Containers::Array<Vector3> centroids{Containers::NoInit, indices.size()/3};
+        for(std::size_t i = 0; i != centroids.size(); ++i)
+            centroids[i] = (positions[indices[i*3 + 0]] +
+                            positions[indices[i*3 + 1]] +
+                            positions[indices[i*3 + 2]])/3.0f;
+        Containers::Array<UnsignedInt> faceCodes = mortonCodes(Containers::stridedArrayView(centroids));
+        faceOrder = sortedOrder(faceCodes, threadCount);
+    }
+
+    /* Sort the vertices, copy them to the output in the new order and invert
+       the order to get a mapping from old vertex IDs to new */
+    Containers::Array<UnsignedInt> vertexCodes = mortonCodes(Containers::stridedArrayView(positions));
+    const Containers::Array<UnsignedInt> vertexOrder = sortedOrder(vertexCodes, threadCount);
+    Trade::MeshData out = interleavedLayout(data, vertexCount);
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i)
+        duplicateInto(Containers::stridedArrayView(vertexOrder),
+            data.attribute(i), out.mutableAttribute(i));
+
+    Containers::Array<UnsignedInt> vertexMapping{Containers::NoInit, vertexCount};
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        vertexMapping[vertexOrder[i]] = i;
+
+    /* Remap the indices and put the faces in the new order, if desired */
+    Containers::Array<UnsignedInt> remappedIndices{Containers::NoInit, indices.size()};
+    if(flags & ReorderSpatiallyFlag::Faces) {
+        for(std::size_t i = 0; i != faceOrder.size(); ++i)
+            for(std::size_t j = 0; j != 3; ++j)
+                remappedIndices[i*3 + j] = vertexMapping[indices[faceOrder[i]*3 + j]];
+    } else for(std::size_t i = 0; i != indices.size(); ++i)
+        remappedIndices[i] = vertexMapping[indices[i]];
+
+    /* Convert back to the original index type */
+    const MeshIndexType indexType = data.indexType();
+    Containers::Array<char> indexData{Containers::NoInit, indices.size()*meshIndexTypeSize(indexType)};
+    if(indexType == MeshIndexType::UnsignedInt)
+        copyIndicesInto<UnsignedInt>(remappedIndices, indexData);
+    else if(indexType == MeshIndexType::UnsignedShort)
+        copyIndicesInto<UnsignedShort>(remappedIndices, indexData);
+    else if(indexType == MeshIndexType::UnsignedByte)
+        copyIndicesInto<UnsignedByte>(remappedIndices, indexData);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    const Trade::MeshIndexData indexView{indexType, Containers::arrayView(indexData)};
+    return Trade::MeshData{data.primitive(),
+        std::move(indexData), indexView,
+        out.releaseVertexData(), out.releaseAttributeData(), vertexCount};
+}
+
+}}
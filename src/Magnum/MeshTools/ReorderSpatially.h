@@ -0,0 +1,127 @@
+#ifndef Magnum_MeshTools_ReorderSpatially_h
+#define Magnum_MeshTools_ReorderSpatially_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::mortonCodes(), @ref Magnum::MeshTools::mortonCodesInto(), @ref Magnum::MeshTools::reorderSpatially(), enum @ref Magnum::MeshTools::ReorderSpatiallyFlag, enum set @ref Magnum::MeshTools::ReorderSpatiallyFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Calculate Morton codes for a list of points
+@param[in]  points  Input points
+@param[out] codes   Where to put the calculated codes
+@m_since_latest
+
+The points are quantized to a @f$ 1024^3 @f$ grid spanning their bounding
+box, and X, Y and Z bits of each quantized coordinate are then interleaved to
+form a 30-bit Morton (Z-order) code. Sorting the points by their codes puts
+points that are close to each other in space close to each other in memory as
+well. Axes along which the bounding box has zero size contribute a constant
+zero. Expects that the @p codes array has the same size as @p points.
+@see @ref mortonCodes(), @ref reorderSpatially()
+*/
+MAGNUM_MESHTOOLS_EXPORT void mortonCodesInto(const Containers::StridedArrayView1D<const Vector3>& points, const Containers::StridedArrayView1D<UnsignedInt>& codes);
+
+/**
+@brief Calculate Morton codes for a list of points
+@m_since_latest
+
+Allocates the output array and calls @ref mortonCodesInto().
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedInt> mortonCodes(const Containers::StridedArrayView1D<const Vector3>& points);
+
+/**
+@brief Spatial reordering flag
+@m_since_latest
+
+@see @ref ReorderSpatiallyFlags, @ref reorderSpatially()
+*/
+enum class ReorderSpatiallyFlag: UnsignedByte {
+    /**
+     * Sort also faces by Morton codes of their centroids. Without this flag
+     * only vertices are reordered and the index buffer keeps its original
+     * face order. Can be only used with @ref MeshPrimitive::Triangles.
+     */
+    Faces = 1 << 0
+};
+
+/**
+@brief Spatial reordering flags
+@m_since_latest
+
+@see @ref reorderSpatially()
+*/
+typedef Containers::EnumSet<ReorderSpatiallyFlag> ReorderSpatiallyFlags;
+
+CORRADE_ENUMSET_OPERATORS(ReorderSpatiallyFlags)
+
+/**
+@brief Reorder mesh vertices and faces spatially
+@param data         Input mesh
+@param flags        Flags
+@param threadCount  How many threads to use for sorting. If @cpp 0 @ce,
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Sorts the vertices by a Morton code of their position calculated using
+@ref mortonCodesInto() and remaps the index buffer accordingly. With
+@ref ReorderSpatiallyFlag::Faces, triangle faces are then additionally sorted
+by a Morton code of their centroid. The result renders the same, but vertices
+and faces that are close in space are also close in memory, which makes
+CPU-side passes that access vertices through the index buffer such as
+@ref generateSmoothNormals(), raycasting or collision detection significantly
+more cache-friendly on meshes with arbitrary vertex order such as 3D scans.
+
+Sorting is done with a stable LSD radix sort, which for larger meshes is
+split across up to @p threadCount threads. Each thread gets at least 64k items
+so small meshes are processed on the calling thread only. On Emscripten
+builds without threading support, everything is always done on the calling
+thread.
+
+Expects that the mesh is indexed and has a @ref Trade::MeshAttribute::Position
+attribute, use @ref generateIndices() to create an index buffer for
+non-indexed meshes. The index type is preserved, vertex data are
+interleaved in the output with the layout calculated by
+@ref interleavedLayout(). If the mesh has more than one position attribute,
+only the first one is used for sorting.
+
+For vertex cache optimization of the index buffer done on top of this, see
+@ref tipsifyInPlace().
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData reorderSpatially(const Trade::MeshData& data, ReorderSpatiallyFlags flags = {}, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
@@ -0,0 +1,248 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Subdivide.h"
+
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+#include "Magnum/VertexFormat.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace Implementation {
+
+namespace {
+
+template<class T> UnsignedInt subdivideEdgesIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<UnsignedInt>& edgeIds) {
+    CORRADE_INTERNAL_ASSERT(edgeIds.size() == indices.size());
+
+    /* The key is the lower index in upper 32 bits and the higher index in
+       the lower 32 bits, so both directions of an edge map to the same
+       entry. Each edge is usually shared by two faces, so half the index
+       count is a good estimate of the final size. */
+    std::unordered_map<UnsignedLong, UnsignedInt> table;
+    table.reserve(indices.size()/2);
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        for(std::size_t j = 0; j != 3; ++j) {
+            UnsignedInt a = indices[i + j];
+            UnsignedInt b = indices[i + (j + 1)%3];
+            if(a > b) std::swap(a, b);
+            const UnsignedInt id = table.size();
+            edgeIds[i + j] = table.emplace((UnsignedLong(a) << 32)|b, id).first->second;
+        }
+    }
+
+    return table.size();
+}
+
+}
+
+UnsignedInt subdivideEdgesInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<UnsignedInt>& edgeIds) {
+    return subdivideEdgesIntoImplementation(indices, edgeIds);
+}
+
+UnsignedInt subdivideEdgesInto(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<UnsignedInt>& edgeIds) {
+    return subdivideEdgesIntoImplementation(indices, edgeIds);
+}
+
+UnsignedInt subdivideEdgesInto(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<UnsignedInt>& edgeIds) {
+    return subdivideEdgesIntoImplementation(indices, edgeIds);
+}
+
+}
+
+namespace {
+
+/* out += factor*in, for one vertex with componentCount floats */
+inline void addScaled(Float* out, const Float* in, const Float factor, const UnsignedInt componentCount) {
+    for(UnsignedInt i = 0; i != componentCount; ++i)
+        out[i] += factor*in[i];
+}
+
+}
+
+Trade::MeshData subdivideLoop(const Trade::MeshData& mesh, const UnsignedInt levels) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::subdivideLoop(): expected" << MeshPrimitive::Triangles << "but got" << mesh.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT((mesh.isIndexed() ? mesh.indexCount() : mesh.vertexCount())%3 == 0,
+        "MeshTools::subdivideLoop(): expected index or vertex count divisible by 3",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Gather all attributes into a single float array, C floats per vertex */
+    Containers::Array<UnsignedInt> attributeOffsets{Containers::NoInit, mesh.attributeCount()};
+    UnsignedInt componentCount = 0;
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const VertexFormat format = mesh.attributeFormat(i);
+        CORRADE_ASSERT(!isVertexFormatImplementationSpecific(format) &&
+            vertexFormatComponentFormat(format) == VertexFormat::Float &&
+            !mesh.attributeArraySize(i),
+            "MeshTools::subdivideLoop(): expected a non-array floating-point attribute but attribute" << i << "is" << format << Debug::nospace << (mesh.attributeArraySize(i) ? "[]" : ""),
+            (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+        attributeOffsets[i] = componentCount;
+        componentCount += vertexFormatSize(format)/sizeof(Float);
+    }
+
+    std::size_t vertexCount = mesh.vertexCount();
+    Containers::Array<Float> vertices{Containers::NoInit, vertexCount*componentCount};
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const Containers::StridedArrayView2D<const char> attribute = mesh.attribute(i);
+        for(std::size_t j = 0; j != vertexCount; ++j)
+            std::memcpy(vertices + j*componentCount + attributeOffsets[i], attribute[j].data(), attribute.size()[1]);
+    }
+
+    Containers::Array<UnsignedInt> indices;
+    if(mesh.isIndexed()) indices = mesh.indicesAsArray();
+    else {
+        indices = Containers::Array<UnsignedInt>{Containers::NoInit, vertexCount};
+        std::iota(indices.begin(), indices.end(), 0);
+    }
+
+    for(UnsignedInt level = 0; level != levels; ++level) {
+        const std::size_t indexCount = indices.size();
+        Containers::Array<UnsignedInt> edgeIds{Containers::NoInit, indexCount};
+        const UnsignedInt edgeCount = Implementation::subdivideEdgesInto(Containers::StridedArrayView1D<const UnsignedInt>{Containers::arrayView(indices)}, Containers::stridedArrayView(edgeIds));
+
+        /* Endpoints, adjacent face count and the vertices opposite to the
+           edge in the first two adjacent faces */
+        Containers::Array<UnsignedInt> edgeVertices{Containers::NoInit, edgeCount*4};
+        Containers::Array<UnsignedInt> edgeFaceCount{Containers::ValueInit, edgeCount};
+        for(std::size_t i = 0; i != indexCount; ++i) {
+            const UnsignedInt edge = edgeIds[i];
+            const std::size_t face = i - i%3;
+            if(!edgeFaceCount[edge]) {
+                edgeVertices[edge*4 + 0] = indices[i];
+                edgeVertices[edge*4 + 1] = indices[face + (i%3 + 1)%3];
+            }
+            if(edgeFaceCount[edge] < 2)
+                edgeVertices[edge*4 + 2 + edgeFaceCount[edge]] = indices[face + (i%3 + 2)%3];
+            ++edgeFaceCount[edge];
+        }
+
+        /* The output has exactly one new vertex per unique edge */
+        Containers::Array<Float> out{Containers::ValueInit, (vertexCount + edgeCount)*componentCount};
+
+        /* Smooth the original vertices. Sum all neighbors and separately
+           neighbors along crease edges, each edge contributes to both its
+           endpoints. */
+        Containers::Array<Float> neighborSum{Containers::ValueInit, vertexCount*componentCount};
+        Containers::Array<Float> creaseSum{Containers::ValueInit, vertexCount*componentCount};
+        Containers::Array<UnsignedInt> valence{Containers::ValueInit, vertexCount};
+        Containers::Array<UnsignedInt> creaseValence{Containers::ValueInit, vertexCount};
+        for(UnsignedInt edge = 0; edge != edgeCount; ++edge) {
+            const UnsignedInt a = edgeVertices[edge*4 + 0];
+            const UnsignedInt b = edgeVertices[edge*4 + 1];
+            addScaled(neighborSum + a*componentCount, vertices + b*componentCount, 1.0f, componentCount);
+            addScaled(neighborSum + b*componentCount, vertices + a*componentCount, 1.0f, componentCount);
+            ++valence[a];
+            ++valence[b];
+            if(edgeFaceCount[edge] != 2) {
+                addScaled(creaseSum + a*componentCount, vertices + b*componentCount, 1.0f, componentCount);
+                addScaled(creaseSum + b*componentCount, vertices + a*componentCount, 1.0f, componentCount);
+                ++creaseValence[a];
+                ++creaseValence[b];
+            }
+        }
+
+        for(std::size_t i = 0; i != vertexCount; ++i) {
+            Float* const to = out + i*componentCount;
+            const Float* const from = vertices + i*componentCount;
+            if(!creaseValence[i] && valence[i]) {
+                const UnsignedInt k = valence[i];
+                const Float beta = k == 3 ? 3.0f/16.0f : 3.0f/(8.0f*k);
+                addScaled(to, from, 1.0f - k*beta, componentCount);
+                addScaled(to, neighborSum + i*componentCount, beta, componentCount);
+            } else if(creaseValence[i] == 2) {
+                addScaled(to, from, 0.75f, componentCount);
+                addScaled(to, creaseSum + i*componentCount, 0.125f, componentCount);
+            } else addScaled(to, from, 1.0f, componentCount);
+        }
+
+        /* New edge vertices */
+        for(UnsignedInt edge = 0; edge != edgeCount; ++edge) {
+            Float* const to = out + (vertexCount + edge)*componentCount;
+            const UnsignedInt* const v = edgeVertices + edge*4;
+            if(edgeFaceCount[edge] == 2) {
+                addScaled(to, vertices + v[0]*componentCount, 0.375f, componentCount);
+                addScaled(to, vertices + v[1]*componentCount, 0.375f, componentCount);
+                addScaled(to, vertices + v[2]*componentCount, 0.125f, componentCount);
+                addScaled(to, vertices + v[3]*componentCount, 0.125f, componentCount);
+            } else {
+                addScaled(to, vertices + v[0]*componentCount, 0.5f, componentCount);
+                addScaled(to, vertices + v[1]*componentCount, 0.5f, componentCount);
+            }
+        }
+
+        /* Subdivide each face to four new, in the same order as
+           subdivideInPlace() does */
+        Containers::Array<UnsignedInt> outIndices{Containers::NoInit, indexCount*4};
+        std::size_t indexOffset = indexCount;
+        for(std::size_t i = 0; i != indexCount; i += 3) {
+            UnsignedInt newVertices[3];
+            for(std::size_t j = 0; j != 3; ++j)
+                newVertices[j] = vertexCount + edgeIds[i + j];
+
+            outIndices[indexOffset++] = indices[i];
+            outIndices[indexOffset++] = newVertices[0];
+            outIndices[indexOffset++] = newVertices[2];
+
+            outIndices[indexOffset++] = newVertices[0];
+            outIndices[indexOffset++] = indices[i + 1];
+            outIndices[indexOffset++] = newVertices[1];
+
+            outIndices[indexOffset++] = newVertices[2];
+            outIndices[indexOffset++] = newVertices[1];
+            outIndices[indexOffset++] = indices[i + 2];
+            for(std::size_t j = 0; j != 3; ++j)
+                outIndices[i + j] = newVertices[j];
+        }
+
+        vertices = std::move(out);
+        indices = std::move(outIndices);
+        vertexCount += edgeCount;
+    }
+
+    /* Put the floats back into a layout with the original formats */
+    Trade::MeshData layout = interleavedLayout(mesh, vertexCount);
+    for(UnsignedInt i = 0; i != layout.attributeCount(); ++i) {
+        const Containers::StridedArrayView2D<char> attribute = layout.mutableAttribute(i);
+        for(std::size_t j = 0; j != vertexCount; ++j)
+            std::memcpy(attribute[j].data(), vertices + j*componentCount + attributeOffsets[i], attribute.size()[1]);
+    }
+
+    Containers::Array<char> indexData{Containers::NoInit, indices.size()*sizeof(UnsignedInt)};
+    std::memcpy(indexData.data(), indices.data(), indexData.size());
+    const Trade::MeshIndexData indexView{Containers::arrayCast<const UnsignedInt>(indexData)};
+    return Trade::MeshData{MeshPrimitive::Triangles,
+        std::move(indexData), indexView,
+        layout.releaseVertexData(), layout.releaseAttributeData()};
+}
+
+}}
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::subdivide(), @ref Magnum::MeshTools::subdivideInPlace()
+ * @brief Function @ref Magnum::MeshTools::subdivide(), @ref Magnum::MeshTools::subdivideInPlace(), @ref Magnum::MeshTools::subdivideShared(), @ref Magnum::MeshTools::subdivideSharedInPlace(), @ref Magnum::MeshTools::subdivideLoop()
  */
 
 #include <Corrade/Containers/GrowableArray.h>
@@ -35,6 +35,8 @@
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 #include <vector>
@@ -44,8 +46,19 @@ namespace Magnum { namespace MeshTools {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template<class IndexType, class Vertex, class Interpolator> void subdivideInPlace(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView1D<Vertex>& vertices, Interpolator interpolator);
+template<class IndexType, class Vertex, class Interpolator> std::size_t subdivideSharedInPlace(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView1D<Vertex>& vertices, std::size_t vertexCount, Interpolator interpolator);
 #endif
 
+namespace Implementation {
+    /* Assigns an ID to each unique undirected triangle edge, in order of
+       first appearance. Edge j of face i goes from indices[i*3 + j] to
+       indices[i*3 + (j + 1)%3], its ID is written to edgeIds[i*3 + j].
+       Returns the unique edge count. */
+    MAGNUM_MESHTOOLS_EXPORT UnsignedInt subdivideEdgesInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<UnsignedInt>& edgeIds);
+    MAGNUM_MESHTOOLS_EXPORT UnsignedInt subdivideEdgesInto(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<UnsignedInt>& edgeIds);
+    MAGNUM_MESHTOOLS_EXPORT UnsignedInt subdivideEdgesInto(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<UnsignedInt>& edgeIds);
+}
+
 /**
 @brief Subdivide a mesh
 @tparam Vertex          Vertex data type
@@ -58,7 +71,8 @@ template<class IndexType, class Vertex, class Interpolator> void subdivideInPlac
 
 Goes through all triangle faces and subdivides them into four new, enlarging
 the @p indices and @p vertices arrays as appropriate. Removing duplicate
-vertices in the mesh is up to the user.
+vertices in the mesh is up to the user. Use @ref subdivideShared() to have
+edges shared by adjacent faces get just a single new vertex.
 @see @ref subdivideInPlace(), @ref removeDuplicatesInPlace()
 */
 template<class IndexType, class Vertex, class Interpolator> void subdivide(Containers::Array<IndexType>& indices, Containers::Array<Vertex>& vertices, Interpolator interpolator) {
@@ -168,6 +182,151 @@ template<class IndexType, class Vertex, class Interpolator> void subdivideInPlac
     subdivideInPlace(Containers::stridedArrayView(indices), vertices, interpolator);
 }
 
+/**
+@brief Subdivide a mesh, sharing vertices of common edges
+@tparam Vertex          Vertex data type
+@tparam Interpolator    See the @p interpolator function parameter
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param interpolator     Functor or function pointer which interpolates
+    two adjacent vertices: @cpp Vertex interpolator(Vertex a, Vertex b) @ce
+@m_since_latest
+
+Like @ref subdivide(), but edges shared by adjacent faces get just a single
+new vertex, so there's no need to call @ref removeDuplicatesInPlace()
+afterwards. Unique edges are found by hashing vertex index pairs, the arrays
+are then enlarged exactly to the final size. Edge direction isn't taken into
+account, so the @p interpolator should be symmetric. For a closed mesh with
+@f$ i @f$ indices and @f$ v @f$ vertices the result has @f$ 4i @f$ indices
+and @f$ v + \frac{i}{2} @f$ vertices.
+@see @ref subdivideSharedInPlace(), @ref subdivideLoop()
+*/
+template<class IndexType, class Vertex, class Interpolator> void subdivideShared(Containers::Array<IndexType>& indices, Containers::Array<Vertex>& vertices, Interpolator interpolator) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivideShared(): index count is not divisible by 3", );
+
+    Containers::Array<UnsignedInt> edgeIds{Containers::NoInit, indices.size()};
+    const UnsignedInt edgeCount = Implementation::subdivideEdgesInto(Containers::StridedArrayView1D<const IndexType>{Containers::stridedArrayView(indices)}, Containers::stridedArrayView(edgeIds));
+
+    const std::size_t vertexCount = vertices.size();
+    arrayResize(vertices, Containers::NoInit, vertexCount + edgeCount);
+    arrayResize(indices, Containers::NoInit, indices.size()*4);
+    subdivideSharedInPlace(Containers::stridedArrayView(indices), Containers::stridedArrayView(vertices), vertexCount, interpolator);
+}
+
+/**
+@brief Subdivide a mesh in-place, sharing vertices of common edges
+@tparam Vertex          Vertex data type
+@tparam Interpolator    See the @p interpolator function parameter
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param vertexCount      Count of vertices in the original mesh
+@param interpolator     Functor or function pointer which interpolates
+    two adjacent vertices: @cpp Vertex interpolator(Vertex a, Vertex b) @ce
+@return New vertex count
+@m_since_latest
+
+Like @ref subdivideInPlace(), but edges shared by adjacent faces get just a
+single new vertex. Expects that the @p indices array has a size of @f$ 4i @f$
+with the original @f$ i @f$ indices being in the first quarter, and that the
+@p vertices array has the original @p vertexCount vertices at the front and
+room for at least one new vertex for each unique edge after them. The new
+vertices are added in order in which their edges first appear in the index
+buffer. For a closed mesh there's exactly @f$ \frac{i}{2} @f$ unique edges,
+so for @f$ k @f$ subsequent subdivisions the final vertex count is known
+upfront: @f[
+    v' = v + \frac{1}{6}(i' - i)
+@f]
+@see @ref subdivideShared()
+*/
+template<class IndexType, class Vertex, class Interpolator> std::size_t subdivideSharedInPlace(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView1D<Vertex>& vertices, const std::size_t vertexCount, Interpolator interpolator) {
+    CORRADE_ASSERT(!(indices.size()%12), "MeshTools::subdivideSharedInPlace(): can't divide" << indices.size() << "indices to four parts with each having triangle faces", {});
+
+    const std::size_t indexCount = indices.size()/4;
+    Containers::Array<UnsignedInt> edgeIds{Containers::NoInit, indexCount};
+    const UnsignedInt edgeCount = Implementation::subdivideEdgesInto(Containers::StridedArrayView1D<const IndexType>{indices.prefix(indexCount)}, Containers::stridedArrayView(edgeIds));
+    CORRADE_ASSERT(vertexCount + edgeCount <= vertices.size(), "MeshTools::subdivideSharedInPlace(): expected at least" << vertexCount + edgeCount << "vertices but got" << vertices.size(), {});
+    /* Somehow ~IndexType{} doesn't work for < 4byte types, as the result is
+       int(-1) instead of the type I want */
+    CORRADE_ASSERT(vertexCount + edgeCount <= IndexType(-1), "MeshTools::subdivideSharedInPlace(): a" << sizeof(IndexType) << Debug::nospace << "-byte index type is too small for" << vertexCount + edgeCount << "vertices", {});
+
+    /* Interpolate each unique edge. IDs are assigned in order of first
+       appearance, so an edge is new exactly when its ID is the next one. */
+    UnsignedInt nextEdge = 0;
+    for(std::size_t i = 0; i != indexCount; ++i) {
+        if(edgeIds[i] != nextEdge) continue;
+        vertices[vertexCount + nextEdge++] = interpolator(
+            vertices[indices[i]], vertices[indices[i - i%3 + (i%3 + 1)%3]]);
+    }
+
+    /* Subdivide each face to four new, in the same order as
+       subdivideInPlace() does */
+    std::size_t indexOffset = indexCount;
+    for(std::size_t i = 0; i != indexCount; i += 3) {
+        IndexType newVertices[3];
+        for(std::size_t j = 0; j != 3; ++j)
+            newVertices[j] = vertexCount + edgeIds[i + j];
+
+        indices[indexOffset++] = indices[i];
+        indices[indexOffset++] = newVertices[0];
+        indices[indexOffset++] = newVertices[2];
+
+        indices[indexOffset++] = newVertices[0];
+        indices[indexOffset++] = indices[i+1];
+        indices[indexOffset++] = newVertices[1];
+
+        indices[indexOffset++] = newVertices[2];
+        indices[indexOffset++] = newVertices[1];
+        indices[indexOffset++] = indices[i+2];
+        for(std::size_t j = 0; j != 3; ++j)
+            indices[i+j] = newVertices[j];
+    }
+
+    return vertexCount + edgeCount;
+}
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+template<class IndexType, class Vertex, class Interpolator> std::size_t subdivideSharedInPlace(const Containers::ArrayView<IndexType>& indices, const Containers::StridedArrayView1D<Vertex>& vertices, std::size_t vertexCount, Interpolator interpolator) {
+    return subdivideSharedInPlace(Containers::stridedArrayView(indices), vertices, vertexCount, interpolator);
+}
+
+/**
+@brief Subdivide a mesh using the Loop scheme
+@param mesh     Input mesh
+@param levels   How many times to subdivide
+@m_since_latest
+
+Each triangle face is divided into four new, with edges shared by adjacent
+faces getting a single new vertex, and all vertices are then smoothed using
+the weights from Charles Loop's
+[Smooth Subdivision Surfaces Based on Triangles](https://www.microsoft.com/en-us/research/publication/smooth-subdivision-surfaces-based-on-triangles/).
+For an interior vertex of valence @f$ k @f$ the weight of each neighbor
+is @f$ \beta = \frac{3}{8k} @f$ (or @f$ \frac{3}{16} @f$ for
+@f$ k = 3 @f$), a new vertex on an interior edge is @f$ \frac{3}{8} @f$
+of both edge endpoints and @f$ \frac{1}{8} @f$ of both opposite vertices.
+Edges that don't have exactly two adjacent faces are treated as creases,
+with new vertices placed in their middle and vertices on them smoothed
+only along the crease. Vertices with more than two crease edges are kept
+in place.
+
+The weights are applied to all attributes, not just positions. Normals
+are thus no longer normalized and you may want to regenerate them using
+@ref generateSmoothNormals() instead. The output is always indexed with
+@ref MeshIndexType::UnsignedInt indices and has the attributes interleaved,
+with array sizes calculated exactly upfront for each level.
+
+Expects that @p mesh is a @ref MeshPrimitive::Triangles with index or
+vertex count divisible by 3 and all attributes are non-array with a
+@ref VertexFormat::Float component format.
+
+The Catmull-Clark scheme isn't provided, as it operates on quad meshes which
+@ref Trade::MeshData can't represent.
+@see @ref subdivideShared(), @ref vertexFormatComponentFormat()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData subdivideLoop(const Trade::MeshData& mesh, UnsignedInt levels = 1);
+
 }}
 
 #endif
@@ -0,0 +1,583 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Bvh.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct BvhTest: TestSuite::Tester {
+    explicit BvhTest();
+
+    void construct();
+    void constructNotIndexed();
+    void constructEmpty();
+    void constructMultipleThreads();
+    void constructNotTriangles();
+    void constructNoPositions();
+    void constructIndexCountNotDivisibleByThree();
+    void constructIndexOutOfBounds();
+    void constructCopy();
+    void constructMove();
+
+    void closestHit();
+    void closestHitMiss();
+    void closestHitMaxDistance();
+    void anyHit();
+
+    void closestHits();
+    void anyHits();
+    void hitsWrongSize();
+
+    void overlapping();
+
+    void benchmarkSetup();
+
+    void benchmarkBuild();
+    void benchmarkBuildMultipleThreads();
+    void benchmarkClosestHit();
+    void benchmarkClosestHits();
+    void benchmarkAnyHits();
+    void benchmarkClosestHitBruteForce();
+
+    private:
+        Containers::Array<UnsignedInt> _indices;
+        Containers::Array<Vector3> _positions;
+        Containers::Array<Vector3> _origins, _directions;
+        Containers::Optional<Bvh> _bvh;
+};
+
+BvhTest::BvhTest() {
+    addTests({&BvhTest::construct,
+              &BvhTest::constructNotIndexed,
+              &BvhTest::constructEmpty,
+              &BvhTest::constructMultipleThreads,
+              &BvhTest::constructNotTriangles,
+              &BvhTest::constructNoPositions,
+              &BvhTest::constructIndexCountNotDivisibleByThree,
+              &BvhTest::constructIndexOutOfBounds,
+              &BvhTest::constructCopy,
+              &BvhTest::constructMove,
+
+              &BvhTest::closestHit,
+              &BvhTest::closestHitMiss,
+              &BvhTest::closestHitMaxDistance,
+              &BvhTest::anyHit,
+
+              &BvhTest::closestHits,
+              &BvhTest::anyHits,
+              &BvhTest::hitsWrongSize,
+
+              &BvhTest::overlapping});
+
+    addBenchmarks({&BvhTest::benchmarkBuild,
+                   &BvhTest::benchmarkBuildMultipleThreads,
+                   &BvhTest::benchmarkClosestHit,
+                   &BvhTest::benchmarkClosestHits,
+                   &BvhTest::benchmarkAnyHits,
+                   &BvhTest::benchmarkClosestHitBruteForce}, 10,
+        &BvhTest::benchmarkSetup,
+        &BvhTest::benchmarkSetup);
+
+    /* A 16x16 grid of parallel rays covering the silhouette of a unit
+       icosphere, similarly to primary rays from a camera */
+    _origins = Containers::Array<Vector3>{Containers::NoInit, 16*16};
+    _directions = Containers::Array<Vector3>{Containers::NoInit, 16*16};
+    for(std::size_t y = 0; y != 16; ++y) {
+        for(std::size_t x = 0; x != 16; ++x) {
+            _origins[y*16 + x] = {x/7.5f - 1.0f, y/7.5f - 1.0f, 3.0f};
+            _directions[y*16 + x] = -Vector3::zAxis();
+        }
+    }
+}
+
+void BvhTest::benchmarkSetup() {
+    /* Set as both the benchmark setup and teardown. Building the BVH takes a
+       while, so it's done once, the first time a benchmark runs. */
+    if(_bvh) return;
+
+    /* An icosphere with 330k faces */
+    Trade::MeshData icosphere = Primitives::icosphereSolid(7);
+    _indices = icosphere.indicesAsArray();
+    _positions = icosphere.positions3DAsArray();
+    _bvh.emplace(icosphere);
+}
+
+/* Two parallel quads, the first at Z = 0, the second at Z = -1 */
+const Vector3 QuadPositions[]{
+    {-1.0f, -1.0f, 0.0f},
+    { 1.0f, -1.0f, 0.0f},
+    { 1.0f,  1.0f, 0.0f},
+    {-1.0f,  1.0f, 0.0f},
+    {-1.0f, -1.0f, -1.0f},
+    { 1.0f, -1.0f, -1.0f},
+    { 1.0f,  1.0f, -1.0f},
+    {-1.0f,  1.0f, -1.0f}
+};
+
+const UnsignedShort QuadIndices[]{
+    0, 1, 2, 0, 2, 3,
+    4, 5, 6, 4, 6, 7
+};
+
+Trade::MeshData quads() {
+    return Trade::MeshData{MeshPrimitive::Triangles,
+        {}, QuadIndices, Trade::MeshIndexData{QuadIndices},
+        {}, QuadPositions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(QuadPositions)}
+        }};
+}
+
+/* Verifies that children are inside their parents and each triangle is
+   referenced by exactly one leaf */
+void verifyHierarchy(const Bvh& bvh) {
+    Containers::Array<UnsignedInt> referenced{Containers::ValueInit, bvh.triangleCount()};
+    for(const Bvh::Node& node: bvh.nodes()) {
+        if(node.count) {
+            for(UnsignedInt i = node.offset; i != node.offset + node.count; ++i)
+                ++referenced[i];
+            continue;
+        }
+
+        for(const Bvh::Node& child: {bvh.nodes()[node.offset], bvh.nodes()[node.offset + 1]}) {
+            CORRADE_VERIFY((child.bounds.min() >= node.bounds.min()).all());
+            CORRADE_VERIFY((child.bounds.max() <= node.bounds.max()).all());
+        }
+    }
+
+    for(UnsignedInt count: referenced) CORRADE_COMPARE(count, 1);
+
+    Containers::Array<UnsignedInt> triangleIds{Containers::NoInit, bvh.triangleCount()};
+    Utility::copy(bvh.triangleIds(), triangleIds);
+    std::sort(triangleIds.begin(), triangleIds.end());
+    for(std::size_t i = 0; i != triangleIds.size(); ++i)
+        CORRADE_COMPARE(triangleIds[i], i);
+}
+
+void BvhTest::construct() {
+    Bvh bvh{quads()};
+    CORRADE_COMPARE(bvh.triangleCount(), 4);
+    CORRADE_COMPARE(bvh.bounds(), (Range3D{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 0.0f}}));
+    CORRADE_VERIFY(!bvh.nodes().empty());
+    CORRADE_COMPARE(bvh.nodes()[0].bounds, bvh.bounds());
+    verifyHierarchy(bvh);
+
+    Bvh icosphere{Primitives::icosphereSolid(3)};
+    CORRADE_COMPARE(icosphere.triangleCount(), 1280);
+    /* There should be way more than a single leaf */
+    CORRADE_COMPARE_AS(icosphere.nodes().size(), std::size_t{1280/4},
+        TestSuite::Compare::Greater);
+    verifyHierarchy(icosphere);
+}
+
+void BvhTest::constructNotIndexed() {
+    /* Every three vertices are a triangle */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 2.0f}, {1.0f, 0.0f, 2.0f}, {0.0f, 1.0f, 2.0f}
+    };
+    Bvh bvh{Trade::MeshData{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayView(positions)}
+    }}};
+    CORRADE_COMPARE(bvh.triangleCount(), 2);
+    CORRADE_COMPARE(bvh.bounds(), (Range3D{{}, {1.0f, 1.0f, 2.0f}}));
+
+    Containers::Optional<Bvh::Hit> hit = bvh.closestHit({0.25f, 0.25f, 3.0f}, -Vector3::zAxis());
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->triangle, 1);
+    CORRADE_COMPARE(hit->distance, 1.0f);
+}
+
+void BvhTest::constructEmpty() {
+    Bvh bvh{nullptr, nullptr};
+    CORRADE_COMPARE(bvh.triangleCount(), 0);
+    CORRADE_VERIFY(bvh.nodes().empty());
+    CORRADE_COMPARE(bvh.bounds(), Range3D{});
+
+    CORRADE_VERIFY(!bvh.closestHit({}, Vector3::zAxis()));
+    CORRADE_VERIFY(!bvh.anyHit({}, Vector3::zAxis()));
+    CORRADE_VERIFY(bvh.overlapping({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}).empty());
+
+    const Vector3 origins[]{{}, {}};
+    const Vector3 directions[]{Vector3::xAxis(), Vector3::zAxis()};
+    Bvh::Hit hits[2];
+    bvh.closestHits(origins, directions, Constants::inf(), hits);
+    CORRADE_COMPARE(hits[0].triangle, ~UnsignedInt{});
+    CORRADE_COMPARE(hits[1].triangle, ~UnsignedInt{});
+}
+
+void BvhTest::constructMultipleThreads() {
+    /* Large enough to be split across threads. The partitioning doesn't
+       depend on the thread count, only the node order does. */
+    Trade::MeshData icosphere = Primitives::icosphereSolid(6);
+    Bvh single{icosphere, 1};
+    Bvh multiple{icosphere, 4};
+    CORRADE_COMPARE(multiple.nodes().size(), single.nodes().size());
+    CORRADE_COMPARE(multiple.bounds(), single.bounds());
+    CORRADE_COMPARE_AS(multiple.triangleIds(), single.triangleIds(),
+        TestSuite::Compare::Container);
+    verifyHierarchy(multiple);
+
+    for(std::size_t i = 0; i != _origins.size(); ++i) {
+        Containers::Optional<Bvh::Hit> a = single.closestHit(_origins[i], _directions[i]);
+        Containers::Optional<Bvh::Hit> b = multiple.closestHit(_origins[i], _directions[i]);
+        CORRADE_COMPARE(!!a, !!b);
+        if(a) {
+            CORRADE_COMPARE(b->triangle, a->triangle);
+            CORRADE_COMPARE(b->distance, a->distance);
+        }
+    }
+}
+
+void BvhTest::constructNotTriangles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Bvh{Trade::MeshData{MeshPrimitive::Lines, 0}};
+    CORRADE_COMPARE(out.str(), "MeshTools::Bvh: expected a triangle mesh but got MeshPrimitive::Lines\n");
+}
+
+void BvhTest::constructNoPositions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Bvh{Trade::MeshData{MeshPrimitive::Triangles, 3}};
+    CORRADE_COMPARE(out.str(), "MeshTools::Bvh: the mesh has no positions\n");
+}
+
+void BvhTest::constructIndexCountNotDivisibleByThree() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedInt indices[]{0, 1, 2, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Bvh{indices, QuadPositions};
+    CORRADE_COMPARE(out.str(), "MeshTools::Bvh: expected index count divisible by 3, got 4\n");
+}
+
+void BvhTest::constructIndexOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedInt indices[]{0, 1, 8};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Bvh{indices, QuadPositions};
+    CORRADE_COMPARE(out.str(), "MeshTools::Bvh: index 8 out of bounds for 8 vertices\n");
+}
+
+void BvhTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<Bvh, const Bvh&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<Bvh, const Bvh&>{}));
+}
+
+void BvhTest::constructMove() {
+    Bvh a{quads()};
+    const Bvh::Node* nodes = a.nodes().data();
+
+    Bvh b{std::move(a)};
+    CORRADE_COMPARE(b.nodes().data(), nodes);
+    CORRADE_COMPARE(b.triangleCount(), 4);
+
+    Bvh c{Primitives::icosphereSolid(0)};
+    c = std::move(b);
+    CORRADE_COMPARE(c.nodes().data(), nodes);
+    CORRADE_COMPARE(c.triangleCount(), 4);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<Bvh>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<Bvh>::value);
+}
+
+void BvhTest::closestHit() {
+    Bvh bvh{quads()};
+
+    /* From above, hits the first quad. The direction isn't normalized, so
+       the distance is a half. */
+    Containers::Optional<Bvh::Hit> hit = bvh.closestHit({0.5f, -0.5f, 1.0f}, {0.0f, 0.0f, -2.0f});
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->triangle, 0);
+    CORRADE_COMPARE(hit->distance, 0.5f);
+    CORRADE_COMPARE(hit->barycentric, (Vector2{0.5f, 0.25f}));
+
+    /* From below, hits the second quad */
+    hit = bvh.closestHit({0.5f, -0.5f, -2.0f}, Vector3::zAxis());
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->triangle, 2);
+    CORRADE_COMPARE(hit->distance, 1.0f);
+
+    /* From between the two, the first quad is behind */
+    hit = bvh.closestHit({-0.5f, 0.5f, -0.5f}, -Vector3::zAxis());
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->triangle, 3);
+    CORRADE_COMPARE(hit->distance, 0.5f);
+}
+
+void BvhTest::closestHitMiss() {
+    Bvh bvh{quads()};
+    CORRADE_VERIFY(!bvh.closestHit({2.0f, 0.0f, 1.0f}, -Vector3::zAxis()));
+    CORRADE_VERIFY(!bvh.closestHit({0.0f, 0.0f, 1.0f}, Vector3::zAxis()));
+    /* Parallel to the quads */
+    CORRADE_VERIFY(!bvh.closestHit({-2.0f, 0.0f, 0.5f}, Vector3::xAxis()));
+}
+
+void BvhTest::closestHitMaxDistance() {
+    Bvh bvh{quads()};
+
+    /* The first quad is too far */
+    CORRADE_VERIFY(!bvh.closestHit({0.5f, -0.5f, 1.0f}, -Vector3::zAxis(), 1.0f));
+
+    /* The first quad is close enough, the second not */
+    Containers::Optional<Bvh::Hit> hit = bvh.closestHit({0.5f, -0.5f, 1.0f}, -Vector3::zAxis(), 1.5f);
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->triangle, 0);
+    CORRADE_COMPARE(hit->distance, 1.0f);
+}
+
+void BvhTest::anyHit() {
+    Bvh bvh{quads()};
+    CORRADE_VERIFY(bvh.anyHit({0.5f, -0.5f, 1.0f}, -Vector3::zAxis()));
+    CORRADE_VERIFY(bvh.anyHit({0.5f, -0.5f, -2.0f}, Vector3::zAxis()));
+    CORRADE_VERIFY(!bvh.anyHit({2.0f, 0.0f, 1.0f}, -Vector3::zAxis()));
+    CORRADE_VERIFY(!bvh.anyHit({0.0f, 0.0f, 1.0f}, Vector3::zAxis()));
+    CORRADE_VERIFY(!bvh.anyHit({0.5f, -0.5f, 1.0f}, -Vector3::zAxis(), 1.0f));
+    CORRADE_VERIFY(bvh.anyHit({0.5f, -0.5f, 1.0f}, -Vector3::zAxis(), 1.5f));
+}
+
+/* Random rays from outside of the unit sphere aimed at a slightly larger
+   area, so some of them miss. The count isn't divisible by the packet size
+   to test the remainder handling. */
+void randomRays(Containers::Array<Vector3>& origins, Containers::Array<Vector3>& directions) {
+    std::minstd_rand random;
+    std::uniform_real_distribution<Float> distribution{-1.5f, 1.5f};
+    origins = Containers::Array<Vector3>{Containers::NoInit, 107};
+    directions = Containers::Array<Vector3>{Containers::NoInit, 107};
+    for(std::size_t i = 0; i != origins.size(); ++i) {
+        origins[i] = Vector3{distribution(random), distribution(random), distribution(random)}.resized(2.0f);
+        directions[i] = Vector3{distribution(random), distribution(random), distribution(random)} - origins[i];
+    }
+}
+
+void BvhTest::closestHits() {
+    Bvh bvh{Primitives::icosphereSolid(3)};
+
+    Containers::Array<Vector3> origins, directions;
+    randomRays(origins, directions);
+
+    Containers::Array<Bvh::Hit> hits{Containers::NoInit, origins.size()};
+    bvh.closestHits(Containers::stridedArrayView(origins),
+        Containers::stridedArrayView(directions), Constants::inf(),
+        Containers::stridedArrayView(hits));
+
+    std::size_t hitCount = 0;
+    for(std::size_t i = 0; i != origins.size(); ++i) {
+        Containers::Optional<Bvh::Hit> expected = bvh.closestHit(origins[i], directions[i]);
+        if(!expected) {
+            CORRADE_COMPARE(hits[i].triangle, ~UnsignedInt{});
+            continue;
+        }
+
+        ++hitCount;
+        CORRADE_COMPARE(hits[i].triangle, expected->triangle);
+        CORRADE_COMPARE(hits[i].distance, expected->distance);
+        CORRADE_COMPARE(hits[i].barycentric, expected->barycentric);
+    }
+
+    /* Verify the test isn't degenerate */
+    CORRADE_COMPARE_AS(hitCount, std::size_t{0}, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(hitCount, origins.size(), TestSuite::Compare::Less);
+}
+
+void BvhTest::anyHits() {
+    Bvh bvh{Primitives::icosphereSolid(3)};
+
+    Containers::Array<Vector3> origins, directions;
+    randomRays(origins, directions);
+
+    bool hits[107];
+    bvh.anyHits(Containers::stridedArrayView(origins),
+        Containers::stridedArrayView(directions), 1.0f, hits);
+
+    for(std::size_t i = 0; i != origins.size(); ++i) {
+        CORRADE_COMPARE(hits[i], bvh.anyHit(origins[i], directions[i], 1.0f));
+    }
+}
+
+void BvhTest::hitsWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Bvh bvh{quads()};
+    const Vector3 origins[3];
+    const Vector3 directions[2];
+    Bvh::Hit hits[3];
+    bool anyHits[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    bvh.closestHits(origins, directions, 1.0f, hits);
+    bvh.anyHits(origins, origins, 1.0f, anyHits);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::Bvh::closestHits(): expected 3 directions and hits but got 2 and 3\n"
+        "MeshTools::Bvh::anyHits(): expected 3 directions and hits but got 3 and 4\n");
+}
+
+void BvhTest::overlapping() {
+    Bvh bvh{quads()};
+
+    /* Around the diagonal of the first quad */
+    Containers::Array<UnsignedInt> triangles = bvh.overlapping({{-0.1f, -0.1f, -0.5f}, {0.1f, 0.1f, 0.5f}});
+    std::sort(triangles.begin(), triangles.end());
+    CORRADE_COMPARE_AS(triangles, Containers::arrayView<UnsignedInt>({0, 1}),
+        TestSuite::Compare::Container);
+
+    /* Inside the lower right triangle of the second quad */
+    triangles = bvh.overlapping({{0.5f, -0.9f, -1.5f}, {0.9f, -0.6f, -0.5f}});
+    CORRADE_COMPARE_AS(triangles, Containers::arrayView<UnsignedInt>({2}),
+        TestSuite::Compare::Container);
+
+    /* Touching the first quad from above */
+    triangles = bvh.overlapping({{0.5f, -0.9f, 0.0f}, {0.9f, -0.6f, 0.5f}});
+    CORRADE_COMPARE_AS(triangles, Containers::arrayView<UnsignedInt>({0}),
+        TestSuite::Compare::Container);
+
+    /* Inside bounds of both triangles of the second quad but overlapping
+       only the upper left one */
+    triangles = bvh.overlapping({{-0.9f, 0.5f, -1.5f}, {-0.6f, 0.9f, -0.5f}});
+    CORRADE_COMPARE_AS(triangles, Containers::arrayView<UnsignedInt>({3}),
+        TestSuite::Compare::Container);
+
+    /* Between the two quads */
+    CORRADE_VERIFY(bvh.overlapping({{-0.5f, -0.5f, -0.75f}, {0.5f, 0.5f, -0.25f}}).empty());
+}
+
+void BvhTest::benchmarkBuild() {
+    std::size_t nodeCount = 0;
+    CORRADE_BENCHMARK(1) {
+        nodeCount += Bvh{Containers::stridedArrayView(_indices), Containers::stridedArrayView(_positions), 1}.nodes().size();
+    }
+
+    CORRADE_VERIFY(nodeCount);
+}
+
+void BvhTest::benchmarkBuildMultipleThreads() {
+    std::size_t nodeCount = 0;
+    CORRADE_BENCHMARK(1) {
+        nodeCount += Bvh{Containers::stridedArrayView(_indices), Containers::stridedArrayView(_positions)}.nodes().size();
+    }
+
+    CORRADE_VERIFY(nodeCount);
+}
+
+void BvhTest::benchmarkClosestHit() {
+    std::size_t hitCount = 0;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != _origins.size(); ++i)
+            if(_bvh->closestHit(_origins[i], _directions[i])) ++hitCount;
+    }
+
+    CORRADE_VERIFY(hitCount);
+}
+
+void BvhTest::benchmarkClosestHits() {
+    Containers::Array<Bvh::Hit> hits{Containers::NoInit, _origins.size()};
+    CORRADE_BENCHMARK(1) {
+        _bvh->closestHits(Containers::stridedArrayView(_origins),
+            Containers::stridedArrayView(_directions), Constants::inf(),
+            Containers::stridedArrayView(hits));
+    }
+
+    CORRADE_VERIFY(hits[8*16 + 8].triangle != ~UnsignedInt{});
+}
+
+void BvhTest::benchmarkAnyHits() {
+    Containers::Array<bool> hits{Containers::NoInit, _origins.size()};
+    CORRADE_BENCHMARK(1) {
+        _bvh->anyHits(Containers::stridedArrayView(_origins),
+            Containers::stridedArrayView(_directions), Constants::inf(),
+            Containers::stridedArrayView(hits));
+    }
+
+    CORRADE_VERIFY(hits[8*16 + 8]);
+}
+
+void BvhTest::benchmarkClosestHitBruteForce() {
+    /* Testing every triangle, for comparison with the above */
+    std::size_t hitCount = 0;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != _origins.size(); ++i) {
+            Float closest = Constants::inf();
+            for(std::size_t j = 0; j != _indices.size(); j += 3) {
+                const Vector3 a = _positions[_indices[j + 0]];
+                const Vector3 ab = _positions[_indices[j + 1]] - a;
+                const Vector3 ac = _positions[_indices[j + 2]] - a;
+                const Vector3 p = Math::cross(_directions[i], ac);
+                const Float determinant = Math::dot(ab, p);
+                if(determinant == 0.0f) continue;
+                const Vector3 s = _origins[i] - a;
+                const Vector3 q = Math::cross(s, ab);
+                const Float u = Math::dot(s, p)/determinant;
+                const Float v = Math::dot(_directions[i], q)/determinant;
+                const Float distance = Math::dot(ac, q)/determinant;
+                if(u >= 0.0f && v >= 0.0f && u + v <= 1.0f && distance >= 0.0f && distance < closest)
+                    closest = distance;
+            }
+
+            if(closest != Constants::inf()) ++hitCount;
+        }
+    }
+
+    CORRADE_VERIFY(hitCount);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BvhTest)
@@ -27,6 +27,7 @@
 #include <Corrade/Containers/EnumSet.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/DebugStl.h>
 
@@ -47,6 +48,7 @@
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/MeshTools/Compile.h"
+#include "Magnum/MeshTools/Concatenate.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/Shaders/Flat.h"
 #include "Magnum/Shaders/Phong.h"
@@ -103,6 +105,7 @@ struct CompileGLTest: GL::OpenGLTester {
 
         void multipleAttributes();
         void packedAttributes();
+        void parallelInterleave();
 
         void customAttribute();
         void unsupportedAttribute();
@@ -115,6 +118,12 @@ struct CompileGLTest: GL::OpenGLTester {
         void externalBuffers();
         void externalBuffersInvalid();
 
+        #ifndef MAGNUM_TARGET_GLES
+        void drawCommands();
+        void drawCommandsNoMeshes();
+        void drawCommandsNotIndexed();
+        #endif
+
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
 
@@ -251,7 +260,8 @@ CompileGLTest::CompileGLTest() {
     #endif
 
     addTests({&CompileGLTest::multipleAttributes,
-              &CompileGLTest::packedAttributes},
+              &CompileGLTest::packedAttributes,
+              &CompileGLTest::parallelInterleave},
         &CompileGLTest::renderSetup,
         &CompileGLTest::renderTeardown);
 
@@ -269,7 +279,14 @@ CompileGLTest::CompileGLTest() {
         &CompileGLTest::renderSetup,
         &CompileGLTest::renderTeardown);
 
-    addTests({&CompileGLTest::externalBuffersInvalid});
+    addTests({&CompileGLTest::externalBuffersInvalid,
+
+              #ifndef MAGNUM_TARGET_GLES
+              &CompileGLTest::drawCommands,
+              &CompileGLTest::drawCommandsNoMeshes,
+              &CompileGLTest::drawCommandsNotIndexed
+              #endif
+              });
 
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
@@ -1146,6 +1163,61 @@ void CompileGLTest::packedAttributes() {
     #endif
 }
 
+void CompileGLTest::parallelInterleave() {
+    /* Positions and texture coordinates in two separate non-interleaved
+       blocks, to verify they get interleaved into the GL buffer properly */
+    struct Vertices {
+        Vector2 positions[9];
+        Vector2 textureCoordinates[9];
+    } vertexData{{
+        {-0.75f, -0.75f}, { 0.00f, -0.75f}, { 0.75f, -0.75f},
+        {-0.75f,  0.00f}, { 0.00f,  0.00f}, { 0.75f,  0.00f},
+        {-0.75f,  0.75f}, { 0.0f,   0.75f}, { 0.75f,  0.75f}
+    }, {
+        {0.0f, 0.0f}, {0.5f, 0.0f}, {1.0f, 0.0f},
+        {0.0f, 0.5f}, {0.5f, 0.5f}, {1.0f, 0.5f},
+        {0.0f, 1.0f}, {0.5f, 1.0f}, {1.0f, 1.0f}
+    }};
+
+    const UnsignedInt indexData[]{
+        0, 1, 4, 0, 4, 3,
+        1, 2, 5, 1, 5, 4,
+        3, 4, 7, 3, 7, 6,
+        4, 5, 8, 4, 8, 7
+    };
+
+    Trade::MeshData meshData{MeshPrimitive::Triangles,
+        {}, indexData, Trade::MeshIndexData{indexData},
+        {}, Containers::arrayView(&vertexData, 1), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(vertexData.positions)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+                Containers::arrayView(vertexData.textureCoordinates)}
+        }};
+
+    GL::Mesh mesh = compile(meshData, CompileFlag::ParallelInterleave);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    _flatTextured2D
+        .bindTexture(_texture)
+        .draw(mesh);
+
+    /* The output should be the same as in the textured case of
+       twoDimensions() */
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read({{}, {32, 32}}, {PixelFormat::RGBA8Unorm}),
+        Utility::Directory::join(COMPILEGLTEST_TEST_DIR, "textured2D.tga"),
+        /* SwiftShader has some minor off-by-one precision differences,
+            llvmpipe as well */
+        (DebugTools::CompareImageToFile{_manager, 1.75f, 0.22f}));
+}
+
 void CompileGLTest::customAttribute() {
     auto&& instanceData = CustomAttributeWarningData[testCaseInstanceId()];
     setTestCaseDescription(instanceData.name);
@@ -1356,6 +1428,77 @@ void CompileGLTest::externalBuffersInvalid() {
         "MeshTools::compile(): invalid external buffer(s)\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES
+void CompileGLTest::drawCommands() {
+    /* First is non-indexed, so it gets a trivial index buffer generated */
+    Trade::MeshData a{MeshPrimitive::Triangles, 3};
+
+    const UnsignedShort indicesB[]{0, 2, 1, 0, 3, 2};
+    Trade::MeshData b{MeshPrimitive::Triangles, {}, indicesB, Trade::MeshIndexData{indicesB}, 4};
+
+    Trade::MeshData c{MeshPrimitive::Triangles, 6};
+
+    Containers::Array<GL::DrawElementsIndirectCommand> commands = compileDrawCommands({a, b, c});
+    CORRADE_COMPARE(commands.size(), 3);
+
+    CORRADE_COMPARE(commands[0].count, 3);
+    CORRADE_COMPARE(commands[0].instanceCount, 1);
+    CORRADE_COMPARE(commands[0].firstIndex, 0);
+    CORRADE_COMPARE(commands[0].baseVertex, 0);
+    CORRADE_COMPARE(commands[0].baseInstance, 0);
+
+    CORRADE_COMPARE(commands[1].count, 6);
+    CORRADE_COMPARE(commands[1].instanceCount, 1);
+    CORRADE_COMPARE(commands[1].firstIndex, 3);
+    CORRADE_COMPARE(commands[1].baseVertex, 0);
+    CORRADE_COMPARE(commands[1].baseInstance, 1);
+
+    CORRADE_COMPARE(commands[2].count, 6);
+    CORRADE_COMPARE(commands[2].instanceCount, 1);
+    CORRADE_COMPARE(commands[2].firstIndex, 9);
+    CORRADE_COMPARE(commands[2].baseVertex, 0);
+    CORRADE_COMPARE(commands[2].baseInstance, 2);
+
+    /* The ranges should match what concatenate() produces */
+    Trade::MeshData concatenated = concatenate({a, b, c});
+    CORRADE_COMPARE(concatenated.indexCount(), 15);
+    Containers::ArrayView<const UnsignedInt> indices = concatenated.indices<UnsignedInt>();
+    CORRADE_COMPARE_AS(indices.slice(commands[1].firstIndex, commands[1].firstIndex + commands[1].count),
+        Containers::arrayView<UnsignedInt>({3, 5, 4, 3, 6, 5}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices.slice(commands[2].firstIndex, commands[2].firstIndex + commands[2].count),
+        Containers::arrayView<UnsignedInt>({7, 8, 9, 10, 11, 12}),
+        TestSuite::Compare::Container);
+}
+
+void CompileGLTest::drawCommandsNoMeshes() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compileDrawCommands(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>>{});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compileDrawCommands(): no meshes passed\n");
+}
+
+void CompileGLTest::drawCommandsNotIndexed() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Trade::MeshData a{MeshPrimitive::Triangles, 3};
+    Trade::MeshData b{MeshPrimitive::Triangles, 6};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compileDrawCommands({a, b});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compileDrawCommands(): expected at least one indexed mesh\n");
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompileGLTest)
@@ -0,0 +1,366 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Encode.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Tipsify.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct EncodeTest: TestSuite::Tester {
+    explicit EncodeTest();
+
+    void triangleIndices();
+    void triangleIndicesExplicitVertex();
+    void triangleIndicesRoundtrip();
+    void triangleIndicesEmpty();
+    void triangleIndicesNotDivisibleByThree();
+    void triangleIndicesInvalidHeader();
+    void triangleIndicesTooShort();
+    void triangleIndicesUnexpectedEnd();
+    void triangleIndicesTrailingData();
+
+    void vertices();
+    void verticesRoundtrip();
+    void verticesEmpty();
+    void verticesNotContiguous();
+    void verticesInvalidHeader();
+    void verticesUnexpectedEnd();
+    void verticesTrailingData();
+
+    void benchmarkDecodeTriangleIndices();
+    void benchmarkDecodeVertices();
+
+    private:
+        Containers::Array<UnsignedInt> _indices;
+        Containers::Array<char> _encodedIndices;
+        Trade::MeshData _mesh{MeshPrimitive::Triangles, 0};
+        Containers::Array<char> _encodedVertices;
+};
+
+EncodeTest::EncodeTest() {
+    addTests({&EncodeTest::triangleIndices,
+              &EncodeTest::triangleIndicesExplicitVertex,
+              &EncodeTest::triangleIndicesRoundtrip,
+              &EncodeTest::triangleIndicesEmpty,
+              &EncodeTest::triangleIndicesNotDivisibleByThree,
+              &EncodeTest::triangleIndicesInvalidHeader,
+              &EncodeTest::triangleIndicesTooShort,
+              &EncodeTest::triangleIndicesUnexpectedEnd,
+              &EncodeTest::triangleIndicesTrailingData,
+
+              &EncodeTest::vertices,
+              &EncodeTest::verticesRoundtrip,
+              &EncodeTest::verticesEmpty,
+              &EncodeTest::verticesNotContiguous,
+              &EncodeTest::verticesInvalidHeader,
+              &EncodeTest::verticesUnexpectedEnd,
+              &EncodeTest::verticesTrailingData});
+
+    addBenchmarks({&EncodeTest::benchmarkDecodeTriangleIndices,
+                   &EncodeTest::benchmarkDecodeVertices}, 10);
+
+    /* An icosphere with 330k faces, with positions and normals */
+    _mesh = Primitives::icosphereSolid(7);
+    _indices = _mesh.indicesAsArray();
+    _encodedIndices = encodeTriangleIndices(Containers::stridedArrayView(_indices));
+    _encodedVertices = encodeVertices(interleavedData(_mesh));
+}
+
+/* Checks that each triangle is the same as the expected one, possibly
+   rotated */
+void compareTriangles(const Containers::ArrayView<const UnsignedInt> actual, const Containers::ArrayView<const UnsignedInt> expected) {
+    CORRADE_COMPARE(actual.size(), expected.size());
+    for(std::size_t i = 0; i != actual.size(); i += 3) {
+        bool found = false;
+        for(std::size_t rotation = 0; rotation != 3 && !found; ++rotation)
+            found = actual[i + 0] == expected[i + rotation] &&
+                    actual[i + 1] == expected[i + (rotation + 1) % 3] &&
+                    actual[i + 2] == expected[i + (rotation + 2) % 3];
+        if(!found) {
+            CORRADE_COMPARE_AS(actual.slice(i, i + 3), expected.slice(i, i + 3),
+                TestSuite::Compare::Container);
+            return;
+        }
+    }
+}
+
+void EncodeTest::triangleIndices() {
+    /* Two triangles sharing an edge, all vertices referenced in order */
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 3};
+
+    Containers::Array<char> encoded = encodeTriangleIndices(indices);
+    CORRADE_COMPARE_AS(encoded, Containers::arrayView<char>({
+        '\xe0',
+        /* No shared edge and the first vertex being the next, then the
+           shared edge at FIFO position 1 and the next vertex */
+        '\xf0', '\x10',
+        /* Both remaining vertices of the first triangle are the next */
+        '\x00'
+    }), TestSuite::Compare::Container);
+
+    UnsignedInt decoded[6];
+    CORRADE_VERIFY(decodeTriangleIndicesInto(encoded, decoded));
+    CORRADE_COMPARE_AS(Containers::arrayView(decoded), Containers::arrayView(indices),
+        TestSuite::Compare::Container);
+}
+
+void EncodeTest::triangleIndicesExplicitVertex() {
+    const UnsignedInt indices[]{5, 0, 1};
+
+    Containers::Array<char> encoded = encodeTriangleIndices(indices);
+    CORRADE_COMPARE_AS(encoded, Containers::arrayView<char>({
+        '\xe0',
+        /* No shared edge, the first vertex explicit */
+        '\xff',
+        /* Zigzag-encoded difference of 5, then the two next vertices */
+        '\x0a', '\x00'
+    }), TestSuite::Compare::Container);
+
+    UnsignedInt decoded[3];
+    CORRADE_VERIFY(decodeTriangleIndicesInto(encoded, decoded));
+    CORRADE_COMPARE_AS(Containers::arrayView(decoded), Containers::arrayView(indices),
+        TestSuite::Compare::Container);
+}
+
+void EncodeTest::triangleIndicesRoundtrip() {
+    Trade::MeshData icosphere = Primitives::icosphereSolid(3);
+    Containers::Array<UnsignedInt> indices = icosphere.indicesAsArray();
+    tipsifyInPlace(Containers::stridedArrayView(indices), icosphere.vertexCount(), 24);
+
+    Containers::Array<char> encoded = encodeTriangleIndices(Containers::stridedArrayView(indices));
+    /* Should be less than a byte per index */
+    CORRADE_COMPARE_AS(encoded.size(), indices.size(),
+        TestSuite::Compare::Less);
+
+    Containers::Array<UnsignedInt> decoded{Containers::NoInit, indices.size()};
+    CORRADE_VERIFY(decodeTriangleIndicesInto(encoded, Containers::stridedArrayView(decoded)));
+    compareTriangles(decoded, indices);
+}
+
+void EncodeTest::triangleIndicesEmpty() {
+    Containers::Array<char> encoded = encodeTriangleIndices(nullptr);
+    CORRADE_COMPARE_AS(encoded, Containers::arrayView<char>({'\xe0'}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(decodeTriangleIndicesInto(encoded, nullptr));
+}
+
+void EncodeTest::triangleIndicesNotDivisibleByThree() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    encodeTriangleIndices(indices);
+    decodeTriangleIndicesInto({}, indices);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeTriangleIndices(): expected index count divisible by 3, got 4\n"
+        "MeshTools::decodeTriangleIndicesInto(): expected index count divisible by 3, got 4\n");
+}
+
+void EncodeTest::triangleIndicesInvalidHeader() {
+    const char data[]{'\xa0', '\xf0', '\x00'};
+    UnsignedInt indices[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeTriangleIndicesInto(data, indices));
+    CORRADE_VERIFY(!decodeTriangleIndicesInto(nullptr, indices));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeTriangleIndicesInto(): invalid header\n"
+        "MeshTools::decodeTriangleIndicesInto(): invalid header\n");
+}
+
+void EncodeTest::triangleIndicesTooShort() {
+    const char data[]{'\xe0', '\xf0', '\x00'};
+    UnsignedInt indices[9];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeTriangleIndicesInto(data, indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeTriangleIndicesInto(): expected at least 4 bytes for 3 triangles but got 3\n");
+}
+
+void EncodeTest::triangleIndicesUnexpectedEnd() {
+    /* The explicit vertex data are missing */
+    const char data[]{'\xe0', '\xff', '\x8a'};
+    UnsignedInt indices[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeTriangleIndicesInto(data, indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeTriangleIndicesInto(): unexpected end of data\n");
+}
+
+void EncodeTest::triangleIndicesTrailingData() {
+    const char data[]{'\xe0', '\xf0', '\x00', '\x00'};
+    UnsignedInt indices[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeTriangleIndicesInto(data, indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeTriangleIndicesInto(): expected 3 bytes for 1 triangles but got 4\n");
+}
+
+void EncodeTest::vertices() {
+    const UnsignedByte vertices[]{1, 3};
+
+    Containers::Array<char> encoded = encodeVertices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(vertices)));
+    CORRADE_COMPARE_AS(encoded, Containers::arrayView<char>({
+        '\xa0',
+        /* A single group with 4-bit values */
+        '\x02',
+        /* Zigzag-encoded differences 1 and 2, padded to a whole group */
+        '\x42', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00'
+    }), TestSuite::Compare::Container);
+
+    UnsignedByte decoded[2];
+    CORRADE_VERIFY(decodeVerticesInto(encoded, Containers::arrayCast<2, char>(Containers::stridedArrayView(decoded))));
+    CORRADE_COMPARE_AS(Containers::arrayView(decoded), Containers::arrayView(vertices),
+        TestSuite::Compare::Container);
+}
+
+void EncodeTest::verticesRoundtrip() {
+    /* Crossing the block boundary, with every attribute having a different
+       bit width */
+    struct Vertex {
+        UnsignedInt constant;
+        UnsignedInt incrementing;
+        Vector3 position;
+    };
+    Containers::Array<Vertex> vertices{Containers::NoInit, 1000};
+    for(std::size_t i = 0; i != vertices.size(); ++i) {
+        vertices[i].constant = 0xdeadbeef;
+        vertices[i].incrementing = i;
+        vertices[i].position = {Float(i), Float(i % 7), Float(i*i)};
+    }
+
+    Containers::Array<char> encoded = encodeVertices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(vertices)));
+    CORRADE_COMPARE_AS(encoded.size(), vertices.size()*sizeof(Vertex),
+        TestSuite::Compare::Less);
+
+    Containers::Array<Vertex> decoded{Containers::NoInit, vertices.size()};
+    CORRADE_VERIFY(decodeVerticesInto(encoded, Containers::arrayCast<2, char>(Containers::stridedArrayView(decoded))));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const char>(Containers::arrayView(decoded)),
+        Containers::arrayCast<const char>(Containers::arrayView(vertices)),
+        TestSuite::Compare::Container);
+}
+
+void EncodeTest::verticesEmpty() {
+    char vertices[1];
+    Containers::Array<char> encoded = encodeVertices(Containers::StridedArrayView2D<const char>{vertices, {0, 12}});
+    CORRADE_COMPARE_AS(encoded, Containers::arrayView<char>({'\xa0'}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(decodeVerticesInto(encoded, Containers::StridedArrayView2D<char>{vertices, {0, 12}}));
+}
+
+void EncodeTest::verticesNotContiguous() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char data[8];
+    const Containers::StridedArrayView2D<char> view = Containers::StridedArrayView2D<char>{data, {2, 4}}.every({1, 2});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    encodeVertices(view);
+    decodeVerticesInto({}, view);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeVertices(): second view dimension is not contiguous\n"
+        "MeshTools::decodeVerticesInto(): second view dimension is not contiguous\n");
+}
+
+void EncodeTest::verticesInvalidHeader() {
+    const char data[]{'\xe0'};
+    char vertices[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeVerticesInto(data, Containers::StridedArrayView2D<char>{vertices, {1, 1}}));
+    CORRADE_VERIFY(!decodeVerticesInto(nullptr, Containers::StridedArrayView2D<char>{vertices, {1, 1}}));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeVerticesInto(): invalid header\n"
+        "MeshTools::decodeVerticesInto(): invalid header\n");
+}
+
+void EncodeTest::verticesUnexpectedEnd() {
+    /* The group is 4-bit but the data is missing */
+    const char data[]{'\xa0', '\x02', '\x42'};
+    char vertices[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeVerticesInto(data, Containers::StridedArrayView2D<char>{vertices, {2, 1}}));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeVerticesInto(): unexpected end of data\n");
+}
+
+void EncodeTest::verticesTrailingData() {
+    const char data[]{'\xa0', '\x00', '\x00'};
+    char vertices[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeVerticesInto(data, Containers::StridedArrayView2D<char>{vertices, {2, 1}}));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeVerticesInto(): expected 2 bytes for 2 vertices of 1 bytes but got 3\n");
+}
+
+void EncodeTest::benchmarkDecodeTriangleIndices() {
+    Containers::Array<UnsignedInt> decoded{Containers::NoInit, _indices.size()};
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(decodeTriangleIndicesInto(_encodedIndices, Containers::stridedArrayView(decoded)));
+    }
+
+    CORRADE_COMPARE(decoded.size(), _indices.size());
+}
+
+void EncodeTest::benchmarkDecodeVertices() {
+    const Containers::StridedArrayView2D<const char> vertices = interleavedData(_mesh);
+    Containers::Array<char> decoded{Containers::NoInit, vertices.size()[0]*vertices.size()[1]};
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(decodeVerticesInto(_encodedVertices, Containers::StridedArrayView2D<char>{decoded, vertices.size()}));
+    }
+
+    CORRADE_COMPARE_AS(decoded.size(), _encodedVertices.size(),
+        TestSuite::Compare::Greater);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::EncodeTest)
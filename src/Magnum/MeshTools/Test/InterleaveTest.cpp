@@ -27,6 +27,7 @@
 #include <vector>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Endianness.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -92,6 +93,12 @@ struct InterleaveTest: Corrade::TestSuite::Tester {
     void interleaveMeshDataAlreadyInterleavedMove();
     void interleaveMeshDataAlreadyInterleavedMoveNonOwned();
     void interleaveMeshDataNothing();
+
+    void interleaveMeshDataInto();
+    void interleaveMeshDataIntoIndexed();
+    void interleaveMeshDataIntoMultipleThreads();
+    void interleaveMeshDataIntoNothing();
+    void interleaveMeshDataIntoTooSmall();
 };
 
 InterleaveTest::InterleaveTest() {
@@ -145,7 +152,13 @@ InterleaveTest::InterleaveTest() {
               &InterleaveTest::interleaveMeshDataExtraOffsetOnly,
               &InterleaveTest::interleaveMeshDataAlreadyInterleavedMove,
               &InterleaveTest::interleaveMeshDataAlreadyInterleavedMoveNonOwned,
-              &InterleaveTest::interleaveMeshDataNothing});
+              &InterleaveTest::interleaveMeshDataNothing,
+
+              &InterleaveTest::interleaveMeshDataInto,
+              &InterleaveTest::interleaveMeshDataIntoIndexed,
+              &InterleaveTest::interleaveMeshDataIntoMultipleThreads,
+              &InterleaveTest::interleaveMeshDataIntoNothing,
+              &InterleaveTest::interleaveMeshDataIntoTooSmall});
 }
 
 void InterleaveTest::attributeCount() {
@@ -1201,6 +1214,120 @@ void InterleaveTest::interleaveMeshDataNothing() {
     CORRADE_COMPARE(interleaved.vertexData().size(), 0);
 }
 
+void InterleaveTest::interleaveMeshDataInto() {
+    struct {
+        Vector2 positions[3];
+        Vector3 normals[3];
+    } vertexData{
+        {{1.3f, 0.3f}, {0.87f, 1.1f}, {1.0f, -0.5f}},
+        {Vector3::xAxis(), Vector3::yAxis(), Vector3::zAxis()}
+    };
+    Trade::MeshData data{MeshPrimitive::TriangleFan, {},
+        Containers::arrayView(&vertexData, 1), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(vertexData.positions)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal, Containers::arrayView(vertexData.normals)}
+        }};
+
+    /* Larger than needed to verify only the prefix is used */
+    char destination[3*20 + 7];
+    Trade::MeshData interleaved = MeshTools::interleaveInto(data, destination);
+    CORRADE_VERIFY(MeshTools::isInterleaved(interleaved));
+    CORRADE_COMPARE(interleaved.primitive(), MeshPrimitive::TriangleFan);
+    CORRADE_VERIFY(!interleaved.isIndexed());
+    CORRADE_COMPARE(interleaved.vertexDataFlags(), Trade::DataFlag::Mutable);
+    CORRADE_COMPARE(interleaved.vertexData().data(), static_cast<const void*>(destination));
+    CORRADE_COMPARE(interleaved.vertexData().size(), 3*20);
+    CORRADE_COMPARE(interleaved.attributeCount(), 2);
+    CORRADE_COMPARE(interleaved.attributeStride(0), 20);
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector2>(Trade::MeshAttribute::Position),
+        Containers::stridedArrayView(vertexData.positions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        Containers::stridedArrayView(vertexData.normals),
+        TestSuite::Compare::Container);
+}
+
+void InterleaveTest::interleaveMeshDataIntoIndexed() {
+    const UnsignedShort indexData[]{0, 2, 1};
+    Vector2 positions[]{{1.3f, 0.3f}, {0.87f, 1.1f}, {1.0f, -0.5f}};
+    Trade::MeshData data{MeshPrimitive::Triangles,
+        {}, indexData, Trade::MeshIndexData{indexData},
+        {}, Containers::arrayView(positions), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }};
+
+    Vector2 destination[3];
+    Trade::MeshData interleaved = MeshTools::interleaveInto(data, Containers::arrayCast<char>(Containers::arrayView(destination)));
+    CORRADE_VERIFY(interleaved.isIndexed());
+    /* The index data are referenced, not copied */
+    CORRADE_COMPARE(interleaved.indexDataFlags(), Trade::DataFlags{});
+    CORRADE_COMPARE(interleaved.indexData().data(), static_cast<const void*>(indexData));
+    CORRADE_COMPARE(interleaved.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(Containers::arrayView(destination),
+        Containers::arrayView(positions),
+        TestSuite::Compare::Container);
+}
+
+void InterleaveTest::interleaveMeshDataIntoMultipleThreads() {
+    /* Big enough for each of the four threads to get over the minimal per-
+       thread size */
+    const UnsignedInt vertexCount = 300000;
+    Containers::Array<Vector3> positions{Containers::NoInit, vertexCount};
+    Containers::Array<Vector2> textureCoordinates{Containers::NoInit, vertexCount};
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        positions[i] = Vector3{Float(i), Float(i%13), -Float(i)};
+        textureCoordinates[i] = Vector2{Float(i%7), Float(i)};
+    }
+
+    /* Put both into a single non-interleaved vertex buffer */
+    Containers::Array<char> vertexData{Containers::NoInit, vertexCount*(sizeof(Vector3) + sizeof(Vector2))};
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(positions)), vertexData.prefix(vertexCount*sizeof(Vector3)));
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(textureCoordinates)), vertexData.suffix(vertexCount*sizeof(Vector3)));
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertexData, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayCast<const Vector3>(vertexData.prefix(vertexCount*sizeof(Vector3)))},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            Containers::arrayCast<const Vector2>(vertexData.suffix(vertexCount*sizeof(Vector3)))}
+    }};
+
+    Containers::Array<char> destination{Containers::NoInit, vertexData.size()};
+    Trade::MeshData interleaved = MeshTools::interleaveInto(mesh, destination, 4);
+    CORRADE_VERIFY(MeshTools::isInterleaved(interleaved));
+    CORRADE_COMPARE(interleaved.vertexCount(), vertexCount);
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::stridedArrayView(positions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+        Containers::stridedArrayView(textureCoordinates),
+        TestSuite::Compare::Container);
+}
+
+void InterleaveTest::interleaveMeshDataIntoNothing() {
+    Trade::MeshData interleaved = MeshTools::interleaveInto(Trade::MeshData{MeshPrimitive::Points, 2}, nullptr);
+    CORRADE_COMPARE(interleaved.attributeCount(), 0);
+    CORRADE_COMPARE(interleaved.vertexCount(), 2);
+    CORRADE_COMPARE(interleaved.vertexData().size(), 0);
+}
+
+void InterleaveTest::interleaveMeshDataIntoTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vector2 positions[3]{};
+    Trade::MeshData data{MeshPrimitive::Triangles,
+        {}, Containers::arrayView(positions), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+        }};
+
+    char destination[23];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::interleaveInto(data, destination);
+    CORRADE_COMPARE(out.str(), "MeshTools::interleaveInto(): the data buffer is too small, expected 24 but got 23\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::InterleaveTest)
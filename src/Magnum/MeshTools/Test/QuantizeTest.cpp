@@ -0,0 +1,378 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/MeshTools/Quantize.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct QuantizeTest: TestSuite::Tester {
+    explicit QuantizeTest();
+
+    void quantize();
+    void quantizeByte();
+    void quantizeNotPreciseEnough();
+    void quantizeTextureCoordinatesOutOfRange();
+    void quantizeTangents();
+    void quantizePassthrough();
+    void quantizeIndexed();
+    void quantizeEmpty();
+    void quantizeImplementationSpecificFormat();
+};
+
+QuantizeTest::QuantizeTest() {
+    addTests({&QuantizeTest::quantize,
+              &QuantizeTest::quantizeByte,
+              &QuantizeTest::quantizeNotPreciseEnough,
+              &QuantizeTest::quantizeTextureCoordinatesOutOfRange,
+              &QuantizeTest::quantizeTangents,
+              &QuantizeTest::quantizePassthrough,
+              &QuantizeTest::quantizeIndexed,
+              &QuantizeTest::quantizeEmpty,
+              &QuantizeTest::quantizeImplementationSpecificFormat});
+}
+
+const struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+    Vector2 textureCoordinates;
+} Vertices[]{
+    {{-2.0f, 1.0f, 0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.25f}},
+    {{3.0f, -1.0f, 0.25f}, {0.6f, 0.0f, 0.8f}, {1.0f, 0.5f}},
+    {{0.5f, 2.5f, -1.0f}, {0.0f, -0.8f, 0.6f}, {0.5f, 1.0f}},
+    {{1.25f, 0.0f, 0.75f}, {-0.48f, 0.6f, 0.64f}, {0.125f, 0.75f}}
+};
+
+Trade::MeshData mesh() {
+    return Trade::MeshData{MeshPrimitive::Triangles, {}, Vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::stridedArrayView(Vertices, &Vertices[0].position,
+                Containers::arraySize(Vertices), sizeof(Vertex))},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            Containers::stridedArrayView(Vertices, &Vertices[0].normal,
+                Containers::arraySize(Vertices), sizeof(Vertex))},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            Containers::stridedArrayView(Vertices, &Vertices[0].textureCoordinates,
+                Containers::arraySize(Vertices), sizeof(Vertex))}
+    }};
+}
+
+void QuantizeTest::quantize() {
+    Trade::MeshData out{MeshPrimitive::Points, 0};
+    Matrix4 positionTransformation;
+    Matrix3 textureCoordinateTransformation;
+    std::tie(out, positionTransformation, textureCoordinateTransformation) = MeshTools::quantize(mesh());
+
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(!out.isIndexed());
+    CORRADE_COMPARE(out.vertexCount(), 4);
+    CORRADE_COMPARE(out.attributeCount(), 3);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::Position), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::Normal), VertexFormat::Vector3bNormalized);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::TextureCoordinates), VertexFormat::Vector2usNormalized);
+
+    /* Each attribute is padded to four bytes, which makes the vertex half
+       the original size */
+    CORRADE_COMPARE(out.attributeOffset(Trade::MeshAttribute::Position), 0);
+    CORRADE_COMPARE(out.attributeOffset(Trade::MeshAttribute::Normal), 8);
+    CORRADE_COMPARE(out.attributeOffset(Trade::MeshAttribute::TextureCoordinates), 12);
+    CORRADE_COMPARE(out.attributeStride(Trade::MeshAttribute::Position), 16);
+    CORRADE_COMPARE(out.vertexData().size(), sizeof(Vertices)/2);
+
+    /* Bounding box from (-2, -1, -1) to (3, 2.5, 0.75), the largest side is
+       5 units. Texture coordinates are in range so there's no transform. */
+    CORRADE_COMPARE(positionTransformation,
+        Matrix4::translation({0.5f, 0.75f, -0.125f})*Matrix4::scaling(Vector3{2.5f}));
+    CORRADE_COMPARE(textureCoordinateTransformation, Matrix3{});
+
+    Containers::StridedArrayView1D<const Vector3s> positions = out.attribute<Vector3s>(Trade::MeshAttribute::Position);
+    Containers::StridedArrayView1D<const Vector3b> normals = out.attribute<Vector3b>(Trade::MeshAttribute::Normal);
+    Containers::StridedArrayView1D<const Vector2us> textureCoordinates = out.attribute<Vector2us>(Trade::MeshAttribute::TextureCoordinates);
+    for(std::size_t i = 0; i != Containers::arraySize(Vertices); ++i) {
+        CORRADE_COMPARE_AS(Math::abs(positionTransformation.transformPoint(Math::unpack<Vector3>(positions[i])) - Vertices[i].position).max(),
+            1.0e-4f*5.0f, TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(Math::abs(Math::unpack<Vector3>(normals[i]) - Vertices[i].normal).max(),
+            5.0e-3f, TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(Math::abs(Math::unpack<Vector2>(textureCoordinates[i]) - Vertices[i].textureCoordinates).max(),
+            1.0e-4f, TestSuite::Compare::LessOrEqual);
+    }
+
+    /* Values on the bounding box edges map to the format limits */
+    CORRADE_COMPARE(positions[0], (Vector3s{-32767, 3277, 8192}));
+    CORRADE_COMPARE(positions[1], (Vector3s{32767, -22937, 4915}));
+    CORRADE_COMPARE(normals[0], (Vector3b{0, 127, 0}));
+    CORRADE_COMPARE(textureCoordinates[2], (Vector2us{32768, 65535}));
+}
+
+void QuantizeTest::quantizeByte() {
+    Trade::MeshData out{MeshPrimitive::Points, 0};
+    Matrix4 positionTransformation;
+    Matrix3 textureCoordinateTransformation;
+    std::tie(out, positionTransformation, textureCoordinateTransformation) = MeshTools::quantize(mesh(), 1.0e-2f, 1.0e-2f, 1.0e-2f);
+
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::Position), VertexFormat::Vector3bNormalized);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::Normal), VertexFormat::Vector3bNormalized);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::TextureCoordinates), VertexFormat::Vector2ubNormalized);
+    CORRADE_COMPARE(out.attributeStride(Trade::MeshAttribute::Position), 12);
+
+    Containers::StridedArrayView1D<const Vector3b> positions = out.attribute<Vector3b>(Trade::MeshAttribute::Position);
+    Containers::StridedArrayView1D<const Vector2ub> textureCoordinates = out.attribute<Vector2ub>(Trade::MeshAttribute::TextureCoordinates);
+    for(std::size_t i = 0; i != Containers::arraySize(Vertices); ++i) {
+        CORRADE_COMPARE_AS(Math::abs(positionTransformation.transformPoint(Math::unpack<Vector3>(positions[i])) - Vertices[i].position).max(),
+            1.0e-2f*5.0f, TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(Math::abs(Math::unpack<Vector2>(textureCoordinates[i]) - Vertices[i].textureCoordinates).max(),
+            1.0e-2f, TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void QuantizeTest::quantizeNotPreciseEnough() {
+    Trade::MeshData out{MeshPrimitive::Points, 0};
+    Matrix4 positionTransformation;
+    Matrix3 textureCoordinateTransformation;
+    std::tie(out, positionTransformation, textureCoordinateTransformation) = MeshTools::quantize(mesh(), 1.0e-6f, 1.0e-6f, 1.0e-6f);
+
+    /* Even 16-bit formats aren't enough, so everything stays as it was */
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::Position), VertexFormat::Vector3);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::Normal), VertexFormat::Vector3);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::TextureCoordinates), VertexFormat::Vector2);
+    CORRADE_COMPARE(out.attributeStride(Trade::MeshAttribute::Position), sizeof(Vertex));
+    CORRADE_COMPARE(positionTransformation, Matrix4{});
+    CORRADE_COMPARE(textureCoordinateTransformation, Matrix3{});
+
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::stridedArrayView(Vertices, &Vertices[0].position,
+            Containers::arraySize(Vertices), sizeof(Vertex)),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        Containers::stridedArrayView(Vertices, &Vertices[0].normal,
+            Containers::arraySize(Vertices), sizeof(Vertex)),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+        Containers::stridedArrayView(Vertices, &Vertices[0].textureCoordinates,
+            Containers::arraySize(Vertices), sizeof(Vertex)),
+        TestSuite::Compare::Container);
+}
+
+void QuantizeTest::quantizeTextureCoordinatesOutOfRange() {
+    const Vector2 textureCoordinates[]{
+        {-1.0f, 0.0f},
+        {3.0f, 0.5f},
+        {1.0f, 2.0f}
+    };
+
+    Trade::MeshData out{MeshPrimitive::Points, 0};
+    Matrix4 positionTransformation;
+    Matrix3 textureCoordinateTransformation;
+    std::tie(out, positionTransformation, textureCoordinateTransformation) = MeshTools::quantize(Trade::MeshData{MeshPrimitive::Triangles, {}, textureCoordinates, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            Containers::arrayView(textureCoordinates)}
+    }});
+
+    /* The bounding box is 4x2 units, so the error is four times larger and
+       8 bits are not enough for the default bound */
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::TextureCoordinates), VertexFormat::Vector2usNormalized);
+    CORRADE_COMPARE(positionTransformation, Matrix4{});
+    CORRADE_COMPARE(textureCoordinateTransformation,
+        Matrix3::translation({-1.0f, 0.0f})*Matrix3::scaling({4.0f, 2.0f}));
+
+    Containers::StridedArrayView1D<const Vector2us> quantized = out.attribute<Vector2us>(Trade::MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(quantized[0], (Vector2us{0, 0}));
+    CORRADE_COMPARE(quantized[1], (Vector2us{65535, 16384}));
+    CORRADE_COMPARE(quantized[2], (Vector2us{32768, 65535}));
+    for(std::size_t i = 0; i != Containers::arraySize(textureCoordinates); ++i)
+        CORRADE_COMPARE_AS(Math::abs(textureCoordinateTransformation.transformPoint(Math::unpack<Vector2>(quantized[i])) - textureCoordinates[i]).max(),
+            1.0e-4f, TestSuite::Compare::LessOrEqual);
+}
+
+void QuantizeTest::quantizeTangents() {
+    const struct {
+        Vector4 tangent;
+        Vector3 bitangent;
+    } vertices[]{
+        {{1.0f, 0.0f, 0.0f, -1.0f}, {0.0f, 0.0f, 1.0f}},
+        {{0.0f, 0.6f, -0.8f, 1.0f}, {-1.0f, 0.0f, 0.0f}}
+    };
+
+    Trade::MeshData out = std::get<0>(MeshTools::quantize(Trade::MeshData{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Tangent,
+            Containers::stridedArrayView(vertices, &vertices[0].tangent,
+                Containers::arraySize(vertices), sizeof(vertices[0]))},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Bitangent,
+            Containers::stridedArrayView(vertices, &vertices[0].bitangent,
+                Containers::arraySize(vertices), sizeof(vertices[0]))}
+    }}, 1.0e-4f, 1.0e-4f));
+
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::Tangent), VertexFormat::Vector4sNormalized);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::Bitangent), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE(out.attributeOffset(Trade::MeshAttribute::Bitangent), 8);
+    CORRADE_COMPARE(out.attributeStride(Trade::MeshAttribute::Tangent), 16);
+    CORRADE_COMPARE_AS(out.attribute<Vector4s>(Trade::MeshAttribute::Tangent), Containers::arrayView<Vector4s>({
+        {32767, 0, 0, -32767},
+        {0, 19660, -26214, 32767}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector3s>(Trade::MeshAttribute::Bitangent), Containers::arrayView<Vector3s>({
+        {0, 0, 32767},
+        {-32767, 0, 0}
+    }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::quantizePassthrough() {
+    const struct {
+        Vector3 position;
+        Color3ub color;
+        Vector3h normal;
+        UnsignedShort custom[2];
+        Vector3 secondPosition;
+    } vertices[]{
+        {{0.0f, 0.0f, 0.0f}, {0xff, 0x33, 0x66}, {}, {15, 3}, {1.0f, 2.0f, 3.0f}},
+        {{2.0f, 0.0f, 0.0f}, {0x99, 0xcc, 0x00}, {}, {7, 22}, {4.0f, 5.0f, 6.0f}}
+    };
+
+    Trade::MeshData out{MeshPrimitive::Points, 0};
+    Matrix4 positionTransformation;
+    std::tie(out, positionTransformation, std::ignore) = MeshTools::quantize(Trade::MeshData{MeshPrimitive::Lines, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::stridedArrayView(vertices, &vertices[0].position,
+                Containers::arraySize(vertices), sizeof(vertices[0]))},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Color,
+            Containers::stridedArrayView(vertices, &vertices[0].color,
+                Containers::arraySize(vertices), sizeof(vertices[0]))},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            Containers::stridedArrayView(vertices, &vertices[0].normal,
+                Containers::arraySize(vertices), sizeof(vertices[0]))},
+        Trade::MeshAttributeData{Trade::meshAttributeCustom(3),
+            VertexFormat::UnsignedShort,
+            Containers::stridedArrayView(vertices, &vertices[0].custom,
+                Containers::arraySize(vertices), sizeof(vertices[0])), 2},
+        /* Only the first position attribute gets quantized */
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::stridedArrayView(vertices, &vertices[0].secondPosition,
+                Containers::arraySize(vertices), sizeof(vertices[0]))}
+    }});
+
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(out.attributeCount(), 5);
+    CORRADE_COMPARE(out.attributeFormat(0), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE(out.attributeFormat(1), VertexFormat::Vector3ubNormalized);
+    CORRADE_COMPARE(out.attributeFormat(2), VertexFormat::Vector3h);
+    CORRADE_COMPARE(out.attributeName(3), Trade::meshAttributeCustom(3));
+    CORRADE_COMPARE(out.attributeFormat(3), VertexFormat::UnsignedShort);
+    CORRADE_COMPARE(out.attributeArraySize(3), 2);
+    CORRADE_COMPARE(out.attributeFormat(4), VertexFormat::Vector3);
+    CORRADE_COMPARE(out.attributeOffset(1), 8);
+    CORRADE_COMPARE(out.attributeOffset(2), 12);
+    CORRADE_COMPARE(out.attributeOffset(3), 20);
+    CORRADE_COMPARE(out.attributeOffset(4), 24);
+    CORRADE_COMPARE(out.attributeStride(0), 36);
+
+    CORRADE_COMPARE(positionTransformation,
+        Matrix4::translation({1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE_AS(out.attribute<Vector3s>(0), Containers::arrayView<Vector3s>({
+        {-32767, 0, 0},
+        {32767, 0, 0}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Color3ub>(1), Containers::arrayView<Color3ub>({
+        {0xff, 0x33, 0x66},
+        {0x99, 0xcc, 0x00}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS((Containers::arrayCast<1, const Vector2us>(out.attribute<UnsignedShort[]>(3))), Containers::arrayView<Vector2us>({
+        {15, 3},
+        {7, 22}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(4), Containers::arrayView<Vector3>({
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::quantizeIndexed() {
+    const UnsignedShort indices[]{0, 1, 2, 2, 1, 3};
+
+    Trade::MeshData out = std::get<0>(MeshTools::quantize(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, Vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::stridedArrayView(Vertices, &Vertices[0].position,
+                    Containers::arraySize(Vertices), sizeof(Vertex))}
+        }}));
+
+    CORRADE_VERIFY(out.isIndexed());
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(out.indices<UnsignedShort>(),
+        Containers::arrayView(indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.vertexCount(), 4);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::Position), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE(out.attributeStride(Trade::MeshAttribute::Position), 8);
+}
+
+void QuantizeTest::quantizeEmpty() {
+    Trade::MeshData out{MeshPrimitive::Points, 0};
+    Matrix4 positionTransformation;
+    Matrix3 textureCoordinateTransformation;
+    std::tie(out, positionTransformation, textureCoordinateTransformation) = MeshTools::quantize(Trade::MeshData{MeshPrimitive::Triangles, nullptr, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            VertexFormat::Vector3, nullptr},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            VertexFormat::Vector2, nullptr}
+    }});
+
+    CORRADE_COMPARE(out.vertexCount(), 0);
+    CORRADE_COMPARE(out.attributeCount(), 2);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::Position), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::TextureCoordinates), VertexFormat::Vector2usNormalized);
+    CORRADE_COMPARE(positionTransformation, Matrix4{});
+    CORRADE_COMPARE(textureCoordinateTransformation, Matrix3{});
+}
+
+void QuantizeTest::quantizeImplementationSpecificFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::quantize(Trade::MeshData{MeshPrimitive::Triangles, nullptr, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            VertexFormat::Vector3, nullptr},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            vertexFormatWrap(0xdead), nullptr}
+    }});
+    CORRADE_COMPARE(out.str(), "MeshTools::quantize(): attribute 1 has an implementation-specific format 0xdead\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::QuantizeTest)
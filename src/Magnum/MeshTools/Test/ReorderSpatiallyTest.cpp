@@ -0,0 +1,343 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/GenerateNormals.h"
+#include "Magnum/MeshTools/ReorderSpatially.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct ReorderSpatiallyTest: TestSuite::Tester {
+    explicit ReorderSpatiallyTest();
+
+    void mortonCodes();
+    void mortonCodesFlat();
+    void mortonCodesEmpty();
+    void mortonCodesWrongSize();
+
+    void reorder();
+    void reorderFaces();
+    void reorderMultipleThreads();
+    void reorderNotIndexed();
+    void reorderNoPositions();
+    void reorderFacesNotTriangles();
+
+    void benchmarkSetup();
+
+    void benchmarkSmoothNormalsShuffled();
+    void benchmarkSmoothNormalsReordered();
+
+    private:
+        Containers::Array<UnsignedInt> _shuffledIndices, _reorderedIndices;
+        Containers::Array<Vector3> _shuffledPositions, _reorderedPositions;
+};
+
+ReorderSpatiallyTest::ReorderSpatiallyTest() {
+    addTests({&ReorderSpatiallyTest::mortonCodes,
+              &ReorderSpatiallyTest::mortonCodesFlat,
+              &ReorderSpatiallyTest::mortonCodesEmpty,
+              &ReorderSpatiallyTest::mortonCodesWrongSize,
+
+              &ReorderSpatiallyTest::reorder,
+              &ReorderSpatiallyTest::reorderFaces,
+              &ReorderSpatiallyTest::reorderMultipleThreads,
+              &ReorderSpatiallyTest::reorderNotIndexed,
+              &ReorderSpatiallyTest::reorderNoPositions,
+              &ReorderSpatiallyTest::reorderFacesNotTriangles});
+
+    addBenchmarks({&ReorderSpatiallyTest::benchmarkSmoothNormalsShuffled,
+                   &ReorderSpatiallyTest::benchmarkSmoothNormalsReordered}, 10,
+        &ReorderSpatiallyTest::benchmarkSetup,
+        &ReorderSpatiallyTest::benchmarkSetup);
+}
+
+void ReorderSpatiallyTest::benchmarkSetup() {
+    /* Used as both setup and teardown of the benchmarks. The data is built
+       only the first time, so it's not rebuilt for every batch and not built
+       at all if benchmarks are skipped. */
+    if(!_shuffledPositions.empty()) return;
+
+    /* An icosphere with 160k vertices and 330k faces with vertices shuffled
+       randomly, to simulate for example a 3D scan that has no sensible vertex
+       order. The reordered variant is made from it using reorderSpatially(). */
+    Trade::MeshData icosphere = Primitives::icosphereSolid(7);
+    const Containers::StridedArrayView1D<const Vector3> positions = icosphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+    Containers::Array<UnsignedInt> shuffle{Containers::NoInit, positions.size()};
+    for(std::size_t i = 0; i != shuffle.size(); ++i) shuffle[i] = i;
+    std::shuffle(shuffle.begin(), shuffle.end(), std::minstd_rand{});
+
+    _shuffledPositions = Containers::Array<Vector3>{Containers::NoInit, positions.size()};
+    for(std::size_t i = 0; i != shuffle.size(); ++i)
+        _shuffledPositions[shuffle[i]] = positions[i];
+    _shuffledIndices = icosphere.indicesAsArray();
+    for(UnsignedInt& i: _shuffledIndices) i = shuffle[i];
+
+    Trade::MeshData shuffled{MeshPrimitive::Triangles,
+        {}, Containers::arrayView(_shuffledIndices), Trade::MeshIndexData{Containers::arrayView(_shuffledIndices)},
+        {}, Containers::arrayView(_shuffledPositions), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(_shuffledPositions)}
+        }};
+    Trade::MeshData reordered = reorderSpatially(shuffled, ReorderSpatiallyFlag::Faces);
+    _reorderedPositions = reordered.positions3DAsArray();
+    _reorderedIndices = reordered.indicesAsArray();
+}
+
+void ReorderSpatiallyTest::mortonCodes() {
+    const Vector3 points[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 1.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {0.5f, 0.5f, 0.5f}
+    };
+
+    CORRADE_COMPARE_AS(MeshTools::mortonCodes(points), Containers::arrayView<UnsignedInt>({
+        0,
+        0x3fffffff,
+        0x09249249,
+        0x12492492,
+        0x24924924,
+        /* 511 in all axes, so all bits except the topmost triplet */
+        0x07ffffff
+    }), TestSuite::Compare::Container);
+}
+
+void ReorderSpatiallyTest::mortonCodesFlat() {
+    /* The Z axis has zero extent, so it contributes nothing */
+    const Vector3 points[]{
+        {-1.0f, 0.0f, 5.0f},
+        {1.0f, 2.0f, 5.0f}
+    };
+
+    CORRADE_COMPARE_AS(MeshTools::mortonCodes(points), Containers::arrayView<UnsignedInt>({
+        0,
+        0x1b6db6db
+    }), TestSuite::Compare::Container);
+}
+
+void ReorderSpatiallyTest::mortonCodesEmpty() {
+    CORRADE_COMPARE(MeshTools::mortonCodes(nullptr).size(), 0);
+}
+
+void ReorderSpatiallyTest::mortonCodesWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Vector3 points[3];
+    UnsignedInt codes[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    mortonCodesInto(points, codes);
+    CORRADE_COMPARE(out.str(), "MeshTools::mortonCodesInto(): expected 3 items in the output but got 4\n");
+}
+
+/* Four vertices on a line, in a random order. The texture coordinates are
+   there to verify all attributes get reordered. */
+const struct Vertex {
+    Vector3 position;
+    Vector2 textureCoordinates;
+} Vertices[]{
+    {{3.0f, 0.0f, 0.0f}, {3.0f, 0.0f}},
+    {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
+    {{2.0f, 0.0f, 0.0f}, {2.0f, 0.0f}},
+    {{1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}}
+};
+
+const UnsignedShort Indices[]{
+    0, 1, 2,
+    2, 1, 3
+};
+
+Trade::MeshData lineMesh() {
+    return Trade::MeshData{MeshPrimitive::Triangles,
+        {}, Indices, Trade::MeshIndexData{Indices},
+        {}, Vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::stridedArrayView(Vertices, &Vertices[0].position,
+                    Containers::arraySize(Vertices), sizeof(Vertex))},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+                Containers::stridedArrayView(Vertices, &Vertices[0].textureCoordinates,
+                    Containers::arraySize(Vertices), sizeof(Vertex))}
+        }};
+}
+
+void ReorderSpatiallyTest::reorder() {
+    Trade::MeshData out = reorderSpatially(lineMesh());
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedShort);
+    /* Face order is kept */
+    CORRADE_COMPARE_AS(out.indices<UnsignedShort>(), Containers::arrayView<UnsignedShort>({
+        3, 0, 2,
+        2, 0, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.attributeCount(), 2);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f},
+        {3.0f, 0.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates), Containers::arrayView<Vector2>({
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {2.0f, 0.0f},
+        {3.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void ReorderSpatiallyTest::reorderFaces() {
+    Trade::MeshData out = reorderSpatially(lineMesh(), ReorderSpatiallyFlag::Faces);
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedShort);
+    /* The second face has centroid at X = 1, the first at X = 5/3, so they
+       get swapped */
+    CORRADE_COMPARE_AS(out.indices<UnsignedShort>(), Containers::arrayView<UnsignedShort>({
+        2, 0, 1,
+        3, 0, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f},
+        {3.0f, 0.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void ReorderSpatiallyTest::reorderMultipleThreads() {
+    /* Random points and faces, large enough to be split across threads. The
+       sort is stable, so the output should be exactly the same as when done
+       on a single thread. */
+    std::minstd_rand random;
+    std::uniform_real_distribution<Float> coordinate{-1.0f, 1.0f};
+    Containers::Array<Vector3> positions{Containers::NoInit, 200000};
+    for(Vector3& i: positions)
+        i = {coordinate(random), coordinate(random), coordinate(random)};
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, 3*200000};
+    for(UnsignedInt& i: indices)
+        i = random() % positions.size();
+
+    Trade::MeshData shuffled{MeshPrimitive::Triangles,
+        {}, Containers::arrayView(indices), Trade::MeshIndexData{Containers::arrayView(indices)},
+        {}, Containers::arrayView(positions), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+    Trade::MeshData single = reorderSpatially(shuffled, ReorderSpatiallyFlag::Faces, 1);
+    Trade::MeshData multiple = reorderSpatially(shuffled, ReorderSpatiallyFlag::Faces, 4);
+
+    CORRADE_COMPARE_AS(multiple.indices<UnsignedInt>(),
+        single.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(multiple.attribute<Vector3>(Trade::MeshAttribute::Position),
+        single.attribute<Vector3>(Trade::MeshAttribute::Position),
+        TestSuite::Compare::Container);
+
+    /* The vertices should be sorted by their codes */
+    const Containers::Array<UnsignedInt> codes = MeshTools::mortonCodes(multiple.attribute<Vector3>(Trade::MeshAttribute::Position));
+    CORRADE_VERIFY(std::is_sorted(codes.begin(), codes.end()));
+}
+
+void ReorderSpatiallyTest::reorderNotIndexed() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    reorderSpatially(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    CORRADE_COMPARE(out.str(), "MeshTools::reorderSpatially(): the mesh is not indexed\n");
+}
+
+void ReorderSpatiallyTest::reorderNoPositions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    reorderSpatially(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, Indices, Trade::MeshIndexData{Indices}, 4});
+    CORRADE_COMPARE(out.str(), "MeshTools::reorderSpatially(): the mesh has no positions\n");
+}
+
+void ReorderSpatiallyTest::reorderFacesNotTriangles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Trade::MeshData mesh{MeshPrimitive::Lines,
+        {}, Indices, Trade::MeshIndexData{Indices},
+        {}, Vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::stridedArrayView(Vertices, &Vertices[0].position,
+                    Containers::arraySize(Vertices), sizeof(Vertex))}
+        }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    reorderSpatially(mesh, ReorderSpatiallyFlag::Faces);
+    CORRADE_COMPARE(out.str(), "MeshTools::reorderSpatially(): can't sort faces of MeshPrimitive::Lines\n");
+}
+
+void ReorderSpatiallyTest::benchmarkSmoothNormalsShuffled() {
+    Containers::Array<Vector3> normals{Containers::NoInit, _shuffledPositions.size()};
+    CORRADE_BENCHMARK(1) {
+        generateSmoothNormalsInto(
+            Containers::stridedArrayView(_shuffledIndices),
+            Containers::stridedArrayView(_shuffledPositions),
+            Containers::stridedArrayView(normals));
+    }
+
+    CORRADE_VERIFY(normals[0].isNormalized());
+}
+
+void ReorderSpatiallyTest::benchmarkSmoothNormalsReordered() {
+    Containers::Array<Vector3> normals{Containers::NoInit, _reorderedPositions.size()};
+    CORRADE_BENCHMARK(1) {
+        generateSmoothNormalsInto(
+            Containers::stridedArrayView(_reorderedIndices),
+            Containers::stridedArrayView(_reorderedPositions),
+            Containers::stridedArrayView(normals));
+    }
+
+    CORRADE_VERIFY(normals[0].isNormalized());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::ReorderSpatiallyTest)
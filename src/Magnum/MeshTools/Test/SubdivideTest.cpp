@@ -30,6 +30,7 @@
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/DebugStl.h>
 
+#include "Magnum/Math/Color.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Subdivide.h"
@@ -50,9 +51,23 @@ struct SubdivideTest: TestSuite::Tester {
     void subdivideInPlaceWrongIndexCount();
     void subdivideInPlaceSmallIndexType();
 
+    void subdivideShared();
+    void subdivideSharedWrongIndexCount();
+    template<class T> void subdivideSharedInPlace();
+    void subdivideSharedInPlaceWrongIndexCount();
+    void subdivideSharedInPlaceNotEnoughVertices();
+    void subdivideSharedInPlaceSmallIndexType();
+
+    void subdivideLoopCrease();
+    void subdivideLoopClosed();
+    void subdivideLoopNotTriangles();
+    void subdivideLoopWrongIndexCount();
+    void subdivideLoopNotFloat();
+
     /* this is additionally regression-tested in PrimitivesIcosphereTest */
 
     void benchmark();
+    void benchmarkShared();
 };
 
 typedef Math::Vector<1, Int> Vector1;
@@ -73,9 +88,25 @@ SubdivideTest::SubdivideTest() {
               &SubdivideTest::subdivideInPlace<UnsignedShort>,
               &SubdivideTest::subdivideInPlace<UnsignedInt>,
               &SubdivideTest::subdivideInPlaceWrongIndexCount,
-              &SubdivideTest::subdivideInPlaceSmallIndexType});
-
-    addBenchmarks({&SubdivideTest::benchmark}, 4);
+              &SubdivideTest::subdivideInPlaceSmallIndexType,
+
+              &SubdivideTest::subdivideShared,
+              &SubdivideTest::subdivideSharedWrongIndexCount,
+              &SubdivideTest::subdivideSharedInPlace<UnsignedByte>,
+              &SubdivideTest::subdivideSharedInPlace<UnsignedShort>,
+              &SubdivideTest::subdivideSharedInPlace<UnsignedInt>,
+              &SubdivideTest::subdivideSharedInPlaceWrongIndexCount,
+              &SubdivideTest::subdivideSharedInPlaceNotEnoughVertices,
+              &SubdivideTest::subdivideSharedInPlaceSmallIndexType,
+
+              &SubdivideTest::subdivideLoopCrease,
+              &SubdivideTest::subdivideLoopClosed,
+              &SubdivideTest::subdivideLoopNotTriangles,
+              &SubdivideTest::subdivideLoopWrongIndexCount,
+              &SubdivideTest::subdivideLoopNotFloat});
+
+    addBenchmarks({&SubdivideTest::benchmark,
+                   &SubdivideTest::benchmarkShared}, 4);
 }
 
 void SubdivideTest::subdivide() {
@@ -168,6 +199,236 @@ void SubdivideTest::subdivideInPlaceSmallIndexType() {
     CORRADE_COMPARE(out.str(), "MeshTools::subdivideInPlace(): a 1-byte index type is too small for 256 vertices\n");
 }
 
+void SubdivideTest::subdivideShared() {
+    auto positions = Containers::array<Vector1>({0, 2, 6, 8});
+    auto indices = Containers::array<UnsignedInt>({0, 1, 2, 1, 2, 3});
+    MeshTools::subdivideShared(indices, positions, interpolator1);
+
+    /* The 1-2 edge is shared, so there's just 5 new vertices instead of 6 */
+    CORRADE_COMPARE_AS(indices, Containers::arrayView<UnsignedInt>({
+        4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(positions, Containers::arrayView<Vector1>({
+        0, 2, 6, 8, 1, 4, 3, 7, 5
+    }), TestSuite::Compare::Container);
+}
+
+void SubdivideTest::subdivideSharedWrongIndexCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    Containers::Array<Vector1> positions;
+    Containers::Array<UnsignedInt> indices{2};
+    MeshTools::subdivideShared(indices, positions, interpolator1);
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideShared(): index count is not divisible by 3\n");
+}
+
+template<class T> void SubdivideTest::subdivideSharedInPlace() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[6*4]{0, 1, 2, 1, 2, 3, /* and 18 more */};
+    Vector1 positions[4 + 5]{0, 2, 6, 8, /* and 5 more */};
+    CORRADE_COMPARE(MeshTools::subdivideSharedInPlace(
+        Containers::stridedArrayView(indices),
+        Containers::stridedArrayView(positions), 4, interpolator1), 9);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<T>({4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions),
+        Containers::arrayView<Vector1>({0, 2, 6, 8, 1, 4, 3, 7, 5}),
+        TestSuite::Compare::Container);
+}
+
+void SubdivideTest::subdivideSharedInPlaceWrongIndexCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    UnsignedInt indices[6*4 + 1]{0, 1, 2, 1, 2, 3, /* and 18+1 more */};
+    Vector1 positions[]{0};
+    MeshTools::subdivideSharedInPlace(Containers::stridedArrayView(indices),
+        Containers::stridedArrayView(positions), 1, interpolator1);
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideSharedInPlace(): can't divide 25 indices to four parts with each having triangle faces\n");
+}
+
+void SubdivideTest::subdivideSharedInPlaceNotEnoughVertices() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    UnsignedInt indices[6*4]{0, 1, 2, 1, 2, 3, /* and 18 more */};
+    Vector1 positions[4 + 4]{0, 2, 6, 8, /* and 4 more */};
+    MeshTools::subdivideSharedInPlace(Containers::stridedArrayView(indices),
+        Containers::stridedArrayView(positions), 4, interpolator1);
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideSharedInPlace(): expected at least 9 vertices but got 8\n");
+}
+
+void SubdivideTest::subdivideSharedInPlaceSmallIndexType() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    UnsignedByte indices[6*4]{0, 1, 2, 1, 2, 3, /* and 18 more */};
+    Vector1 positions[256]{};
+    MeshTools::subdivideSharedInPlace(Containers::stridedArrayView(indices),
+        Containers::stridedArrayView(positions), 251, interpolator1);
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideSharedInPlace(): a 1-byte index type is too small for 256 vertices\n");
+}
+
+void SubdivideTest::subdivideLoopCrease() {
+    /* A single non-indexed triangle, all edges are creases */
+    const struct Vertex {
+        Vector3 position;
+        Vector2 textureCoordinates;
+    } vertexData[]{
+        {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
+        {{1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
+        {{0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}}
+    };
+    Trade::MeshData mesh{MeshPrimitive::Triangles, {}, vertexData, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::stridedArrayView(vertexData, &vertexData[0].position,
+                Containers::arraySize(vertexData), sizeof(Vertex))},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            Containers::stridedArrayView(vertexData, &vertexData[0].textureCoordinates,
+                Containers::arraySize(vertexData), sizeof(Vertex))}
+    }};
+
+    Trade::MeshData out = MeshTools::subdivideLoop(mesh);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(out.isIndexed());
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE_AS(out.indices<UnsignedInt>(), Containers::arrayView<UnsignedInt>({
+        3, 4, 5, 0, 3, 5, 3, 1, 4, 5, 4, 2
+    }), TestSuite::Compare::Container);
+
+    /* Original vertices are smoothed along the crease, new vertices are in
+       the middle of the edges */
+    CORRADE_COMPARE(out.attributeCount(), 2);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {0.125f, 0.125f, 0.0f},
+        {0.75f, 0.125f, 0.0f},
+        {0.125f, 0.75f, 0.0f},
+        {0.5f, 0.0f, 0.0f},
+        {0.5f, 0.5f, 0.0f},
+        {0.0f, 0.5f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates), Containers::arrayView<Vector2>({
+        {0.125f, 0.125f},
+        {0.75f, 0.125f},
+        {0.125f, 0.75f},
+        {0.5f, 0.0f},
+        {0.5f, 0.5f},
+        {0.0f, 0.5f}
+    }), TestSuite::Compare::Container);
+}
+
+void SubdivideTest::subdivideLoopClosed() {
+    /* A regular tetrahedron centered at origin. All vertices have valence 3
+       and the sum of all four is zero, so the smoothed vertices are a quarter
+       of the original and new vertices a quarter of the edge endpoint sum */
+    const Vector3 positions[]{
+        { 1.0f,  1.0f,  1.0f},
+        { 1.0f, -1.0f, -1.0f},
+        {-1.0f,  1.0f, -1.0f},
+        {-1.0f, -1.0f,  1.0f}
+    };
+    const UnsignedShort indices[]{
+        0, 1, 2,
+        0, 2, 3,
+        0, 3, 1,
+        1, 3, 2
+    };
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+    }};
+
+    Trade::MeshData out = MeshTools::subdivideLoop(mesh);
+    CORRADE_COMPARE(out.indexCount(), 48);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        { 0.25f,  0.25f,  0.25f},
+        { 0.25f, -0.25f, -0.25f},
+        {-0.25f,  0.25f, -0.25f},
+        {-0.25f, -0.25f,  0.25f},
+        { 0.5f,   0.0f,   0.0f}, /* 0-1 */
+        { 0.0f,   0.0f,  -0.5f}, /* 1-2 */
+        { 0.0f,   0.5f,   0.0f}, /* 2-0 */
+        {-0.5f,   0.0f,   0.0f}, /* 2-3 */
+        { 0.0f,   0.0f,   0.5f}, /* 3-0 */
+        { 0.0f,  -0.5f,   0.0f}  /* 3-1 */
+    }), TestSuite::Compare::Container);
+
+    /* Two levels, each time the edge count quadruples. Closed mesh, so
+       there's half as many edges as indices on each level. */
+    Trade::MeshData out2 = MeshTools::subdivideLoop(mesh, 2);
+    CORRADE_COMPARE(out2.indexCount(), 192);
+    CORRADE_COMPARE(out2.vertexCount(), 10 + 24);
+}
+
+void SubdivideTest::subdivideLoopNotTriangles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+    MeshTools::subdivideLoop(Trade::MeshData{MeshPrimitive::Lines, 6});
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideLoop(): expected MeshPrimitive::Triangles but got MeshPrimitive::Lines\n");
+}
+
+void SubdivideTest::subdivideLoopWrongIndexCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+    MeshTools::subdivideLoop(Trade::MeshData{MeshPrimitive::Triangles, 7});
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideLoop(): expected index or vertex count divisible by 3\n");
+}
+
+void SubdivideTest::subdivideLoopNotFloat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const struct Vertex {
+        Vector3 position;
+        Color4ub color;
+    } vertexData[3]{};
+    Trade::MeshData mesh{MeshPrimitive::Triangles, {}, vertexData, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::stridedArrayView(vertexData, &vertexData[0].position,
+                Containers::arraySize(vertexData), sizeof(Vertex))},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Color,
+            Containers::stridedArrayView(vertexData, &vertexData[0].color,
+                Containers::arraySize(vertexData), sizeof(Vertex))}
+    }};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    MeshTools::subdivideLoop(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideLoop(): expected a non-array floating-point attribute but attribute 1 is VertexFormat::Vector4ubNormalized\n");
+}
+
 void SubdivideTest::benchmark() {
     Trade::MeshData icosphere = Primitives::icosphereSolid(0);
 
@@ -186,6 +447,24 @@ void SubdivideTest::benchmark() {
     }
 }
 
+void SubdivideTest::benchmarkShared() {
+    Trade::MeshData icosphere = Primitives::icosphereSolid(0);
+
+    CORRADE_BENCHMARK(3) {
+        Containers::Array<UnsignedInt> indices;
+        arrayResize(indices, Containers::NoInit, icosphere.indexCount());
+        Utility::copy(icosphere.indices<UnsignedInt>(), indices);
+
+        Containers::Array<Vector3> positions;
+        arrayResize(positions, Containers::NoInit, icosphere.vertexCount());
+        Utility::copy(icosphere.attribute<Vector3>(Trade::MeshAttribute::Position), positions);
+
+        /* Subdivide 5 times */
+        for(std::size_t i = 0; i != 5; ++i)
+            MeshTools::subdivideShared(indices, positions, interpolator3);
+    }
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideTest)
@@ -0,0 +1,359 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "PixelFormatConversion.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum {
+
+namespace {
+
+enum class Component: UnsignedByte {
+    Unorm8 = 1,
+    Snorm8,
+    Srgb8,
+    Unorm16,
+    Snorm16,
+    Half,
+    Float
+};
+
+struct FormatProperties {
+    /* Zero for unsupported formats */
+    Component component;
+    UnsignedInt channelCount;
+};
+
+FormatProperties formatProperties(const PixelFormat format) {
+    if(isPixelFormatImplementationSpecific(format)) return {};
+
+    switch(format) {
+        #define _c(format, component, channelCount)                         \
+            case PixelFormat::format: return {Component::component, channelCount};
+        _c(R8Unorm, Unorm8, 1)
+        _c(RG8Unorm, Unorm8, 2)
+        _c(RGB8Unorm, Unorm8, 3)
+        _c(RGBA8Unorm, Unorm8, 4)
+        _c(R8Snorm, Snorm8, 1)
+        _c(RG8Snorm, Snorm8, 2)
+        _c(RGB8Snorm, Snorm8, 3)
+        _c(RGBA8Snorm, Snorm8, 4)
+        _c(R8Srgb, Srgb8, 1)
+        _c(RG8Srgb, Srgb8, 2)
+        _c(RGB8Srgb, Srgb8, 3)
+        _c(RGBA8Srgb, Srgb8, 4)
+        _c(R16Unorm, Unorm16, 1)
+        _c(RG16Unorm, Unorm16, 2)
+        _c(RGB16Unorm, Unorm16, 3)
+        _c(RGBA16Unorm, Unorm16, 4)
+        _c(R16Snorm, Snorm16, 1)
+        _c(RG16Snorm, Snorm16, 2)
+        _c(RGB16Snorm, Snorm16, 3)
+        _c(RGBA16Snorm, Snorm16, 4)
+        _c(R16F, Half, 1)
+        _c(RG16F, Half, 2)
+        _c(RGB16F, Half, 3)
+        _c(RGBA16F, Half, 4)
+        _c(R32F, Float, 1)
+        _c(RG32F, Float, 2)
+        _c(RGB32F, Float, 3)
+        _c(RGBA32F, Float, 4)
+        #undef _c
+        default: return {};
+    }
+}
+
+/* Adding or removing channels of the same component type. Templated on the
+   channel counts so the per-pixel loops get unrolled. */
+template<class T, UnsignedInt sourceChannels, UnsignedInt destinationChannels> void reshuffleRow(const char* const source, char* const destination, const std::size_t width, const T alpha) {
+    const T* src = reinterpret_cast<const T*>(source);
+    T* dst = reinterpret_cast<T*>(destination);
+    for(std::size_t i = 0; i != width; ++i) {
+        for(UnsignedInt c = 0; c != destinationChannels; ++c) {
+            if(c < sourceChannels) dst[c] = src[c];
+            else dst[c] = c == 3 ? alpha : T{};
+        }
+        src += sourceChannels;
+        dst += destinationChannels;
+    }
+}
+
+template<class T, UnsignedInt sourceChannels> void reshuffleRow(const char* const source, char* const destination, const UnsignedInt destinationChannels, const std::size_t width, const T alpha) {
+    switch(destinationChannels) {
+        case 1: return reshuffleRow<T, sourceChannels, 1>(source, destination, width, alpha);
+        case 2: return reshuffleRow<T, sourceChannels, 2>(source, destination, width, alpha);
+        case 3: return reshuffleRow<T, sourceChannels, 3>(source, destination, width, alpha);
+        case 4: return reshuffleRow<T, sourceChannels, 4>(source, destination, width, alpha);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+template<class T> void reshuffleRow(const char* const source, const UnsignedInt sourceChannels, char* const destination, const UnsignedInt destinationChannels, const std::size_t width, const T alpha) {
+    switch(sourceChannels) {
+        case 1: return reshuffleRow<T, 1>(source, destination, destinationChannels, width, alpha);
+        case 2: return reshuffleRow<T, 2>(source, destination, destinationChannels, width, alpha);
+        case 3: return reshuffleRow<T, 3>(source, destination, destinationChannels, width, alpha);
+        case 4: return reshuffleRow<T, 4>(source, destination, destinationChannels, width, alpha);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+void reshuffleRow(const Component component, const char* const source, const UnsignedInt sourceChannels, char* const destination, const UnsignedInt destinationChannels, const std::size_t width) {
+    switch(component) {
+        case Component::Unorm8:
+        case Component::Srgb8:
+            return reshuffleRow<UnsignedByte>(source, sourceChannels, destination, destinationChannels, width, 0xff);
+        case Component::Snorm8:
+            return reshuffleRow<Byte>(source, sourceChannels, destination, destinationChannels, width, 0x7f);
+        case Component::Unorm16:
+            return reshuffleRow<UnsignedShort>(source, sourceChannels, destination, destinationChannels, width, 0xffff);
+        case Component::Snorm16:
+            return reshuffleRow<Short>(source, sourceChannels, destination, destinationChannels, width, 0x7fff);
+        case Component::Half:
+            /* 1.0 in half-float */
+            return reshuffleRow<UnsignedShort>(source, sourceChannels, destination, destinationChannels, width, 0x3c00);
+        case Component::Float:
+            return reshuffleRow<Float>(source, sourceChannels, destination, destinationChannels, width, 1.0f);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+template<class T> Containers::StridedArrayView2D<T> componentView(T* const data, const std::size_t width, const UnsignedInt channelCount) {
+    return {{data, width*channelCount}, {width, channelCount}, {std::ptrdiff_t(sizeof(T)*channelCount), sizeof(T)}};
+}
+
+/* Unpacks a row into the first channels of a RGBA float scratch row,
+   converting sRGB to linear */
+void decodeRow(const FormatProperties& properties, const char* const source, const std::size_t width, const Containers::ArrayView<Vector4>& scratch) {
+    const Containers::StridedArrayView2D<Float> dst{
+        {scratch.data()->data(), width*4},
+        {width, properties.channelCount}, {sizeof(Vector4), sizeof(Float)}};
+
+    switch(properties.component) {
+        case Component::Unorm8:
+            Math::unpackInto(componentView(reinterpret_cast<const UnsignedByte*>(source), width, properties.channelCount), dst);
+            return;
+        case Component::Snorm8:
+            Math::unpackInto(componentView(reinterpret_cast<const Byte*>(source), width, properties.channelCount), dst);
+            return;
+        case Component::Unorm16:
+            Math::unpackInto(componentView(reinterpret_cast<const UnsignedShort*>(source), width, properties.channelCount), dst);
+            return;
+        case Component::Snorm16:
+            Math::unpackInto(componentView(reinterpret_cast<const Short*>(source), width, properties.channelCount), dst);
+            return;
+        case Component::Half:
+            Math::unpackHalfInto(componentView(reinterpret_cast<const UnsignedShort*>(source), width, properties.channelCount), dst);
+            return;
+        case Component::Float: {
+            const Float* src = reinterpret_cast<const Float*>(source);
+            for(std::size_t i = 0; i != width; ++i)
+                for(UnsignedInt c = 0; c != properties.channelCount; ++c)
+                    scratch[i][c] = *src++;
+        } return;
+        case Component::Srgb8: {
+            /* Alpha is always linear */
+            const Containers::StridedArrayView2D<const UnsignedByte> src = componentView(reinterpret_cast<const UnsignedByte*>(source), width, properties.channelCount);
+            const UnsignedInt srgbChannelCount = Math::min(properties.channelCount, 3u);
+            Math::fromSrgbInto(src.prefix({width, srgbChannelCount}), dst.prefix({width, srgbChannelCount}));
+            if(properties.channelCount == 4)
+                Math::unpackInto(src.suffix({0, 3}), dst.suffix({0, 3}));
+        } return;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Packs the first channels of a RGBA float scratch row into the destination,
+   clamping to the representable range and converting linear to sRGB. The
+   scratch gets modified in the process. */
+void encodeRow(const FormatProperties& properties, const Containers::ArrayView<Vector4>& scratch, char* const destination, const std::size_t width) {
+    const Containers::StridedArrayView2D<const Float> src{
+        {scratch.data()->data(), width*4},
+        {width, properties.channelCount}, {sizeof(Vector4), sizeof(Float)}};
+
+    switch(properties.component) {
+        case Component::Unorm8:
+        case Component::Srgb8:
+        case Component::Unorm16:
+            for(Vector4& i: scratch) i = Math::clamp(i, 0.0f, 1.0f);
+            break;
+        case Component::Snorm8:
+        case Component::Snorm16:
+            for(Vector4& i: scratch) i = Math::clamp(i, -1.0f, 1.0f);
+            break;
+        case Component::Half:
+        case Component::Float:
+            break;
+    }
+
+    switch(properties.component) {
+        case Component::Unorm8:
+            Math::packInto(src, componentView(reinterpret_cast<UnsignedByte*>(destination), width, properties.channelCount));
+            return;
+        case Component::Srgb8: {
+            /* Alpha is always linear */
+            const Containers::StridedArrayView2D<UnsignedByte> dst = componentView(reinterpret_cast<UnsignedByte*>(destination), width, properties.channelCount);
+            const UnsignedInt srgbChannelCount = Math::min(properties.channelCount, 3u);
+            Math::toSrgbInto(src.prefix({width, srgbChannelCount}), dst.prefix({width, srgbChannelCount}));
+            if(properties.channelCount == 4)
+                Math::packInto(src.suffix({0, 3}), dst.suffix({0, 3}));
+        } return;
+        case Component::Snorm8:
+            Math::packInto(src, componentView(reinterpret_cast<Byte*>(destination), width, properties.channelCount));
+            return;
+        case Component::Unorm16:
+            Math::packInto(src, componentView(reinterpret_cast<UnsignedShort*>(destination), width, properties.channelCount));
+            return;
+        case Component::Snorm16:
+            Math::packInto(src, componentView(reinterpret_cast<Short*>(destination), width, properties.channelCount));
+            return;
+        case Component::Half:
+            Math::packHalfInto(src, componentView(reinterpret_cast<UnsignedShort*>(destination), width, properties.channelCount));
+            return;
+        case Component::Float: {
+            Float* dst = reinterpret_cast<Float*>(destination);
+            for(std::size_t i = 0; i != width; ++i)
+                for(UnsignedInt c = 0; c != properties.channelCount; ++c)
+                    *dst++ = scratch[i][c];
+        } return;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+template<UnsignedInt dimensions> void convertPixelFormatIntoImplementation(const ImageView<dimensions, const char>& source, const ImageView<dimensions, char>& destination) {
+    CORRADE_ASSERT(source.size() == destination.size(),
+        "convertPixelFormatInto(): expected destination size" << source.size() << "but got" << destination.size(), );
+    CORRADE_ASSERT(isPixelFormatConversionSupported(source.format(), destination.format()),
+        "convertPixelFormatInto(): conversion from" << source.format() << "to" << destination.format() << "is not supported", );
+
+    /* Row length, row count and image count with the storage applied. The
+       Image(View) constructors already verified that the data are large
+       enough. */
+    const Vector3i size = Vector3i::pad(source.size(), 1);
+    const std::pair<Math::Vector3<std::size_t>, Math::Vector3<std::size_t>> sourceProperties = source.storage().dataProperties(source.pixelSize(), size);
+    const std::pair<Math::Vector3<std::size_t>, Math::Vector3<std::size_t>> destinationProperties = destination.storage().dataProperties(destination.pixelSize(), size);
+    const char* const sourceData = static_cast<const char*>(source.data().data()) + sourceProperties.first.sum();
+    char* const destinationData = static_cast<char*>(destination.data().data()) + destinationProperties.first.sum();
+    const std::size_t width = size.x();
+
+    /* Pick the conversion path once for the whole image */
+    const FormatProperties sourceFormat = formatProperties(source.format());
+    const FormatProperties destinationFormat = formatProperties(destination.format());
+    enum class Path { Copy, Reshuffle, Float } path;
+    if(source.format() == destination.format())
+        path = Path::Copy;
+    else if(sourceFormat.component == destinationFormat.component)
+        path = Path::Reshuffle;
+    else path = Path::Float;
+
+    Containers::Array<Vector4> scratch;
+    if(path == Path::Float)
+        scratch = Containers::Array<Vector4>{Containers::ValueInit, width};
+
+    for(Int z = 0; z != size.z(); ++z) {
+        for(Int y = 0; y != size.y(); ++y) {
+            const char* src = sourceData + z*sourceProperties.second.x()*sourceProperties.second.y() + y*sourceProperties.second.x();
+            char* dst = destinationData + z*destinationProperties.second.x()*destinationProperties.second.y() + y*destinationProperties.second.x();
+
+            switch(path) {
+                case Path::Copy:
+                    std::memcpy(dst, src, width*source.pixelSize());
+                    break;
+                case Path::Reshuffle:
+                    reshuffleRow(sourceFormat.component, src, sourceFormat.channelCount, dst, destinationFormat.channelCount, width);
+                    break;
+                case Path::Float:
+                    /* Channels that the source doesn't have are zero, alpha
+                       is one */
+                    if(sourceFormat.channelCount < destinationFormat.channelCount)
+                        for(Vector4& i: scratch) i = {0.0f, 0.0f, 0.0f, 1.0f};
+                    decodeRow(sourceFormat, src, width, scratch);
+                    encodeRow(destinationFormat, scratch, dst, width);
+                    break;
+            }
+        }
+    }
+}
+
+template<UnsignedInt dimensions> Image<dimensions> convertPixelFormatImplementation(const ImageView<dimensions, const char>& source, const PixelFormat format) {
+    /* Checking here as well to not allocate an image of a format that has
+       unknown size */
+    CORRADE_ASSERT(isPixelFormatConversionSupported(source.format(), format),
+        "convertPixelFormat(): conversion from" << source.format() << "to" << format << "is not supported", (Image<dimensions>{PixelStorage{}, format, {}, 1}));
+
+    const UnsignedInt pixelSize = format == source.format() ? source.pixelSize() : Magnum::pixelSize(format);
+    const std::pair<Math::Vector3<std::size_t>, Math::Vector3<std::size_t>> properties = PixelStorage{}.dataProperties(pixelSize, Vector3i::pad(source.size(), 1));
+    Image<dimensions> out{PixelStorage{}, format, format == source.format() ? source.formatExtra() : 0, pixelSize, source.size(), Containers::Array<char>{Containers::ValueInit, properties.second.product()}};
+    convertPixelFormatIntoImplementation<dimensions>(source, out);
+    return out;
+}
+
+}
+
+bool isPixelFormatConversionSupported(const PixelFormat source, const PixelFormat destination) {
+    return source == destination || (formatProperties(source).channelCount && formatProperties(destination).channelCount);
+}
+
+void convertPixelFormatInto(const ImageView1D& source, const MutableImageView1D& destination) {
+    convertPixelFormatIntoImplementation<1>(source, destination);
+}
+
+void convertPixelFormatInto(const ImageView2D& source, const MutableImageView2D& destination) {
+    convertPixelFormatIntoImplementation<2>(source, destination);
+}
+
+void convertPixelFormatInto(const ImageView3D& source, const MutableImageView3D& destination) {
+    convertPixelFormatIntoImplementation<3>(source, destination);
+}
+
+Image1D convertPixelFormat(const ImageView1D& source, const PixelFormat format) {
+    return convertPixelFormatImplementation<1>(source, format);
+}
+
+Image2D convertPixelFormat(const ImageView2D& source, const PixelFormat format) {
+    return convertPixelFormatImplementation<2>(source, format);
+}
+
+Image3D convertPixelFormat(const ImageView3D& source, const PixelFormat format) {
+    return convertPixelFormatImplementation<3>(source, format);
+}
+
+}
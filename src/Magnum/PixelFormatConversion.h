@@ -0,0 +1,115 @@
+#ifndef Magnum_PixelFormatConversion_h
+#define Magnum_PixelFormatConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::isPixelFormatConversionSupported(), @ref Magnum::convertPixelFormatInto(), @ref Magnum::convertPixelFormat()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Whether a pixel format conversion is supported
+@m_since_latest
+
+Returns @cpp true @ce if @p source and @p destination are the same format,
+including integer, depth/stencil and implementation-specific formats, for
+which the conversion is just a copy respecting @ref PixelStorage of both
+images. Otherwise returns @cpp true @ce only if both are one- to
+four-component @ref PixelFormat::R8Unorm "*8Unorm",
+@ref PixelFormat::R8Snorm "*8Snorm", @ref PixelFormat::R8Srgb "*8Srgb",
+@ref PixelFormat::R16Unorm "*16Unorm", @ref PixelFormat::R16Snorm "*16Snorm",
+@ref PixelFormat::R16F "*16F" or @ref PixelFormat::R32F "*32F" formats.
+@see @ref convertPixelFormatInto(), @ref convertPixelFormat()
+*/
+MAGNUM_EXPORT bool isPixelFormatConversionSupported(PixelFormat source, PixelFormat destination);
+
+/**
+@brief Convert pixels of an image into another image of a different format
+@m_since_latest
+
+Expects that both images have the same size and that
+@ref isPixelFormatConversionSupported() returns @cpp true @ce for their
+formats. Both images can have arbitrary @ref PixelStorage. The conversion
+behaves as follows:
+
+-   Color values are preserved. Normalized and floating-point values are
+    converted to the destination representation with clamping to its range,
+    values of @ref PixelFormat::R8Srgb "*8Srgb" formats are converted from
+    and to sRGB space. The alpha channel is always treated as linear.
+-   Channels not present in the source are set to zero, except for alpha,
+    which is set to the maximum value. Channels not present in the
+    destination are dropped.
+
+Conversions that only add or remove channels, such as
+@ref PixelFormat::RGB8Unorm to @ref PixelFormat::RGBA8Unorm, and conversions
+between identical formats are done directly on the source data. All other
+conversions go through a row of 32-bit floats using the batch functions from
+@ref Magnum/Math/PackingBatch.h.
+@see @ref convertPixelFormat()
+*/
+MAGNUM_EXPORT void convertPixelFormatInto(const ImageView1D& source, const MutableImageView1D& destination);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void convertPixelFormatInto(const ImageView2D& source, const MutableImageView2D& destination);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void convertPixelFormatInto(const ImageView3D& source, const MutableImageView3D& destination);
+
+/**
+@brief Convert an image to a different pixel format
+@m_since_latest
+
+Allocates a new image of given @p format with default @ref PixelStorage and
+calls @ref convertPixelFormatInto().
+*/
+MAGNUM_EXPORT Image1D convertPixelFormat(const ImageView1D& source, PixelFormat format);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT Image2D convertPixelFormat(const ImageView2D& source, PixelFormat format);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT Image3D convertPixelFormat(const ImageView3D& source, PixelFormat format);
+
+}
+
+#endif
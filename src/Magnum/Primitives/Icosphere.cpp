@@ -27,7 +27,6 @@
 
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Vector3.h"
-#include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Subdivide.h"
 #include "Magnum/Trade/ArrayAllocator.h"
 #include "Magnum/Trade/MeshData.h"
@@ -85,7 +84,10 @@ constexpr struct VertexSolidStrip {
 
 Trade::MeshData icosphereSolid(const UnsignedInt subdivisions) {
     const std::size_t indexCount = Containers::arraySize(Indices)*(1 << subdivisions*2);
-    const std::size_t vertexCount = Containers::arraySize(Vertices) + ((indexCount - Containers::arraySize(Indices))/3);
+    /* Each subdivision adds one vertex per edge and the icosahedron is
+       closed, so each edge is shared by exactly two faces. That makes the
+       final vertex count known upfront. */
+    const std::size_t vertexCount = Containers::arraySize(Vertices) + (indexCount - Containers::arraySize(Indices))/6;
 
     Containers::Array<char> indexData{indexCount*sizeof(UnsignedInt)};
     auto indices = Containers::arrayCast<UnsignedInt>(indexData);
@@ -106,19 +108,15 @@ Trade::MeshData icosphereSolid(const UnsignedInt subdivisions) {
         for(std::size_t i = 0; i != Containers::arraySize(Vertices); ++i)
             positions[i] = Vertices[i].position;
 
+        std::size_t iterationVertexCount = Containers::arraySize(Vertices);
         for(std::size_t i = 0; i != subdivisions; ++i) {
             const std::size_t iterationIndexCount = Containers::arraySize(Indices)*(1 << (i + 1)*2);
-            const std::size_t iterationVertexCount = Containers::arraySize(Vertices) + ((iterationIndexCount - Containers::arraySize(Indices))/3);
-            MeshTools::subdivideInPlace(indices.prefix(iterationIndexCount), positions.prefix(iterationVertexCount), [](const Vector3& a, const Vector3& b) {
+            iterationVertexCount = MeshTools::subdivideSharedInPlace(Containers::stridedArrayView(indices.prefix(iterationIndexCount)), positions, iterationVertexCount, [](const Vector3& a, const Vector3& b) {
                 return (a+b).normalized();
             });
         }
 
-        /** @todo i need arrayShrinkAndGiveUpMemoryIfItDoesntCauseRealloc() */
-        Containers::arrayResize<Trade::ArrayAllocator>(vertexData,
-            MeshTools::removeDuplicatesIndexedInPlace(
-                Containers::stridedArrayView(indices),
-                Containers::arrayCast<2, char>(positions))*sizeof(Vertex));
+        CORRADE_INTERNAL_ASSERT(iterationVertexCount == vertexCount);
     }
 
     /* Build up the views again with correct size, fill the normals */
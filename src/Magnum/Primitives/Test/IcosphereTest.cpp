@@ -66,7 +66,7 @@ void IcosphereTest::count0() {
 }
 
 void IcosphereTest::data1() {
-    /* This also tests the subdivide() and removeDuplicates() mesh tools */
+    /* This also tests the subdivideSharedInPlace() mesh tool */
 
     Trade::MeshData icosphere = Primitives::icosphereSolid(1);
 
@@ -25,6 +25,8 @@
 
 #include "Resource.h"
 
+#include <Corrade/Containers/EnumSet.hpp>
+
 namespace Magnum {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -49,6 +51,25 @@ Debug& operator<<(Debug& debug, const ResourceState value) {
     return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
 }
 
+Debug& operator<<(Debug& debug, const ResourceManagerFlag value) {
+    debug << "ResourceManagerFlag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case ResourceManagerFlag::v: return debug << "::" #v;
+        _c(ThreadSafe)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const ResourceManagerFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "ResourceManagerFlags{}", {
+        ResourceManagerFlag::ThreadSafe});
+}
+
 Debug& operator<<(Debug& debug, const ResourceKey& value) {
     return debug << "ResourceKey(0x" << Debug::nospace << static_cast<const Utility::HashDigest<sizeof(std::size_t)>&>(value) << Debug::nospace << ")";
 }
@@ -132,11 +132,16 @@ class Resource {
          * Creates empty resource. Resources are acquired from the manager by
          * calling @ref ResourceManager::get().
          */
-        explicit Resource(): _manager{nullptr}, _lastCheck{0}, _state{ResourceState::Final}, _data{nullptr} {}
+        explicit Resource(): _manager{nullptr}, _entry{nullptr}, _lastCheck{0}, _state{ResourceState::Final}, _data{nullptr} {}
 
-        /** @brief Copy constructor */
-        Resource(const Resource<T, U>& other): _manager{other._manager}, _key{other._key}, _lastCheck{other._lastCheck}, _state{other._state}, _data{other._data} {
-            if(_manager) _manager->incrementReferenceCount(_key);
+        /**
+         * @brief Copy constructor
+         *
+         * Increments the reference count without accessing the manager, the
+         * increment is atomic.
+         */
+        Resource(const Resource<T, U>& other): _manager{other._manager}, _key{other._key}, _entry{other._entry}, _lastCheck{other._lastCheck}, _state{other._state}, _data{other._data} {
+            if(_manager) _manager->incrementReferenceCount(*_entry);
         }
 
         /** @brief Move constructor */
@@ -144,7 +149,7 @@ class Resource {
 
         /** @brief Destructor */
         ~Resource() {
-            if(_manager) _manager->decrementReferenceCount(_key);
+            if(_manager) _manager->decrementReferenceCount(_key, *_entry);
         }
 
         /** @brief Copy assignment */
@@ -236,35 +241,38 @@ class Resource {
         friend Implementation::ResourceManagerData<T>;
         #endif
 
-        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key): _manager{manager}, _key{key}, _lastCheck{0}, _state{ResourceState::NotLoaded}, _data{nullptr} {
-            manager->incrementReferenceCount(key);
-        }
+        /* The reference count is already incremented by the manager */
+        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key, typename Implementation::ResourceManagerData<T>::Data& entry): _manager{manager}, _key{key}, _entry{&entry}, _lastCheck{0}, _state{ResourceState::NotLoaded}, _data{nullptr} {}
 
         void acquire();
 
         Implementation::ResourceManagerData<T>* _manager;
         ResourceKey _key;
+        typename Implementation::ResourceManagerData<T>::Data* _entry;
         std::size_t _lastCheck;
         ResourceState _state;
         T* _data;
 };
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(const Resource<T, U>& other) {
-    if(_manager) _manager->decrementReferenceCount(_key);
+    /* Increment first to not free the data in case of self-assignment */
+    if(other._manager) other._manager->incrementReferenceCount(*other._entry);
+    if(_manager) _manager->decrementReferenceCount(_key, *_entry);
 
     _manager = other._manager;
     _key = other._key;
+    _entry = other._entry;
     _lastCheck = other._lastCheck;
     _state = other._state;
     _data = other._data;
 
-    if(_manager) _manager->incrementReferenceCount(_key);
     return *this;
 }
 
-template<class T, class U> Resource<T, U>::Resource(Resource<T, U>&& other) noexcept: _manager(other._manager), _key(other._key), _lastCheck(other._lastCheck), _state(other._state), _data(other._data) {
+template<class T, class U> Resource<T, U>::Resource(Resource<T, U>&& other) noexcept: _manager(other._manager), _key(other._key), _entry(other._entry), _lastCheck(other._lastCheck), _state(other._state), _data(other._data) {
     other._manager = nullptr;
     other._key = {};
+    other._entry = nullptr;
     other._lastCheck = 0;
     other._state = ResourceState::Final;
     other._data = nullptr;
@@ -274,6 +282,7 @@ template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(Resource<T,
     using std::swap;
     swap(_manager, other._manager);
     swap(_key, other._key);
+    swap(_entry, other._entry);
     swap(_lastCheck, other._lastCheck);
     swap(_state, other._state);
     swap(_data, other._data);
@@ -285,15 +294,18 @@ template<class T, class U> void Resource<T, U>::acquire() {
     if(_state == ResourceState::Final) return;
 
     /* Nothing changed since last check */
-    if(_manager->lastChange() <= _lastCheck) return;
+    const std::size_t lastChange = _manager->lastChange();
+    if(lastChange <= _lastCheck) return;
 
-    /* Acquire new data and save last check time */
-    const typename Implementation::ResourceManagerData<T>::Data& d = _manager->data(_key);
-    _lastCheck = _manager->lastChange();
+    /* Save last check time and acquire new data. The time is queried before
+       the data, so if another thread changes them in the meantime, the next
+       check will see the change. */
+    _lastCheck = lastChange;
+    const auto data = _manager->data(_key, *_entry);
 
     /* Try to get the data */
-    _data = d.data;
-    _state = static_cast<ResourceState>(d.state);
+    _data = data.first;
+    _state = static_cast<ResourceState>(data.second);
 
     /* Data are not available */
     if(!_data) {
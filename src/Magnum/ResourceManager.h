@@ -26,10 +26,16 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::ResourceManager, @ref Magnum::ResourceDataState, @ref Magnum::ResourcePolicy
+ * @brief Class @ref Magnum::ResourceManager, enum @ref Magnum::ResourceDataState, @ref Magnum::ResourcePolicy, @ref Magnum::ResourceManagerFlag, enum set @ref Magnum::ResourceManagerFlags
  */
 
+#include <atomic>
+#include <list>
+#include <mutex>
 #include <unordered_map>
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.h>
 #include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Resource.h"
@@ -86,13 +92,95 @@ enum class ResourcePolicy: UnsignedByte {
     Manual,
 
     /** The resource will be unloaded when last reference to it is gone. */
-    ReferenceCounted
+    ReferenceCounted,
+
+    /**
+     * The resource will be unloaded when nothing references it and the
+     * memory budget set via @ref ResourceManager::setBudget() is exceeded,
+     * least recently used resources first. If a loader is set, an unloaded
+     * resource is loaded again on the next @ref ResourceManager::get(). See
+     * @ref ResourceManager-budget for more information.
+     * @m_since_latest
+     */
+    Cached
 };
 
+/**
+@brief Resource manager flag
+@m_since_latest
+
+@see @ref ResourceManagerFlags, @ref ResourceManager::ResourceManager()
+*/
+enum class ResourceManagerFlag: UnsignedByte {
+    /**
+     * Make the manager safe to use from multiple threads at once. The
+     * resources are distributed across several independently locked shards
+     * and reference counting is atomic, so @ref ResourceManager::get(),
+     * @ref ResourceManager::set(), @ref ResourceManager::state(),
+     * @ref ResourceManager::free() and @ref Resource copies or accesses can
+     * be done from any thread. Required by @ref AsyncResourceLoader. See
+     * @ref ResourceManager-thread-safety for more information.
+     */
+    ThreadSafe = 1 << 0
+};
+
+/**
+@brief Resource manager flags
+@m_since_latest
+
+@see @ref ResourceManager::ResourceManager()
+*/
+typedef Containers::EnumSet<ResourceManagerFlag> ResourceManagerFlags;
+
+CORRADE_ENUMSET_OPERATORS(ResourceManagerFlags)
+
+/**
+@debugoperatorenum{ResourceManagerFlag}
+@m_since_latest
+*/
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, ResourceManagerFlag value);
+
+/**
+@debugoperatorenum{ResourceManagerFlags}
+@m_since_latest
+*/
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, ResourceManagerFlags value);
+
 template<class> class AbstractResourceLoader;
 
 namespace Implementation {
 
+/* Memory usage and budget common for all types in the manager. Constructed
+   before all ResourceManagerData instances, which keep a reference to it. */
+class ResourceManagerBase {
+    template<class> friend class ResourceManagerData;
+
+    public:
+        std::size_t budget() const { return _budget; }
+
+        std::size_t memoryUsage() const { return _memoryUsage; }
+
+    protected:
+        explicit ResourceManagerBase(): _budget{~std::size_t{}}, _memoryUsage{0}, _lastUse{0} {}
+        virtual ~ResourceManagerBase() = default;
+
+        void setBudget(std::size_t budget) {
+            _budget = budget;
+            evict();
+        }
+
+        /* Unloads least recently used resources of all types until the
+           memory usage fits into the budget */
+        virtual void evict() = 0;
+
+    private:
+        std::size_t _budget;
+        std::atomic<std::size_t> _memoryUsage;
+        /* Incremented every time a resource becomes unused, giving a global
+           ordering of unused resources across all types */
+        std::atomic<std::size_t> _lastUse;
+};
+
 /** @todo Print either resource key or name string based on loader capabilities */
 
 template<class T> class ResourceManagerData {
@@ -110,7 +198,15 @@ template<class T> class ResourceManagerData {
 
         std::size_t lastChange() const { return _lastChange; }
 
-        std::size_t count() const { return _data.size(); }
+        ResourceManagerFlags flags() const { return _flags; }
+
+        std::size_t count() const;
+
+        std::size_t budget() const { return _budget; }
+
+        void setBudget(std::size_t budget);
+
+        std::size_t memoryUsage() const { return _memoryUsage; }
 
         std::size_t referenceCount(ResourceKey key) const;
 
@@ -118,7 +214,7 @@ template<class T> class ResourceManagerData {
 
         template<class U> Resource<T, U> get(ResourceKey key);
 
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size);
 
         T* fallback() { return _fallback; }
         const T* fallback() const { return _fallback; }
@@ -127,7 +223,7 @@ template<class T> class ResourceManagerData {
 
         void free();
 
-        void clear() { _data.clear(); }
+        void clear();
 
         AbstractResourceLoader<T>* loader() { return _loader; }
         const AbstractResourceLoader<T>* loader() const { return _loader; }
@@ -136,24 +232,84 @@ template<class T> class ResourceManagerData {
 
         void setLoader(AbstractResourceLoader<T>* loader);
 
+        /* Stamp of the least recently used unreferenced resource or
+           ~std::size_t{} if there's none */
+        std::size_t oldestUnused() const;
+
+        /* Unloads the least recently used unreferenced resource, returns
+           false if there's none */
+        bool evictOldest();
+
     protected:
-        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0) {}
+        explicit ResourceManagerData(ResourceManagerFlags flags, ResourceManagerBase& base);
 
     private:
         struct Data;
 
-        const Data& data(ResourceKey key) { return _data[key]; }
+        /* In the thread-safe mode the resources are distributed across
+           ShardCount maps based on the top bits of the key hash, so threads
+           accessing different resources rarely contend on the same mutex.
+           Otherwise there's just one shard that's never locked. */
+        enum: std::size_t { ShardCount = 16 };
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<ResourceKey, Data> data;
+        };
+
+        Shard& shard(ResourceKey key) const {
+            return _shards[_shards.size() == 1 ? 0 :
+                std::hash<ResourceKey>{}(key) >> (sizeof(std::size_t)*8 - 4)];
+        }
+
+        std::unique_lock<std::mutex> lock(std::mutex& mutex) const {
+            return _flags & ResourceManagerFlag::ThreadSafe ?
+                std::unique_lock<std::mutex>{mutex} :
+                std::unique_lock<std::mutex>{};
+        }
 
-        void incrementReferenceCount(ResourceKey key) {
-            ++_data[key].referenceCount;
+        std::unique_lock<std::mutex> lock(Shard& shard) const {
+            return lock(shard.mutex);
         }
 
-        void decrementReferenceCount(ResourceKey key);
+        /* Unreferenced ResourcePolicy::Cached resources, least recently used
+           first. The entries are added and removed only with the shard lock
+           held, the LRU lock is always taken after the shard lock. */
+        typedef std::list<std::pair<std::size_t, ResourceKey>> Lru;
+        void addToLru(ResourceKey key, Data& entry);
+        void removeFromLru(Data& entry);
+
+        /* Removes the entry including its LRU position and memory usage,
+           expects the shard lock to be held */
+        void erase(Shard& shard, typename std::unordered_map<ResourceKey, Data>::iterator it);
+
+        /* Unloads least recently used resources until the memory usage fits
+           into both the per-type and the global budget */
+        void evict();
+
+        /* Data pointer and state, consistent with each other */
+        std::pair<T*, ResourceDataState> data(ResourceKey key, const Data& entry) const;
+
+        /* Entry addresses are stable as std::unordered_map never relocates
+           its nodes, so Resource can keep a pointer to the entry and copy
+           itself without any lookup or locking */
+        void incrementReferenceCount(Data& entry) {
+            ++entry.referenceCount;
+        }
 
-        std::unordered_map<ResourceKey, Data> _data;
+        void decrementReferenceCount(ResourceKey key, Data& entry);
+
+        /* Mutable because a lock is needed also in const getters */
+        mutable Containers::Array<Shard> _shards;
         T* _fallback;
         AbstractResourceLoader<T>* _loader;
-        std::size_t _lastChange;
+        std::atomic<std::size_t> _lastChange;
+        ResourceManagerFlags _flags;
+
+        ResourceManagerBase& _base;
+        std::size_t _budget;
+        std::atomic<std::size_t> _memoryUsage;
+        mutable std::mutex _lruMutex;
+        Lru _lru;
 };
 
 /* Helper class for defining which real types are in the type pack */
@@ -218,15 +374,62 @@ Basic usage is:
 </li>
 </ul>
 
-@see @ref AbstractResourceLoader
+@section ResourceManager-budget Memory budget
+
+Resources set with @ref ResourcePolicy::Cached together with their size in
+bytes stay loaded after the last reference to them is gone, as long as the
+memory usage of the manager doesn't exceed a budget. When it does, the least
+recently used unreferenced resources get unloaded until the usage fits again.
+The budget can be set either for a particular type with @ref setBudget() or
+for all types together with @ref setBudget(std::size_t), resource sizes
+reported for other policies are counted towards the usage as well:
+
+@snippet Magnum.cpp ResourceManager-budget
+
+If a loader is set for given type, the next @ref get() of an unloaded
+resource will request it from the loader again, which makes it possible to
+keep a working set of resources that's bounded in size. The loader reports
+the size through @ref AbstractResourceLoader::set().
+
+@section ResourceManager-thread-safety Thread safety
+
+By default the manager is not thread-safe, which makes it the fastest for the
+common case of all resources being loaded and accessed from a single thread.
+Constructing it with @ref ResourceManagerFlag::ThreadSafe makes it possible to
+populate and access the resources from multiple threads at once --- in that
+case the resources are distributed across several independently locked
+shards, reference counts in @ref Resource are atomic and a @ref Resource that
+reached @ref ResourceState::Final doesn't touch the manager at all anymore.
+The @ref AsyncResourceLoader then provides a pool of worker threads that load
+the data in the background, moving the resources from
+@ref ResourceState::Loading to @ref ResourceState::Final without blocking
+@ref get() calls on the main thread:
+
+@snippet Magnum.cpp ResourceManager-thread-safe
+
+Note that while the locking makes all operations on the manager itself safe,
+replacing data of a @ref ResourceDataState::Mutable resource from one thread
+deletes the previous data that may be still used by @ref Resource instances in
+other threads. Only the transition of a @ref ResourceDataState::Loading
+resource to a final state is safe in all cases. Functions setting the
+fallback or the loader are not meant to be called while other threads access
+the manager.
+
+@see @ref AbstractResourceLoader, @ref AsyncResourceLoader
 */
 /* Due to too much work involved with explicit template instantiation (all
    Resource combinations, all ResourceManagerData...), this class doesn't have
    template implementation file. */
-template<class... Types> class ResourceManager: private Implementation::ResourceManagerData<Types>... {
+template<class... Types> class ResourceManager: private Implementation::ResourceManagerBase, private Implementation::ResourceManagerData<Types>... {
     public:
-        /** @brief Constructor */
-        explicit ResourceManager();
+        /**
+         * @brief Constructor
+         *
+         * By default the manager is not thread-safe, pass
+         * @ref ResourceManagerFlag::ThreadSafe to make it possible to access
+         * it from multiple threads at once.
+         */
+        explicit ResourceManager(ResourceManagerFlags flags = {});
 
         /**
          * @brief Destructor
@@ -236,11 +439,92 @@ template<class... Types> class ResourceManager: private Implementation::Resource
          */
         ~ResourceManager();
 
+        /**
+         * @brief Flags
+         * @m_since_latest
+         */
+        ResourceManagerFlags flags() const { return _flags; }
+
         /** @brief Count of resources of given type */
         template<class T> std::size_t count() {
             return this->Implementation::ResourceManagerData<T>::count();
         }
 
+        /**
+         * @brief Memory usage of resources of given type
+         * @m_since_latest
+         *
+         * Sum of sizes passed to @ref set() for all resources of given type
+         * that are currently in the manager.
+         * @see @ref ResourceManager-budget
+         */
+        template<class T> std::size_t memoryUsage() const {
+            return this->Implementation::ResourceManagerData<T>::memoryUsage();
+        }
+
+        /**
+         * @brief Memory usage of all resources
+         * @m_since_latest
+         *
+         * Sum of @ref memoryUsage() const for all types.
+         */
+        std::size_t memoryUsage() const {
+            return Implementation::ResourceManagerBase::memoryUsage();
+        }
+
+        /**
+         * @brief Memory budget for resources of given type
+         * @m_since_latest
+         *
+         * Default is @cpp ~std::size_t{} @ce, i.e. unlimited.
+         * @see @ref setBudget()
+         */
+        template<class T> std::size_t budget() const {
+            return this->Implementation::ResourceManagerData<T>::budget();
+        }
+
+        /**
+         * @brief Memory budget for all resources
+         * @m_since_latest
+         *
+         * Default is @cpp ~std::size_t{} @ce, i.e. unlimited.
+         * @see @ref setBudget(std::size_t)
+         */
+        std::size_t budget() const {
+            return Implementation::ResourceManagerBase::budget();
+        }
+
+        /**
+         * @brief Set memory budget for resources of given type
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If @ref memoryUsage() for given type exceeds @p budget, the least
+         * recently used unreferenced resources with
+         * @ref ResourcePolicy::Cached are unloaded until it fits. Other
+         * resources are never unloaded, so the usage can stay above the
+         * budget if there's nothing else to unload. See
+         * @ref ResourceManager-budget for more information.
+         */
+        template<class T> ResourceManager<Types...>& setBudget(std::size_t budget) {
+            this->Implementation::ResourceManagerData<T>::setBudget(budget);
+            return *this;
+        }
+
+        /**
+         * @brief Set memory budget for all resources
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Like @ref setBudget(), but applies to the sum of memory usage of
+         * all types. Least recently used resources are unloaded first,
+         * regardless of their type.
+         */
+        ResourceManager<Types...>& setBudget(std::size_t budget) {
+            Implementation::ResourceManagerBase::setBudget(budget);
+            return *this;
+        }
+
         /**
          * @brief Get resource reference
          *
@@ -282,12 +566,17 @@ template<class... Types> class ResourceManager: private Implementation::Resource
          * zero reference count. It means that all reference counted resources
          * which were only loaded but not used will stay loaded and you need to
          * explicitly call @ref free() to delete them.
+         *
+         * The @p size is counted towards @ref memoryUsage() and is used to
+         * decide which @ref ResourcePolicy::Cached resources to unload when
+         * the budget is exceeded. See @ref ResourceManager-budget for more
+         * information.
          * @attention Subsequent updates are not possible if resource state is
          *      already @ref ResourceState::Final.
          * @see @ref referenceCount(), @ref state()
          */
-        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
-            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy);
+        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy, size);
             return *this;
         }
 
@@ -295,14 +584,14 @@ template<class... Types> class ResourceManager: private Implementation::Resource
          * @overload
          * @m_since{2019,10}
          */
-        template<class T> ResourceManager<Types...>& set(ResourceKey key, Containers::Pointer<T>&& data, ResourceDataState state, ResourcePolicy policy) {
-            set(key, data.release(), state, policy);
+        template<class T> ResourceManager<Types...>& set(ResourceKey key, Containers::Pointer<T>&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            set(key, data.release(), state, policy, size);
             return *this;
         }
 
         /** @overload */
-        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy) {
-            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
+        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
         }
 
         /**
@@ -381,8 +670,8 @@ template<class... Types> class ResourceManager: private Implementation::Resource
          * @brief Clear all resources of given type
          * @return Reference to self (for method chaining)
          *
-         * Unlike @ref free() this function assumes that no resource is
-         * referenced.
+         * Unlike @ref free() this function expects that no resource is
+         * referenced, otherwise nothing is cleared.
          */
         template<class T> ResourceManager<Types...>& clear() {
             this->Implementation::ResourceManagerData<T>::clear();
@@ -393,8 +682,9 @@ template<class... Types> class ResourceManager: private Implementation::Resource
          * @brief Clear all resources
          * @return Reference to self (for method chaining)
          *
-         * Unlike @ref free() this function assumes that no resource is
-         * referenced.
+         * Unlike @ref free() this function expects that no resource is
+         * referenced, otherwise resources of the type that has any
+         * references are not cleared.
          */
         ResourceManager<Types...>& clear() {
             clearInternal(Implementation::ResourceTypePack<Types...>{});
@@ -449,6 +739,26 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             freeLoaders(Implementation::ResourceTypePack<NextTypes...>{});
         }
         void freeLoaders(Implementation::ResourceTypePack<>) const {}
+
+        void evict() override;
+
+        template<class FirstType, class ...NextTypes> std::size_t oldestUnusedInternal(Implementation::ResourceTypePack<FirstType, NextTypes...>) const {
+            const std::size_t first = Implementation::ResourceManagerData<FirstType>::oldestUnused();
+            const std::size_t next = oldestUnusedInternal(Implementation::ResourceTypePack<NextTypes...>{});
+            return first < next ? first : next;
+        }
+        std::size_t oldestUnusedInternal(Implementation::ResourceTypePack<>) const {
+            return ~std::size_t{};
+        }
+
+        template<class FirstType, class ...NextTypes> void evictOldestInternal(Implementation::ResourceTypePack<FirstType, NextTypes...>, std::size_t oldest) {
+            if(Implementation::ResourceManagerData<FirstType>::oldestUnused() == oldest)
+                Implementation::ResourceManagerData<FirstType>::evictOldest();
+            else evictOldestInternal(Implementation::ResourceTypePack<NextTypes...>{}, oldest);
+        }
+        void evictOldestInternal(Implementation::ResourceTypePack<>, std::size_t) {}
+
+        ResourceManagerFlags _flags;
 };
 
 namespace Implementation {
@@ -458,33 +768,53 @@ template<class T> void safeDelete(T* data) {
     delete data;
 }
 
+template<class T> ResourceManagerData<T>::ResourceManagerData(const ResourceManagerFlags flags, ResourceManagerBase& base): _shards{Containers::ValueInit, flags & ResourceManagerFlag::ThreadSafe ? std::size_t(ShardCount) : 1}, _fallback{nullptr}, _loader{nullptr}, _lastChange{0}, _flags{flags}, _base(base), _budget{~std::size_t{}}, _memoryUsage{0} {}
+
 template<class T> ResourceManagerData<T>::~ResourceManagerData() {
     /* Loaders are already deleted via freeLoaders() from ResourceManager */
     safeDelete(_fallback);
 }
 
+template<class T> std::size_t ResourceManagerData<T>::count() const {
+    std::size_t count = 0;
+    for(Shard& shard: _shards) {
+        auto lock = this->lock(shard);
+        count += shard.data.size();
+    }
+    return count;
+}
+
+template<class T> void ResourceManagerData<T>::setBudget(const std::size_t budget) {
+    _budget = budget;
+    evict();
+}
+
 template<class T> std::size_t ResourceManagerData<T>::referenceCount(const ResourceKey key) const {
-    auto it = _data.find(key);
-    if(it == _data.end()) return 0;
+    Shard& shard = this->shard(key);
+    auto lock = this->lock(shard);
+    auto it = shard.data.find(key);
+    if(it == shard.data.end()) return 0;
     return it->second.referenceCount;
 }
 
 template<class T> ResourceState ResourceManagerData<T>::state(const ResourceKey key) const {
-    const auto it = _data.find(key);
+    Shard& shard = this->shard(key);
+    auto lock = this->lock(shard);
+    const auto it = shard.data.find(key);
 
     /* Resource not loaded */
-    if(it == _data.end() || !it->second.data) {
+    if(it == shard.data.end() || !it->second.data) {
         /* Fallback found, add *Fallback to state */
         if(_fallback) {
-            if(it != _data.end() && it->second.state == ResourceDataState::Loading)
+            if(it != shard.data.end() && it->second.state == ResourceDataState::Loading)
                 return ResourceState::LoadingFallback;
-            else if(it != _data.end() && it->second.state == ResourceDataState::NotFound)
+            else if(it != shard.data.end() && it->second.state == ResourceDataState::NotFound)
                 return ResourceState::NotFoundFallback;
             else return ResourceState::NotLoadedFallback;
         }
 
         /* Fallback not found, loading didn't start yet */
-        if(it == _data.end() || (it->second.state != ResourceDataState::Loading && it->second.state != ResourceDataState::NotFound))
+        if(it == shard.data.end() || (it->second.state != ResourceDataState::Loading && it->second.state != ResourceDataState::NotFound))
             return ResourceState::NotLoaded;
     }
 
@@ -492,36 +822,85 @@ template<class T> ResourceState ResourceManagerData<T>::state(const ResourceKey
     return static_cast<ResourceState>(it->second.state);
 }
 
-template<class T> template<class U> Resource<T, U> ResourceManagerData<T>::get(ResourceKey key) {
-    /* Ask loader for the data, if they aren't there yet */
-    if(_loader && _data.find(key) == _data.end())
-        _loader->load(key);
-
-    return Resource<T, U>(this, key);
-}
+template<class T> template<class U> Resource<T, U> ResourceManagerData<T>::get(const ResourceKey key) {
+    Shard& shard = this->shard(key);
+    Data* entry;
+    bool load = false;
+    {
+        auto lock = this->lock(shard);
+        auto it = shard.data.find(key);
+        if(it == shard.data.end()) {
+            it = shard.data.emplace(key, Data()).first;
+
+            /* If there's a loader, mark the resource as loading while still
+               holding the lock so concurrent get() calls don't request it
+               again */
+            if(_loader) {
+                /** @todo What policy for loading resources? */
+                it->second.state = ResourceDataState::Loading;
+                it->second.policy = ResourcePolicy::Resident;
+                ++_lastChange;
+                load = true;
+            }
+        }
 
-template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy) {
-    auto it = _data.find(key);
+        entry = &it->second;
 
-    /* NotFound / Loading state shouldn't have any data */
-    CORRADE_ASSERT((data == nullptr) == (state == ResourceDataState::NotFound || state == ResourceDataState::Loading),
-        "ResourceManager::set(): data should be null if and only if state is NotFound or Loading", );
+        /* Used again, so it can't be unloaded anymore */
+        removeFromLru(*entry);
+        ++entry->referenceCount;
+    }
 
-    /* Cannot change resource with already final state */
-    CORRADE_ASSERT(it == _data.end() || it->second.state != ResourceDataState::Final,
-        "ResourceManager::set(): cannot change already final resource" << key, );
+    /* Ask loader for the data. Done outside of the lock as the loader is
+       free to call set() directly from doLoad(). */
+    if(load) _loader->loadInternal(key);
 
-    /* Insert the resource, if not already there */
-    if(it == _data.end())
-        it = _data.emplace(key, Data()).first;
+    return Resource<T, U>{this, key, *entry};
+}
 
-    /* Otherwise delete previous data */
-    else safeDelete(it->second.data);
+template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy, const std::size_t size) {
+    {
+        Shard& shard = this->shard(key);
+        auto lock = this->lock(shard);
+        auto it = shard.data.find(key);
+
+        /* NotFound / Loading state shouldn't have any data */
+        CORRADE_ASSERT((data == nullptr) == (state == ResourceDataState::NotFound || state == ResourceDataState::Loading),
+            "ResourceManager::set(): data should be null if and only if state is NotFound or Loading", );
+
+        /* Cannot change resource with already final state */
+        CORRADE_ASSERT(it == shard.data.end() || it->second.state != ResourceDataState::Final,
+            "ResourceManager::set(): cannot change already final resource" << key, );
+
+        /* Insert the resource, if not already there */
+        if(it == shard.data.end())
+            it = shard.data.emplace(key, Data()).first;
+
+        /* Otherwise delete previous data */
+        else safeDelete(it->second.data);
+
+        /* Update the memory usage. Unsigned overflow makes this work also if
+           the new size is smaller. */
+        _memoryUsage += size - it->second.size;
+        _base._memoryUsage += size - it->second.size;
+
+        Data& entry = it->second;
+        entry.data = data;
+        entry.state = state;
+        entry.policy = policy;
+        entry.size = size;
+        ++_lastChange;
+
+        /* Unreferenced cached data can be unloaded right away, put them to
+           the end of the LRU list. Resources without data are never unloaded
+           as there's nothing to gain and the loader may be still working on
+           them. */
+        removeFromLru(entry);
+        if(policy == ResourcePolicy::Cached && data && !entry.referenceCount)
+            addToLru(key, entry);
+    }
 
-    it->second.data = data;
-    it->second.state = state;
-    it->second.policy = policy;
-    ++_lastChange;
+    evict();
 }
 
 template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
@@ -534,13 +913,92 @@ template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
 
 template<class T> void ResourceManagerData<T>::free() {
     /* Delete all non-referenced non-resident resources */
-    for(auto it = _data.begin(); it != _data.end(); ) {
-        if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount)
-            it = _data.erase(it);
-        else ++it;
+    for(Shard& shard: _shards) {
+        auto lock = this->lock(shard);
+        for(auto it = shard.data.begin(); it != shard.data.end(); ) {
+            if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount)
+                erase(shard, it++);
+            else ++it;
+        }
     }
 }
 
+template<class T> void ResourceManagerData<T>::clear() {
+    /* Resources point directly to their entries, so nothing can be removed
+       if any of them is still referenced */
+    for(Shard& shard: _shards) {
+        auto lock = this->lock(shard);
+        for(const auto& entry: shard.data)
+            CORRADE_ASSERT(!entry.second.referenceCount,
+                "ResourceManager: cleared/destroyed while data are still referenced", );
+    }
+
+    for(Shard& shard: _shards) {
+        auto lock = this->lock(shard);
+        for(auto& entry: shard.data) {
+            removeFromLru(entry.second);
+            _memoryUsage -= entry.second.size;
+            _base._memoryUsage -= entry.second.size;
+        }
+        shard.data.clear();
+    }
+}
+
+template<class T> std::size_t ResourceManagerData<T>::oldestUnused() const {
+    auto lock = this->lock(_lruMutex);
+    return _lru.empty() ? ~std::size_t{} : _lru.front().first;
+}
+
+template<class T> bool ResourceManagerData<T>::evictOldest() {
+    ResourceKey key;
+    {
+        auto lock = this->lock(_lruMutex);
+        if(_lru.empty()) return false;
+        key = _lru.front().second;
+    }
+
+    /* The LRU lock can't be held while taking the shard lock, so check that
+       nobody acquired the resource in the meantime. If it's not in the list
+       anymore, the next call will pick another one. */
+    Shard& shard = this->shard(key);
+    auto lock = this->lock(shard);
+    auto it = shard.data.find(key);
+    if(it != shard.data.end() && it->second.lru)
+        erase(shard, it);
+    return true;
+}
+
+template<class T> void ResourceManagerData<T>::addToLru(const ResourceKey key, Data& entry) {
+    auto lock = this->lock(_lruMutex);
+    entry.lruPosition = _lru.emplace(_lru.end(), ++_base._lastUse, key);
+    entry.lru = true;
+}
+
+template<class T> void ResourceManagerData<T>::removeFromLru(Data& entry) {
+    if(!entry.lru) return;
+
+    auto lock = this->lock(_lruMutex);
+    _lru.erase(entry.lruPosition);
+    entry.lru = false;
+}
+
+template<class T> void ResourceManagerData<T>::erase(Shard& shard, const typename std::unordered_map<ResourceKey, Data>::iterator it) {
+    removeFromLru(it->second);
+    _memoryUsage -= it->second.size;
+    _base._memoryUsage -= it->second.size;
+    shard.data.erase(it);
+}
+
+template<class T> void ResourceManagerData<T>::evict() {
+    while(_memoryUsage > _budget && evictOldest()) {}
+    if(_base._memoryUsage > _base._budget) _base.evict();
+}
+
+template<class T> std::pair<T*, ResourceDataState> ResourceManagerData<T>::data(const ResourceKey key, const Data& entry) const {
+    auto lock = this->lock(shard(key));
+    return {entry.data, entry.state};
+}
+
 template<class T> void ResourceManagerData<T>::setLoader(AbstractResourceLoader<T>* const loader) {
     /* Delete previous loader */
     delete _loader;
@@ -550,28 +1008,48 @@ template<class T> void ResourceManagerData<T>::setLoader(AbstractResourceLoader<
 }
 
 template<class T> void ResourceManagerData<T>::freeLoader() {
-    if(!_loader) return;
-
-    _loader->manager = nullptr;
+    /* The loader stays attached while it's being destroyed so an
+       asynchronous loader can still pass the in-progress and discarded
+       resources to the manager. The loader destructor resets _loader. */
     delete _loader;
 }
 
-template<class T> void ResourceManagerData<T>::decrementReferenceCount(ResourceKey key) {
-    auto it = _data.find(key);
-    CORRADE_INTERNAL_ASSERT(it != _data.end());
+template<class T> void ResourceManagerData<T>::decrementReferenceCount(const ResourceKey key, Data& entry) {
+    /* Still referenced from elsewhere, nothing else to do */
+    if(--entry.referenceCount) return;
+
+    /* Free the resource if it is reference counted or mark it as unused if
+       it is cached. The entry has to be looked up again under the lock, as
+       another thread might have acquired a new reference to it or even freed
+       it in the meantime, and so the entry can't be touched anymore. */
+    {
+        Shard& shard = this->shard(key);
+        auto lock = this->lock(shard);
+        auto it = shard.data.find(key);
+        if(it == shard.data.end() || it->second.referenceCount) return;
+
+        if(it->second.policy == ResourcePolicy::ReferenceCounted)
+            erase(shard, it);
+
+        /* Cached resources get unloaded only when over budget, put them to
+           the end of the LRU list */
+        else if(it->second.policy == ResourcePolicy::Cached && it->second.data && !it->second.lru)
+            addToLru(key, it->second);
+        else return;
+    }
 
-    /* Free the resource if it is reference counted */
-    if(--it->second.referenceCount == 0 && it->second.policy == ResourcePolicy::ReferenceCounted)
-        _data.erase(it);
+    evict();
 }
 
 template<class T> struct ResourceManagerData<T>::Data {
-    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0) {}
+    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), lru(false), size(0), referenceCount(0) {}
 
     Data(const Data&) = delete;
 
-    Data(Data&& other): data(other.data), state(other.state), policy(other.policy), referenceCount(other.referenceCount) {
+    /* Only ever called on an entry that's not in the LRU list yet */
+    Data(Data&& other): data(other.data), state(other.state), policy(other.policy), lru(false), size(other.size), referenceCount(other.referenceCount.load()) {
         other.data = nullptr;
+        other.size = 0;
         other.referenceCount = 0;
     }
 
@@ -583,7 +1061,12 @@ template<class T> struct ResourceManagerData<T>::Data {
     T* data;
     ResourceDataState state;
     ResourcePolicy policy;
-    std::size_t referenceCount;
+    /* Whether lruPosition is valid */
+    bool lru;
+    std::size_t size;
+    typename Lru::iterator lruPosition;
+    /* Atomic so Resource copies don't need to lock the shard */
+    std::atomic<std::size_t> referenceCount;
 };
 
 template<class T> inline ResourceManagerData<T>::Data::~Data() {
@@ -594,12 +1077,22 @@ template<class T> inline ResourceManagerData<T>::Data::~Data() {
 
 }
 
-template<class ...Types> ResourceManager<Types...>::ResourceManager() = default;
+template<class ...Types> ResourceManager<Types...>::ResourceManager(const ResourceManagerFlags flags): Implementation::ResourceManagerData<Types>(flags, *this)..., _flags{flags} {}
 
 template<class ...Types> ResourceManager<Types...>::~ResourceManager() {
     freeLoaders(typename Implementation::ResourceTypePack<Types...>{});
 }
 
+template<class ...Types> void ResourceManager<Types...>::evict() {
+    /* Unload the least recently used resource of any type until the total
+       fits. Stops once there's nothing left to unload. */
+    while(memoryUsage() > budget()) {
+        const std::size_t oldest = oldestUnusedInternal(Implementation::ResourceTypePack<Types...>{});
+        if(oldest == ~std::size_t{}) break;
+        evictOldestInternal(Implementation::ResourceTypePack<Types...>{}, oldest);
+    }
+}
+
 }
 
 /* Make the definition complete */
@@ -30,6 +30,7 @@
  */
 
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/GL/Shader.h"
 #include "Magnum/Shaders/AbstractVector.h"
 #include "Magnum/Shaders/visibility.h"
 
@@ -109,12 +110,35 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
         typedef Implementation::DistanceFieldVectorFlags Flags;
         #endif
 
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref DistanceFieldVector(Flags) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref DistanceFieldVector(CompileState&&)
+         */
+        static CompileState compile(Flags flags = {});
+
         /**
          * @brief Constructor
          * @param flags     Flags
          */
         explicit DistanceFieldVector(Flags flags = {});
 
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit DistanceFieldVector(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -225,6 +249,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
         #endif
 
     private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit DistanceFieldVector(NoInitT) {}
+
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
         using GL::AbstractShaderProgram::drawTransformFeedback;
@@ -242,6 +270,25 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
             _smoothnessUniform{5};
 };
 
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref DistanceFieldVector::compile(). See @ref shaders-async for
+more information.
+*/
+template<UnsignedInt dimensions> class DistanceFieldVector<dimensions>::CompileState: public DistanceFieldVector<dimensions> {
+    /* Everything deliberately private except for the inheritance */
+    friend DistanceFieldVector<dimensions>;
+
+    explicit CompileState(NoCreateT): DistanceFieldVector<dimensions>{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(DistanceFieldVector<dimensions>&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version): DistanceFieldVector<dimensions>{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version} {}
+
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+};
+
 /** @brief Two-dimensional distance field vector shader */
 typedef DistanceFieldVector<2> DistanceFieldVector2D;
 
@@ -27,8 +27,10 @@
 
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Shader.h"
@@ -43,11 +45,41 @@ namespace Magnum { namespace Shaders {
 
 namespace {
     enum: Int { TextureUnit = 0 };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    enum: Int {
+        TransformationProjectionBufferBinding = 0,
+        DrawBufferBinding = 1,
+        TextureTransformationBufferBinding = 2,
+        MaterialBufferBinding = 3
+    };
+    #endif
 }
 
-template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _flags(flags) {
+template<UnsignedInt dimensions> typename Flat<dimensions>::CompileState Flat<dimensions>::compile(const Flags flags
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount
+    #endif
+) {
     CORRADE_ASSERT(!(flags & Flag::TextureTransformation) || (flags & Flag::Textured),
-        "Shaders::Flat: texture transformation enabled but the shader is not textured", );
+        "Shaders::Flat: texture transformation enabled but the shader is not textured", CompileState{NoCreate});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
+        "Shaders::Flat: material count can't be zero", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
+        "Shaders::Flat: draw count can't be zero", CompileState{NoCreate});
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags >= Flag::UniformBuffers) {
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::uniform_buffer_object);
+        /* The draw ID is an unsigned integer passed between stages */
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::EXT::gpu_shader4);
+    }
+    if(flags >= Flag::MultiDraw)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::shader_draw_parameters);
+    #endif
 
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
@@ -73,8 +105,19 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
         .addSource(flags >= Flag::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
         #endif
         .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
-        .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "")
-        .addSource(rs.get("generic.glsl"))
+        .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        vert.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n",
+            drawCount));
+        #ifndef MAGNUM_TARGET_GLES
+        vert.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
+        #endif
+    }
+    #endif
+    vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Flat.vert"));
     frag.addSource(flags & Flag::Textured ? "#define TEXTURED\n" : "")
         .addSource(flags & Flag::AlphaMask ? "#define ALPHA_MASK\n" : "")
@@ -83,12 +126,38 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
         .addSource(flags & Flag::ObjectId ? "#define OBJECT_ID\n" : "")
         .addSource(flags >= Flag::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
         #endif
-        .addSource(rs.get("generic.glsl"))
+        ;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        frag.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n"
+            "#define MATERIAL_COUNT {}\n",
+            drawCount,
+            materialCount));
+    }
+    #endif
+    frag.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Flat.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    Flat<dimensions> out{NoInit};
+    out._flags = flags;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        out._materialCount = materialCount;
+        out._drawCount = drawCount;
+    }
+    #endif
+
+    /* If the program binary is in the cache, compilation and linking can be
+       skipped */
+    if(out.loadBinary({vert, frag}))
+        return CompileState{std::move(out), GL::Shader{NoCreate}, GL::Shader{NoCreate}, version};
+
+    vert.submitCompile();
+    frag.submitCompile();
 
-    attachShaders({vert, frag});
+    out.attachShaders({vert, frag});
 
     /* ES3 has this done in the shader directly and doesn't even provide
        bindFragmentDataLocation() */
@@ -97,61 +166,118 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
     #endif
     {
-        bindAttributeLocation(Position::Location, "position");
+        out.bindAttributeLocation(Position::Location, "position");
         if(flags & Flag::Textured)
-            bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
         if(flags & Flag::VertexColor)
-            bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
+            out.bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
         #ifndef MAGNUM_TARGET_GLES2
         if(flags & Flag::ObjectId) {
-            bindFragmentDataLocation(ColorOutput, "color");
-            bindFragmentDataLocation(ObjectIdOutput, "objectId");
+            out.bindFragmentDataLocation(ColorOutput, "color");
+            out.bindFragmentDataLocation(ObjectIdOutput, "objectId");
         }
         if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            out.bindAttributeLocation(ObjectId::Location, "instanceObjectId");
         #endif
         if(flags & Flag::InstancedTransformation)
-            bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+            out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
         if(flags >= Flag::InstancedTextureOffset)
-            bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+            out.bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
     }
     #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    out.submitLink();
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version};
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> typename Flat<dimensions>::CompileState Flat<dimensions>::compile(const Flags flags) {
+    return compile(flags, 1, 1);
+}
+#endif
+
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): Flat{compile(flags)} {}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags, const UnsignedInt materialCount, const UnsignedInt drawCount): Flat{compile(flags, materialCount, drawCount)} {}
+#endif
+
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(CompileState&& state): Flat{static_cast<Flat<dimensions>&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting so it doesn't crash on uniform queries
+       below. */
+    if(!id()) return;
+    #endif
+
+    /* The shaders weren't compiled if the program was loaded from a binary
+       cache */
+    if(state._vert.id())
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile());
+    CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
 
     #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = state._version;
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
-        if(flags & Flag::TextureTransformation)
-            _textureMatrixUniform = uniformLocation("textureMatrix");
-        _colorUniform = uniformLocation("color");
-        if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
         #ifndef MAGNUM_TARGET_GLES2
-        if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+        if(_flags >= Flag::UniformBuffers) {
+            _drawOffsetUniform = uniformLocation("drawOffset");
+        } else
         #endif
+        {
+            _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+            if(_flags & Flag::TextureTransformation)
+                _textureMatrixUniform = uniformLocation("textureMatrix");
+            _colorUniform = uniformLocation("color");
+            if(_flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(_flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+            #endif
+        }
     }
 
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
     #endif
     {
-        if(flags & Flag::Textured) setUniform(uniformLocation("textureData"), TextureUnit);
+        if(_flags & Flag::Textured) setUniform(uniformLocation("textureData"), TextureUnit);
+        #ifndef MAGNUM_TARGET_GLES2
+        if(_flags >= Flag::UniformBuffers) {
+            setUniformBlockBinding(uniformBlockIndex("TransformationProjection"), TransformationProjectionBufferBinding);
+            setUniformBlockBinding(uniformBlockIndex("Draw"), DrawBufferBinding);
+            if(_flags & Flag::TextureTransformation)
+                setUniformBlockBinding(uniformBlockIndex("TextureTransformation"), TextureTransformationBufferBinding);
+            setUniformBlockBinding(uniformBlockIndex("Material"), MaterialBufferBinding);
+        }
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
-    setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
-    if(flags & Flag::TextureTransformation)
-        setTextureMatrix(Matrix3{Math::IdentityInit});
-    setColor(Magnum::Color4{1.0f});
-    if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
-    /* Object ID is zero by default */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_flags >= Flag::UniformBuffers) {
+        /* Draw offset is zero by default */
+    } else
+    #endif
+    {
+        setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
+        if(_flags & Flag::TextureTransformation)
+            setTextureMatrix(Matrix3{Math::IdentityInit});
+        setColor(Magnum::Color4{1.0f});
+        if(_flags & Flag::AlphaMask) setAlphaMask(0.5f);
+        /* Object ID is zero by default */
+    }
     #endif
 }
 
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_transformationProjectionMatrixUniform, matrix);
     return *this;
 }
@@ -159,11 +285,19 @@ template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTransfor
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTextureMatrix(const Matrix3& matrix) {
     CORRADE_ASSERT(_flags & Flag::TextureTransformation,
         "Shaders::Flat::setTextureMatrix(): the shader was not created with texture transformation enabled", *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setTextureMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_textureMatrixUniform, matrix);
     return *this;
 }
 
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setColor(const Magnum::Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_colorUniform, color);
     return *this;
 }
@@ -178,6 +312,10 @@ template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTexture
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setAlphaMask(Float mask) {
     CORRADE_ASSERT(_flags & Flag::AlphaMask,
         "Shaders::Flat::setAlphaMask(): the shader was not created with alpha mask enabled", *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setAlphaMask(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_alphaMaskUniform, mask);
     return *this;
 }
@@ -186,9 +324,80 @@ template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setAlphaMas
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setObjectId(UnsignedInt id) {
     CORRADE_ASSERT(_flags & Flag::ObjectId,
         "Shaders::Flat::setObjectId(): the shader was not created with object ID enabled", *this);
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setObjectId(): the shader was created with uniform buffers enabled", *this);
     setUniform(_objectIdUniform, id);
     return *this;
 }
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::setDrawOffset(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(offset < _drawCount,
+        "Shaders::Flat::setDrawOffset(): draw offset" << offset << "is out of bounds for" << _drawCount << "draws", *this);
+    setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTransformationProjectionBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationProjectionBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTransformationProjectionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationProjectionBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTextureTransformationBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTextureTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindMaterialBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindMaterialBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
+    return *this;
+}
 #endif
 
 template class Flat<2>;
@@ -212,11 +421,17 @@ Debug& operator<<(Debug& debug, const FlatFlag value) {
         #endif
         _c(InstancedTransformation)
         _c(InstancedTextureOffset)
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(UniformBuffers)
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        _c(MultiDraw)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
 
-    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedShort(value)) << Debug::nospace << ")";
 }
 
 Debug& operator<<(Debug& debug, const FlatFlags value) {
@@ -230,7 +445,14 @@ Debug& operator<<(Debug& debug, const FlatFlags value) {
         FlatFlag::InstancedObjectId, /* Superset of ObjectId */
         FlatFlag::ObjectId,
         #endif
-        FlatFlag::InstancedTransformation});
+        FlatFlag::InstancedTransformation,
+        #ifndef MAGNUM_TARGET_GLES
+        FlatFlag::MultiDraw, /* Superset of UniformBuffers */
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        FlatFlag::UniformBuffers
+        #endif
+        });
 }
 
 }
@@ -23,10 +23,14 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#if defined(OBJECT_ID) && !defined(GL_ES) && !defined(NEW_GLSL)
+#if (defined(OBJECT_ID) || defined(UNIFORM_BUFFERS)) && !defined(GL_ES) && !defined(NEW_GLSL)
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
 #ifndef NEW_GLSL
 #define fragmentColor gl_FragColor
 #define texture texture2D
@@ -40,6 +44,7 @@ layout(binding = 0)
 uniform lowp sampler2D textureData;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 2)
 #endif
@@ -68,6 +73,42 @@ layout(location = 4)
 uniform highp uint objectId; /* defaults to zero */
 #endif
 
+/* Uniform buffers */
+
+#else
+/* Keep in sync with FlatDrawUniform in Flat.h. The struct is padded to 16
+   bytes by the std140 array stride rules. */
+struct DrawUniform {
+    highp uint materialId;
+    highp uint objectId;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 1
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+/* Keep in sync with FlatMaterialUniform in Flat.h. The struct is padded to 32
+   bytes by the std140 array stride rules. */
+struct MaterialUniform {
+    lowp vec4 color;
+    lowp float alphaMask;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 3
+    #endif
+) uniform Material {
+    MaterialUniform materials[MATERIAL_COUNT];
+};
+
+flat in highp uint drawId;
+#endif
+
 #ifdef TEXTURED
 in mediump vec2 interpolatedTextureCoordinates;
 #endif
@@ -95,6 +136,17 @@ out highp uint fragmentObjectId;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef OBJECT_ID
+    highp uint objectId = draws[drawId].objectId;
+    #endif
+    highp uint materialId = draws[drawId].materialId;
+    lowp vec4 color = materials[materialId].color;
+    #ifdef ALPHA_MASK
+    lowp float alphaMask = materials[materialId].alphaMask;
+    #endif
+    #endif
+
     fragmentColor =
         #ifdef TEXTURED
         texture(textureData, interpolatedTextureCoordinates)*
@@ -26,18 +26,20 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Shaders::Flat, typedef @ref Magnum::Shaders::Flat2D, @ref Magnum::Shaders::Flat3D
+ * @brief Class @ref Magnum::Shaders::Flat, struct @ref Magnum::Shaders::FlatDrawUniform, @ref Magnum::Shaders::FlatMaterialUniform, typedef @ref Magnum::Shaders::Flat2D, @ref Magnum::Shaders::Flat3D
  */
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/Shaders/Generic.h"
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
 
 namespace Implementation {
-    enum class FlatFlag: UnsignedByte {
+    enum class FlatFlag: UnsignedShort {
         Textured = 1 << 0,
         AlphaMask = 1 << 1,
         VertexColor = 1 << 2,
@@ -47,7 +49,13 @@ namespace Implementation {
         InstancedObjectId = (1 << 5)|ObjectId,
         #endif
         InstancedTransformation = 1 << 6,
-        InstancedTextureOffset = (1 << 7)|TextureTransformation
+        InstancedTextureOffset = (1 << 7)|TextureTransformation,
+        #ifndef MAGNUM_TARGET_GLES2
+        UniformBuffers = 1 << 8,
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        MultiDraw = UniformBuffers|(1 << 9)
+        #endif
     };
     typedef Containers::EnumSet<FlatFlag> FlatFlags;
 }
@@ -149,6 +157,37 @@ color to a mesh:
 @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
     1.0.
 
+@section Shaders-Flat-ubo Uniform buffers
+
+Setting a handful of uniforms for every draw is a significant CPU overhead
+when drawing many different objects. Enabling @ref Flag::UniformBuffers
+switches the shader to take per-draw state from uniform buffers instead of
+individual uniforms. Transformation is supplied via a
+@ref TransformationProjectionUniform2D / @ref TransformationProjectionUniform3D
+buffer bound with @ref bindTransformationProjectionBuffer(), per-draw material
+index and object ID in a @ref FlatDrawUniform buffer bound with
+@ref bindDrawBuffer(), materials in a @ref FlatMaterialUniform buffer bound
+with @ref bindMaterialBuffer() and, if @ref Flag::TextureTransformation is
+enabled, texture transformation in a @ref TextureTransformationUniform buffer
+bound with @ref bindTextureTransformationBuffer(). The draw and material
+counts, which define the uniform array sizes, are passed to the
+@ref Flat(Flags, UnsignedInt, UnsignedInt) constructor. A draw is then picked
+with @ref setDrawOffset():
+
+@snippet MagnumShaders.cpp Flat-usage-ubo
+
+With @ref Flag::MultiDraw enabled as well, the draw offset is further summed
+with the @glsl gl_DrawID @ce builtin, which makes it possible to render many
+different objects, each with its own transformation and material, in a single
+@ref draw(Containers::ArrayView<const Containers::Reference<MeshView>>) or
+@ref drawIndirect() call:
+
+@snippet MagnumShaders.cpp Flat-usage-multidraw
+
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+
 @see @ref shaders, @ref Flat2D, @ref Flat3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::AbstractShaderProgram {
@@ -363,7 +402,45 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
              *      in WebGL 1.0.
              * @m_since{2020,06}
              */
-            InstancedTextureOffset = (1 << 7)|TextureTransformation
+            InstancedTextureOffset = (1 << 7)|TextureTransformation,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Use uniform buffers. Expects that uniform data are supplied via
+             * @ref bindTransformationProjectionBuffer(), @ref bindDrawBuffer(),
+             * @ref bindTextureTransformationBuffer() and
+             * @ref bindMaterialBuffer() instead of direct uniform setters. See
+             * @ref Shaders-Flat-ubo for more information.
+             * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            UniformBuffers = 1 << 8,
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Enable multidraw functionality. Implies
+             * @ref Flag::UniformBuffers and adds the value from
+             * @ref setDrawOffset() with the @glsl gl_DrawID @ce builtin,
+             * which makes draws submitted via
+             * @ref GL::AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+             * or @ref GL::AbstractShaderProgram::drawIndirect() pick up
+             * per-draw parameters directly, without having to rebind the
+             * uniform buffers or specify @ref setDrawOffset() before each
+             * draw. See @ref Shaders-Flat-ubo for more information.
+             * @requires_gl46 Extension @gl_extension{ARB,uniform_buffer_object}
+             *      and @gl_extension{ARB,shader_draw_parameters}
+             * @requires_gl Multidraw with @glsl gl_DrawID @ce is not available
+             *      in OpenGL ES or WebGL.
+             * @m_since_latest
+             */
+            MultiDraw = UniformBuffers|(1 << 9)
+            #endif
         };
 
         /**
@@ -379,12 +456,84 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
         typedef Implementation::FlatFlags Flags;
         #endif
 
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref Flat(Flags) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref Flat(CompileState&&)
+         */
+        static CompileState compile(Flags flags = {});
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Compile a uniform buffer variant asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref Flat(Flags, UnsignedInt, UnsignedInt) can perform
+         * an asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref Flat(CompileState&&)
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
         /**
          * @brief Constructor
          * @param flags     Flags
          */
         explicit Flat(Flags flags = {});
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Construct for rendering with uniform buffers
+         * @param flags         Flags
+         * @param materialCount Size of a @ref FlatMaterialUniform buffer
+         *      bound with @ref bindMaterialBuffer()
+         * @param drawCount     Size of a
+         *      @ref TransformationProjectionUniform2D /
+         *      @ref TransformationProjectionUniform3D /
+         *      @ref FlatDrawUniform / @ref TextureTransformationUniform
+         *      buffer bound with @ref bindTransformationProjectionBuffer(),
+         *      @ref bindDrawBuffer() and
+         *      @ref bindTextureTransformationBuffer()
+         * @m_since_latest
+         *
+         * If @p flags contain @ref Flag::UniformBuffers, expects that both
+         * @p materialCount and @p drawCount are larger than zero. The counts
+         * define the uniform array sizes, so they're limited by the maximum
+         * uniform block size supported by the implementation. If
+         * @p flags don't contain @ref Flag::UniformBuffers, the counts are
+         * ignored and the constructor behaves the same as @ref Flat(Flags).
+         * If @p flags contain @ref Flag::MultiDraw, expects that
+         * @gl_extension{ARB,shader_draw_parameters} is supported. See
+         * @ref Shaders-Flat-ubo for more information.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        explicit Flat(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit Flat(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -414,11 +563,45 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
         /** @brief Flags */
         Flags flags() const { return _flags; }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Material count
+         * @m_since_latest
+         *
+         * Statically defined size of the @ref FlatMaterialUniform uniform
+         * buffer. Has use only if @ref Flag::UniformBuffers is set, otherwise
+         * @cpp 0 @ce.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Draw count
+         * @m_since_latest
+         *
+         * Statically defined size of each of the
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D, @ref FlatDrawUniform and
+         * @ref TextureTransformationUniform uniform buffers. Has use only if
+         * @ref Flag::UniformBuffers is set, otherwise @cpp 0 @ce.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+        #endif
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
          *
-         * Initial value is an identity matrix.
+         * Initial value is an identity matrix. Expects that
+         * @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TransformationProjectionUniform2D::transformationProjectionMatrix /
+         * @ref TransformationProjectionUniform3D::transformationProjectionMatrix
+         * and call @ref bindTransformationProjectionBuffer() instead.
          */
         Flat<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix);
 
@@ -429,7 +612,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          *
          * Expects that the shader was created with
          * @ref Flag::TextureTransformation enabled. Initial value is an
-         * identity matrix.
+         * identity matrix. If @ref Flag::UniformBuffers is set, use
+         * @ref TextureTransformationUniform::setTextureMatrix() and
+         * @ref bindTextureTransformationBuffer() instead.
          */
         Flat<dimensions>& setTextureMatrix(const Matrix3& matrix);
 
@@ -439,7 +624,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          *
          * If @ref Flag::Textured is set, initial value is
          * @cpp 0xffffffff_rgbaf @ce and the color will be multiplied with the
-         * texture.
+         * texture. Expects that @ref Flag::UniformBuffers is not set, in that
+         * case fill @ref FlatMaterialUniform::color and call
+         * @ref bindMaterialBuffer() instead.
          * @see @ref bindTexture()
          */
         Flat<dimensions>& setColor(const Magnum::Color4& color);
@@ -462,7 +649,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          * Expects that the shader was created with @ref Flag::AlphaMask
          * enabled. Fragments with alpha values smaller than the mask value
          * will be discarded. Initial value is @cpp 0.5f @ce. See the flag
-         * documentation for further information.
+         * documentation for further information. If
+         * @ref Flag::UniformBuffers is set, fill
+         * @ref FlatMaterialUniform::alphaMask and call
+         * @ref bindMaterialBuffer() instead.
          */
         Flat<dimensions>& setAlphaMask(Float mask);
 
@@ -476,14 +666,124 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          * @ref Shaders-Flat-object-id for more information. Default is
          * @cpp 0 @ce. If @ref Flag::InstancedObjectId is enabled as well, this
          * value is combined with ID coming from the @ref ObjectId attribute.
+         * If @ref Flag::UniformBuffers is set, fill
+         * @ref FlatDrawUniform::objectId and call @ref bindDrawBuffer()
+         * instead.
          * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
          * @requires_gles30 Object ID output requires integer support in
          *      shaders, which is not available in OpenGL ES 2.0 or WebGL 1.0.
          */
         Flat<dimensions>& setObjectId(UnsignedInt id);
+
+        /**
+         * @brief Set a draw offset
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Specifies which item in the uniform buffers bound with
+         * @ref bindTransformationProjectionBuffer(), @ref bindDrawBuffer()
+         * and @ref bindTextureTransformationBuffer() should be used for
+         * current draw. Expects that @ref Flag::UniformBuffers is set and
+         * @p offset is less than @ref drawCount(). Initial value is
+         * @cpp 0 @ce. If @ref Flag::MultiDraw is set, @glsl gl_DrawID @ce is
+         * added to this value, which makes each draw submitted via
+         * @ref GL::AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+         * pick up its own per-draw parameters.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Set a transformation and projection uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D. At the very least you need
+         * to call also @ref bindDrawBuffer() and @ref bindMaterialBuffer().
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindTransformationProjectionBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindTransformationProjectionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref FlatDrawUniform. At the very least you need to call also
+         * @ref bindTransformationProjectionBuffer() and
+         * @ref bindMaterialBuffer().
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindDrawBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindDrawBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a texture transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that both @ref Flag::UniformBuffers and
+         * @ref Flag::TextureTransformation is set. The buffer is expected to
+         * contain @ref drawCount() instances of
+         * @ref TextureTransformationUniform.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindTextureTransformationBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindTextureTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a material uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref materialCount() instances of
+         * @ref FlatMaterialUniform. At the very least you need to call also
+         * @ref bindTransformationProjectionBuffer() and
+         * @ref bindDrawBuffer().
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindMaterialBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindMaterialBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
         #endif
 
     private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit Flat(NoInitT) {}
+
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
         using GL::AbstractShaderProgram::drawTransformFeedback;
@@ -493,21 +793,175 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
         #endif
 
         Flags _flags;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _materialCount{}, _drawCount{};
+        #endif
         Int _transformationProjectionMatrixUniform{0},
             _textureMatrixUniform{1},
             _colorUniform{2},
             _alphaMaskUniform{3};
         #ifndef MAGNUM_TARGET_GLES2
         Int _objectIdUniform{4};
+        /* Used instead of all other uniforms when Flag::UniformBuffers is
+           set, so it can alias them */
+        Int _drawOffsetUniform{0};
         #endif
 };
 
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref Flat::compile(). See @ref shaders-async for
+more information.
+*/
+template<UnsignedInt dimensions> class Flat<dimensions>::CompileState: public Flat<dimensions> {
+    /* Everything deliberately private except for the inheritance */
+    friend Flat<dimensions>;
+
+    explicit CompileState(NoCreateT): Flat<dimensions>{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(Flat<dimensions>&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version): Flat<dimensions>{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version} {}
+
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+};
+
 /** @brief 2D flat shader */
 typedef Flat<2> Flat2D;
 
 /** @brief 3D flat shader */
 typedef Flat<3> Flat3D;
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Per-draw uniform for flat shaders
+@m_since_latest
+
+Contents of a uniform buffer bound with @ref Flat::bindDrawBuffer(). Follows
+the std140 layout rules, one instance per draw. See @ref Shaders-Flat-ubo for
+more information.
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct FlatDrawUniform {
+    /** @brief Constructor */
+    constexpr explicit FlatDrawUniform() noexcept: materialId{0}, objectId{0} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit FlatDrawUniform(NoInitT) noexcept {}
+
+    /**
+     * @brief Set the @ref materialId field
+     * @return Reference to self (for method chaining)
+     */
+    FlatDrawUniform& setMaterialId(UnsignedInt id) {
+        materialId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref objectId field
+     * @return Reference to self (for method chaining)
+     */
+    FlatDrawUniform& setObjectId(UnsignedInt id) {
+        objectId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Material ID
+     *
+     * Index into the @ref FlatMaterialUniform buffer bound with
+     * @ref Flat::bindMaterialBuffer(). Expected to be less than
+     * @ref Flat::materialCount(). Default value is @cpp 0 @ce.
+     */
+    UnsignedInt materialId;
+
+    /**
+     * @brief Object ID
+     *
+     * Used only if @ref Flat::Flag::ObjectId is enabled, ignored otherwise.
+     * If @ref Flat::Flag::InstancedObjectId is enabled as well, this value is
+     * added to the ID coming from the @ref Flat::ObjectId attribute. Default
+     * value is @cpp 0 @ce.
+     * @see @ref Flat::setObjectId()
+     */
+    UnsignedInt objectId;
+
+    /* Explicit padding to the std140 array stride */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    Int:32;
+    #endif
+};
+
+/**
+@brief Material uniform for flat shaders
+@m_since_latest
+
+Contents of a uniform buffer bound with @ref Flat::bindMaterialBuffer().
+Follows the std140 layout rules, one instance per material, selected with
+@ref FlatDrawUniform::materialId. See @ref Shaders-Flat-ubo for more
+information.
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct FlatMaterialUniform {
+    /** @brief Constructor */
+    constexpr explicit FlatMaterialUniform() noexcept: color{1.0f, 1.0f, 1.0f, 1.0f}, alphaMask{0.5f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit FlatMaterialUniform(NoInitT) noexcept: color{NoInit} {}
+
+    /**
+     * @brief Set the @ref color field
+     * @return Reference to self (for method chaining)
+     */
+    FlatMaterialUniform& setColor(const Color4& color) {
+        this->color = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref alphaMask field
+     * @return Reference to self (for method chaining)
+     */
+    FlatMaterialUniform& setAlphaMask(Float alphaMask) {
+        this->alphaMask = alphaMask;
+        return *this;
+    }
+
+    /**
+     * @brief Color
+     *
+     * Default value is @cpp 0xffffffff_rgbaf @ce. If
+     * @ref Flat::Flag::Textured is enabled, the color is multiplied with
+     * the texture.
+     * @see @ref Flat::setColor()
+     */
+    Color4 color;
+
+    /**
+     * @brief Alpha mask value
+     *
+     * Used only if @ref Flat::Flag::AlphaMask is enabled, ignored otherwise.
+     * Default value is @cpp 0.5f @ce.
+     * @see @ref Flat::setAlphaMask()
+     */
+    Float alphaMask;
+
+    /* Explicit padding to the std140 array stride */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    Int:32;
+    Int:32;
+    #endif
+};
+#endif
+
 #ifdef DOXYGEN_GENERATING_OUTPUT
 /** @debugoperatorclassenum{Flat,Flat::Flag} */
 template<UnsignedInt dimensions> Debug& operator<<(Debug& debug, Flat<dimensions>::Flag value);
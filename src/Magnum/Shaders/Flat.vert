@@ -23,15 +23,24 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#if defined(INSTANCED_OBJECT_ID) && !defined(GL_ES) && !defined(NEW_GLSL)
+#if (defined(INSTANCED_OBJECT_ID) || defined(UNIFORM_BUFFERS)) && !defined(GL_ES) && !defined(NEW_GLSL)
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
+#ifdef MULTI_DRAW
+#extension GL_ARB_shader_draw_parameters: require
+#endif
+
 #ifndef NEW_GLSL
 #define in attribute
 #define out varying
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
@@ -62,6 +71,55 @@ uniform mediump mat3 textureMatrix
     ;
 #endif
 
+/* Uniform buffers */
+
+#else
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp uint drawOffset
+    #ifndef GL_ES
+    = 0u
+    #endif
+    ;
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 0
+    #endif
+) uniform TransformationProjection {
+    /* In 2D the mat3 is padded to three vec4s by the std140 rules, matching
+       TransformationProjectionUniform2D */
+    highp
+        #ifdef TWO_DIMENSIONS
+        mat3
+        #elif defined(THREE_DIMENSIONS)
+        mat4
+        #else
+        #error
+        #endif
+    transformationProjectionMatrices[DRAW_COUNT];
+};
+
+#ifdef TEXTURE_TRANSFORMATION
+/* Keep in sync with TextureTransformationUniform in Generic.h */
+struct TextureTransformationUniform {
+    mediump vec4 rotationScaling;
+    mediump vec4 offsetReservedReserved;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform TextureTransformation {
+    TextureTransformationUniform textureTransformations[DRAW_COUNT];
+};
+#endif
+
+flat out highp uint drawId;
+#endif
+
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -121,6 +179,28 @@ in mediump vec2 instancedTextureOffset;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef MULTI_DRAW
+    drawId = drawOffset + uint(gl_DrawIDARB);
+    #else
+    drawId = drawOffset;
+    #endif
+    #ifdef TWO_DIMENSIONS
+    highp mat3
+    #elif defined(THREE_DIMENSIONS)
+    highp mat4
+    #else
+    #error
+    #endif
+        transformationProjectionMatrix = transformationProjectionMatrices[drawId];
+    #ifdef TEXTURE_TRANSFORMATION
+    mediump mat3 textureMatrix = mat3(
+        vec3(textureTransformations[drawId].rotationScaling.xy, 0.0),
+        vec3(textureTransformations[drawId].rotationScaling.zw, 0.0),
+        vec3(textureTransformations[drawId].offsetReservedReserved.xy, 1.0));
+    #endif
+    #endif
+
     #ifdef TWO_DIMENSIONS
     gl_Position.xywz = vec4(transformationProjectionMatrix*
         #ifdef INSTANCED_TRANSFORMATION
@@ -26,10 +26,12 @@
 */
 
 /** @file
- * @brief Struct @ref Magnum::Shaders::Generic, typedef @ref Magnum::Shaders::Generic2D, @ref Magnum::Shaders::Generic3D
+ * @brief Struct @ref Magnum::Shaders::Generic, @ref Magnum::Shaders::TransformationProjectionUniform2D, @ref Magnum::Shaders::TransformationProjectionUniform3D, @ref Magnum::Shaders::ProjectionUniform3D, @ref Magnum::Shaders::TransformationUniform3D, @ref Magnum::Shaders::TextureTransformationUniform, typedef @ref Magnum::Shaders::Generic2D, @ref Magnum::Shaders::Generic3D
  */
 
 #include "Magnum/GL/Attribute.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
 
 namespace Magnum { namespace Shaders {
 
@@ -436,6 +438,224 @@ typedef Generic<2> Generic2D;
 /** @brief Generic 3D shader definition */
 typedef Generic<3> Generic3D;
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief 2D transformation and projection uniform common for all shaders
+@m_since_latest
+
+Contents of a uniform buffer consumed by shaders with the
+@ref Flat::Flag::UniformBuffers "Flag::UniformBuffers" flag enabled. Follows
+the std140 layout rules, one instance per draw. See
+@ref shaders-generic-uniforms for more information.
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TransformationProjectionUniform2D {
+    /** @brief Constructor */
+    constexpr explicit TransformationProjectionUniform2D() noexcept: transformationProjectionMatrix{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TransformationProjectionUniform2D(NoInitT) noexcept: transformationProjectionMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref transformationProjectionMatrix field
+     * @return Reference to self (for method chaining)
+     *
+     * The matrix is expanded to @relativeref{Magnum,Matrix3x4}, with the
+     * bottom row being zero.
+     */
+    TransformationProjectionUniform2D& setTransformationProjectionMatrix(const Matrix3& matrix) {
+        transformationProjectionMatrix = Matrix3x4{
+            Vector4{matrix[0], 0.0f},
+            Vector4{matrix[1], 0.0f},
+            Vector4{matrix[2], 0.0f}};
+        return *this;
+    }
+
+    /**
+     * @brief Transformation and projection matrix
+     *
+     * Default value is an identity matrix. The bottom row is unused and acts
+     * only as a padding to match uniform buffer packing rules.
+     * @see @ref Flat::setTransformationProjectionMatrix()
+     */
+    Matrix3x4 transformationProjectionMatrix;
+};
+
+/**
+@brief 3D transformation and projection uniform common for all shaders
+@m_since_latest
+
+Contents of a uniform buffer consumed by shaders with the
+@ref Flat::Flag::UniformBuffers "Flag::UniformBuffers" flag enabled. Follows
+the std140 layout rules, one instance per draw. See
+@ref shaders-generic-uniforms for more information.
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TransformationProjectionUniform3D {
+    /** @brief Constructor */
+    constexpr explicit TransformationProjectionUniform3D() noexcept: transformationProjectionMatrix{Math::IdentityInit} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TransformationProjectionUniform3D(NoInitT) noexcept: transformationProjectionMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref transformationProjectionMatrix field
+     * @return Reference to self (for method chaining)
+     */
+    TransformationProjectionUniform3D& setTransformationProjectionMatrix(const Matrix4& matrix) {
+        transformationProjectionMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Transformation and projection matrix
+     *
+     * Default value is an identity matrix.
+     * @see @ref Flat::setTransformationProjectionMatrix()
+     */
+    Matrix4 transformationProjectionMatrix;
+};
+
+/**
+@brief 3D projection uniform common for all shaders
+@m_since_latest
+
+Contents of a uniform buffer consumed by @ref Phong with
+@ref Phong::Flag::UniformBuffers enabled. Follows the std140 layout rules,
+usually there's just one instance shared by all draws. See
+@ref shaders-generic-uniforms for more information.
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct ProjectionUniform3D {
+    /** @brief Constructor */
+    constexpr explicit ProjectionUniform3D() noexcept: projectionMatrix{Math::IdentityInit} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit ProjectionUniform3D(NoInitT) noexcept: projectionMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref projectionMatrix field
+     * @return Reference to self (for method chaining)
+     */
+    ProjectionUniform3D& setProjectionMatrix(const Matrix4& matrix) {
+        projectionMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Projection matrix
+     *
+     * Default value is an identity matrix.
+     * @see @ref Phong::setProjectionMatrix()
+     */
+    Matrix4 projectionMatrix;
+};
+
+/**
+@brief 3D transformation uniform common for all shaders
+@m_since_latest
+
+Contents of a uniform buffer consumed by @ref Phong with
+@ref Phong::Flag::UniformBuffers enabled. Follows the std140 layout rules,
+one instance per draw. See @ref shaders-generic-uniforms for more information.
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TransformationUniform3D {
+    /** @brief Constructor */
+    constexpr explicit TransformationUniform3D() noexcept: transformationMatrix{Math::IdentityInit} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TransformationUniform3D(NoInitT) noexcept: transformationMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref transformationMatrix field
+     * @return Reference to self (for method chaining)
+     */
+    TransformationUniform3D& setTransformationMatrix(const Matrix4& matrix) {
+        transformationMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Transformation matrix
+     *
+     * Default value is an identity matrix.
+     * @see @ref Phong::setTransformationMatrix()
+     */
+    Matrix4 transformationMatrix;
+};
+
+/**
+@brief Texture transformation uniform common for all shaders
+@m_since_latest
+
+Contents of a uniform buffer consumed by shaders with both
+@ref Flat::Flag::UniformBuffers "Flag::UniformBuffers" and
+@ref Flat::Flag::TextureTransformation "Flag::TextureTransformation" enabled.
+Follows the std140 layout rules, one instance per draw. See
+@ref shaders-generic-uniforms for more information.
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TextureTransformationUniform {
+    /** @brief Constructor */
+    constexpr explicit TextureTransformationUniform() noexcept: rotationScaling{1.0f, 0.0f, 0.0f, 1.0f}, offset{0.0f, 0.0f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TextureTransformationUniform(NoInitT) noexcept: rotationScaling{NoInit}, offset{NoInit} {}
+
+    /**
+     * @brief Set the @ref rotationScaling and @ref offset fields
+     * @return Reference to self (for method chaining)
+     *
+     * The top left 2x2 part of the matrix is put into @ref rotationScaling
+     * column-wise, the top two components of the last column into
+     * @ref offset. The bottom row is ignored.
+     */
+    TextureTransformationUniform& setTextureMatrix(const Matrix3& matrix) {
+        rotationScaling = {matrix[0][0], matrix[0][1], matrix[1][0], matrix[1][1]};
+        offset = matrix.translation();
+        return *this;
+    }
+
+    /**
+     * @brief Texture rotation and scaling
+     *
+     * The top left 2x2 part of a texture transformation matrix, stored
+     * column-wise. Default value is an identity.
+     * @see @ref Flat::setTextureMatrix()
+     */
+    Vector4 rotationScaling;
+
+    /**
+     * @brief Texture offset
+     *
+     * Translation part of a texture transformation matrix. Default value is
+     * a zero vector.
+     * @see @ref Flat::setTextureMatrix()
+     */
+    Vector2 offset;
+
+    /* Explicit padding to the std140 array stride */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    Int:32;
+    #endif
+};
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 struct BaseGeneric {
     enum: UnsignedInt {
@@ -231,40 +231,50 @@ MeshVisualizer2D::MeshVisualizer2D(const Flags flags): Implementation::MeshVisua
     static_cast<void>(version);
     #endif
 
+    /* If the program binary is in the cache, compilation and linking can be
+       skipped */
+    bool loaded;
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, *geom, frag}));
+    if(geom) loaded = loadBinary({vert, *geom, frag});
     else
     #endif
-        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
-
-    attachShaders({vert, frag});
-    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) attachShader(*geom);
-    #endif
+        loaded = loadBinary({vert, frag});
+    if(!loaded) {
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, *geom, frag}));
+        else
+        #endif
+            CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
 
-    /* ES3 has this done in the shader directly */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
-    #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-        #ifndef MAGNUM_TARGET_GLES2
-        if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+        attachShaders({vert, frag});
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) attachShader(*geom);
         #endif
+
+        /* ES3 has this done in the shader directly */
         #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
         #ifndef MAGNUM_TARGET_GLES
-        if(!GL::Context::current().isVersionSupported(GL::Version::GL310))
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
         #endif
         {
-            bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            bindAttributeLocation(Position::Location, "position");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::InstancedObjectId)
+                bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            #endif
+            #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+            #ifndef MAGNUM_TARGET_GLES
+            if(!GL::Context::current().isVersionSupported(GL::Version::GL310))
+            #endif
+            {
+                bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            }
+            #endif
         }
         #endif
-    }
-    #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    }
 
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
@@ -425,51 +435,61 @@ MeshVisualizer3D::MeshVisualizer3D(const Flags flags): Implementation::MeshVisua
     static_cast<void>(version);
     #endif
 
+    /* If the program binary is in the cache, compilation and linking can be
+       skipped */
+    bool loaded;
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, *geom, frag}));
+    if(geom) loaded = loadBinary({vert, *geom, frag});
     else
     #endif
-        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
-
-    attachShaders({vert, frag});
-    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) attachShader(*geom);
-    #endif
-
-    /* ES3 has this done in the shader directly */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
-    #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-        #ifndef MAGNUM_TARGET_GLES2
-        if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+        loaded = loadBinary({vert, frag});
+    if(!loaded) {
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, *geom, frag}));
+        else
         #endif
+            CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-        if(flags & Flag::TangentDirection ||
-           flags & Flag::BitangentFromTangentDirection)
-            bindAttributeLocation(Tangent4::Location, "tangent");
-        if(flags & Flag::BitangentDirection)
-            bindAttributeLocation(Bitangent::Location, "bitangent");
-        if(flags & Flag::NormalDirection ||
-           flags & Flag::BitangentFromTangentDirection)
-            bindAttributeLocation(Normal::Location, "normal");
+        if(geom) attachShader(*geom);
         #endif
 
+        /* ES3 has this done in the shader directly */
         #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
         #ifndef MAGNUM_TARGET_GLES
-        if(!GL::Context::current().isVersionSupported(GL::Version::GL310))
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
         #endif
         {
-            bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            bindAttributeLocation(Position::Location, "position");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::InstancedObjectId)
+                bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            #endif
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            if(flags & Flag::TangentDirection ||
+               flags & Flag::BitangentFromTangentDirection)
+                bindAttributeLocation(Tangent4::Location, "tangent");
+            if(flags & Flag::BitangentDirection)
+                bindAttributeLocation(Bitangent::Location, "bitangent");
+            if(flags & Flag::NormalDirection ||
+               flags & Flag::BitangentFromTangentDirection)
+                bindAttributeLocation(Normal::Location, "normal");
+            #endif
+
+            #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+            #ifndef MAGNUM_TARGET_GLES
+            if(!GL::Context::current().isVersionSupported(GL::Version::GL310))
+            #endif
+            {
+                bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            }
+            #endif
         }
         #endif
-    }
-    #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    }
 
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
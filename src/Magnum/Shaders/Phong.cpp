@@ -34,6 +34,7 @@
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Shader.h"
@@ -53,11 +54,43 @@ namespace {
         SpecularTextureUnit = 2,
         NormalTextureUnit = 3
     };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    enum: Int {
+        ProjectionBufferBinding = 0,
+        TransformationBufferBinding = 1,
+        DrawBufferBinding = 2,
+        TextureTransformationBufferBinding = 3,
+        MaterialBufferBinding = 4,
+        LightBufferBinding = 5
+    };
+    #endif
 }
 
-Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _lightCount{lightCount}, _lightColorsUniform{_lightPositionsUniform + Int(lightCount)}, _lightSpecularColorsUniform{_lightPositionsUniform + 2*Int(lightCount)}, _lightRangesUniform{_lightPositionsUniform + 3*Int(lightCount)} {
+Phong::CompileState Phong::compile(const Flags flags, const UnsignedInt lightCount
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount
+    #endif
+) {
     CORRADE_ASSERT(!(flags & Flag::TextureTransformation) || (flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture|Flag::NormalTexture)),
-        "Shaders::Phong: texture transformation enabled but the shader is not textured", );
+        "Shaders::Phong: texture transformation enabled but the shader is not textured", CompileState{NoCreate});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
+        "Shaders::Phong: material count can't be zero", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
+        "Shaders::Phong: draw count can't be zero", CompileState{NoCreate});
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags >= Flag::UniformBuffers) {
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::uniform_buffer_object);
+        /* The draw ID is an unsigned integer passed between stages */
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::EXT::gpu_shader4);
+    }
+    if(flags >= Flag::MultiDraw)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::shader_draw_parameters);
+    #endif
 
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
@@ -66,6 +99,19 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
     #endif
     Utility::Resource rs("MagnumShaders");
 
+    Phong out{NoInit};
+    out._flags = flags;
+    out._lightCount = lightCount;
+    out._lightColorsUniform = out._lightPositionsUniform + Int(lightCount);
+    out._lightSpecularColorsUniform = out._lightPositionsUniform + 2*Int(lightCount);
+    out._lightRangesUniform = out._lightPositionsUniform + 3*Int(lightCount);
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        out._materialCount = materialCount;
+        out._drawCount = drawCount;
+    }
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
     const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
     #else
@@ -76,8 +122,10 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
     GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
 
     #ifndef MAGNUM_TARGET_GLES
+    /* With uniform buffers the light parameters come from a buffer, so no
+       initializers are needed */
     std::string lightInitializerVertex, lightInitializerFragment;
-    if(lightCount) {
+    if(lightCount && !(flags >= Flag::UniformBuffers)) {
         using namespace Containers::Literals;
 
         /* Initializer for the light color / position / range arrays -- we need
@@ -137,8 +185,20 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
         #endif
         .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
         .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        vert.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n",
+            drawCount));
+        #ifndef MAGNUM_TARGET_GLES
+        vert.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
+        #endif
+    }
+    #endif
     #ifndef MAGNUM_TARGET_GLES
-    if(lightCount) vert.addSource(std::move(lightInitializerVertex));
+    if(!lightInitializerVertex.empty())
+        vert.addSource(std::move(lightInitializerVertex));
     #endif
     vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Phong.vert"));
@@ -159,18 +219,35 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
             "#define LIGHT_SPECULAR_COLORS_LOCATION {}\n"
             "#define LIGHT_RANGES_LOCATION {}\n",
             lightCount,
-            _lightPositionsUniform + lightCount,
-            _lightPositionsUniform + 2*lightCount,
-            _lightPositionsUniform + 3*lightCount));
+            out._lightPositionsUniform + lightCount,
+            out._lightPositionsUniform + 2*lightCount,
+            out._lightPositionsUniform + 3*lightCount));
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        frag.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n"
+            "#define MATERIAL_COUNT {}\n",
+            drawCount,
+            materialCount));
+    }
+    #endif
     #ifndef MAGNUM_TARGET_GLES
-    if(lightCount) frag.addSource(std::move(lightInitializerFragment));
+    if(!lightInitializerFragment.empty())
+        frag.addSource(std::move(lightInitializerFragment));
     #endif
     frag.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Phong.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    /* If the program binary is in the cache, compilation and linking can be
+       skipped */
+    if(out.loadBinary({vert, frag}))
+        return CompileState{std::move(out), GL::Shader{NoCreate}, GL::Shader{NoCreate}, version};
+
+    vert.submitCompile();
+    frag.submitCompile();
 
-    attachShaders({vert, frag});
+    out.attachShaders({vert, frag});
 
     /* ES3 has this done in the shader directly and doesn't even provide
        bindFragmentDataLocation() */
@@ -179,103 +256,163 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
     #endif
     {
-        bindAttributeLocation(Position::Location, "position");
+        out.bindAttributeLocation(Position::Location, "position");
         if(lightCount)
-            bindAttributeLocation(Normal::Location, "normal");
+            out.bindAttributeLocation(Normal::Location, "normal");
         if((flags & Flag::NormalTexture) && lightCount) {
-            bindAttributeLocation(Tangent::Location, "tangent");
+            out.bindAttributeLocation(Tangent::Location, "tangent");
             if(flags & Flag::Bitangent)
-                bindAttributeLocation(Bitangent::Location, "bitangent");
+                out.bindAttributeLocation(Bitangent::Location, "bitangent");
         }
         if(flags & Flag::VertexColor)
-            bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
+            out.bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
         if(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture))
-            bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
         #ifndef MAGNUM_TARGET_GLES2
         if(flags & Flag::ObjectId) {
-            bindFragmentDataLocation(ColorOutput, "color");
-            bindFragmentDataLocation(ObjectIdOutput, "objectId");
+            out.bindFragmentDataLocation(ColorOutput, "color");
+            out.bindFragmentDataLocation(ObjectIdOutput, "objectId");
         }
         if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            out.bindAttributeLocation(ObjectId::Location, "instanceObjectId");
         #endif
         if(flags & Flag::InstancedTransformation)
-            bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+            out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
         if(flags >= Flag::InstancedTextureOffset)
-            bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+            out.bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
     }
     #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    out.submitLink();
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version};
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+Phong::CompileState Phong::compile(const Flags flags, const UnsignedInt lightCount) {
+    return compile(flags, lightCount, 1, 1);
+}
+#endif
+
+Phong::Phong(const Flags flags, const UnsignedInt lightCount): Phong{compile(flags, lightCount)} {}
+
+#ifndef MAGNUM_TARGET_GLES2
+Phong::Phong(const Flags flags, const UnsignedInt lightCount, const UnsignedInt materialCount, const UnsignedInt drawCount): Phong{compile(flags, lightCount, materialCount, drawCount)} {}
+#endif
+
+Phong::Phong(CompileState&& state): Phong{static_cast<Phong&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting so it doesn't crash on uniform queries
+       below. */
+    if(!id()) return;
+    #endif
+
+    /* The shaders weren't compiled if the program was loaded from a binary
+       cache */
+    if(state._vert.id())
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile());
+    CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
 
     #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = state._version;
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationMatrixUniform = uniformLocation("transformationMatrix");
-        if(flags & Flag::TextureTransformation)
-            _textureMatrixUniform = uniformLocation("textureMatrix");
-        _projectionMatrixUniform = uniformLocation("projectionMatrix");
-        _ambientColorUniform = uniformLocation("ambientColor");
-        if(lightCount) {
-            _normalMatrixUniform = uniformLocation("normalMatrix");
-            _diffuseColorUniform = uniformLocation("diffuseColor");
-            _specularColorUniform = uniformLocation("specularColor");
-            _shininessUniform = uniformLocation("shininess");
-            if(flags & Flag::NormalTexture)
-                _normalTextureScaleUniform = uniformLocation("normalTextureScale");
-            _lightPositionsUniform = uniformLocation("lightPositions");
-            _lightColorsUniform = uniformLocation("lightColors");
-            _lightSpecularColorsUniform = uniformLocation("lightSpecularColors");
-            _lightRangesUniform = uniformLocation("lightRanges");
-        }
-        if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
         #ifndef MAGNUM_TARGET_GLES2
-        if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+        if(_flags >= Flag::UniformBuffers) {
+            _drawOffsetUniform = uniformLocation("drawOffset");
+        } else
         #endif
+        {
+            _transformationMatrixUniform = uniformLocation("transformationMatrix");
+            if(_flags & Flag::TextureTransformation)
+                _textureMatrixUniform = uniformLocation("textureMatrix");
+            _projectionMatrixUniform = uniformLocation("projectionMatrix");
+            _ambientColorUniform = uniformLocation("ambientColor");
+            if(_lightCount) {
+                _normalMatrixUniform = uniformLocation("normalMatrix");
+                _diffuseColorUniform = uniformLocation("diffuseColor");
+                _specularColorUniform = uniformLocation("specularColor");
+                _shininessUniform = uniformLocation("shininess");
+                if(_flags & Flag::NormalTexture)
+                    _normalTextureScaleUniform = uniformLocation("normalTextureScale");
+                _lightPositionsUniform = uniformLocation("lightPositions");
+                _lightColorsUniform = uniformLocation("lightColors");
+                _lightSpecularColorsUniform = uniformLocation("lightSpecularColors");
+                _lightRangesUniform = uniformLocation("lightRanges");
+            }
+            if(_flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(_flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+            #endif
+        }
     }
 
     #ifndef MAGNUM_TARGET_GLES
-    if(flags && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
+    if(_flags && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
     #endif
     {
-        if(flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureUnit);
-        if(lightCount) {
-            if(flags & Flag::DiffuseTexture) setUniform(uniformLocation("diffuseTexture"), DiffuseTextureUnit);
-            if(flags & Flag::SpecularTexture) setUniform(uniformLocation("specularTexture"), SpecularTextureUnit);
-            if(flags & Flag::NormalTexture) setUniform(uniformLocation("normalTexture"), NormalTextureUnit);
+        if(_flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureUnit);
+        if(_lightCount) {
+            if(_flags & Flag::DiffuseTexture) setUniform(uniformLocation("diffuseTexture"), DiffuseTextureUnit);
+            if(_flags & Flag::SpecularTexture) setUniform(uniformLocation("specularTexture"), SpecularTextureUnit);
+            if(_flags & Flag::NormalTexture) setUniform(uniformLocation("normalTexture"), NormalTextureUnit);
+        }
+        #ifndef MAGNUM_TARGET_GLES2
+        if(_flags >= Flag::UniformBuffers) {
+            setUniformBlockBinding(uniformBlockIndex("Projection"), ProjectionBufferBinding);
+            setUniformBlockBinding(uniformBlockIndex("Transformation"), TransformationBufferBinding);
+            setUniformBlockBinding(uniformBlockIndex("Draw"), DrawBufferBinding);
+            if(_flags & Flag::TextureTransformation)
+                setUniformBlockBinding(uniformBlockIndex("TextureTransformation"), TextureTransformationBufferBinding);
+            setUniformBlockBinding(uniformBlockIndex("Material"), MaterialBufferBinding);
+            if(_lightCount)
+                setUniformBlockBinding(uniformBlockIndex("Light"), LightBufferBinding);
         }
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
-    /* Default to fully opaque white so we can see the textures */
-    if(flags & Flag::AmbientTexture) setAmbientColor(Magnum::Color4{1.0f});
-    else setAmbientColor(Magnum::Color4{0.0f});
-    setTransformationMatrix(Matrix4{Math::IdentityInit});
-    setProjectionMatrix(Matrix4{Math::IdentityInit});
-    if(lightCount) {
-        setDiffuseColor(Magnum::Color4{1.0f});
-        setSpecularColor(Magnum::Color4{1.0f, 0.0f});
-        setShininess(80.0f);
-        if(flags & Flag::NormalTexture)
-            setNormalTextureScale(1.0f);
-        setLightPositions(Containers::Array<Vector4>{Containers::DirectInit, lightCount, Vector4{0.0f, 0.0f, 1.0f, 0.0f}});
-        Containers::Array<Magnum::Color3> colors{Containers::DirectInit, lightCount, Magnum::Color3{1.0f}};
-        setLightColors(colors);
-        setLightSpecularColors(colors);
-        setLightRanges(Containers::Array<Float>{Containers::DirectInit, lightCount, Constants::inf()});
-        /* Light position is zero by default */
-        setNormalMatrix(Matrix3x3{Math::IdentityInit});
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_flags >= Flag::UniformBuffers) {
+        /* Draw offset is zero by default */
+    } else
+    #endif
+    {
+        /* Default to fully opaque white so we can see the textures */
+        if(_flags & Flag::AmbientTexture) setAmbientColor(Magnum::Color4{1.0f});
+        else setAmbientColor(Magnum::Color4{0.0f});
+        setTransformationMatrix(Matrix4{Math::IdentityInit});
+        setProjectionMatrix(Matrix4{Math::IdentityInit});
+        if(_lightCount) {
+            setDiffuseColor(Magnum::Color4{1.0f});
+            setSpecularColor(Magnum::Color4{1.0f, 0.0f});
+            setShininess(80.0f);
+            if(_flags & Flag::NormalTexture)
+                setNormalTextureScale(1.0f);
+            setLightPositions(Containers::Array<Vector4>{Containers::DirectInit, _lightCount, Vector4{0.0f, 0.0f, 1.0f, 0.0f}});
+            Containers::Array<Magnum::Color3> colors{Containers::DirectInit, _lightCount, Magnum::Color3{1.0f}};
+            setLightColors(colors);
+            setLightSpecularColors(colors);
+            setLightRanges(Containers::Array<Float>{Containers::DirectInit, _lightCount, Constants::inf()});
+            /* Light position is zero by default */
+            setNormalMatrix(Matrix3x3{Math::IdentityInit});
+        }
+        if(_flags & Flag::TextureTransformation)
+            setTextureMatrix(Matrix3{Math::IdentityInit});
+        if(_flags & Flag::AlphaMask) setAlphaMask(0.5f);
+        /* Object ID is zero by default */
     }
-    if(flags & Flag::TextureTransformation)
-        setTextureMatrix(Matrix3{Math::IdentityInit});
-    if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
-    /* Object ID is zero by default */
     #endif
 }
 
 Phong& Phong::setAmbientColor(const Magnum::Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setAmbientColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_ambientColorUniform, color);
     return *this;
 }
@@ -288,6 +425,10 @@ Phong& Phong::bindAmbientTexture(GL::Texture2D& texture) {
 }
 
 Phong& Phong::setDiffuseColor(const Magnum::Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setDiffuseColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_diffuseColorUniform, color);
     return *this;
 }
@@ -300,6 +441,10 @@ Phong& Phong::bindDiffuseTexture(GL::Texture2D& texture) {
 }
 
 Phong& Phong::setSpecularColor(const Magnum::Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setSpecularColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_specularColorUniform, color);
     return *this;
 }
@@ -326,6 +471,10 @@ Phong& Phong::bindTextures(GL::Texture2D* ambient, GL::Texture2D* diffuse, GL::T
 }
 
 Phong& Phong::setShininess(Float shininess) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setShininess(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_shininessUniform, shininess);
     return *this;
 }
@@ -333,6 +482,10 @@ Phong& Phong::setShininess(Float shininess) {
 Phong& Phong::setNormalTextureScale(const Float scale) {
     CORRADE_ASSERT(_flags & Flag::NormalTexture,
         "Shaders::Phong::setNormalTextureScale(): the shader was not created with normal texture enabled", *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setNormalTextureScale(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_normalTextureScaleUniform, scale);
     return *this;
 }
@@ -340,6 +493,10 @@ Phong& Phong::setNormalTextureScale(const Float scale) {
 Phong& Phong::setAlphaMask(Float mask) {
     CORRADE_ASSERT(_flags & Flag::AlphaMask,
         "Shaders::Phong::setAlphaMask(): the shader was not created with alpha mask enabled", *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setAlphaMask(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_alphaMaskUniform, mask);
     return *this;
 }
@@ -348,22 +505,36 @@ Phong& Phong::setAlphaMask(Float mask) {
 Phong& Phong::setObjectId(UnsignedInt id) {
     CORRADE_ASSERT(_flags & Flag::ObjectId,
         "Shaders::Phong::setObjectId(): the shader was not created with object ID enabled", *this);
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setObjectId(): the shader was created with uniform buffers enabled", *this);
     setUniform(_objectIdUniform, id);
     return *this;
 }
 #endif
 
 Phong& Phong::setTransformationMatrix(const Matrix4& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setTransformationMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_transformationMatrixUniform, matrix);
     return *this;
 }
 
 Phong& Phong::setNormalMatrix(const Matrix3x3& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setNormalMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_normalMatrixUniform, matrix);
     return *this;
 }
 
 Phong& Phong::setProjectionMatrix(const Matrix4& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setProjectionMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_projectionMatrixUniform, matrix);
     return *this;
 }
@@ -371,6 +542,10 @@ Phong& Phong::setProjectionMatrix(const Matrix4& matrix) {
 Phong& Phong::setTextureMatrix(const Matrix3& matrix) {
     CORRADE_ASSERT(_flags & Flag::TextureTransformation,
         "Shaders::Phong::setTextureMatrix(): the shader was not created with texture transformation enabled", *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setTextureMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_textureMatrixUniform, matrix);
     return *this;
 }
@@ -378,6 +553,10 @@ Phong& Phong::setTextureMatrix(const Matrix3& matrix) {
 Phong& Phong::setLightPositions(const Containers::ArrayView<const Vector4> positions) {
     CORRADE_ASSERT(_lightCount == positions.size(),
         "Shaders::Phong::setLightPositions(): expected" << _lightCount << "items but got" << positions.size(), *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightPositions(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_lightPositionsUniform, positions);
     return *this;
 }
@@ -407,6 +586,10 @@ Phong& Phong::setLightPositions(const std::initializer_list<Vector3> positions)
 Phong& Phong::setLightPosition(const UnsignedInt id, const Vector4& position) {
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightPosition(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightPosition(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_lightPositionsUniform + id, position);
     return *this;
 }
@@ -425,6 +608,10 @@ Phong& Phong::setLightPosition(const Vector3& position) {
 Phong& Phong::setLightColors(const Containers::ArrayView<const Magnum::Color3> colors) {
     CORRADE_ASSERT(_lightCount == colors.size(),
         "Shaders::Phong::setLightColors(): expected" << _lightCount << "items but got" << colors.size(), *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightColors(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_lightColorsUniform, colors);
     return *this;
 }
@@ -452,6 +639,10 @@ Phong& Phong::setLightColors(const std::initializer_list<Magnum::Color3> colors)
 Phong& Phong::setLightColor(const UnsignedInt id, const Magnum::Color3& color) {
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightColor(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_lightColorsUniform + id, color);
     return *this;
 }
@@ -470,6 +661,10 @@ Phong& Phong::setLightColor(const Magnum::Color4& color) {
 Phong& Phong::setLightSpecularColors(const Containers::ArrayView<const Magnum::Color3> colors) {
     CORRADE_ASSERT(_lightCount == colors.size(),
         "Shaders::Phong::setLightSpecularColors(): expected" << _lightCount << "items but got" << colors.size(), *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightSpecularColors(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_lightSpecularColorsUniform, colors);
     return *this;
 }
@@ -481,6 +676,10 @@ Phong& Phong::setLightSpecularColors(const std::initializer_list<Magnum::Color3>
 Phong& Phong::setLightSpecularColor(const UnsignedInt id, const Magnum::Color3& color) {
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightSpecularColor(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightSpecularColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_lightSpecularColorsUniform + id, color);
     return *this;
 }
@@ -488,6 +687,10 @@ Phong& Phong::setLightSpecularColor(const UnsignedInt id, const Magnum::Color3&
 Phong& Phong::setLightRanges(const Containers::ArrayView<const Float> ranges) {
     CORRADE_ASSERT(_lightCount == ranges.size(),
         "Shaders::Phong::setLightRanges(): expected" << _lightCount << "items but got" << ranges.size(), *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightRanges(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_lightRangesUniform, ranges);
     return *this;
 }
@@ -499,10 +702,113 @@ Phong& Phong::setLightRanges(const std::initializer_list<Float> ranges) {
 Phong& Phong::setLightRange(const UnsignedInt id, const Float range) {
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightRange(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightRange(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_lightRangesUniform + id, range);
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+Phong& Phong::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::setDrawOffset(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(offset < _drawCount,
+        "Shaders::Phong::setDrawOffset(): draw offset" << offset << "is out of bounds for" << _drawCount << "draws", *this);
+    setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+Phong& Phong::bindProjectionBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, ProjectionBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindProjectionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, ProjectionBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindTransformationBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindDrawBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindDrawBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindTextureTransformationBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindTextureTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindMaterialBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindMaterialBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindLightBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindLightBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
 Debug& operator<<(Debug& debug, const Phong::Flag value) {
     debug << "Shaders::Phong::Flag" << Debug::nospace;
 
@@ -523,11 +829,17 @@ Debug& operator<<(Debug& debug, const Phong::Flag value) {
         #endif
         _c(InstancedTransformation)
         _c(InstancedTextureOffset)
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(UniformBuffers)
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        _c(MultiDraw)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
 
-    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedShort(value)) << Debug::nospace << ")";
 }
 
 Debug& operator<<(Debug& debug, const Phong::Flags value) {
@@ -545,7 +857,14 @@ Debug& operator<<(Debug& debug, const Phong::Flags value) {
         Phong::Flag::InstancedObjectId, /* Superset of ObjectId */
         Phong::Flag::ObjectId,
         #endif
-        Phong::Flag::InstancedTransformation});
+        Phong::Flag::InstancedTransformation,
+        #ifndef MAGNUM_TARGET_GLES
+        Phong::Flag::MultiDraw, /* Superset of UniformBuffers */
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        Phong::Flag::UniformBuffers
+        #endif
+        });
 }
 
 }}
@@ -23,10 +23,14 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#if defined(OBJECT_ID) && !defined(GL_ES) && !defined(NEW_GLSL)
+#if (defined(OBJECT_ID) || defined(UNIFORM_BUFFERS)) && !defined(GL_ES) && !defined(NEW_GLSL)
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
 #ifndef NEW_GLSL
 #define in varying
 #define fragmentColor gl_FragColor
@@ -44,6 +48,7 @@ layout(binding = 0)
 uniform lowp sampler2D ambientTexture;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 4)
 #endif
@@ -56,6 +61,7 @@ uniform lowp vec4 ambientColor
     #endif
     #endif
     ;
+#endif
 
 #if LIGHT_COUNT
 #ifdef DIFFUSE_TEXTURE
@@ -65,6 +71,7 @@ layout(binding = 1)
 uniform lowp sampler2D diffuseTexture;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 5)
 #endif
@@ -73,6 +80,7 @@ uniform lowp vec4 diffuseColor
     = vec4(1.0)
     #endif
     ;
+#endif
 
 #ifdef SPECULAR_TEXTURE
 #ifdef EXPLICIT_TEXTURE_LAYER
@@ -88,6 +96,7 @@ layout(binding = 3)
 uniform lowp sampler2D normalTexture;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 6)
 #endif
@@ -106,7 +115,9 @@ uniform mediump float shininess
     #endif
     ;
 #endif
+#endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef NORMAL_TEXTURE
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 8)
@@ -170,6 +181,68 @@ uniform lowp float lightRanges[LIGHT_COUNT]
     ;
 #endif
 
+/* Uniform buffers */
+
+#else
+/* Keep in sync with Phong.vert and PhongDrawUniform in Phong.h. The mat3 is
+   padded to three vec4s by the std140 rules. */
+struct DrawUniform {
+    mediump mat3 normalMatrix;
+    highp uint materialId;
+    highp uint objectId;
+    highp uint lightOffset;
+    highp uint lightCount;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+/* Keep in sync with PhongMaterialUniform in Phong.h. The struct is padded to
+   64 bytes by the std140 array stride rules. */
+struct MaterialUniform {
+    lowp vec4 ambientColor;
+    lowp vec4 diffuseColor;
+    lowp vec4 specularColor;
+    mediump float normalTextureScale;
+    mediump float shininess;
+    lowp float alphaMask;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 4
+    #endif
+) uniform Material {
+    MaterialUniform materials[MATERIAL_COUNT];
+};
+
+#if LIGHT_COUNT
+/* Keep in sync with PhongLightUniform in Phong.h. The vec3s are aligned to
+   16 bytes by the std140 rules, so the struct is 48 bytes in total. */
+struct LightUniform {
+    highp vec4 position;
+    lowp vec3 color;
+    lowp vec3 specularColor;
+    highp float range;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 5
+    #endif
+) uniform Light {
+    LightUniform lights[LIGHT_COUNT];
+};
+#endif
+
+flat in highp uint drawId;
+#endif
+
 #if LIGHT_COUNT
 in mediump vec3 transformedNormal;
 #ifdef NORMAL_TEXTURE
@@ -180,7 +253,9 @@ in mediump vec3 transformedTangent;
 in mediump vec3 transformedBitangent;
 #endif
 #endif
+#ifndef UNIFORM_BUFFERS
 in highp vec4 lightDirections[LIGHT_COUNT];
+#endif
 in highp vec3 cameraDirection;
 #endif
 
@@ -211,6 +286,31 @@ out highp uint fragmentObjectId;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef OBJECT_ID
+    highp uint objectId = draws[drawId].objectId;
+    #endif
+    highp uint materialId = draws[drawId].materialId;
+    lowp vec4 ambientColor = materials[materialId].ambientColor;
+    #if LIGHT_COUNT
+    lowp vec4 diffuseColor = materials[materialId].diffuseColor;
+    lowp vec4 specularColor = materials[materialId].specularColor;
+    mediump float shininess = materials[materialId].shininess;
+    /* Clamp the offset first so the subtraction below can't underflow, an
+       offset past the end means no lights are used */
+    highp uint lightOffset = min(draws[drawId].lightOffset, uint(LIGHT_COUNT));
+    /* Clamp to the statically defined buffer size so the default of
+       0xffffffffu means all lights after the offset */
+    highp uint lightCount = min(draws[drawId].lightCount, uint(LIGHT_COUNT) - lightOffset);
+    #endif
+    #ifdef NORMAL_TEXTURE
+    mediump float normalTextureScale = materials[materialId].normalTextureScale;
+    #endif
+    #ifdef ALPHA_MASK
+    lowp float alphaMask = materials[materialId].alphaMask;
+    #endif
+    #endif
+
     lowp const vec4 finalAmbientColor =
         #ifdef AMBIENT_TEXTURE
         texture(ambientTexture, interpolatedTextureCoordinates)*
@@ -262,27 +362,44 @@ void main() {
     #endif
 
     /* Add diffuse color for each light */
+    #ifndef UNIFORM_BUFFERS
     for(int i = 0; i < LIGHT_COUNT; ++i) {
+        highp vec4 lightDirection = lightDirections[i];
+        lowp vec3 lightColor = lightColors[i];
+        lowp vec3 lightSpecularColor = lightSpecularColors[i];
+        lowp float lightRange = lightRanges[i];
+        mediump float lightCountFloat = float(LIGHT_COUNT);
+    #else
+    for(highp uint i = 0u; i < lightCount; ++i) {
+        /* Camera direction is the negative transformed position, see the
+           vertex shader for why the light direction is calculated here */
+        highp vec4 lightPosition = lights[lightOffset + i].position;
+        highp vec4 lightDirection = vec4(lightPosition.xyz + cameraDirection*lightPosition.w, lightPosition.w);
+        lowp vec3 lightColor = lights[lightOffset + i].color;
+        lowp vec3 lightSpecularColor = lights[lightOffset + i].specularColor;
+        highp float lightRange = lights[lightOffset + i].range;
+        mediump float lightCountFloat = float(lightCount);
+    #endif
         /* Attenuation. Directional lights have the .w component set to 0, use
            that to make the distance zero -- which will then ensure the
            attenuation is always 1.0 */
-        highp float dist = length(lightDirections[i].xyz)*lightDirections[i].w;
+        highp float dist = length(lightDirection.xyz)*lightDirection.w;
         /* If range is 0 for whatever reason, clamp it to a small value to
            avoid a NaN when dist is 0 as well (which is the case for
            directional lights). */
-        highp float attenuation = clamp(1.0 - pow(dist/max(lightRanges[i], 0.0001), 4.0), 0.0, 1.0);
+        highp float attenuation = clamp(1.0 - pow(dist/max(lightRange, 0.0001), 4.0), 0.0, 1.0);
         attenuation = attenuation*attenuation/(1.0 + dist*dist);
 
-        highp vec3 normalizedLightDirection = normalize(lightDirections[i].xyz);
+        highp vec3 normalizedLightDirection = normalize(lightDirection.xyz);
         lowp float intensity = max(0.0, dot(normalizedTransformedNormal, normalizedLightDirection))*attenuation;
-        fragmentColor += vec4(finalDiffuseColor.rgb*lightColors[i]*intensity, finalDiffuseColor.a/float(LIGHT_COUNT));
+        fragmentColor += vec4(finalDiffuseColor.rgb*lightColor*intensity, finalDiffuseColor.a/lightCountFloat);
 
         /* Add specular color, if needed */
         if(intensity > 0.001) {
             highp vec3 reflection = reflect(-normalizedLightDirection, normalizedTransformedNormal);
             /* Use attenuation for the specularity as well */
             mediump float specularity = clamp(pow(max(0.0, dot(normalize(cameraDirection), reflection)), shininess), 0.0, 1.0)*attenuation;
-            fragmentColor += vec4(finalSpecularColor.rgb*lightSpecularColors[i].rgb*specularity, finalSpecularColor.a);
+            fragmentColor += vec4(finalSpecularColor.rgb*lightSpecularColor.rgb*specularity, finalSpecularColor.a);
         }
     }
     #endif
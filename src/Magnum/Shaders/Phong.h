@@ -26,10 +26,13 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Shaders::Phong
+ * @brief Class @ref Magnum::Shaders::Phong, struct @ref Magnum::Shaders::PhongDrawUniform, @ref Magnum::Shaders::PhongMaterialUniform, @ref Magnum::Shaders::PhongLightUniform
  */
 
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Constants.h"
 #include "Magnum/Shaders/Generic.h"
 #include "Magnum/Shaders/visibility.h"
 
@@ -246,6 +249,44 @@ well to ensure lighting works:
 @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
     1.0.
 
+@section Shaders-Phong-ubo Uniform buffers
+
+Similarly to @ref Shaders-Flat-ubo "the Flat shader", enabling
+@ref Flag::UniformBuffers switches the shader to take per-draw state from
+uniform buffers instead of individual uniforms. Projection is supplied in a
+@ref ProjectionUniform3D buffer bound with @ref bindProjectionBuffer(),
+per-draw transformation in a @ref TransformationUniform3D buffer bound with
+@ref bindTransformationBuffer(), normal matrix, material index, object ID and
+a light range in a @ref PhongDrawUniform buffer bound with
+@ref bindDrawBuffer(), materials in a @ref PhongMaterialUniform buffer bound
+with @ref bindMaterialBuffer() and lights in a @ref PhongLightUniform buffer
+bound with @ref bindLightBuffer(). If @ref Flag::TextureTransformation is
+enabled, texture transformation is taken from a
+@ref TextureTransformationUniform buffer bound with
+@ref bindTextureTransformationBuffer(). The light, material and draw counts,
+which define the uniform array sizes, are passed to the
+@ref Phong(Flags, UnsignedInt, UnsignedInt, UnsignedInt) constructor and a
+draw is then picked with @ref setDrawOffset():
+
+@snippet MagnumShaders.cpp Phong-usage-ubo
+
+Unlike with classic uniforms, where the light count is fixed for the whole
+shader, each draw can use a different subset of the light buffer through
+@ref PhongDrawUniform::lightOffset and @ref PhongDrawUniform::lightCount. To
+keep the count of vertex shader outputs independent of the light buffer size,
+light directions are calculated in the fragment shader in this case.
+
+With @ref Flag::MultiDraw enabled as well, the draw offset is further summed
+with the @glsl gl_DrawID @ce builtin, allowing many different objects to be
+rendered in a single
+@ref draw(Containers::ArrayView<const Containers::Reference<MeshView>>) or
+@ref drawIndirect() call. See the @ref Shaders-Flat-ubo "Flat shader"
+documentation for an example.
+
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+
 @see @ref shaders
 */
 class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
@@ -553,7 +594,46 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
              *      in WebGL 1.0.
              * @m_since{2020,06}
              */
-            InstancedTextureOffset = (1 << 10)|TextureTransformation
+            InstancedTextureOffset = (1 << 10)|TextureTransformation,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Use uniform buffers. Expects that uniform data are supplied via
+             * @ref bindProjectionBuffer(), @ref bindTransformationBuffer(),
+             * @ref bindDrawBuffer(), @ref bindTextureTransformationBuffer(),
+             * @ref bindMaterialBuffer() and @ref bindLightBuffer() instead of
+             * direct uniform setters. See @ref Shaders-Phong-ubo for more
+             * information.
+             * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            UniformBuffers = 1 << 12,
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Enable multidraw functionality. Implies
+             * @ref Flag::UniformBuffers and adds the value from
+             * @ref setDrawOffset() with the @glsl gl_DrawID @ce builtin,
+             * which makes draws submitted via
+             * @ref GL::AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+             * or @ref GL::AbstractShaderProgram::drawIndirect() pick up
+             * per-draw parameters directly, without having to rebind the
+             * uniform buffers or specify @ref setDrawOffset() before each
+             * draw. See @ref Shaders-Phong-ubo for more information.
+             * @requires_gl46 Extension @gl_extension{ARB,uniform_buffer_object}
+             *      and @gl_extension{ARB,shader_draw_parameters}
+             * @requires_gl Multidraw with @glsl gl_DrawID @ce is not available
+             *      in OpenGL ES or WebGL.
+             * @m_since_latest
+             */
+            MultiDraw = UniformBuffers|(1 << 13)
+            #endif
         };
 
         /**
@@ -563,6 +643,36 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          */
         typedef Containers::EnumSet<Flag> Flags;
 
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref Phong(Flags, UnsignedInt) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref Phong(CompileState&&)
+         */
+        static CompileState compile(Flags flags = {}, UnsignedInt lightCount = 1);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Compile a uniform buffer variant asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref Phong(Flags, UnsignedInt, UnsignedInt, UnsignedInt)
+         * can perform an asynchronous compilation and linking. See
+         * @ref shaders-async for more information.
+         * @see @ref Phong(CompileState&&)
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt lightCount, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
         /**
          * @brief Constructor
          * @param flags         Flags
@@ -570,6 +680,53 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          */
         explicit Phong(Flags flags = {}, UnsignedInt lightCount = 1);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Construct for rendering with uniform buffers
+         * @param flags         Flags
+         * @param lightCount    Size of a @ref PhongLightUniform buffer bound
+         *      with @ref bindLightBuffer()
+         * @param materialCount Size of a @ref PhongMaterialUniform buffer
+         *      bound with @ref bindMaterialBuffer()
+         * @param drawCount     Size of a @ref TransformationUniform3D /
+         *      @ref PhongDrawUniform / @ref TextureTransformationUniform
+         *      buffer bound with @ref bindTransformationBuffer(),
+         *      @ref bindDrawBuffer() and
+         *      @ref bindTextureTransformationBuffer()
+         * @m_since_latest
+         *
+         * If @p flags contain @ref Flag::UniformBuffers, expects that both
+         * @p materialCount and @p drawCount are larger than zero. The counts
+         * define the uniform array sizes, so they're limited by the maximum
+         * uniform block size supported by the implementation. Unlike with
+         * classic uniforms, the @p lightCount is only an upper bound ---
+         * @ref PhongDrawUniform::lightOffset and
+         * @ref PhongDrawUniform::lightCount then pick a range of lights used
+         * for a particular draw. If @p flags don't contain
+         * @ref Flag::UniformBuffers, @p materialCount and @p drawCount are
+         * ignored and the constructor behaves the same as
+         * @ref Phong(Flags, UnsignedInt). If @p flags contain
+         * @ref Flag::MultiDraw, expects that
+         * @gl_extension{ARB,shader_draw_parameters} is supported. See
+         * @ref Shaders-Phong-ubo for more information.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        explicit Phong(Flags flags, UnsignedInt lightCount, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit Phong(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -599,9 +756,43 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
         /** @brief Flags */
         Flags flags() const { return _flags; }
 
-        /** @brief Light count */
+        /**
+         * @brief Light count
+         *
+         * If @ref Flag::UniformBuffers is set, this is the statically defined
+         * size of the @ref PhongLightUniform uniform buffer.
+         */
         UnsignedInt lightCount() const { return _lightCount; }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Material count
+         * @m_since_latest
+         *
+         * Statically defined size of the @ref PhongMaterialUniform uniform
+         * buffer. Has use only if @ref Flag::UniformBuffers is set, otherwise
+         * @cpp 0 @ce.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Draw count
+         * @m_since_latest
+         *
+         * Statically defined size of each of the
+         * @ref TransformationUniform3D, @ref PhongDrawUniform and
+         * @ref TextureTransformationUniform uniform buffers. Has use only if
+         * @ref Flag::UniformBuffers is set, otherwise @cpp 0 @ce.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+        #endif
+
         /**
          * @brief Set ambient color
          * @return Reference to self (for method chaining)
@@ -609,6 +800,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * If @ref Flag::AmbientTexture is set, default value is
          * @cpp 0xffffffff_rgbaf @ce and the color will be multiplied with
          * ambient texture, otherwise default value is @cpp 0x00000000_rgbaf @ce.
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * PhongMaterialUniform::ambientColor and call @ref bindMaterialBuffer()
+         * instead.
          * @see @ref bindAmbientTexture(), @ref Shaders-Phong-lights-ambient
          */
         Phong& setAmbientColor(const Magnum::Color4& color);
@@ -631,6 +826,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * Initial value is @cpp 0xffffffff_rgbaf @ce. If @ref lightCount() is
          * zero, this function is a no-op, as diffuse color doesn't contribute
          * to the output in that case.
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * PhongMaterialUniform::diffuseColor and call @ref bindMaterialBuffer()
+         * instead.
          * @see @ref bindDiffuseTexture()
          */
         Phong& setDiffuseColor(const Magnum::Color4& color);
@@ -659,6 +858,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * Expects that the shader was created with @ref Flag::NormalTexture
          * enabled. If @ref lightCount() is zero, this function is a no-op, as
          * normals don't contribute to the output in that case.
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * PhongMaterialUniform::normalTextureScale and call @ref
+         * bindMaterialBuffer() instead.
          * @see @ref Shaders-Phong-normal-mapping, @ref bindNormalTexture(),
          *      @ref Trade::MaterialAttribute::NormalTextureScale
          */
@@ -688,6 +891,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * @cpp 0x00000000_rgbaf @ce. If @ref lightCount() is zero, this
          * function is a no-op, as specular color doesn't contribute to the
          * output in that case.
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * PhongMaterialUniform::specularColor and call @ref
+         * bindMaterialBuffer() instead.
          * @see @ref bindSpecularTexture()
          */
         Phong& setSpecularColor(const Magnum::Color4& color);
@@ -730,6 +937,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * Initial value is @cpp 80.0f @ce. If @ref lightCount() is zero, this
          * function is a no-op, as specular color doesn't contribute to the
          * output in that case.
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * PhongMaterialUniform::shininess and call @ref bindMaterialBuffer()
+         * instead.
          */
         Phong& setShininess(Float shininess);
 
@@ -741,6 +952,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * enabled. Fragments with alpha values smaller than the mask value
          * will be discarded. Initial value is @cpp 0.5f @ce. See the flag
          * documentation for further information.
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * PhongMaterialUniform::alphaMask and call @ref bindMaterialBuffer()
+         * instead.
          */
         Phong& setAlphaMask(Float mask);
 
@@ -753,6 +968,9 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * enabled. Value set here is written to the @ref ObjectIdOutput, see
          * @ref Shaders-Phong-object-id for more information. Default is
          * @cpp 0 @ce.
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * PhongDrawUniform::objectId and call @ref bindDrawBuffer() instead.
          * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
          * @requires_gles30 Object ID output requires integer support in
          *      shaders, which is not available in OpenGL ES 2.0 or WebGL 1.0.
@@ -766,6 +984,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          *
          * You need to set also @ref setNormalMatrix() with a corresponding
          * value. Initial value is an identity matrix.
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * TransformationUniform3D::transformationMatrix and call @ref
+         * bindTransformationBuffer() instead.
          */
         Phong& setTransformationMatrix(const Matrix4& matrix);
 
@@ -779,6 +1001,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * value is an identity matrix. If @ref lightCount() is zero, this
          * function is a no-op, as normals don't contribute to the output in
          * that case.
+         *
+         * If @ref Flag::UniformBuffers is set, use @ref
+         * PhongDrawUniform::setNormalMatrix() and call @ref bindDrawBuffer()
+         * instead.
          * @see @ref Math::Matrix4::normalMatrix()
          */
         Phong& setNormalMatrix(const Matrix3x3& matrix);
@@ -790,6 +1016,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * Initial value is an identity matrix (i.e., an orthographic
          * projection of the default @f$ [ -\boldsymbol{1} ; \boldsymbol{1} ] @f$
          * cube).
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * ProjectionUniform3D::projectionMatrix and call @ref
+         * bindProjectionBuffer() instead.
          */
         Phong& setProjectionMatrix(const Matrix4& matrix);
 
@@ -801,6 +1031,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * Expects that the shader was created with
          * @ref Flag::TextureTransformation enabled. Initial value is an
          * identity matrix.
+         *
+         * If @ref Flag::UniformBuffers is set, use @ref
+         * TextureTransformationUniform::setTextureMatrix() and call @ref
+         * bindTextureTransformationBuffer() instead.
          */
         Phong& setTextureMatrix(const Matrix3& matrix);
 
@@ -816,6 +1050,9 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * @p positions array is the same as @ref lightCount(). Initial values
          * are @cpp {0.0f, 0.0f, 1.0f, 0.0f} @ce --- a directional "fill" light
          * coming from the camera.
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * PhongLightUniform::position and call @ref bindLightBuffer() instead.
          * @see @ref Shaders-Phong-lights, @ref setLightPosition()
          */
         Phong& setLightPositions(Containers::ArrayView<const Vector4> positions);
@@ -886,6 +1123,9 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          *
          * Initial values are @cpp 0xffffff_rgbf @ce. Expects that the size
          * of the @p colors array is the same as @ref lightCount().
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * PhongLightUniform::color and call @ref bindLightBuffer() instead.
          * @see @ref Shaders-Phong-lights, @ref setLightColor()
          */
         Phong& setLightColors(Containers::ArrayView<const Magnum::Color3> colors);
@@ -952,6 +1192,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * highlights on certain lights. Initial values are
          * @cpp 0xffffff_rgbf @ce. Expects that the size of the @p colors array
          * is the same as @ref lightCount().
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * PhongLightUniform::specularColor and call @ref bindLightBuffer()
+         * instead.
          * @see @ref Shaders-Phong-lights, @ref setLightColor()
          */
         Phong& setLightSpecularColors(Containers::ArrayView<const Magnum::Color3> colors);
@@ -981,6 +1225,9 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          *
          * Initial values are @ref Constants::inf(). Expects that the size of
          * the @p ranges array is the same as @ref lightCount().
+         *
+         * If @ref Flag::UniformBuffers is set, fill @ref
+         * PhongLightUniform::range and call @ref bindLightBuffer() instead.
          * @see @ref Shaders-Phong-lights, @ref setLightRange()
          */
         Phong& setLightRanges(Containers::ArrayView<const Float> ranges);
@@ -1003,7 +1250,158 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          */
         Phong& setLightRange(UnsignedInt id, Float range);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set a draw offset
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Specifies which item in the uniform buffers bound with
+         * @ref bindTransformationBuffer(), @ref bindDrawBuffer() and
+         * @ref bindTextureTransformationBuffer() should be used for current
+         * draw. Expects that @ref Flag::UniformBuffers is set and @p offset
+         * is less than @ref drawCount(). Initial value is @cpp 0 @ce. If
+         * @ref Flag::MultiDraw is set, @glsl gl_DrawID @ce is added to this
+         * value, which makes each draw submitted via
+         * @ref GL::AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+         * pick up its own per-draw parameters.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Set a projection uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain at least one instance of
+         * @ref ProjectionUniform3D. At the very least you need to call also
+         * @ref bindTransformationBuffer(), @ref bindDrawBuffer() and
+         * @ref bindMaterialBuffer(), usually @ref bindLightBuffer() as well.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindProjectionBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindProjectionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref TransformationUniform3D. At the very least you need to call
+         * also @ref bindProjectionBuffer(), @ref bindDrawBuffer() and
+         * @ref bindMaterialBuffer(), usually @ref bindLightBuffer() as well.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindTransformationBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref PhongDrawUniform. At the very least you need to call also
+         * @ref bindProjectionBuffer(), @ref bindTransformationBuffer() and
+         * @ref bindMaterialBuffer(), usually @ref bindLightBuffer() as well.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindDrawBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindDrawBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a texture transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that both @ref Flag::UniformBuffers and
+         * @ref Flag::TextureTransformation is set. The buffer is expected to
+         * contain @ref drawCount() instances of
+         * @ref TextureTransformationUniform.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindTextureTransformationBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindTextureTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a material uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref materialCount() instances of
+         * @ref PhongMaterialUniform. At the very least you need to call also
+         * @ref bindProjectionBuffer(), @ref bindTransformationBuffer() and
+         * @ref bindDrawBuffer(), usually @ref bindLightBuffer() as well.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindMaterialBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindMaterialBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a light uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref lightCount() instances of
+         * @ref PhongLightUniform. Which of them are used for a particular
+         * draw is specified by @ref PhongDrawUniform::lightOffset and
+         * @ref PhongDrawUniform::lightCount.
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindLightBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindLightBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
     private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit Phong(NoInitT) {}
+
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
         using GL::AbstractShaderProgram::drawTransformFeedback;
@@ -1014,6 +1412,9 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
 
         Flags _flags;
         UnsignedInt _lightCount;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _materialCount{}, _drawCount{};
+        #endif
         Int _transformationMatrixUniform{0},
             _projectionMatrixUniform{1},
             _normalMatrixUniform{2},
@@ -1031,8 +1432,386 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
             _lightColorsUniform, /* 11 + lightCount, set in the constructor */
             _lightSpecularColorsUniform, /* 11 + 2*lightCount */
             _lightRangesUniform; /* 11 + 3*lightCount */
+        #ifndef MAGNUM_TARGET_GLES2
+        /* Used instead of all other uniforms when Flag::UniformBuffers is
+           set, so it can alias them */
+        Int _drawOffsetUniform{0};
+        #endif
 };
 
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref Phong::compile(). See @ref shaders-async for
+more information.
+*/
+class Phong::CompileState: public Phong {
+    /* Everything deliberately private except for the inheritance */
+    friend Phong;
+
+    explicit CompileState(NoCreateT): Phong{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(Phong&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version): Phong{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version} {}
+
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+};
+
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Per-draw uniform for Phong shaders
+@m_since_latest
+
+Contents of a uniform buffer bound with @ref Phong::bindDrawBuffer(). Follows
+the std140 layout rules, one instance per draw. See @ref Shaders-Phong-ubo for
+more information.
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct PhongDrawUniform {
+    /** @brief Constructor */
+    constexpr explicit PhongDrawUniform() noexcept: normalMatrix{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}}, materialId{0}, objectId{0}, lightOffset{0}, lightCount{0xffffffffu} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PhongDrawUniform(NoInitT) noexcept: normalMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref normalMatrix field
+     * @return Reference to self (for method chaining)
+     *
+     * The matrix is expanded to @relativeref{Magnum,Matrix3x4}, with the
+     * bottom row being zero.
+     */
+    PhongDrawUniform& setNormalMatrix(const Matrix3x3& matrix) {
+        normalMatrix = Matrix3x4{
+            Vector4{matrix[0], 0.0f},
+            Vector4{matrix[1], 0.0f},
+            Vector4{matrix[2], 0.0f}};
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref materialId field
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setMaterialId(UnsignedInt id) {
+        materialId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref objectId field
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setObjectId(UnsignedInt id) {
+        objectId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref lightOffset and @ref lightCount fields
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setLightOffsetCount(UnsignedInt offset, UnsignedInt count) {
+        lightOffset = offset;
+        lightCount = count;
+        return *this;
+    }
+
+    /**
+     * @brief Normal matrix
+     *
+     * Default value is an identity matrix. The bottom row is unused and acts
+     * only as a padding to match uniform buffer packing rules. If
+     * @ref Phong::lightCount() is zero, normals don't contribute to the
+     * output and the value is unused.
+     * @see @ref Phong::setNormalMatrix()
+     */
+    Matrix3x4 normalMatrix;
+
+    /**
+     * @brief Material ID
+     *
+     * Index into the @ref PhongMaterialUniform buffer bound with
+     * @ref Phong::bindMaterialBuffer(). Expected to be less than
+     * @ref Phong::materialCount(). Default value is @cpp 0 @ce.
+     */
+    UnsignedInt materialId;
+
+    /**
+     * @brief Object ID
+     *
+     * Used only if @ref Phong::Flag::ObjectId is enabled, ignored otherwise.
+     * If @ref Phong::Flag::InstancedObjectId is enabled as well, this value is
+     * added to the ID coming from the @ref Phong::ObjectId attribute. Default
+     * value is @cpp 0 @ce.
+     * @see @ref Phong::setObjectId()
+     */
+    UnsignedInt objectId;
+
+    /**
+     * @brief Light offset
+     *
+     * Index of the first light in the @ref PhongLightUniform buffer bound
+     * with @ref Phong::bindLightBuffer() that's used for this draw. Expected
+     * to be less than @ref Phong::lightCount(), if it's not, the shader
+     * clamps it and no lights are used for the draw. Default value is
+     * @cpp 0 @ce.
+     */
+    UnsignedInt lightOffset;
+
+    /**
+     * @brief Light count
+     *
+     * Count of lights starting at @ref lightOffset used for this draw. The
+     * sum of @ref lightOffset and @ref lightCount is clamped to
+     * @ref Phong::lightCount(), so the default value of
+     * @cpp 0xffffffffu @ce means all lights after @ref lightOffset.
+     */
+    UnsignedInt lightCount;
+};
+
+/**
+@brief Material uniform for Phong shaders
+@m_since_latest
+
+Contents of a uniform buffer bound with @ref Phong::bindMaterialBuffer().
+Follows the std140 layout rules, one instance per material, selected with
+@ref PhongDrawUniform::materialId. See @ref Shaders-Phong-ubo for more
+information.
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct PhongMaterialUniform {
+    /** @brief Constructor */
+    constexpr explicit PhongMaterialUniform() noexcept: ambientColor{0.0f, 0.0f, 0.0f, 0.0f}, diffuseColor{1.0f, 1.0f, 1.0f, 1.0f}, specularColor{1.0f, 1.0f, 1.0f, 0.0f}, normalTextureScale{1.0f}, shininess{80.0f}, alphaMask{0.5f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PhongMaterialUniform(NoInitT) noexcept: ambientColor{NoInit}, diffuseColor{NoInit}, specularColor{NoInit} {}
+
+    /**
+     * @brief Set the @ref ambientColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setAmbientColor(const Color4& color) {
+        ambientColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref diffuseColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setDiffuseColor(const Color4& color) {
+        diffuseColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref specularColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setSpecularColor(const Color4& color) {
+        specularColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref normalTextureScale field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setNormalTextureScale(Float scale) {
+        normalTextureScale = scale;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref shininess field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setShininess(Float shininess) {
+        this->shininess = shininess;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref alphaMask field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setAlphaMask(Float alphaMask) {
+        this->alphaMask = alphaMask;
+        return *this;
+    }
+
+    /**
+     * @brief Ambient color
+     *
+     * Default value is @cpp 0x00000000_rgbaf @ce. If
+     * @ref Phong::Flag::AmbientTexture is enabled, you likely want to set
+     * this to @cpp 0xffffffff_rgbaf @ce, as the color is multiplied with the
+     * texture.
+     * @see @ref Phong::setAmbientColor()
+     */
+    Color4 ambientColor;
+
+    /**
+     * @brief Diffuse color
+     *
+     * Default value is @cpp 0xffffffff_rgbaf @ce. If
+     * @ref Phong::Flag::DiffuseTexture is enabled, the color is multiplied
+     * with the texture.
+     * @see @ref Phong::setDiffuseColor()
+     */
+    Color4 diffuseColor;
+
+    /**
+     * @brief Specular color
+     *
+     * Default value is @cpp 0xffffff00_rgbaf @ce. If
+     * @ref Phong::Flag::SpecularTexture is enabled, the color is multiplied
+     * with the texture.
+     * @see @ref Phong::setSpecularColor()
+     */
+    Color4 specularColor;
+
+    /**
+     * @brief Normal texture scale
+     *
+     * Used only if @ref Phong::Flag::NormalTexture is enabled, ignored
+     * otherwise. Default value is @cpp 1.0f @ce.
+     * @see @ref Phong::setNormalTextureScale()
+     */
+    Float normalTextureScale;
+
+    /**
+     * @brief Shininess
+     *
+     * Default value is @cpp 80.0f @ce.
+     * @see @ref Phong::setShininess()
+     */
+    Float shininess;
+
+    /**
+     * @brief Alpha mask value
+     *
+     * Used only if @ref Phong::Flag::AlphaMask is enabled, ignored otherwise.
+     * Default value is @cpp 0.5f @ce.
+     * @see @ref Phong::setAlphaMask()
+     */
+    Float alphaMask;
+
+    /* Explicit padding to the std140 array stride */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    #endif
+};
+
+/**
+@brief Light parameters uniform for Phong shaders
+@m_since_latest
+
+Contents of a uniform buffer bound with @ref Phong::bindLightBuffer(). Follows
+the std140 layout rules, one instance per light, with a range of them picked
+for a particular draw by @ref PhongDrawUniform::lightOffset and
+@ref PhongDrawUniform::lightCount. See @ref Shaders-Phong-ubo for more
+information.
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct PhongLightUniform {
+    /** @brief Constructor */
+    constexpr explicit PhongLightUniform() noexcept: position{0.0f, 0.0f, 1.0f, 0.0f}, color{1.0f, 1.0f, 1.0f}, specularColor{1.0f, 1.0f, 1.0f}, range{Constants::inf()} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PhongLightUniform(NoInitT) noexcept: position{NoInit}, color{NoInit}, specularColor{NoInit} {}
+
+    /**
+     * @brief Set the @ref position field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setPosition(const Vector4& position) {
+        this->position = position;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref color field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setColor(const Color3& color) {
+        this->color = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref specularColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setSpecularColor(const Color3& color) {
+        specularColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref range field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setRange(Float range) {
+        this->range = range;
+        return *this;
+    }
+
+    /**
+     * @brief Position
+     *
+     * Depending on the fourth component, the value is treated as either a
+     * camera-relative position of a point light, if the fourth component is
+     * @cpp 1.0f @ce; or a direction *to* a directional light, if the fourth
+     * component is @cpp 0.0f @ce. Default value is
+     * @cpp {0.0f, 0.0f, 1.0f, 0.0f} @ce --- a directional "fill" light
+     * coming from the camera.
+     * @see @ref Phong::setLightPosition()
+     */
+    Vector4 position;
+
+    /**
+     * @brief Color
+     *
+     * Default value is @cpp 0xffffff_rgbf @ce.
+     * @see @ref Phong::setLightColor()
+     */
+    Color3 color;
+
+    /* Explicit padding, vec3 is aligned to 16 bytes in std140 */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    #endif
+
+    /**
+     * @brief Specular color
+     *
+     * Default value is @cpp 0xffffff_rgbf @ce.
+     * @see @ref Phong::setLightSpecularColor()
+     */
+    Color3 specularColor;
+
+    /**
+     * @brief Range
+     *
+     * Default value is @ref Constants::inf().
+     * @see @ref Phong::setLightRange()
+     */
+    Float range;
+};
+#endif
+
 /** @debugoperatorclassenum{Phong,Phong::Flag} */
 MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, Phong::Flag value);
 
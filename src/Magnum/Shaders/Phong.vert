@@ -23,15 +23,24 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#if defined(INSTANCED_OBJECT_ID) && !defined(GL_ES) && !defined(NEW_GLSL)
+#if (defined(INSTANCED_OBJECT_ID) || defined(UNIFORM_BUFFERS)) && !defined(GL_ES) && !defined(NEW_GLSL)
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
+#ifdef MULTI_DRAW
+#extension GL_ARB_shader_draw_parameters: require
+#endif
+
 #ifndef NEW_GLSL
 #define in attribute
 #define out varying
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
@@ -84,6 +93,71 @@ uniform highp vec4 lightPositions[LIGHT_COUNT]
     ;
 #endif
 
+/* Uniform buffers */
+
+#else
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp uint drawOffset
+    #ifndef GL_ES
+    = 0u
+    #endif
+    ;
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 0
+    #endif
+) uniform Projection {
+    highp mat4 projectionMatrix;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 1
+    #endif
+) uniform Transformation {
+    highp mat4 transformationMatrices[DRAW_COUNT];
+};
+
+/* Keep in sync with Phong.frag and PhongDrawUniform in Phong.h. The mat3 is
+   padded to three vec4s by the std140 rules. */
+struct DrawUniform {
+    mediump mat3 normalMatrix;
+    highp uint materialId;
+    highp uint objectId;
+    highp uint lightOffset;
+    highp uint lightCount;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+#ifdef TEXTURE_TRANSFORMATION
+/* Keep in sync with TextureTransformationUniform in Generic.h */
+struct TextureTransformationUniform {
+    mediump vec4 rotationScaling;
+    mediump vec4 offsetReservedReserved;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 3
+    #endif
+) uniform TextureTransformation {
+    TextureTransformationUniform textureTransformations[DRAW_COUNT];
+};
+#endif
+
+flat out highp uint drawId;
+#endif
+
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -172,11 +246,31 @@ out mediump vec3 transformedTangent;
 out mediump vec3 transformedBitangent;
 #endif
 #endif
+#ifndef UNIFORM_BUFFERS
 out highp vec4 lightDirections[LIGHT_COUNT];
+#endif
 out highp vec3 cameraDirection;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef MULTI_DRAW
+    drawId = drawOffset + uint(gl_DrawIDARB);
+    #else
+    drawId = drawOffset;
+    #endif
+    highp mat4 transformationMatrix = transformationMatrices[drawId];
+    #if LIGHT_COUNT
+    mediump mat3 normalMatrix = draws[drawId].normalMatrix;
+    #endif
+    #ifdef TEXTURE_TRANSFORMATION
+    mediump mat3 textureMatrix = mat3(
+        vec3(textureTransformations[drawId].rotationScaling.xy, 0.0),
+        vec3(textureTransformations[drawId].rotationScaling.zw, 0.0),
+        vec3(textureTransformations[drawId].offsetReservedReserved.xy, 1.0));
+    #endif
+    #endif
+
     /* Transformed vertex position */
     highp vec4 transformedPosition4 = transformationMatrix*
         #ifdef INSTANCED_TRANSFORMATION
@@ -214,9 +308,14 @@ void main() {
     #endif
 
     /* Direction to the light. Directional lights have the last component set
-       to 0, which gets used to ignore the transformed position. */
+       to 0, which gets used to ignore the transformed position. With uniform
+       buffers the set of lights is picked per draw, so the directions are
+       calculated in the fragment shader from the camera direction instead to
+       keep the varying count independent of the light buffer size. */
+    #ifndef UNIFORM_BUFFERS
     for(int i = 0; i < LIGHT_COUNT; ++i)
         lightDirections[i] = vec4(lightPositions[i].xyz - transformedPosition*lightPositions[i].w, lightPositions[i].w);
+    #endif
 
     /* Direction to the camera */
     cameraDirection = -transformedPosition;
@@ -49,8 +49,19 @@ typedef AbstractVector<3> AbstractVector3D;
 template<UnsignedInt> class Flat;
 typedef Flat<2> Flat2D;
 typedef Flat<3> Flat3D;
+#ifndef MAGNUM_TARGET_GLES2
+struct FlatDrawUniform;
+struct FlatMaterialUniform;
+#endif
 
 /* Generic is used only statically */
+#ifndef MAGNUM_TARGET_GLES2
+struct TransformationProjectionUniform2D;
+struct TransformationProjectionUniform3D;
+struct ProjectionUniform3D;
+struct TransformationUniform3D;
+struct TextureTransformationUniform;
+#endif
 
 class MeshVisualizer2D;
 class MeshVisualizer3D;
@@ -59,6 +70,11 @@ typedef CORRADE_DEPRECATED("use MeshVisualizer3D instead") MeshVisualizer3D Mesh
 #endif
 
 class Phong;
+#ifndef MAGNUM_TARGET_GLES2
+struct PhongDrawUniform;
+struct PhongMaterialUniform;
+struct PhongLightUniform;
+#endif
 
 template<UnsignedInt> class Vector;
 typedef Vector<2> Vector2D;
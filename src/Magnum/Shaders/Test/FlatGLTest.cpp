@@ -30,11 +30,13 @@
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/System.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Mesh.h"
@@ -65,15 +67,25 @@ struct FlatGLTest: GL::OpenGLTester {
 
     template<UnsignedInt dimensions> void construct();
 
+    template<UnsignedInt dimensions> void constructAsync();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffers();
+    #endif
     template<UnsignedInt dimensions> void constructMove();
 
     template<UnsignedInt dimensions> void constructTextureTransformationNotTextured();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffersZeroCounts();
+    #endif
 
     template<UnsignedInt dimensions> void bindTextureNotEnabled();
     template<UnsignedInt dimensions> void setAlphaMaskNotEnabled();
     template<UnsignedInt dimensions> void setTextureMatrixNotEnabled();
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void setObjectIdNotEnabled();
+    template<UnsignedInt dimensions> void setUniformUniformBuffersEnabled();
+    template<UnsignedInt dimensions> void bindBufferUniformBuffersNotEnabled();
+    template<UnsignedInt dimensions> void setDrawOffsetOutOfBounds();
     #endif
 
     void renderSetup();
@@ -83,6 +95,10 @@ struct FlatGLTest: GL::OpenGLTester {
     void renderDefaults3D();
     void renderColored2D();
     void renderColored3D();
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderColoredUniformBuffers2D();
+    void renderColoredUniformBuffers3D();
+    #endif
     void renderSinglePixelTextured2D();
     void renderSinglePixelTextured3D();
     void renderTextured2D();
@@ -192,6 +208,20 @@ const struct {
 };
 
 #ifndef MAGNUM_TARGET_GLES2
+constexpr struct {
+    const char* name;
+    Flat2D::Flags flags;
+    UnsignedInt materialCount, drawCount;
+} ConstructUniformBuffersData[]{
+    {"", Flat2D::Flag::UniformBuffers, 1, 1},
+    {"textured + texture transformation", Flat2D::Flag::UniformBuffers|Flat2D::Flag::Textured|Flat2D::Flag::TextureTransformation, 1, 1},
+    {"object ID + alpha mask", Flat2D::Flag::UniformBuffers|Flat2D::Flag::ObjectId|Flat2D::Flag::AlphaMask, 1, 1},
+    {"multiple materials, draws", Flat2D::Flag::UniformBuffers, 16, 48},
+    #ifndef MAGNUM_TARGET_GLES
+    {"multidraw with all the things", Flat2D::Flag::MultiDraw|Flat2D::Flag::Textured|Flat2D::Flag::TextureTransformation|Flat2D::Flag::AlphaMask|Flat2D::Flag::ObjectId|Flat2D::Flag::InstancedTextureOffset|Flat2D::Flag::InstancedTransformation|Flat2D::Flag::InstancedObjectId, 16, 48}
+    #endif
+};
+
 constexpr struct {
     const char* name;
     Flat2D::Flags flags;
@@ -214,12 +244,26 @@ FlatGLTest::FlatGLTest() {
         &FlatGLTest::construct<3>},
         Containers::arraySize(ConstructData));
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests<FlatGLTest>({
+        &FlatGLTest::constructUniformBuffers<2>,
+        &FlatGLTest::constructUniformBuffers<3>},
+        Containers::arraySize(ConstructUniformBuffersData));
+    #endif
+
     addTests<FlatGLTest>({
+        &FlatGLTest::constructAsync<2>,
+        &FlatGLTest::constructAsync<3>,
+
         &FlatGLTest::constructMove<2>,
         &FlatGLTest::constructMove<3>,
 
         &FlatGLTest::constructTextureTransformationNotTextured<2>,
         &FlatGLTest::constructTextureTransformationNotTextured<3>,
+        #ifndef MAGNUM_TARGET_GLES2
+        &FlatGLTest::constructUniformBuffersZeroCounts<2>,
+        &FlatGLTest::constructUniformBuffersZeroCounts<3>,
+        #endif
 
         &FlatGLTest::bindTextureNotEnabled<2>,
         &FlatGLTest::bindTextureNotEnabled<3>,
@@ -229,7 +273,13 @@ FlatGLTest::FlatGLTest() {
         &FlatGLTest::setTextureMatrixNotEnabled<3>,
         #ifndef MAGNUM_TARGET_GLES2
         &FlatGLTest::setObjectIdNotEnabled<2>,
-        &FlatGLTest::setObjectIdNotEnabled<3>
+        &FlatGLTest::setObjectIdNotEnabled<3>,
+        &FlatGLTest::setUniformUniformBuffersEnabled<2>,
+        &FlatGLTest::setUniformUniformBuffersEnabled<3>,
+        &FlatGLTest::bindBufferUniformBuffersNotEnabled<2>,
+        &FlatGLTest::bindBufferUniformBuffersNotEnabled<3>,
+        &FlatGLTest::setDrawOffsetOutOfBounds<2>,
+        &FlatGLTest::setDrawOffsetOutOfBounds<3>
         #endif
         });
 
@@ -237,6 +287,10 @@ FlatGLTest::FlatGLTest() {
               &FlatGLTest::renderDefaults3D,
               &FlatGLTest::renderColored2D,
               &FlatGLTest::renderColored3D,
+              #ifndef MAGNUM_TARGET_GLES2
+              &FlatGLTest::renderColoredUniformBuffers2D,
+              &FlatGLTest::renderColoredUniformBuffers3D,
+              #endif
               &FlatGLTest::renderSinglePixelTextured2D,
               &FlatGLTest::renderSinglePixelTextured3D},
         &FlatGLTest::renderSetup,
@@ -322,6 +376,60 @@ template<UnsignedInt dimensions> void FlatGLTest::construct() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void FlatGLTest::constructUniformBuffers() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    auto&& data = ConstructUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if((data.flags & Flat2D::Flag::ObjectId) && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(data.flags >= Flat2D::Flag::MultiDraw && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+        CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() + std::string(" is not supported"));
+    #endif
+
+    Flat<dimensions> shader{data.flags, data.materialCount, data.drawCount};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.materialCount(), data.materialCount);
+    CORRADE_COMPARE(shader.drawCount(), data.drawCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
+template<UnsignedInt dimensions> void FlatGLTest::constructAsync() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    typename Flat<dimensions>::CompileState state = Flat<dimensions>::compile(Flat<dimensions>::Flag::Textured|Flat<dimensions>::Flag::AlphaMask);
+    CORRADE_COMPARE(state.flags(), Flat<dimensions>::Flag::Textured|Flat<dimensions>::Flag::AlphaMask);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    Flat<dimensions> shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), Flat<dimensions>::Flag::Textured|Flat<dimensions>::Flag::AlphaMask);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
 template<UnsignedInt dimensions> void FlatGLTest::constructMove() {
     setTestCaseTemplateName(std::to_string(dimensions));
 
@@ -357,6 +465,29 @@ template<UnsignedInt dimensions> void FlatGLTest::constructTextureTransformation
         "Shaders::Flat: texture transformation enabled but the shader is not textured\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void FlatGLTest::constructUniformBuffersZeroCounts() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Flat<dimensions>{Flat<dimensions>::Flag::UniformBuffers, 0, 1};
+    Flat<dimensions>{Flat<dimensions>::Flag::UniformBuffers, 1, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat: material count can't be zero\n"
+        "Shaders::Flat: draw count can't be zero\n");
+}
+#endif
+
 template<UnsignedInt dimensions> void FlatGLTest::bindTextureNotEnabled() {
     setTestCaseTemplateName(std::to_string(dimensions));
 
@@ -425,6 +556,89 @@ template<UnsignedInt dimensions> void FlatGLTest::setObjectIdNotEnabled() {
     CORRADE_COMPARE(out.str(),
         "Shaders::Flat::setObjectId(): the shader was not created with object ID enabled\n");
 }
+
+template<UnsignedInt dimensions> void FlatGLTest::setUniformUniformBuffersEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Flat<dimensions> shader{Flat<dimensions>::Flag::UniformBuffers|Flat<dimensions>::Flag::Textured|Flat<dimensions>::Flag::TextureTransformation|Flat<dimensions>::Flag::AlphaMask|Flat<dimensions>::Flag::ObjectId, 1, 1};
+    shader.setTransformationProjectionMatrix({})
+        .setTextureMatrix({})
+        .setColor({})
+        .setAlphaMask(0.5f)
+        .setObjectId(0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setTextureMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setAlphaMask(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setObjectId(): the shader was created with uniform buffers enabled\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::bindBufferUniformBuffersNotEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer;
+    Flat<dimensions> shader;
+    shader.bindTransformationProjectionBuffer(buffer)
+        .bindTransformationProjectionBuffer(buffer, 0, 16)
+        .bindDrawBuffer(buffer)
+        .bindDrawBuffer(buffer, 0, 16)
+        .bindTextureTransformationBuffer(buffer)
+        .bindTextureTransformationBuffer(buffer, 0, 16)
+        .bindMaterialBuffer(buffer)
+        .bindMaterialBuffer(buffer, 0, 16)
+        .setDrawOffset(0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::setDrawOffset(): the shader was not created with uniform buffers enabled\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::setDrawOffsetOutOfBounds() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Flat<dimensions> shader{Flat<dimensions>::Flag::UniformBuffers, 1, 5};
+    shader.setDrawOffset(5);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::setDrawOffset(): draw offset 5 is out of bounds for 5 draws\n");
+}
 #endif
 
 constexpr Vector2i RenderSize{80, 80};
@@ -521,6 +735,101 @@ void FlatGLTest::renderColored2D() {
         (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void FlatGLTest::renderColoredUniformBuffers2D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    GL::Mesh circle = MeshTools::compile(Primitives::circle2DSolid(32));
+
+    /* The first draw and material are deliberately bogus to verify the draw
+       offset and material ID get used */
+    GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationProjectionUniform2D{}
+            .setTransformationProjectionMatrix(Matrix3::scaling(Vector2{0.1f})),
+        TransformationProjectionUniform2D{}
+            .setTransformationProjectionMatrix(Matrix3::projection({2.1f, 2.1f}))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatDrawUniform{},
+        FlatDrawUniform{}
+            .setMaterialId(1)
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatMaterialUniform{}
+            .setColor(0xff0000_rgbf),
+        FlatMaterialUniform{}
+            .setColor(0x9999ff_rgbf)
+    }};
+
+    Flat2D{Flat2D::Flag::UniformBuffers, 2, 2}
+        .bindTransformationProjectionBuffer(transformationProjectionUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .setDrawOffset(1)
+        .draw(circle);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Should be exactly the same output as the classic uniform variant */
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "FlatTestFiles/colored2D.tga"),
+        (DebugTools::CompareImageToFile{_manager}));
+}
+
+void FlatGLTest::renderColoredUniformBuffers3D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
+
+    GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationProjectionUniform3D{}
+            .setTransformationProjectionMatrix(
+                Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f)*
+                Matrix4::translation(Vector3::zAxis(-2.15f))*
+                Matrix4::rotationY(-15.0_degf)*
+                Matrix4::rotationX(15.0_degf))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatDrawUniform{}
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatMaterialUniform{}
+            .setColor(0x9999ff_rgbf)
+    }};
+
+    Flat3D{Flat3D::Flag::UniformBuffers, 1, 1}
+        .bindTransformationProjectionBuffer(transformationProjectionUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .draw(sphere);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "FlatTestFiles/colored3D.tga"),
+        /* SwiftShader has 5 different pixels on the edges */
+        (DebugTools::CompareImageToFile{_manager, 170.0f, 0.133f}));
+}
+#endif
+
 void FlatGLTest::renderColored3D() {
     GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
 
@@ -23,20 +23,33 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <new>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 
+#include "Magnum/Math/Color.h"
 #include "Magnum/Shaders/Flat.h"
 
 namespace Magnum { namespace Shaders { namespace Test { namespace {
 
+using namespace Math::Literals;
+
 struct FlatTest: TestSuite::Tester {
     explicit FlatTest();
 
     template<UnsignedInt dimensions> void constructNoCreate();
     template<UnsignedInt dimensions> void constructCopy();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void drawUniformConstructDefault();
+    void drawUniformConstructNoInit();
+    void drawUniformSetters();
+    void materialUniformConstructDefault();
+    void materialUniformConstructNoInit();
+    void materialUniformSetters();
+    #endif
+
     void debugFlag();
     void debugFlags();
     void debugFlagsSupersets();
@@ -49,6 +62,15 @@ FlatTest::FlatTest() {
               &FlatTest::constructCopy<2>,
               &FlatTest::constructCopy<3>,
 
+              #ifndef MAGNUM_TARGET_GLES2
+              &FlatTest::drawUniformConstructDefault,
+              &FlatTest::drawUniformConstructNoInit,
+              &FlatTest::drawUniformSetters,
+              &FlatTest::materialUniformConstructDefault,
+              &FlatTest::materialUniformConstructNoInit,
+              &FlatTest::materialUniformSetters,
+              #endif
+
               &FlatTest::debugFlag,
               &FlatTest::debugFlags,
               &FlatTest::debugFlagsSupersets});
@@ -75,6 +97,99 @@ template<UnsignedInt dimensions> void FlatTest::constructCopy() {
     CORRADE_VERIFY(!(std::is_assignable<Flat<dimensions>, const Flat<dimensions>&>{}));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void FlatTest::drawUniformConstructDefault() {
+    FlatDrawUniform a;
+    CORRADE_COMPARE(a.materialId, 0);
+    CORRADE_COMPARE(a.objectId, 0);
+
+    constexpr FlatDrawUniform ca;
+    CORRADE_COMPARE(ca.materialId, 0);
+    CORRADE_COMPARE(ca.objectId, 0);
+
+    /* Has to match the std140 array stride */
+    CORRADE_COMPARE(sizeof(FlatDrawUniform), 16);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<FlatDrawUniform>::value);
+}
+
+void FlatTest::drawUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    FlatDrawUniform a;
+    a.materialId = 5;
+    a.objectId = 7;
+
+    new(&a) FlatDrawUniform{NoInit};
+    {
+        /* Explicitly check we're not on Clang because certain Clang-based IDEs
+           inherit __GNUC__ if GCC is used instead of leaving it at 4 like
+           Clang itself does */
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.materialId, 5);
+        CORRADE_COMPARE(a.objectId, 7);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<FlatDrawUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, FlatDrawUniform>::value);
+}
+
+void FlatTest::drawUniformSetters() {
+    FlatDrawUniform a;
+    a.setMaterialId(5)
+     .setObjectId(7);
+    CORRADE_COMPARE(a.materialId, 5);
+    CORRADE_COMPARE(a.objectId, 7);
+}
+
+void FlatTest::materialUniformConstructDefault() {
+    FlatMaterialUniform a;
+    CORRADE_COMPARE(a.color, (Color4{1.0f, 1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(a.alphaMask, 0.5f);
+
+    constexpr FlatMaterialUniform ca;
+    CORRADE_COMPARE(ca.color, (Color4{1.0f, 1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(ca.alphaMask, 0.5f);
+
+    /* Has to match the std140 array stride */
+    CORRADE_COMPARE(sizeof(FlatMaterialUniform), 32);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<FlatMaterialUniform>::value);
+}
+
+void FlatTest::materialUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    FlatMaterialUniform a;
+    a.color = 0x354565fc_rgbaf;
+    a.alphaMask = 0.7f;
+
+    new(&a) FlatMaterialUniform{NoInit};
+    {
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.color, 0x354565fc_rgbaf);
+        CORRADE_COMPARE(a.alphaMask, 0.7f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<FlatMaterialUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, FlatMaterialUniform>::value);
+}
+
+void FlatTest::materialUniformSetters() {
+    FlatMaterialUniform a;
+    a.setColor(0x354565fc_rgbaf)
+     .setAlphaMask(0.7f);
+    CORRADE_COMPARE(a.color, 0x354565fc_rgbaf);
+    CORRADE_COMPARE(a.alphaMask, 0.7f);
+}
+#endif
+
 void FlatTest::debugFlag() {
     std::ostringstream out;
 
@@ -102,9 +217,21 @@ void FlatTest::debugFlagsSupersets() {
 
     /* InstancedTextureOffset is a superset of TextureTransformation so only
        one should be printed */
-    std::ostringstream out;
-    Debug{&out} << (Flat3D::Flag::InstancedTextureOffset|Flat3D::Flag::TextureTransformation);
-    CORRADE_COMPARE(out.str(), "Shaders::Flat::Flag::InstancedTextureOffset\n");
+    {
+        std::ostringstream out;
+        Debug{&out} << (Flat3D::Flag::InstancedTextureOffset|Flat3D::Flag::TextureTransformation);
+        CORRADE_COMPARE(out.str(), "Shaders::Flat::Flag::InstancedTextureOffset\n");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* MultiDraw is a superset of UniformBuffers so only one should be
+       printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (Flat3D::Flag::MultiDraw|Flat3D::Flag::UniformBuffers);
+        CORRADE_COMPARE(out.str(), "Shaders::Flat::Flag::MultiDraw\n");
+    }
+    #endif
 }
 
 }}}}
@@ -40,6 +40,17 @@ struct GenericTest: TestSuite::Tester {
     void tbnContiguous();
     void tbnBothNormalAndQuaternion();
     void textureTransformContiguous();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void transformationProjectionUniform2DConstructDefault();
+    void transformationProjectionUniform2DSetters();
+    void transformationProjectionUniform3DConstructDefault();
+    void transformationProjectionUniform3DSetters();
+    void projectionUniform3DConstructDefault();
+    void transformationUniform3DConstructDefault();
+    void textureTransformationUniformConstructDefault();
+    void textureTransformationUniformSetters();
+    #endif
 };
 
 GenericTest::GenericTest() {
@@ -48,7 +59,19 @@ GenericTest::GenericTest() {
 
               &GenericTest::tbnContiguous,
               &GenericTest::tbnBothNormalAndQuaternion,
-              &GenericTest::textureTransformContiguous});
+              &GenericTest::textureTransformContiguous,
+
+              #ifndef MAGNUM_TARGET_GLES2
+              &GenericTest::transformationProjectionUniform2DConstructDefault,
+              &GenericTest::transformationProjectionUniform2DSetters,
+              &GenericTest::transformationProjectionUniform3DConstructDefault,
+              &GenericTest::transformationProjectionUniform3DSetters,
+              &GenericTest::projectionUniform3DConstructDefault,
+              &GenericTest::transformationUniform3DConstructDefault,
+              &GenericTest::textureTransformationUniformConstructDefault,
+              &GenericTest::textureTransformationUniformSetters,
+              #endif
+              });
 }
 
 void GenericTest::glslMatch() {
@@ -111,6 +134,68 @@ void GenericTest::textureTransformContiguous() {
     //CORRADE_COMPARE(Generic3D::TextureOffset::Location, Generic3D::TextureMatrix::Location + 2);
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void GenericTest::transformationProjectionUniform2DConstructDefault() {
+    constexpr TransformationProjectionUniform2D a;
+    CORRADE_COMPARE(a.transformationProjectionMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}}));
+
+    /* Has to match the std140 array stride */
+    CORRADE_COMPARE(sizeof(TransformationProjectionUniform2D), 48);
+}
+
+void GenericTest::transformationProjectionUniform2DSetters() {
+    TransformationProjectionUniform2D a;
+    a.setTransformationProjectionMatrix(Matrix3::translation({3.0f, 4.0f}));
+    CORRADE_COMPARE(a.transformationProjectionMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{3.0f, 4.0f, 1.0f, 0.0f}}));
+}
+
+void GenericTest::transformationProjectionUniform3DConstructDefault() {
+    constexpr TransformationProjectionUniform3D a;
+    CORRADE_COMPARE(a.transformationProjectionMatrix, Matrix4{});
+    CORRADE_COMPARE(sizeof(TransformationProjectionUniform3D), 64);
+}
+
+void GenericTest::transformationProjectionUniform3DSetters() {
+    TransformationProjectionUniform3D a;
+    a.setTransformationProjectionMatrix(Matrix4::translation({3.0f, 4.0f, 5.0f}));
+    CORRADE_COMPARE(a.transformationProjectionMatrix, Matrix4::translation({3.0f, 4.0f, 5.0f}));
+}
+
+void GenericTest::projectionUniform3DConstructDefault() {
+    constexpr ProjectionUniform3D a;
+    CORRADE_COMPARE(a.projectionMatrix, Matrix4{});
+    CORRADE_COMPARE(sizeof(ProjectionUniform3D), 64);
+}
+
+void GenericTest::transformationUniform3DConstructDefault() {
+    constexpr TransformationUniform3D a;
+    CORRADE_COMPARE(a.transformationMatrix, Matrix4{});
+    CORRADE_COMPARE(sizeof(TransformationUniform3D), 64);
+}
+
+void GenericTest::textureTransformationUniformConstructDefault() {
+    constexpr TextureTransformationUniform a;
+    CORRADE_COMPARE(a.rotationScaling, (Vector4{1.0f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(a.offset, Vector2{});
+
+    /* Has to match the std140 array stride */
+    CORRADE_COMPARE(sizeof(TextureTransformationUniform), 32);
+}
+
+void GenericTest::textureTransformationUniformSetters() {
+    TextureTransformationUniform a;
+    a.setTextureMatrix(Matrix3::translation({0.5f, 0.25f})*Matrix3::scaling({2.0f, 3.0f}));
+    CORRADE_COMPARE(a.rotationScaling, (Vector4{2.0f, 0.0f, 0.0f, 3.0f}));
+    CORRADE_COMPARE(a.offset, (Vector2{0.5f, 0.25f}));
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::GenericTest)
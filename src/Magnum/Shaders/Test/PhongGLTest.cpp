@@ -30,11 +30,13 @@
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/System.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Framebuffer.h"
@@ -65,9 +67,16 @@ struct PhongGLTest: GL::OpenGLTester {
 
     void construct();
 
+    void constructAsync();
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructUniformBuffers();
+    #endif
     void constructMove();
 
     void constructTextureTransformationNotTextured();
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructUniformBuffersZeroCounts();
+    #endif
 
     void bindTexturesNotEnabled();
     void setAlphaMaskNotEnabled();
@@ -77,6 +86,11 @@ struct PhongGLTest: GL::OpenGLTester {
     #endif
     void setWrongLightCount();
     void setWrongLightId();
+    #ifndef MAGNUM_TARGET_GLES2
+    void setUniformUniformBuffersEnabled();
+    void bindBufferUniformBuffersNotEnabled();
+    void setDrawOffsetOutOfBounds();
+    #endif
 
     void renderSetup();
     void renderTeardown();
@@ -106,6 +120,9 @@ struct PhongGLTest: GL::OpenGLTester {
 
     void renderLights();
     void renderLightsSetOneByOne();
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderLightsUniformBuffers();
+    #endif
     void renderLowLightAngle();
     void renderZeroLights();
 
@@ -482,12 +499,38 @@ constexpr struct {
         }
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+constexpr struct {
+    const char* name;
+    Phong::Flags flags;
+    UnsignedInt lightCount, materialCount, drawCount;
+} ConstructUniformBuffersData[]{
+    {"", Phong::Flag::UniformBuffers, 1, 1, 1},
+    {"ambient + diffuse + specular texture + texture transformation", Phong::Flag::UniformBuffers|Phong::Flag::AmbientTexture|Phong::Flag::DiffuseTexture|Phong::Flag::SpecularTexture|Phong::Flag::TextureTransformation, 1, 1, 1},
+    {"normal texture + bitangent + alpha mask", Phong::Flag::UniformBuffers|Phong::Flag::NormalTexture|Phong::Flag::Bitangent|Phong::Flag::AlphaMask, 1, 1, 1},
+    {"object ID", Phong::Flag::UniformBuffers|Phong::Flag::ObjectId, 1, 1, 1},
+    {"zero lights", Phong::Flag::UniformBuffers, 0, 16, 24},
+    {"multiple lights, materials, draws", Phong::Flag::UniformBuffers, 8, 16, 24},
+    #ifndef MAGNUM_TARGET_GLES
+    {"multidraw with all the things", Phong::Flag::MultiDraw|Phong::Flag::AmbientTexture|Phong::Flag::DiffuseTexture|Phong::Flag::SpecularTexture|Phong::Flag::NormalTexture|Phong::Flag::TextureTransformation|Phong::Flag::AlphaMask|Phong::Flag::ObjectId|Phong::Flag::InstancedTextureOffset|Phong::Flag::InstancedTransformation|Phong::Flag::InstancedObjectId, 8, 16, 24}
+    #endif
+};
+#endif
+
 PhongGLTest::PhongGLTest() {
     addInstancedTests({&PhongGLTest::construct}, Containers::arraySize(ConstructData));
 
-    addTests({&PhongGLTest::constructMove,
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests({&PhongGLTest::constructUniformBuffers}, Containers::arraySize(ConstructUniformBuffersData));
+    #endif
+
+    addTests({&PhongGLTest::constructAsync,
+              &PhongGLTest::constructMove,
 
               &PhongGLTest::constructTextureTransformationNotTextured,
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::constructUniformBuffersZeroCounts,
+              #endif
 
               &PhongGLTest::bindTexturesNotEnabled,
               &PhongGLTest::setAlphaMaskNotEnabled,
@@ -496,7 +539,13 @@ PhongGLTest::PhongGLTest() {
               &PhongGLTest::setObjectIdNotEnabled,
               #endif
               &PhongGLTest::setWrongLightCount,
-              &PhongGLTest::setWrongLightId});
+              &PhongGLTest::setWrongLightId,
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::setUniformUniformBuffersEnabled,
+              &PhongGLTest::bindBufferUniformBuffersNotEnabled,
+              &PhongGLTest::setDrawOffsetOutOfBounds
+              #endif
+              });
 
     addTests({&PhongGLTest::renderDefaults},
         &PhongGLTest::renderSetup,
@@ -550,6 +599,9 @@ PhongGLTest::PhongGLTest() {
         &PhongGLTest::renderTeardown);
 
     addTests({&PhongGLTest::renderLightsSetOneByOne,
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::renderLightsUniformBuffers,
+              #endif
               &PhongGLTest::renderLowLightAngle},
         &PhongGLTest::renderSetup,
         &PhongGLTest::renderTeardown);
@@ -616,6 +668,59 @@ void PhongGLTest::construct() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::constructUniformBuffers() {
+    auto&& data = ConstructUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if((data.flags & Phong::Flag::ObjectId) && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(data.flags >= Phong::Flag::MultiDraw && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+        CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() + std::string(" is not supported"));
+    #endif
+
+    Phong shader{data.flags, data.lightCount, data.materialCount, data.drawCount};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.lightCount(), data.lightCount);
+    CORRADE_COMPARE(shader.materialCount(), data.materialCount);
+    CORRADE_COMPARE(shader.drawCount(), data.drawCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
+void PhongGLTest::constructAsync() {
+    Phong::CompileState state = Phong::compile(Phong::Flag::DiffuseTexture|Phong::Flag::AlphaMask, 3);
+    CORRADE_COMPARE(state.flags(), Phong::Flag::DiffuseTexture|Phong::Flag::AlphaMask);
+    CORRADE_COMPARE(state.lightCount(), 3);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    Phong shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), Phong::Flag::DiffuseTexture|Phong::Flag::AlphaMask);
+    CORRADE_COMPARE(shader.lightCount(), 3);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
 void PhongGLTest::constructMove() {
     Phong a{Phong::Flag::AlphaMask, 3};
     const GLuint id = a.id();
@@ -649,6 +754,27 @@ void PhongGLTest::constructTextureTransformationNotTextured() {
         "Shaders::Phong: texture transformation enabled but the shader is not textured\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::constructUniformBuffersZeroCounts() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Phong{Phong::Flag::UniformBuffers, 1, 0, 1};
+    Phong{Phong::Flag::UniformBuffers, 1, 1, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong: material count can't be zero\n"
+        "Shaders::Phong: draw count can't be zero\n");
+}
+#endif
+
 void PhongGLTest::bindTexturesNotEnabled() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -756,6 +882,121 @@ void PhongGLTest::setWrongLightId() {
         "Shaders::Phong::setLightRange(): light ID 3 is out of bounds for 3 lights\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::setUniformUniformBuffersEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Phong shader{Phong::Flag::UniformBuffers|Phong::Flag::NormalTexture|Phong::Flag::TextureTransformation|Phong::Flag::AlphaMask|Phong::Flag::ObjectId, 1, 1, 1};
+    shader.setAmbientColor({})
+        .setDiffuseColor({})
+        .setNormalTextureScale({})
+        .setSpecularColor({})
+        .setShininess({})
+        .setAlphaMask({})
+        .setObjectId({})
+        .setTransformationMatrix({})
+        .setNormalMatrix({})
+        .setProjectionMatrix({})
+        .setTextureMatrix({})
+        .setLightPositions({Vector4{}})
+        .setLightPosition(0, {})
+        .setLightColors({Color3{}})
+        .setLightColor(0, {})
+        .setLightSpecularColors({Color3{}})
+        .setLightSpecularColor(0, {})
+        .setLightRanges({0.0f})
+        .setLightRange(0, {});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::setAmbientColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setDiffuseColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setNormalTextureScale(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setSpecularColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setShininess(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setAlphaMask(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setObjectId(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setTransformationMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setNormalMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setProjectionMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setTextureMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightPositions(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightPosition(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightColors(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightSpecularColors(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightSpecularColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightRanges(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightRange(): the shader was created with uniform buffers enabled\n");
+}
+
+void PhongGLTest::bindBufferUniformBuffersNotEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer;
+    Phong shader;
+    shader.bindProjectionBuffer(buffer)
+        .bindProjectionBuffer(buffer, 0, 16)
+        .bindTransformationBuffer(buffer)
+        .bindTransformationBuffer(buffer, 0, 16)
+        .bindDrawBuffer(buffer)
+        .bindDrawBuffer(buffer, 0, 16)
+        .bindTextureTransformationBuffer(buffer)
+        .bindTextureTransformationBuffer(buffer, 0, 16)
+        .bindMaterialBuffer(buffer)
+        .bindMaterialBuffer(buffer, 0, 16)
+        .bindLightBuffer(buffer)
+        .bindLightBuffer(buffer, 0, 16)
+        .setDrawOffset(0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::setDrawOffset(): the shader was not created with uniform buffers enabled\n");
+}
+
+void PhongGLTest::setDrawOffsetOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Phong shader{Phong::Flag::UniformBuffers, 1, 1, 5};
+    shader.setDrawOffset(5);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::setDrawOffset(): draw offset 5 is out of bounds for 5 draws\n");
+}
+#endif
+
 constexpr Vector2i RenderSize{80, 80};
 
 void PhongGLTest::renderSetup() {
@@ -1593,6 +1834,81 @@ void PhongGLTest::renderLightsSetOneByOne() {
         (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::renderLightsUniformBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    GL::Mesh plane = MeshTools::compile(Primitives::planeSolid());
+
+    Matrix4 transformation =
+        Matrix4::translation({0.0f, 0.0f, -1.5f});
+
+    GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+        ProjectionUniform3D{}
+            .setProjectionMatrix(Matrix4::perspectiveProjection(80.0_degf, 1.0f, 0.1f, 20.0f))
+    }};
+    GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationUniform3D{}
+            .setTransformationMatrix(transformation)
+    }};
+    /* Same setup as in renderLightsSetOneByOne(), but with a bogus light in
+       front to verify the light offset gets used */
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongDrawUniform{}
+            .setNormalMatrix(transformation.normalMatrix())
+            .setLightOffsetCount(1, 2)
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongMaterialUniform{}
+            /* Set non-black ambient to catch accidental NaNs -- the render
+               should never be fully black */
+            .setAmbientColor(0x222222_rgbf)
+            .setShininess(60.0f)
+    }};
+    GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongLightUniform{}
+            .setPosition({0.0f, 0.0f, 1.0f, 0.0f})
+            .setColor(0xff0000_rgbf),
+        PhongLightUniform{}
+            .setPosition({-1.0f, 1.5f, -0.5f, 0.0f})
+            .setColor(0x00ffff_rgbf)
+            .setSpecularColor(0x0000ff_rgbf),
+        PhongLightUniform{}
+            .setPosition({0.75f, -0.75f, -0.75f, 1.0f})
+            .setColor(0xff8080_rgbf)
+            .setSpecularColor(0x80ff80_rgbf)
+            .setRange(1.5f)
+    }};
+
+    Phong{Phong::Flag::UniformBuffers, 3, 1, 1}
+        .bindProjectionBuffer(projectionUniform)
+        .bindTransformationBuffer(transformationUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .bindLightBuffer(lightUniform)
+        .draw(plane);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    const Image2D image = _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm});
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Light directions are calculated per-fragment here, so allow for slight
+       precision differences compared to the classic uniform variant */
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<const Color3ub>(image.pixels<Color4ub>()),
+        Utility::Directory::join({_testDir, "PhongTestFiles/light-point-range1.5.tga"}),
+        (DebugTools::CompareImageToFile{_manager, 3.0f, 0.02f}));
+}
+#endif
+
 void PhongGLTest::renderLowLightAngle() {
     GL::Mesh plane = MeshTools::compile(Primitives::planeSolid());
 
@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstddef>
+#include <new>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -31,12 +33,26 @@
 
 namespace Magnum { namespace Shaders { namespace Test { namespace {
 
+using namespace Math::Literals;
+
 struct PhongTest: TestSuite::Tester {
     explicit PhongTest();
 
     void constructNoCreate();
     void constructCopy();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void drawUniformConstructDefault();
+    void drawUniformConstructNoInit();
+    void drawUniformSetters();
+    void materialUniformConstructDefault();
+    void materialUniformConstructNoInit();
+    void materialUniformSetters();
+    void lightUniformConstructDefault();
+    void lightUniformConstructNoInit();
+    void lightUniformSetters();
+    #endif
+
     void debugFlag();
     void debugFlags();
     void debugFlagsSupersets();
@@ -46,6 +62,18 @@ PhongTest::PhongTest() {
     addTests({&PhongTest::constructNoCreate,
               &PhongTest::constructCopy,
 
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongTest::drawUniformConstructDefault,
+              &PhongTest::drawUniformConstructNoInit,
+              &PhongTest::drawUniformSetters,
+              &PhongTest::materialUniformConstructDefault,
+              &PhongTest::materialUniformConstructNoInit,
+              &PhongTest::materialUniformSetters,
+              &PhongTest::lightUniformConstructDefault,
+              &PhongTest::lightUniformConstructNoInit,
+              &PhongTest::lightUniformSetters,
+              #endif
+
               &PhongTest::debugFlag,
               &PhongTest::debugFlags,
               &PhongTest::debugFlagsSupersets});
@@ -65,6 +93,186 @@ void PhongTest::constructCopy() {
     CORRADE_VERIFY(!(std::is_assignable<Phong, const Phong&>{}));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongTest::drawUniformConstructDefault() {
+    PhongDrawUniform a;
+    CORRADE_COMPARE(a.normalMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}}));
+    CORRADE_COMPARE(a.materialId, 0);
+    CORRADE_COMPARE(a.objectId, 0);
+    CORRADE_COMPARE(a.lightOffset, 0);
+    CORRADE_COMPARE(a.lightCount, 0xffffffffu);
+
+    constexpr PhongDrawUniform ca;
+    CORRADE_COMPARE(ca.normalMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}}));
+    CORRADE_COMPARE(ca.materialId, 0);
+    CORRADE_COMPARE(ca.objectId, 0);
+    CORRADE_COMPARE(ca.lightOffset, 0);
+    CORRADE_COMPARE(ca.lightCount, 0xffffffffu);
+
+    /* Has to match the std140 array stride */
+    CORRADE_COMPARE(sizeof(PhongDrawUniform), 64);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PhongDrawUniform>::value);
+}
+
+void PhongTest::drawUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PhongDrawUniform a;
+    a.normalMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+    a.lightCount = 7;
+
+    new(&a) PhongDrawUniform{NoInit};
+    {
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.normalMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+        CORRADE_COMPARE(a.lightCount, 7);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongDrawUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PhongDrawUniform>::value);
+}
+
+void PhongTest::drawUniformSetters() {
+    PhongDrawUniform a;
+    a.setNormalMatrix(Matrix4::rotationX(90.0_degf).normalMatrix())
+     .setMaterialId(5)
+     .setObjectId(7)
+     .setLightOffsetCount(9, 10);
+    CORRADE_COMPARE(a.normalMatrix, (Matrix3x4{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f},
+        Vector4{0.0f, -1.0f, 0.0f, 0.0f}}));
+    CORRADE_COMPARE(a.materialId, 5);
+    CORRADE_COMPARE(a.objectId, 7);
+    CORRADE_COMPARE(a.lightOffset, 9);
+    CORRADE_COMPARE(a.lightCount, 10);
+}
+
+void PhongTest::materialUniformConstructDefault() {
+    PhongMaterialUniform a;
+    CORRADE_COMPARE(a.ambientColor, 0x00000000_rgbaf);
+    CORRADE_COMPARE(a.diffuseColor, 0xffffffff_rgbaf);
+    CORRADE_COMPARE(a.specularColor, 0xffffff00_rgbaf);
+    CORRADE_COMPARE(a.normalTextureScale, 1.0f);
+    CORRADE_COMPARE(a.shininess, 80.0f);
+    CORRADE_COMPARE(a.alphaMask, 0.5f);
+
+    constexpr PhongMaterialUniform ca;
+    CORRADE_COMPARE(ca.ambientColor, 0x00000000_rgbaf);
+    CORRADE_COMPARE(ca.diffuseColor, 0xffffffff_rgbaf);
+    CORRADE_COMPARE(ca.specularColor, 0xffffff00_rgbaf);
+    CORRADE_COMPARE(ca.normalTextureScale, 1.0f);
+    CORRADE_COMPARE(ca.shininess, 80.0f);
+    CORRADE_COMPARE(ca.alphaMask, 0.5f);
+
+    /* Has to match the std140 array stride */
+    CORRADE_COMPARE(sizeof(PhongMaterialUniform), 64);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PhongMaterialUniform>::value);
+}
+
+void PhongTest::materialUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PhongMaterialUniform a;
+    a.diffuseColor = 0x354565fc_rgbaf;
+    a.shininess = 100.0f;
+
+    new(&a) PhongMaterialUniform{NoInit};
+    {
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.diffuseColor, 0x354565fc_rgbaf);
+        CORRADE_COMPARE(a.shininess, 100.0f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongMaterialUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PhongMaterialUniform>::value);
+}
+
+void PhongTest::materialUniformSetters() {
+    PhongMaterialUniform a;
+    a.setAmbientColor(0x111111ff_rgbaf)
+     .setDiffuseColor(0x222222ff_rgbaf)
+     .setSpecularColor(0x333333ff_rgbaf)
+     .setNormalTextureScale(0.5f)
+     .setShininess(100.0f)
+     .setAlphaMask(0.7f);
+    CORRADE_COMPARE(a.ambientColor, 0x111111ff_rgbaf);
+    CORRADE_COMPARE(a.diffuseColor, 0x222222ff_rgbaf);
+    CORRADE_COMPARE(a.specularColor, 0x333333ff_rgbaf);
+    CORRADE_COMPARE(a.normalTextureScale, 0.5f);
+    CORRADE_COMPARE(a.shininess, 100.0f);
+    CORRADE_COMPARE(a.alphaMask, 0.7f);
+}
+
+void PhongTest::lightUniformConstructDefault() {
+    PhongLightUniform a;
+    CORRADE_COMPARE(a.position, (Vector4{0.0f, 0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(a.color, 0xffffff_rgbf);
+    CORRADE_COMPARE(a.specularColor, 0xffffff_rgbf);
+    CORRADE_COMPARE(a.range, Constants::inf());
+
+    constexpr PhongLightUniform ca;
+    CORRADE_COMPARE(ca.position, (Vector4{0.0f, 0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(ca.color, 0xffffff_rgbf);
+    CORRADE_COMPARE(ca.specularColor, 0xffffff_rgbf);
+    CORRADE_COMPARE(ca.range, Constants::inf());
+
+    /* Has to match the std140 array stride, with the vec3 members aligned to
+       16 bytes */
+    CORRADE_COMPARE(sizeof(PhongLightUniform), 48);
+    CORRADE_COMPARE(offsetof(PhongLightUniform, specularColor), 32);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PhongLightUniform>::value);
+}
+
+void PhongTest::lightUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PhongLightUniform a;
+    a.position = {1.5f, 0.3f, 3.1f, 1.0f};
+    a.range = 25.0f;
+
+    new(&a) PhongLightUniform{NoInit};
+    {
+        #if defined(CORRADE_TARGET_GCC) && !defined(CORRADE_TARGET_CLANG) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.position, (Vector4{1.5f, 0.3f, 3.1f, 1.0f}));
+        CORRADE_COMPARE(a.range, 25.0f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongLightUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PhongLightUniform>::value);
+}
+
+void PhongTest::lightUniformSetters() {
+    PhongLightUniform a;
+    a.setPosition({1.5f, 0.3f, 3.1f, 1.0f})
+     .setColor(0x354565_rgbf)
+     .setSpecularColor(0xccaa00_rgbf)
+     .setRange(25.0f);
+    CORRADE_COMPARE(a.position, (Vector4{1.5f, 0.3f, 3.1f, 1.0f}));
+    CORRADE_COMPARE(a.color, 0x354565_rgbf);
+    CORRADE_COMPARE(a.specularColor, 0xccaa00_rgbf);
+    CORRADE_COMPARE(a.range, 25.0f);
+}
+#endif
+
 void PhongTest::debugFlag() {
     std::ostringstream out;
 
@@ -92,9 +300,21 @@ void PhongTest::debugFlagsSupersets() {
 
     /* InstancedTextureOffset is a superset of TextureTransformation so only
        one should be printed */
-    std::ostringstream out;
-    Debug{&out} << (Phong::Flag::InstancedTextureOffset|Phong::Flag::TextureTransformation);
-    CORRADE_COMPARE(out.str(), "Shaders::Phong::Flag::InstancedTextureOffset\n");
+    {
+        std::ostringstream out;
+        Debug{&out} << (Phong::Flag::InstancedTextureOffset|Phong::Flag::TextureTransformation);
+        CORRADE_COMPARE(out.str(), "Shaders::Phong::Flag::InstancedTextureOffset\n");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* MultiDraw is a superset of UniformBuffers so only one should be
+       printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (Phong::Flag::MultiDraw|Phong::Flag::UniformBuffers);
+        CORRADE_COMPARE(out.str(), "Shaders::Phong::Flag::MultiDraw\n");
+    }
+    #endif
 }
 
 }}}}
@@ -40,7 +40,7 @@
 
 namespace Magnum { namespace Shaders {
 
-template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags): _flags{flags} {
+template<UnsignedInt dimensions> typename Vector<dimensions>::CompileState Vector<dimensions>::compile(const Flags flags) {
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -64,9 +64,18 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags):
     frag.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Vector.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    Vector<dimensions> out{NoInit};
+    out._flags = flags;
 
-    GL::AbstractShaderProgram::attachShaders({vert,  frag});
+    /* If the program binary is in the cache, compilation and linking can be
+       skipped */
+    if(out.loadBinary({vert, frag}))
+        return CompileState{std::move(out), GL::Shader{NoCreate}, GL::Shader{NoCreate}, version};
+
+    vert.submitCompile();
+    frag.submitCompile();
+
+    out.attachShaders({vert,  frag});
 
     /* ES3 has this done in the shader directly */
     #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
@@ -74,19 +83,39 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags):
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
     #endif
     {
-        GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
-        GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+        out.bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
+        out.bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
     }
     #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::AbstractShaderProgram::link());
+    out.submitLink();
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version};
+}
+
+template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags): Vector{compile(flags)} {}
+
+template<UnsignedInt dimensions> Vector<dimensions>::Vector(CompileState&& state): Vector{static_cast<Vector<dimensions>&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting so it doesn't crash on uniform queries
+       below. */
+    if(!GL::AbstractShaderProgram::id()) return;
+    #endif
+
+    /* The shaders weren't compiled if the program was loaded from a binary
+       cache */
+    if(state._vert.id())
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile());
+    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::AbstractShaderProgram::checkLink());
 
     #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = state._version;
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
         _transformationProjectionMatrixUniform = GL::AbstractShaderProgram::uniformLocation("transformationProjectionMatrix");
-        if(flags & Flag::TextureTransformation)
+        if(_flags & Flag::TextureTransformation)
             _textureMatrixUniform = GL::AbstractShaderProgram::uniformLocation("textureMatrix");
         _backgroundColorUniform = GL::AbstractShaderProgram::uniformLocation("backgroundColor");
         _colorUniform = GL::AbstractShaderProgram::uniformLocation("color");
@@ -102,7 +131,7 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags):
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
     setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
-    if(flags & Flag::TextureTransformation)
+    if(_flags & Flag::TextureTransformation)
         setTextureMatrix(Matrix3{Math::IdentityInit});
     setColor(Color4{1.0f}); /* Background color is zero by default */
     #endif
@@ -30,6 +30,7 @@
  */
 
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/GL/Shader.h"
 #include "Magnum/Shaders/AbstractVector.h"
 #include "Magnum/Shaders/visibility.h"
 
@@ -105,12 +106,35 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
         typedef Implementation::VectorFlags Flags;
         #endif
 
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref Vector(Flags) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref Vector(CompileState&&)
+         */
+        static CompileState compile(Flags flags = {});
+
         /**
          * @brief Constructor
          * @param flags     Flags
          */
         explicit Vector(Flags flags = {});
 
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit Vector(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -194,6 +218,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
         #endif
 
     private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit Vector(NoInitT) {}
+
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
         using GL::AbstractShaderProgram::drawTransformFeedback;
@@ -209,6 +237,25 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
             _colorUniform{3};
 };
 
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref Vector::compile(). See @ref shaders-async for
+more information.
+*/
+template<UnsignedInt dimensions> class Vector<dimensions>::CompileState: public Vector<dimensions> {
+    /* Everything deliberately private except for the inheritance */
+    friend Vector<dimensions>;
+
+    explicit CompileState(NoCreateT): Vector<dimensions>{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(Vector<dimensions>&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version): Vector<dimensions>{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version} {}
+
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+};
+
 /** @brief Two-dimensional vector shader */
 typedef Vector<2> Vector2D;
 
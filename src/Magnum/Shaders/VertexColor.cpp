@@ -39,7 +39,7 @@
 
 namespace Magnum { namespace Shaders {
 
-template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor() {
+template<UnsignedInt dimensions> typename VertexColor<dimensions>::CompileState VertexColor<dimensions>::compile() {
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -62,9 +62,17 @@ template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor() {
     frag.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("VertexColor.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    VertexColor<dimensions> out{NoInit};
 
-    attachShaders({vert, frag});
+    /* If the program binary is in the cache, compilation and linking can be
+       skipped */
+    if(out.loadBinary({vert, frag}))
+        return CompileState{std::move(out), GL::Shader{NoCreate}, GL::Shader{NoCreate}, version};
+
+    vert.submitCompile();
+    frag.submitCompile();
+
+    out.attachShaders({vert, frag});
 
     /* ES3 has this done in the shader directly */
     #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
@@ -72,14 +80,34 @@ template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor() {
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
     #endif
     {
-        bindAttributeLocation(Position::Location, "position");
-        bindAttributeLocation(Color3::Location, "color"); /* Color4 is the same */
+        out.bindAttributeLocation(Position::Location, "position");
+        out.bindAttributeLocation(Color3::Location, "color"); /* Color4 is the same */
     }
     #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    out.submitLink();
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version};
+}
+
+template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor(): VertexColor{compile()} {}
+
+template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor(CompileState&& state): VertexColor{static_cast<VertexColor<dimensions>&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a
+       NoCreate'd CompileState. Exiting so it doesn't crash on uniform queries
+       below. */
+    if(!id()) return;
+    #endif
+
+    /* The shaders weren't compiled if the program was loaded from a binary
+       cache */
+    if(state._vert.id())
+        CORRADE_INTERNAL_ASSERT_OUTPUT(state._vert.checkCompile() && state._frag.checkCompile());
+    CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
 
     #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = state._version;
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
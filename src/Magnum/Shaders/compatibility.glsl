@@ -36,6 +36,7 @@
     #extension GL_ARB_shading_language_420pack: enable
     #define RUNTIME_CONST
     #define EXPLICIT_TEXTURE_LAYER
+    #define EXPLICIT_BINDING
 #endif
 
 #if !defined(GL_ES) && defined(GL_ARB_explicit_uniform_location) && !defined(DISABLE_GL_ARB_explicit_uniform_location)
@@ -45,8 +46,8 @@
 
 #if defined(GL_ES) && __VERSION__ >= 300
     #define EXPLICIT_ATTRIB_LOCATION
-    /* EXPLICIT_TEXTURE_LAYER, EXPLICIT_UNIFORM_LOCATION and RUNTIME_CONST is not
-       available in OpenGL ES */
+    /* EXPLICIT_TEXTURE_LAYER, EXPLICIT_BINDING, EXPLICIT_UNIFORM_LOCATION and
+       RUNTIME_CONST is not available in OpenGL ES */
 #endif
 
 /* Precision qualifiers are not supported in GLSL 1.20 */
@@ -0,0 +1,250 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/AsyncResourceLoader.h"
+#include "Magnum/ResourceManager.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct AsyncResourceLoaderTest: TestSuite::Tester {
+    explicit AsyncResourceLoaderTest();
+
+    void construct();
+    void load();
+    void loadConcurrent();
+    void stop();
+
+    void notThreadSafe();
+    void loadStopped();
+    void destructNotStopped();
+};
+
+typedef Magnum::ResourceManager<Int> ResourceManager;
+
+AsyncResourceLoaderTest::AsyncResourceLoaderTest() {
+    addTests({&AsyncResourceLoaderTest::construct,
+              &AsyncResourceLoaderTest::load,
+              &AsyncResourceLoaderTest::loadConcurrent,
+              &AsyncResourceLoaderTest::stop,
+
+              &AsyncResourceLoaderTest::notThreadSafe,
+              &AsyncResourceLoaderTest::loadStopped,
+              &AsyncResourceLoaderTest::destructNotStopped});
+}
+
+/* Loads the key value as an integer, keys above 1000 are not found. Keys
+   equal to 1000 block until released. */
+class IntResourceLoader: public AsyncResourceLoader<Int> {
+    public:
+        explicit IntResourceLoader(UnsignedInt threadCount = 0): AsyncResourceLoader<Int>{threadCount} {}
+
+        ~IntResourceLoader() { stop(); }
+
+        std::atomic<bool> started{false}, released{true};
+
+    private:
+        void doLoadAsync(ResourceKey key) override {
+            const std::size_t value = *reinterpret_cast<const std::size_t*>(key.byteArray());
+            if(value == 1000) {
+                started = true;
+                while(!released) std::this_thread::yield();
+            }
+
+            if(value > 1000) setNotFound(key);
+            else set(key, Int(value));
+        }
+};
+
+void AsyncResourceLoaderTest::construct() {
+    IntResourceLoader a{3};
+    CORRADE_COMPARE(a.threadCount(), 3);
+    CORRADE_COMPARE(a.pendingCount(), 0);
+
+    IntResourceLoader b;
+    CORRADE_VERIFY(b.threadCount() >= 1);
+}
+
+void AsyncResourceLoaderTest::load() {
+    ResourceManager rm{ResourceManagerFlag::ThreadSafe};
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit, 2u};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> resources[100];
+    for(std::size_t i = 0; i != 99; ++i)
+        resources[i] = rm.get<Int>(ResourceKey(i));
+    resources[99] = rm.get<Int>(ResourceKey(std::size_t(1337)));
+    CORRADE_COMPARE(loader.requestedCount(), 100);
+
+    /* Getting already requested resources again doesn't request them
+       again */
+    Resource<Int> again = rm.get<Int>(ResourceKey(std::size_t(5)));
+    CORRADE_COMPARE(loader.requestedCount(), 100);
+
+    loader.wait();
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(loader.loadedCount(), 99);
+    CORRADE_COMPARE(loader.notFoundCount(), 1);
+
+    for(std::size_t i = 0; i != 99; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(resources[i].state(), ResourceState::Final);
+        CORRADE_COMPARE(*resources[i], Int(i));
+    }
+    CORRADE_COMPARE(resources[99].state(), ResourceState::NotFound);
+    CORRADE_COMPARE(*again, 5);
+}
+
+void AsyncResourceLoaderTest::loadConcurrent() {
+    ResourceManager rm{ResourceManagerFlag::ThreadSafe};
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit, 2u};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    /* Multiple threads requesting the same resources should result in each
+       being loaded just once */
+    std::thread threads[4];
+    std::size_t failed[4]{};
+    for(std::size_t t = 0; t != 4; ++t) threads[t] = std::thread{[&rm, &failed, t]{
+        for(std::size_t i = 0; i != 1000; ++i) {
+            Resource<Int> a = rm.get<Int>(ResourceKey((i + t*7) % 200));
+            const ResourceState state = a.state();
+            if(state != ResourceState::Loading && state != ResourceState::Final)
+                ++failed[t];
+            if(state == ResourceState::Final && *a != Int((i + t*7) % 200))
+                ++failed[t];
+        }
+    }};
+    for(std::thread& thread: threads) thread.join();
+
+    for(std::size_t t = 0; t != 4; ++t) {
+        CORRADE_ITERATION(t);
+        CORRADE_COMPARE(failed[t], 0);
+    }
+
+    loader.wait();
+    CORRADE_COMPARE(loader.requestedCount(), 200);
+    CORRADE_COMPARE(loader.loadedCount(), 200);
+    CORRADE_COMPARE(rm.count<Int>(), 200);
+}
+
+void AsyncResourceLoaderTest::stop() {
+    ResourceManager rm{ResourceManagerFlag::ThreadSafe};
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit, 1u};
+    IntResourceLoader& loader = *loaderPtr;
+    loader.released = false;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    /* The first blocks the only worker, the second stays in the queue */
+    Resource<Int> a = rm.get<Int>(ResourceKey(std::size_t(1000)));
+    Resource<Int> b = rm.get<Int>(ResourceKey(std::size_t(3)));
+    while(!loader.started) std::this_thread::yield();
+    CORRADE_COMPARE(loader.pendingCount(), 2);
+
+    /* Stopping waits for the in-progress request to finish and marks the
+       queued one as not found */
+    std::thread stopping{[&loader]{ loader.stop(); }};
+    while(loader.pendingCount() != 1) std::this_thread::yield();
+    loader.released = true;
+    stopping.join();
+
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    CORRADE_COMPARE(*a, 1000);
+    CORRADE_COMPARE(b.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader.loadedCount(), 1);
+    CORRADE_COMPARE(loader.notFoundCount(), 1);
+
+    /* Stopping again and waiting does nothing */
+    loader.stop();
+    loader.wait();
+}
+
+void AsyncResourceLoaderTest::notThreadSafe() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    ResourceManager rm;
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit, 1u};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Resource<Int> a = rm.get<Int>(ResourceKey(std::size_t(3)));
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(out.str(), "AsyncResourceLoader: the manager has to be constructed with ResourceManagerFlag::ThreadSafe\n");
+}
+
+void AsyncResourceLoaderTest::loadStopped() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    ResourceManager rm{ResourceManagerFlag::ThreadSafe};
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit, 1u};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+    loader.stop();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ResourceKey key{std::size_t(3)};
+    Resource<Int> a = rm.get<Int>(key);
+    CORRADE_COMPARE(a.state(), ResourceState::Loading);
+    CORRADE_COMPARE(out.str(), Utility::formatString("AsyncResourceLoader: can't load ResourceKey(0x{}) as the loader is stopped\n", key.hexString()));
+}
+
+void AsyncResourceLoaderTest::destructNotStopped() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    class Loader: public AsyncResourceLoader<Int> {
+        public:
+            explicit Loader(): AsyncResourceLoader<Int>{1} {}
+
+        private:
+            void doLoadAsync(ResourceKey) override {}
+    };
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        Loader loader;
+    }
+    CORRADE_COMPARE(out.str(), "AsyncResourceLoader: stop() has to be called from the subclass destructor\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::AsyncResourceLoaderTest)
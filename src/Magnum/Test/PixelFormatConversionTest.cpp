@@ -0,0 +1,342 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/PixelFormatConversion.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Half.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct PixelFormatConversionTest: TestSuite::Tester {
+    explicit PixelFormatConversionTest();
+
+    void supported();
+
+    void copy();
+    void addChannels();
+    void removeChannels();
+    void addChannelsFloat();
+    void unormToFloat();
+    void floatToUnorm();
+    void floatToHalf();
+    void snormToUnorm();
+    void srgbToFloat();
+    void floatToSrgb();
+    void srgbToUnorm();
+
+    void allocate1D();
+    void allocate3D();
+    void allocateImplementationSpecific();
+
+    void sizeMismatch();
+    void unsupported();
+};
+
+PixelFormatConversionTest::PixelFormatConversionTest() {
+    addTests({&PixelFormatConversionTest::supported,
+
+              &PixelFormatConversionTest::copy,
+              &PixelFormatConversionTest::addChannels,
+              &PixelFormatConversionTest::removeChannels,
+              &PixelFormatConversionTest::addChannelsFloat,
+              &PixelFormatConversionTest::unormToFloat,
+              &PixelFormatConversionTest::floatToUnorm,
+              &PixelFormatConversionTest::floatToHalf,
+              &PixelFormatConversionTest::snormToUnorm,
+              &PixelFormatConversionTest::srgbToFloat,
+              &PixelFormatConversionTest::floatToSrgb,
+              &PixelFormatConversionTest::srgbToUnorm,
+
+              &PixelFormatConversionTest::allocate1D,
+              &PixelFormatConversionTest::allocate3D,
+              &PixelFormatConversionTest::allocateImplementationSpecific,
+
+              &PixelFormatConversionTest::sizeMismatch,
+              &PixelFormatConversionTest::unsupported});
+}
+
+void PixelFormatConversionTest::supported() {
+    CORRADE_VERIFY(isPixelFormatConversionSupported(PixelFormat::RGB8Unorm, PixelFormat::RGBA8Unorm));
+    CORRADE_VERIFY(isPixelFormatConversionSupported(PixelFormat::RGBA8Srgb, PixelFormat::RGBA16F));
+    CORRADE_VERIFY(isPixelFormatConversionSupported(PixelFormat::R32F, PixelFormat::R8Unorm));
+    CORRADE_VERIFY(isPixelFormatConversionSupported(PixelFormat::RG16Snorm, PixelFormat::RGB8Snorm));
+
+    /* Same formats are always supported */
+    CORRADE_VERIFY(isPixelFormatConversionSupported(PixelFormat::RGBA8UI, PixelFormat::RGBA8UI));
+    CORRADE_VERIFY(isPixelFormatConversionSupported(PixelFormat::RG32I, PixelFormat::RG32I));
+    CORRADE_VERIFY(isPixelFormatConversionSupported(pixelFormatWrap(0xdead), pixelFormatWrap(0xdead)));
+
+    CORRADE_VERIFY(!isPixelFormatConversionSupported(PixelFormat::RGBA8UI, PixelFormat::RGBA8Unorm));
+    CORRADE_VERIFY(!isPixelFormatConversionSupported(PixelFormat::R32F, PixelFormat::R32I));
+    CORRADE_VERIFY(!isPixelFormatConversionSupported(pixelFormatWrap(0xdead), PixelFormat::RGBA8Unorm));
+}
+
+void PixelFormatConversionTest::copy() {
+    /* Source with one pixel skipped and four-byte row alignment, destination
+       tightly packed */
+    const char source[]{
+        0, 0, 0, 1, 2, 3, 4, 5, 6, 0, 0, 0,
+        0, 0, 0, 7, 8, 9, 10, 11, 12, 0, 0, 0
+    };
+    char destination[12];
+
+    convertPixelFormatInto(
+        ImageView2D{PixelStorage{}.setSkip({1, 0, 0}).setRowLength(4), PixelFormat::RGB8Unorm, {2, 2}, source},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, destination});
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<char>({
+        1, 2, 3, 4, 5, 6,
+        7, 8, 9, 10, 11, 12
+    }), TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::addChannels() {
+    const Color3ub source[]{
+        {1, 2, 3}, {4, 5, 6},
+        {7, 8, 9}, {10, 11, 12}
+    };
+    Color4ub destination[4];
+
+    convertPixelFormatInto(
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, source},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, destination});
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Color4ub>({
+        {1, 2, 3, 255}, {4, 5, 6, 255},
+        {7, 8, 9, 255}, {10, 11, 12, 255}
+    }), TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::removeChannels() {
+    const Color4ub source[]{
+        {1, 2, 3, 4}, {5, 6, 7, 8}
+    };
+    Vector2ub destination[2];
+
+    /* sRGB to sRGB is not converted to linear in between */
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, source},
+        MutableImageView2D{PixelFormat::RG8Srgb, {2, 1}, destination});
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Vector2ub>({
+        {1, 2}, {5, 6}
+    }), TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::addChannelsFloat() {
+    const Float source[]{0.5f, -2.0f};
+    Vector4 destination[2];
+
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::R32F, {1, 2}, source},
+        MutableImageView2D{PixelFormat::RGBA32F, {1, 2}, destination});
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Vector4>({
+        {0.5f, 0.0f, 0.0f, 1.0f},
+        {-2.0f, 0.0f, 0.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::unormToFloat() {
+    const Vector2us source[]{
+        {0, 65535}, {32768, 13107}
+    };
+    Vector3 destination[2];
+
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RG16Unorm, {2, 1}, source},
+        MutableImageView2D{PixelFormat::RGB32F, {2, 1}, destination});
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Vector3>({
+        {0.0f, 1.0f, 0.0f}, {0.500008f, 0.2f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::floatToUnorm() {
+    /* Out-of-range values get clamped */
+    const Float source[]{-0.5f, 0.25f, 1.5f, 1.0f};
+    UnsignedByte destination[4];
+
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::R32F, {4, 1}, source},
+        MutableImageView2D{PixelFormat::R8Unorm, {4, 1}, destination});
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<UnsignedByte>({
+        0, 64, 255, 255
+    }), TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::floatToHalf() {
+    const Vector2 source[]{
+        {0.5f, -2.0f}
+    };
+    Vector4h destination[1];
+
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RG32F, {1, 1}, source},
+        MutableImageView2D{PixelFormat::RGBA16F, {1, 1}, destination});
+    CORRADE_COMPARE(Vector4{destination[0]}, (Vector4{0.5f, -2.0f, 0.0f, 1.0f}));
+}
+
+void PixelFormatConversionTest::snormToUnorm() {
+    const Vector2b source[]{
+        {-127, 127}, {0, 64}
+    };
+    Vector2ub destination[2];
+
+    /* Negative values get clamped to zero */
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RG8Snorm, {2, 1}, source},
+        MutableImageView2D{PixelFormat::RG8Unorm, {2, 1}, destination});
+    CORRADE_COMPARE_AS(Containers::arrayView(destination), Containers::arrayView<Vector2ub>({
+        {0, 255}, {0, 129}
+    }), TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::srgbToFloat() {
+    const Color4ub source[]{
+        {188, 0, 255, 128}
+    };
+    Vector4 destination[1];
+
+    /* Alpha is linear */
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8Srgb, {1, 1}, source},
+        MutableImageView2D{PixelFormat::RGBA32F, {1, 1}, destination});
+    CORRADE_COMPARE(destination[0], (Vector4{0.502886f, 0.0f, 1.0f, 0.501961f}));
+}
+
+void PixelFormatConversionTest::floatToSrgb() {
+    const Vector4 source[]{
+        {0.5f, 0.0f, 1.0f, 0.5f}
+    };
+    Color4ub destination[1];
+
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA32F, {1, 1}, source},
+        MutableImageView2D{PixelFormat::RGBA8Srgb, {1, 1}, destination});
+    CORRADE_COMPARE(destination[0], (Color4ub{188, 0, 255, 128}));
+}
+
+void PixelFormatConversionTest::srgbToUnorm() {
+    const Color3ub source[]{
+        {188, 0, 255}, {0, 0, 0}
+    };
+    Color3ub destination[2];
+
+    convertPixelFormatInto(
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Srgb, {2, 1}, source},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 1}, destination});
+    CORRADE_COMPARE(destination[0], (Color3ub{128, 0, 255}));
+}
+
+void PixelFormatConversionTest::allocate1D() {
+    const Vector2ub source[]{
+        {10, 20}, {30, 40}, {50, 60}
+    };
+
+    Image1D image = convertPixelFormat(ImageView1D{PixelStorage{}.setAlignment(1), PixelFormat::RG8Unorm, 3, source}, PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image.format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image.size(), 3);
+    CORRADE_COMPARE(image.storage().alignment(), 4);
+    CORRADE_COMPARE(image.data().size(), 12);
+    CORRADE_COMPARE_AS(image.pixels<Color3ub>(), Containers::arrayView<Color3ub>({
+        {10, 20, 0}, {30, 40, 0}, {50, 60, 0}
+    }), TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::allocate3D() {
+    const Float source[]{
+        0.0f, 1.0f,
+        0.5f, 0.25f
+    };
+
+    /* Two slices of 1x2 pixels, with rows padded to four bytes in the output */
+    Image3D image = convertPixelFormat(ImageView3D{PixelFormat::R32F, {1, 2, 2}, source}, PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image.format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image.size(), (Vector3i{1, 2, 2}));
+    CORRADE_COMPARE(image.data().size(), 16);
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[0][0][0], 0);
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[0][1][0], 255);
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[1][0][0], 128);
+    CORRADE_COMPARE(image.pixels<UnsignedByte>()[1][1][0], 64);
+}
+
+void PixelFormatConversionTest::allocateImplementationSpecific() {
+    const char source[]{1, 2, 3, 4, 5, 6, 0, 0};
+
+    /* The format is just copied, including the extra format and pixel size */
+    Image2D image = convertPixelFormat(ImageView2D{PixelStorage{}, 0xdead, 0xbeef, 3, {2, 1}, source}, pixelFormatWrap(0xdead));
+    CORRADE_COMPARE(image.format(), pixelFormatWrap(0xdead));
+    CORRADE_COMPARE(image.formatExtra(), 0xbeef);
+    CORRADE_COMPARE(image.pixelSize(), 3);
+    CORRADE_COMPARE_AS(image.data().prefix(6), Containers::arrayView<char>({
+        1, 2, 3, 4, 5, 6
+    }), TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::sizeMismatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char source[16]{};
+    char destination[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, source},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, destination});
+    CORRADE_COMPARE(out.str(), "convertPixelFormatInto(): expected destination size Vector(2, 2) but got Vector(2, 1)\n");
+}
+
+void PixelFormatConversionTest::unsupported() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char source[16]{};
+    char destination[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8UI, {2, 2}, source},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, destination});
+    convertPixelFormat(ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, source}, PixelFormat::RG16I);
+    CORRADE_COMPARE(out.str(),
+        "convertPixelFormatInto(): conversion from PixelFormat::RGBA8UI to PixelFormat::RGBA8Unorm is not supported\n"
+        "convertPixelFormat(): conversion from PixelFormat::RGBA8Unorm to PixelFormat::RG16I is not supported\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::PixelFormatConversionTest)
@@ -25,6 +25,7 @@
 */
 
 #include <sstream>
+#include <thread>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/FormatStl.h>
 
@@ -50,6 +51,7 @@ struct ResourceManagerTest: TestSuite::Tester {
     void residentPolicy();
     void referenceCountedPolicy();
     void manualPolicy();
+    void cachedPolicy();
     void defaults();
     void clear();
     void clearWhileReferenced();
@@ -57,8 +59,17 @@ struct ResourceManagerTest: TestSuite::Tester {
     void loader();
     void loaderSetNullptr();
 
+    void budget();
+    void budgetGlobal();
+    void budgetLoader();
+
+    void threadSafe();
+    void threadSafeConcurrentAccess();
+
     void debugResourceState();
     void debugResourceKey();
+    void debugFlag();
+    void debugFlags();
 };
 
 struct Data {
@@ -87,6 +98,7 @@ ResourceManagerTest::ResourceManagerTest() {
               &ResourceManagerTest::residentPolicy,
               &ResourceManagerTest::referenceCountedPolicy,
               &ResourceManagerTest::manualPolicy,
+              &ResourceManagerTest::cachedPolicy,
               &ResourceManagerTest::defaults,
               &ResourceManagerTest::clear,
               &ResourceManagerTest::clearWhileReferenced,
@@ -94,8 +106,17 @@ ResourceManagerTest::ResourceManagerTest() {
               &ResourceManagerTest::loader,
               &ResourceManagerTest::loaderSetNullptr,
 
+              &ResourceManagerTest::budget,
+              &ResourceManagerTest::budgetGlobal,
+              &ResourceManagerTest::budgetLoader,
+
+              &ResourceManagerTest::threadSafe,
+              &ResourceManagerTest::threadSafeConcurrentAccess,
+
               &ResourceManagerTest::debugResourceState,
-              &ResourceManagerTest::debugResourceKey});
+              &ResourceManagerTest::debugResourceKey,
+              &ResourceManagerTest::debugFlag,
+              &ResourceManagerTest::debugFlags});
 }
 
 void ResourceManagerTest::constructResource() {
@@ -369,6 +390,33 @@ void ResourceManagerTest::referenceCountedPolicy() {
     CORRADE_COMPARE(rm.referenceCount<Data>(dataRefCountKey), 0);
 }
 
+void ResourceManagerTest::cachedPolicy() {
+    ResourceManager rm;
+
+    ResourceKey dataKey("data");
+
+    /* Without a budget the resource stays loaded after all references are
+       removed */
+    rm.set(dataKey, Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Cached, 16);
+    {
+        Resource<Data> data = rm.get<Data>(dataKey);
+        CORRADE_COMPARE(data.state(), ResourceState::Final);
+        CORRADE_COMPARE(rm.memoryUsage<Data>(), 16);
+    }
+
+    CORRADE_COMPARE(rm.count<Data>(), 1);
+    CORRADE_COMPARE(Data::count, 1);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 16);
+    CORRADE_COMPARE(rm.memoryUsage(), 16);
+
+    /* But it's freed like a manually managed resource */
+    rm.free();
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(Data::count, 0);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 0);
+    CORRADE_COMPARE(rm.memoryUsage(), 0);
+}
+
 void ResourceManagerTest::manualPolicy() {
     ResourceManager rm;
 
@@ -430,6 +478,9 @@ void ResourceManagerTest::clearWhileReferenced() {
 
     rm.clear();
     CORRADE_COMPARE(out.str(), "ResourceManager: cleared/destroyed while data are still referenced\n");
+
+    /* The resource points directly to the entry, so it has to stay */
+    CORRADE_COMPARE(rm.count<Int>(), 1);
 }
 
 void ResourceManagerTest::loader() {
@@ -536,6 +587,196 @@ void ResourceManagerTest::loaderSetNullptr() {
     CORRADE_COMPARE(*world, 42);
 }
 
+void ResourceManagerTest::budget() {
+    ResourceManager rm;
+    CORRADE_COMPARE(rm.budget<Int>(), ~std::size_t{});
+    CORRADE_COMPARE(rm.budget(), ~std::size_t{});
+
+    rm.set("a", 1, ResourceDataState::Final, ResourcePolicy::Cached, 100);
+    rm.set("b", 2, ResourceDataState::Final, ResourcePolicy::Cached, 100);
+    rm.set("c", 3, ResourceDataState::Final, ResourcePolicy::Cached, 100);
+    rm.set("resident", 4, ResourceDataState::Final, ResourcePolicy::Resident, 50);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 350);
+
+    {
+        /* Referenced resources are not unloaded, the least recently set one
+           goes first */
+        Resource<Int> a = rm.get<Int>("a");
+        rm.setBudget<Int>(250);
+        CORRADE_COMPARE(rm.budget<Int>(), 250);
+        CORRADE_COMPARE(rm.memoryUsage<Int>(), 250);
+        CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::Final);
+        CORRADE_COMPARE(rm.state<Int>("b"), ResourceState::NotLoaded);
+        CORRADE_COMPARE(rm.state<Int>("c"), ResourceState::Final);
+    }
+
+    /* Releasing the last reference makes it the most recently used one, so
+       c goes before a */
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 250);
+    rm.set("d", 5, ResourceDataState::Final, ResourcePolicy::Cached, 100);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 250);
+    CORRADE_COMPARE(rm.count<Int>(), 3);
+    CORRADE_COMPARE(rm.state<Int>("c"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::Final);
+    CORRADE_COMPARE(rm.state<Int>("d"), ResourceState::Final);
+
+    /* Resident resources are counted but never unloaded */
+    rm.setBudget<Int>(0);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 50);
+    CORRADE_COMPARE(rm.count<Int>(), 1);
+    CORRADE_COMPARE(rm.state<Int>("resident"), ResourceState::Final);
+
+    /* Other types are not affected by the budget */
+    rm.set("data", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Cached, 100);
+    CORRADE_COMPARE(rm.count<Data>(), 1);
+    CORRADE_COMPARE(rm.memoryUsage(), 150);
+
+    rm.clear();
+    CORRADE_COMPARE(rm.memoryUsage(), 0);
+    CORRADE_COMPARE(Data::count, 0);
+}
+
+void ResourceManagerTest::budgetGlobal() {
+    ResourceManager rm;
+
+    rm.set("data", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::Cached, 30);
+    rm.set("a", 1, ResourceDataState::Mutable, ResourcePolicy::Cached, 100);
+    rm.set("b", 2, ResourceDataState::Final, ResourcePolicy::Cached, 100);
+    {
+        Resource<Int> a = rm.get<Int>("a");
+    }
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 200);
+    CORRADE_COMPARE(rm.memoryUsage<Data>(), 30);
+    CORRADE_COMPARE(rm.memoryUsage(), 230);
+
+    /* The least recently used resources are unloaded regardless of type */
+    rm.setBudget(150);
+    CORRADE_COMPARE(rm.budget(), 150);
+    CORRADE_COMPARE(rm.budget<Int>(), ~std::size_t{});
+    CORRADE_COMPARE(rm.memoryUsage(), 100);
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(Data::count, 0);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::Mutable);
+    CORRADE_COMPARE(rm.state<Int>("b"), ResourceState::NotLoaded);
+
+    /* Updating the size of a mutable resource is reflected in the usage */
+    rm.set("a", 7, ResourceDataState::Final, ResourcePolicy::Cached, 10);
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 10);
+    CORRADE_COMPARE(rm.memoryUsage(), 10);
+}
+
+void ResourceManagerTest::budgetLoader() {
+    class IntResourceLoader: public AbstractResourceLoader<Int> {
+        void doLoad(ResourceKey key) override {
+            set(key, 42, ResourceDataState::Final, ResourcePolicy::Cached, 100);
+        }
+    };
+
+    ResourceManager rm;
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+    rm.setBudget<Int>(150);
+
+    {
+        Resource<Int> a = rm.get<Int>("a");
+        Resource<Int> b = rm.get<Int>("b");
+        CORRADE_COMPARE(*a, 42);
+        CORRADE_COMPARE(*b, 42);
+        CORRADE_COMPARE(rm.memoryUsage<Int>(), 200);
+    }
+
+    /* b was released first, so it got unloaded as soon as it was unused */
+    CORRADE_COMPARE(rm.memoryUsage<Int>(), 100);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::Final);
+    CORRADE_COMPARE(rm.state<Int>("b"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(loader.requestedCount(), 2);
+
+    /* Getting a cached resource doesn't load it again, an unloaded one is
+       requested from the loader */
+    Resource<Int> a = rm.get<Int>("a");
+    CORRADE_COMPARE(loader.requestedCount(), 2);
+    Resource<Int> b = rm.get<Int>("b");
+    CORRADE_COMPARE(b.state(), ResourceState::Final);
+    CORRADE_COMPARE(*b, 42);
+    CORRADE_COMPARE(loader.requestedCount(), 3);
+    CORRADE_COMPARE(loader.loadedCount(), 3);
+}
+
+void ResourceManagerTest::threadSafe() {
+    ResourceManager rm{ResourceManagerFlag::ThreadSafe};
+    CORRADE_COMPARE(rm.flags(), ResourceManagerFlag::ThreadSafe);
+
+    /* Enough resources to be spread across all shards */
+    for(Int i = 0; i != 100; ++i)
+        rm.set(ResourceKey(std::size_t(i)), i, ResourceDataState::Final, ResourcePolicy::Manual);
+    rm.set("data", Containers::pointer<Data>(), ResourceDataState::Final, ResourcePolicy::ReferenceCounted);
+    CORRADE_COMPARE(rm.count<Int>(), 100);
+    CORRADE_COMPARE(rm.count<Data>(), 1);
+
+    {
+        Resource<Int> a = rm.get<Int>(ResourceKey(std::size_t(37)));
+        Resource<Int> b = a;
+        CORRADE_COMPARE(rm.referenceCount<Int>(ResourceKey(std::size_t(37))), 2);
+        CORRADE_COMPARE(b.state(), ResourceState::Final);
+        CORRADE_COMPARE(*b, 37);
+
+        /* Referenced resources are not freed */
+        rm.free<Int>();
+        CORRADE_COMPARE(rm.count<Int>(), 1);
+        CORRADE_COMPARE(*a, 37);
+
+        Resource<Data> data = rm.get<Data>("data");
+        CORRADE_COMPARE(data.state(), ResourceState::Final);
+        CORRADE_COMPARE(Data::count, 1);
+    }
+
+    /* Reference-counted resources are freed when the last reference is
+       gone */
+    CORRADE_COMPARE(rm.referenceCount<Int>(ResourceKey(std::size_t(37))), 0);
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(Data::count, 0);
+
+    rm.clear();
+    CORRADE_COMPARE(rm.count<Int>(), 0);
+}
+
+void ResourceManagerTest::threadSafeConcurrentAccess() {
+    ResourceManager rm{ResourceManagerFlag::ThreadSafe};
+    for(Int i = 0; i != 64; ++i)
+        rm.set(ResourceKey(std::size_t(i)), i);
+
+    /* Each thread repeatedly acquires and copies shared resources and
+       creates reference-counted resources of its own, which get freed again
+       right after */
+    std::thread threads[4];
+    std::size_t failed[4]{};
+    for(std::size_t t = 0; t != 4; ++t) threads[t] = std::thread{[&rm, &failed, t]{
+        for(std::size_t i = 0; i != 10000; ++i) {
+            const std::size_t id = (i*7 + t*13) % 64;
+            Resource<Int> a = rm.get<Int>(ResourceKey(id));
+            Resource<Int> b = a;
+            if(!b || *b != Int(id)) ++failed[t];
+
+            const ResourceKey own{std::size_t(1000 + t)};
+            rm.set(own, Int(i), ResourceDataState::Mutable, ResourcePolicy::ReferenceCounted);
+            Resource<Int> c = rm.get<Int>(own);
+            if(c.state() != ResourceState::Mutable || *c != Int(i)) ++failed[t];
+        }
+    }};
+    for(std::thread& thread: threads) thread.join();
+
+    for(std::size_t t = 0; t != 4; ++t) {
+        CORRADE_ITERATION(t);
+        CORRADE_COMPARE(failed[t], 0);
+    }
+    CORRADE_COMPARE(rm.count<Int>(), 64);
+    for(std::size_t i = 0; i != 64; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(rm.referenceCount<Int>(ResourceKey(i)), 0);
+    }
+}
+
 void ResourceManagerTest::debugResourceState() {
     std::ostringstream out;
     Debug{&out} << ResourceState::Loading << ResourceState(0xbe);
@@ -549,6 +790,18 @@ void ResourceManagerTest::debugResourceKey() {
     CORRADE_COMPARE(out.str(), Utility::formatString("ResourceKey(0x{})\n", hello.hexString()));
 }
 
+void ResourceManagerTest::debugFlag() {
+    std::ostringstream out;
+    Debug{&out} << ResourceManagerFlag::ThreadSafe << ResourceManagerFlag(0xbe);
+    CORRADE_COMPARE(out.str(), "ResourceManagerFlag::ThreadSafe ResourceManagerFlag(0xbe)\n");
+}
+
+void ResourceManagerTest::debugFlags() {
+    std::ostringstream out;
+    Debug{&out} << (ResourceManagerFlag::ThreadSafe|ResourceManagerFlag(0xf0)) << ResourceManagerFlags{};
+    CORRADE_COMPARE(out.str(), "ResourceManagerFlag::ThreadSafe|ResourceManagerFlag(0xf0) ResourceManagerFlags{}\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Test::ResourceManagerTest)
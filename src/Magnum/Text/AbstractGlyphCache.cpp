@@ -41,6 +41,10 @@ AbstractGlyphCache::AbstractGlyphCache(const Vector2i& size, const Vector2i& pad
 AbstractGlyphCache::~AbstractGlyphCache() = default;
 
 std::vector<Range2Di> AbstractGlyphCache::reserve(const std::vector<Vector2i>& sizes) {
+    return doReserve(sizes);
+}
+
+std::vector<Range2Di> AbstractGlyphCache::doReserve(const std::vector<Vector2i>& sizes) {
     CORRADE_ASSERT((glyphs.size() == 1 && glyphs.at(0) == std::pair<Vector2i, Range2Di>()),
         "Text::AbstractGlyphCache::reserve(): reserving space in non-empty cache is not yet implemented", {});
     glyphs.reserve(glyphs.size() + sizes.size());
@@ -57,6 +61,15 @@ void AbstractGlyphCache::insert(const UnsignedInt glyph, const Vector2i& positio
     else CORRADE_INTERNAL_ASSERT_OUTPUT(glyphs.insert({glyph, glyphData}).second);
 }
 
+void AbstractGlyphCache::remove(const UnsignedInt glyph) {
+    CORRADE_ASSERT(glyph != 0,
+        "Text::AbstractGlyphCache::remove(): can't remove the default glyph", );
+    const auto found = glyphs.find(glyph);
+    CORRADE_ASSERT(found != glyphs.end(),
+        "Text::AbstractGlyphCache::remove(): glyph" << glyph << "not found", );
+    glyphs.erase(found);
+}
+
 void AbstractGlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
     CORRADE_ASSERT((offset >= Vector2i{} && offset + image.size() <= _size).all(),
         "Text::AbstractGlyphCache::setImage():" << Range2Di::fromSize(offset, image.size()) << "out of bounds for texture size" << _size, );
@@ -78,6 +78,10 @@ The subclass needs to implement the @ref doSetImage() function and manage the
 glyph cache image. The public @ref setImage() function already does checking
 for rectangle bounds so it's not needed to do it again on the implementation
 side.
+
+Subclasses that manage the atlas space on their own, such as
+@ref DynamicGlyphCache, can additionally override @ref doReserve() and use
+@ref remove() to take glyphs out of the cache.
 */
 class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
     public:
@@ -102,6 +106,16 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         /** @brief Count of glyphs in the cache */
         std::size_t glyphCount() const { return glyphs.size(); }
 
+        /**
+         * @brief Whether given glyph is in the cache
+         * @m_since_latest
+         *
+         * Glyph @cpp 0 @ce is always present.
+         */
+        bool contains(UnsignedInt glyph) const {
+            return glyphs.find(glyph) != glyphs.end();
+        }
+
         /**
          * @brief Parameters of given glyph
          * @param glyph         Glyph ID
@@ -139,7 +153,8 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          * glyph was stored there, use @ref insert() to store actual glyph on
          * given position and @ref setImage() to upload glyph image.
          *
-         * Glyph @p sizes are expected to be without padding.
+         * Glyph @p sizes are expected to be without padding. Calls
+         * @ref doReserve().
          *
          * @attention Cache size must be large enough to contain all rendered
          *      glyphs.
@@ -183,10 +198,32 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          */
         Image2D image();
 
+    protected:
+        /**
+         * @brief Remove glyph from the cache
+         * @m_since_latest
+         *
+         * Meant to be used by subclasses that implement @ref doReserve() and
+         * thus know when the area occupied by a glyph can be reused. Expects
+         * that the glyph is in the cache and that it isn't glyph
+         * @cpp 0 @ce.
+         */
+        void remove(UnsignedInt glyph);
+
     private:
         /** @brief Implementation for @ref features() */
         virtual GlyphCacheFeatures doFeatures() const = 0;
 
+        /**
+         * @brief Implementation for @ref reserve()
+         * @m_since_latest
+         *
+         * Default implementation packs the glyphs using
+         * @ref TextureTools::atlas() and thus works only on a cache that
+         * contains just the default glyph @cpp 0 @ce.
+         */
+        virtual std::vector<Range2Di> doReserve(const std::vector<Vector2i>& sizes);
+
         /**
          * @brief Implementation for @ref setImage()
          *
@@ -0,0 +1,429 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DynamicGlyphCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <tuple>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Unicode.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/AbstractFont.h"
+
+namespace Magnum { namespace Text {
+
+struct DynamicGlyphCache::State {
+    explicit State(PixelFormat format, const Vector2i& size);
+
+    /* CPU-side copy of the whole texture and area changed since last
+       flush() */
+    Image2D image;
+    Range2Di dirty;
+
+    UnsignedInt frame{};
+    std::size_t evictedGlyphCount{};
+
+    /* Free regions of the texture, including padding. Kept as a list of
+       non-overlapping rectangles, split on allocation and merged back on
+       release where possible. */
+    std::vector<Range2Di> free;
+
+    /* Tracked glyphs, the least recently used one at the back, together with
+       a frame in which each was last used */
+    std::list<UnsignedInt> lru;
+    std::unordered_map<UnsignedInt, std::pair<std::list<UnsignedInt>::iterator, UnsignedInt>> used;
+
+    /* Rectangles (including padding) handed out by reserve() during current
+       fillGlyphs() and the rectangle occupied by glyph 0, if it was
+       allocated by us */
+    std::vector<Range2Di> reserved;
+    Range2Di notFound;
+
+    /* Whether fillGlyphs() is in progress, in which case setImage() copies
+       only the reserved rectangles, and whether reserve() failed during it */
+    bool filling{};
+    bool reserveFailed{};
+};
+
+namespace {
+
+std::size_t imageDataSize(const PixelFormat format, const Vector2i& size) {
+    /* Rows aligned to four bytes, as is the PixelStorage default */
+    return ((size.x()*pixelSize(format) + 3)/4*4)*size.y();
+}
+
+bool isEmpty(const Range2Di& rectangle) {
+    return !rectangle.size().product();
+}
+
+bool isReserved(const std::vector<Range2Di>& reserved, const Range2Di& rectangle) {
+    return std::find(reserved.begin(), reserved.end(), rectangle) != reserved.end();
+}
+
+bool allocate(std::vector<Range2Di>& free, const Vector2i& size, Range2Di& out) {
+    /* Pick the free rectangle where the glyph fits best along the shorter
+       side */
+    std::size_t best = ~std::size_t{};
+    Int bestFit{};
+    for(std::size_t i = 0; i != free.size(); ++i) {
+        const Vector2i leftover = free[i].size() - size;
+        if(leftover.x() < 0 || leftover.y() < 0) continue;
+        const Int fit = Math::min(leftover.x(), leftover.y());
+        if(best == ~std::size_t{} || fit < bestFit) {
+            best = i;
+            bestFit = fit;
+            if(!fit) break;
+        }
+    }
+
+    if(best == ~std::size_t{}) return false;
+
+    /* Place the glyph into the bottom left corner and split the rest along
+       the shorter leftover axis, which keeps the larger leftover rectangle
+       as large as possible */
+    const Range2Di rectangle = free[best];
+    out = Range2Di::fromSize(rectangle.min(), size);
+    const Vector2i leftover = rectangle.size() - size;
+    Range2Di right, top;
+    if(leftover.x() < leftover.y()) {
+        right = {{out.max().x(), rectangle.min().y()}, {rectangle.max().x(), out.max().y()}};
+        top = {{rectangle.min().x(), out.max().y()}, rectangle.max()};
+    } else {
+        right = {{out.max().x(), rectangle.min().y()}, rectangle.max()};
+        top = {{rectangle.min().x(), out.max().y()}, {out.max().x(), rectangle.max().y()}};
+    }
+
+    free[best] = free.back();
+    free.pop_back();
+    if(!isEmpty(right)) free.push_back(right);
+    if(!isEmpty(top)) free.push_back(top);
+    return true;
+}
+
+void release(std::vector<Range2Di>& free, Range2Di rectangle) {
+    if(isEmpty(rectangle)) return;
+
+    /* Merge with free neighbors sharing a whole edge, repeat as long as the
+       grown rectangle finds new neighbors */
+    for(std::size_t i = 0; i != free.size(); ) {
+        const Range2Di& other = free[i];
+        const bool sameColumn = other.min().x() == rectangle.min().x() && other.max().x() == rectangle.max().x();
+        const bool sameRow = other.min().y() == rectangle.min().y() && other.max().y() == rectangle.max().y();
+        if(sameColumn && other.max().y() == rectangle.min().y())
+            rectangle.min().y() = other.min().y();
+        else if(sameColumn && other.min().y() == rectangle.max().y())
+            rectangle.max().y() = other.max().y();
+        else if(sameRow && other.max().x() == rectangle.min().x())
+            rectangle.min().x() = other.min().x();
+        else if(sameRow && other.min().x() == rectangle.max().x())
+            rectangle.max().x() = other.max().x();
+        else {
+            ++i;
+            continue;
+        }
+
+        free[i] = free.back();
+        free.pop_back();
+        i = 0;
+    }
+
+    free.push_back(rectangle);
+}
+
+/* Merging only neighbors sharing a whole edge gradually fragments the free
+   list. This rebuilds it from scratch by cutting occupied rectangles out of
+   the whole texture and merging the pieces back together. */
+void rebuild(std::vector<Range2Di>& free, const Vector2i& size, std::vector<Range2Di>& occupied) {
+    std::sort(occupied.begin(), occupied.end(), [](const Range2Di& a, const Range2Di& b) {
+        return a.min().y() < b.min().y() || (a.min().y() == b.min().y() && a.min().x() < b.min().x());
+    });
+
+    std::vector<Range2Di> pieces{Range2Di{{}, size}}, next;
+    for(const Range2Di& o: occupied) {
+        if(isEmpty(o)) continue;
+
+        next.clear();
+        for(const Range2Di& f: pieces) {
+            if(o.min().x() >= f.max().x() || f.min().x() >= o.max().x() ||
+               o.min().y() >= f.max().y() || f.min().y() >= o.max().y()) {
+                next.push_back(f);
+                continue;
+            }
+
+            /* Full-height pieces left and right of the occupied rectangle,
+               the rest below and above it */
+            const Int minX = Math::max(f.min().x(), o.min().x());
+            const Int maxX = Math::min(f.max().x(), o.max().x());
+            if(o.min().x() > f.min().x())
+                next.push_back({f.min(), {o.min().x(), f.max().y()}});
+            if(o.max().x() < f.max().x())
+                next.push_back({{o.max().x(), f.min().y()}, f.max()});
+            if(o.min().y() > f.min().y())
+                next.push_back({{minX, f.min().y()}, {maxX, o.min().y()}});
+            if(o.max().y() < f.max().y())
+                next.push_back({{minX, o.max().y()}, {maxX, f.max().y()}});
+        }
+        std::swap(pieces, next);
+    }
+
+    free.clear();
+    for(const Range2Di& piece: pieces) release(free, piece);
+}
+
+}
+
+DynamicGlyphCache::State::State(const PixelFormat format, const Vector2i& size): image{format, size, Containers::Array<char>{Containers::ValueInit, imageDataSize(format, size)}}, free{Range2Di{{}, size}} {}
+
+DynamicGlyphCache::DynamicGlyphCache(AbstractGlyphCache& cache, const PixelFormat format): AbstractGlyphCache{cache.textureSize(), cache.padding()}, _cache(cache), _state{Containers::InPlaceInit, format, cache.textureSize()} {}
+
+DynamicGlyphCache::~DynamicGlyphCache() = default;
+
+UnsignedInt DynamicGlyphCache::frame() const { return _state->frame; }
+
+std::size_t DynamicGlyphCache::evictedGlyphCount() const {
+    return _state->evictedGlyphCount;
+}
+
+GlyphCacheFeatures DynamicGlyphCache::doFeatures() const {
+    return GlyphCacheFeature::ImageDownload;
+}
+
+void DynamicGlyphCache::fillGlyphs(AbstractFont& font, const std::string& characters) {
+    /* Mark glyphs that are already present as used, collect characters for
+       the rest. Each missing glyph is collected just once, as fonts usually
+       don't expect the same glyph inserted twice. */
+    std::string missingCharacters;
+    std::vector<UnsignedInt> missingGlyphs;
+    for(std::size_t i = 0; i < characters.size(); ) {
+        const std::size_t begin = i;
+        char32_t codepoint;
+        std::tie(codepoint, i) = Utility::Unicode::nextChar(characters, i);
+
+        /* Characters that have no glyph map to glyph 0, which is always
+           present and never evicted */
+        const UnsignedInt glyph = font.glyphId(codepoint);
+        if(!glyph) continue;
+
+        const auto found = _state->used.find(glyph);
+        if(found != _state->used.end()) {
+            _state->lru.splice(_state->lru.begin(), _state->lru, found->second.first);
+            found->second.second = _state->frame;
+        } else if(std::find(missingGlyphs.begin(), missingGlyphs.end(), glyph) == missingGlyphs.end()) {
+            missingGlyphs.push_back(glyph);
+            missingCharacters.append(characters, begin, i - begin);
+        }
+    }
+
+    if(missingGlyphs.empty()) return;
+
+    _state->reserved.clear();
+    _state->reserveFailed = false;
+    const std::pair<Vector2i, Range2Di> notFoundBefore = (*this)[0];
+    _state->filling = true;
+    font.fillGlyphCache(*this, missingCharacters);
+    _state->filling = false;
+
+    /* If reserve() failed, the font got empty rectangles for some glyphs and
+       may have inserted them anyway. Remove those so they get filled again
+       next time, and restore glyph 0 if the font overwrote it with an empty
+       rectangle. */
+    if(_state->reserveFailed) {
+        for(const UnsignedInt glyph: missingGlyphs) {
+            if(contains(glyph) && !isReserved(_state->reserved, (*this)[glyph].second))
+                remove(glyph);
+        }
+        const std::pair<Vector2i, Range2Di> notFound = (*this)[0];
+        if(notFound != notFoundBefore && !isReserved(_state->reserved, notFound.second))
+            insert(0, notFoundBefore.first + padding(), notFoundBefore.second.padded(-padding()));
+    }
+
+    /* Start tracking glyphs the font inserted */
+    for(const UnsignedInt glyph: missingGlyphs) {
+        if(!contains(glyph)) continue;
+        _state->lru.push_front(glyph);
+        _state->used.emplace(glyph, std::make_pair(_state->lru.begin(), _state->frame));
+    }
+
+    /* Return reserved space that didn't get used. Fonts usually rasterize
+       glyph 0 again with each fill, in which case the previous space it
+       occupied is returned instead. */
+    const Range2Di notFound = (*this)[0].second;
+    for(const Range2Di& rectangle: _state->reserved) {
+        bool used = false;
+        if(rectangle == notFound) {
+            release(_state->free, _state->notFound);
+            _state->notFound = rectangle;
+            used = true;
+        } else for(const UnsignedInt glyph: missingGlyphs) {
+            if(contains(glyph) && (*this)[glyph].second == rectangle) {
+                used = true;
+                break;
+            }
+        }
+
+        if(!used) release(_state->free, rectangle);
+    }
+    _state->reserved.clear();
+}
+
+bool DynamicGlyphCache::evictOne() {
+    /* Glyphs used in the current frame can't be evicted, and since the list
+       is ordered by last use, if the last one is from the current frame, all
+       are */
+    if(_state->lru.empty()) return false;
+    const UnsignedInt glyph = _state->lru.back();
+    const auto found = _state->used.find(glyph);
+    if(found->second.second == _state->frame) return false;
+
+    release(_state->free, (*this)[glyph].second);
+    remove(glyph);
+    _state->used.erase(found);
+    _state->lru.pop_back();
+    ++_state->evictedGlyphCount;
+    return true;
+}
+
+std::vector<Range2Di> DynamicGlyphCache::doReserve(const std::vector<Vector2i>& sizes) {
+    const std::size_t reservedBefore = _state->reserved.size();
+
+    std::vector<Range2Di> out;
+    out.reserve(sizes.size());
+    for(const Vector2i& size: sizes) {
+        /* Glyphs of zero area such as spaces don't need any space if there's
+           no padding */
+        const Vector2i paddedSize = size + padding()*2;
+        if(!paddedSize.product()) {
+            out.emplace_back();
+            continue;
+        }
+
+        Range2Di rectangle;
+        bool rebuilt = false;
+        while(!allocate(_state->free, paddedSize, rectangle)) {
+            /* If there's enough free space in total, it's just too
+               fragmented. Rebuild the free list first, evict only if that
+               doesn't help. */
+            if(!rebuilt) {
+                std::size_t freeArea = 0;
+                for(const Range2Di& free: _state->free)
+                    freeArea += free.size().product();
+                if(freeArea >= std::size_t(paddedSize.product())) {
+                    std::vector<Range2Di> occupied = _state->reserved;
+                    occupied.push_back(_state->notFound);
+                    for(const UnsignedInt glyph: _state->lru)
+                        occupied.push_back((*this)[glyph].second);
+                    rebuild(_state->free, textureSize(), occupied);
+                    rebuilt = true;
+                    continue;
+                }
+            }
+
+            if(evictOne()) {
+                rebuilt = false;
+                continue;
+            }
+
+            /* Fonts index the output with glyph positions without checking
+               its size, so return a list of empty rectangles instead of an
+               empty list. Glyphs inserted with those get removed again at
+               the end of fillGlyphs(). */
+            Error{} << "Text::DynamicGlyphCache::reserve(): can't fit" << sizes.size() << "glyphs into a texture of size" << textureSize() << "even after evicting all glyphs not used in the current frame";
+            for(std::size_t i = reservedBefore; i != _state->reserved.size(); ++i)
+                release(_state->free, _state->reserved[i]);
+            _state->reserved.resize(reservedBefore);
+            _state->reserveFailed = true;
+            return std::vector<Range2Di>(sizes.size());
+        }
+
+        _state->reserved.push_back(rectangle);
+        out.push_back(rectangle.padded(-padding()));
+    }
+
+    return out;
+}
+
+void DynamicGlyphCache::doSetImage(const Vector2i& offset, const ImageView2D& image) {
+    CORRADE_ASSERT(image.format() == _state->image.format(),
+        "Text::DynamicGlyphCache::setImage(): expected" << _state->image.format() << "but got" << image.format(), );
+
+    if(!image.size().product()) return;
+
+    /* Outside of fillGlyphs() the whole image is taken. During it, fonts
+       such as FreeTypeFont upload their whole rasterized atlas, which is
+       empty everywhere except the rectangles they got from reserve(), so
+       copy just those to avoid wiping out glyphs from earlier fills. */
+    const Range2Di imageRectangle = Range2Di::fromSize(offset, image.size());
+    if(!_state->filling) copyImage(offset, image, imageRectangle);
+    else for(const Range2Di& rectangle: _state->reserved)
+        copyImage(offset, image, Math::intersect(imageRectangle, rectangle));
+}
+
+void DynamicGlyphCache::copyImage(const Vector2i& offset, const ImageView2D& image, const Range2Di& rectangle) {
+    if(isEmpty(rectangle)) return;
+
+    /* Copy the image into the CPU-side texture copy row by row, the upload
+       is deferred to flush() */
+    const Containers::StridedArrayView3D<const char> src = image.pixels();
+    const Containers::StridedArrayView3D<char> dst = _state->image.pixels();
+    const Vector2i srcMin = rectangle.min() - offset;
+    const std::size_t rowSize = rectangle.size().x()*image.pixelSize();
+    for(Int y = 0; y != rectangle.size().y(); ++y)
+        std::memcpy(&dst[rectangle.min().y() + y][rectangle.min().x()][0], &src[srcMin.y() + y][srcMin.x()][0], rowSize);
+
+    _state->dirty = Math::join(_state->dirty, rectangle);
+}
+
+Image2D DynamicGlyphCache::doImage() {
+    Containers::Array<char> data{Containers::NoInit, _state->image.data().size()};
+    std::memcpy(data.data(), _state->image.data().data(), data.size());
+    return Image2D{_state->image.format(), _state->image.size(), std::move(data)};
+}
+
+void DynamicGlyphCache::flush() {
+    if(!isEmpty(_state->dirty)) {
+        const Vector2i size = _state->image.size();
+        _cache.setImage(_state->dirty.min(), ImageView2D{
+            PixelStorage{}
+                .setRowLength(size.x())
+                .setSkip({_state->dirty.min(), 0}),
+            _state->image.format(), _state->dirty.size(),
+            _state->image.data()});
+        _state->dirty = {};
+    }
+
+    ++_state->frame;
+}
+
+}}
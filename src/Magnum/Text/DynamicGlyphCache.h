@@ -0,0 +1,171 @@
+#ifndef Magnum_Text_DynamicGlyphCache_h
+#define Magnum_Text_DynamicGlyphCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::DynamicGlyphCache
+ * @m_since_latest
+ */
+
+#include <string>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Text/AbstractGlyphCache.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Glyph cache filled on demand
+@m_since_latest
+
+Compared to filling a @ref GlyphCache with all glyphs upfront via
+@ref AbstractFont::fillGlyphCache(), which is impractical for large character
+sets such as CJK or user-generated text, this cache rasterizes only glyphs
+that are actually needed and makes room for new ones by evicting glyphs that
+weren't used recently.
+
+The class doesn't own any texture, instead it wraps another glyph cache such
+as @ref GlyphCache that provides the texture storage. Glyph rectangles are
+allocated from a list of free regions in the texture, space of evicted glyphs
+is returned back to it. Glyph images are collected in a CPU-side copy of the
+texture and uploaded to the wrapped cache in a single
+@ref AbstractGlyphCache::setImage() call spanning all regions changed since the
+last @ref flush().
+
+@section Text-DynamicGlyphCache-usage Usage
+
+Call @ref fillGlyphs() with each text before laying it out, then @ref flush()
+once per frame after all text for the frame was prepared. The cache itself
+is then passed to @ref AbstractFont::layout() or @ref Renderer, while the
+texture is taken from the wrapped cache:
+
+@snippet MagnumText.cpp DynamicGlyphCache-usage
+
+Glyphs passed to @ref fillGlyphs() during the current frame are never evicted
+so all text prepared for a frame is guaranteed to have its glyphs present.
+If the glyphs for a frame don't fit into the texture even after evicting all
+glyphs from previous frames, @ref reserve() prints a message and returns a
+list of empty rectangles. Glyphs the font inserts with those are removed again
+at the end of @ref fillGlyphs(), so they get filled on the next call.
+
+Fonts such as FreeTypeFont or StbTrueTypeFont upload the whole rasterized
+atlas using a single @ref setImage() call. To not wipe out glyphs from earlier
+fills, only the rectangles handed out by @ref reserve() during the current
+@ref fillGlyphs() are taken from images the font passes to @ref setImage(),
+the rest is ignored.
+
+The cache is meant to be used with a single font and a single font size,
+fonts supporting @ref FontFeature::PreparedGlyphCache can't be used to fill
+it.
+*/
+class MAGNUM_TEXT_EXPORT DynamicGlyphCache: public AbstractGlyphCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param cache     Glyph cache providing the texture storage
+         * @param format    Format of glyph images
+         *
+         * Takes texture size and padding from @p cache. The @p cache is
+         * expected to stay alive for the whole lifetime of this instance. Its
+         * glyph table isn't used.
+         */
+        explicit DynamicGlyphCache(AbstractGlyphCache& cache, PixelFormat format);
+
+        /** @brief Copying is not allowed */
+        DynamicGlyphCache(const DynamicGlyphCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        DynamicGlyphCache(DynamicGlyphCache&&) = delete;
+
+        ~DynamicGlyphCache();
+
+        /** @brief Copying is not allowed */
+        DynamicGlyphCache& operator=(const DynamicGlyphCache&) = delete;
+
+        /** @brief Moving is not allowed */
+        DynamicGlyphCache& operator=(DynamicGlyphCache&&) = delete;
+
+        /** @brief Glyph cache providing the texture storage */
+        AbstractGlyphCache& cache() { return _cache; }
+        const AbstractGlyphCache& cache() const { return _cache; } /**< @overload */
+
+        /**
+         * @brief Current frame
+         *
+         * Starts at @cpp 0 @ce, incremented with every @ref flush().
+         */
+        UnsignedInt frame() const;
+
+        /**
+         * @brief Count of glyphs evicted so far
+         *
+         * Useful for detecting whether the texture is too small for the
+         * amount of text that's rendered.
+         */
+        std::size_t evictedGlyphCount() const;
+
+        /**
+         * @brief Ensure glyphs for given characters are in the cache
+         * @param font          Font to rasterize the glyphs with
+         * @param characters    UTF-8 characters
+         *
+         * Marks glyphs of all @p characters as used in the current frame.
+         * Characters that don't have their glyph in the cache yet are passed
+         * to @ref AbstractFont::fillGlyphCache(), which then calls
+         * @ref reserve(), @ref insert() and @ref setImage() on this instance.
+         * Reserved space that the font didn't use, as well as space of a
+         * replaced glyph @cpp 0 @ce, is returned back for reuse.
+         */
+        void fillGlyphs(AbstractFont& font, const std::string& characters);
+
+        /**
+         * @brief Upload changed glyph images and advance to the next frame
+         *
+         * Uploads the area changed since the last call to the wrapped cache
+         * using a single @ref AbstractGlyphCache::setImage() call, if
+         * anything changed. Then increments @ref frame(), making glyphs used
+         * in the frame that just ended eligible for eviction.
+         */
+        void flush();
+
+    private:
+        struct State;
+
+        GlyphCacheFeatures MAGNUM_TEXT_LOCAL doFeatures() const override;
+        std::vector<Range2Di> MAGNUM_TEXT_LOCAL doReserve(const std::vector<Vector2i>& sizes) override;
+        void MAGNUM_TEXT_LOCAL doSetImage(const Vector2i& offset, const ImageView2D& image) override;
+        Image2D MAGNUM_TEXT_LOCAL doImage() override;
+
+        bool MAGNUM_TEXT_LOCAL evictOne();
+        void MAGNUM_TEXT_LOCAL copyImage(const Vector2i& offset, const ImageView2D& image, const Range2Di& rectangle);
+
+        AbstractGlyphCache& _cache;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,231 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GlyphLayout.h"
+
+#include <cstring>
+#include <tuple>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Unicode.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+
+namespace Magnum { namespace Text {
+
+std::pair<UnsignedInt, Range2D> layoutGlyphQuadsInto(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Alignment alignment, const Containers::ArrayView<const char> text, const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates) {
+    CORRADE_ASSERT(vertexPositions.size() == vertexTextureCoordinates.size(),
+        "Text::layoutGlyphQuadsInto(): expected vertex position and texture coordinate views to have the same size but got" << vertexPositions.size() << "and" << vertexTextureCoordinates.size(), {});
+
+    /* Everything that's per-font is calculated just once */
+    const Float scale = size/font.size();
+    const Vector2 lineAdvance = Vector2::yAxis(font.lineHeight()*scale);
+    const Vector2 inverseTextureSize = 1.0f/Vector2(cache.textureSize());
+
+    /* Total rendered bounds, initial line position and count of vertices
+       written so far */
+    Range2D rectangle;
+    Vector2 linePosition;
+    std::size_t vertex = 0;
+
+    /* Render each line separately and align it horizontally */
+    std::size_t i = 0;
+    for(;;) {
+        const std::size_t lineBeginVertex = vertex;
+
+        /* Bounds of rendered line */
+        Range2D lineRectangle;
+
+        /* Render all glyphs on the line */
+        Vector2 cursorPosition = linePosition;
+        while(i != text.size() && text[i] != '\n') {
+            char32_t character;
+            std::tie(character, i) = Utility::Unicode::nextChar(text, i);
+
+            CORRADE_ASSERT(vertex + 4 <= vertexPositions.size(),
+                "Text::layoutGlyphQuadsInto(): expected views to have at least" << vertex + 4 << "elements but got" << vertexPositions.size(), {});
+
+            const UnsignedInt glyph = font.glyphId(character);
+
+            /* Texture coordinates and quad position, denormalized to
+               requested text size, same as done in MagnumFont's layouter */
+            Vector2i position;
+            Range2Di textureRectangle;
+            std::tie(position, textureRectangle) = cache[glyph];
+            const Range2D textureCoordinates = Range2D{textureRectangle}.scaled(inverseTextureSize);
+            const Range2D quadPosition = Range2D{Range2Di::fromSize(position, textureRectangle.size())}.scaled(Vector2{scale}).translated(cursorPosition);
+
+            /* Extend line rectangle with current quad bounds. If zero size,
+               replace it. */
+            if(!lineRectangle.size().isZero()) {
+                lineRectangle.bottomLeft() = Math::min(lineRectangle.bottomLeft(), quadPosition.bottomLeft());
+                lineRectangle.topRight() = Math::max(lineRectangle.topRight(), quadPosition.topRight());
+            } else lineRectangle = quadPosition;
+
+            /* 0---2
+               |   |
+               |   |
+               |   |
+               1---3 */
+            vertexPositions[vertex + 0] = quadPosition.topLeft();
+            vertexPositions[vertex + 1] = quadPosition.bottomLeft();
+            vertexPositions[vertex + 2] = quadPosition.topRight();
+            vertexPositions[vertex + 3] = quadPosition.bottomRight();
+            vertexTextureCoordinates[vertex + 0] = textureCoordinates.topLeft();
+            vertexTextureCoordinates[vertex + 1] = textureCoordinates.bottomLeft();
+            vertexTextureCoordinates[vertex + 2] = textureCoordinates.topRight();
+            vertexTextureCoordinates[vertex + 3] = textureCoordinates.bottomRight();
+            vertex += 4;
+
+            cursorPosition += font.glyphAdvance(glyph)*scale;
+        }
+
+        /* Horizontally align the rendered line */
+        Float alignmentOffsetX = 0.0f;
+        if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
+            alignmentOffsetX = -lineRectangle.centerX();
+        else if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
+            alignmentOffsetX = -lineRectangle.right();
+
+        /* Integer alignment */
+        if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
+            alignmentOffsetX = Math::round(alignmentOffsetX);
+
+        /* Align positions and bounds on current line */
+        lineRectangle = lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
+        for(std::size_t j = lineBeginVertex; j != vertex; ++j)
+            vertexPositions[j].x() += alignmentOffsetX;
+
+        /* Add final line bounds to total bounds. Empty lines are skipped. */
+        if(vertex != lineBeginVertex) {
+            if(!rectangle.size().isZero()) {
+                rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
+                rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
+            } else rectangle = lineRectangle;
+        }
+
+        /* Move to next line, if any */
+        if(i == text.size()) break;
+        ++i;
+        linePosition -= lineAdvance;
+    }
+
+    /* Vertically align the rendered text */
+    Float alignmentOffsetY = 0.0f;
+    if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentMiddle)
+        alignmentOffsetY = -rectangle.centerY();
+    else if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentTop)
+        alignmentOffsetY = -rectangle.top();
+
+    /* Integer alignment */
+    if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
+        alignmentOffsetY = Math::round(alignmentOffsetY);
+
+    /* Align positions and bounds */
+    rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
+    for(std::size_t j = 0; j != vertex; ++j)
+        vertexPositions[j].y() += alignmentOffsetY;
+
+    return {UnsignedInt(vertex/4), rectangle};
+}
+
+std::pair<UnsignedInt, Range2D> layoutGlyphQuadsInto(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Alignment alignment, const std::string& text, const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates) {
+    return layoutGlyphQuadsInto(font, cache, size, alignment, Containers::ArrayView<const char>{text.data(), text.size()}, vertexPositions, vertexTextureCoordinates);
+}
+
+std::pair<UnsignedInt, Range2D> layoutGlyphQuadsInto(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Alignment alignment, const char* const text, const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates) {
+    return layoutGlyphQuadsInto(font, cache, size, alignment, Containers::ArrayView<const char>{text, std::strlen(text)}, vertexPositions, vertexTextureCoordinates);
+}
+
+UnsignedInt layoutGlyphQuadsInto(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Alignment alignment, const Containers::StridedArrayView1D<const std::string>& texts, const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& glyphOffsets, const Containers::StridedArrayView1D<Range2D>& rectangles) {
+    CORRADE_ASSERT(glyphOffsets.size() == texts.size() && rectangles.size() == texts.size(),
+        "Text::layoutGlyphQuadsInto(): expected glyph offset and rectangle views to have" << texts.size() << "elements but got" << glyphOffsets.size() << "and" << rectangles.size(), {});
+
+    UnsignedInt glyphCount = 0;
+    for(std::size_t i = 0; i != texts.size(); ++i) {
+        glyphOffsets[i] = glyphCount;
+
+        /* The previous call made sure the views are large enough for all
+           glyphs so far */
+        const std::size_t vertexOffset = std::size_t(glyphCount)*4;
+        const std::pair<UnsignedInt, Range2D> out = layoutGlyphQuadsInto(font, cache, size, alignment, texts[i], vertexPositions.suffix(vertexOffset), vertexTextureCoordinates.suffix(vertexOffset));
+        glyphCount += out.first;
+        rectangles[i] = out.second;
+    }
+
+    return glyphCount;
+}
+
+MeshIndexType glyphQuadIndexType(const UnsignedInt glyphCount) {
+    const UnsignedInt vertexCount = glyphCount*4;
+    if(vertexCount <= 256) return MeshIndexType::UnsignedByte;
+    if(vertexCount <= 65536) return MeshIndexType::UnsignedShort;
+    return MeshIndexType::UnsignedInt;
+}
+
+namespace {
+
+template<class T> void glyphQuadIndicesIntoImplementation(const UnsignedInt glyphOffset, const Containers::StridedArrayView1D<T>& indices) {
+    CORRADE_ASSERT(indices.size() % 6 == 0,
+        "Text::glyphQuadIndicesInto(): expected the index count to be divisible by 6 but got" << indices.size(), );
+    const UnsignedInt glyphCount = indices.size()/6;
+    CORRADE_ASSERT((UnsignedLong(glyphOffset) + glyphCount)*4 <= UnsignedLong(T(~T{})) + 1,
+        "Text::glyphQuadIndicesInto(): glyphs" << glyphOffset << "to" << glyphOffset + glyphCount << "can't be indexed with" << sizeof(T)*8 << Debug::nospace << "-bit indices", );
+
+    for(UnsignedInt i = 0; i != glyphCount; ++i) {
+        /* 0---2 0---2 5
+           |   | |  / /|
+           |   | | / / |
+           |   | |/ /  |
+           1---3 1 3---4 */
+
+        const T vertex = T((glyphOffset + i)*4);
+        const std::size_t pos = std::size_t(i)*6;
+        indices[pos]   = vertex;
+        indices[pos+1] = vertex+1;
+        indices[pos+2] = vertex+2;
+        indices[pos+3] = vertex+1;
+        indices[pos+4] = vertex+3;
+        indices[pos+5] = vertex+2;
+    }
+}
+
+}
+
+void glyphQuadIndicesInto(const UnsignedInt glyphOffset, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    glyphQuadIndicesIntoImplementation(glyphOffset, indices);
+}
+
+void glyphQuadIndicesInto(const UnsignedInt glyphOffset, const Containers::StridedArrayView1D<UnsignedShort>& indices) {
+    glyphQuadIndicesIntoImplementation(glyphOffset, indices);
+}
+
+void glyphQuadIndicesInto(const UnsignedInt glyphOffset, const Containers::StridedArrayView1D<UnsignedByte>& indices) {
+    glyphQuadIndicesIntoImplementation(glyphOffset, indices);
+}
+
+}}
@@ -0,0 +1,158 @@
+#ifndef Magnum_Text_GlyphLayout_h
+#define Magnum_Text_GlyphLayout_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Text::layoutGlyphQuadsInto(), @ref Magnum::Text::glyphQuadIndexType(), @ref Magnum::Text::glyphQuadIndicesInto()
+ * @m_since_latest
+ */
+
+#include <string>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Alignment.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Lay out glyph quads for a text into caller-provided views
+@param[in]  font                    Font
+@param[in]  cache                   Glyph cache
+@param[in]  size                    Font size
+@param[in]  alignment               Text alignment
+@param[in]  text                    UTF-8 text to lay out
+@param[out] vertexPositions         Where to put vertex positions
+@param[out] vertexTextureCoordinates Where to put vertex texture
+    coordinates
+@return Count of laid out glyphs and a rectangle spanning the text
+@m_since_latest
+
+A headless, allocation-free alternative to @ref AbstractRenderer::render().
+Each glyph is written as four vertices in the same order as
+@ref Renderer produces them --- top left, bottom left, top right and bottom
+right --- so the output can be indexed with @ref glyphQuadIndicesInto(). Both
+views are expected to have the same size and be large enough for all glyphs,
+four vertices per glyph. The text contains at most one glyph per byte, so
+@cpp text.size()*4 @ce vertices is always enough.
+
+Unlike @ref AbstractFont::layout(), the glyphs are looked up one character at
+a time using @ref AbstractFont::glyphId() and @ref AbstractFont::glyphAdvance()
+instead of going through a heap-allocated @ref AbstractLayouter, which means
+ligatures and kerning done by the font plugin layouter are not applied. All
+glyphs are expected to be present in @p cache, missing glyphs are rendered
+using the glyph @cpp 0 @ce.
+@see @ref AbstractFont::fillGlyphCache()
+*/
+MAGNUM_TEXT_EXPORT std::pair<UnsignedInt, Range2D> layoutGlyphQuadsInto(AbstractFont& font, const AbstractGlyphCache& cache, Float size, Alignment alignment, Containers::ArrayView<const char> text, const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates);
+
+/**
+@overload
+@m_since_latest
+*/
+MAGNUM_TEXT_EXPORT std::pair<UnsignedInt, Range2D> layoutGlyphQuadsInto(AbstractFont& font, const AbstractGlyphCache& cache, Float size, Alignment alignment, const std::string& text, const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates);
+
+/**
+@overload
+@m_since_latest
+*/
+MAGNUM_TEXT_EXPORT std::pair<UnsignedInt, Range2D> layoutGlyphQuadsInto(AbstractFont& font, const AbstractGlyphCache& cache, Float size, Alignment alignment, const char* text, const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates);
+
+/**
+@brief Lay out glyph quads for a batch of texts into caller-provided views
+@param[in]  font                    Font
+@param[in]  cache                   Glyph cache
+@param[in]  size                    Font size
+@param[in]  alignment               Text alignment
+@param[in]  texts                   UTF-8 texts to lay out
+@param[out] vertexPositions         Where to put vertex positions
+@param[out] vertexTextureCoordinates Where to put vertex texture
+    coordinates
+@param[out] glyphOffsets            Where to put offset of the first glyph
+    of each text
+@param[out] rectangles              Where to put rectangles spanning each
+    text
+@return Total count of laid out glyphs
+@m_since_latest
+
+Calls @ref layoutGlyphQuadsInto(AbstractFont&, const AbstractGlyphCache&, Float, Alignment, const std::string&, const Containers::StridedArrayView1D<Vector2>&, const Containers::StridedArrayView1D<Vector2>&)
+for each text, placing its glyphs right after glyphs of the previous text.
+Glyphs of text @cpp i @ce are then in range
+@cpp glyphOffsets[i] @ce to @cpp glyphOffsets[i + 1] @ce, or to the returned
+total count for the last text. The @p glyphOffsets and @p rectangles views are
+expected to have the same size as @p texts. Each text is laid out relative to
+the origin, use @p glyphOffsets to position them afterwards. Apart from the
+caller-provided views, no memory is allocated, so the views can be reused
+across frames:
+
+@snippet MagnumText.cpp layoutGlyphQuadsInto
+*/
+MAGNUM_TEXT_EXPORT UnsignedInt layoutGlyphQuadsInto(AbstractFont& font, const AbstractGlyphCache& cache, Float size, Alignment alignment, const Containers::StridedArrayView1D<const std::string>& texts, const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates, const Containers::StridedArrayView1D<UnsignedInt>& glyphOffsets, const Containers::StridedArrayView1D<Range2D>& rectangles);
+
+/**
+@brief Smallest index type able to index given count of glyph quads
+@m_since_latest
+
+Returns @ref MeshIndexType::UnsignedByte for up to 64 glyphs,
+@ref MeshIndexType::UnsignedShort for up to 16384 glyphs and
+@ref MeshIndexType::UnsignedInt otherwise.
+@see @ref glyphQuadIndicesInto()
+*/
+MAGNUM_TEXT_EXPORT MeshIndexType glyphQuadIndexType(UnsignedInt glyphCount);
+
+/**
+@brief Generate indices for glyph quads into a caller-provided view
+@param[in]  glyphOffset     Offset of the first glyph
+@param[out] indices         Where to put the indices
+@m_since_latest
+
+Writes six indices for each of @cpp indices.size()/6 @ce glyphs, forming two
+triangles from the four vertices output by @ref layoutGlyphQuadsInto(),
+starting at vertex @cpp glyphOffset*4 @ce. The @p indices size is expected to
+be divisible by six and all generated indices are expected to fit into the
+index type.
+@see @ref glyphQuadIndexType()
+*/
+MAGNUM_TEXT_EXPORT void glyphQuadIndicesInto(UnsignedInt glyphOffset, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+
+/**
+@overload
+@m_since_latest
+*/
+MAGNUM_TEXT_EXPORT void glyphQuadIndicesInto(UnsignedInt glyphOffset, const Containers::StridedArrayView1D<UnsignedShort>& indices);
+
+/**
+@overload
+@m_since_latest
+*/
+MAGNUM_TEXT_EXPORT void glyphQuadIndicesInto(UnsignedInt glyphOffset, const Containers::StridedArrayView1D<UnsignedByte>& indices);
+
+}}
+
+#endif
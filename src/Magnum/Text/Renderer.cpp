@@ -27,6 +27,7 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/GL/Context.h"
@@ -35,37 +36,18 @@
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Shaders/AbstractVector.h"
 #include "Magnum/Text/AbstractFont.h"
-#include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/Text/GlyphLayout.h"
 
 namespace Magnum { namespace Text {
 
 namespace {
 
-template<class T> void createIndices(void* output, const UnsignedInt glyphCount) {
-    T* const out = reinterpret_cast<T*>(output);
-    for(UnsignedInt i = 0; i != glyphCount; ++i) {
-        /* 0---2 0---2 5
-           |   | |  / /|
-           |   | | / / |
-           |   | |/ /  |
-           1---3 1 3---4 */
-
-        const T vertex = T(i)*4;
-        const UnsignedInt pos = T(i)*6;
-        out[pos]   = vertex;
-        out[pos+1] = vertex+1;
-        out[pos+2] = vertex+2;
-        out[pos+3] = vertex+1;
-        out[pos+4] = vertex+3;
-        out[pos+5] = vertex+2;
-    }
-}
-
 struct Vertex {
     Vector2 position, textureCoordinates;
 };
 
-std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
+std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
     /* Output data, reserve memory as when the text would be ASCII-only. In
        reality the actual vertex count will be smaller, but allocating more at
        once is better than reallocating many times later. */
@@ -177,29 +159,21 @@ std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& fo
 }
 
 std::pair<Containers::Array<char>, MeshIndexType> renderIndicesInternal(const UnsignedInt glyphCount) {
-    const UnsignedInt vertexCount = glyphCount*4;
     const UnsignedInt indexCount = glyphCount*6;
 
-    Containers::Array<char> indices;
-    MeshIndexType indexType;
-    if(vertexCount <= 256) {
-        indexType = MeshIndexType::UnsignedByte;
-        indices = Containers::Array<char>(indexCount*sizeof(UnsignedByte));
-        createIndices<UnsignedByte>(indices, glyphCount);
-    } else if(vertexCount <= 65536) {
-        indexType = MeshIndexType::UnsignedShort;
-        indices = Containers::Array<char>(indexCount*sizeof(UnsignedShort));
-        createIndices<UnsignedShort>(indices, glyphCount);
-    } else {
-        indexType = MeshIndexType::UnsignedInt;
-        indices = Containers::Array<char>(indexCount*sizeof(UnsignedInt));
-        createIndices<UnsignedInt>(indices, glyphCount);
-    }
+    const MeshIndexType indexType = glyphQuadIndexType(glyphCount);
+    Containers::Array<char> indices{Containers::NoInit, indexCount*meshIndexTypeSize(indexType)};
+    if(indexType == MeshIndexType::UnsignedByte)
+        glyphQuadIndicesInto(0, Containers::arrayCast<UnsignedByte>(indices));
+    else if(indexType == MeshIndexType::UnsignedShort)
+        glyphQuadIndicesInto(0, Containers::arrayCast<UnsignedShort>(indices));
+    else
+        glyphQuadIndicesInto(0, Containers::arrayCast<UnsignedInt>(indices));
 
     return {std::move(indices), indexType};
 }
 
-std::tuple<GL::Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, GL::BufferUsage usage, Alignment alignment) {
+std::tuple<GL::Mesh, Range2D> renderInternal(AbstractFont& font, const AbstractGlyphCache& cache, Float size, const std::string& text, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, GL::BufferUsage usage, Alignment alignment) {
     /* Render vertices and upload them */
     std::vector<Vertex> vertices;
     Range2D rectangle;
@@ -227,7 +201,7 @@ std::tuple<GL::Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCach
 
 }
 
-std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> AbstractRenderer::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment) {
+std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> AbstractRenderer::render(AbstractFont& font, const AbstractGlyphCache& cache, Float size, const std::string& text, Alignment alignment) {
     /* Render vertices */
     std::vector<Vertex> vertices;
     Range2D rectangle;
@@ -245,12 +219,12 @@ std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>,
     /* Render indices */
     const UnsignedInt glyphCount = vertices.size()/4;
     std::vector<UnsignedInt> indices(glyphCount*6);
-    createIndices<UnsignedInt>(indices.data(), glyphCount);
+    glyphQuadIndicesInto(0, Containers::arrayView(indices));
 
     return std::make_tuple(std::move(positions), std::move(textureCoordinates), std::move(indices), rectangle);
 }
 
-template<UnsignedInt dimensions> std::tuple<GL::Mesh, Range2D> Renderer<dimensions>::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, GL::BufferUsage usage, Alignment alignment) {
+template<UnsignedInt dimensions> std::tuple<GL::Mesh, Range2D> Renderer<dimensions>::render(AbstractFont& font, const AbstractGlyphCache& cache, Float size, const std::string& text, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, GL::BufferUsage usage, Alignment alignment) {
     /* Finalize mesh configuration and return the result */
     auto r = renderInternal(font, cache, size, text, vertexBuffer, indexBuffer, usage, alignment);
     GL::Mesh& mesh = std::get<0>(r);
@@ -297,7 +271,7 @@ void AbstractRenderer::bufferUnmapImplementationDefault(GL::Buffer& buffer)
     #endif
 }
 
-AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{GL::Buffer::TargetHint::Array}, _indexBuffer{GL::Buffer::TargetHint::ElementArray}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0) {
+AbstractRenderer::AbstractRenderer(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{GL::Buffer::TargetHint::Array}, _indexBuffer{GL::Buffer::TargetHint::ElementArray}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0) {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::map_buffer_range);
     #elif defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
@@ -317,7 +291,7 @@ AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache,
 
 AbstractRenderer::~AbstractRenderer() = default;
 
-template<UnsignedInt dimensions> Renderer<dimensions>::Renderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): AbstractRenderer(font, cache, size, alignment) {
+template<UnsignedInt dimensions> Renderer<dimensions>::Renderer(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Alignment alignment): AbstractRenderer(font, cache, size, alignment) {
     /* Finalize mesh configuration */
     _mesh.addVertexBuffer(_vertexBuffer, 0,
             typename Shaders::AbstractVector<dimensions>::Position(Shaders::AbstractVector<dimensions>::Position::Components::Two),
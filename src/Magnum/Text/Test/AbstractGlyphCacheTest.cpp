@@ -26,6 +26,7 @@
 #include <sstream>
 #include <tuple>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Image.h"
@@ -41,6 +42,9 @@ struct AbstractGlyphCacheTest: TestSuite::Tester {
     void initialize();
     void access();
     void reserve();
+    void reserveCustom();
+    void remove();
+    void removeInvalid();
 
     void setImage();
     void setImageOutOfBounds();
@@ -54,6 +58,9 @@ AbstractGlyphCacheTest::AbstractGlyphCacheTest() {
     addTests({&AbstractGlyphCacheTest::initialize,
               &AbstractGlyphCacheTest::access,
               &AbstractGlyphCacheTest::reserve,
+              &AbstractGlyphCacheTest::reserveCustom,
+              &AbstractGlyphCacheTest::remove,
+              &AbstractGlyphCacheTest::removeInvalid,
 
               &AbstractGlyphCacheTest::setImage,
               &AbstractGlyphCacheTest::setImageOutOfBounds,
@@ -114,6 +121,61 @@ void AbstractGlyphCacheTest::reserve() {
     CORRADE_VERIFY(!cache.reserve({{5, 3}}).empty());
 }
 
+void AbstractGlyphCacheTest::reserveCustom() {
+    struct MyGlyphCache: AbstractGlyphCache {
+        using AbstractGlyphCache::AbstractGlyphCache;
+
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+        std::vector<Range2Di> doReserve(const std::vector<Vector2i>& sizes) override {
+            return {Range2Di::fromSize({}, sizes[0])};
+        }
+    } cache{Vector2i{236}};
+
+    /* Works on a non-empty cache as well */
+    cache.insert(3, {}, {{10, 10}, {23, 45}});
+    CORRADE_COMPARE_AS(cache.reserve({{5, 3}}),
+        (std::vector<Range2Di>{{{}, {5, 3}}}),
+        TestSuite::Compare::Container);
+}
+
+struct RemovableGlyphCache: DummyGlyphCache {
+    using DummyGlyphCache::DummyGlyphCache;
+    using AbstractGlyphCache::remove;
+};
+
+void AbstractGlyphCacheTest::remove() {
+    RemovableGlyphCache cache{Vector2i{236}};
+    cache.insert(25, {3, 4}, {{15, 30}, {45, 35}});
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+    CORRADE_VERIFY(cache.contains(0));
+    CORRADE_VERIFY(cache.contains(25));
+
+    cache.remove(25);
+    CORRADE_COMPARE(cache.glyphCount(), 1);
+    CORRADE_VERIFY(!cache.contains(25));
+
+    /* The glyph can be inserted again after */
+    cache.insert(25, {3, 4}, {{0, 0}, {5, 5}});
+    CORRADE_VERIFY(cache.contains(25));
+}
+
+void AbstractGlyphCacheTest::removeInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    RemovableGlyphCache cache{Vector2i{236}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.remove(0);
+    cache.remove(25);
+    CORRADE_COMPARE(out.str(),
+        "Text::AbstractGlyphCache::remove(): can't remove the default glyph\n"
+        "Text::AbstractGlyphCache::remove(): glyph 25 not found\n");
+}
+
 void AbstractGlyphCacheTest::setImage() {
     struct MyGlyphCache: AbstractGlyphCache {
         using AbstractGlyphCache::AbstractGlyphCache;
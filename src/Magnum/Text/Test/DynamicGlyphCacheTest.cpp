@@ -0,0 +1,395 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <type_traits>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/DynamicGlyphCache.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct DynamicGlyphCacheTest: TestSuite::Tester {
+    explicit DynamicGlyphCacheTest();
+
+    void construct();
+    void constructCopy();
+
+    void fill();
+    void fillAlreadyPresent();
+    void fillUnusedSpaceReturned();
+    void fillNotFoundGlyphReplaced();
+    void fillWholeAtlasUploaded();
+
+    void evict();
+    void evictCurrentFrame();
+
+    void flushNothingChanged();
+    void setImageInvalidFormat();
+};
+
+DynamicGlyphCacheTest::DynamicGlyphCacheTest() {
+    addTests({&DynamicGlyphCacheTest::construct,
+              &DynamicGlyphCacheTest::constructCopy,
+
+              &DynamicGlyphCacheTest::fill,
+              &DynamicGlyphCacheTest::fillAlreadyPresent,
+              &DynamicGlyphCacheTest::fillUnusedSpaceReturned,
+              &DynamicGlyphCacheTest::fillNotFoundGlyphReplaced,
+              &DynamicGlyphCacheTest::fillWholeAtlasUploaded,
+
+              &DynamicGlyphCacheTest::evict,
+              &DynamicGlyphCacheTest::evictCurrentFrame,
+
+              &DynamicGlyphCacheTest::flushNothingChanged,
+              &DynamicGlyphCacheTest::setImageInvalidFormat});
+}
+
+struct UploadGlyphCache: AbstractGlyphCache {
+    using AbstractGlyphCache::AbstractGlyphCache;
+
+    GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i& offset, const ImageView2D& image) override {
+        uploads.push_back(Range2Di::fromSize(offset, image.size()));
+        pixels.clear();
+        for(const auto row: image.pixels<UnsignedByte>())
+            for(const UnsignedByte pixel: row) pixels.push_back(pixel);
+    }
+
+    std::vector<Range2Di> uploads;
+    std::vector<UnsignedByte> pixels;
+};
+
+/* Letters map to glyphs 1 to 26, each glyph is a square filled with its ID.
+   Either uploaded glyph by glyph or, like FreeTypeFont does, rasterized into
+   an image of the whole texture size and uploaded at once. */
+struct FakeFont: AbstractFont {
+    FontFeatures doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doGlyphId(const char32_t character) override {
+        return character >= 'a' && character <= 'z' ? character - 'a' + 1 : 0;
+    }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override {
+        return nullptr;
+    }
+
+    void doFillGlyphCache(AbstractGlyphCache& cache, const std::u32string& characters) override {
+        filled.push_back(characters);
+
+        std::vector<UnsignedInt> glyphs;
+        if(rasterizeNotFound) glyphs.push_back(0);
+        for(const char32_t character: characters)
+            glyphs.push_back(doGlyphId(character));
+
+        /* Like real fonts, doesn't check the output size */
+        const std::vector<Range2Di> rectangles = cache.reserve(std::vector<Vector2i>(glyphs.size(), glyphSize));
+
+        const Vector2i textureSize = cache.textureSize();
+        Containers::Array<char> atlas{Containers::ValueInit, std::size_t(textureSize.product())};
+        for(std::size_t i = 0; i != glyphs.size(); ++i) {
+            if(glyphs[i] == skipGlyph) continue;
+
+            cache.insert(glyphs[i], {}, rectangles[i]);
+            if(wholeAtlas) {
+                for(Int y = rectangles[i].min().y(); y != rectangles[i].max().y(); ++y)
+                    for(Int x = rectangles[i].min().x(); x != rectangles[i].max().x(); ++x)
+                        atlas[y*textureSize.x() + x] = char(glyphs[i]);
+            } else {
+                Containers::Array<char> data{Containers::DirectInit, std::size_t(glyphSize.product()), char(glyphs[i])};
+                cache.setImage(rectangles[i].min(), ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, glyphSize, data});
+            }
+        }
+
+        if(wholeAtlas)
+            cache.setImage({}, ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, textureSize, atlas});
+    }
+
+    Vector2i glyphSize{4};
+    bool rasterizeNotFound = false;
+    bool wholeAtlas = false;
+    UnsignedInt skipGlyph = ~UnsignedInt{};
+    std::vector<std::u32string> filled;
+};
+
+void DynamicGlyphCacheTest::construct() {
+    UploadGlyphCache backend{{64, 32}, {2, 1}};
+    DynamicGlyphCache cache{backend, PixelFormat::R8Unorm};
+
+    CORRADE_COMPARE(&cache.cache(), &backend);
+    CORRADE_COMPARE(cache.textureSize(), (Vector2i{64, 32}));
+    CORRADE_COMPARE(cache.padding(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(cache.features(), GlyphCacheFeature::ImageDownload);
+    CORRADE_COMPARE(cache.glyphCount(), 1);
+    CORRADE_COMPARE(cache.frame(), 0);
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+
+    Image2D image = cache.image();
+    CORRADE_COMPARE(image.format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image.size(), (Vector2i{64, 32}));
+}
+
+void DynamicGlyphCacheTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<DynamicGlyphCache, const DynamicGlyphCache&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<DynamicGlyphCache, const DynamicGlyphCache&>{}));
+}
+
+void DynamicGlyphCacheTest::fill() {
+    UploadGlyphCache backend{Vector2i{8}};
+    DynamicGlyphCache cache{backend, PixelFormat::R8Unorm};
+    FakeFont font;
+
+    /* Each missing glyph is requested just once, characters without a glyph
+       are not requested at all */
+    cache.fillGlyphs(font, "ab?a");
+    CORRADE_COMPARE(font.filled, (std::vector<std::u32string>{U"ab"}));
+    CORRADE_COMPARE(cache.glyphCount(), 3);
+    CORRADE_VERIFY(cache.contains(1));
+    CORRADE_VERIFY(cache.contains(2));
+    CORRADE_COMPARE(cache[1].second, (Range2Di{{0, 0}, {4, 4}}));
+    CORRADE_COMPARE(cache[2].second, (Range2Di{{4, 0}, {8, 4}}));
+
+    /* Nothing uploaded until flush() */
+    CORRADE_VERIFY(backend.uploads.empty());
+
+    /* Both glyphs get uploaded in a single call */
+    cache.flush();
+    CORRADE_COMPARE(cache.frame(), 1);
+    CORRADE_COMPARE_AS(backend.uploads,
+        (std::vector<Range2Di>{{{0, 0}, {8, 4}}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(backend.pixels, (std::vector<UnsignedByte>{
+        1, 1, 1, 1, 2, 2, 2, 2,
+        1, 1, 1, 1, 2, 2, 2, 2,
+        1, 1, 1, 1, 2, 2, 2, 2,
+        1, 1, 1, 1, 2, 2, 2, 2
+    }), TestSuite::Compare::Container);
+}
+
+void DynamicGlyphCacheTest::fillAlreadyPresent() {
+    UploadGlyphCache backend{Vector2i{8}};
+    DynamicGlyphCache cache{backend, PixelFormat::R8Unorm};
+    FakeFont font;
+
+    cache.fillGlyphs(font, "ab");
+    cache.flush();
+
+    /* Only the glyph that's not there yet is requested */
+    cache.fillGlyphs(font, "bac");
+    CORRADE_COMPARE(font.filled, (std::vector<std::u32string>{U"ab", U"c"}));
+
+    /* No font call at all if everything is there */
+    cache.fillGlyphs(font, "cab");
+    CORRADE_COMPARE(font.filled.size(), 2);
+
+    /* Only the newly added glyph is uploaded */
+    cache.flush();
+    CORRADE_COMPARE_AS(backend.uploads, (std::vector<Range2Di>{
+        {{0, 0}, {8, 4}},
+        {{0, 4}, {4, 8}}
+    }), TestSuite::Compare::Container);
+}
+
+void DynamicGlyphCacheTest::fillUnusedSpaceReturned() {
+    UploadGlyphCache backend{Vector2i{8}};
+    DynamicGlyphCache cache{backend, PixelFormat::R8Unorm};
+    FakeFont font;
+
+    /* Space for x gets reserved, but the font doesn't insert it */
+    font.skipGlyph = 24;
+    cache.fillGlyphs(font, "x");
+    CORRADE_VERIFY(!cache.contains(24));
+
+    /* So the whole texture is still available even in the same frame */
+    cache.fillGlyphs(font, "abcd");
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+}
+
+void DynamicGlyphCacheTest::fillNotFoundGlyphReplaced() {
+    /* Space for six glyphs */
+    UploadGlyphCache backend{{12, 8}};
+    DynamicGlyphCache cache{backend, PixelFormat::R8Unorm};
+    FakeFont font;
+
+    /* The font rasterizes glyph 0 again with every fill. If the space it
+       occupied before wouldn't get reused, the last fill wouldn't fit. */
+    font.rasterizeNotFound = true;
+    cache.fillGlyphs(font, "a");
+    cache.fillGlyphs(font, "b");
+    cache.fillGlyphs(font, "c");
+    cache.fillGlyphs(font, "d");
+    CORRADE_COMPARE(font.filled.size(), 4);
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+    CORRADE_VERIFY(cache.contains(1));
+    CORRADE_VERIFY(cache.contains(2));
+    CORRADE_VERIFY(cache.contains(3));
+    CORRADE_VERIFY(cache.contains(4));
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+}
+
+void DynamicGlyphCacheTest::fillWholeAtlasUploaded() {
+    UploadGlyphCache backend{Vector2i{8}};
+    DynamicGlyphCache cache{backend, PixelFormat::R8Unorm};
+    FakeFont font;
+    font.wholeAtlas = true;
+
+    cache.fillGlyphs(font, "ab");
+    cache.flush();
+
+    /* The font uploads the whole texture with just c in it, but only the
+       rectangle reserved for c is taken from it */
+    cache.fillGlyphs(font, "c");
+    cache.flush();
+    CORRADE_COMPARE_AS(backend.uploads, (std::vector<Range2Di>{
+        {{0, 0}, {8, 4}},
+        {{0, 4}, {4, 8}}
+    }), TestSuite::Compare::Container);
+
+    /* Glyphs from the previous fill are still there */
+    Image2D image = cache.image();
+    std::vector<UnsignedByte> pixels;
+    for(const auto row: image.pixels<UnsignedByte>())
+        for(const UnsignedByte pixel: row) pixels.push_back(pixel);
+    CORRADE_COMPARE_AS(pixels, (std::vector<UnsignedByte>{
+        1, 1, 1, 1, 2, 2, 2, 2,
+        1, 1, 1, 1, 2, 2, 2, 2,
+        1, 1, 1, 1, 2, 2, 2, 2,
+        1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 0, 0, 0, 0,
+        3, 3, 3, 3, 0, 0, 0, 0,
+        3, 3, 3, 3, 0, 0, 0, 0,
+        3, 3, 3, 3, 0, 0, 0, 0
+    }), TestSuite::Compare::Container);
+}
+
+void DynamicGlyphCacheTest::evict() {
+    UploadGlyphCache backend{Vector2i{8}};
+    DynamicGlyphCache cache{backend, PixelFormat::R8Unorm};
+    FakeFont font;
+
+    /* Fills the whole texture */
+    cache.fillGlyphs(font, "abcd");
+    cache.flush();
+
+    /* The first glyph is the least recently used one */
+    cache.fillGlyphs(font, "e");
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 1);
+    CORRADE_VERIFY(!cache.contains(1));
+    CORRADE_VERIFY(cache.contains(5));
+    CORRADE_COMPARE(cache[5].second, (Range2Di{{0, 0}, {4, 4}}));
+
+    /* Using b makes c the least recently used one */
+    cache.fillGlyphs(font, "b");
+    cache.flush();
+    cache.fillGlyphs(font, "f");
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 2);
+    CORRADE_VERIFY(cache.contains(2));
+    CORRADE_VERIFY(!cache.contains(3));
+    CORRADE_VERIFY(cache.contains(4));
+    CORRADE_VERIFY(cache.contains(6));
+
+    /* An evicted glyph gets rasterized again when needed */
+    cache.fillGlyphs(font, "a");
+    CORRADE_COMPARE(font.filled.back(), U"a");
+    CORRADE_VERIFY(cache.contains(1));
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 3);
+}
+
+void DynamicGlyphCacheTest::evictCurrentFrame() {
+    UploadGlyphCache backend{Vector2i{8}};
+    DynamicGlyphCache cache{backend, PixelFormat::R8Unorm};
+    FakeFont font;
+
+    cache.fillGlyphs(font, "abcd");
+
+    /* All glyphs are used in the current frame, so nothing can be evicted */
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        cache.fillGlyphs(font, "e");
+    }
+    CORRADE_COMPARE(out.str(), "Text::DynamicGlyphCache::reserve(): can't fit 1 glyphs into a texture of size Vector(8, 8) even after evicting all glyphs not used in the current frame\n");
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+
+    /* The font got an empty rectangle and inserted the glyph with it anyway,
+       it's removed again and its image isn't taken */
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+    CORRADE_VERIFY(!cache.contains(5));
+    CORRADE_COMPARE(cache.image().pixels<UnsignedByte>()[0][0], 1);
+
+    /* In the next frame it's fine */
+    cache.flush();
+    cache.fillGlyphs(font, "e");
+    CORRADE_VERIFY(cache.contains(5));
+}
+
+void DynamicGlyphCacheTest::flushNothingChanged() {
+    UploadGlyphCache backend{Vector2i{8}};
+    DynamicGlyphCache cache{backend, PixelFormat::R8Unorm};
+    FakeFont font;
+
+    cache.fillGlyphs(font, "ab");
+    cache.flush();
+    CORRADE_COMPARE(backend.uploads.size(), 1);
+
+    /* Just using glyphs that are there doesn't upload anything, the frame is
+       advanced nevertheless */
+    cache.fillGlyphs(font, "ba");
+    cache.flush();
+    CORRADE_COMPARE(backend.uploads.size(), 1);
+    CORRADE_COMPARE(cache.frame(), 2);
+}
+
+void DynamicGlyphCacheTest::setImageInvalidFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UploadGlyphCache backend{Vector2i{8}};
+    DynamicGlyphCache cache{backend, PixelFormat::R8Unorm};
+
+    const char data[4]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.setImage({}, ImageView2D{PixelFormat::RG8Unorm, {1, 1}, data});
+    CORRADE_COMPARE(out.str(), "Text::DynamicGlyphCache::setImage(): expected PixelFormat::R8Unorm but got PixelFormat::RG8Unorm\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::DynamicGlyphCacheTest)
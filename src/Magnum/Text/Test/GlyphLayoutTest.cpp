@@ -0,0 +1,337 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/Text/GlyphLayout.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct GlyphLayoutTest: TestSuite::Tester {
+    explicit GlyphLayoutTest();
+
+    void layout();
+    void layoutMultiline();
+    void layoutUnknownGlyph();
+    void layoutBatch();
+    void layoutViewSizeMismatch();
+    void layoutViewTooSmall();
+    void layoutBatchViewSizeMismatch();
+
+    void indexType();
+    void indices();
+    void indicesInvalidSize();
+    void indicesOutOfRange();
+
+    void benchmarkLayoutBatch();
+};
+
+GlyphLayoutTest::GlyphLayoutTest() {
+    addTests({&GlyphLayoutTest::layout,
+              &GlyphLayoutTest::layoutMultiline,
+              &GlyphLayoutTest::layoutUnknownGlyph,
+              &GlyphLayoutTest::layoutBatch,
+              &GlyphLayoutTest::layoutViewSizeMismatch,
+              &GlyphLayoutTest::layoutViewTooSmall,
+              &GlyphLayoutTest::layoutBatchViewSizeMismatch,
+
+              &GlyphLayoutTest::indexType,
+              &GlyphLayoutTest::indices,
+              &GlyphLayoutTest::indicesInvalidSize,
+              &GlyphLayoutTest::indicesOutOfRange});
+
+    addBenchmarks({&GlyphLayoutTest::benchmarkLayoutBatch}, 10);
+}
+
+/* Font of size 2 with line height 3, 'a' being glyph 1 and 'b' glyph 2,
+   everything else glyph 0 */
+struct DummyFont: AbstractFont {
+    FontFeatures doFeatures() const override { return FontFeature::OpenData; }
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override {}
+
+    Metrics doOpenData(Containers::ArrayView<const char>, Float) override {
+        _opened = true;
+        return {2.0f, 1.0f, -1.0f, 3.0f};
+    }
+
+    UnsignedInt doGlyphId(char32_t character) override {
+        if(character == 'a') return 1;
+        if(character == 'b') return 2;
+        return 0;
+    }
+
+    Vector2 doGlyphAdvance(UnsignedInt glyph) override {
+        if(glyph == 1) return {3.0f, 0.0f};
+        if(glyph == 2) return {2.0f, 0.0f};
+        return {};
+    }
+
+    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override {
+        return nullptr;
+    }
+
+    bool _opened = false;
+};
+
+struct DummyGlyphCache: AbstractGlyphCache {
+    explicit DummyGlyphCache(): AbstractGlyphCache{{16, 8}} {
+        insert(1, {1, 0}, {{0, 0}, {4, 8}});
+        insert(2, {0, -1}, {{8, 4}, {12, 8}});
+    }
+
+    GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+void GlyphLayoutTest::layout() {
+    DummyFont font;
+    font.openData(nullptr, 0.0f);
+    DummyGlyphCache cache;
+
+    Vector2 positions[8];
+    Vector2 textureCoordinates[8];
+
+    /* Rendering at twice the font size */
+    const std::pair<UnsignedInt, Range2D> out = layoutGlyphQuadsInto(font, cache, 4.0f, Alignment::LineLeft, "ab", positions, textureCoordinates);
+    CORRADE_COMPARE(out.first, 2);
+    CORRADE_COMPARE(out.second, (Range2D{{2.0f, -2.0f}, {14.0f, 16.0f}}));
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView<Vector2>({
+        {2.0f, 16.0f}, {2.0f, 0.0f}, {10.0f, 16.0f}, {10.0f, 0.0f},
+        {6.0f, 6.0f}, {6.0f, -2.0f}, {14.0f, 6.0f}, {14.0f, -2.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(textureCoordinates), Containers::arrayView<Vector2>({
+        {0.0f, 1.0f}, {0.0f, 0.0f}, {0.25f, 1.0f}, {0.25f, 0.0f},
+        {0.5f, 1.0f}, {0.5f, 0.5f}, {0.75f, 1.0f}, {0.75f, 0.5f}
+    }), TestSuite::Compare::Container);
+}
+
+void GlyphLayoutTest::layoutMultiline() {
+    DummyFont font;
+    font.openData(nullptr, 0.0f);
+    DummyGlyphCache cache;
+
+    /* The empty line in the middle only advances the cursor */
+    Vector2 positions[8];
+    Vector2 textureCoordinates[8];
+    const std::pair<UnsignedInt, Range2D> out = layoutGlyphQuadsInto(font, cache, 4.0f, Alignment::MiddleCenter, "a\n\nb", positions, textureCoordinates);
+    CORRADE_COMPARE(out.first, 2);
+    CORRADE_COMPARE(out.second, (Range2D{{-4.0f, -15.0f}, {4.0f, 15.0f}}));
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView<Vector2>({
+        {-4.0f, 15.0f}, {-4.0f, -1.0f}, {4.0f, 15.0f}, {4.0f, -1.0f},
+        {-4.0f, -7.0f}, {-4.0f, -15.0f}, {4.0f, -7.0f}, {4.0f, -15.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void GlyphLayoutTest::layoutUnknownGlyph() {
+    DummyFont font;
+    font.openData(nullptr, 0.0f);
+    DummyGlyphCache cache;
+
+    /* Multi-byte characters result in a single glyph, unknown glyphs use the
+       glyph 0 from the cache, which is empty by default */
+    Vector2 positions[12];
+    Vector2 textureCoordinates[12];
+    const std::pair<UnsignedInt, Range2D> out = layoutGlyphQuadsInto(font, cache, 2.0f, Alignment::LineLeft, "\xc4\x9b" "ba", positions, textureCoordinates);
+    CORRADE_COMPARE(out.first, 3);
+    CORRADE_COMPARE(positions[0], Vector2{});
+    CORRADE_COMPARE(positions[3], Vector2{});
+    CORRADE_COMPARE(positions[4], (Vector2{0.0f, 3.0f}));
+    CORRADE_COMPARE(positions[8], (Vector2{3.0f, 8.0f}));
+}
+
+void GlyphLayoutTest::layoutBatch() {
+    DummyFont font;
+    font.openData(nullptr, 0.0f);
+    DummyGlyphCache cache;
+
+    const std::string texts[]{"ab", "", "b"};
+    Vector2 positions[12];
+    Vector2 textureCoordinates[12];
+    UnsignedInt glyphOffsets[3];
+    Range2D rectangles[3];
+    CORRADE_COMPARE(layoutGlyphQuadsInto(font, cache, 4.0f, Alignment::LineLeft, texts, positions, textureCoordinates, glyphOffsets, rectangles), 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphOffsets), Containers::arrayView<UnsignedInt>({
+        0, 2, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(rectangles), Containers::arrayView<Range2D>({
+        {{2.0f, -2.0f}, {14.0f, 16.0f}},
+        {},
+        {{0.0f, -2.0f}, {8.0f, 6.0f}}
+    }), TestSuite::Compare::Container);
+
+    /* Each text is laid out relative to the origin */
+    CORRADE_COMPARE_AS(Containers::arrayView(positions).suffix(8), Containers::arrayView<Vector2>({
+        {0.0f, 6.0f}, {0.0f, -2.0f}, {8.0f, 6.0f}, {8.0f, -2.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(textureCoordinates[8], (Vector2{0.5f, 1.0f}));
+}
+
+void GlyphLayoutTest::layoutViewSizeMismatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyFont font;
+    font.openData(nullptr, 0.0f);
+    DummyGlyphCache cache;
+
+    Vector2 positions[8];
+    Vector2 textureCoordinates[7];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    layoutGlyphQuadsInto(font, cache, 4.0f, Alignment::LineLeft, "ab", positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(), "Text::layoutGlyphQuadsInto(): expected vertex position and texture coordinate views to have the same size but got 8 and 7\n");
+}
+
+void GlyphLayoutTest::layoutViewTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyFont font;
+    font.openData(nullptr, 0.0f);
+    DummyGlyphCache cache;
+
+    Vector2 positions[7];
+    Vector2 textureCoordinates[7];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    layoutGlyphQuadsInto(font, cache, 4.0f, Alignment::LineLeft, "ab", positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(), "Text::layoutGlyphQuadsInto(): expected views to have at least 8 elements but got 7\n");
+}
+
+void GlyphLayoutTest::layoutBatchViewSizeMismatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyFont font;
+    font.openData(nullptr, 0.0f);
+    DummyGlyphCache cache;
+
+    const std::string texts[3];
+    UnsignedInt glyphOffsets[3];
+    Range2D rectangles[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    layoutGlyphQuadsInto(font, cache, 4.0f, Alignment::LineLeft, texts, nullptr, nullptr, glyphOffsets, rectangles);
+    CORRADE_COMPARE(out.str(), "Text::layoutGlyphQuadsInto(): expected glyph offset and rectangle views to have 3 elements but got 3 and 2\n");
+}
+
+void GlyphLayoutTest::indexType() {
+    CORRADE_COMPARE(glyphQuadIndexType(0), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(glyphQuadIndexType(64), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(glyphQuadIndexType(65), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(glyphQuadIndexType(16384), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(glyphQuadIndexType(16385), MeshIndexType::UnsignedInt);
+}
+
+void GlyphLayoutTest::indices() {
+    UnsignedShort indices[12];
+    glyphQuadIndicesInto(1, indices);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<UnsignedShort>({
+        4, 5, 6, 5, 7, 6,
+        8, 9, 10, 9, 11, 10
+    }), TestSuite::Compare::Container);
+
+    /* The last glyph that still fits into 8-bit indices */
+    UnsignedByte byteIndices[6];
+    glyphQuadIndicesInto(63, byteIndices);
+    CORRADE_COMPARE_AS(Containers::arrayView(byteIndices), Containers::arrayView<UnsignedByte>({
+        252, 253, 254, 253, 255, 254
+    }), TestSuite::Compare::Container);
+
+    /* Strided output, such as when interleaving with other data */
+    UnsignedInt stridedIndices[12]{};
+    glyphQuadIndicesInto(0, Containers::stridedArrayView(stridedIndices).every(2));
+    CORRADE_COMPARE_AS(Containers::arrayView(stridedIndices), Containers::arrayView<UnsignedInt>({
+        0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 2, 0
+    }), TestSuite::Compare::Container);
+}
+
+void GlyphLayoutTest::indicesInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[7];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    glyphQuadIndicesInto(0, indices);
+    CORRADE_COMPARE(out.str(), "Text::glyphQuadIndicesInto(): expected the index count to be divisible by 6 but got 7\n");
+}
+
+void GlyphLayoutTest::indicesOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedByte indices[12];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    glyphQuadIndicesInto(63, indices);
+    CORRADE_COMPARE(out.str(), "Text::glyphQuadIndicesInto(): glyphs 63 to 65 can't be indexed with 8-bit indices\n");
+}
+
+void GlyphLayoutTest::benchmarkLayoutBatch() {
+    DummyFont font;
+    font.openData(nullptr, 0.0f);
+    DummyGlyphCache cache;
+
+    std::vector<std::string> texts(1000, "abba\nbaab");
+    Containers::Array<Vector2> positions{Containers::NoInit, texts.size()*8*4};
+    Containers::Array<Vector2> textureCoordinates{Containers::NoInit, texts.size()*8*4};
+    Containers::Array<UnsignedInt> glyphOffsets{Containers::NoInit, texts.size()};
+    Containers::Array<Range2D> rectangles{Containers::NoInit, texts.size()};
+
+    UnsignedInt glyphCount = 0;
+    CORRADE_BENCHMARK(10) {
+        glyphCount += layoutGlyphQuadsInto(font, cache, 4.0f, Alignment::MiddleCenter, Containers::arrayView(texts), positions, textureCoordinates, glyphOffsets, rectangles);
+    }
+
+    CORRADE_COMPARE(glyphCount, 10*texts.size()*8);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::GlyphLayoutTest)
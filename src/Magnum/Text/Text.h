@@ -43,6 +43,7 @@ class AbstractLayouter;
 enum class Alignment: UnsignedByte;
 
 class AbstractGlyphCache;
+class DynamicGlyphCache;
 #ifdef MAGNUM_TARGET_GL
 class DistanceFieldGlyphCache;
 class GlyphCache;
@@ -0,0 +1,352 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Mipmap.h"
+
+#include <new>
+#include <cmath>
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/PackingBatch.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+enum class Encoding: UnsignedByte {
+    Unorm8,
+    Srgb8,
+    Float
+};
+
+struct FormatProperties {
+    Encoding encoding;
+    /* Zero for unsupported formats */
+    UnsignedInt channelCount;
+};
+
+FormatProperties formatProperties(const PixelFormat format) {
+    switch(format) {
+        case PixelFormat::R8Unorm: return {Encoding::Unorm8, 1};
+        case PixelFormat::RG8Unorm: return {Encoding::Unorm8, 2};
+        case PixelFormat::RGB8Unorm: return {Encoding::Unorm8, 3};
+        case PixelFormat::RGBA8Unorm: return {Encoding::Unorm8, 4};
+        case PixelFormat::R8Srgb: return {Encoding::Srgb8, 1};
+        case PixelFormat::RG8Srgb: return {Encoding::Srgb8, 2};
+        case PixelFormat::RGB8Srgb: return {Encoding::Srgb8, 3};
+        case PixelFormat::RGBA8Srgb: return {Encoding::Srgb8, 4};
+        case PixelFormat::R32F: return {Encoding::Float, 1};
+        case PixelFormat::RG32F: return {Encoding::Float, 2};
+        case PixelFormat::RGB32F: return {Encoding::Float, 3};
+        case PixelFormat::RGBA32F: return {Encoding::Float, 4};
+        default: return {Encoding::Unorm8, 0};
+    }
+}
+
+inline UnsignedByte packUnorm8(const Float value) {
+    return UnsignedByte(Math::clamp(value, 0.0f, 1.0f)*255.0f + 0.5f);
+}
+
+/* Unpacks the image into a tightly packed float array */
+void decode(const Containers::StridedArrayView3D<const char>& pixels, const FormatProperties& properties, Float* out) {
+    const std::size_t width = pixels.size()[1];
+    const UnsignedInt channelCount = properties.channelCount;
+    /* Alpha is always linear */
+    const UnsignedInt srgbChannelCount = Math::min(channelCount, 3u);
+
+    for(std::size_t y = 0, yMax = pixels.size()[0]; y != yMax; ++y) {
+        /* Pixels in a row are always contiguous */
+        const char* row = static_cast<const char*>(pixels[y].data());
+        Float* outRow = out + y*width*channelCount;
+
+        if(properties.encoding == Encoding::Float) {
+            const Float* in = reinterpret_cast<const Float*>(row);
+            for(std::size_t i = 0, iMax = width*channelCount; i != iMax; ++i)
+                outRow[i] = in[i];
+        } else if(properties.encoding == Encoding::Unorm8) {
+            const UnsignedByte* in = reinterpret_cast<const UnsignedByte*>(row);
+            for(std::size_t i = 0, iMax = width*channelCount; i != iMax; ++i)
+                outRow[i] = in[i]/255.0f;
+        } else {
+            const Containers::StridedArrayView2D<const UnsignedByte> in{
+                {reinterpret_cast<const UnsignedByte*>(row), width*channelCount},
+                {width, channelCount}};
+            const Containers::StridedArrayView2D<Float> outView{
+                {outRow, width*channelCount}, {width, channelCount}};
+            Math::fromSrgbInto(in.prefix({width, srgbChannelCount}), outView.prefix({width, srgbChannelCount}));
+            if(channelCount == 4)
+                Math::unpackInto(in.suffix({0, 3}), outView.suffix({0, 3}));
+        }
+    }
+}
+
+/* Packs a tightly packed float array into the image */
+void encode(const Float* in, const FormatProperties& properties, const Containers::StridedArrayView3D<char>& pixels) {
+    const std::size_t width = pixels.size()[1];
+    const UnsignedInt channelCount = properties.channelCount;
+    const UnsignedInt srgbChannelCount = Math::min(channelCount, 3u);
+
+    for(std::size_t y = 0, yMax = pixels.size()[0]; y != yMax; ++y) {
+        char* row = static_cast<char*>(pixels[y].data());
+        const Float* inRow = in + y*width*channelCount;
+
+        if(properties.encoding == Encoding::Float) {
+            Float* out = reinterpret_cast<Float*>(row);
+            for(std::size_t i = 0, iMax = width*channelCount; i != iMax; ++i)
+                out[i] = inRow[i];
+        } else if(properties.encoding == Encoding::Unorm8) {
+            UnsignedByte* out = reinterpret_cast<UnsignedByte*>(row);
+            for(std::size_t i = 0, iMax = width*channelCount; i != iMax; ++i)
+                out[i] = packUnorm8(inRow[i]);
+        } else {
+            /* Clamping is done by toSrgbInto() itself */
+            const Containers::StridedArrayView2D<const Float> inView{
+                {inRow, width*channelCount}, {width, channelCount}};
+            const Containers::StridedArrayView2D<UnsignedByte> out{
+                {reinterpret_cast<UnsignedByte*>(row), width*channelCount},
+                {width, channelCount}};
+            Math::toSrgbInto(inView.prefix({width, srgbChannelCount}), out.prefix({width, srgbChannelCount}));
+            if(channelCount == 4) {
+                UnsignedByte* alpha = reinterpret_cast<UnsignedByte*>(row) + 3;
+                for(std::size_t x = 0; x != width; ++x)
+                    alpha[x*4] = packUnorm8(inRow[x*4 + 3]);
+            }
+        }
+    }
+}
+
+/* Zeroth-order modified Bessel function of the first kind, used by the
+   Kaiser window. The series converges quickly for the alpha we use. */
+Float besselI0(const Float x) {
+    Float sum = 1.0f;
+    Float term = 1.0f;
+    const Float halfX = x*0.5f;
+    for(UnsignedInt k = 1; k != 32; ++k) {
+        term *= halfX/k;
+        const Float squared = term*term;
+        sum += squared;
+        if(squared < sum*1.0e-8f) break;
+    }
+    return sum;
+}
+
+constexpr Float KaiserRadius = 3.0f;
+constexpr Float KaiserAlpha = 4.0f;
+
+/* For each destination pixel along one axis a fixed count of source indices
+   (clamped to the edge) and normalized weights */
+struct Weights {
+    UnsignedInt tapCount;
+    Containers::Array<Int> indices;
+    Containers::Array<Float> weights;
+};
+
+Weights computeWeights(const Int sourceSize, const Int destinationSize, const MipmapFilter filter) {
+    Weights out;
+
+    /* Nothing to filter along this axis */
+    if(sourceSize == destinationSize) {
+        out.tapCount = 1;
+        out.indices = Containers::Array<Int>{Containers::NoInit, std::size_t(destinationSize)};
+        out.weights = Containers::Array<Float>{Containers::NoInit, std::size_t(destinationSize)};
+        for(Int i = 0; i != destinationSize; ++i) {
+            out.indices[i] = i;
+            out.weights[i] = 1.0f;
+        }
+        return out;
+    }
+
+    const Float scale = Float(sourceSize)/Float(destinationSize);
+    const Float support = filter == MipmapFilter::Box ? scale*0.5f : scale*KaiserRadius;
+    out.tapCount = UnsignedInt(std::ceil(support*2.0f)) + 1;
+    out.indices = Containers::Array<Int>{Containers::ValueInit, std::size_t(destinationSize)*out.tapCount};
+    out.weights = Containers::Array<Float>{Containers::ValueInit, std::size_t(destinationSize)*out.tapCount};
+    const Float kaiserNormalization = 1.0f/besselI0(KaiserAlpha);
+
+    for(Int i = 0; i != destinationSize; ++i) {
+        const Float center = (i + 0.5f)*scale;
+        const Int first = Int(std::floor(center - support));
+        Int* indices = out.indices + i*out.tapCount;
+        Float* weights = out.weights + i*out.tapCount;
+
+        Float sum = 0.0f;
+        for(UnsignedInt t = 0; t != out.tapCount; ++t) {
+            const Int j = first + Int(t);
+            Float weight;
+            if(filter == MipmapFilter::Box) {
+                /* Overlap of the source pixel with the destination pixel
+                   footprint */
+                weight = Math::max(0.0f, Math::min(j + 1.0f, center + support) - Math::max(Float(j), center - support));
+            } else {
+                /* Distance in destination pixels */
+                const Float x = (j + 0.5f - center)/scale;
+                if(std::abs(x) >= KaiserRadius) weight = 0.0f;
+                else {
+                    const Float sinc = x == 0.0f ? 1.0f :
+                        std::sin(Constants::pi()*x)/(Constants::pi()*x);
+                    const Float r = x/KaiserRadius;
+                    weight = sinc*besselI0(KaiserAlpha*std::sqrt(1.0f - r*r))*kaiserNormalization;
+                }
+            }
+
+            indices[t] = Math::clamp(j, 0, sourceSize - 1);
+            weights[t] = weight;
+            sum += weight;
+        }
+
+        for(UnsignedInt t = 0; t != out.tapCount; ++t)
+            weights[t] /= sum;
+    }
+
+    return out;
+}
+
+/* Separable passes. The channel count is a template parameter so the inner
+   loops can get fully unrolled and vectorized. */
+template<UnsignedInt channelCount> void filterRows(const Float* const in, const Int inWidth, Float* const out, const Int outWidth, const Int height, const Weights& weights) {
+    for(Int y = 0; y != height; ++y) {
+        const Float* inRow = in + std::size_t(y)*inWidth*channelCount;
+        Float* outRow = out + std::size_t(y)*outWidth*channelCount;
+        for(Int x = 0; x != outWidth; ++x) {
+            const Int* indices = weights.indices + x*weights.tapCount;
+            const Float* w = weights.weights + x*weights.tapCount;
+            Float sum[channelCount]{};
+            for(UnsignedInt t = 0; t != weights.tapCount; ++t) {
+                const Float* pixel = inRow + indices[t]*channelCount;
+                for(UnsignedInt c = 0; c != channelCount; ++c)
+                    sum[c] += w[t]*pixel[c];
+            }
+            for(UnsignedInt c = 0; c != channelCount; ++c)
+                outRow[x*channelCount + c] = sum[c];
+        }
+    }
+}
+
+void filterColumns(const Float* const in, Float* const out, const std::size_t rowLength, const Int outHeight, const Weights& weights) {
+    /* Processing whole rows at a time, which keeps the memory access
+       sequential and the inner loop trivially vectorizable */
+    for(Int y = 0; y != outHeight; ++y) {
+        const Int* indices = weights.indices + y*weights.tapCount;
+        const Float* w = weights.weights + y*weights.tapCount;
+        Float* outRow = out + y*rowLength;
+        for(std::size_t i = 0; i != rowLength; ++i) outRow[i] = 0.0f;
+        for(UnsignedInt t = 0; t != weights.tapCount; ++t) {
+            const Float* inRow = in + indices[t]*rowLength;
+            const Float weight = w[t];
+            for(std::size_t i = 0; i != rowLength; ++i)
+                outRow[i] += weight*inRow[i];
+        }
+    }
+}
+
+}
+
+Debug& operator<<(Debug& debug, const MipmapFilter value) {
+    debug << "TextureTools::MipmapFilter" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case MipmapFilter::v: return debug << "::" #v;
+        _c(Box)
+        _c(Kaiser)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+UnsignedInt mipmapLevelCount(const Vector2i& size) {
+    CORRADE_ASSERT(size.product(),
+        "TextureTools::mipmapLevelCount(): expected non-zero size, got" << size, {});
+    return Math::log2(UnsignedInt(size.max())) + 1;
+}
+
+bool isMipmapFormatSupported(const PixelFormat format) {
+    return formatProperties(format).channelCount;
+}
+
+Containers::Array<Image2D> mipmaps(const ImageView2D& image, const MipmapFilter filter) {
+    CORRADE_ASSERT(image.size().product(),
+        "TextureTools::mipmaps(): expected non-zero image size, got" << image.size(), {});
+    const FormatProperties properties = formatProperties(image.format());
+    CORRADE_ASSERT(properties.channelCount,
+        "TextureTools::mipmaps(): unsupported format" << image.format(), {});
+
+    const UnsignedInt channelCount = properties.channelCount;
+    const UnsignedInt pixelSize = image.pixelSize();
+    const UnsignedInt levelCount = mipmapLevelCount(image.size());
+    Containers::Array<Image2D> out{Containers::NoInit, levelCount - 1};
+
+    /* Current level, next level and a scratch buffer for the horizontal
+       pass, all sized for the base level and reused for the (smaller) levels
+       that follow */
+    Vector2i size = image.size();
+    Containers::Array<Float> current{Containers::NoInit, std::size_t(size.product())*channelCount};
+    Containers::Array<Float> next{Containers::NoInit, std::size_t(size.product())*channelCount};
+    Containers::Array<Float> horizontal{Containers::NoInit, std::size_t(size.product())*channelCount};
+    decode(image.pixels(), properties, current);
+
+    for(UnsignedInt level = 0; level != levelCount - 1; ++level) {
+        const Vector2i nextSize = Math::max(size/2, Vector2i{1});
+
+        /* Horizontal pass from current to the scratch buffer */
+        const Weights horizontalWeights = computeWeights(size.x(), nextSize.x(), filter);
+        switch(channelCount) {
+            case 1: filterRows<1>(current, size.x(), horizontal, nextSize.x(), size.y(), horizontalWeights); break;
+            case 2: filterRows<2>(current, size.x(), horizontal, nextSize.x(), size.y(), horizontalWeights); break;
+            case 3: filterRows<3>(current, size.x(), horizontal, nextSize.x(), size.y(), horizontalWeights); break;
+            case 4: filterRows<4>(current, size.x(), horizontal, nextSize.x(), size.y(), horizontalWeights); break;
+            default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        }
+
+        /* Vertical pass from the scratch buffer to the next level */
+        const Weights verticalWeights = computeWeights(size.y(), nextSize.y(), filter);
+        filterColumns(horizontal, next, std::size_t(nextSize.x())*channelCount, nextSize.y(), verticalWeights);
+
+        /* Pack the result into an image with default four-byte row
+           alignment */
+        const std::size_t rowStride = (std::size_t(nextSize.x())*pixelSize + 3)/4*4;
+        new(&out[level]) Image2D{image.format(), nextSize, Containers::Array<char>{Containers::ValueInit, rowStride*nextSize.y()}};
+        encode(next, properties, out[level].pixels());
+
+        std::swap(current, next);
+        size = nextSize;
+    }
+
+    return out;
+}
+
+}}
@@ -0,0 +1,132 @@
+#ifndef Magnum_TextureTools_Mipmap_h
+#define Magnum_TextureTools_Mipmap_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::mipmaps(), @ref Magnum::TextureTools::mipmapLevelCount(), @ref Magnum::TextureTools::isMipmapFormatSupported(), enum @ref Magnum::TextureTools::MipmapFilter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Mipmap filter
+@m_since_latest
+
+@see @ref mipmaps()
+*/
+enum class MipmapFilter: UnsignedByte {
+    /**
+     * Box filter. Each pixel of the next level is an area-weighted average of
+     * the pixels it covers in the previous level, which for even sizes is the
+     * usual 2x2 average. Fast, but prone to aliasing on high-frequency
+     * content.
+     */
+    Box,
+
+    /**
+     * Kaiser-windowed sinc filter with a radius of three pixels of the next
+     * level and @f$ \alpha = 4 @f$. Produces sharper mip levels with less
+     * aliasing than @ref MipmapFilter::Box, at the cost of being several
+     * times slower. The negative lobes can cause slight ringing around hard
+     * edges, results are clamped to the representable range.
+     */
+    Kaiser
+};
+
+/**
+@debugoperatorenum{MipmapFilter}
+@m_since_latest
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, MipmapFilter value);
+
+/**
+@brief Mip level count for given image size
+@m_since_latest
+
+Returns @f$ \lfloor \log_2 \max(w, h) \rfloor + 1 @f$, which is the count of
+levels in a full mip chain including the base level. Expects that the size is
+non-zero in both dimensions.
+@see @ref mipmaps(), @ref Math::log2()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT UnsignedInt mipmapLevelCount(const Vector2i& size);
+
+/**
+@brief Whether a mip chain can be generated for given format
+@m_since_latest
+
+Returns @cpp true @ce if @p format can be passed to @ref mipmaps(),
+@cpp false @ce otherwise. Implementation-specific pixel formats are never
+supported.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT bool isMipmapFormatSupported(PixelFormat format);
+
+/**
+@brief Generate a mip chain for an image
+@param image    Base level
+@param filter   Filter to use
+@m_since_latest
+
+Returns @ref mipmapLevelCount() minus one images, with the first one being
+level @cpp 1 @ce. Each level is half the size of the previous one, rounded
+down and clamped to @cpp 1 @ce, and has the same format as @p image with
+default @ref PixelStorage. Every level is filtered from a floating-point
+version of the previous one, so quantization errors don't accumulate along
+the chain.
+
+Supported formats are @ref PixelFormat::R8Unorm, @ref PixelFormat::RG8Unorm,
+@ref PixelFormat::RGB8Unorm, @ref PixelFormat::RGBA8Unorm, their sRGB variants
+and @ref PixelFormat::R32F, @ref PixelFormat::RG32F, @ref PixelFormat::RGB32F
+and @ref PixelFormat::RGBA32F. For the sRGB formats the color channels are
+converted to linear space before filtering and back after, so the levels
+don't get darker as with naive averaging of sRGB values; the alpha channel is
+filtered as-is. Use @ref isMipmapFormatSupported() to check a format upfront.
+Expects that the image size is non-zero.
+
+The filtering is done separably on contiguous float rows with precomputed
+weights, in a form that compilers are able to vectorize. Pass the base level
+together with the result to
+@ref Trade::AbstractImageConverter::exportLevelsToFile() to save the whole
+chain:
+
+@snippet MagnumTextureTools.cpp mipmaps
+
+Saving multiple levels needs a converter plugin supporting
+@ref Trade::ImageConverterFeature::ConvertLevels. None of the converters
+bundled with Magnum itself support it at the moment, so a third-party plugin
+has to be used.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Containers::Array<Image2D> mipmaps(const ImageView2D& image, MipmapFilter filter = MipmapFilter::Box);
+
+}}
+
+#endif
@@ -0,0 +1,229 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/TextureTools/Mipmap.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct MipmapTest: TestSuite::Tester {
+    explicit MipmapTest();
+
+    void levelCount();
+    void levelCountZeroSize();
+    void formatSupported();
+
+    void box();
+    void boxOddSize();
+    void boxSrgb();
+    void boxFloat();
+    void boxNonSquare();
+    void kaiserConstant();
+
+    void zeroSize();
+    void unsupportedFormat();
+
+    void debugFilter();
+};
+
+MipmapTest::MipmapTest() {
+    addTests({&MipmapTest::levelCount,
+              &MipmapTest::levelCountZeroSize,
+              &MipmapTest::formatSupported,
+
+              &MipmapTest::box,
+              &MipmapTest::boxOddSize,
+              &MipmapTest::boxSrgb,
+              &MipmapTest::boxFloat,
+              &MipmapTest::boxNonSquare,
+              &MipmapTest::kaiserConstant,
+
+              &MipmapTest::zeroSize,
+              &MipmapTest::unsupportedFormat,
+
+              &MipmapTest::debugFilter});
+}
+
+void MipmapTest::levelCount() {
+    CORRADE_COMPARE(mipmapLevelCount({1, 1}), 1);
+    CORRADE_COMPARE(mipmapLevelCount({2, 1}), 2);
+    CORRADE_COMPARE(mipmapLevelCount({3, 3}), 2);
+    CORRADE_COMPARE(mipmapLevelCount({256, 256}), 9);
+    CORRADE_COMPARE(mipmapLevelCount({17, 300}), 9);
+}
+
+void MipmapTest::levelCountZeroSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    mipmapLevelCount({4, 0});
+    CORRADE_COMPARE(out.str(), "TextureTools::mipmapLevelCount(): expected non-zero size, got Vector(4, 0)\n");
+}
+
+void MipmapTest::formatSupported() {
+    CORRADE_VERIFY(isMipmapFormatSupported(PixelFormat::RGBA8Unorm));
+    CORRADE_VERIFY(isMipmapFormatSupported(PixelFormat::RG8Srgb));
+    CORRADE_VERIFY(isMipmapFormatSupported(PixelFormat::R32F));
+    CORRADE_VERIFY(!isMipmapFormatSupported(PixelFormat::RGBA16Unorm));
+    CORRADE_VERIFY(!isMipmapFormatSupported(PixelFormat::Depth32F));
+    CORRADE_VERIFY(!isMipmapFormatSupported(pixelFormatWrap(0xdead)));
+}
+
+void MipmapTest::box() {
+    const UnsignedByte data[]{
+         0, 10, 20, 30,
+        40, 50, 60, 70
+    };
+    Containers::Array<Image2D> levels = mipmaps(ImageView2D{PixelFormat::R8Unorm, {4, 2}, data});
+    CORRADE_COMPARE(levels.size(), 2);
+
+    CORRADE_COMPARE(levels[0].format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(levels[0].size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE_AS(levels[0].pixels<UnsignedByte>()[0],
+        Containers::arrayView<UnsignedByte>({25, 45}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(levels[1].size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE(levels[1].pixels<UnsignedByte>()[0][0], 35);
+}
+
+void MipmapTest::boxOddSize() {
+    /* Every source pixel contributes with the same weight, nothing gets
+       dropped */
+    const UnsignedByte data[]{0, 30, 90, 0};
+    Containers::Array<Image2D> levels = mipmaps(ImageView2D{PixelFormat::R8Unorm, {3, 1}, data});
+    CORRADE_COMPARE(levels.size(), 1);
+    CORRADE_COMPARE(levels[0].size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE(levels[0].pixels<UnsignedByte>()[0][0], 40);
+}
+
+void MipmapTest::boxSrgb() {
+    /* A black & white checkerboard should average to 50% linear gray, which
+       is 188 in sRGB, not 128. Alpha is filtered linearly. */
+    const Color4ub data[]{
+        {0, 0, 0, 0}, {255, 255, 255, 255},
+        {255, 255, 255, 255}, {0, 0, 0, 0}
+    };
+    Containers::Array<Image2D> levels = mipmaps(ImageView2D{PixelFormat::RGBA8Srgb, {2, 2}, data});
+    CORRADE_COMPARE(levels.size(), 1);
+    CORRADE_COMPARE(levels[0].format(), PixelFormat::RGBA8Srgb);
+    CORRADE_COMPARE(levels[0].pixels<Color4ub>()[0][0], (Color4ub{188, 188, 188, 128}));
+
+    /* The same data as non-sRGB average to 128 */
+    Containers::Array<Image2D> linear = mipmaps(ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, data});
+    CORRADE_COMPARE(linear[0].pixels<Color4ub>()[0][0], (Color4ub{128, 128, 128, 128}));
+}
+
+void MipmapTest::boxFloat() {
+    const Vector2 data[]{
+        {1.0f, -2.0f}, {3.0f, 4.0f},
+        {5.0f, 6.0f}, {7.0f, 8.0f}
+    };
+    Containers::Array<Image2D> levels = mipmaps(ImageView2D{PixelFormat::RG32F, {2, 2}, data});
+    CORRADE_COMPARE(levels.size(), 1);
+    CORRADE_COMPARE(levels[0].pixels<Vector2>()[0][0], (Vector2{4.0f, 4.0f}));
+}
+
+void MipmapTest::boxNonSquare() {
+    /* 1x4, the narrow dimension stays at one pixel */
+    const Color3ub data[]{
+        {0, 100, 200}, {0, 0, 0},
+        {40, 40, 40}, {80, 80, 80}
+    };
+    /* Rows are just three bytes, no padding */
+    ImageView2D image{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {1, 4}, data};
+    Containers::Array<Image2D> levels = mipmaps(image);
+    CORRADE_COMPARE(levels.size(), 2);
+    CORRADE_COMPARE(levels[0].size(), (Vector2i{1, 2}));
+    CORRADE_COMPARE(levels[0].pixels<Color3ub>()[0][0], (Color3ub{0, 50, 100}));
+    CORRADE_COMPARE(levels[0].pixels<Color3ub>()[1][0], (Color3ub{60, 60, 60}));
+    CORRADE_COMPARE(levels[1].size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE(levels[1].pixels<Color3ub>()[0][0], (Color3ub{30, 55, 80}));
+}
+
+void MipmapTest::kaiserConstant() {
+    /* The weights are normalized, so a constant image stays constant even
+       with the negative lobes and edge clamping */
+    Color4ub data[8*8];
+    for(Color4ub& i: data) i = {100, 150, 200, 255};
+
+    Containers::Array<Image2D> levels = mipmaps(ImageView2D{PixelFormat::RGBA8Unorm, {8, 8}, data}, MipmapFilter::Kaiser);
+    CORRADE_COMPARE(levels.size(), 3);
+    for(std::size_t i = 0; i != levels.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(levels[i].size(), Vector2i{4 >> i});
+        for(const Containers::StridedArrayView1D<const Color4ub> row: levels[i].pixels<Color4ub>())
+            for(const Color4ub& pixel: row)
+                CORRADE_COMPARE(pixel, (Color4ub{100, 150, 200, 255}));
+    }
+}
+
+void MipmapTest::zeroSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    mipmaps(ImageView2D{PixelFormat::RGBA8Unorm, {0, 4}, nullptr});
+    CORRADE_COMPARE(out.str(), "TextureTools::mipmaps(): expected non-zero image size, got Vector(0, 4)\n");
+}
+
+void MipmapTest::unsupportedFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char data[16]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    mipmaps(ImageView2D{PixelFormat::RGBA16Unorm, {2, 1}, data});
+    CORRADE_COMPARE(out.str(), "TextureTools::mipmaps(): unsupported format PixelFormat::RGBA16Unorm\n");
+}
+
+void MipmapTest::debugFilter() {
+    std::ostringstream out;
+    Debug{&out} << MipmapFilter::Kaiser << MipmapFilter(0xde);
+    CORRADE_COMPARE(out.str(), "TextureTools::MipmapFilter::Kaiser TextureTools::MipmapFilter(0xde)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::MipmapTest)
@@ -34,6 +34,7 @@
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Trade/ImageData.h"
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
@@ -45,7 +46,7 @@ namespace Magnum { namespace Trade {
 std::string AbstractImageConverter::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Trade.AbstractImageConverter/0.2.1"
+"cz.mosra.magnum.Trade.AbstractImageConverter/0.2.3"
 /* [interface] */
     ;
 }
@@ -189,6 +190,127 @@ bool AbstractImageConverter::exportToFile(const ImageData2D& image, const std::s
     return image.isCompressed() ? exportToFile(CompressedImageView2D(image), filename) : exportToFile(ImageView2D(image), filename);
 }
 
+Containers::Array<char> AbstractImageConverter::exportLevelsToData(const Containers::ArrayView<const ImageView2D> imageLevels) {
+    CORRADE_ASSERT(!imageLevels.empty(),
+        "Trade::AbstractImageConverter::exportLevelsToData(): at least one image level has to be specified", nullptr);
+    if(imageLevels.size() == 1) return exportToData(imageLevels[0]);
+
+    CORRADE_ASSERT(features() >= (ImageConverterFeature::ConvertData|ImageConverterFeature::ConvertLevels),
+        "Trade::AbstractImageConverter::exportLevelsToData(): feature not supported", nullptr);
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 1; i != imageLevels.size(); ++i)
+        CORRADE_ASSERT(imageLevels[i].format() == imageLevels[0].format(),
+            "Trade::AbstractImageConverter::exportLevelsToData(): expected all levels to have" << imageLevels[0].format() << "but level" << i << "has" << imageLevels[i].format(), nullptr);
+    #endif
+
+    Containers::Array<char> out = doExportLevelsToData(imageLevels);
+    CORRADE_ASSERT(!out.deleter(), "Trade::AbstractImageConverter::exportLevelsToData(): implementation is not allowed to use a custom Array deleter", {});
+    return out;
+}
+
+Containers::Array<char> AbstractImageConverter::exportLevelsToData(const std::initializer_list<ImageView2D> imageLevels) {
+    return exportLevelsToData(Containers::arrayView(imageLevels));
+}
+
+Containers::Array<char> AbstractImageConverter::doExportLevelsToData(Containers::ArrayView<const ImageView2D>) {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImageConverter::exportLevelsToData(): feature advertised but not implemented", nullptr);
+}
+
+bool AbstractImageConverter::exportLevelsToFile(const Containers::ArrayView<const ImageView2D> imageLevels, const std::string& filename) {
+    CORRADE_ASSERT(!imageLevels.empty(),
+        "Trade::AbstractImageConverter::exportLevelsToFile(): at least one image level has to be specified", {});
+    if(imageLevels.size() == 1) return exportToFile(imageLevels[0], filename);
+
+    CORRADE_ASSERT(features() >= (ImageConverterFeature::ConvertFile|ImageConverterFeature::ConvertLevels),
+        "Trade::AbstractImageConverter::exportLevelsToFile(): feature not supported", {});
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 1; i != imageLevels.size(); ++i)
+        CORRADE_ASSERT(imageLevels[i].format() == imageLevels[0].format(),
+            "Trade::AbstractImageConverter::exportLevelsToFile(): expected all levels to have" << imageLevels[0].format() << "but level" << i << "has" << imageLevels[i].format(), {});
+    #endif
+
+    return doExportLevelsToFile(imageLevels, filename);
+}
+
+bool AbstractImageConverter::exportLevelsToFile(const std::initializer_list<ImageView2D> imageLevels, const std::string& filename) {
+    return exportLevelsToFile(Containers::arrayView(imageLevels), filename);
+}
+
+bool AbstractImageConverter::doExportLevelsToFile(const Containers::ArrayView<const ImageView2D> imageLevels, const std::string& filename) {
+    CORRADE_ASSERT(features() >= ImageConverterFeature::ConvertData, "Trade::AbstractImageConverter::exportLevelsToFile(): feature advertised but not implemented", false);
+
+    const auto data = doExportLevelsToData(imageLevels);
+    /* No deleter checks as it doesn't matter here */
+    if(!data) return false;
+
+    if(!Utility::Directory::write(filename, data)) {
+        Error() << "Trade::AbstractImageConverter::exportLevelsToFile(): cannot write to file" << filename;
+        return false;
+    }
+
+    return true;
+}
+
+bool AbstractImageConverter::beginExportToFile(const ImageView2D& image, const std::string& filename) {
+    CORRADE_ASSERT(features() & ImageConverterFeature::ConvertFileRows,
+        "Trade::AbstractImageConverter::beginExportToFile(): feature not supported", {});
+    CORRADE_ASSERT(!_exportingRows,
+        "Trade::AbstractImageConverter::beginExportToFile(): another export is in progress", {});
+
+    if(!doBeginExportToFile(image, filename)) return false;
+
+    _exportingRows = true;
+    _exportRowsFormat = image.format();
+    _exportRowsWidth = image.size().x();
+    _exportRowsRemaining = image.size().y();
+    return true;
+}
+
+bool AbstractImageConverter::doBeginExportToFile(const ImageView2D&, const std::string&) {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImageConverter::beginExportToFile(): feature advertised but not implemented", {});
+}
+
+bool AbstractImageConverter::exportRowsToFile(const ImageView2D& rows) {
+    CORRADE_ASSERT(_exportingRows,
+        "Trade::AbstractImageConverter::exportRowsToFile(): no export in progress, call beginExportToFile() first", {});
+    CORRADE_ASSERT(rows.format() == _exportRowsFormat && rows.size().x() == _exportRowsWidth,
+        "Trade::AbstractImageConverter::exportRowsToFile(): expected" << _exportRowsFormat << "rows" << _exportRowsWidth << "pixels wide but got" << rows.format() << "and" << rows.size().x() << "pixels", {});
+    CORRADE_ASSERT(rows.size().y() <= _exportRowsRemaining,
+        "Trade::AbstractImageConverter::exportRowsToFile(): expected at most" << _exportRowsRemaining << "rows but got" << rows.size().y(), {});
+
+    if(!doExportRowsToFile(rows)) {
+        /* Let the implementation clean up, ignoring the return value */
+        doEndExportToFile();
+        _exportingRows = false;
+        return false;
+    }
+
+    _exportRowsRemaining -= rows.size().y();
+    return true;
+}
+
+bool AbstractImageConverter::doExportRowsToFile(const ImageView2D&) {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImageConverter::exportRowsToFile(): feature advertised but not implemented", {});
+}
+
+bool AbstractImageConverter::endExportToFile() {
+    CORRADE_ASSERT(_exportingRows,
+        "Trade::AbstractImageConverter::endExportToFile(): no export in progress, call beginExportToFile() first", {});
+
+    _exportingRows = false;
+    const bool out = doEndExportToFile();
+    if(_exportRowsRemaining) {
+        Error{} << "Trade::AbstractImageConverter::endExportToFile(): expected" << _exportRowsRemaining << "more rows";
+        return false;
+    }
+
+    return out;
+}
+
+bool AbstractImageConverter::doEndExportToFile() {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImageConverter::endExportToFile(): feature advertised but not implemented", {});
+}
+
 Debug& operator<<(Debug& debug, const ImageConverterFeature value) {
     debug << "Trade::ImageConverterFeature" << Debug::nospace;
 
@@ -201,6 +323,8 @@ Debug& operator<<(Debug& debug, const ImageConverterFeature value) {
         _c(ConvertCompressedFile)
         _c(ConvertData)
         _c(ConvertCompressedData)
+        _c(ConvertFileRows)
+        _c(ConvertLevels)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -214,6 +338,8 @@ Debug& operator<<(Debug& debug, const ImageConverterFeatures value) {
         ImageConverterFeature::ConvertCompressedImage,
         ImageConverterFeature::ConvertData,
         ImageConverterFeature::ConvertCompressedData,
+        ImageConverterFeature::ConvertFileRows,
+        ImageConverterFeature::ConvertLevels,
         /* These are implied by Convert[Compressed]Data, so have to be last */
         ImageConverterFeature::ConvertFile,
         ImageConverterFeature::ConvertCompressedFile});
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Trade::AbstractImageConverter, enum @ref Magnum::Trade::ImageConverterFeature, enum set @ref Magnum::Trade::ImageConverterFeatures
  */
 
+#include <initializer_list>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 
 #include "Magnum/Magnum.h"
@@ -80,7 +81,27 @@ enum class ImageConverterFeature: UnsignedByte {
      * @ref AbstractImageConverter::exportToData(const CompressedImageView2D&).
      * Implies @ref ImageConverterFeature::ConvertCompressedFile.
      */
-    ConvertCompressedData = ConvertCompressedFile|(1 << 4)
+    ConvertCompressedData = ConvertCompressedFile|(1 << 4),
+
+    /**
+     * Exporting image to file in row bands with
+     * @ref AbstractImageConverter::beginExportToFile(),
+     * @ref AbstractImageConverter::exportRowsToFile() and
+     * @ref AbstractImageConverter::endExportToFile()
+     * @m_since_latest
+     */
+    ConvertFileRows = 1 << 5,
+
+    /**
+     * Exporting multiple image levels, such as a mip chain, into a single
+     * file or data with
+     * @ref AbstractImageConverter::exportLevelsToData() or
+     * @ref AbstractImageConverter::exportLevelsToFile(). Has to be combined
+     * with @ref ImageConverterFeature::ConvertData or
+     * @ref ImageConverterFeature::ConvertFile, respectively.
+     * @m_since_latest
+     */
+    ConvertLevels = 1 << 6
 };
 
 /**
@@ -186,6 +207,19 @@ checked by the implementation:
 -   The function @ref doExportToFile(const CompressedImageView2D&, const std::string&)
     is called only if @ref ImageConverterFeature::ConvertCompressedFile is
     supported.
+-   The functions @ref doBeginExportToFile(), @ref doExportRowsToFile() and
+    @ref doEndExportToFile() are called only if
+    @ref ImageConverterFeature::ConvertFileRows is supported. The latter two
+    are called only after a successful @ref doBeginExportToFile(), with
+    @ref doExportRowsToFile() getting a view matching the format and width of
+    the image and not exceeding the count of remaining rows.
+-   The functions @ref doExportLevelsToData() and @ref doExportLevelsToFile()
+    are called only if @ref ImageConverterFeature::ConvertLevels is supported
+    together with @ref ImageConverterFeature::ConvertData or
+    @ref ImageConverterFeature::ConvertFile, respectively, and only with at
+    least two levels, all having the same format. A single level is
+    delegated to @ref doExportToData(const ImageView2D&) or
+    @ref doExportToFile(const ImageView2D&, const std::string&) instead.
 
 @m_class{m-block m-warning}
 
@@ -345,6 +379,86 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
          */
         bool exportToFile(const ImageData2D& image, const std::string& filename);
 
+        /**
+         * @brief Export multiple image levels to raw data
+         * @m_since_latest
+         *
+         * Available only if @ref ImageConverterFeature::ConvertData together
+         * with @ref ImageConverterFeature::ConvertLevels is supported. Expects
+         * that @p imageLevels is non-empty and all levels have the same
+         * format, the first item being the base level. If there's just one
+         * level, the call is equivalent to
+         * @ref exportToData(const ImageView2D&) and
+         * @ref ImageConverterFeature::ConvertLevels doesn't need to be
+         * supported. Returns data on success, @cpp nullptr @ce otherwise.
+         * @see @ref features(), @ref exportLevelsToFile(),
+         *      @ref TextureTools::mipmaps()
+         */
+        Containers::Array<char> exportLevelsToData(Containers::ArrayView<const ImageView2D> imageLevels);
+
+        /** @overload */
+        Containers::Array<char> exportLevelsToData(std::initializer_list<ImageView2D> imageLevels);
+
+        /**
+         * @brief Export multiple image levels to file
+         * @m_since_latest
+         *
+         * Available only if @ref ImageConverterFeature::ConvertFile together
+         * with @ref ImageConverterFeature::ConvertLevels is supported. Has the
+         * same expectations as @ref exportLevelsToData(), a single level is
+         * equivalent to calling
+         * @ref exportToFile(const ImageView2D&, const std::string&). Returns
+         * @cpp true @ce on success, @cpp false @ce otherwise.
+         * @see @ref features()
+         */
+        bool exportLevelsToFile(Containers::ArrayView<const ImageView2D> imageLevels, const std::string& filename);
+
+        /** @overload */
+        bool exportLevelsToFile(std::initializer_list<ImageView2D> imageLevels, const std::string& filename);
+
+        /**
+         * @brief Begin exporting an image to file in row bands
+         * @param image     Image properties
+         * @param filename  Output file
+         * @m_since_latest
+         *
+         * Available only if @ref ImageConverterFeature::ConvertFileRows is
+         * supported. The @p image describes format and size of the whole
+         * image, its data are ignored and can be @cpp nullptr @ce. The rows
+         * are then passed from the bottom up using @ref exportRowsToFile()
+         * and the export is finished with @ref endExportToFile(). Compared to
+         * @ref exportToFile(const ImageView2D&, const std::string&) the whole
+         * image doesn't need to be resident in memory, which makes it possible
+         * to process huge images in fixed amount of memory. Expects that no
+         * other export is in progress. Returns @cpp true @ce on success,
+         * @cpp false @ce otherwise.
+         * @see @ref features(), @ref Trade::AbstractImporter::beginImage2DRows()
+         */
+        bool beginExportToFile(const ImageView2D& image, const std::string& filename);
+
+        /**
+         * @brief Export next rows of an image to file
+         * @m_since_latest
+         *
+         * Expects that @ref beginExportToFile() was called before, that
+         * @p rows has the same format and width as the image and that its
+         * height doesn't exceed the count of rows not exported yet. Returns
+         * @cpp true @ce on success, @cpp false @ce otherwise, in which case
+         * the export is aborted.
+         */
+        bool exportRowsToFile(const ImageView2D& rows);
+
+        /**
+         * @brief Finish exporting an image to file
+         * @m_since_latest
+         *
+         * Expects that @ref beginExportToFile() was called before. If not all
+         * rows were passed to @ref exportRowsToFile(), prints an error
+         * message and returns @cpp false @ce, leaving the output incomplete.
+         * Returns @cpp true @ce on success.
+         */
+        bool endExportToFile();
+
     private:
         /** @brief Implementation for @ref features() */
         virtual ImageConverterFeatures doFeatures() const = 0;
@@ -394,7 +508,50 @@ class MAGNUM_TRADE_EXPORT AbstractImageConverter: public PluginManager::Abstract
          */
         virtual bool doExportToFile(const CompressedImageView2D& image, const std::string& filename);
 
+        /**
+         * @brief Implementation for @ref exportLevelsToData()
+         * @m_since_latest
+         */
+        virtual Containers::Array<char> doExportLevelsToData(Containers::ArrayView<const ImageView2D> imageLevels);
+
+        /**
+         * @brief Implementation for @ref exportLevelsToFile()
+         * @m_since_latest
+         *
+         * If @ref ImageConverterFeature::ConvertData is supported, default
+         * implementation calls @ref doExportLevelsToData() and saves the
+         * result to given file.
+         */
+        virtual bool doExportLevelsToFile(Containers::ArrayView<const ImageView2D> imageLevels, const std::string& filename);
+
+        /**
+         * @brief Implementation for @ref beginExportToFile()
+         * @m_since_latest
+         */
+        virtual bool doBeginExportToFile(const ImageView2D& image, const std::string& filename);
+
+        /**
+         * @brief Implementation for @ref exportRowsToFile()
+         * @m_since_latest
+         */
+        virtual bool doExportRowsToFile(const ImageView2D& rows);
+
+        /**
+         * @brief Implementation for @ref endExportToFile()
+         * @m_since_latest
+         *
+         * Called also if not all rows were exported, in order to let the
+         * implementation release its resources. In that case the return value
+         * is ignored.
+         */
+        virtual bool doEndExportToFile();
+
         ImageConverterFlags _flags;
+
+        /* State of an export in row bands, used for sanity checks */
+        bool _exportingRows{};
+        PixelFormat _exportRowsFormat{};
+        Int _exportRowsWidth{}, _exportRowsRemaining{};
 };
 
 }}
@@ -33,6 +33,8 @@
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/FileCallback.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/ArrayAllocator.h"
 #include "Magnum/Trade/CameraData.h"
@@ -62,7 +64,7 @@ namespace Magnum { namespace Trade {
 std::string AbstractImporter::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Trade.AbstractImporter/0.3.3"
+"cz.mosra.magnum.Trade.AbstractImporter/0.3.4"
 /* [interface] */
     ;
 }
@@ -206,6 +208,7 @@ void AbstractImporter::doOpenFile(const std::string& filename) {
 }
 
 void AbstractImporter::close() {
+    _image2DRowsRemaining = 0;
     if(isOpened()) {
         doClose();
         CORRADE_INTERNAL_ASSERT(!isOpened());
@@ -977,6 +980,58 @@ Containers::Optional<ImageData2D> AbstractImporter::doImage2D(UnsignedInt, Unsig
     CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImporter::image2D(): not implemented", {});
 }
 
+Containers::Optional<ImageView2D> AbstractImporter::beginImage2DRows(const UnsignedInt id, const UnsignedInt level) {
+    CORRADE_ASSERT(features() & ImporterFeature::Image2DRows,
+        "Trade::AbstractImporter::beginImage2DRows(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::beginImage2DRows(): no file opened", {});
+    CORRADE_ASSERT(id < doImage2DCount(), "Trade::AbstractImporter::beginImage2DRows(): index" << id << "out of range for" << doImage2DCount() << "entries", {});
+    #ifndef CORRADE_NO_ASSERT
+    /* See image2D() for why this is done only for nonzero levels */
+    if(level) {
+        const UnsignedInt levelCount = doImage2DLevelCount(id);
+        CORRADE_ASSERT(levelCount, "Trade::AbstractImporter::beginImage2DRows(): implementation reported zero levels", {});
+        CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::beginImage2DRows(): level" << level << "out of range for" << levelCount << "entries", {});
+    }
+    #endif
+
+    /* Abort the previous import, if any */
+    _image2DRowsRemaining = 0;
+
+    Containers::Optional<ImageView2D> image = doBeginImage2DRows(id, level);
+    if(image) {
+        _image2DRowsFormat = image->format();
+        _image2DRowsWidth = image->size().x();
+        _image2DRowsRemaining = image->size().y();
+    }
+    return image;
+}
+
+Containers::Optional<ImageView2D> AbstractImporter::doBeginImage2DRows(UnsignedInt, UnsignedInt) {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImporter::beginImage2DRows(): feature advertised but not implemented", {});
+}
+
+bool AbstractImporter::image2DRows(const MutableImageView2D& rows) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image2DRows(): no file opened", {});
+    CORRADE_ASSERT(_image2DRowsRemaining,
+        "Trade::AbstractImporter::image2DRows(): no rows to import, call beginImage2DRows() first", {});
+    CORRADE_ASSERT(rows.format() == _image2DRowsFormat && rows.size().x() == _image2DRowsWidth,
+        "Trade::AbstractImporter::image2DRows(): expected" << _image2DRowsFormat << "rows" << _image2DRowsWidth << "pixels wide but got" << rows.format() << "and" << rows.size().x() << "pixels", {});
+    CORRADE_ASSERT(rows.size().y() <= _image2DRowsRemaining,
+        "Trade::AbstractImporter::image2DRows(): expected at most" << _image2DRowsRemaining << "rows but got" << rows.size().y(), {});
+
+    if(!doImage2DRows(rows)) {
+        _image2DRowsRemaining = 0;
+        return false;
+    }
+
+    _image2DRowsRemaining -= rows.size().y();
+    return true;
+}
+
+bool AbstractImporter::doImage2DRows(const MutableImageView2D&) {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImporter::image2DRows(): feature advertised but not implemented", {});
+}
+
 Containers::Optional<ImageData2D> AbstractImporter::image2D(const std::string& name, const UnsignedInt level) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image2D(): no file opened", {});
     const Int id = doImage2DForName(name);
@@ -1071,6 +1126,7 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
         _c(OpenData)
         _c(OpenState)
         _c(FileCallback)
+        _c(Image2DRows)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1082,7 +1138,8 @@ Debug& operator<<(Debug& debug, const ImporterFeatures value) {
     return Containers::enumSetDebugOutput(debug, value, "Trade::ImporterFeatures{}", {
         ImporterFeature::OpenData,
         ImporterFeature::OpenState,
-        ImporterFeature::FileCallback});
+        ImporterFeature::FileCallback,
+        ImporterFeature::Image2DRows});
 }
 
 Debug& operator<<(Debug& debug, const ImporterFlag value) {
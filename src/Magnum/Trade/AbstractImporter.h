@@ -64,7 +64,15 @@ enum class ImporterFeature: UnsignedByte {
      * See @ref Trade-AbstractImporter-usage-callbacks and particular importer
      * documentation for more information.
      */
-    FileCallback = 1 << 2
+    FileCallback = 1 << 2,
+
+    /**
+     * Importing two-dimensional images in row bands using
+     * @ref AbstractImporter::beginImage2DRows() and
+     * @ref AbstractImporter::image2DRows().
+     * @m_since_latest
+     */
+    Image2DRows = 1 << 3
 };
 
 /**
@@ -300,6 +308,11 @@ checked by the implementation:
 -   The @ref doSetFileCallback() function is called only if
     @ref ImporterFeature::FileCallback is supported and there is no file
     opened.
+-   The @ref doBeginImage2DRows() and @ref doImage2DRows() functions are
+    called only if @ref ImporterFeature::Image2DRows is supported. The
+    @ref doImage2DRows() function is called only after a successful
+    @ref doBeginImage2DRows(), with a view matching the format and width of
+    the image and not exceeding the count of remaining rows.
 -   All `do*()` implementations working on an opened file as well as
     @ref doImporterState() are called only if there is any file opened.
 -   All `do*()` implementations taking data ID as parameter are called only if
@@ -1336,6 +1349,39 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         Containers::Optional<ImageData2D> image2D(const std::string& name, UnsignedInt level = 0);
 
+        /**
+         * @brief Begin importing a two-dimensional image in row bands
+         * @param id        Image ID, from range [0, @ref image2DCount()).
+         * @param level     Mip level, from range [0, @ref image2DLevelCount())
+         * @m_since_latest
+         *
+         * Available only if @ref ImporterFeature::Image2DRows is supported.
+         * On success returns a view without any data describing format, size
+         * and pixel storage of the whole image, the rows are then imported
+         * from the bottom up using @ref image2DRows(). Compared to
+         * @ref image2D() the whole image doesn't need to be resident in
+         * memory, which makes it possible to process huge images in fixed
+         * amount of memory. Returns @ref Containers::NullOpt if importing
+         * failed. Calling this function again or closing the file aborts the
+         * previous import. Expects that a file is opened.
+         * @see @ref features()
+         */
+        Containers::Optional<ImageView2D> beginImage2DRows(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Import next rows of a two-dimensional image
+         * @m_since_latest
+         *
+         * Fills the whole @p rows view with next @cpp rows.size().y() @ce
+         * rows of the image. Expects that @ref beginImage2DRows() was called
+         * before, that @p rows has the same format and width as the image and
+         * that its height doesn't exceed the count of rows not imported yet.
+         * The view can have arbitrary @ref PixelStorage. Returns
+         * @cpp false @ce if importing failed, in which case the import is
+         * aborted and no more rows can be imported.
+         */
+        bool image2DRows(const MutableImageView2D& rows);
+
         /**
          * @brief Three-dimensional image count
          *
@@ -2028,6 +2074,20 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref image2D() */
         virtual Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level);
 
+        /**
+         * @brief Implementation for @ref beginImage2DRows()
+         * @m_since_latest
+         *
+         * The returned view is not expected to have any data.
+         */
+        virtual Containers::Optional<ImageView2D> doBeginImage2DRows(UnsignedInt id, UnsignedInt level);
+
+        /**
+         * @brief Implementation for @ref image2DRows()
+         * @m_since_latest
+         */
+        virtual bool doImage2DRows(const MutableImageView2D& rows);
+
         /**
          * @brief Implementation for @ref image3DCount()
          *
@@ -2069,6 +2129,10 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         ImporterFlags _flags;
 
+        /* State of an import in row bands, used for sanity checks */
+        PixelFormat _image2DRowsFormat{};
+        Int _image2DRowsWidth{}, _image2DRowsRemaining{};
+
         Containers::Optional<Containers::ArrayView<const char>>(*_fileCallback)(const std::string&, InputFileCallbackPolicy, void*){};
         void* _fileCallbackUserData{};
 
@@ -0,0 +1,139 @@
+#ifndef Magnum_Trade_Implementation_batchConversion_h
+#define Magnum_Trade_Implementation_batchConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <sys/stat.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/ImageData.h"
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* Used only in executables where we don't want it to be exported */
+namespace {
+
+struct BatchItem {
+    std::string input, output;
+};
+
+/* Importer and converter used by a single batch job. Each job gets its own
+   plugin managers, as the Any* proxies load and instantiate plugins on demand
+   and a manager shared between jobs would need to be locked for the whole
+   import or export. A null converter means the imported data are saved
+   as-is. */
+struct BatchJob {
+    Containers::Pointer<PluginManager::Manager<AbstractImporter>> importerManager;
+    Containers::Pointer<PluginManager::Manager<AbstractImageConverter>> converterManager;
+    Containers::Pointer<AbstractImporter> importer;
+    Containers::Pointer<AbstractImageConverter> converter;
+};
+
+struct BatchResult {
+    std::size_t converted, skipped, failed;
+};
+
+/* Returns 0 if the file doesn't exist. Corrade::Utility::Directory doesn't
+   provide this. */
+/** @todo use a Unicode-aware variant on Windows */
+Long modificationTime(const std::string& filename) {
+    struct stat st;
+    if(stat(filename.data(), &st) != 0) return 0;
+    return st.st_mtime;
+}
+
+/* Converts the items in parallel, one thread per job, the calling thread
+   runs the first job. Items whose output is newer than the input are skipped
+   unless force is set. */
+BatchResult convertBatch(const Containers::ArrayView<const BatchItem> items, const Containers::ArrayView<BatchJob> jobs, const UnsignedInt imageId, const UnsignedInt level, const bool force, const bool verbose) {
+    std::mutex outputMutex;
+    std::atomic<std::size_t> next{0}, converted{0}, skipped{0}, failed{0};
+
+    auto job = [&](AbstractImporter& importer, AbstractImageConverter* converter) {
+        for(std::size_t i; (i = next++) < items.size(); ) {
+            const BatchItem& item = items[i];
+
+            const Long outputTime = modificationTime(item.output);
+            if(!force && outputTime && outputTime >= modificationTime(item.input)) {
+                ++skipped;
+                continue;
+            }
+
+            Containers::Optional<ImageData2D> image;
+            if(!importer.openFile(item.input) ||
+               !(image = importer.image2D(imageId, level)))
+            {
+                std::lock_guard<std::mutex> outputLock{outputMutex};
+                Error{} << "Cannot import" << item.input;
+                ++failed;
+                continue;
+            }
+            importer.close();
+
+            if(verbose) {
+                std::lock_guard<std::mutex> outputLock{outputMutex};
+                Debug{} << "Converting" << item.input << "to" << item.output;
+            }
+
+            Utility::Directory::mkpath(Utility::Directory::path(item.output));
+
+            bool success;
+            if(!converter)
+                success = Utility::Directory::write(item.output, image->data());
+            else
+                success = converter->exportToFile(*image, item.output);
+
+            if(!success) {
+                std::lock_guard<std::mutex> outputLock{outputMutex};
+                Error{} << "Cannot save file" << item.output;
+                ++failed;
+            } else ++converted;
+        }
+    };
+
+    Containers::Array<std::thread> threads{jobs.size() - 1};
+    for(std::size_t i = 1; i != jobs.size(); ++i)
+        threads[i - 1] = std::thread{job, std::ref(*jobs[i].importer), jobs[i].converter.get()};
+    job(*jobs[0].importer, jobs[0].converter.get());
+    for(std::thread& thread: threads) thread.join();
+
+    return {converted.load(), skipped.load(), failed.load()};
+}
+
+}
+
+}}}
+
+#endif
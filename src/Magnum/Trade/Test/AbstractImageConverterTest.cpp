@@ -25,6 +25,7 @@
 
 #include <sstream>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
@@ -85,6 +86,22 @@ struct AbstractImageConverterTest: TestSuite::Tester {
 
     void exportImageDataToFile();
 
+    void exportRowsToFile();
+    void exportRowsToFileNotSupported();
+    void exportRowsToFileNotImplemented();
+    void exportRowsToFileFailed();
+    void exportRowsToFileIncomplete();
+    void exportRowsToFileInvalid();
+
+    void exportLevelsToData();
+    void exportLevelsToDataSingleLevel();
+    void exportLevelsToDataNotSupported();
+    void exportLevelsToDataNotImplemented();
+    void exportLevelsToDataInvalid();
+    void exportLevelsToFile();
+    void exportLevelsToFileThroughData();
+    void exportLevelsToFileNotSupported();
+
     void debugFeature();
     void debugFeatures();
     void debugFlag();
@@ -132,6 +149,22 @@ AbstractImageConverterTest::AbstractImageConverterTest() {
 
               &AbstractImageConverterTest::exportImageDataToFile,
 
+              &AbstractImageConverterTest::exportRowsToFile,
+              &AbstractImageConverterTest::exportRowsToFileNotSupported,
+              &AbstractImageConverterTest::exportRowsToFileNotImplemented,
+              &AbstractImageConverterTest::exportRowsToFileFailed,
+              &AbstractImageConverterTest::exportRowsToFileIncomplete,
+              &AbstractImageConverterTest::exportRowsToFileInvalid,
+
+              &AbstractImageConverterTest::exportLevelsToData,
+              &AbstractImageConverterTest::exportLevelsToDataSingleLevel,
+              &AbstractImageConverterTest::exportLevelsToDataNotSupported,
+              &AbstractImageConverterTest::exportLevelsToDataNotImplemented,
+              &AbstractImageConverterTest::exportLevelsToDataInvalid,
+              &AbstractImageConverterTest::exportLevelsToFile,
+              &AbstractImageConverterTest::exportLevelsToFileThroughData,
+              &AbstractImageConverterTest::exportLevelsToFileNotSupported,
+
               &AbstractImageConverterTest::debugFeature,
               &AbstractImageConverterTest::debugFeatures,
               &AbstractImageConverterTest::debugFlag,
@@ -644,6 +677,317 @@ void AbstractImageConverterTest::exportImageDataToFile() {
     }
 }
 
+void AbstractImageConverterTest::exportRowsToFile() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertFileRows; }
+        bool doBeginExportToFile(const ImageView2D& image, const std::string& filename) override {
+            arrayAppend(data, {char(image.size().x()), char(image.size().y())});
+            this->filename = filename;
+            return true;
+        }
+        bool doExportRowsToFile(const ImageView2D& rows) override {
+            arrayAppend(data, char(rows.size().y()));
+            return true;
+        }
+        bool doEndExportToFile() override {
+            return Utility::Directory::write(filename, data);
+        }
+
+        std::string filename;
+        Containers::Array<char> data;
+    } converter;
+
+    const std::string filename = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "image.out");
+
+    /* Remove previous file, if any */
+    Utility::Directory::rm(filename);
+    CORRADE_VERIFY(!Utility::Directory::exists(filename));
+
+    /* The data don't need to be present for the whole image */
+    CORRADE_VERIFY(converter.beginExportToFile(ImageView2D{PixelFormat::RGBA8Unorm, {0x0f, 0x0d}}, filename));
+    CORRADE_VERIFY(converter.exportRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {0x0f, 0x0a}, {nullptr, 0x0f*0x0a*4}}));
+    CORRADE_VERIFY(converter.exportRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {0x0f, 0x03}, {nullptr, 0x0f*0x03*4}}));
+    CORRADE_VERIFY(converter.endExportToFile());
+    CORRADE_COMPARE_AS(filename,
+        "\x0f\x0d\x0a\x03", TestSuite::Compare::FileToString);
+
+    /* It's possible to start a new export after */
+    CORRADE_VERIFY(converter.beginExportToFile(ImageView2D{PixelFormat::RGBA8Unorm, {0x0f, 0x0d}}, filename));
+}
+
+void AbstractImageConverterTest::exportRowsToFileNotSupported() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertData; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    converter.beginExportToFile(ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}}, Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "image.out"));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::beginExportToFile(): feature not supported\n");
+}
+
+void AbstractImageConverterTest::exportRowsToFileNotImplemented() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertFileRows; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    converter.beginExportToFile(ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}}, Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "image.out"));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::beginExportToFile(): feature advertised but not implemented\n");
+}
+
+void AbstractImageConverterTest::exportRowsToFileFailed() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertFileRows; }
+        bool doBeginExportToFile(const ImageView2D&, const std::string&) override { return true; }
+        bool doExportRowsToFile(const ImageView2D&) override { return false; }
+        bool doEndExportToFile() override {
+            ended = true;
+            return true;
+        }
+
+        bool ended = false;
+    } converter;
+
+    CORRADE_VERIFY(converter.beginExportToFile(ImageView2D{PixelFormat::RGBA8Unorm, {1, 4}}, {}));
+    CORRADE_VERIFY(!converter.exportRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, {nullptr, 4}}));
+
+    /* The implementation should get a chance to clean up and the export is
+       aborted */
+    CORRADE_VERIFY(converter.ended);
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.exportRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, {nullptr, 4}});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::exportRowsToFile(): no export in progress, call beginExportToFile() first\n");
+}
+
+void AbstractImageConverterTest::exportRowsToFileIncomplete() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertFileRows; }
+        bool doBeginExportToFile(const ImageView2D&, const std::string&) override { return true; }
+        bool doExportRowsToFile(const ImageView2D&) override { return true; }
+        bool doEndExportToFile() override {
+            ended = true;
+            return true;
+        }
+
+        bool ended = false;
+    } converter;
+
+    CORRADE_VERIFY(converter.beginExportToFile(ImageView2D{PixelFormat::RGBA8Unorm, {1, 4}}, {}));
+    CORRADE_VERIFY(converter.exportRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, {nullptr, 4}}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter.endExportToFile());
+    CORRADE_VERIFY(converter.ended);
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::endExportToFile(): expected 3 more rows\n");
+}
+
+void AbstractImageConverterTest::exportRowsToFileInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertFileRows; }
+        bool doBeginExportToFile(const ImageView2D&, const std::string&) override { return true; }
+        bool doExportRowsToFile(const ImageView2D&) override { return true; }
+        bool doEndExportToFile() override { return true; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.exportRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, {nullptr, 8}});
+    converter.endExportToFile();
+    CORRADE_VERIFY(converter.beginExportToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 3}}, {}));
+    converter.beginExportToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 3}}, {});
+    converter.exportRowsToFile(ImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, {nullptr, 8}});
+    converter.exportRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, {nullptr, 4}});
+    converter.exportRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 4}, {nullptr, 32}});
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImageConverter::exportRowsToFile(): no export in progress, call beginExportToFile() first\n"
+        "Trade::AbstractImageConverter::endExportToFile(): no export in progress, call beginExportToFile() first\n"
+        "Trade::AbstractImageConverter::beginExportToFile(): another export is in progress\n"
+        "Trade::AbstractImageConverter::exportRowsToFile(): expected PixelFormat::RGBA8Unorm rows 2 pixels wide but got PixelFormat::RGBA8Srgb and 2 pixels\n"
+        "Trade::AbstractImageConverter::exportRowsToFile(): expected PixelFormat::RGBA8Unorm rows 2 pixels wide but got PixelFormat::RGBA8Unorm and 1 pixels\n"
+        "Trade::AbstractImageConverter::exportRowsToFile(): expected at most 3 rows but got 4\n");
+}
+
+void AbstractImageConverterTest::exportLevelsToData() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertData|ImageConverterFeature::ConvertLevels; }
+        Containers::Array<char> doExportLevelsToData(Containers::ArrayView<const ImageView2D> imageLevels) override {
+            return Containers::array({char(imageLevels.size()), char(imageLevels[0].size().x()), char(imageLevels[1].size().x())});
+        }
+    } converter;
+
+    Containers::Array<char> data = converter.exportLevelsToData({
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, {nullptr, 64}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, {nullptr, 16}}
+    });
+    CORRADE_COMPARE_AS(data,
+        Containers::arrayView<char>({2, 4, 2}),
+        TestSuite::Compare::Container);
+}
+
+void AbstractImageConverterTest::exportLevelsToDataSingleLevel() {
+    /* ConvertLevels doesn't need to be supported for a single level */
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertData; }
+        Containers::Array<char> doExportToData(const ImageView2D& image) override {
+            return Containers::array({char(image.size().x())});
+        }
+    } converter;
+
+    Containers::Array<char> data = converter.exportLevelsToData({
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, {nullptr, 64}}
+    });
+    CORRADE_COMPARE_AS(data,
+        Containers::arrayView<char>({4}),
+        TestSuite::Compare::Container);
+}
+
+void AbstractImageConverterTest::exportLevelsToDataNotSupported() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertData; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.exportLevelsToData({
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, {nullptr, 64}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, {nullptr, 16}}
+    });
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::exportLevelsToData(): feature not supported\n");
+}
+
+void AbstractImageConverterTest::exportLevelsToDataNotImplemented() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertData|ImageConverterFeature::ConvertLevels; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.exportLevelsToData({
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, {nullptr, 64}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, {nullptr, 16}}
+    });
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::exportLevelsToData(): feature advertised but not implemented\n");
+}
+
+void AbstractImageConverterTest::exportLevelsToDataInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertData|ImageConverterFeature::ConvertLevels; }
+        Containers::Array<char> doExportLevelsToData(Containers::ArrayView<const ImageView2D>) override {
+            return nullptr;
+        }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.exportLevelsToData({});
+    converter.exportLevelsToData({
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, {nullptr, 64}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, {nullptr, 16}},
+        ImageView2D{PixelFormat::RGBA8Srgb, {1, 1}, {nullptr, 4}}
+    });
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImageConverter::exportLevelsToData(): at least one image level has to be specified\n"
+        "Trade::AbstractImageConverter::exportLevelsToData(): expected all levels to have PixelFormat::RGBA8Unorm but level 2 has PixelFormat::RGBA8Srgb\n");
+}
+
+void AbstractImageConverterTest::exportLevelsToFile() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertFile|ImageConverterFeature::ConvertLevels; }
+        bool doExportLevelsToFile(Containers::ArrayView<const ImageView2D> imageLevels, const std::string& filename) override {
+            return Utility::Directory::write(filename, Containers::arrayView<char>({char(imageLevels.size()), char(imageLevels[1].size().x())}));
+        }
+    } converter;
+
+    const std::string filename = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "image.out");
+
+    /* Remove previous file, if any */
+    Utility::Directory::rm(filename);
+    CORRADE_VERIFY(!Utility::Directory::exists(filename));
+
+    CORRADE_VERIFY(converter.exportLevelsToFile({
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, {nullptr, 64}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, {nullptr, 16}}
+    }, filename));
+    CORRADE_COMPARE_AS(filename,
+        "\x02\x02", TestSuite::Compare::FileToString);
+}
+
+void AbstractImageConverterTest::exportLevelsToFileThroughData() {
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertData|ImageConverterFeature::ConvertLevels; }
+        Containers::Array<char> doExportLevelsToData(Containers::ArrayView<const ImageView2D> imageLevels) override {
+            return Containers::array({char(imageLevels.size()), char(imageLevels[1].size().x())});
+        }
+    } converter;
+
+    const std::string filename = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "image.out");
+
+    /* Remove previous file, if any */
+    Utility::Directory::rm(filename);
+    CORRADE_VERIFY(!Utility::Directory::exists(filename));
+
+    /* doExportLevelsToFile() should call doExportLevelsToData() */
+    CORRADE_VERIFY(converter.exportLevelsToFile({
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, {nullptr, 64}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, {nullptr, 16}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, {nullptr, 4}}
+    }, filename));
+    CORRADE_COMPARE_AS(filename,
+        "\x03\x02", TestSuite::Compare::FileToString);
+}
+
+void AbstractImageConverterTest::exportLevelsToFileNotSupported() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImageConverter {
+        ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertData; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.exportLevelsToFile({
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, {nullptr, 64}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, {nullptr, 16}}
+    }, Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "image.out"));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::exportLevelsToFile(): feature not supported\n");
+}
+
 void AbstractImageConverterTest::debugFeature() {
     std::ostringstream out;
 
@@ -654,8 +998,8 @@ void AbstractImageConverterTest::debugFeature() {
 void AbstractImageConverterTest::debugFeatures() {
     std::ostringstream out;
 
-    Debug{&out} << (ImageConverterFeature::ConvertData|ImageConverterFeature::ConvertCompressedFile) << ImageConverterFeatures{};
-    CORRADE_COMPARE(out.str(), "Trade::ImageConverterFeature::ConvertData|Trade::ImageConverterFeature::ConvertCompressedFile Trade::ImageConverterFeatures{}\n");
+    Debug{&out} << (ImageConverterFeature::ConvertData|ImageConverterFeature::ConvertCompressedFile) << (ImageConverterFeature::ConvertFile|ImageConverterFeature::ConvertFileRows) << ImageConverterFeatures{};
+    CORRADE_COMPARE(out.str(), "Trade::ImageConverterFeature::ConvertData|Trade::ImageConverterFeature::ConvertCompressedFile Trade::ImageConverterFeature::ConvertFileRows|Trade::ImageConverterFeature::ConvertFile Trade::ImageConverterFeatures{}\n");
 }
 
 void AbstractImageConverterTest::debugFlag() {
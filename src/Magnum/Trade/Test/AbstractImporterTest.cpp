@@ -27,10 +27,12 @@
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/FileCallback.h"
 #include "Magnum/Trade/AbstractImporter.h"
@@ -251,6 +253,12 @@ struct AbstractImporterTest: TestSuite::Tester {
     void image2DNonOwningDeleter();
     void image2DGrowableDeleter();
     void image2DCustomDeleter();
+    void image2DRows();
+    void image2DRowsNotSupported();
+    void image2DRowsNotImplemented();
+    void image2DRowsOutOfRange();
+    void image2DRowsFailed();
+    void image2DRowsInvalid();
 
     void image3D();
     void image3DLevelCountNotImplemented();
@@ -477,6 +485,12 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::image2DNonOwningDeleter,
               &AbstractImporterTest::image2DGrowableDeleter,
               &AbstractImporterTest::image2DCustomDeleter,
+              &AbstractImporterTest::image2DRows,
+              &AbstractImporterTest::image2DRowsNotSupported,
+              &AbstractImporterTest::image2DRowsNotImplemented,
+              &AbstractImporterTest::image2DRowsOutOfRange,
+              &AbstractImporterTest::image2DRowsFailed,
+              &AbstractImporterTest::image2DRowsInvalid,
 
               &AbstractImporterTest::image3D,
               &AbstractImporterTest::image3DLevelCountNotImplemented,
@@ -4314,6 +4328,176 @@ void AbstractImporterTest::image2DCustomDeleter() {
         "Trade::AbstractImporter::image2D(): implementation is not allowed to use a custom Array deleter\n");
 }
 
+void AbstractImporterTest::image2DRows() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Image2DRows; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 8; }
+        UnsignedInt doImage2DLevelCount(UnsignedInt) override { return 3; }
+        Containers::Optional<ImageView2D> doBeginImage2DRows(UnsignedInt id, UnsignedInt level) override {
+            if(id == 7 && level == 2) return ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {3, 5}};
+            return {};
+        }
+        bool doImage2DRows(const MutableImageView2D& rows) override {
+            for(Containers::StridedArrayView1D<UnsignedByte> row: rows.pixels<UnsignedByte>())
+                for(UnsignedByte& pixel: row) pixel = row.size()*10 + next;
+            ++next;
+            return true;
+        }
+
+        UnsignedByte next = 0;
+    } importer;
+
+    Containers::Optional<ImageView2D> image = importer.beginImage2DRows(7, 2);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{3, 5}));
+
+    /* The rows can have arbitrary storage, padding is left untouched */
+    char data[16]{};
+    CORRADE_VERIFY(importer.image2DRows(MutableImageView2D{PixelFormat::R8Unorm, {3, 3}, data}));
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(11),
+        Containers::arrayView<char>({30, 30, 30, 0, 30, 30, 30, 0, 30, 30, 30}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(importer.image2DRows(MutableImageView2D{PixelFormat::R8Unorm, {3, 2}, data}));
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(7),
+        Containers::arrayView<char>({31, 31, 31, 0, 31, 31, 31}),
+        TestSuite::Compare::Container);
+}
+
+void AbstractImporterTest::image2DRowsNotSupported() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 8; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.beginImage2DRows(7);
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::beginImage2DRows(): feature not supported\n");
+}
+
+void AbstractImporterTest::image2DRowsNotImplemented() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Image2DRows; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 8; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.beginImage2DRows(7);
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::beginImage2DRows(): feature advertised but not implemented\n");
+}
+
+void AbstractImporterTest::image2DRowsOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Image2DRows; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 8; }
+        UnsignedInt doImage2DLevelCount(UnsignedInt) override { return 3; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.beginImage2DRows(8);
+    importer.beginImage2DRows(7, 3);
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImporter::beginImage2DRows(): index 8 out of range for 8 entries\n"
+        "Trade::AbstractImporter::beginImage2DRows(): level 3 out of range for 3 entries\n");
+}
+
+void AbstractImporterTest::image2DRowsFailed() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Image2DRows; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageView2D> doBeginImage2DRows(UnsignedInt, UnsignedInt) override {
+            return ImageView2D{PixelFormat::RGBA8Unorm, {1, 4}};
+        }
+        bool doImage2DRows(const MutableImageView2D&) override {
+            return false;
+        }
+    } importer;
+
+    CORRADE_VERIFY(importer.beginImage2DRows(0));
+
+    char data[4];
+    CORRADE_VERIFY(!importer.image2DRows(MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data}));
+
+    /* The import got aborted, so no more rows can be imported */
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.image2DRows(MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::image2DRows(): no rows to import, call beginImage2DRows() first\n");
+}
+
+void AbstractImporterTest::image2DRowsInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Image2DRows; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageView2D> doBeginImage2DRows(UnsignedInt, UnsignedInt) override {
+            return ImageView2D{PixelFormat::RGBA8Unorm, {2, 3}};
+        }
+        bool doImage2DRows(const MutableImageView2D&) override {
+            return true;
+        }
+    } importer;
+
+    char data[32];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.image2DRows(MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, data});
+    CORRADE_VERIFY(importer.beginImage2DRows(0));
+    importer.image2DRows(MutableImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, data});
+    importer.image2DRows(MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data});
+    importer.image2DRows(MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 4}, data});
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImporter::image2DRows(): no rows to import, call beginImage2DRows() first\n"
+        "Trade::AbstractImporter::image2DRows(): expected PixelFormat::RGBA8Unorm rows 2 pixels wide but got PixelFormat::RGBA8Srgb and 2 pixels\n"
+        "Trade::AbstractImporter::image2DRows(): expected PixelFormat::RGBA8Unorm rows 2 pixels wide but got PixelFormat::RGBA8Unorm and 1 pixels\n"
+        "Trade::AbstractImporter::image2DRows(): expected at most 3 rows but got 4\n");
+}
+
 void AbstractImporterTest::image3D() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override { return {}; }
@@ -4625,8 +4809,8 @@ void AbstractImporterTest::debugFeature() {
 void AbstractImporterTest::debugFeatures() {
     std::ostringstream out;
 
-    Debug{&out} << (ImporterFeature::OpenData|ImporterFeature::OpenState) << ImporterFeatures{};
-    CORRADE_COMPARE(out.str(), "Trade::ImporterFeature::OpenData|Trade::ImporterFeature::OpenState Trade::ImporterFeatures{}\n");
+    Debug{&out} << (ImporterFeature::OpenData|ImporterFeature::OpenState) << (ImporterFeature::FileCallback|ImporterFeature::Image2DRows) << ImporterFeatures{};
+    CORRADE_COMPARE(out.str(), "Trade::ImporterFeature::OpenData|Trade::ImporterFeature::OpenState Trade::ImporterFeature::FileCallback|Trade::ImporterFeature::Image2DRows Trade::ImporterFeatures{}\n");
 }
 
 void AbstractImporterTest::debugFlag() {
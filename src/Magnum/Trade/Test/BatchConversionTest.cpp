@@ -0,0 +1,207 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/FileToString.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Trade/Implementation/batchConversion.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct BatchConversionTest: TestSuite::Tester {
+    explicit BatchConversionTest();
+
+    void convert();
+    void convertRaw();
+    void skipUpToDate();
+    void importFailed();
+
+    private:
+        std::string _inputDir, _outputDir;
+        Containers::Array<Implementation::BatchItem> _items;
+};
+
+BatchConversionTest::BatchConversionTest() {
+    addTests({&BatchConversionTest::convert,
+              &BatchConversionTest::convertRaw,
+              &BatchConversionTest::skipUpToDate,
+              &BatchConversionTest::importFailed});
+
+    _inputDir = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "BatchConversionTestFiles/input");
+    _outputDir = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "BatchConversionTestFiles/output");
+    Utility::Directory::mkpath(_inputDir);
+
+    /* Enough files for every job to get some */
+    _items = Containers::Array<Implementation::BatchItem>{8};
+    for(std::size_t i = 0; i != _items.size(); ++i) {
+        const std::string name = std::string{"image"} + char('0' + i);
+        _items[i].input = Utility::Directory::join(_inputDir, name + ".in");
+        _items[i].output = Utility::Directory::join(_outputDir, name + ".out");
+        Utility::Directory::writeString(_items[i].input, std::string{"abc"} + char('0' + i));
+    }
+}
+
+/* Imports the file contents as a 4x1 image */
+struct Importer: AbstractImporter {
+    ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+    bool doIsOpened() const override { return !!_data; }
+    void doClose() override { _data = nullptr; }
+
+    void doOpenData(Containers::ArrayView<const char> data) override {
+        _data = Containers::Array<char>{Containers::NoInit, data.size()};
+        std::copy(data.begin(), data.end(), _data.begin());
+    }
+
+    UnsignedInt doImage2DCount() const override { return 1; }
+    Containers::Optional<ImageData2D> doImage2D(UnsignedInt, UnsignedInt) override {
+        if(_data.size() != 4) return {};
+        Containers::Array<char> data{Containers::NoInit, _data.size()};
+        std::copy(_data.begin(), _data.end(), data.begin());
+        return ImageData2D{PixelFormat::R8Unorm, {4, 1}, std::move(data)};
+    }
+
+    Containers::Array<char> _data;
+};
+
+/* Saves the pixels in reverse order */
+struct Converter: AbstractImageConverter {
+    ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertData; }
+
+    Containers::Array<char> doExportToData(const ImageView2D& image) override {
+        Containers::Array<char> out{Containers::NoInit, image.data().size()};
+        std::reverse_copy(image.data().begin(), image.data().end(), out.begin());
+        return out;
+    }
+};
+
+Containers::Array<Implementation::BatchJob> createJobs(const std::size_t count, const bool raw) {
+    Containers::Array<Implementation::BatchJob> jobs{count};
+    for(Implementation::BatchJob& job: jobs) {
+        job.importer.reset(new Importer);
+        if(!raw) job.converter.reset(new Converter);
+    }
+    return jobs;
+}
+
+void BatchConversionTest::convert() {
+    Utility::Directory::rm(_outputDir);
+
+    Containers::Array<Implementation::BatchJob> jobs = createJobs(3, false);
+    const Implementation::BatchResult result = Implementation::convertBatch(_items, jobs, 0, 0, false, false);
+    CORRADE_COMPARE(result.converted, 8);
+    CORRADE_COMPARE(result.skipped, 0);
+    CORRADE_COMPARE(result.failed, 0);
+
+    /* The output directory gets created */
+    for(std::size_t i = 0; i != _items.size(); ++i) {
+        CORRADE_ITERATION(_items[i].output);
+        CORRADE_COMPARE_AS(_items[i].output,
+            char('0' + i) + std::string{"cba"},
+            TestSuite::Compare::FileToString);
+    }
+}
+
+void BatchConversionTest::convertRaw() {
+    Utility::Directory::rm(_outputDir);
+
+    /* Without a converter the imported data are saved as-is */
+    Containers::Array<Implementation::BatchJob> jobs = createJobs(2, true);
+    const Implementation::BatchResult result = Implementation::convertBatch(_items, jobs, 0, 0, false, false);
+    CORRADE_COMPARE(result.converted, 8);
+    CORRADE_COMPARE(result.failed, 0);
+
+    for(std::size_t i = 0; i != _items.size(); ++i) {
+        CORRADE_ITERATION(_items[i].output);
+        CORRADE_COMPARE_AS(_items[i].output,
+            std::string{"abc"} + char('0' + i),
+            TestSuite::Compare::FileToString);
+    }
+}
+
+void BatchConversionTest::skipUpToDate() {
+    Utility::Directory::rm(_outputDir);
+
+    Containers::Array<Implementation::BatchJob> jobs = createJobs(3, false);
+    CORRADE_COMPARE(Implementation::convertBatch(_items, jobs, 0, 0, false, false).converted, 8);
+
+    /* Outputs are now at least as new as inputs, so nothing is converted */
+    {
+        const Implementation::BatchResult result = Implementation::convertBatch(_items, jobs, 0, 0, false, false);
+        CORRADE_COMPARE(result.converted, 0);
+        CORRADE_COMPARE(result.skipped, 8);
+        CORRADE_COMPARE(result.failed, 0);
+    }
+
+    /* Unless forced */
+    {
+        const Implementation::BatchResult result = Implementation::convertBatch(_items, jobs, 0, 0, true, false);
+        CORRADE_COMPARE(result.converted, 8);
+        CORRADE_COMPARE(result.skipped, 0);
+        CORRADE_COMPARE(result.failed, 0);
+    }
+}
+
+void BatchConversionTest::importFailed() {
+    Utility::Directory::rm(_outputDir);
+
+    Containers::Array<Implementation::BatchItem> items{3};
+    items[0] = _items[0];
+    items[1].input = Utility::Directory::join(_inputDir, "nonexistent.in");
+    items[1].output = Utility::Directory::join(_outputDir, "nonexistent.out");
+    items[2] = _items[2];
+
+    /* A single job so all output is printed from this thread and thus
+       redirected. A failure doesn't stop the conversion of other files. */
+    Containers::Array<Implementation::BatchJob> jobs = createJobs(1, false);
+    std::ostringstream out;
+    Implementation::BatchResult result;
+    {
+        Error redirectError{&out};
+        result = Implementation::convertBatch(items, jobs, 0, 0, false, false);
+    }
+    CORRADE_COMPARE(result.converted, 2);
+    CORRADE_COMPARE(result.skipped, 0);
+    CORRADE_COMPARE(result.failed, 1);
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::AbstractImporter::openFile(): cannot open file {0}\n"
+        "Cannot import {0}\n", items[1].input));
+    CORRADE_VERIFY(!Utility::Directory::exists(items[1].output));
+    CORRADE_VERIFY(Utility::Directory::exists(items[2].output));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::BatchConversionTest)
@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <thread>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StaticArray.h>
@@ -33,11 +35,16 @@
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/String.h>
 
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/PixelFormatConversion.h"
 #include "Magnum/Implementation/converterUtilities.h"
+#include "Magnum/TextureTools/Mipmap.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/Implementation/batchConversion.h"
 #include "Magnum/Trade/Implementation/converterUtilities.h"
 
 namespace Magnum {
@@ -69,13 +76,17 @@ magnum-imageconverter [-h|--help] [-I|--importer IMPORTER]
     [-C|--converter CONVERTER] [--plugin-dir DIR]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…] [--image IMAGE]
-    [--level LEVEL] [--in-place] [--info] [-v|--verbose] [--] input output
+    [--level LEVEL] [--format FORMAT] [--mipmaps] [--mipmap-filter FILTER]
+    [--in-place] [--info] [--batch] [--batch-extension EXT] [-j|--jobs N]
+    [--force] [-v|--verbose] [--] input output
 @endcode
 
 Arguments:
 
--   `input` --- input image
--   `output` --- output image, ignored if `--in-place` or `--info` is present
+-   `input` --- input image; with `--batch` an input directory or a manifest
+    file
+-   `output` --- output image, ignored if `--in-place` or `--info` is present;
+    with `--batch` an output directory, ignored if `input` is a manifest
 -   `-h`, `--help` --- display this help message and exit
 -   `-I`, `--importer IMPORTER` --- image importer plugin (default:
     @ref Trade::AnyImageImporter "AnyImageImporter")
@@ -88,8 +99,22 @@ Arguments:
     to pass to the converter
 -   `--image IMAGE` --- image to import (default: `0`)
 -   `--level LEVEL` --- image level to import (default: `0`)
+-   `--format FORMAT` --- convert the image to given @ref PixelFormat before
+    saving
+-   `--mipmaps` --- generate a full mip chain and save it together with the
+    image
+-   `--mipmap-filter FILTER` --- filter to use for mip generation, `box` or
+    `kaiser` (default: `box`)
 -   `--in-place` --- overwrite the input image with the output
 -   `--info` --- print info about the input file and exit
+-   `--batch` --- convert a whole directory or a list of files given by a
+    manifest
+-   `--batch-extension EXT` --- output file extension when converting a
+    directory in batch mode (default: `png`)
+-   `-j`, `--jobs N` --- number of parallel conversion jobs in batch mode
+    (default: `0`, meaning the number of hardware threads)
+-   `--force` --- in batch mode, convert also files whose output is up to
+    date
 -   `-v`, `--verbose` --- verbose output from importer and converter plugins
 
 Specifying `--importer raw:&lt;format&gt;` will treat the input as a raw
@@ -101,12 +126,54 @@ If `--info` is given, the utility will print information about all images
 present in the file. In this case no conversion is done and output file doesn't
 need to be specified.
 
+If the importer supports @ref Trade::ImporterFeature::Image2DRows and the
+converter supports @ref Trade::ImageConverterFeature::ConvertFileRows, such as
+@ref Trade::TgaImporter "TgaImporter" and
+@ref Trade::TgaImageConverter "TgaImageConverter", the image is converted in
+row bands without having it whole in memory. Since the proxy
+@ref Trade::AnyImageImporter "AnyImageImporter" and
+@ref Trade::AnyImageConverter "AnyImageConverter" plugins don't advertise
+these features, the plugins need to be specified explicitly with `--importer`
+/ `--converter`.
+
+If `--format` is given, the imported image is converted to given
+@ref PixelFormat using @ref convertPixelFormat() before saving, for example
+`--format RGBA8Unorm` to add an alpha channel to a RGB image. See
+@ref isPixelFormatConversionSupported() for a list of supported conversions.
+
+If `--mipmaps` is given, a full mip chain is generated from the imported
+image using @ref TextureTools::mipmaps() and saved together with it using
+@ref Trade::AbstractImageConverter::exportLevelsToFile(). The converter has to
+support both @ref Trade::ImageConverterFeature::ConvertFile and
+@ref Trade::ImageConverterFeature::ConvertLevels in that case. None of the
+converters bundled with Magnum itself support it at the moment, so `--mipmaps`
+needs a third-party converter plugin passed via `-C` / `--converter`. See the
+@ref TextureTools::mipmaps() documentation for a list of supported formats.
+
 The `-i` / `--importer-options` and `-c` / `--converter-options` arguments
 accept a comma-separated list of key/value pairs to set in the importer /
 converter plugin configuration. If the `=` character is omitted, it's
 equivalent to saying `key=true`; configuration subgroups are delimited with
 `/`.
 
+@subsection magnum-imageconverter-usage-batch Batch conversion
+
+If `--batch` is given and `input` is a directory, all files directly inside
+it are converted to files of the same name in the `output` directory, with
+the extension replaced by `--batch-extension`. If `input` is a file, it's
+treated as a manifest, where each non-empty line that doesn't begin with `#`
+contains a whitespace-separated input and output filename. Relative paths in
+the manifest are taken relative to the manifest location.
+
+Each of the `--jobs` worker threads has its own plugin managers and reuses a
+single importer and converter instance for all files it converts, so the
+conversion runs in parallel even with the
+@ref Trade::AnyImageImporter "AnyImageImporter" and
+@ref Trade::AnyImageConverter "AnyImageConverter" proxy plugins that load the
+concrete plugin on demand. Files whose output is newer than the input are
+skipped unless `--force` is specified. The `raw:<format>` importer as well as
+`--info` and `--in-place` options are not supported in batch mode.
+
 @section magnum-imageconverter-example Example usage
 
 Converting a JPEG file to a PNG:
@@ -135,6 +202,14 @@ inspection:
 magnum-imageconverter image.dds --converter raw data.dat
 @endcode
 
+Converting all PNG files in a directory to DDS files in another, using eight
+parallel jobs and skipping files that were already converted before:
+
+@code{.sh}
+magnum-imageconverter --batch textures/ cooked/ --batch-extension dds \
+    --importer PngImporter --converter DdsImageConverter -j 8
+@endcode
+
 @see @ref magnum-sceneconverter
 */
 
@@ -142,6 +217,142 @@ magnum-imageconverter image.dds --converter raw data.dat
 
 using namespace Magnum;
 
+namespace {
+
+/* Imports and converts the image in row bands of roughly 16 MB */
+int convertRows(Trade::AbstractImporter& importer, Trade::AbstractImageConverter& converter, const UnsignedInt id, const UnsignedInt level, const std::string& output, const bool verbose) {
+    Containers::Optional<ImageView2D> image = importer.beginImage2DRows(id, level);
+    if(!image) {
+        Error() << "Cannot import the image";
+        return 4;
+    }
+
+    if(verbose)
+        Debug{} << "Converting image of size" << image->size() << "and format" << image->format() << "to" << output << "in row bands";
+
+    if(!converter.beginExportToFile(*image, output)) {
+        Error() << "Cannot save file" << output;
+        return 5;
+    }
+
+    const std::size_t rowSize = std::size_t(image->pixelSize())*image->size().x();
+    const Int bandRows = std::max(Int(16*1024*1024/std::max(rowSize, std::size_t{1})), 1);
+    Containers::Array<char> data{Containers::NoInit, rowSize*std::min(bandRows, image->size().y())};
+    for(Int y = 0; y < image->size().y(); y += bandRows) {
+        const Int count = std::min(bandRows, image->size().y() - y);
+        const MutableImageView2D rows{PixelStorage{}.setAlignment(1),
+            image->format(), image->formatExtra(), image->pixelSize(),
+            {image->size().x(), count}, data.prefix(rowSize*count)};
+        if(!importer.image2DRows(rows)) {
+            Error() << "Cannot import the image";
+            converter.endExportToFile();
+            return 4;
+        }
+        if(!converter.exportRowsToFile(rows)) {
+            Error() << "Cannot save file" << output;
+            return 5;
+        }
+    }
+
+    if(!converter.endExportToFile()) {
+        Error() << "Cannot save file" << output;
+        return 5;
+    }
+
+    return 0;
+}
+
+int batch(const Utility::Arguments& args, const std::string& importerPluginDir, const std::string& converterPluginDir) {
+    if(Utility::String::beginsWith(args.value("importer"), "raw:")) {
+        Error{} << "Raw importer is not supported in batch mode";
+        return 6;
+    }
+    if(args.isSet("info") || args.isSet("in-place")) {
+        Error{} << "The --info and --in-place options are not supported in batch mode";
+        return 6;
+    }
+
+    /* Gather the list of files to convert */
+    const std::string input = args.value("input");
+    Containers::Array<Trade::Implementation::BatchItem> items;
+    if(Utility::Directory::isDirectory(input)) {
+        if(args.value("output").empty()) {
+            Error{} << "An output directory is required when converting a directory";
+            return 6;
+        }
+
+        const std::string extension = "." + args.value("batch-extension");
+        for(const std::string& file: Utility::Directory::list(input,
+            Utility::Directory::Flag::SkipDirectories|
+            Utility::Directory::Flag::SkipDotAndDotDot|
+            Utility::Directory::Flag::SortAscending))
+        {
+            arrayAppend(items, Containers::InPlaceInit,
+                Utility::Directory::join(input, file),
+                Utility::Directory::join(args.value("output"),
+                    Utility::Directory::splitExtension(file).first + extension));
+        }
+
+    } else {
+        if(!Utility::Directory::exists(input)) {
+            Error{} << "Cannot open file" << input;
+            return 3;
+        }
+
+        const std::string base = Utility::Directory::path(input);
+        const std::vector<std::string> lines = Utility::String::splitWithoutEmptyParts(Utility::Directory::readString(input), '\n');
+        for(std::size_t i = 0; i != lines.size(); ++i) {
+            const std::string line = Utility::String::trim(lines[i]);
+            if(line.empty() || line[0] == '#') continue;
+
+            const std::vector<std::string> files = Utility::String::splitWithoutEmptyParts(line);
+            if(files.size() != 2) {
+                Error{} << "Expected an input and output filename on manifest line" << i + 1 << "but got" << line;
+                return 6;
+            }
+
+            arrayAppend(items, Containers::InPlaceInit,
+                Utility::Directory::join(base, files[0]),
+                Utility::Directory::join(base, files[1]));
+        }
+    }
+
+    std::size_t jobCount = args.value<UnsignedInt>("jobs");
+    if(!jobCount) jobCount = std::max(std::thread::hardware_concurrency(), 1u);
+    jobCount = std::min(jobCount, std::max(items.size(), std::size_t{1}));
+
+    /* Each job gets its own plugin managers and instances, created upfront on
+       this thread. The conversion itself then doesn't need any locking, even
+       with the Any* proxies that load and instantiate plugins on demand. */
+    const bool raw = args.value("converter") == "raw";
+    Containers::Array<Trade::Implementation::BatchJob> jobs{jobCount};
+    for(Trade::Implementation::BatchJob& job: jobs) {
+        job.importerManager.emplace(importerPluginDir);
+        if(!(job.importer = job.importerManager->loadAndInstantiate(args.value("importer")))) {
+            Debug{} << "Available importer plugins:" << Utility::String::join(job.importerManager->aliasList(), ", ");
+            return 1;
+        }
+        if(args.isSet("verbose")) job.importer->setFlags(Trade::ImporterFlag::Verbose);
+        Implementation::setOptions(*job.importer, args.value("importer-options"));
+
+        if(raw) continue;
+        job.converterManager.emplace(converterPluginDir);
+        if(!(job.converter = job.converterManager->loadAndInstantiate(args.value("converter")))) {
+            Debug{} << "Available converter plugins:" << Utility::String::join(job.converterManager->aliasList(), ", ");
+            return 2;
+        }
+        if(args.isSet("verbose")) job.converter->setFlags(Trade::ImageConverterFlag::Verbose);
+        Implementation::setOptions(*job.converter, args.value("converter-options"));
+    }
+
+    const Trade::Implementation::BatchResult result = Trade::Implementation::convertBatch(items, jobs, args.value<UnsignedInt>("image"), args.value<UnsignedInt>("level"), args.isSet("force"), args.isSet("verbose"));
+
+    Debug{} << "Converted" << result.converted << "of" << items.size() << "images," << result.skipped << "up to date," << result.failed << "failed";
+    return result.failed ? 5 : 0;
+}
+
+}
+
 int main(int argc, char** argv) {
     Utility::Arguments args;
     args.addArgument("input").setHelp("input", "input image")
@@ -153,14 +364,22 @@ int main(int argc, char** argv) {
         .addOption('c', "converter-options").setHelp("converter-options", "configuration options to pass to the converter", "key=val,key2=val2,…")
         .addOption("image", "0").setHelp("image", "image to import")
         .addOption("level", "0").setHelp("level", "image level to import")
+        .addOption("format").setHelp("format", "convert the image to given pixel format before saving", "FORMAT")
+        .addBooleanOption("mipmaps").setHelp("mipmaps", "generate a full mip chain and save it together with the image")
+        .addOption("mipmap-filter", "box").setHelp("mipmap-filter", "filter to use for mip generation, box or kaiser", "FILTER")
         .addBooleanOption("in-place").setHelp("in-place", "overwrite the input image with the output")
         .addBooleanOption("info").setHelp("info", "print info about the input file and exit")
+        .addBooleanOption("batch").setHelp("batch", "convert a whole directory or a list of files given by a manifest")
+        .addOption("batch-extension", "png").setHelp("batch-extension", "output file extension when converting a directory in batch mode", "EXT")
+        .addOption('j', "jobs", "0").setHelp("jobs", "number of parallel conversion jobs in batch mode, 0 means the number of hardware threads", "N")
+        .addBooleanOption("force").setHelp("force", "in batch mode, convert also files whose output is up to date")
         .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
             /* If --in-place or --info is passed, we don't need the output
-               argument */
+               argument. In batch mode the output is needed only if the input
+               is a directory, that's checked later. */
             if(error == Utility::Arguments::ParseError::MissingArgument &&
-               key == "output" && (args.isSet("in-place") || args.isSet("info")))
+               key == "output" && (args.isSet("in-place") || args.isSet("info") || args.isSet("batch")))
                 return true;
 
             /* Handle all other errors as usual */
@@ -179,12 +398,26 @@ be specified.
 The -i / --importer-options and -c / --converter-options arguments accept a
 comma-separated list of key/value pairs to set in the importer / converter
 plugin configuration. If the = character is omitted, it's equivalent to saying
-key=true; configuration subgroups are delimited with /.)")
+key=true; configuration subgroups are delimited with /.
+
+If --batch is given and input is a directory, all files directly inside it are
+converted to files of the same name in the output directory, with the
+extension replaced by --batch-extension. Otherwise the input is treated as a
+manifest with a whitespace-separated input and output filename on each line.
+Files whose output is newer than the input are skipped unless --force is
+specified.)")
         .parse(argc, argv);
 
-    PluginManager::Manager<Trade::AbstractImporter> importerManager{
-        args.value("plugin-dir").empty() ? std::string{} :
-        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths()[0])};
+    const std::string importerPluginDir = args.value("plugin-dir").empty() ? std::string{} :
+        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths()[0]);
+    const std::string converterPluginDir = args.value("plugin-dir").empty() ? std::string{} :
+        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImageConverter::pluginSearchPaths()[0]);
+
+    /* Batch conversion of many files, with plugin managers for each job */
+    if(args.isSet("batch")) return batch(args, importerPluginDir, converterPluginDir);
+
+    PluginManager::Manager<Trade::AbstractImporter> importerManager{importerPluginDir};
+    PluginManager::Manager<Trade::AbstractImageConverter> converterManager{converterPluginDir};
 
     /* Load raw data, if requested; assume it's a tightly-packed square of
        given format */
@@ -276,7 +509,25 @@ key=true; configuration subgroups are delimited with /.)")
             return 3;
         }
 
-         if(!(image = importer->image2D(args.value<UnsignedInt>("image"), args.value<UnsignedInt>("level")))) {
+        /* If both the importer and the converter support it, convert the
+           image in row bands without having it whole in memory. Not done
+           in-place as the input would get overwritten while being read. */
+        if(importer->features() & Trade::ImporterFeature::Image2DRows && args.value("converter") != "raw" && !args.isSet("in-place") && args.value("format").empty() && !args.isSet("mipmaps")) {
+            Containers::Pointer<Trade::AbstractImageConverter> converter = converterManager.loadAndInstantiate(args.value("converter"));
+            if(!converter) {
+                Debug{} << "Available converter plugins:" << Utility::String::join(converterManager.aliasList(), ", ");
+                return 2;
+            }
+
+            if(converter->features() & Trade::ImageConverterFeature::ConvertFileRows) {
+                if(args.isSet("verbose")) converter->setFlags(Trade::ImageConverterFlag::Verbose);
+                Implementation::setOptions(*converter, args.value("converter-options"));
+
+                return convertRows(*importer, *converter, args.value<UnsignedInt>("image"), args.value<UnsignedInt>("level"), args.value("output"), args.isSet("verbose"));
+            }
+        }
+
+        if(!(image = importer->image2D(args.value<UnsignedInt>("image"), args.value<UnsignedInt>("level")))) {
             Error() << "Cannot import the image";
             return 4;
         }
@@ -284,6 +535,57 @@ key=true; configuration subgroups are delimited with /.)")
 
     const std::string output = args.value(args.isSet("in-place") ? "input" : "output");
 
+    /* Convert to a different pixel format, if requested */
+    if(!args.value("format").empty()) {
+        const PixelFormat format = Utility::ConfigurationValue<PixelFormat>::fromString(args.value("format"), {});
+        if(format == PixelFormat{}) {
+            Error() << "Invalid pixel format" << args.value("format");
+            return 1;
+        }
+
+        if(image->isCompressed()) {
+            Error() << "Can't convert a compressed image to" << format;
+            return 4;
+        }
+        if(!isPixelFormatConversionSupported(image->format(), format)) {
+            Error() << "Can't convert an image of format" << image->format() << "to" << format;
+            return 4;
+        }
+
+        Image2D converted = convertPixelFormat(*image, format);
+        image = Trade::ImageData2D{converted.storage(), converted.format(), converted.formatExtra(), converted.pixelSize(), converted.size(), converted.release()};
+    }
+
+    /* Generate mip levels, if requested */
+    Containers::Array<Image2D> mipLevels;
+    if(args.isSet("mipmaps")) {
+        TextureTools::MipmapFilter filter;
+        if(args.value("mipmap-filter") == "box")
+            filter = TextureTools::MipmapFilter::Box;
+        else if(args.value("mipmap-filter") == "kaiser")
+            filter = TextureTools::MipmapFilter::Kaiser;
+        else {
+            Error() << "Unknown mipmap filter" << args.value("mipmap-filter");
+            return 1;
+        }
+
+        if(args.value("converter") == "raw") {
+            Error() << "Mipmaps can't be saved as raw data";
+            return 1;
+        }
+
+        if(image->isCompressed()) {
+            Error() << "Can't generate mipmaps for a compressed image";
+            return 4;
+        }
+        if(!TextureTools::isMipmapFormatSupported(image->format())) {
+            Error() << "Can't generate mipmaps for an image of format" << image->format();
+            return 4;
+        }
+
+        mipLevels = TextureTools::mipmaps(*image, filter);
+    }
+
     {
         Debug d;
         if(args.value("converter") == "raw")
@@ -303,9 +605,6 @@ key=true; configuration subgroups are delimited with /.)")
     }
 
     /* Load converter plugin */
-    PluginManager::Manager<Trade::AbstractImageConverter> converterManager{
-        args.value("plugin-dir").empty() ? std::string{} :
-        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImageConverter::pluginSearchPaths()[0])};
     Containers::Pointer<Trade::AbstractImageConverter> converter = converterManager.loadAndInstantiate(args.value("converter"));
     if(!converter) {
         Debug{} << "Available converter plugins:" << Utility::String::join(converterManager.aliasList(), ", ");
@@ -316,8 +615,21 @@ key=true; configuration subgroups are delimited with /.)")
     if(args.isSet("verbose")) converter->setFlags(Trade::ImageConverterFlag::Verbose);
     Implementation::setOptions(*converter, args.value("converter-options"));
 
-    /* Save output file */
-    if(!converter->exportToFile(*image, output)) {
+    /* Save output file, together with the mip levels if generated */
+    if(args.isSet("mipmaps")) {
+        if(!(converter->features() >= (Trade::ImageConverterFeature::ConvertFile|Trade::ImageConverterFeature::ConvertLevels))) {
+            Error() << "Converter" << args.value("converter") << "doesn't support saving multiple image levels";
+            return 5;
+        }
+
+        Containers::Array<ImageView2D> levels;
+        arrayAppend(levels, Containers::InPlaceInit, *image);
+        for(const Image2D& level: mipLevels) arrayAppend(levels, Containers::InPlaceInit, level);
+        if(!converter->exportLevelsToFile(levels, output)) {
+            Error() << "Cannot save file" << output;
+            return 5;
+        }
+    } else if(!converter->exportToFile(*image, output)) {
         Error() << "Cannot save file" << output;
         return 5;
     }
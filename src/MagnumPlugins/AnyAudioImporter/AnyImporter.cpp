@@ -39,7 +39,10 @@ AnyImporter::AnyImporter(PluginManager::AbstractManager& manager, const std::str
 
 AnyImporter::~AnyImporter() = default;
 
-ImporterFeatures AnyImporter::doFeatures() const { return {}; }
+ImporterFeatures AnyImporter::doFeatures() const {
+    /* Streaming is available only if the concrete importer supports it */
+    return _in ? _in->features() & ImporterFeature::Streaming : ImporterFeatures{};
+}
 
 bool AnyImporter::doIsOpened() const { return !!_in; }
 
@@ -89,7 +92,13 @@ UnsignedInt AnyImporter::doFrequency() const { return _in->frequency(); }
 
 Containers::Array<char> AnyImporter::doData() { return _in->data(); }
 
+UnsignedLong AnyImporter::doFrameCount() const { return _in->frameCount(); }
+
+bool AnyImporter::doSeek(const UnsignedLong frame) { return _in->seek(frame); }
+
+std::size_t AnyImporter::doRead(const Containers::ArrayView<char> destination) { return _in->read(destination); }
+
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyAudioImporter, Magnum::Audio::AnyImporter,
-    "cz.mosra.magnum.Audio.AbstractImporter/0.1")
+    "cz.mosra.magnum.Audio.AbstractImporter/0.2")
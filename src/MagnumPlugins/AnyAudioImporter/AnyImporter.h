@@ -68,7 +68,9 @@ tries to open the file with it. Supported formats:
     plugin that provides it
 -   FLAC (`*.flac`), loaded with any plugin that provides `FlacAudioImporter`
 
-Only loading from files is supported.
+Only loading from files is supported. Once a file is opened,
+@ref ImporterFeature::Streaming is advertised and forwarded if the concrete
+importer supports it.
 
 @section Audio-AnyImporter-usage Usage
 
@@ -120,6 +122,10 @@ class MAGNUM_ANYAUDIOIMPORTER_EXPORT AnyImporter: public AbstractImporter {
         MAGNUM_ANYAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_ANYAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
 
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL UnsignedLong doFrameCount() const override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL bool doSeek(UnsignedLong frame) override;
+        MAGNUM_ANYAUDIOIMPORTER_LOCAL std::size_t doRead(Containers::ArrayView<char> destination) override;
+
         Containers::Pointer<AbstractImporter> _in;
 };
 
@@ -100,6 +100,12 @@ void AnyImporterTest::load() {
     CORRADE_COMPARE(importer->frequency(), 96000);
     CORRADE_COMPARE(importer->data().size(), 4);
 
+    /* Streaming is forwarded */
+    CORRADE_VERIFY(importer->features() & ImporterFeature::Streaming);
+    CORRADE_COMPARE(importer->frameCount(), 2);
+    char chunk[4];
+    CORRADE_COMPARE(importer->read(chunk), 2);
+
     importer->close();
     CORRADE_VERIFY(!importer->isOpened());
 }
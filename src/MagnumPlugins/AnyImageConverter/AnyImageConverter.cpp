@@ -112,4 +112,4 @@ bool AnyImageConverter::doExportToFile(const CompressedImageView2D&, const std::
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyImageConverter, Magnum::Trade::AnyImageConverter,
-    "cz.mosra.magnum.Trade.AbstractImageConverter/0.2.1")
+    "cz.mosra.magnum.Trade.AbstractImageConverter/0.2.3")
@@ -249,4 +249,4 @@ Containers::Optional<ImageData2D> AnyImageImporter::doImage2D(const UnsignedInt
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyImageImporter, Magnum::Trade::AnyImageImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3.3")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.4")
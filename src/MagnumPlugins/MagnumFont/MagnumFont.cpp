@@ -25,6 +25,9 @@
 
 #include "MagnumFont.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
@@ -36,6 +39,7 @@
 #include "Magnum/Math/ConfigurationValue.h"
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/MagnumFont/MagnumFontMetrics.h"
 #include "MagnumPlugins/TgaImporter/TgaImporter.h"
 
 namespace Magnum { namespace Text {
@@ -49,23 +53,69 @@ struct MagnumFont::Data {
     Utility::Configuration conf;
     Containers::Optional<Trade::ImageData2D> image;
     Containers::Optional<std::string> filePath;
-    std::unordered_map<char32_t, UnsignedInt> glyphId;
-    std::vector<Vector2> glyphAdvance;
+
+    /* Binary metrics, either built from the textual format, read from a
+       file, memory-mapped or kept from the file callback. The views below
+       point into one of these. */
+    Containers::Array<char> metricsData;
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Utility::Directory::MapDeleter> mappedMetricsData;
+    #endif
+    Containers::Optional<std::string> callbackMetricsFilename;
+
+    Containers::ArrayView<const Implementation::MagnumFontMetricsGlyph> glyphs;
+    Containers::ArrayView<const UnsignedShort> bmp;
+    Containers::ArrayView<const Implementation::MagnumFontMetricsCharacter> others;
 };
 
 namespace {
     class MagnumFontLayouter: public AbstractLayouter {
         public:
-            explicit MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, Float fontSize, Float textSize, std::vector<UnsignedInt>&& glyphs);
+            explicit MagnumFontLayouter(Containers::ArrayView<const Implementation::MagnumFontMetricsGlyph> glyphData, const AbstractGlyphCache& cache, Float fontSize, Float textSize, Containers::Array<UnsignedInt>&& glyphs, UnsignedInt glyphCount);
 
         private:
             std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override;
 
-            const std::vector<Vector2>& glyphAdvance;
+            const Containers::ArrayView<const Implementation::MagnumFontMetricsGlyph> glyphData;
             const AbstractGlyphCache& cache;
             const Float fontSize, textSize;
-            const std::vector<UnsignedInt> glyphs;
+            const Containers::Array<UnsignedInt> glyphs;
     };
+
+    /* Sets up the views, returns false if the data are not valid */
+    bool setupMetrics(Containers::ArrayView<const char> data, Containers::ArrayView<const Implementation::MagnumFontMetricsGlyph>& glyphs, Containers::ArrayView<const UnsignedShort>& bmp, Containers::ArrayView<const Implementation::MagnumFontMetricsCharacter>& others) {
+        if(data.size() < sizeof(Implementation::MagnumFontMetricsHeader)) {
+            Error{} << "Text::MagnumFont::openData(): metrics file too short, expected at least" << sizeof(Implementation::MagnumFontMetricsHeader) << "bytes but got" << data.size();
+            return false;
+        }
+
+        const auto& header = *reinterpret_cast<const Implementation::MagnumFontMetricsHeader*>(data.data());
+        if(std::memcmp(header.magic, Implementation::MagnumFontMetricsMagic, 4) != 0 || header.version != Implementation::MagnumFontMetricsVersion) {
+            Error{} << "Text::MagnumFont::openData(): invalid metrics file signature";
+            return false;
+        }
+
+        if(data.size() != Implementation::magnumFontMetricsSize(header)) {
+            Error{} << "Text::MagnumFont::openData(): metrics file size mismatch, expected" << Implementation::magnumFontMetricsSize(header) << "bytes but got" << data.size();
+            return false;
+        }
+
+        glyphs = Containers::arrayCast<const Implementation::MagnumFontMetricsGlyph>(data.slice(sizeof(Implementation::MagnumFontMetricsHeader), Implementation::magnumFontMetricsBmpOffset(header)));
+        bmp = {reinterpret_cast<const UnsignedShort*>(data.data() + Implementation::magnumFontMetricsBmpOffset(header)), header.bmpCount};
+        others = Containers::arrayCast<const Implementation::MagnumFontMetricsCharacter>(data.suffix(Implementation::magnumFontMetricsOtherOffset(header)));
+
+        /* Check glyph IDs once here so the lookup doesn't need to */
+        for(const UnsignedShort glyph: bmp) if(glyph >= header.glyphCount) {
+            Error{} << "Text::MagnumFont::openData(): glyph ID" << glyph << "out of bounds for" << header.glyphCount << "glyphs";
+            return false;
+        }
+        for(const Implementation::MagnumFontMetricsCharacter& c: others) if(c.glyph >= header.glyphCount) {
+            Error{} << "Text::MagnumFont::openData(): glyph ID" << c.glyph << "out of bounds for" << header.glyphCount << "glyphs";
+            return false;
+        }
+
+        return true;
+    }
 }
 
 MagnumFont::MagnumFont(): _opened(nullptr) {}
@@ -78,7 +128,12 @@ FontFeatures MagnumFont::doFeatures() const { return FontFeature::OpenData|FontF
 
 bool MagnumFont::doIsOpened() const { return _opened && _opened->image; }
 
-void MagnumFont::doClose() { _opened = nullptr; }
+void MagnumFont::doClose() {
+    /* Release the metrics data held since opening */
+    if(_opened && _opened->callbackMetricsFilename)
+        fileCallback()(*_opened->callbackMetricsFilename, InputFileCallbackPolicy::Close, fileCallbackUserData());
+    _opened = nullptr;
+}
 
 auto MagnumFont::doOpenData(const Containers::ArrayView<const char> data, const Float) -> Metrics {
     if(!_opened) _opened.emplace();
@@ -98,9 +153,10 @@ auto MagnumFont::doOpenData(const Containers::ArrayView<const char> data, const
     }
 
     /* Check version */
-    if(conf.value<UnsignedInt>("version") != 1) {
-        Error() << "Text::MagnumFont::openData(): unsupported file version, expected 1 but got"
-                << conf.value<UnsignedInt>("version");
+    const UnsignedInt version = conf.value<UnsignedInt>("version");
+    if(version != 1 && version != 2) {
+        Error() << "Text::MagnumFont::openData(): unsupported file version, expected 1 or 2 but got"
+                << version;
         return {};
     }
 
@@ -109,25 +165,96 @@ auto MagnumFont::doOpenData(const Containers::ArrayView<const char> data, const
     Trade::TgaImporter importer;
     importer.setFileCallback(fileCallback(), fileCallbackUserData());
     if(!importer.openFile(Utility::Directory::join(_opened->filePath ? *_opened->filePath : "", conf.value("image")))) return {};
-    _opened->image = importer.image2D(0);
-    if(!_opened->image) return {};
+    Containers::Optional<Trade::ImageData2D> image = importer.image2D(0);
+    if(!image) return {};
+
+    /* Version 1 has glyph and character info in the configuration file, put
+       it into the same binary representation as version 2 uses so the
+       lookup is the same for both */
+    Containers::ArrayView<const char> metrics;
+    if(version == 1) {
+        const std::vector<Utility::ConfigurationGroup*> glyphs = conf.groups("glyph");
+        Containers::Array<Implementation::MagnumFontMetricsGlyph> glyphData{Containers::NoInit, glyphs.size()};
+        for(std::size_t i = 0; i != glyphs.size(); ++i)
+            glyphData[i] = Implementation::MagnumFontMetricsGlyph{
+                glyphs[i]->value<Vector2>("advance"),
+                glyphs[i]->value<Vector2i>("position"),
+                glyphs[i]->value<Range2Di>("rectangle")};
+
+        const std::vector<Utility::ConfigurationGroup*> chars = conf.groups("char");
+        Containers::Array<Implementation::MagnumFontMetricsCharacter> charData{Containers::NoInit, chars.size()};
+        for(std::size_t i = 0; i != chars.size(); ++i)
+            charData[i] = Implementation::MagnumFontMetricsCharacter{
+                chars[i]->value<char32_t>("unicode"),
+                chars[i]->value<UnsignedInt>("glyph")};
+
+        _opened->metricsData = Implementation::magnumFontMetrics(glyphData, charData);
+        metrics = _opened->metricsData;
+
+    /* Version 2 has them in a separate binary file. Keep it around instead
+       of parsing it, if possible without a copy. */
+    } else {
+        if(!conf.hasValue("metrics")) {
+            Error{} << "Text::MagnumFont::openData(): metrics file not specified";
+            return {};
+        }
+
+        const std::string metricsFilename = Utility::Directory::join(_opened->filePath ? *_opened->filePath : "", conf.value("metrics"));
+        if(fileCallback()) {
+            const Containers::Optional<Containers::ArrayView<const char>> data = fileCallback()(metricsFilename, InputFileCallbackPolicy::LoadPermanent, fileCallbackUserData());
+            if(!data) {
+                Error{} << "Text::MagnumFont::openData(): cannot open file" << metricsFilename;
+                return {};
+            }
+            _opened->callbackMetricsFilename = metricsFilename;
+
+            /* If the callback data are not aligned enough for the
+               tables, make a copy */
+            if(reinterpret_cast<std::uintptr_t>(data->data()) % 4) {
+                _opened->metricsData = Containers::Array<char>{Containers::NoInit, data->size()};
+                std::copy(data->begin(), data->end(), _opened->metricsData.begin());
+                metrics = _opened->metricsData;
+            } else metrics = *data;
+        } else {
+            if(!Utility::Directory::exists(metricsFilename)) {
+                Error{} << "Text::MagnumFont::openData(): cannot open file" << metricsFilename;
+                return {};
+            }
+
+            #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+            _opened->mappedMetricsData = Utility::Directory::mapRead(metricsFilename);
+            metrics = _opened->mappedMetricsData;
+            #else
+            _opened->metricsData = Utility::Directory::read(metricsFilename);
+            metrics = _opened->metricsData;
+            #endif
+        }
+
+        /* The file is little-endian, on big-endian platforms convert a copy
+           to the native endianness */
+        #ifdef CORRADE_TARGET_BIG_ENDIAN
+        if(metrics.data() != _opened->metricsData.data()) {
+            _opened->metricsData = Containers::Array<char>{Containers::NoInit, metrics.size()};
+            std::copy(metrics.begin(), metrics.end(), _opened->metricsData.begin());
+        }
+        Implementation::magnumFontMetricsLittleEndianInPlace(_opened->metricsData, true);
+        metrics = _opened->metricsData;
+        #endif
+    }
+
+    if(!setupMetrics(metrics, _opened->glyphs, _opened->bmp, _opened->others)) {
+        /* The font won't be opened so doClose() won't get called, release
+           the data here */
+        if(_opened->callbackMetricsFilename) {
+            fileCallback()(*_opened->callbackMetricsFilename, InputFileCallbackPolicy::Close, fileCallbackUserData());
+            _opened->callbackMetricsFilename = Containers::NullOpt;
+        }
+        return {};
+    }
 
     /* Everything okay, save the data internally */
     _opened->conf = std::move(conf);
-
-    /* Glyph advances */
-    const std::vector<Utility::ConfigurationGroup*> glyphs = _opened->conf.groups("glyph");
-    _opened->glyphAdvance.reserve(glyphs.size());
-    for(const Utility::ConfigurationGroup* const g: glyphs)
-        _opened->glyphAdvance.push_back(g->value<Vector2>("advance"));
-
-    /* Fill character->glyph map */
-    const std::vector<Utility::ConfigurationGroup*> chars = _opened->conf.groups("char");
-    for(const Utility::ConfigurationGroup* const c: chars) {
-        const UnsignedInt glyphId = c->value<UnsignedInt>("glyph");
-        CORRADE_INTERNAL_ASSERT(glyphId < _opened->glyphAdvance.size());
-        _opened->glyphId.emplace(c->value<char32_t>("unicode"), glyphId);
-    }
+    _opened->image = std::move(image);
 
     return {_opened->conf.value<Float>("fontSize"),
             _opened->conf.value<Float>("ascent"),
@@ -143,12 +270,20 @@ auto MagnumFont::doOpenFile(const std::string& filename, Float size) -> Metrics
 }
 
 UnsignedInt MagnumFont::doGlyphId(const char32_t character) {
-    auto it = _opened->glyphId.find(character);
-    return it != _opened->glyphId.end() ? it->second : 0;
+    /* Direct lookup for BMP characters, glyph 0 means not found there */
+    if(character < _opened->bmp.size() && _opened->bmp[character])
+        return _opened->bmp[character];
+
+    /* Binary search for the rest */
+    const Implementation::MagnumFontMetricsCharacter* const found = std::lower_bound(_opened->others.begin(), _opened->others.end(), character,
+        [](const Implementation::MagnumFontMetricsCharacter& a, const char32_t b) {
+            return a.character < b;
+        });
+    return found != _opened->others.end() && found->character == character ? found->glyph : 0;
 }
 
 Vector2 MagnumFont::doGlyphAdvance(const UnsignedInt glyph) {
-    return glyph < _opened->glyphAdvance.size() ? _opened->glyphAdvance[glyph] : Vector2();
+    return glyph < _opened->glyphs.size() ? _opened->glyphs[glyph].advance : Vector2();
 }
 
 Containers::Pointer<AbstractGlyphCache> MagnumFont::doCreateGlyphCache() {
@@ -160,30 +295,29 @@ Containers::Pointer<AbstractGlyphCache> MagnumFont::doCreateGlyphCache() {
     cache->setImage({}, *_opened->image);
 
     /* Fill glyph map */
-    const std::vector<Utility::ConfigurationGroup*> glyphs = _opened->conf.groups("glyph");
-    for(std::size_t i = 0; i != glyphs.size(); ++i)
-        cache->insert(i, glyphs[i]->value<Vector2i>("position"), glyphs[i]->value<Range2Di>("rectangle"));
+    for(std::size_t i = 0; i != _opened->glyphs.size(); ++i)
+        cache->insert(i, _opened->glyphs[i].position, _opened->glyphs[i].rectangle);
 
     return cache;
 }
 
 Containers::Pointer<AbstractLayouter> MagnumFont::doLayout(const AbstractGlyphCache& cache, Float size, const std::string& text) {
-    /* Get glyph codes from characters */
-    std::vector<UnsignedInt> glyphs;
-    glyphs.reserve(text.size());
+    /* Get glyph codes from characters. There's at most one glyph per byte,
+       so allocate just once for the worst case. */
+    Containers::Array<UnsignedInt> glyphs{Containers::NoInit, text.size()};
+    UnsignedInt glyphCount = 0;
     for(std::size_t i = 0; i != text.size(); ) {
-        UnsignedInt codepoint;
+        char32_t codepoint;
         std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
-        const auto it = _opened->glyphId.find(codepoint);
-        glyphs.push_back(it == _opened->glyphId.end() ? 0 : it->second);
+        glyphs[glyphCount++] = doGlyphId(codepoint);
     }
 
-    return Containers::Pointer<MagnumFontLayouter>(new MagnumFontLayouter(_opened->glyphAdvance, cache, this->size(), size, std::move(glyphs)));
+    return Containers::Pointer<MagnumFontLayouter>(new MagnumFontLayouter(_opened->glyphs, cache, this->size(), size, std::move(glyphs), glyphCount));
 }
 
 namespace {
 
-MagnumFontLayouter::MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), glyphAdvance(glyphAdvance), cache(cache), fontSize(fontSize), textSize(textSize), glyphs(std::move(glyphs)) {}
+MagnumFontLayouter::MagnumFontLayouter(const Containers::ArrayView<const Implementation::MagnumFontMetricsGlyph> glyphData, const AbstractGlyphCache& cache, const Float fontSize, const Float textSize, Containers::Array<UnsignedInt>&& glyphs, const UnsignedInt glyphCount): AbstractLayouter(glyphCount), glyphData(glyphData), cache(cache), fontSize(fontSize), textSize(textSize), glyphs(std::move(glyphs)) {}
 
 std::tuple<Range2D, Range2D, Vector2> MagnumFontLayouter::doRenderGlyph(const UnsignedInt i) {
     /* Position of the texture in the resulting glyph, texture coordinates */
@@ -199,7 +333,7 @@ std::tuple<Range2D, Range2D, Vector2> MagnumFontLayouter::doRenderGlyph(const Un
     const auto quadRectangle = Range2D(Range2Di::fromSize(position, rectangle.size())).scaled(Vector2(textSize/fontSize));
 
     /* Advance for given glyph, denormalized to requested text size */
-    const Vector2 advance = glyphAdvance[glyphs[i]]*(textSize/fontSize);
+    const Vector2 advance = glyphData[glyphs[i]].advance*(textSize/fontSize);
 
     return std::make_tuple(quadRectangle, textureCoordinates, advance);
 }
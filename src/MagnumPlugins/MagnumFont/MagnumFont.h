@@ -58,10 +58,62 @@ namespace Magnum { namespace Text {
 /**
 @brief Simple bitmap font plugin
 
-The font consists of two files, one text file containing character and glyph
-info and one TGA file containing the glyphs in distance field format. The font
-can be conveniently created from any other format using
-@ref MagnumFontConverter. The file syntax is as in following:
+The font consists of a text file containing font properties, a binary file
+containing character and glyph info and a TGA file containing the glyphs in
+distance field format. The font can be conveniently created from any other
+format using @ref MagnumFontConverter. The configuration file syntax is as in
+following:
+
+@code{.ini}
+# File format version
+version=2
+
+# Font image filename
+image=font.tga
+
+# Glyph metrics and character mapping filename
+metrics=font.metrics
+
+# Size of unscaled font image
+originalImageSize=1536 1536
+
+# Glyph padding
+padding=9
+
+# Font size
+fontSize=128
+
+# Line height
+lineHeight=270
+@endcode
+
+The metrics file is a little-endian binary file, consisting of a 32-byte
+header followed by three tightly packed tables:
+
+-   the header contains a @cb{.txt} MFNT @ce signature, a 32-bit format
+    version (@cpp 1 @ce), 32-bit glyph count, 32-bit count of entries in the
+    direct-mapped table, 32-bit count of entries in the sorted table and
+    12 reserved bytes
+-   the glyph table, with each 32-byte entry containing advance to next
+    character as two 32-bit floats, glyph texture position relative to
+    baseline as two 32-bit integers and glyph rectangle in the font image as
+    four 32-bit integers (left, bottom, right, top), all in pixels
+-   a direct-mapped table of 16-bit glyph IDs for characters from the Basic
+    Multilingual Plane, indexed by the UTF-32 codepoint, with zero meaning the
+    character is either not present or is in the sorted table; padded to a
+    multiple of four bytes
+-   a table of (32-bit UTF-32 codepoint, 32-bit glyph ID) pairs for the
+    remaining characters, sorted by the codepoint
+
+The file is used as-is without any parsing --- if the plugin has a
+file callback set using @ref AbstractFont::setFileCallback(), it's loaded with
+@ref InputFileCallbackPolicy::LoadPermanent and kept until the font is closed,
+otherwise it's memory-mapped where the platform supports it. Glyph ID lookup
+for BMP characters is then a single table access, the rest is a binary search.
+
+The original textual format, with version set to @cpp 1 @ce and glyph and
+character info contained directly in the configuration file, is still
+supported for loading. Its syntax is as in following:
 
 @code{.ini}
 # Font image filename
@@ -0,0 +1,166 @@
+#ifndef Magnum_Text_MagnumFontMetrics_h
+#define Magnum_Text_MagnumFontMetrics_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+
+/* Used by both MagnumFont and MagnumFontConverter, which is why it isn't
+   directly inside MagnumFont.cpp. OTOH it doesn't need to be exposed
+   publicly, which is why it has no docblocks. The format is described in
+   the MagnumFont class docs. */
+
+namespace Magnum { namespace Text { namespace Implementation {
+
+/* Binary font metrics file header. All data are little-endian, the tables
+   follow the header in order glyphs, BMP characters (padded to four bytes),
+   other characters. */
+struct MagnumFontMetricsHeader {
+    char magic[4];              /* MFNT */
+    UnsignedInt version;        /* 1 */
+    UnsignedInt glyphCount;     /* Size of the glyph table */
+    UnsignedInt bmpCount;       /* Size of the direct-mapped BMP table */
+    UnsignedInt otherCount;     /* Size of the sorted table for the rest */
+    UnsignedInt reserved[3];
+};
+
+/* Same as the [glyph] group in the textual format */
+struct MagnumFontMetricsGlyph {
+    Vector2 advance;
+    Vector2i position;
+    Range2Di rectangle;
+};
+
+/* A character outside of BMP, or one that maps to a glyph ID that doesn't fit
+   into 16 bits */
+struct MagnumFontMetricsCharacter {
+    UnsignedInt character;
+    UnsignedInt glyph;
+};
+
+static_assert(sizeof(MagnumFontMetricsHeader) == 32, "MagnumFontMetricsHeader size is not 32 bytes");
+static_assert(sizeof(MagnumFontMetricsGlyph) == 32, "MagnumFontMetricsGlyph size is not 32 bytes");
+static_assert(sizeof(MagnumFontMetricsCharacter) == 8, "MagnumFontMetricsCharacter size is not 8 bytes");
+
+constexpr char MagnumFontMetricsMagic[]{'M', 'F', 'N', 'T'};
+constexpr UnsignedInt MagnumFontMetricsVersion = 1;
+
+inline std::size_t magnumFontMetricsBmpOffset(const MagnumFontMetricsHeader& header) {
+    return sizeof(MagnumFontMetricsHeader) + std::size_t(header.glyphCount)*sizeof(MagnumFontMetricsGlyph);
+}
+
+inline std::size_t magnumFontMetricsOtherOffset(const MagnumFontMetricsHeader& header) {
+    return magnumFontMetricsBmpOffset(header) + ((std::size_t(header.bmpCount)*sizeof(UnsignedShort) + 3) & ~std::size_t{3});
+}
+
+inline std::size_t magnumFontMetricsSize(const MagnumFontMetricsHeader& header) {
+    return magnumFontMetricsOtherOffset(header) + std::size_t(header.otherCount)*sizeof(MagnumFontMetricsCharacter);
+}
+
+/* Converts the header and the tables between little endian and the native
+   endianness in place, a no-op on little-endian platforms. The table sizes
+   are taken from the header, after converting it if the data are
+   little-endian. If the data size doesn't match the header, only the header
+   is converted and the size check in MagnumFont fails afterwards. */
+inline void magnumFontMetricsLittleEndianInPlace(const Containers::ArrayView<char> data, const bool fromLittleEndian) {
+    if(data.size() < sizeof(MagnumFontMetricsHeader)) return;
+
+    auto& header = *reinterpret_cast<MagnumFontMetricsHeader*>(data.data());
+    if(fromLittleEndian)
+        Utility::Endianness::littleEndianInPlace(header.version, header.glyphCount, header.bmpCount, header.otherCount);
+    const MagnumFontMetricsHeader nativeHeader = header;
+    if(!fromLittleEndian)
+        Utility::Endianness::littleEndianInPlace(header.version, header.glyphCount, header.bmpCount, header.otherCount);
+
+    if(data.size() != magnumFontMetricsSize(nativeHeader)) return;
+
+    for(MagnumFontMetricsGlyph& glyph: Containers::arrayCast<MagnumFontMetricsGlyph>(data.slice(sizeof(MagnumFontMetricsHeader), magnumFontMetricsBmpOffset(nativeHeader))))
+        Utility::Endianness::littleEndianInPlace(
+            glyph.advance.x(), glyph.advance.y(),
+            glyph.position.x(), glyph.position.y(),
+            glyph.rectangle.min().x(), glyph.rectangle.min().y(),
+            glyph.rectangle.max().x(), glyph.rectangle.max().y());
+    for(UnsignedShort& glyph: Containers::arrayCast<UnsignedShort>(data.slice(magnumFontMetricsBmpOffset(nativeHeader), magnumFontMetricsBmpOffset(nativeHeader) + nativeHeader.bmpCount*sizeof(UnsignedShort))))
+        Utility::Endianness::littleEndianInPlace(glyph);
+    for(MagnumFontMetricsCharacter& c: Containers::arrayCast<MagnumFontMetricsCharacter>(data.suffix(magnumFontMetricsOtherOffset(nativeHeader))))
+        Utility::Endianness::littleEndianInPlace(c.character, c.glyph);
+}
+
+/* Builds the binary representation, in native endianness. If a character is
+   listed more than once, the first occurence is used. BMP characters are put
+   into a direct-mapped table spanning up to the highest BMP character
+   present, glyph 0 meaning the character is not present. The rest is sorted
+   for a binary search. */
+inline Containers::Array<char> magnumFontMetrics(const Containers::ArrayView<const MagnumFontMetricsGlyph> glyphs, const Containers::ArrayView<const MagnumFontMetricsCharacter> characters) {
+    MagnumFontMetricsHeader header{};
+    std::memcpy(header.magic, MagnumFontMetricsMagic, 4);
+    header.version = MagnumFontMetricsVersion;
+    header.glyphCount = glyphs.size();
+
+    /* Characters that go into the sorted table, in a stable order so the
+       first occurence is kept */
+    Containers::Array<MagnumFontMetricsCharacter> others{Containers::NoInit, characters.size()};
+    for(const MagnumFontMetricsCharacter& c: characters) {
+        if(c.character < 0x10000 && c.glyph < 0x10000)
+            header.bmpCount = Math::max(header.bmpCount, c.character + 1);
+        else
+            others[header.otherCount++] = c;
+    }
+    std::stable_sort(others.begin(), others.begin() + header.otherCount,
+        [](const MagnumFontMetricsCharacter& a, const MagnumFontMetricsCharacter& b) {
+            return a.character < b.character;
+        });
+    header.otherCount = std::unique(others.begin(), others.begin() + header.otherCount,
+        [](const MagnumFontMetricsCharacter& a, const MagnumFontMetricsCharacter& b) {
+            return a.character == b.character;
+        }) - others.begin();
+
+    Containers::Array<char> out{Containers::ValueInit, magnumFontMetricsSize(header)};
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(header), glyphs.data(), glyphs.size()*sizeof(MagnumFontMetricsGlyph));
+
+    /* Go backwards so the first occurence overwrites the others */
+    UnsignedShort* const bmp = reinterpret_cast<UnsignedShort*>(out.data() + magnumFontMetricsBmpOffset(header));
+    for(std::size_t i = characters.size(); i != 0; --i) {
+        const MagnumFontMetricsCharacter& c = characters[i - 1];
+        if(c.character < 0x10000 && c.glyph < 0x10000)
+            bmp[c.character] = c.glyph;
+    }
+
+    std::memcpy(out.data() + magnumFontMetricsOtherOffset(header), others.data(), header.otherCount*sizeof(MagnumFontMetricsCharacter));
+
+    return out;
+}
+
+}}}
+
+#endif
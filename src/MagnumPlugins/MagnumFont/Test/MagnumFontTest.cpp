@@ -24,11 +24,13 @@
 */
 
 #include <sstream>
+#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
 
 #include "Magnum/FileCallback.h"
 #include "Magnum/Text/AbstractFont.h"
@@ -48,19 +50,60 @@ struct MagnumFontTest: TestSuite::Tester {
 
     void fileCallbackImage();
     void fileCallbackImageNotFound();
+    void fileCallbackMetrics();
+
+    void metricsNotSpecified();
+    void metricsNotFound();
+    void metricsInvalid();
 
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<Trade::AbstractImporter> _importerManager{"nonexistent"};
     PluginManager::Manager<AbstractFont> _fontManager{"nonexistent"};
 };
 
+constexpr struct {
+    const char* name;
+    const char* filename;
+} FileData[]{
+    {"textual metrics", "font.conf"},
+    {"binary metrics", "font-v2.conf"}
+};
+
+constexpr struct {
+    const char* name;
+    std::size_t size;
+    std::size_t offset;
+    char value;
+    const char* message;
+} MetricsInvalidData[]{
+    {"too short", 31, 0, 0,
+        "metrics file too short, expected at least 32 bytes but got 31"},
+    {"invalid signature", 368, 0, 'X',
+        "invalid metrics file signature"},
+    {"invalid version", 368, 4, 2,
+        "invalid metrics file signature"},
+    {"size mismatch", 367, 0, 0,
+        "metrics file size mismatch, expected 368 bytes but got 367"},
+    {"glyph out of bounds", 368, 32 + 3*32 + 0x57*2, 3,
+        "glyph ID 3 out of bounds for 3 glyphs"}
+};
+
 MagnumFontTest::MagnumFontTest() {
-    addTests({&MagnumFontTest::nonexistent,
-              &MagnumFontTest::properties,
-              &MagnumFontTest::layout,
+    addTests({&MagnumFontTest::nonexistent});
+
+    addInstancedTests({&MagnumFontTest::properties,
+                       &MagnumFontTest::layout},
+        Containers::arraySize(FileData));
+
+    addTests({&MagnumFontTest::fileCallbackImage,
+              &MagnumFontTest::fileCallbackImageNotFound,
+              &MagnumFontTest::fileCallbackMetrics,
+
+              &MagnumFontTest::metricsNotSpecified,
+              &MagnumFontTest::metricsNotFound});
 
-              &MagnumFontTest::fileCallbackImage,
-              &MagnumFontTest::fileCallbackImageNotFound});
+    addInstancedTests({&MagnumFontTest::metricsInvalid},
+        Containers::arraySize(MetricsInvalidData));
 
     /* Load the plugins directly from the build tree. Otherwise they're static
        and already loaded. */
@@ -81,20 +124,31 @@ void MagnumFontTest::nonexistent() {
 }
 
 void MagnumFontTest::properties() {
+    auto&& data = FileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
     Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
 
-    CORRADE_VERIFY(font->openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+    CORRADE_VERIFY(font->openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, data.filename), 0.0f));
     CORRADE_COMPARE(font->size(), 16.0f);
     CORRADE_COMPARE(font->ascent(), 25.0f);
     CORRADE_COMPARE(font->descent(), -10.0f);
     CORRADE_COMPARE(font->lineHeight(), 39.7333f);
+    CORRADE_COMPARE(font->glyphId(U'W'), 2);
+    CORRADE_COMPARE(font->glyphId(U'e'), 1);
+    CORRADE_COMPARE(font->glyphId(U'a'), 0);
+    CORRADE_COMPARE(font->glyphId(U'\U0001F600'), 0);
     CORRADE_COMPARE(font->glyphAdvance(font->glyphId(U'W')), Vector2(23.0f, 0.0f));
+    CORRADE_COMPARE(font->glyphAdvance(3), Vector2());
 }
 
 void MagnumFontTest::layout() {
+    auto&& data = FileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
     Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
 
-    CORRADE_VERIFY(font->openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+    CORRADE_VERIFY(font->openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, data.filename), 0.0f));
 
     /* Fill the cache with some fake glyphs */
     struct DummyGlyphCache: AbstractGlyphCache {
@@ -175,6 +229,108 @@ void MagnumFontTest::fileCallbackImageNotFound() {
     CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::openFile(): cannot open file font.tga\n");
 }
 
+void MagnumFontTest::fileCallbackMetrics() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    std::unordered_map<std::string, Containers::Array<char>> files;
+    files["not/a/path/font-v2.conf"] = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font-v2.conf"));
+    files["not/a/path/font.tga"] = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.tga"));
+    files["not/a/path/font.metrics"] = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.metrics"));
+    font->setFileCallback([](const std::string& filename, InputFileCallbackPolicy policy,
+        std::unordered_map<std::string, Containers::Array<char>>& files) {
+            if(filename == "not/a/path/font.metrics")
+                Debug{} << "Loading" << filename << "with" << policy;
+            return Containers::optional(Containers::ArrayView<const char>(files.at(filename)));
+        }, files);
+
+    /* The metrics should be requested permanently and released only when the
+       font is closed */
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(font->openFile("not/a/path/font-v2.conf", 13.0f));
+    }
+    CORRADE_COMPARE(out.str(), "Loading not/a/path/font.metrics with InputFileCallbackPolicy::LoadPermanent\n");
+    CORRADE_COMPARE(font->glyphAdvance(font->glyphId(U'W')), Vector2(23.0f, 0.0f));
+
+    out.str({});
+    {
+        Debug redirectOutput{&out};
+        font->close();
+    }
+    CORRADE_COMPARE(out.str(), "Loading not/a/path/font.metrics with InputFileCallbackPolicy::Close\n");
+}
+
+void MagnumFontTest::metricsNotSpecified() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    std::unordered_map<std::string, Containers::Array<char>> files;
+    files["font.conf"] = Containers::Array<char>{Containers::InPlaceInit, {
+        'v', 'e', 'r', 's', 'i', 'o', 'n', '=', '2', '\n'}};
+    files["font.tga"] = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.tga"));
+    font->setFileCallback([](const std::string& filename, InputFileCallbackPolicy,
+        std::unordered_map<std::string, Containers::Array<char>>& files) {
+            return Containers::optional(Containers::ArrayView<const char>(files.at(filename)));
+        }, files);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!font->openFile("font.conf", 13.0f));
+    CORRADE_COMPARE(out.str(), "Text::MagnumFont::openData(): metrics file not specified\n");
+}
+
+void MagnumFontTest::metricsNotFound() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    std::unordered_map<std::string, Containers::Array<char>> files;
+    files["not/a/path/font-v2.conf"] = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font-v2.conf"));
+    files["not/a/path/font.tga"] = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.tga"));
+    font->setFileCallback([](const std::string& filename, InputFileCallbackPolicy,
+        std::unordered_map<std::string, Containers::Array<char>>& files) -> Containers::Optional<Containers::ArrayView<const char>> {
+            auto found = files.find(filename);
+            if(found == files.end()) return {};
+            return Containers::ArrayView<const char>{found->second};
+        }, files);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!font->openFile("not/a/path/font-v2.conf", 13.0f));
+    CORRADE_COMPARE(out.str(), "Text::MagnumFont::openData(): cannot open file not/a/path/font.metrics\n");
+}
+
+void MagnumFontTest::metricsInvalid() {
+    auto&& data = MetricsInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    std::unordered_map<std::string, Containers::Array<char>> files;
+    files["font-v2.conf"] = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font-v2.conf"));
+    files["font.tga"] = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.tga"));
+    Containers::Array<char> metrics = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.metrics"));
+    CORRADE_COMPARE(metrics.size(), 368);
+    if(data.value) metrics[data.offset] = data.value;
+    files["font.metrics"] = Containers::Array<char>{Containers::ValueInit, data.size};
+    std::copy(metrics.begin(), metrics.begin() + data.size, files["font.metrics"].begin());
+
+    font->setFileCallback([](const std::string& filename, InputFileCallbackPolicy policy,
+        std::unordered_map<std::string, Containers::Array<char>>& files) {
+            /* The data should be released even if opening fails */
+            if(filename == "font.metrics" && policy == InputFileCallbackPolicy::Close)
+                Debug{} << "Closing" << filename;
+            return Containers::optional(Containers::ArrayView<const char>(files.at(filename)));
+        }, files);
+
+    std::ostringstream out, outClose;
+    {
+        Error redirectError{&out};
+        Debug redirectOutput{&outClose};
+        CORRADE_VERIFY(!font->openFile("font-v2.conf", 13.0f));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString("Text::MagnumFont::openData(): {}\n", data.message));
+    CORRADE_COMPARE(outClose.str(), "Closing font.metrics\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontTest)
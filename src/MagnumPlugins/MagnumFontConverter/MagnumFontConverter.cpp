@@ -37,6 +37,7 @@
 #include "Magnum/Math/ConfigurationValue.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/AbstractGlyphCache.h"
+#include "MagnumPlugins/MagnumFont/MagnumFontMetrics.h"
 #include "MagnumPlugins/TgaImageConverter/TgaImageConverter.h"
 
 namespace Magnum { namespace Text {
@@ -57,8 +58,9 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
 
     Utility::Configuration configuration;
 
-    configuration.setValue("version", 1);
+    configuration.setValue("version", 2);
     configuration.setValue("image", Utility::Directory::filename(filename) + ".tga");
+    configuration.setValue("metrics", Utility::Directory::filename(filename) + ".metrics");
     configuration.setValue("originalImageSize", cache.textureSize());
     configuration.setValue("padding", cache.padding());
     configuration.setValue("fontSize", font.size());
@@ -92,25 +94,28 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
         inverseGlyphIdMap[map.second] = map.first;
 
     /* Character->glyph map, map glyph IDs to new ones */
-    for(const char32_t c: characters) {
-        Utility::ConfigurationGroup* group = configuration.addGroup("char");
-        const UnsignedInt glyphId = font.glyphId(c);
-        group->setValue("unicode", c);
+    Containers::Array<Implementation::MagnumFontMetricsCharacter> charData{Containers::NoInit, characters.size()};
+    for(std::size_t i = 0; i != characters.size(); ++i) {
+        const UnsignedInt glyphId = font.glyphId(characters[i]);
 
         /* Map old glyph ID to new, if not found, map to glyph 0 */
         auto found = glyphIdMap.find(glyphId);
-        group->setValue("glyph", found == glyphIdMap.end() ? 0 : glyphIdMap.at(glyphId));
+        charData[i] = Implementation::MagnumFontMetricsCharacter{
+            UnsignedInt(characters[i]),
+            found == glyphIdMap.end() ? 0 : found->second};
     }
 
     /* Save glyph properties in order which preserves their IDs, remove padding
        from the values so they aren't added twice when using the font later */
     /** @todo Some better way to handle this padding stuff */
-    for(UnsignedInt oldGlyphId: inverseGlyphIdMap) {
+    Containers::Array<Implementation::MagnumFontMetricsGlyph> glyphData{Containers::NoInit, inverseGlyphIdMap.size()};
+    for(std::size_t i = 0; i != inverseGlyphIdMap.size(); ++i) {
+        const UnsignedInt oldGlyphId = inverseGlyphIdMap[i];
         std::pair<Vector2i, Range2Di> glyph = cache[oldGlyphId];
-        Utility::ConfigurationGroup* group = configuration.addGroup("glyph");
-        group->setValue("advance", font.glyphAdvance(oldGlyphId));
-        group->setValue("position", glyph.first+cache.padding());
-        group->setValue("rectangle", glyph.second.padded(-cache.padding()));
+        glyphData[i] = Implementation::MagnumFontMetricsGlyph{
+            font.glyphAdvance(oldGlyphId),
+            glyph.first+cache.padding(),
+            glyph.second.padded(-cache.padding())};
     }
 
     std::ostringstream confOut;
@@ -122,9 +127,14 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
     /* Save cache image */
     auto tgaData = Trade::TgaImageConverter().exportToData(cache.image());
 
+    /* Metrics are stored as little-endian */
+    Containers::Array<char> metrics = Implementation::magnumFontMetrics(glyphData, charData);
+    Implementation::magnumFontMetricsLittleEndianInPlace(metrics, false);
+
     std::vector<std::pair<std::string, Containers::Array<char>>> out;
     out.emplace_back(filename + ".conf", std::move(confData));
     out.emplace_back(filename + ".tga", std::move(tgaData));
+    out.emplace_back(filename + ".metrics", std::move(metrics));
     return out;
 }
 
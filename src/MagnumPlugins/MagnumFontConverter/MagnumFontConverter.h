@@ -54,8 +54,10 @@ namespace Magnum { namespace Text {
 /**
 @brief MagnumFont converter plugin
 
-Expects filename prefix, creates two files, `prefix.conf` and `prefix.tga`. See
-@ref MagnumFont for more information about the font. The plugin requires the
+Expects filename prefix, creates three files, `prefix.conf`, `prefix.metrics`
+and `prefix.tga`. See @ref MagnumFont for more information about the font. The
+plugin produces version 2 of the format, with glyph and character info in a
+separate binary file. The plugin requires the
 passed @ref AbstractGlyphCache to support @ref GlyphCacheFeature::ImageDownload.
 
 @section Text-MagnumFontConverter-usage Usage
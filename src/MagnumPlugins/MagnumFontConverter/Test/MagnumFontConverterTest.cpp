@@ -79,6 +79,7 @@ void MagnumFontConverterTest::exportFont() {
     /* Remove previously created files */
     Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.conf"));
     Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.tga"));
+    Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.metrics"));
 
     /* Fake font with fake cache */
     class FakeFont: public Text::AbstractFont {
@@ -137,7 +138,12 @@ void MagnumFontConverterTest::exportFont() {
 
     /* Verify font parameters */
     CORRADE_COMPARE_AS(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.conf"),
-                       Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"),
+                       Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font-v2.conf"),
+                       TestSuite::Compare::File);
+
+    /* Verify glyph metrics and character mapping */
+    CORRADE_COMPARE_AS(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.metrics"),
+                       Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.metrics"),
                        TestSuite::Compare::File);
 
     if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
@@ -0,0 +1,66 @@
+#ifndef Magnum_Trade_MeshCodecHeader_h
+#define Magnum_Trade_MeshCodecHeader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Types.h"
+
+/* Used by both MeshCodecImporter and MeshCodecSceneConverter, which is why it
+   isn't directly inside MeshCodecImporter.cpp. OTOH it doesn't need to be
+   exposed publicly, which is why it has no docblocks. */
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+#pragma pack(1)
+/* Mesh codec file header, all values are little-endian */
+struct MeshCodecHeader {
+    char            magic[4];       /* MCDC */
+    UnsignedInt     primitive;      /* MeshPrimitive */
+    UnsignedInt     indexType;      /* MeshIndexType, 0 for non-indexed meshes */
+    UnsignedInt     indexCount;     /* Index count */
+    UnsignedInt     vertexCount;    /* Vertex count */
+    UnsignedInt     vertexSize;     /* Size of a single interleaved vertex */
+    UnsignedInt     attributeCount; /* Count of attributes after the header */
+    UnsignedInt     indexDataSize;  /* Size of encoded indices after attributes */
+    UnsignedInt     vertexDataSize; /* Size of encoded vertices after indices */
+};
+
+/* Attribute description, attributeCount of these follow the header */
+struct MeshCodecAttribute {
+    UnsignedShort   name;           /* MeshAttribute */
+    UnsignedShort   arraySize;      /* Array size, 0 for non-array attributes */
+    UnsignedInt     format;         /* VertexFormat */
+    UnsignedInt     offset;         /* Offset inside the vertex */
+};
+#pragma pack()
+
+static_assert(sizeof(MeshCodecHeader) == 36, "MeshCodecHeader size is not 36 bytes");
+static_assert(sizeof(MeshCodecAttribute) == 12, "MeshCodecAttribute size is not 12 bytes");
+
+constexpr char MeshCodecMagic[4]{'M', 'C', 'D', 'C'};
+
+}}}
+
+#endif
@@ -0,0 +1,266 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshCodecImporter.h"
+
+#include <algorithm>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/Encode.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MeshCodecImporter/MeshCodecHeader.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+template<class T> bool narrowIndicesInto(const Containers::ArrayView<const UnsignedInt> in, const Containers::ArrayView<char> out, const UnsignedInt vertexCount) {
+    const Containers::ArrayView<T> outT = Containers::arrayCast<T>(out);
+    for(std::size_t i = 0; i != in.size(); ++i) {
+        if(in[i] >= vertexCount || in[i] > T(~T{})) {
+            Error{} << "Trade::MeshCodecImporter::mesh(): index" << in[i] << "out of bounds for" << vertexCount << "vertices";
+            return false;
+        }
+        outT[i] = T(in[i]);
+    }
+    return true;
+}
+
+template<class T> bool checkIndices(const Containers::ArrayView<const char> data, const UnsignedInt vertexCount) {
+    for(const T index: Containers::arrayCast<const T>(data)) {
+        if(index >= vertexCount) {
+            Error{} << "Trade::MeshCodecImporter::mesh(): index" << index << "out of bounds for" << vertexCount << "vertices";
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+MeshCodecImporter::MeshCodecImporter() = default;
+
+MeshCodecImporter::MeshCodecImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+MeshCodecImporter::~MeshCodecImporter() = default;
+
+ImporterFeatures MeshCodecImporter::doFeatures() const { return ImporterFeature::OpenData; }
+
+bool MeshCodecImporter::doIsOpened() const { return !!_in; }
+
+void MeshCodecImporter::doClose() { _in = nullptr; }
+
+void MeshCodecImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    /* Check just the signature and the total size here so openData() fails
+       for obviously broken files, the rest is checked during decoding in
+       doMesh() */
+    if(data.size() < sizeof(Implementation::MeshCodecHeader)) {
+        Error{} << "Trade::MeshCodecImporter::openData(): file too short, expected at least" << sizeof(Implementation::MeshCodecHeader) << "bytes but got" << data.size();
+        return;
+    }
+
+    const auto& header = *reinterpret_cast<const Implementation::MeshCodecHeader*>(data.data());
+    if(!std::equal(header.magic, header.magic + 4, Implementation::MeshCodecMagic)) {
+        Error{} << "Trade::MeshCodecImporter::openData(): invalid file signature";
+        return;
+    }
+
+    /* 64-bit math so a malformed header can't overflow on 32-bit systems */
+    const UnsignedLong expectedSize = sizeof(Implementation::MeshCodecHeader) +
+        UnsignedLong(Utility::Endianness::littleEndian(header.attributeCount))*sizeof(Implementation::MeshCodecAttribute) +
+        Utility::Endianness::littleEndian(header.indexDataSize) +
+        Utility::Endianness::littleEndian(header.vertexDataSize);
+    if(data.size() != expectedSize) {
+        Error{} << "Trade::MeshCodecImporter::openData(): file size mismatch, expected" << expectedSize << "bytes but got" << data.size();
+        return;
+    }
+
+    _in = Containers::Array<char>{Containers::NoInit, data.size()};
+    Utility::copy(data, _in);
+}
+
+UnsignedInt MeshCodecImporter::doMeshCount() const { return 1; }
+
+Containers::Optional<MeshData> MeshCodecImporter::doMesh(UnsignedInt, UnsignedInt) {
+    const auto& header = *reinterpret_cast<const Implementation::MeshCodecHeader*>(_in.data());
+    const UnsignedInt primitive = Utility::Endianness::littleEndian(header.primitive);
+    const UnsignedInt indexType = Utility::Endianness::littleEndian(header.indexType);
+    const UnsignedInt indexCount = Utility::Endianness::littleEndian(header.indexCount);
+    const UnsignedInt vertexCount = Utility::Endianness::littleEndian(header.vertexCount);
+    const UnsignedInt vertexSize = Utility::Endianness::littleEndian(header.vertexSize);
+    const UnsignedInt attributeCount = Utility::Endianness::littleEndian(header.attributeCount);
+    const UnsignedInt indexDataSize = Utility::Endianness::littleEndian(header.indexDataSize);
+    const UnsignedInt vertexDataSize = Utility::Endianness::littleEndian(header.vertexDataSize);
+
+    if(primitive - 1 >= UnsignedInt(MeshPrimitive::Edges)) {
+        Error{} << "Trade::MeshCodecImporter::mesh(): invalid primitive" << primitive;
+        return Containers::NullOpt;
+    }
+    if(indexType > UnsignedInt(MeshIndexType::UnsignedInt)) {
+        Error{} << "Trade::MeshCodecImporter::mesh(): invalid index type" << indexType;
+        return Containers::NullOpt;
+    }
+    if(!indexType && indexCount) {
+        Error{} << "Trade::MeshCodecImporter::mesh(): expected no indices for a non-indexed mesh but got" << indexCount;
+        return Containers::NullOpt;
+    }
+
+    if(vertexSize > 32767) {
+        Error{} << "Trade::MeshCodecImporter::mesh(): expected vertex size to fit into 16 bits but got" << vertexSize;
+        return Containers::NullOpt;
+    }
+
+    /* Attribute descriptions. Everything MeshAttributeData and MeshData would
+       assert on has to be checked here. */
+    const std::size_t attributeBegin = sizeof(Implementation::MeshCodecHeader);
+    const std::size_t indexBegin = attributeBegin + attributeCount*sizeof(Implementation::MeshCodecAttribute);
+    const std::size_t vertexBegin = indexBegin + indexDataSize;
+    const auto attributeDescriptions = Containers::arrayCast<const Implementation::MeshCodecAttribute>(_in.slice(attributeBegin, indexBegin));
+    Containers::Array<MeshAttributeData> attributes{attributeCount};
+    for(UnsignedInt i = 0; i != attributeCount; ++i) {
+        const auto name = MeshAttribute(Utility::Endianness::littleEndian(attributeDescriptions[i].name));
+        const auto format = VertexFormat(Utility::Endianness::littleEndian(attributeDescriptions[i].format));
+        const UnsignedShort arraySize = Utility::Endianness::littleEndian(attributeDescriptions[i].arraySize);
+        const UnsignedInt offset = Utility::Endianness::littleEndian(attributeDescriptions[i].offset);
+
+        if(!isMeshAttributeCustom(name) && UnsignedInt(name) - 1 >= UnsignedInt(MeshAttribute::ObjectId)) {
+            Error{} << "Trade::MeshCodecImporter::mesh(): invalid name" << UnsignedInt(name) << "of attribute" << i;
+            return Containers::NullOpt;
+        }
+        /* This also catches implementation-specific formats, as the converter
+           doesn't allow them */
+        if(UnsignedInt(format) - 1 >= UnsignedInt(VertexFormat::Matrix4x3sNormalizedAligned)) {
+            Error{} << "Trade::MeshCodecImporter::mesh(): invalid format" << UnsignedInt(format) << "of attribute" << i;
+            return Containers::NullOpt;
+        }
+        if(!Implementation::isVertexFormatCompatibleWithAttribute(name, format)) {
+            Error{} << "Trade::MeshCodecImporter::mesh():" << format << "is not a valid format for attribute" << i << "of" << name;
+            return Containers::NullOpt;
+        }
+        if(arraySize && !Implementation::isAttributeArrayAllowed(name)) {
+            Error{} << "Trade::MeshCodecImporter::mesh(): attribute" << i << "of" << name << "can't be an array";
+            return Containers::NullOpt;
+        }
+        const UnsignedLong end = UnsignedLong(offset) + vertexFormatSize(format)*Math::max(arraySize, UnsignedShort{1});
+        if(end > vertexSize) {
+            Error{} << "Trade::MeshCodecImporter::mesh(): attribute" << i << "spans" << end << "bytes but vertex size is" << vertexSize;
+            return Containers::NullOpt;
+        }
+
+        attributes[i] = MeshAttributeData{name, format, offset, vertexCount, std::ptrdiff_t(vertexSize), arraySize};
+    }
+
+    /* Check that the counts can fit into the encoded data before allocating
+       anything based on them. Each 256-vertex block needs at least one byte
+       for each byte of a vertex, each triangle at least one code byte. 64-bit
+       math so a malformed header can't overflow on 32-bit systems. */
+    const bool isTriangleCodec = indexType && MeshPrimitive(primitive) == MeshPrimitive::Triangles && indexCount % 3 == 0;
+    const UnsignedLong minVertexDataSize = 1 + (UnsignedLong(vertexCount) + 255)/256*vertexSize;
+    if(vertexDataSize < minVertexDataSize) {
+        Error{} << "Trade::MeshCodecImporter::mesh(): expected at least" << minVertexDataSize << "bytes for" << vertexCount << "vertices of" << vertexSize << "bytes but got" << vertexDataSize;
+        return Containers::NullOpt;
+    }
+    if(indexType) {
+        const UnsignedLong minIndexDataSize = isTriangleCodec ?
+            1 + UnsignedLong(indexCount)/3 :
+            1 + (UnsignedLong(indexCount) + 255)/256*meshIndexTypeSize(MeshIndexType(indexType));
+        if(indexDataSize < minIndexDataSize) {
+            Error{} << "Trade::MeshCodecImporter::mesh(): expected at least" << minIndexDataSize << "bytes for" << indexCount << "indices but got" << indexDataSize;
+            return Containers::NullOpt;
+        }
+    }
+
+    /* On 32-bit systems the decoded data may still not be addressable. The
+       triangle codec decodes to 32-bit indices first. */
+    const UnsignedLong decodedVertexDataSize = UnsignedLong(vertexCount)*vertexSize;
+    const UnsignedLong decodedIndexDataSize = UnsignedLong(indexCount)*(isTriangleCodec ? 4 : indexType ? meshIndexTypeSize(MeshIndexType(indexType)) : 0);
+    if(decodedVertexDataSize > ~std::size_t{} || decodedIndexDataSize > ~std::size_t{}) {
+        Error{} << "Trade::MeshCodecImporter::mesh():" << decodedVertexDataSize << "bytes of vertex data and" << decodedIndexDataSize << "bytes of index data can't be addressed on this platform";
+        return Containers::NullOpt;
+    }
+
+    /* Vertex data. The decoder prints a message on its own if anything goes
+       wrong. */
+    Containers::Array<char> vertexData{Containers::NoInit, std::size_t(vertexCount)*vertexSize};
+    if(!MeshTools::decodeVerticesInto(_in.suffix(vertexBegin),
+        Containers::StridedArrayView2D<char>{vertexData, vertexData.data(),
+            {vertexCount, vertexSize}, {std::ptrdiff_t(vertexSize), 1}}))
+        return Containers::NullOpt;
+
+    /* Index data. Triangles are encoded with the dedicated codec, everything
+       else as a generic byte stream, same as the vertex data. */
+    Containers::Array<char> indexData;
+    MeshIndexData indices;
+    if(indexType) {
+        const UnsignedInt indexTypeSize = meshIndexTypeSize(MeshIndexType(indexType));
+        const Containers::ArrayView<const char> encodedIndices = _in.slice(indexBegin, vertexBegin);
+        indexData = Containers::Array<char>{Containers::NoInit, std::size_t(indexCount)*indexTypeSize};
+
+        if(isTriangleCodec) {
+            Containers::Array<UnsignedInt> decoded{Containers::NoInit, indexCount};
+            if(!MeshTools::decodeTriangleIndicesInto(encodedIndices, Containers::stridedArrayView(decoded)))
+                return Containers::NullOpt;
+
+            bool valid;
+            if(MeshIndexType(indexType) == MeshIndexType::UnsignedInt)
+                valid = narrowIndicesInto<UnsignedInt>(decoded, indexData, vertexCount);
+            else if(MeshIndexType(indexType) == MeshIndexType::UnsignedShort)
+                valid = narrowIndicesInto<UnsignedShort>(decoded, indexData, vertexCount);
+            else valid = narrowIndicesInto<UnsignedByte>(decoded, indexData, vertexCount);
+            if(!valid) return Containers::NullOpt;
+
+        } else {
+            if(!MeshTools::decodeVerticesInto(encodedIndices,
+                Containers::StridedArrayView2D<char>{indexData, indexData.data(),
+                    {indexCount, indexTypeSize}, {std::ptrdiff_t(indexTypeSize), 1}}))
+                return Containers::NullOpt;
+
+            bool valid;
+            if(MeshIndexType(indexType) == MeshIndexType::UnsignedInt)
+                valid = checkIndices<UnsignedInt>(indexData, vertexCount);
+            else if(MeshIndexType(indexType) == MeshIndexType::UnsignedShort)
+                valid = checkIndices<UnsignedShort>(indexData, vertexCount);
+            else valid = checkIndices<UnsignedByte>(indexData, vertexCount);
+            if(!valid) return Containers::NullOpt;
+        }
+
+        indices = MeshIndexData{MeshIndexType(indexType), indexData};
+    }
+
+    return MeshData{MeshPrimitive(primitive),
+        std::move(indexData), indices,
+        std::move(vertexData), std::move(attributes), vertexCount};
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MeshCodecImporter, Magnum::Trade::MeshCodecImporter,
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.4")
@@ -0,0 +1,129 @@
+#ifndef Magnum_Trade_MeshCodecImporter_h
+#define Magnum_Trade_MeshCodecImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MeshCodecImporter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/MeshCodecImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MESHCODECIMPORTER_BUILD_STATIC
+    #ifdef MeshCodecImporter_EXPORTS
+        #define MAGNUM_MESHCODECIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MESHCODECIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MESHCODECIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MESHCODECIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MESHCODECIMPORTER_EXPORT
+#define MAGNUM_MESHCODECIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Mesh codec importer plugin
+@m_since_latest
+
+Imports meshes produced by @ref MeshCodecSceneConverter, decoding the index
+and vertex data with @ref MeshTools::decodeTriangleIndicesInto() and
+@ref MeshTools::decodeVerticesInto().
+
+@section Trade-MeshCodecImporter-usage Usage
+
+This plugin depends on the @ref Trade and @ref MeshTools libraries and is built
+if `WITH_MESHCODECIMPORTER` is enabled when building Magnum. To use as a
+dynamic plugin, load @cpp "MeshCodecImporter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(WITH_MESHCODECIMPORTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MeshCodecImporter)
+@endcode
+
+To use as a static plugin or use this as a dependency of another plugin with
+CMake, you need to request the `MeshCodecImporter` component of the `Magnum`
+package and link to the `Magnum::MeshCodecImporter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MeshCodecImporter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MeshCodecImporter)
+@endcode
+
+See @ref building, @ref cmake and @ref plugins for more information.
+
+@section Trade-MeshCodecImporter-behavior Behavior and limitations
+
+The file contains exactly one mesh. The mesh is imported with the same
+primitive, index type and attributes as was passed to the converter, with the
+attributes interleaved. Triangle meshes may have vertices of each triangle
+rotated, as described in @ref MeshTools::encodeTriangleIndices(). All header
+fields, attribute descriptions and decoded indices are checked, so the plugin
+is safe to use on untrusted input.
+*/
+class MAGNUM_MESHCODECIMPORTER_EXPORT MeshCodecImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit MeshCodecImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit MeshCodecImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MeshCodecImporter();
+
+    private:
+        MAGNUM_MESHCODECIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
+        MAGNUM_MESHCODECIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_MESHCODECIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_MESHCODECIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_MESHCODECIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
+        MAGNUM_MESHCODECIMPORTER_LOCAL Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override;
+
+        Containers::Array<char> _in;
+};
+
+}}
+
+#endif
@@ -0,0 +1,475 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Encode.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MeshCodecImporter/MeshCodecHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MeshCodecImporterTest: TestSuite::Tester {
+    explicit MeshCodecImporterTest();
+
+    void tooShort();
+    void invalidSignature();
+    void sizeMismatch();
+
+    void invalid();
+    void vertexSizeTooLarge();
+    void vertexDataTooShort();
+    void indexDataTooShort();
+    void indexDataTooShortNonTriangle();
+    void indexOutOfBounds();
+    void indexOutOfBoundsNonTriangle();
+    void indexTypeOverflow();
+    void invalidIndexData();
+    void invalidVertexData();
+
+    void triangles();
+    void lines();
+    void nonIndexed();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+const Vector3 Positions[]{
+    {-1.0f, 0.0f, 0.0f},
+    { 1.0f, 0.0f, 0.0f},
+    { 0.0f, 1.0f, 0.0f}
+};
+
+struct Header {
+    MeshPrimitive primitive;
+    UnsignedInt indexType, indexCount, vertexCount, vertexSize;
+};
+
+struct Attribute {
+    UnsignedShort name, arraySize;
+    UnsignedInt format, offset;
+};
+
+Containers::Array<char> file(const Header& header, std::initializer_list<Attribute> attributes, Containers::ArrayView<const char> indices, Containers::ArrayView<const char> vertices) {
+    Containers::Array<char> out{Containers::ValueInit,
+        sizeof(Implementation::MeshCodecHeader) +
+        attributes.size()*sizeof(Implementation::MeshCodecAttribute) +
+        indices.size() + vertices.size()};
+
+    auto& outHeader = *reinterpret_cast<Implementation::MeshCodecHeader*>(out.data());
+    std::copy(Implementation::MeshCodecMagic, Implementation::MeshCodecMagic + 4, outHeader.magic);
+    outHeader.primitive = Utility::Endianness::littleEndian(UnsignedInt(header.primitive));
+    outHeader.indexType = Utility::Endianness::littleEndian(header.indexType);
+    outHeader.indexCount = Utility::Endianness::littleEndian(header.indexCount);
+    outHeader.vertexCount = Utility::Endianness::littleEndian(header.vertexCount);
+    outHeader.vertexSize = Utility::Endianness::littleEndian(header.vertexSize);
+    outHeader.attributeCount = Utility::Endianness::littleEndian(UnsignedInt(attributes.size()));
+    outHeader.indexDataSize = Utility::Endianness::littleEndian(UnsignedInt(indices.size()));
+    outHeader.vertexDataSize = Utility::Endianness::littleEndian(UnsignedInt(vertices.size()));
+
+    auto* outAttribute = reinterpret_cast<Implementation::MeshCodecAttribute*>(out.data() + sizeof(Implementation::MeshCodecHeader));
+    for(const Attribute& attribute: attributes) {
+        outAttribute->name = Utility::Endianness::littleEndian(attribute.name);
+        outAttribute->arraySize = Utility::Endianness::littleEndian(attribute.arraySize);
+        outAttribute->format = Utility::Endianness::littleEndian(attribute.format);
+        outAttribute->offset = Utility::Endianness::littleEndian(attribute.offset);
+        ++outAttribute;
+    }
+
+    char* data = reinterpret_cast<char*>(outAttribute);
+    Utility::copy(indices, Containers::arrayView(data, indices.size()));
+    Utility::copy(vertices, Containers::arrayView(data + indices.size(), vertices.size()));
+    return out;
+}
+
+const struct {
+    const char* name;
+    MeshPrimitive primitive;
+    UnsignedInt indexType, indexCount;
+    Attribute attribute;
+    const char* message;
+} InvalidData[]{
+    {"invalid primitive",
+        MeshPrimitive(0xdead), 0, 0,
+        {UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0},
+        "invalid primitive 57005"},
+    {"implementation-specific primitive",
+        meshPrimitiveWrap(0x3), 0, 0,
+        {UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0},
+        "invalid primitive 2147483651"},
+    {"invalid index type",
+        MeshPrimitive::Triangles, 4, 3,
+        {UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0},
+        "invalid index type 4"},
+    {"indices for a non-indexed mesh",
+        MeshPrimitive::Triangles, 0, 3,
+        {UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0},
+        "expected no indices for a non-indexed mesh but got 3"},
+    {"invalid attribute name",
+        MeshPrimitive::Triangles, 0, 0,
+        {0, 0, UnsignedInt(VertexFormat::Vector3), 0},
+        "invalid name 0 of attribute 0"},
+    {"unknown builtin attribute name",
+        MeshPrimitive::Triangles, 0, 0,
+        {UnsignedShort(UnsignedShort(MeshAttribute::ObjectId) + 1), 0, UnsignedInt(VertexFormat::Vector3), 0},
+        "invalid name 8 of attribute 0"},
+    {"invalid attribute format",
+        MeshPrimitive::Triangles, 0, 0,
+        {UnsignedShort(MeshAttribute::Position), 0, 0, 0},
+        "invalid format 0 of attribute 0"},
+    {"implementation-specific attribute format",
+        MeshPrimitive::Triangles, 0, 0,
+        {UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(vertexFormatWrap(0x1)), 0},
+        "invalid format 2147483649 of attribute 0"},
+    {"incompatible attribute format",
+        MeshPrimitive::Triangles, 0, 0,
+        {UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::UnsignedInt), 0},
+        "VertexFormat::UnsignedInt is not a valid format for attribute 0 of Trade::MeshAttribute::Position"},
+    {"builtin array attribute",
+        MeshPrimitive::Triangles, 0, 0,
+        {UnsignedShort(MeshAttribute::Position), 2, UnsignedInt(VertexFormat::Vector3), 0},
+        "attribute 0 of Trade::MeshAttribute::Position can't be an array"},
+    {"attribute out of bounds",
+        MeshPrimitive::Triangles, 0, 0,
+        {UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 4},
+        "attribute 0 spans 16 bytes but vertex size is 12"},
+    {"array attribute out of bounds",
+        MeshPrimitive::Triangles, 0, 0,
+        {UnsignedShort(meshAttributeCustom(3)), 4, UnsignedInt(VertexFormat::Float), 0},
+        "attribute 0 spans 16 bytes but vertex size is 12"}
+};
+
+MeshCodecImporterTest::MeshCodecImporterTest() {
+    addTests({&MeshCodecImporterTest::tooShort,
+              &MeshCodecImporterTest::invalidSignature,
+              &MeshCodecImporterTest::sizeMismatch});
+
+    addInstancedTests({&MeshCodecImporterTest::invalid},
+        Containers::arraySize(InvalidData));
+
+    addTests({&MeshCodecImporterTest::vertexSizeTooLarge,
+              &MeshCodecImporterTest::vertexDataTooShort,
+              &MeshCodecImporterTest::indexDataTooShort,
+              &MeshCodecImporterTest::indexDataTooShortNonTriangle,
+
+              &MeshCodecImporterTest::indexOutOfBounds,
+              &MeshCodecImporterTest::indexOutOfBoundsNonTriangle,
+              &MeshCodecImporterTest::indexTypeOverflow,
+              &MeshCodecImporterTest::invalidIndexData,
+              &MeshCodecImporterTest::invalidVertexData,
+
+              &MeshCodecImporterTest::triangles,
+              &MeshCodecImporterTest::lines,
+              &MeshCodecImporterTest::nonIndexed});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MESHCODECIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(MESHCODECIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MeshCodecImporterTest::tooShort() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    const char data[]{'M', 'C', 'D', 'C', 0, 0, 0};
+    CORRADE_VERIFY(!importer->openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecImporter::openData(): file too short, expected at least 36 bytes but got 7\n");
+}
+
+void MeshCodecImporterTest::invalidSignature() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    Containers::Array<char> data = file({MeshPrimitive::Points, 0, 0, 0, 0}, {}, {}, {});
+    data[3] = 'X';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecImporter::openData(): invalid file signature\n");
+}
+
+void MeshCodecImporterTest::sizeMismatch() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    const char vertices[]{'\xa0', 0, 0};
+    Containers::Array<char> data = file({MeshPrimitive::Points, 0, 0, 0, 0}, {}, {}, vertices);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data.prefix(data.size() - 1)));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecImporter::openData(): file size mismatch, expected 39 bytes but got 38\n");
+}
+
+void MeshCodecImporterTest::invalid() {
+    auto&& data = InvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    /* The validation happens before decoding, so the actual data don't
+       matter */
+    CORRADE_VERIFY(importer->openData(file({data.primitive, data.indexType, data.indexCount, 3, 12}, {data.attribute}, {}, {})));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MeshCodecImporter::mesh(): {}\n", data.message));
+}
+
+void MeshCodecImporterTest::vertexSizeTooLarge() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    /* Just the 36-byte header, which would need 16 EB of vertex data */
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Points, 0, 0, 0xffffffffu, 0xffffffffu}, {}, {}, {})));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecImporter::mesh(): expected vertex size to fit into 16 bits but got 4294967295\n");
+}
+
+void MeshCodecImporterTest::vertexDataTooShort() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    /* The check happens before anything gets allocated, so the allocation of
+       48 GB of vertex data isn't even attempted */
+    const char encodedVertices[]{'\xa0', 0, 0};
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Points, 0, 0, 0xffffffffu, 12},
+        {{UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0}},
+        {}, encodedVertices)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecImporter::mesh(): expected at least 201326593 bytes for 4294967295 vertices of 12 bytes but got 3\n");
+}
+
+void MeshCodecImporterTest::indexDataTooShort() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    const char encodedIndices[]{'\xe0', 0};
+    Containers::Array<char> encodedVertices = MeshTools::encodeVertices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(Positions)));
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Triangles, UnsignedInt(MeshIndexType::UnsignedInt), 3000000000u, 3, 12},
+        {{UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0}},
+        encodedIndices, encodedVertices)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecImporter::mesh(): expected at least 1000000001 bytes for 3000000000 indices but got 2\n");
+}
+
+void MeshCodecImporterTest::indexDataTooShortNonTriangle() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    const char encodedIndices[]{'\xa0', 0};
+    Containers::Array<char> encodedVertices = MeshTools::encodeVertices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(Positions)));
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Lines, UnsignedInt(MeshIndexType::UnsignedShort), 1000, 3, 12},
+        {{UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0}},
+        encodedIndices, encodedVertices)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecImporter::mesh(): expected at least 9 bytes for 1000 indices but got 2\n");
+}
+
+void MeshCodecImporterTest::indexOutOfBounds() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 3};
+    Containers::Array<char> encodedIndices = MeshTools::encodeTriangleIndices(Containers::stridedArrayView(indices));
+    Containers::Array<char> encodedVertices = MeshTools::encodeVertices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(Positions)));
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Triangles, UnsignedInt(MeshIndexType::UnsignedInt), 6, 3, 12},
+        {{UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0}},
+        encodedIndices, encodedVertices)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecImporter::mesh(): index 3 out of bounds for 3 vertices\n");
+}
+
+void MeshCodecImporterTest::indexOutOfBoundsNonTriangle() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    const UnsignedShort indices[]{0, 1, 1, 5};
+    Containers::Array<char> encodedIndices = MeshTools::encodeVertices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)));
+    Containers::Array<char> encodedVertices = MeshTools::encodeVertices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(Positions)));
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Lines, UnsignedInt(MeshIndexType::UnsignedShort), 4, 3, 12},
+        {{UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0}},
+        encodedIndices, encodedVertices)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecImporter::mesh(): index 5 out of bounds for 3 vertices\n");
+}
+
+void MeshCodecImporterTest::indexTypeOverflow() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    /* The index is in bounds of the vertex count, but doesn't fit into the
+       index type */
+    const UnsignedInt indices[]{0, 1, 256};
+    Containers::Array<char> encodedIndices = MeshTools::encodeTriangleIndices(Containers::stridedArrayView(indices));
+    Containers::Array<char> vertices{Containers::ValueInit, 300};
+    Containers::Array<char> encodedVertices = MeshTools::encodeVertices(Containers::StridedArrayView2D<const char>{vertices, {300, 1}});
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Triangles, UnsignedInt(MeshIndexType::UnsignedByte), 3, 300, 1},
+        {{UnsignedShort(MeshAttribute::ObjectId), 0, UnsignedInt(VertexFormat::UnsignedByte), 0}},
+        encodedIndices, encodedVertices)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecImporter::mesh(): index 256 out of bounds for 300 vertices\n");
+}
+
+void MeshCodecImporterTest::invalidIndexData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    const char encodedIndices[]{'\xe1', 0};
+    Containers::Array<char> encodedVertices = MeshTools::encodeVertices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(Positions)));
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Triangles, UnsignedInt(MeshIndexType::UnsignedInt), 3, 3, 12},
+        {{UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0}},
+        encodedIndices, encodedVertices)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeTriangleIndicesInto(): invalid header\n");
+}
+
+void MeshCodecImporterTest::invalidVertexData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    /* Large enough to pass the size check, but the first group of the first
+       byte says it has 16 bytes of data that aren't there */
+    const char encodedVertices[]{'\xa0', 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Points, 0, 0, 3, 12},
+        {{UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0}},
+        {}, encodedVertices)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeVerticesInto(): unexpected end of data\n");
+}
+
+void MeshCodecImporterTest::triangles() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 0};
+    Containers::Array<char> encodedIndices = MeshTools::encodeTriangleIndices(Containers::stridedArrayView(indices));
+    Containers::Array<char> encodedVertices = MeshTools::encodeVertices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(Positions)));
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Triangles, UnsignedInt(MeshIndexType::UnsignedShort), 6, 3, 12},
+        {{UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0},
+         {UnsignedShort(meshAttributeCustom(7)), 2, UnsignedInt(VertexFormat::UnsignedShort), 8}},
+        encodedIndices, encodedVertices)));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+    /* The triangles may get rotated, compare the decoded output instead of
+       the original indices */
+    Containers::Array<UnsignedInt> decoded{6};
+    CORRADE_VERIFY(MeshTools::decodeTriangleIndicesInto(encodedIndices, Containers::stridedArrayView(decoded)));
+    CORRADE_COMPARE_AS(mesh->indicesAsArray(), decoded,
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+    CORRADE_COMPARE(mesh->attributeName(0), MeshAttribute::Position);
+    CORRADE_COMPARE(mesh->attributeFormat(0), VertexFormat::Vector3);
+    CORRADE_COMPARE(mesh->attributeStride(0), 12);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(0),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->attributeName(1), meshAttributeCustom(7));
+    CORRADE_COMPARE(mesh->attributeFormat(1), VertexFormat::UnsignedShort);
+    CORRADE_COMPARE(mesh->attributeArraySize(1), 2);
+    CORRADE_COMPARE(mesh->attributeOffset(1), 8);
+}
+
+void MeshCodecImporterTest::lines() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    const UnsignedByte indices[]{0, 1, 1, 2, 2, 0};
+    Containers::Array<char> encodedIndices = MeshTools::encodeVertices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)));
+    Containers::Array<char> encodedVertices = MeshTools::encodeVertices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(Positions)));
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Lines, UnsignedInt(MeshIndexType::UnsignedByte), 6, 3, 12},
+        {{UnsignedShort(MeshAttribute::Position), 0, UnsignedInt(VertexFormat::Vector3), 0}},
+        encodedIndices, encodedVertices)));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedByte>(),
+        Containers::arrayView(indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+}
+
+void MeshCodecImporterTest::nonIndexed() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MeshCodecImporter");
+
+    const char vertices[1]{};
+    Containers::Array<char> encodedVertices = MeshTools::encodeVertices(Containers::StridedArrayView2D<const char>{vertices, {5, 0}});
+    CORRADE_VERIFY(importer->openData(file({MeshPrimitive::Points, 0, 0, 5, 0}, {}, {}, encodedVertices)));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE(mesh->vertexCount(), 5);
+    CORRADE_COMPARE(mesh->attributeCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshCodecImporterTest)
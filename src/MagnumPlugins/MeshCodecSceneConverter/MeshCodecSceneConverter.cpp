@@ -0,0 +1,124 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshCodecSceneConverter.h"
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/MeshTools/Encode.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MeshCodecImporter/MeshCodecHeader.h"
+
+namespace Magnum { namespace Trade {
+
+MeshCodecSceneConverter::MeshCodecSceneConverter() = default;
+
+MeshCodecSceneConverter::MeshCodecSceneConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractSceneConverter{manager, plugin} {}
+
+MeshCodecSceneConverter::~MeshCodecSceneConverter() = default;
+
+SceneConverterFeatures MeshCodecSceneConverter::doFeatures() const {
+    return SceneConverterFeature::ConvertMeshToData;
+}
+
+Containers::Array<char> MeshCodecSceneConverter::doConvertToData(const MeshData& mesh) {
+    if(isMeshPrimitiveImplementationSpecific(mesh.primitive())) {
+        Error{} << "Trade::MeshCodecSceneConverter::convertToData(): implementation-specific primitive" << reinterpret_cast<void*>(meshPrimitiveUnwrap(mesh.primitive())) << "is not supported";
+        return {};
+    }
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const VertexFormat format = mesh.attributeFormat(i);
+        if(isVertexFormatImplementationSpecific(format)) {
+            Error{} << "Trade::MeshCodecSceneConverter::convertToData(): implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(format)) << "of attribute" << i << "is not supported";
+            return {};
+        }
+    }
+
+    /* Interleave the mesh if it isn't already so the vertex data can be
+       encoded as a single stream */
+    Containers::Optional<MeshData> interleaved;
+    if(!MeshTools::isInterleaved(mesh))
+        interleaved = MeshTools::interleave(mesh);
+    const MeshData& source = interleaved ? *interleaved : mesh;
+    const Containers::StridedArrayView2D<const char> vertices = MeshTools::interleavedData(source);
+    const std::size_t vertexOffset = static_cast<const char*>(vertices.data()) - source.vertexData().data();
+    const Containers::Array<char> encodedVertices = MeshTools::encodeVertices(vertices);
+
+    /* Triangles use the dedicated index codec, indices of everything else are
+       encoded the same way as vertex data. The importer makes the same
+       decision based on the primitive and index count. */
+    Containers::Array<char> encodedIndices;
+    if(source.isIndexed()) {
+        if(source.primitive() == MeshPrimitive::Triangles && source.indexCount() % 3 == 0) {
+            const Containers::Array<UnsignedInt> indices = source.indicesAsArray();
+            encodedIndices = MeshTools::encodeTriangleIndices(Containers::stridedArrayView(indices));
+        } else encodedIndices = MeshTools::encodeVertices(source.indices());
+    }
+
+    Containers::Array<char> out{Containers::ValueInit,
+        sizeof(Implementation::MeshCodecHeader) +
+        source.attributeCount()*sizeof(Implementation::MeshCodecAttribute) +
+        encodedIndices.size() + encodedVertices.size()};
+
+    auto& header = *reinterpret_cast<Implementation::MeshCodecHeader*>(out.data());
+    std::copy(Implementation::MeshCodecMagic, Implementation::MeshCodecMagic + 4, header.magic);
+    header.primitive = Utility::Endianness::littleEndian(UnsignedInt(source.primitive()));
+    header.indexType = Utility::Endianness::littleEndian(source.isIndexed() ? UnsignedInt(source.indexType()) : 0u);
+    header.indexCount = Utility::Endianness::littleEndian(source.isIndexed() ? source.indexCount() : 0u);
+    header.vertexCount = Utility::Endianness::littleEndian(source.vertexCount());
+    header.vertexSize = Utility::Endianness::littleEndian(UnsignedInt(vertices.size()[1]));
+    header.attributeCount = Utility::Endianness::littleEndian(source.attributeCount());
+    header.indexDataSize = Utility::Endianness::littleEndian(UnsignedInt(encodedIndices.size()));
+    header.vertexDataSize = Utility::Endianness::littleEndian(UnsignedInt(encodedVertices.size()));
+
+    const auto attributes = Containers::arrayCast<Implementation::MeshCodecAttribute>(out.slice(sizeof(Implementation::MeshCodecHeader), sizeof(Implementation::MeshCodecHeader) + source.attributeCount()*sizeof(Implementation::MeshCodecAttribute)));
+    for(UnsignedInt i = 0; i != source.attributeCount(); ++i) {
+        attributes[i].name = Utility::Endianness::littleEndian(UnsignedShort(source.attributeName(i)));
+        attributes[i].arraySize = Utility::Endianness::littleEndian(source.attributeArraySize(i));
+        attributes[i].format = Utility::Endianness::littleEndian(UnsignedInt(source.attributeFormat(i)));
+        attributes[i].offset = Utility::Endianness::littleEndian(UnsignedInt(source.attributeOffset(i) - vertexOffset));
+    }
+
+    const std::size_t indexBegin = sizeof(Implementation::MeshCodecHeader) + attributes.size()*sizeof(Implementation::MeshCodecAttribute);
+    Utility::copy(encodedIndices, out.slice(indexBegin, indexBegin + encodedIndices.size()));
+    Utility::copy(encodedVertices, out.suffix(indexBegin + encodedIndices.size()));
+
+    if(flags() & SceneConverterFlag::Verbose)
+        Debug{} << "Trade::MeshCodecSceneConverter::convertToData(): encoded" << (source.isIndexed() ? source.indexCount()*meshIndexTypeSize(source.indexType()) : 0) << "bytes of indices to" << encodedIndices.size() << "and" << vertices.size()[0]*vertices.size()[1] << "bytes of vertices to" << encodedVertices.size();
+
+    return out;
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MeshCodecSceneConverter, Magnum::Trade::MeshCodecSceneConverter,
+    "cz.mosra.magnum.Trade.AbstractSceneConverter/0.1")
@@ -0,0 +1,129 @@
+#ifndef Magnum_Trade_MeshCodecSceneConverter_h
+#define Magnum_Trade_MeshCodecSceneConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MeshCodecSceneConverter
+ * @m_since_latest
+ */
+
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "MagnumPlugins/MeshCodecSceneConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MESHCODECSCENECONVERTER_BUILD_STATIC
+    #ifdef MeshCodecSceneConverter_EXPORTS
+        #define MAGNUM_MESHCODECSCENECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MESHCODECSCENECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MESHCODECSCENECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MESHCODECSCENECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MESHCODECSCENECONVERTER_EXPORT
+#define MAGNUM_MESHCODECSCENECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Mesh codec scene converter plugin
+@m_since_latest
+
+Encodes a mesh with @ref MeshTools::encodeTriangleIndices() and
+@ref MeshTools::encodeVertices() into a compact binary representation that
+can be imported back with @ref MeshCodecImporter. The output is considerably
+smaller than the original data and, as the codecs remove most redundancy
+from the index and vertex streams, compresses further with general-purpose
+compressors.
+
+@section Trade-MeshCodecSceneConverter-usage Usage
+
+This plugin depends on the @ref Trade and @ref MeshTools libraries and is built
+if `WITH_MESHCODECSCENECONVERTER` is enabled when building Magnum. To use as a
+dynamic plugin, load @cpp "MeshCodecSceneConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(WITH_MESHCODECSCENECONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MeshCodecSceneConverter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `MeshCodecSceneConverter` component of the `Magnum`
+package and link to the `Magnum::MeshCodecSceneConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MeshCodecSceneConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MeshCodecSceneConverter)
+@endcode
+
+See @ref building, @ref cmake and @ref plugins for more information.
+
+@section Trade-MeshCodecSceneConverter-behavior Behavior and limitations
+
+Non-interleaved meshes are interleaved first using @ref MeshTools::interleave(),
+padding at the end of each vertex is not preserved. Indexed triangle meshes
+are encoded with @ref MeshTools::encodeTriangleIndices(), which may rotate
+vertices of each triangle, indices of other primitives are encoded with
+@ref MeshTools::encodeVertices(). For best results, optimize the mesh for
+vertex cache with @ref MeshTools::tipsifyInPlace() and reorder the vertices
+by their first reference before conversion.
+
+Implementation-specific primitives and vertex formats are not supported. The
+file header is stored in little-endian, vertex and index data are stored in
+the machine byte order.
+
+The plugin supports @ref SceneConverterFlag::Verbose, printing the resulting
+index and vertex data sizes.
+*/
+class MAGNUM_MESHCODECSCENECONVERTER_EXPORT MeshCodecSceneConverter: public AbstractSceneConverter {
+    public:
+        /** @brief Default constructor */
+        explicit MeshCodecSceneConverter();
+
+        /** @brief Plugin manager constructor */
+        explicit MeshCodecSceneConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MeshCodecSceneConverter();
+
+    private:
+        MAGNUM_MESHCODECSCENECONVERTER_LOCAL SceneConverterFeatures doFeatures() const override;
+        MAGNUM_MESHCODECSCENECONVERTER_LOCAL Containers::Array<char> doConvertToData(const MeshData& mesh) override;
+};
+
+}}
+
+#endif
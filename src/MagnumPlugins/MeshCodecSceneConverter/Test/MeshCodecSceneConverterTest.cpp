@@ -0,0 +1,351 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Encode.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MeshCodecImporter/MeshCodecHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MeshCodecSceneConverterTest: TestSuite::Tester {
+    explicit MeshCodecSceneConverterTest();
+
+    void implementationSpecificPrimitive();
+    void implementationSpecificVertexFormat();
+
+    void header();
+    void verbose();
+
+    void triangles();
+    void nonInterleaved();
+    void lines();
+    void nonIndexed();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractSceneConverter> _converterManager{"nonexistent"};
+    PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
+};
+
+struct Vertex {
+    Vector3 position;
+    Vector2 textureCoordinates;
+};
+
+/* A 3x3 grid of vertices with two triangles in each cell */
+const Vertex Vertices[]{
+    {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
+    {{1.0f, 0.0f, 0.0f}, {0.5f, 0.0f}},
+    {{2.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
+    {{0.0f, 1.0f, 0.0f}, {0.0f, 0.5f}},
+    {{1.0f, 1.0f, 0.5f}, {0.5f, 0.5f}},
+    {{2.0f, 1.0f, 0.0f}, {1.0f, 0.5f}},
+    {{0.0f, 2.0f, 0.0f}, {0.0f, 1.0f}},
+    {{1.0f, 2.0f, 0.0f}, {0.5f, 1.0f}},
+    {{2.0f, 2.0f, 0.0f}, {1.0f, 1.0f}}
+};
+
+const Containers::StridedArrayView1D<const Vector3> Positions{Vertices,
+    &Vertices[0].position, Containers::arraySize(Vertices), sizeof(Vertex)};
+const Containers::StridedArrayView1D<const Vector2> TextureCoordinates{Vertices,
+    &Vertices[0].textureCoordinates, Containers::arraySize(Vertices), sizeof(Vertex)};
+
+const UnsignedShort TriangleIndices[]{
+    0, 1, 4, 0, 4, 3,
+    1, 2, 5, 1, 5, 4,
+    3, 4, 7, 3, 7, 6,
+    4, 5, 8, 4, 8, 7
+};
+
+MeshCodecSceneConverterTest::MeshCodecSceneConverterTest() {
+    addTests({&MeshCodecSceneConverterTest::implementationSpecificPrimitive,
+              &MeshCodecSceneConverterTest::implementationSpecificVertexFormat,
+
+              &MeshCodecSceneConverterTest::header,
+              &MeshCodecSceneConverterTest::verbose,
+
+              &MeshCodecSceneConverterTest::triangles,
+              &MeshCodecSceneConverterTest::nonInterleaved,
+              &MeshCodecSceneConverterTest::lines,
+              &MeshCodecSceneConverterTest::nonIndexed});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MESHCODECSCENECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_converterManager.load(MESHCODECSCENECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* Optional plugins that don't have to be here */
+    #ifdef MESHCODECIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(MESHCODECIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MeshCodecSceneConverterTest::implementationSpecificPrimitive() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MeshCodecSceneConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convertToData(MeshData{meshPrimitiveWrap(0xdead), 3}));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecSceneConverter::convertToData(): implementation-specific primitive 0xdead is not supported\n");
+}
+
+void MeshCodecSceneConverterTest::implementationSpecificVertexFormat() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MeshCodecSceneConverter");
+
+    MeshData mesh{MeshPrimitive::Triangles, {}, Vertices, {
+        MeshAttributeData{MeshAttribute::Position, Positions},
+        MeshAttributeData{MeshAttribute::TextureCoordinates, vertexFormatWrap(0xcaca), TextureCoordinates}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convertToData(mesh));
+    CORRADE_COMPARE(out.str(), "Trade::MeshCodecSceneConverter::convertToData(): implementation-specific format 0xcaca of attribute 1 is not supported\n");
+}
+
+void MeshCodecSceneConverterTest::header() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MeshCodecSceneConverter");
+
+    MeshData mesh{MeshPrimitive::Triangles,
+        {}, TriangleIndices, MeshIndexData{TriangleIndices},
+        {}, Vertices, {
+            MeshAttributeData{MeshAttribute::Position, Positions},
+            MeshAttributeData{MeshAttribute::TextureCoordinates, TextureCoordinates}
+        }};
+
+    Containers::Array<char> data = converter->convertToData(mesh);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE_AS(data.size(), sizeof(Implementation::MeshCodecHeader) + 2*sizeof(Implementation::MeshCodecAttribute),
+        TestSuite::Compare::Greater);
+
+    const auto& header = *reinterpret_cast<const Implementation::MeshCodecHeader*>(data.data());
+    CORRADE_COMPARE(std::string(header.magic, 4), "MCDC");
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(header.primitive), UnsignedInt(MeshPrimitive::Triangles));
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(header.indexType), UnsignedInt(MeshIndexType::UnsignedShort));
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(header.indexCount), 24);
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(header.vertexCount), 9);
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(header.vertexSize), 20);
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(header.attributeCount), 2);
+    CORRADE_COMPARE(data.size(), sizeof(Implementation::MeshCodecHeader) + 2*sizeof(Implementation::MeshCodecAttribute) + Utility::Endianness::littleEndian(header.indexDataSize) + Utility::Endianness::littleEndian(header.vertexDataSize));
+
+    /* Eight triangles sharing edges should be way less than the original 48
+       bytes of indices */
+    CORRADE_COMPARE_AS(Utility::Endianness::littleEndian(header.indexDataSize), 24u,
+        TestSuite::Compare::Less);
+
+    const auto* attributes = reinterpret_cast<const Implementation::MeshCodecAttribute*>(data.data() + sizeof(Implementation::MeshCodecHeader));
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(attributes[0].name), UnsignedShort(MeshAttribute::Position));
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(attributes[0].format), UnsignedInt(VertexFormat::Vector3));
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(attributes[0].offset), 0);
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(attributes[1].name), UnsignedShort(MeshAttribute::TextureCoordinates));
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(attributes[1].format), UnsignedInt(VertexFormat::Vector2));
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(attributes[1].offset), 12);
+}
+
+void MeshCodecSceneConverterTest::verbose() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MeshCodecSceneConverter");
+    converter->setFlags(SceneConverterFlag::Verbose);
+
+    MeshData mesh{MeshPrimitive::Triangles,
+        {}, TriangleIndices, MeshIndexData{TriangleIndices},
+        {}, Vertices, {
+            MeshAttributeData{MeshAttribute::Position, Positions}
+        }};
+
+    std::ostringstream out;
+    Containers::Array<char> data;
+    {
+        Debug redirectOutput{&out};
+        data = converter->convertToData(mesh);
+    }
+    CORRADE_VERIFY(data);
+
+    const auto& header = *reinterpret_cast<const Implementation::MeshCodecHeader*>(data.data());
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::MeshCodecSceneConverter::convertToData(): encoded 48 bytes of indices to {} and 108 bytes of vertices to {}\n",
+        Utility::Endianness::littleEndian(header.indexDataSize),
+        Utility::Endianness::littleEndian(header.vertexDataSize)));
+}
+
+void MeshCodecSceneConverterTest::triangles() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MeshCodecSceneConverter");
+
+    MeshData mesh{MeshPrimitive::Triangles,
+        {}, TriangleIndices, MeshIndexData{TriangleIndices},
+        {}, Vertices, {
+            MeshAttributeData{MeshAttribute::Position, Positions},
+            MeshAttributeData{MeshAttribute::TextureCoordinates, TextureCoordinates}
+        }};
+
+    Containers::Array<char> data = converter->convertToData(mesh);
+    CORRADE_VERIFY(data);
+
+    if(!(_importerManager.loadState("MeshCodecImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MeshCodecImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MeshCodecImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+
+    CORRADE_COMPARE(imported->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(imported->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(imported->indexCount(), 24);
+    /* The encoder may rotate the triangles, but each has to stay the same
+       with the same winding */
+    const Containers::Array<UnsignedInt> indices = imported->indicesAsArray();
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        CORRADE_VERIFY(
+            (indices[i] == TriangleIndices[i] && indices[i + 1] == TriangleIndices[i + 1] && indices[i + 2] == TriangleIndices[i + 2]) ||
+            (indices[i] == TriangleIndices[i + 1] && indices[i + 1] == TriangleIndices[i + 2] && indices[i + 2] == TriangleIndices[i]) ||
+            (indices[i] == TriangleIndices[i + 2] && indices[i + 1] == TriangleIndices[i] && indices[i + 2] == TriangleIndices[i + 1]));
+    }
+
+    CORRADE_COMPARE(imported->vertexCount(), 9);
+    CORRADE_COMPARE(imported->attributeCount(), 2);
+    CORRADE_COMPARE_AS(imported->attribute<Vector3>(MeshAttribute::Position),
+        Positions,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(imported->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        TextureCoordinates,
+        TestSuite::Compare::Container);
+}
+
+void MeshCodecSceneConverterTest::nonInterleaved() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MeshCodecSceneConverter");
+
+    /* Positions first, then a custom array attribute */
+    const struct {
+        Vector3 positions[3];
+        Vector2us weights[3];
+    } vertexData{
+        {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+        {{1, 2}, {3, 4}, {5, 6}}
+    };
+
+    MeshData mesh{MeshPrimitive::Points, {}, Containers::arrayView(&vertexData, 1), {
+        MeshAttributeData{MeshAttribute::Position, Containers::arrayView(vertexData.positions)},
+        MeshAttributeData{meshAttributeCustom(1), VertexFormat::UnsignedShort, Containers::stridedArrayView(vertexData.weights), 2}
+    }};
+
+    Containers::Array<char> data = converter->convertToData(mesh);
+    CORRADE_VERIFY(data);
+
+    if(!(_importerManager.loadState("MeshCodecImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MeshCodecImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MeshCodecImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+
+    CORRADE_COMPARE(imported->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!imported->isIndexed());
+    CORRADE_COMPARE(imported->vertexCount(), 3);
+    CORRADE_COMPARE(imported->attributeCount(), 2);
+    /* The data are interleaved now */
+    CORRADE_COMPARE(imported->attributeStride(0), 16);
+    CORRADE_COMPARE(imported->attributeStride(1), 16);
+    CORRADE_COMPARE_AS(imported->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(vertexData.positions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(imported->attributeName(1), meshAttributeCustom(1));
+    CORRADE_COMPARE(imported->attributeArraySize(1), 2);
+    CORRADE_COMPARE_AS((Containers::arrayCast<1, const Vector2us>(imported->attribute<UnsignedShort[]>(1))),
+        Containers::arrayView(vertexData.weights),
+        TestSuite::Compare::Container);
+}
+
+void MeshCodecSceneConverterTest::lines() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MeshCodecSceneConverter");
+
+    const UnsignedByte indices[]{0, 1, 1, 2, 2, 5, 5, 8, 8, 7, 7, 6};
+    MeshData mesh{MeshPrimitive::Lines,
+        {}, indices, MeshIndexData{indices},
+        {}, Vertices, {
+            MeshAttributeData{MeshAttribute::Position, Positions}
+        }};
+
+    Containers::Array<char> data = converter->convertToData(mesh);
+    CORRADE_VERIFY(data);
+
+    if(!(_importerManager.loadState("MeshCodecImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MeshCodecImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MeshCodecImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+
+    /* Non-triangle indices are preserved exactly */
+    CORRADE_COMPARE(imported->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(imported->indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE_AS(imported->indices<UnsignedByte>(),
+        Containers::arrayView(indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(imported->attribute<Vector3>(MeshAttribute::Position),
+        Positions,
+        TestSuite::Compare::Container);
+}
+
+void MeshCodecSceneConverterTest::nonIndexed() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MeshCodecSceneConverter");
+
+    Containers::Array<char> data = converter->convertToData(MeshData{MeshPrimitive::Faces, 15});
+    CORRADE_VERIFY(data);
+
+    if(!(_importerManager.loadState("MeshCodecImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MeshCodecImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MeshCodecImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+
+    CORRADE_COMPARE(imported->primitive(), MeshPrimitive::Faces);
+    CORRADE_VERIFY(!imported->isIndexed());
+    CORRADE_COMPARE(imported->vertexCount(), 15);
+    CORRADE_COMPARE(imported->attributeCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshCodecSceneConverterTest)
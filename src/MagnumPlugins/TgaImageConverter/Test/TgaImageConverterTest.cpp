@@ -50,6 +50,9 @@ struct TgaImageConverterTest: TestSuite::Tester {
     void rgb();
     void rgba();
 
+    void rows();
+    void rowsIncomplete();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
     PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
@@ -100,6 +103,9 @@ TgaImageConverterTest::TgaImageConverterTest() {
         &TgaImageConverterTest::rgba},
         Containers::arraySize(VerboseData));
 
+    addTests({&TgaImageConverterTest::rows,
+              &TgaImageConverterTest::rowsIncomplete});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef TGAIMAGECONVERTER_PLUGIN_FILENAME
@@ -109,6 +115,9 @@ TgaImageConverterTest::TgaImageConverterTest() {
     #ifdef TGAIMPORTER_PLUGIN_FILENAME
     CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
     #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(TGAIMAGECONVERTER_TEST_OUTPUT_DIR));
 }
 
 void TgaImageConverterTest::wrongFormat() {
@@ -185,6 +194,34 @@ void TgaImageConverterTest::rgba() {
     CORRADE_COMPARE(out.str(), data.message32);
 }
 
+void TgaImageConverterTest::rows() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    const std::string filename = Utility::Directory::join(TGAIMAGECONVERTER_TEST_OUTPUT_DIR, "rows.tga");
+
+    /* Two rows and then the last one, each time with different storage */
+    CORRADE_VERIFY(converter->beginExportToFile(ImageView2D{PixelFormat::RGB8Unorm, {2, 3}}, filename));
+    CORRADE_VERIFY(converter->exportRowsToFile(ImageView2D{PixelStorage{}.setSkip({0, 1, 0}), PixelFormat::RGB8Unorm, {2, 2}, OriginalDataRGB}));
+    CORRADE_VERIFY(converter->exportRowsToFile(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 1}, Containers::arrayView(ConvertedDataRGB).suffix(12)}));
+    CORRADE_VERIFY(converter->endExportToFile());
+
+    /* The result should be the same as when exporting everything at once */
+    Containers::Array<char> expected = converter->exportToData(OriginalRGB);
+    CORRADE_VERIFY(expected);
+    CORRADE_COMPARE_AS(Utility::Directory::read(filename),
+        expected, TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rowsIncomplete() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(converter->beginExportToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 3}}, Utility::Directory::join(TGAIMAGECONVERTER_TEST_OUTPUT_DIR, "rows-incomplete.tga")));
+    CORRADE_VERIFY(converter->exportRowsToFile(ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, OriginalDataRGBA}));
+    CORRADE_VERIFY(!converter->endExportToFile());
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImageConverter::endExportToFile(): expected 2 more rows\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterTest)
@@ -26,9 +26,9 @@
 #include "TgaImageConverter.h"
 
 #include <fstream>
-#include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/ImageView.h"
@@ -39,11 +39,47 @@
 
 namespace Magnum { namespace Trade {
 
+namespace {
+
+bool fillHeader(Implementation::TgaHeader& header, const ImageView2D& image, const char* const messagePrefix) {
+    switch(image.format()) {
+        case PixelFormat::RGB8Unorm:
+        case PixelFormat::RGBA8Unorm:
+            header.imageType = 2;
+            break;
+        case PixelFormat::R8Unorm:
+            header.imageType = 3;
+            break;
+        default:
+            Error() << messagePrefix << "unsupported pixel format" << image.format();
+            return false;
+    }
+    header.bpp = image.pixelSize()*8;
+    header.width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
+    header.height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
+    return true;
+}
+
+/* TGA stores the channels in BGR(A) order */
+void swizzlePixels(const PixelFormat format, const Containers::ArrayView<char> pixels) {
+    if(format == PixelFormat::RGB8Unorm) {
+        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(pixels))
+            pixel = Math::gather<'b', 'g', 'r'>(pixel);
+    } else if(format == PixelFormat::RGBA8Unorm) {
+        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(pixels))
+            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+    }
+}
+
+}
+
 TgaImageConverter::TgaImageConverter() = default;
 
 TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImageConverter{manager, plugin} {}
 
-ImageConverterFeatures TgaImageConverter::doFeatures() const { return ImageConverterFeature::ConvertData; }
+TgaImageConverter::~TgaImageConverter() = default;
+
+ImageConverterFeatures TgaImageConverter::doFeatures() const { return ImageConverterFeature::ConvertData|ImageConverterFeature::ConvertFileRows; }
 
 Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& image) {
     /* Initialize data buffer */
@@ -51,44 +87,74 @@ Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& ima
     Containers::Array<char> data{Containers::ValueInit, sizeof(Implementation::TgaHeader) + pixelSize*image.size().product()};
 
     /* Fill header */
-    auto header = reinterpret_cast<Implementation::TgaHeader*>(data.begin());
-    switch(image.format()) {
-        case PixelFormat::RGB8Unorm:
-        case PixelFormat::RGBA8Unorm:
-            header->imageType = 2;
-            break;
-        case PixelFormat::R8Unorm:
-            header->imageType = 3;
-            break;
-        default:
-            Error() << "Trade::TgaImageConverter::exportToData(): unsupported pixel format" << image.format();
-            return nullptr;
-    }
-    header->bpp = pixelSize*8;
-    header->width = UnsignedShort(Utility::Endianness::littleEndian(image.size().x()));
-    header->height = UnsignedShort(Utility::Endianness::littleEndian(image.size().y()));
+    if(!fillHeader(*reinterpret_cast<Implementation::TgaHeader*>(data.begin()), image, "Trade::TgaImageConverter::exportToData():"))
+        return nullptr;
 
     /* Copy the pixels into output, dropping padding (if any) */
     const Containers::ArrayView<char> pixels = data.suffix(sizeof(Implementation::TgaHeader));
     Utility::copy(image.pixels(), Containers::StridedArrayView3D<char>{pixels,
         {std::size_t(image.size().y()), std::size_t(image.size().x()), pixelSize}});
 
-    if(image.format() == PixelFormat::RGB8Unorm) {
-        if(flags() & ImageConverterFlag::Verbose)
+    if(flags() & ImageConverterFlag::Verbose) {
+        if(image.format() == PixelFormat::RGB8Unorm)
             Debug{} << "Trade::TgaImageConverter::exportToData(): converting from RGB to BGR";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(pixels))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
-    } else if(image.format() == PixelFormat::RGBA8Unorm) {
-        if(flags() & ImageConverterFlag::Verbose)
+        else if(image.format() == PixelFormat::RGBA8Unorm)
             Debug{} << "Trade::TgaImageConverter::exportToData(): converting from RGBA to BGRA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(pixels))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
     }
+    swizzlePixels(image.format(), pixels);
 
     return data;
 }
 
+bool TgaImageConverter::doBeginExportToFile(const ImageView2D& image, const std::string& filename) {
+    Implementation::TgaHeader header{};
+    if(!fillHeader(header, image, "Trade::TgaImageConverter::beginExportToFile():"))
+        return false;
+
+    Containers::Pointer<std::ofstream> out{new std::ofstream{filename, std::ios::binary}};
+    if(!out->write(reinterpret_cast<const char*>(&header), sizeof(Implementation::TgaHeader))) {
+        Error{} << "Trade::TgaImageConverter::beginExportToFile(): cannot write to file" << filename;
+        return false;
+    }
+
+    if(flags() & ImageConverterFlag::Verbose) {
+        if(image.format() == PixelFormat::RGB8Unorm)
+            Debug{} << "Trade::TgaImageConverter::beginExportToFile(): converting from RGB to BGR";
+        else if(image.format() == PixelFormat::RGBA8Unorm)
+            Debug{} << "Trade::TgaImageConverter::beginExportToFile(): converting from RGBA to BGRA";
+    }
+
+    _out = std::move(out);
+    _rowData = Containers::Array<char>{Containers::NoInit, image.pixelSize()*image.size().x()};
+    return true;
+}
+
+bool TgaImageConverter::doExportRowsToFile(const ImageView2D& rows) {
+    /* Copy each row to drop padding (if any), swizzle and write */
+    const Containers::StridedArrayView3D<const char> pixels = rows.pixels();
+    for(std::size_t y = 0; y != pixels.size()[0]; ++y) {
+        Utility::copy(pixels[y], Containers::StridedArrayView2D<char>{_rowData,
+            {pixels.size()[1], pixels.size()[2]}});
+        swizzlePixels(rows.format(), _rowData);
+        if(!_out->write(_rowData, _rowData.size())) {
+            Error{} << "Trade::TgaImageConverter::exportRowsToFile(): cannot write to file";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TgaImageConverter::doEndExportToFile() {
+    _out->close();
+    const bool out = !_out->fail();
+    _out = nullptr;
+    _rowData = nullptr;
+    if(!out) Error{} << "Trade::TgaImageConverter::endExportToFile(): cannot write to file";
+    return out;
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(TgaImageConverter, Magnum::Trade::TgaImageConverter,
-    "cz.mosra.magnum.Trade.AbstractImageConverter/0.2.1")
+    "cz.mosra.magnum.Trade.AbstractImageConverter/0.2.3")
@@ -29,6 +29,10 @@
  * @brief Class @ref Magnum::Trade::TgaImageConverter
  */
 
+#include <iosfwd>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+
 #include "Magnum/Trade/AbstractImageConverter.h"
 
 #include "MagnumPlugins/TgaImageConverter/configure.h"
@@ -87,6 +91,14 @@ target_link_libraries(your-app PRIVATE Magnum::TgaImageConverter)
 @endcode
 
 See @ref building, @ref cmake and @ref plugins for more information.
+
+@section Trade-TgaImageConverter-behavior Behavior and limitations
+
+The plugin supports @ref ImageConverterFeature::ConvertFileRows, allowing to
+export the image to a file in row bands using @ref beginExportToFile(),
+@ref exportRowsToFile() and @ref endExportToFile(). The rows are written to
+the file as they come, so the export needs just a fixed amount of memory
+regardless of the image size.
 */
 class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageConverter {
     public:
@@ -96,9 +108,18 @@ class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageCon
         /** @brief Plugin manager constructor */
         explicit TgaImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~TgaImageConverter();
+
     private:
         ImageConverterFeatures MAGNUM_TGAIMAGECONVERTER_LOCAL doFeatures() const override;
         Containers::Array<char> MAGNUM_TGAIMAGECONVERTER_LOCAL doExportToData(const ImageView2D& image) override;
+        bool MAGNUM_TGAIMAGECONVERTER_LOCAL doBeginExportToFile(const ImageView2D& image, const std::string& filename) override;
+        bool MAGNUM_TGAIMAGECONVERTER_LOCAL doExportRowsToFile(const ImageView2D& rows) override;
+        bool MAGNUM_TGAIMAGECONVERTER_LOCAL doEndExportToFile() override;
+
+        /* State of an export in row bands */
+        Containers::Pointer<std::ofstream> _out;
+        Containers::Array<char> _rowData;
 };
 
 }}
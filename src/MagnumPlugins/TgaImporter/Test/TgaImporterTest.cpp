@@ -32,6 +32,7 @@
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/FormatStl.h>
 
+#include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
@@ -59,6 +60,13 @@ struct TgaImporterTest: TestSuite::Tester {
 
     void rleTooLarge();
 
+    void rows();
+    void rowsRle();
+    void rowsFile();
+    void rowsShort();
+    void rowsRleTooLarge();
+    void rowsRleTrailingData();
+
     void openTwice();
     void importTwice();
 
@@ -107,6 +115,16 @@ constexpr const char Color24Rle[] = {
     '\x82', 4, 5, 6
 };
 
+constexpr const char Color24RleTooLarge[] = {
+    0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0,
+    /* 3 pixels as-is */
+    '\x02', 1, 2, 3,
+            2, 3, 4,
+            3, 4, 5,
+    /* 1 pixel 4x repeated (one more than it should be) */
+    '\x83', 4, 5, 6
+};
+
 /* MSVC 2015 crashes when seeing constexpr here. Not doing that, then. */
 const struct {
     const char* name;
@@ -146,7 +164,14 @@ TgaImporterTest::TgaImporterTest() {
     addTests({&TgaImporterTest::grayscale8,
               &TgaImporterTest::grayscale8Rle,
 
-              &TgaImporterTest::rleTooLarge});
+              &TgaImporterTest::rleTooLarge,
+
+              &TgaImporterTest::rows,
+              &TgaImporterTest::rowsRle,
+              &TgaImporterTest::rowsFile,
+              &TgaImporterTest::rowsShort,
+              &TgaImporterTest::rowsRleTooLarge,
+              &TgaImporterTest::rowsRleTrailingData});
 
     addTests({&TgaImporterTest::openTwice,
               &TgaImporterTest::importTwice});
@@ -404,21 +429,132 @@ void TgaImporterTest::grayscale8Rle() {
 
 void TgaImporterTest::rleTooLarge() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24RleTooLarge));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2D(0));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2D(): RLE data larger than advertised Vector(2, 3) pixels at byte 28\n");
+}
+
+void TgaImporterTest::rows() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24));
+
+    Containers::Optional<ImageView2D> image = importer->beginImage2DRows(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+
+    /* Two rows and then one, with four-byte row alignment to verify the
+       output storage is respected */
+    char out[16]{};
+    CORRADE_VERIFY(importer->image2DRows(MutableImageView2D{PixelFormat::RGB8Unorm, {2, 2}, out}));
+    CORRADE_COMPARE_AS(Containers::arrayView(out).prefix(14), Containers::arrayView<char>({
+        3, 2, 1, 4, 3, 2, 0, 0,
+        5, 4, 3, 6, 5, 4
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(importer->image2DRows(MutableImageView2D{PixelFormat::RGB8Unorm, {2, 1}, out}));
+    CORRADE_COMPARE_AS(Containers::arrayView(out).prefix(6), Containers::arrayView<char>({
+        7, 6, 5, 8, 7, 6
+    }), TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::rowsRle() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24Rle));
+    CORRADE_VERIFY(importer->beginImage2DRows(0));
+
+    /* The repeat packet spans the second and third row, the decoder has to
+       preserve its state between the calls */
+    PixelStorage storage;
+    storage.setAlignment(1);
+    char out[6];
+    const char expected[][6]{
+        {3, 2, 1, 4, 3, 2},
+        {5, 4, 3, 6, 5, 4},
+        {6, 5, 4, 6, 5, 4}
+    };
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(importer->image2DRows(MutableImageView2D{storage, PixelFormat::RGB8Unorm, {2, 1}, out}));
+        CORRADE_COMPARE_AS(Containers::arrayView(out),
+            Containers::arrayView(expected[i]),
+            TestSuite::Compare::Container);
+    }
+}
+
+void TgaImporterTest::rowsFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TGAIMPORTER_TEST_DIR, "file.tga")));
+
+    Containers::Optional<ImageView2D> image = importer->beginImage2DRows(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+
+    PixelStorage storage;
+    storage.setAlignment(1);
+    char out[6];
+    CORRADE_VERIFY(importer->image2DRows(MutableImageView2D{storage, PixelFormat::R8Unorm, {2, 3}, out}));
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<char>({
+        1, 2, 3, 4, 5, 6
+    }), TestSuite::Compare::Container);
+
+    /* Importing the whole image afterwards works as well */
+    Containers::Optional<Trade::ImageData2D> whole = importer->image2D(0);
+    CORRADE_VERIFY(whole);
+    CORRADE_COMPARE_AS(whole->data(), Containers::arrayView(out),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::rowsShort() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Containers::arrayView(Color24).except(7)));
+    CORRADE_VERIFY(importer->beginImage2DRows(0));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    char data[8];
+    CORRADE_VERIFY(importer->image2DRows(MutableImageView2D{PixelFormat::RGB8Unorm, {2, 1}, data}));
+    CORRADE_VERIFY(!importer->image2DRows(MutableImageView2D{PixelFormat::RGB8Unorm, {2, 1}, data}));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2DRows(): file too short at row 1\n");
+}
+
+void TgaImporterTest::rowsRleTooLarge() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(Color24RleTooLarge));
+    CORRADE_VERIFY(importer->beginImage2DRows(0));
+
+    /* The repeat packet starts in the second row and would overflow the
+       image */
+    std::ostringstream out;
+    Error redirectError{&out};
+    char data[8];
+    CORRADE_VERIFY(importer->image2DRows(MutableImageView2D{PixelFormat::RGB8Unorm, {2, 1}, data}));
+    CORRADE_VERIFY(!importer->image2DRows(MutableImageView2D{PixelFormat::RGB8Unorm, {2, 1}, data}));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2DRows(): RLE data larger than advertised Vector(2, 3) pixels at row 1\n");
+}
+
+void TgaImporterTest::rowsRleTrailingData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    /* Same as Color24Rle, but with one more packet at the end */
     const char data[] = {
         0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0,
-        /* 3 pixels as-is */
         '\x02', 1, 2, 3,
                 2, 3, 4,
                 3, 4, 5,
-        /* 1 pixel 4x repeated (one more than it should be) */
-        '\x83', 4, 5, 6
+        '\x82', 4, 5, 6,
+        '\x80', 7, 8, 9
     };
     CORRADE_VERIFY(importer->openData(data));
+    CORRADE_VERIFY(importer->beginImage2DRows(0));
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(!importer->image2D(0));
-    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2D(): RLE data larger than advertised Vector(2, 3) pixels at byte 28\n");
+    char pixels[24];
+    CORRADE_VERIFY(!importer->image2DRows(MutableImageView2D{PixelFormat::RGB8Unorm, {2, 3}, pixels}));
+    CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2DRows(): RLE data larger than advertised Vector(2, 3) pixels after the last row\n");
 }
 
 void TgaImporterTest::openTwice() {
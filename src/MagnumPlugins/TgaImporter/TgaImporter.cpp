@@ -25,13 +25,15 @@
 
 #include "TgaImporter.h"
 
+#include <algorithm>
 #include <fstream>
-#include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Endianness.h>
 
+#include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Swizzle.h"
 #include "Magnum/Math/Vector4.h"
@@ -40,17 +42,107 @@
 
 namespace Magnum { namespace Trade {
 
+namespace {
+
+struct Properties {
+    PixelFormat format;
+    Vector2i size;
+    std::size_t pixelSize;
+    bool rle;
+};
+
+Containers::Optional<Properties> parseHeader(const Implementation::TgaHeader& header, const char* const messagePrefix) {
+    Properties out;
+
+    /* Size in machine endian */
+    out.size = {Utility::Endianness::littleEndian(header.width),
+                Utility::Endianness::littleEndian(header.height)};
+
+    /* Image format */
+    if(header.colorMapType != 0) {
+        Error() << messagePrefix << "paletted files are not supported";
+        return Containers::NullOpt;
+    }
+
+    /* Color */
+    if(header.imageType == 2 || header.imageType == 10) {
+        /* Reference: http://www.paulbourke.net/dataformats/tga/ */
+        out.rle = header.imageType == 10;
+        switch(header.bpp) {
+            case 24:
+                out.format = PixelFormat::RGB8Unorm;
+                break;
+            case 32:
+                out.format = PixelFormat::RGBA8Unorm;
+                break;
+            default:
+                Error() << messagePrefix << "unsupported color bits-per-pixel:" << header.bpp;
+                return Containers::NullOpt;
+        }
+
+    /* Grayscale */
+    } else if(header.imageType == 3 || header.imageType == 11) {
+        /* I only discovered this by accident when using ImageMagick's
+            mogrify -compression RunLengthEncoded file.tga
+           as far as I could find, it's not documented in any TGA specs */
+        out.rle = header.imageType == 11;
+        out.format = PixelFormat::R8Unorm;
+        if(header.bpp != 8) {
+            Error() << messagePrefix << "unsupported grayscale bits-per-pixel:" << header.bpp;
+            return Containers::NullOpt;
+        }
+
+    /* Other? */
+    } else {
+        Error() << messagePrefix << "unsupported image type:" << header.imageType;
+        return Containers::NullOpt;
+    }
+
+    out.pixelSize = header.bpp/8;
+    return out;
+}
+
+PixelStorage pixelStorage(const Properties& properties) {
+    /* Adjust pixel storage if row size is not four byte aligned */
+    PixelStorage storage;
+    if((properties.size.x()*properties.pixelSize)%4 != 0)
+        storage.setAlignment(1);
+    return storage;
+}
+
+}
+
+struct TgaImporter::Rows {
+    Properties properties;
+    /* Read position in _in if opened from data, the file is read
+       sequentially */
+    std::size_t offset;
+    Int row;
+    /* RLE packets can span across rows, so the currently decoded one is
+       remembered. If the packet is repeating a single pixel, it's stored in
+       `pixel`. */
+    std::size_t packetRemaining;
+    bool packetRepeat;
+    char pixel[4];
+    /* A single row of the image in file layout */
+    Containers::Array<char> rowData;
+};
+
 TgaImporter::TgaImporter() = default;
 
 TgaImporter::TgaImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
 TgaImporter::~TgaImporter() = default;
 
-ImporterFeatures TgaImporter::doFeatures() const { return ImporterFeature::OpenData; }
+ImporterFeatures TgaImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::Image2DRows; }
 
-bool TgaImporter::doIsOpened() const { return _in; }
+bool TgaImporter::doIsOpened() const { return _in || _file; }
 
-void TgaImporter::doClose() { _in = nullptr; }
+void TgaImporter::doClose() {
+    _in = nullptr;
+    _file = nullptr;
+    _rows = nullptr;
+}
 
 void TgaImporter::doOpenData(const Containers::ArrayView<const char> data) {
     /* Because here we're copying the data and using the _in to check if file
@@ -69,73 +161,68 @@ void TgaImporter::doOpenData(const Containers::ArrayView<const char> data) {
     std::copy(data.begin(), data.end(), _in.begin());
 }
 
-UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
-
-Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedInt) {
-    /* Check if the file is long enough */
-    if(_in.size() < sizeof(Implementation::TgaHeader)) {
-        Error{} << "Trade::TgaImporter::image2D(): file too short, expected at least" << sizeof(Implementation::TgaHeader) << "bytes but got" << _in.size();
-        return Containers::NullOpt;
+void TgaImporter::doOpenFile(const std::string& filename) {
+    /* Only open the file here, the data are read in doImage2D() or
+       incrementally in doImage2DRows() */
+    Containers::Pointer<std::ifstream> file{new std::ifstream{filename, std::ios::binary}};
+    if(!*file) {
+        Error{} << "Trade::TgaImporter::openFile(): cannot open file" << filename;
+        return;
     }
 
-    const Implementation::TgaHeader& header = *reinterpret_cast<const Implementation::TgaHeader*>(_in.data());
-
-    /* Size in machine endian */
-    const Vector2i size{Utility::Endianness::littleEndian(header.width),
-                        Utility::Endianness::littleEndian(header.height)};
+    file->seekg(0, std::ios::end);
+    const std::streamoff end = file->tellg();
+    if(end == -1) {
+        Error{} << "Trade::TgaImporter::openFile(): cannot determine size of" << filename;
+        return;
+    }
 
-    /* Image format */
-    PixelFormat format;
-    if(header.colorMapType != 0) {
-        Error() << "Trade::TgaImporter::image2D(): paletted files are not supported";
-        return Containers::NullOpt;
+    const std::size_t size = end;
+    if(!size) {
+        Error{} << "Trade::TgaImporter::openFile(): the file is empty";
+        return;
     }
 
-    /* Color */
-    bool rle = false;
-    if(header.imageType == 2 || header.imageType == 10) {
-        /* Reference: http://www.paulbourke.net/dataformats/tga/ */
-        rle = header.imageType == 10;
-        switch(header.bpp) {
-            case 24:
-                format = PixelFormat::RGB8Unorm;
-                break;
-            case 32:
-                format = PixelFormat::RGBA8Unorm;
-                break;
-            default:
-                Error() << "Trade::TgaImporter::image2D(): unsupported color bits-per-pixel:" << header.bpp;
-                return Containers::NullOpt;
-        }
+    _file = std::move(file);
+    _fileSize = size;
+}
 
-    /* Grayscale */
-    } else if(header.imageType == 3 || header.imageType == 11) {
-        /* I only discovered this by accident when using ImageMagick's
-            mogrify -compression RunLengthEncoded file.tga
-           as far as I could find, it's not documented in any TGA specs */
-        rle = header.imageType == 11;
-        format = PixelFormat::R8Unorm;
-        if(header.bpp != 8) {
-            Error() << "Trade::TgaImporter::image2D(): unsupported grayscale bits-per-pixel:" << header.bpp;
+UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
+
+Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedInt) {
+    /* If opened from a file, read it whole now */
+    Containers::Array<char> fileData;
+    if(_file) {
+        fileData = Containers::Array<char>{Containers::NoInit, _fileSize};
+        _file->clear();
+        _file->seekg(0);
+        _file->read(fileData, _fileSize);
+        if(std::size_t(_file->gcount()) != _fileSize) {
+            Error{} << "Trade::TgaImporter::image2D(): expected to read" << _fileSize << "bytes but got" << _file->gcount();
             return Containers::NullOpt;
         }
+    }
+    const Containers::ArrayView<const char> in = _file ? fileData : _in;
 
-    /* Other? */
-    } else {
-        Error() << "Trade::TgaImporter::image2D(): unsupported image type:" << header.imageType;
+    /* Check if the file is long enough */
+    if(in.size() < sizeof(Implementation::TgaHeader)) {
+        Error{} << "Trade::TgaImporter::image2D(): file too short, expected at least" << sizeof(Implementation::TgaHeader) << "bytes but got" << in.size();
         return Containers::NullOpt;
     }
 
-    const std::size_t pixelSize = header.bpp/8;
-    const std::size_t outputSize = std::size_t(size.product())*pixelSize;
+    const Containers::Optional<Properties> properties = parseHeader(*reinterpret_cast<const Implementation::TgaHeader*>(in.data()), "Trade::TgaImporter::image2D():");
+    if(!properties) return Containers::NullOpt;
+
+    const std::size_t pixelSize = properties->pixelSize;
+    const std::size_t outputSize = std::size_t(properties->size.product())*pixelSize;
 
     /* Copy data directly if not RLE */
     Containers::Array<char> data{outputSize};
-    Containers::ArrayView<const char> srcPixels = _in.suffix(sizeof(Implementation::TgaHeader));
-    if(!rle) {
+    Containers::ArrayView<const char> srcPixels = in.suffix(sizeof(Implementation::TgaHeader));
+    if(!properties->rle) {
         /* Files that are larger are allowed in this case (but not for RLE) */
         if(srcPixels.size() < outputSize) {
-            Error{} << "Trade::TgaImporter::image2D(): file too short, expected" << outputSize + sizeof(Implementation::TgaHeader) << "bytes but got" << _in.size();
+            Error{} << "Trade::TgaImporter::image2D(): file too short, expected" << outputSize + sizeof(Implementation::TgaHeader) << "bytes but got" << in.size();
             return Containers::NullOpt;
         }
 
@@ -164,7 +251,7 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
                 return Containers::NullOpt;
             }
             if(count*pixelSize > dstPixels.size()) {
-                Error{} << "Trade::TgaImporter::image2D(): RLE data larger than advertised" << size << "pixels at byte" << (srcPixels.data() - _in.data());
+                Error{} << "Trade::TgaImporter::image2D(): RLE data larger than advertised" << properties->size << "pixels at byte" << (srcPixels.data() - in.data());
                 return Containers::NullOpt;
             }
 
@@ -183,27 +270,141 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
         }
     }
 
-    /* Adjust pixel storage if row size is not four byte aligned */
-    PixelStorage storage;
-    if((size.x()*header.bpp/8)%4 != 0)
-        storage.setAlignment(1);
-
-    if(format == PixelFormat::RGB8Unorm) {
+    if(properties->format == PixelFormat::RGB8Unorm) {
         if(flags() & ImporterFlag::Verbose)
             Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
         for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(data))
             pixel = Math::gather<'b', 'g', 'r'>(pixel);
-    } else if(format == PixelFormat::RGBA8Unorm) {
+    } else if(properties->format == PixelFormat::RGBA8Unorm) {
         if(flags() & ImporterFlag::Verbose)
             Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
         for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(data))
             pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
     }
 
-    return ImageData2D{storage, format, size, std::move(data)};
+    return ImageData2D{pixelStorage(*properties), properties->format, properties->size, std::move(data)};
+}
+
+std::size_t TgaImporter::readRows(const Containers::ArrayView<char> data) {
+    if(_file) {
+        _file->read(data, data.size());
+        return _file->gcount();
+    }
+
+    const std::size_t size = std::min(data.size(), _in.size() - std::min(_rows->offset, _in.size()));
+    Utility::copy(_in.slice(_rows->offset, _rows->offset + size), data.prefix(size));
+    _rows->offset += size;
+    return size;
+}
+
+Containers::Optional<ImageView2D> TgaImporter::doBeginImage2DRows(UnsignedInt, UnsignedInt) {
+    _rows.emplace();
+    if(_file) {
+        _file->clear();
+        _file->seekg(0);
+    }
+
+    Implementation::TgaHeader header;
+    const std::size_t headerSize = readRows({reinterpret_cast<char*>(&header), sizeof(Implementation::TgaHeader)});
+    if(headerSize != sizeof(Implementation::TgaHeader)) {
+        Error{} << "Trade::TgaImporter::beginImage2DRows(): file too short, expected at least" << sizeof(Implementation::TgaHeader) << "bytes but got" << headerSize;
+        return Containers::NullOpt;
+    }
+
+    Containers::Optional<Properties> properties = parseHeader(header, "Trade::TgaImporter::beginImage2DRows():");
+    if(!properties) return Containers::NullOpt;
+
+    if(flags() & ImporterFlag::Verbose) {
+        if(properties->format == PixelFormat::RGB8Unorm)
+            Debug{} << "Trade::TgaImporter::beginImage2DRows(): converting from BGR to RGB";
+        else if(properties->format == PixelFormat::RGBA8Unorm)
+            Debug{} << "Trade::TgaImporter::beginImage2DRows(): converting from BGRA to RGBA";
+    }
+
+    _rows->properties = *properties;
+    _rows->rowData = Containers::Array<char>{Containers::NoInit, properties->size.x()*properties->pixelSize};
+    return ImageView2D{pixelStorage(*properties), properties->format, properties->size};
+}
+
+bool TgaImporter::doImage2DRows(const MutableImageView2D& rows) {
+    Rows& state = *_rows;
+    const std::size_t pixelSize = state.properties.pixelSize;
+    const std::size_t width = state.properties.size.x();
+    const Containers::StridedArrayView3D<char> dst = rows.pixels();
+
+    for(std::size_t y = 0; y != dst.size()[0]; ++y, ++state.row) {
+        /* Copy the row directly if not RLE */
+        if(!state.properties.rle) {
+            if(readRows(state.rowData) != state.rowData.size()) {
+                Error{} << "Trade::TgaImporter::image2DRows(): file too short at row" << state.row;
+                return false;
+            }
+
+        /* Otherwise decode, continuing with a packet from the previous row if
+           it isn't finished yet */
+        } else for(std::size_t x = 0; x != width; ) {
+            if(!state.packetRemaining) {
+                char rleHeader;
+                if(readRows({&rleHeader, 1}) != 1) {
+                    Error{} << "Trade::TgaImporter::image2DRows(): RLE file too short at row" << state.row;
+                    return false;
+                }
+
+                /* See doImage2D() for details about the format */
+                state.packetRemaining = (UnsignedByte(rleHeader) & ~0x80) + 1;
+                state.packetRepeat = UnsignedByte(rleHeader) & 0x80;
+                if(state.packetRemaining > (state.properties.size.y() - state.row)*width - x) {
+                    Error{} << "Trade::TgaImporter::image2DRows(): RLE data larger than advertised" << state.properties.size << "pixels at row" << state.row;
+                    return false;
+                }
+                if(state.packetRepeat && readRows({state.pixel, pixelSize}) != pixelSize) {
+                    Error{} << "Trade::TgaImporter::image2DRows(): RLE file too short at row" << state.row;
+                    return false;
+                }
+            }
+
+            const std::size_t count = std::min(state.packetRemaining, width - x);
+            const Containers::ArrayView<char> rowPixels = state.rowData.slice(x*pixelSize, (x + count)*pixelSize);
+            if(state.packetRepeat) {
+                Utility::copy(Containers::StridedArrayView2D<const char>{
+                    Containers::arrayView(state.pixel).prefix(pixelSize),
+                    {count, pixelSize}, {0, 1}},
+                    Containers::StridedArrayView2D<char>{rowPixels,
+                    {count, pixelSize}});
+            } else if(readRows(rowPixels) != rowPixels.size()) {
+                Error{} << "Trade::TgaImporter::image2DRows(): RLE file too short at row" << state.row;
+                return false;
+            }
+
+            x += count;
+            state.packetRemaining -= count;
+        }
+
+        if(state.properties.format == PixelFormat::RGB8Unorm) {
+            for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(state.rowData))
+                pixel = Math::gather<'b', 'g', 'r'>(pixel);
+        } else if(state.properties.format == PixelFormat::RGBA8Unorm) {
+            for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(state.rowData))
+                pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+        }
+
+        /* The output view can have arbitrary padding */
+        Utility::copy(Containers::StridedArrayView2D<const char>{state.rowData,
+            {width, pixelSize}}, dst[y]);
+    }
+
+    /* Same as in doImage2D(), RLE data continuing after the last pixel are
+       an error */
+    char extra;
+    if(state.properties.rle && state.row == state.properties.size.y() && readRows({&extra, 1})) {
+        Error{} << "Trade::TgaImporter::image2DRows(): RLE data larger than advertised" << state.properties.size << "pixels after the last row";
+        return false;
+    }
+
+    return true;
 }
 
 }}
 
 CORRADE_PLUGIN_REGISTER(TgaImporter, Magnum::Trade::TgaImporter,
-    "cz.mosra.magnum.Trade.AbstractImporter/0.3.3")
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.4")
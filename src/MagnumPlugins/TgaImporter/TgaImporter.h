@@ -29,7 +29,9 @@
  * @brief Class @ref Magnum::Trade::TgaImporter
  */
 
+#include <iosfwd>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Utility/VisibilityMacros.h>
 
 #include "Magnum/Trade/AbstractImporter.h"
@@ -98,6 +100,12 @@ are imported with default @ref PixelStorage parameters except for alignment,
 which may be changed to `1` if the data require it.
 
 RLE compression is supported, paletted images are not.
+
+The plugin supports @ref ImporterFeature::Image2DRows, allowing to import the
+image in row bands using @ref beginImage2DRows() and @ref image2DRows(). If
+the file is opened using @ref openFile() and no file callbacks are set, the
+data are read from the file on demand and the streaming import thus needs just
+a fixed amount of memory regardless of the image size.
 */
 class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
     public:
@@ -113,11 +121,23 @@ class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         ImporterFeatures MAGNUM_TGAIMPORTER_LOCAL doFeatures() const override;
         bool MAGNUM_TGAIMPORTER_LOCAL doIsOpened() const override;
         void MAGNUM_TGAIMPORTER_LOCAL doOpenData(Containers::ArrayView<const char> data) override;
+        void MAGNUM_TGAIMPORTER_LOCAL doOpenFile(const std::string& filename) override;
         void MAGNUM_TGAIMPORTER_LOCAL doClose() override;
         UnsignedInt MAGNUM_TGAIMPORTER_LOCAL doImage2DCount() const override;
         Containers::Optional<ImageData2D> MAGNUM_TGAIMPORTER_LOCAL doImage2D(UnsignedInt id, UnsignedInt level) override;
+        Containers::Optional<ImageView2D> MAGNUM_TGAIMPORTER_LOCAL doBeginImage2DRows(UnsignedInt id, UnsignedInt level) override;
+        bool MAGNUM_TGAIMPORTER_LOCAL doImage2DRows(const MutableImageView2D& rows) override;
+
+        MAGNUM_TGAIMPORTER_LOCAL std::size_t readRows(Containers::ArrayView<char> data);
 
         Containers::Array<char> _in;
+        /* Set if opened through openFile(), the data are then read from the
+           file only when needed */
+        Containers::Pointer<std::ifstream> _file;
+        std::size_t _fileSize;
+
+        struct Rows;
+        Containers::Pointer<Rows> _rows;
 };
 
 }}
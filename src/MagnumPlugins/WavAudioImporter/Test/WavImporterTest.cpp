@@ -78,6 +78,11 @@ struct WavImporterTest: TestSuite::Tester {
     void surround51Channel16();
     void surround71Channel24();
 
+    void stream();
+    void streamData();
+    void streamBigEndian();
+    void streamZeroSamples();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -119,7 +124,12 @@ WavImporterTest::WavImporterTest() {
               &WavImporterTest::stereo64fBigEndian,
 
               &WavImporterTest::surround51Channel16,
-              &WavImporterTest::surround71Channel24});
+              &WavImporterTest::surround71Channel24,
+
+              &WavImporterTest::stream,
+              &WavImporterTest::streamData,
+              &WavImporterTest::streamBigEndian,
+              &WavImporterTest::streamZeroSamples});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -469,6 +479,77 @@ void WavImporterTest::surround71Channel24() {
     CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::Extensible\n");
 }
 
+void WavImporterTest::stream() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::Streaming);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono8.wav")));
+    CORRADE_COMPARE(importer->frameCount(), 2136);
+
+    const Containers::Array<char> data = importer->data();
+    Containers::Array<char> out{Containers::ValueInit, data.size()};
+
+    /* Reading in chunks gives the same as getting everything at once */
+    char chunk[1000];
+    CORRADE_COMPARE(importer->read(chunk), 1000);
+    std::copy(chunk, chunk + 1000, out.begin());
+    CORRADE_COMPARE(importer->read(chunk), 1000);
+    std::copy(chunk, chunk + 1000, out.begin() + 1000);
+    CORRADE_COMPARE(importer->read(chunk), 136);
+    std::copy(chunk, chunk + 136, out.begin() + 2000);
+    CORRADE_COMPARE(importer->read(chunk), 0);
+    CORRADE_COMPARE_AS(out, data, TestSuite::Compare::Container);
+
+    /* Seeking back */
+    CORRADE_VERIFY(importer->seek(2130));
+    CORRADE_COMPARE(importer->read(chunk), 6);
+    CORRADE_COMPARE_AS(Containers::arrayView(chunk).prefix(6),
+        data.suffix(2130), TestSuite::Compare::Container);
+}
+
+void WavImporterTest::streamData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+
+    /* The data get copied on open, so it's fine to drop them afterwards */
+    {
+        Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono16.wav"));
+        CORRADE_VERIFY(importer->openData(file));
+    }
+    CORRADE_COMPARE(importer->format(), BufferFormat::Mono16);
+    CORRADE_COMPARE(importer->frameCount(), 2);
+
+    /* Only whole frames get read, the rest of the buffer is untouched */
+    alignas(2) char chunk[3]{'\xff', '\xff', '\xff'};
+    CORRADE_COMPARE(importer->read(chunk), 1);
+    CORRADE_COMPARE(*reinterpret_cast<UnsignedShort*>(chunk), 0x101d);
+    CORRADE_COMPARE(chunk[2], '\xff');
+    CORRADE_COMPARE(importer->read(chunk), 1);
+    CORRADE_COMPARE(*reinterpret_cast<UnsignedShort*>(chunk), 0xc571);
+    CORRADE_COMPARE(chunk[2], '\xff');
+    CORRADE_COMPARE(importer->read(chunk), 0);
+}
+
+void WavImporterTest::streamBigEndian() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo64fbe.wav")));
+    CORRADE_COMPARE(importer->format(), BufferFormat::StereoDouble);
+
+    /* The streamed data are converted to machine endian the same way as
+       data() */
+    const Containers::Array<char> data = importer->data();
+    Containers::Array<char> out{Containers::ValueInit, data.size()};
+    CORRADE_COMPARE(importer->read(out), data.size()/16);
+    CORRADE_COMPARE_AS(out, data, TestSuite::Compare::Container);
+}
+
+void WavImporterTest::streamZeroSamples() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "zeroSamples.wav")));
+    CORRADE_COMPARE(importer->frameCount(), 0);
+
+    char chunk[2];
+    CORRADE_COMPARE(importer->read(chunk), 0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::WavImporterTest)
@@ -26,12 +26,19 @@
 
 #include "WavImporter.h"
 
+#include <algorithm>
+#include <cstring>
 #include <Corrade/Utility/Assert.h>
-#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/EndiannessBatch.h>
 
 #include "MagnumPlugins/WavAudioImporter/WavHeader.h"
 
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define MAGNUM_WAVAUDIOIMPORTER_USE_MAPPING
+#endif
+
 namespace Magnum { namespace Audio {
 
 using Implementation::RiffChunk;
@@ -39,19 +46,66 @@ using Implementation::WavAudioFormat;
 using Implementation::WavFormatChunk;
 using Implementation::WavHeaderChunk;
 
+struct WavImporter::Mapping {
+    #ifdef MAGNUM_WAVAUDIOIMPORTER_USE_MAPPING
+    Containers::Array<const char, Utility::Directory::MapDeleter> data;
+    #endif
+};
+
 WavImporter::WavImporter() = default;
 
 WavImporter::WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
-ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenData; }
+WavImporter::~WavImporter() = default;
 
-bool WavImporter::doIsOpened() const { return !!_data; }
+ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::Streaming; }
+
+bool WavImporter::doIsOpened() const { return _opened; }
 
 void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
+    Containers::Optional<Containers::ArrayView<const char>> samples = parse(data);
+    if(!samples) return;
+
+    /* Copy the data, as the view is not guaranteed to stay valid */
+    _data = Containers::Array<char>{Containers::NoInit, samples->size()};
+    std::copy(samples->begin(), samples->end(), _data.begin());
+    _samples = _data;
+    _position = 0;
+    _opened = true;
+}
+
+void WavImporter::doOpenFile(const std::string& filename) {
+    if(!Utility::Directory::exists(filename)) {
+        Error() << "Audio::WavImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    /* Map the file instead of reading it whole, so streaming a long track
+       touches only the pages that are actually decoded. If mapping fails
+       (for example on an empty file) or isn't available, fall back to
+       reading the whole file. */
+    #ifdef MAGNUM_WAVAUDIOIMPORTER_USE_MAPPING
+    Containers::Array<const char, Utility::Directory::MapDeleter> mapped = Utility::Directory::mapRead(filename);
+    if(mapped) {
+        Containers::Optional<Containers::ArrayView<const char>> samples = parse(mapped);
+        if(!samples) return;
+
+        _mapping.reset(new Mapping{std::move(mapped)});
+        _samples = *samples;
+        _position = 0;
+        _opened = true;
+        return;
+    }
+    #endif
+
+    doOpenData(Utility::Directory::read(filename));
+}
+
+Containers::Optional<Containers::ArrayView<const char>> WavImporter::parse(Containers::ArrayView<const char> data) {
     /* Check file size */
     if(data.size() < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
         Error() << "Audio::WavImporter::openData(): the file is too short:" << data.size() << "bytes";
-        return;
+        return {};
     }
 
     /* Get the RIFF/WAV header */
@@ -61,7 +115,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     if((std::strncmp(header.chunk.chunkId, "RIFF", 4) != 0 && std::strncmp(header.chunk.chunkId, "RIFX", 4) != 0) ||
        std::strncmp(header.format, "WAVE", 4) != 0) {
         Error() << "Audio::WavImporter::openData(): the file signature is invalid";
-        return;
+        return {};
     }
 
     /* Check if the file is Big-Endian. While RIFX files are extremely rare,
@@ -76,7 +130,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     if(header.chunk.chunkSize < 36 || header.chunk.chunkSize + 8 != data.size()) {
         Error() << "Audio::WavImporter::openData(): the file has improper size, expected"
                 << header.chunk.chunkSize + 8 << "but got" << data.size();
-        return;
+        return {};
     }
 
     const RiffChunk* dataChunk = nullptr;
@@ -100,7 +154,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         if(std::strncmp(currChunk->chunkId, "fmt ", 4) == 0) {
             if(formatChunk) {
                 Error() << "Audio::WavImporter::openData(): the file contains too many format chunks";
-                return;
+                return {};
             }
 
             formatChunk = WavFormatChunk{*reinterpret_cast<const WavFormatChunk*>(currChunk)};
@@ -108,7 +162,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         } else if(std::strncmp(currChunk->chunkId, "data", 4) == 0) {
             if(dataChunk != nullptr) {
                 Error() << "Audio::WavImporter::openData(): the file contains too many data chunks";
-                return;
+                return {};
             }
 
             dataChunk = currChunk;
@@ -120,13 +174,13 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     /* Make sure we actually got a format chunk */
     if(!formatChunk) {
         Error() << "Audio::WavImporter::openData(): the file contains no format chunk";
-        return;
+        return {};
     }
 
     /* Make sure we actually got a data chunk */
     if(dataChunk == nullptr) {
         Error() << "Audio::WavImporter::openData(): the file contains no data chunk";
-        return;
+        return {};
     }
 
     /* Fix endianness on Format chunk */
@@ -152,7 +206,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): PCM with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check IEEE Float format */
@@ -169,7 +223,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): IEEE with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check A-Law format */
@@ -182,7 +236,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): ALaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Check μ-Law format */
@@ -195,61 +249,90 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): MuLaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return {};
         }
 
     /* Unknown/unimplemented format */
     } else {
         Error() << "Audio::WavImporter::openData(): unsupported format" << formatChunk->audioFormat;
-        return;
+        return {};
     }
 
     /* Size sanity checks */
     if(headerSize + offset > data.size()) {
         Error() << "Audio::WavImporter::openData(): file size doesn't match computed size";
-        return;
+        return {};
     }
 
     /* Format sanity checks */
-    if(formatChunk->blockAlign != formatChunk->numChannels * formatChunk->bitsPerSample / 8 ||
+    if(!formatChunk->blockAlign ||
+       formatChunk->blockAlign != formatChunk->numChannels * formatChunk->bitsPerSample / 8 ||
        formatChunk->byteRate != formatChunk->sampleRate * formatChunk->blockAlign) {
         Error() << "Audio::WavImporter::openData(): the file is corrupted";
-        return;
+        return {};
     }
 
-    /* Save frequency */
+    /* Save frequency and frame size */
     _frequency = formatChunk->sampleRate;
+    _frameSize = formatChunk->blockAlign;
 
-    /* Copy the data */
-    const char* dataChunkPtr = reinterpret_cast<const char*>(dataChunk + 1);
-    _data = Containers::Array<char>(dataChunkSize);
-    std::copy(dataChunkPtr, dataChunkPtr+dataChunkSize, _data->begin());
-
-    /* Fix the data endianness */
-    if(hasBigEndianData != Utility::Endianness::isBigEndian()) {
-        if(formatChunk->bitsPerSample == 16)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint16_t>(*_data));
-        else if(formatChunk->bitsPerSample == 32)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint32_t>(*_data));
-        else if(formatChunk->bitsPerSample == 64)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint64_t>(*_data));
-        else CORRADE_INTERNAL_ASSERT(formatChunk->bitsPerSample == 8);
-    }
+    /* The data are converted to machine endian only when they're copied out
+       in doData() or doRead(), so it's possible to use the file contents
+       directly */
+    _swapSize = hasBigEndianData != Utility::Endianness::isBigEndian() ?
+        formatChunk->bitsPerSample/8 : 1;
+
+    return Containers::arrayView(reinterpret_cast<const char*>(dataChunk + 1), dataChunkSize);
 }
 
-void WavImporter::doClose() { _data = Containers::NullOpt; }
+void WavImporter::doClose() {
+    _data = nullptr;
+    _mapping = nullptr;
+    _samples = nullptr;
+    _opened = false;
+}
 
 BufferFormat WavImporter::doFormat() const { return _format; }
 
 UnsignedInt WavImporter::doFrequency() const { return _frequency; }
 
+void WavImporter::swapEndianness(const Containers::ArrayView<char> data) const {
+    if(_swapSize == 2)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint16_t>(data));
+    else if(_swapSize == 4)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint32_t>(data));
+    else if(_swapSize == 8)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint64_t>(data));
+    else CORRADE_INTERNAL_ASSERT(_swapSize == 1);
+}
+
 Containers::Array<char> WavImporter::doData() {
-    Containers::Array<char> copy(_data->size());
-    std::copy(_data->begin(), _data->end(), copy.begin());
+    Containers::Array<char> copy{Containers::NoInit, _samples.size()};
+    std::copy(_samples.begin(), _samples.end(), copy.begin());
+    swapEndianness(copy);
     return copy;
 }
 
+UnsignedLong WavImporter::doFrameCount() const {
+    return _samples.size()/_frameSize;
+}
+
+bool WavImporter::doSeek(const UnsignedLong frame) {
+    _position = frame;
+    return true;
+}
+
+std::size_t WavImporter::doRead(const Containers::ArrayView<char> destination) {
+    const std::size_t count = std::min<UnsignedLong>(destination.size()/_frameSize, doFrameCount() - _position);
+    const std::size_t size = count*_frameSize;
+    const char* const begin = _samples.begin() + _position*_frameSize;
+    std::copy(begin, begin + size, destination.begin());
+    swapEndianness(destination.prefix(size));
+    _position += count;
+    return count;
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(WavAudioImporter, Magnum::Audio::WavImporter,
-    "cz.mosra.magnum.Audio.AbstractImporter/0.1")
+    "cz.mosra.magnum.Audio.AbstractImporter/0.2")
@@ -32,6 +32,7 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
 
@@ -76,6 +77,11 @@ Supports mono and stereo files of the following formats:
 Both Little-Endian files (with a `RIFF` header) and Big-Endian files (with
 a `RIFX` header) are supported, data is converted to machine endian on import.
 
+The plugin supports @ref ImporterFeature::Streaming. Files opened with
+@ref openFile() are memory-mapped on platforms that support it, so streaming
+a long track through @ref read() doesn't need to keep a copy of the whole file
+in memory. Data passed to @ref openData() are copied.
+
 @section Audio-WavImporter-usage Usage
 
 This plugin is built if `WITH_WAVAUDIOIMPORTER` is enabled when building
@@ -117,19 +123,42 @@ class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
         /** @brief Plugin manager constructor */
         explicit WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        /** @brief Destructor */
+        ~WavImporter();
+
     private:
+        struct Mapping;
+
         MAGNUM_WAVAUDIOIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_WAVAUDIOIMPORTER_LOCAL BufferFormat doFormat() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
 
-        Containers::Optional<Containers::Array<char>> _data;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL UnsignedLong doFrameCount() const override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL bool doSeek(UnsignedLong frame) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doRead(Containers::ArrayView<char> destination) override;
+
+        /* Parses the header, fills the format properties and returns a view
+           on the sample data inside `data` */
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Optional<Containers::ArrayView<const char>> parse(Containers::ArrayView<const char> data);
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void swapEndianness(Containers::ArrayView<char> data) const;
+
+        /* Sample data are in (non-machine-endian) file layout, pointing
+           either to _data or _mapping */
+        Containers::Array<char> _data;
+        Containers::Pointer<Mapping> _mapping;
+        Containers::ArrayView<const char> _samples;
+        UnsignedLong _position{};
         BufferFormat _format;
         UnsignedInt _frequency;
+        UnsignedInt _frameSize;
+        UnsignedInt _swapSize;
+        bool _opened{};
 };
 
 }}